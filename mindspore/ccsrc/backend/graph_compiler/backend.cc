@@ -40,6 +40,7 @@
 #include "runtime/pynative/graph_adapter.h"
 #include "distributed/recovery/recovery_context.h"
 #include "include/common/utils/scoped_long_running.h"
+#include "include/common/thread_pool.h"
 #ifdef ENABLE_DEBUGGER
 #include "debug/debugger/debugger.h"
 #endif
@@ -137,6 +138,19 @@ VectorRef MsBackend::MsSimuRunGraph(const GraphId &g) {
 }
 
 namespace {
+// Compile the kernel graphs of the segments concurrently when it is set to 1.
+constexpr char kParallelCompileEnv[] = "MS_DEV_PARALLEL_COMPILE";
+// Share the kernels among the kernel graphs of the same content compiled concurrently when it is set to 1.
+constexpr char kStageGraphCacheEnv[] = "MS_DEV_STAGE_GRAPH_CACHE";
+
+// The kernels which call python are created with the GIL held, so their graphs are not compiled concurrently.
+bool IsConcurrentCompileSupported(const GraphSegmentPtr &segment) {
+  MS_EXCEPTION_IF_NULL(segment);
+  return std::none_of(segment->nodes_.begin(), segment->nodes_.end(), [](const AnfNodePtr &node) {
+    return IsPrimitiveCNode(node, prim::kPrimPyFunc) || IsPrimitiveCNode(node, prim::kPrimCustom);
+  });
+}
+
 std::vector<tensor::TensorPtr> GetTensorWithoutValueMask(const session::BackendOpRunInfoPtr &op_run_info) {
   MS_EXCEPTION_IF_NULL(op_run_info);
   std::vector<tensor::TensorPtr> tensors_without_value_node;
@@ -668,12 +682,102 @@ void MindRTBackend::CompileGraph(const FuncGraphPtr &func_graph, device::RunMode
   const auto &segments = graph_partition_->Partition(func_graph, &contain_multi_target);
   MS_LOG(INFO) << "Compile graph: " << func_graph->ToString() << ", Split segments size:" << segments.size();
 
+  if (real_execution_mode_ != kPynativeMode && common::GetEnv(kParallelCompileEnv) == "1") {
+    CompileGraphConcurrently(segments, run_mode);
+    return;
+  }
+
   // Foreach the segments to compile graph.
   for (const auto &segment : segments) {
     CompileGraph(segment, run_mode);
   }
 }
 
+void MindRTBackend::CompileGraphConcurrently(const std::vector<GraphSegmentPtr> &segments, device::RunMode run_mode) {
+  MS_EXCEPTION_IF_NULL(graph_compiler_);
+  struct SegmentGraph {
+    GraphSegmentPtr segment;
+    DeviceContext *device_context;
+    AnfNodePtrList outputs;
+    KernelGraphPtr graph;
+  };
+  // Step 1: Construct the kernel graphs in the order of the segments, so that the graph ids are the same as the serial
+  // compiling.
+  std::vector<SegmentGraph> segment_graphs;
+  for (const auto &segment : segments) {
+    MS_EXCEPTION_IF_NULL(segment);
+    if (segment->nodes_.size() == 0) {
+      MS_LOG(EXCEPTION) << "The segments size is 0.";
+    }
+    SegmentGraph segment_graph{segment, nullptr, {}, nullptr};
+    if (!segment->is_cut_) {
+      MS_EXCEPTION_IF_NULL(segment->nodes_[0]);
+      segment_graph.device_context = device::DeviceContextManager::GetInstance().GetOrCreateDeviceContext(
+        {GetCNodeTarget(segment->nodes_[0]), device_id_});
+      MS_EXCEPTION_IF_NULL(segment_graph.device_context);
+      segment_graph.device_context->Initialize();
+      FuncGraphPtr fg;
+      AnfNodePtrList inputs;
+      std::tie(fg, inputs, segment_graph.outputs) = TransformSegmentToAnfGraph(segment->nodes_);
+      segment_graph.graph =
+        graph_compiler_->ConstructKernelGraph(segment, segment_graph.outputs, segment_graph.device_context, run_mode);
+    }
+    (void)segment_graphs.emplace_back(std::move(segment_graph));
+  }
+
+  // Step 2: Optimize the graphs and create the kernels concurrently, the graphs of the same content as the graphs
+  // compiled before, e.g. the identical stages of a pipeline, may share their kernels.
+  std::vector<std::pair<KernelGraphPtr, const DeviceContext *>> concurrent_graphs;
+  std::vector<size_t> serial_stages;
+  for (size_t i = 0; i < segment_graphs.size(); ++i) {
+    const auto &segment_graph = segment_graphs[i];
+    if (segment_graph.graph == nullptr) {
+      continue;
+    }
+    if (IsConcurrentCompileSupported(segment_graph.segment)) {
+      (void)concurrent_graphs.emplace_back(segment_graph.graph, segment_graph.device_context);
+    } else {
+      (void)serial_stages.emplace_back(i);
+    }
+  }
+  size_t reused_graph_num = 0;
+  {
+    mindspore::ScopedLongRunning long_running;
+    reused_graph_num =
+      graph_compiler_->OptimizeGraphsAndCreateKernels(concurrent_graphs, common::GetEnv(kStageGraphCacheEnv) == "1");
+  }
+  for (const auto i : serial_stages) {
+    graph_compiler_->OptimizeGraphAndCreateKernel(segment_graphs[i].graph, segment_graphs[i].device_context);
+  }
+  MS_LOG(INFO) << "Compile " << concurrent_graphs.size() << " kernel graphs concurrently, " << reused_graph_num
+               << " of them share the kernels of the same graphs compiled before, and " << serial_stages.size()
+               << " kernel graphs serially.";
+
+  // Step 3: Finish compiling the graphs in the order of the segments.
+  for (const auto &segment_graph : segment_graphs) {
+    if (segment_graph.graph == nullptr) {
+      CompileGraph(segment_graph.segment, run_mode);
+      continue;
+    }
+    auto graph_id = graph_compiler_->FinishCompileGraph(segment_graph.graph, segment_graph.outputs,
+                                                        segment_graph.device_context);
+    AddKernelGraph(segment_graph.segment, graph_id, segment_graph.device_context);
+  }
+}
+
+void MindRTBackend::AddKernelGraph(const GraphSegmentPtr &segment, GraphId graph_id, DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(segment);
+  graph_id_to_device_context_[graph_id] = device_context;
+
+  const auto &func_graph = segment->nodes_[0]->func_graph();
+  MS_EXCEPTION_IF_NULL(func_graph);
+  if (func_graph_to_kernel_graph_ids_.find(func_graph) == func_graph_to_kernel_graph_ids_.end()) {
+    (void)func_graph_to_kernel_graph_ids_[func_graph].emplace_back(std::vector<GraphId>{graph_id});
+  } else {
+    (void)func_graph_to_kernel_graph_ids_[func_graph].back().emplace_back(graph_id);
+  }
+}
+
 void MindRTBackend::CompileGraph(const GraphSegmentPtr &segment, device::RunMode run_mode) {
   MS_EXCEPTION_IF_NULL(segment);
   // Compile the normal nodes, which doesn't contain the cut node.
@@ -702,16 +806,7 @@ void MindRTBackend::CompileGraph(const GraphSegmentPtr &segment, device::RunMode
     // Compile graph.
     auto graph_id =
       graph_compiler_->CompileGraph(segment, outputs, device_context, run_mode, real_execution_mode_ == kPynativeMode);
-
-    graph_id_to_device_context_[graph_id] = device_context;
-
-    const auto &func_graph = segment->nodes_[0]->func_graph();
-    MS_EXCEPTION_IF_NULL(func_graph);
-    if (func_graph_to_kernel_graph_ids_.find(func_graph) == func_graph_to_kernel_graph_ids_.end()) {
-      (void)func_graph_to_kernel_graph_ids_[func_graph].emplace_back(std::vector<GraphId>{graph_id});
-    } else {
-      (void)func_graph_to_kernel_graph_ids_[func_graph].back().emplace_back(graph_id);
-    }
+    AddKernelGraph(segment, graph_id, device_context);
   } else {
     // Compile the cut node.
     auto cut_node = segment->nodes_[0];
@@ -1385,9 +1480,12 @@ std::unique_ptr<GraphCompilerInfo> MindRTBackend::ConstructGraphCompilerInfo(con
 
   std::vector<std::vector<int64_t> *> tensors_mask;
   std::vector<std::vector<tensor::TensorPtr> *> input_tensors;
+  // The CPU graphs of many small kernels can run in a static schedule instead of kernel actors.
+  auto strategy = (common::GetEnv("MS_DEV_STATIC_SCHEDULE") == "1") ? runtime::GraphExecutionStrategy::kStaticSchedule
+                                                                     : runtime::GraphExecutionStrategy::kPipeline;
   return std::make_unique<GraphCompilerInfo>(graphs, device_contexts, tensors_mask, input_tensors, control_nodes_,
                                              root_graph->parameters(), parser, outputs_order, outputs_num, name, false,
-                                             runtime::GraphExecutionStrategy::kPipeline);
+                                             strategy);
 }
 
 std::unique_ptr<GraphCompilerInfo> MindRTBackend::ConstructGraphCompilerInfo(
@@ -135,6 +135,12 @@ class BACKEND_EXPORT MindRTBackend : public Backend {
   // Compile the kernel graph by the segment which is from the function graph partition.
   void CompileGraph(const GraphSegmentPtr &segment, device::RunMode run_mode);
 
+  // Compile the kernel graphs of the segments concurrently, see 'GraphCompiler::ConstructKernelGraph'.
+  void CompileGraphConcurrently(const std::vector<GraphSegmentPtr> &segments, device::RunMode run_mode);
+
+  // Record the kernel graph compiled from the segment.
+  void AddKernelGraph(const GraphSegmentPtr &segment, GraphId graph_id, DeviceContext *device_context);
+
   // CreateKernel, Transform and Schedule have not been finished when LazyBuild is enabled in PyNative mode.
   void CompileSingleOpGraph(const KernelGraphPtr &graph, const DeviceContext *device_context,
                             GraphCompilerInfo *graph_compiler_info) const;
@@ -27,6 +27,8 @@ namespace common {
 constexpr size_t kDeviceNum = 8;
 constexpr size_t kMaxThreadNum = 23;
 constexpr size_t kYieldThreshold = 1000;
+// Whether the current thread is a thread of the pool, whose tasks can not wait for the pool again.
+thread_local bool in_sync_run_thread = false;
 
 ThreadPool::ThreadPool() {
   size_t process_core_num = std::thread::hardware_concurrency() - 1;
@@ -52,6 +54,7 @@ void ThreadPool::SyncRunLoop(const std::shared_ptr<ThreadContext> &context) {
   if (context == nullptr) {
     return;
   }
+  in_sync_run_thread = true;
   size_t yield_count = 0;
   while (true) {
     if (exit_run_) {
@@ -93,6 +96,14 @@ bool ThreadPool::SyncRun(const std::vector<Task> &tasks) {
     auto ret = tasks[0]();
     return ret == SUCCESS;
   }
+  // The caller of the outer SyncRun holds the pool and waits for this task, so the nested tasks run serially.
+  if (in_sync_run_thread) {
+    bool success = true;
+    for (const auto &task : tasks) {
+      success = (task() == SUCCESS) && success;
+    }
+    return success;
+  }
   std::unique_lock<std::mutex> lock(pool_mtx_);
   exit_run_ = false;
   size_t task_num = tasks.size();
@@ -169,5 +180,40 @@ ThreadPool::~ThreadPool() {
     // exit
   }
 }
+
+void ParallelRun(size_t task_num, const std::function<void(size_t)> &func, size_t min_task_num_per_thread) {
+  min_task_num_per_thread = std::max(min_task_num_per_thread, static_cast<size_t>(1));
+  const size_t thread_num = in_sync_run_thread ? 1
+                                               : std::min(ThreadPool::GetInstance().GetSyncRunThreadNum(),
+                                                          task_num / min_task_num_per_thread);
+  if (thread_num <= 1) {
+    for (size_t i = 0; i < task_num; ++i) {
+      func(i);
+    }
+    return;
+  }
+  std::mutex exception_mutex;
+  std::exception_ptr exception_ptr = nullptr;
+  std::vector<Task> tasks;
+  const size_t task_num_per_thread = (task_num + thread_num - 1) / thread_num;
+  for (size_t start = 0; start < task_num; start += task_num_per_thread) {
+    const size_t end = std::min(start + task_num_per_thread, task_num);
+    (void)tasks.emplace_back([start, end, &func, &exception_mutex, &exception_ptr]() {
+      try {
+        for (size_t i = start; i < end; ++i) {
+          func(i);
+        }
+      } catch (const std::exception &) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        exception_ptr = std::current_exception();
+      }
+      return SUCCESS;
+    });
+  }
+  (void)ThreadPool::GetInstance().SyncRun(tasks);
+  if (exception_ptr != nullptr) {
+    std::rethrow_exception(exception_ptr);
+  }
+}
 }  // namespace common
 }  // namespace mindspore
@@ -0,0 +1,327 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "frontend/optimizer/layer_dedup.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <sstream>
+#include <tuple>
+#include <vector>
+#include "ir/func_graph.h"
+#include "ir/graph_utils.h"
+#include "ir/tensor.h"
+#include "utils/hash_map.h"
+#include "utils/hash_set.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+// The graphs smaller than this are cheaper to be inlined than to be called.
+constexpr size_t kMinDedupNodeNum = 16;
+// The constant tensors larger than this are compared by their addresses instead of their data.
+constexpr size_t kMaxSignatureTensorSize = 1024;
+// The nested layers are deduplicated from inside to outside, one level in each round.
+constexpr size_t kMaxDedupRound = 16;
+
+struct DedupGraphInfo {
+  FuncGraphPtr func_graph;
+  std::string signature;
+  // The free variables in the order of their first use, which is the same for the graphs of the same signature.
+  std::vector<AnfNodePtr> free_variables;
+  // The uses of the free variables, as the user, the input index and the index in the free_variables.
+  std::vector<std::tuple<CNodePtr, size_t, size_t>> free_variable_uses;
+  std::vector<CNodePtr> call_sites;
+  size_t node_num{0};
+};
+
+std::string AbstractText(const AnfNodePtr &node) {
+  const auto &abs = node->abstract();
+  if (abs == nullptr) {
+    return "";
+  }
+  // The ref key of the weights is not a part of the signature, since it differs in every layer.
+  const auto &shape = abs->BuildShape();
+  const auto &type = abs->BuildType();
+  return (shape == nullptr ? "" : shape->ToString()) + (type == nullptr ? "" : type->ToString());
+}
+
+std::string ValueText(const ValuePtr &value) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (value->isa<Primitive>()) {
+    auto prim = value->cast<PrimitivePtr>();
+    std::map<std::string, std::string> sorted_attrs;
+    for (const auto &attr : prim->attrs()) {
+      if (attr.first == "instance_name") {
+        continue;
+      }
+      sorted_attrs[attr.first] = attr.second == nullptr ? "" : attr.second->DumpText();
+    }
+    std::ostringstream oss;
+    oss << prim->name() << "[";
+    for (const auto &attr : sorted_attrs) {
+      oss << attr.first << "=" << attr.second << ",";
+    }
+    oss << "]";
+    return oss.str();
+  }
+  if (value->isa<tensor::Tensor>()) {
+    auto tensor = value->cast<tensor::TensorPtr>();
+    std::ostringstream oss;
+    oss << "Tensor" << tensor->GetShapeAndDataTypeInfo() << ":";
+    if (tensor->Size() > kMaxSignatureTensorSize) {
+      oss << tensor.get();
+    } else {
+      oss << std::string(static_cast<const char *>(tensor->data_c()), tensor->Size());
+    }
+    return oss.str();
+  }
+  if (value->isa<FuncGraph>()) {
+    // The graphs called by the layer must be the same one, which holds after the inner layers are deduplicated.
+    std::ostringstream oss;
+    oss << "Graph" << value.get();
+    return oss.str();
+  }
+  return value->ToString();
+}
+
+std::string GraphAttrsText(const FuncGraphPtr &func_graph) {
+  std::map<std::string, std::string> sorted_attrs;
+  for (const auto &attr : func_graph->attrs()) {
+    sorted_attrs[attr.first] = attr.second == nullptr ? "" : attr.second->DumpText();
+  }
+  std::ostringstream oss;
+  for (const auto &attr : sorted_attrs) {
+    oss << attr.first << "=" << attr.second << ",";
+  }
+  return oss.str();
+}
+
+bool IsWeight(const AnfNodePtr &node, const FuncGraphManagerPtr &manager) {
+  return node->isa<Parameter>() && node->func_graph() != nullptr && manager->roots().contains(node->func_graph());
+}
+
+// Collect the call sites of the graph, the graph is only deduplicated if all its users call it directly.
+bool GetCallSites(const FuncGraphPtr &func_graph, std::vector<CNodePtr> *call_sites) {
+  for (const auto &iter : func_graph->func_graph_cnodes_index()) {
+    const auto &user_index = iter.first;
+    MS_EXCEPTION_IF_NULL(user_index);
+    auto user = dyn_cast<CNode>(user_index->first);
+    if (user == nullptr || user_index->second != 0 || user->func_graph() == nullptr ||
+        user->func_graph() == func_graph) {
+      return false;
+    }
+    call_sites->push_back(user);
+  }
+  return !call_sites->empty();
+}
+
+// Build the canonical signature of the graph, two graphs have the same signature only if they are the same after
+// their free variables are replaced with each other in the order of their first use.
+bool BuildGraphInfo(const FuncGraphPtr &func_graph, const FuncGraphManagerPtr &manager, DedupGraphInfo *info) {
+  MS_EXCEPTION_IF_NULL(func_graph);
+  if (manager->roots().contains(func_graph) || func_graph->has_flag(FUNC_GRAPH_FLAG_NO_INLINE) ||
+      func_graph->has_flag(FUNC_GRAPH_FLAG_DEFER_INLINE) || func_graph->stub() || func_graph->get_return() == nullptr ||
+      !func_graph->children().empty()) {
+    return false;
+  }
+  if (!GetCallSites(func_graph, &info->call_sites)) {
+    return false;
+  }
+  auto nodes = TopoSort(func_graph->get_return(), SuccIncoming, [&func_graph](const AnfNodePtr &node) {
+    return node->func_graph() == func_graph ? FOLLOW : NOFOLLOW;
+  });
+  if (nodes.size() < kMinDedupNodeNum) {
+    return false;
+  }
+  mindspore::HashMap<AnfNodePtr, size_t> node_ids;
+  mindspore::HashMap<AnfNodePtr, size_t> free_variable_ids;
+  const auto &parameters = func_graph->parameters();
+  std::ostringstream oss;
+  oss << GraphAttrsText(func_graph) << "|" << parameters.size() << "|";
+  for (const auto &node : nodes) {
+    MS_EXCEPTION_IF_NULL(node);
+    (void)node_ids.emplace(node, node_ids.size());
+    if (node->isa<ValueNode>()) {
+      const auto &value = GetValueNode(node);
+      if (value == func_graph) {
+        return false;
+      }
+      oss << "V" << ValueText(value);
+    } else if (node->func_graph() != func_graph) {
+      if (!IsWeight(node, manager)) {
+        return false;
+      }
+      oss << "F" << free_variable_ids.size();
+      (void)free_variable_ids.emplace(node, free_variable_ids.size());
+      info->free_variables.push_back(node);
+    } else if (node->isa<Parameter>()) {
+      auto iter = std::find(parameters.begin(), parameters.end(), node);
+      if (iter == parameters.end()) {
+        return false;
+      }
+      oss << "P" << (iter - parameters.begin());
+    } else {
+      auto cnode = node->cast<CNodePtr>();
+      MS_EXCEPTION_IF_NULL(cnode);
+      oss << "C(";
+      for (size_t i = 0; i < cnode->size(); ++i) {
+        const auto &input = cnode->input(i);
+        oss << node_ids.at(input) << ",";
+        auto fv_iter = free_variable_ids.find(input);
+        if (fv_iter != free_variable_ids.end()) {
+          (void)info->free_variable_uses.emplace_back(cnode, i, fv_iter->second);
+        }
+      }
+      oss << ")";
+    }
+    oss << AbstractText(node) << ";";
+  }
+  info->func_graph = func_graph;
+  info->signature = oss.str();
+  info->node_num = nodes.size();
+  return true;
+}
+
+// Lift the free variables of the representative to its parameters, and call it with the weights of every layer.
+void ShareRepresentative(const std::vector<DedupGraphInfo *> &group, const FuncGraphManagerPtr &manager) {
+  const auto &rep = group.front();
+  const auto &rep_graph = rep->func_graph;
+  auto tr = manager->Transact();
+  std::vector<AnfNodePtr> lifted_parameters;
+  for (const auto &free_variable : rep->free_variables) {
+    auto parameter = std::make_shared<Parameter>(rep_graph);
+    parameter->set_abstract(free_variable->abstract());
+    tr.AddParameter(rep_graph, parameter);
+    lifted_parameters.push_back(parameter);
+  }
+  for (const auto &use : rep->free_variable_uses) {
+    tr.SetEdge(std::get<0>(use), SizeToInt(std::get<1>(use)), lifted_parameters[std::get<2>(use)]);
+  }
+  for (const auto &info : group) {
+    for (const auto &call_site : info->call_sites) {
+      auto graph_node = NewValueNode(rep_graph);
+      graph_node->set_abstract(rep_graph->ToAbstract());
+      std::vector<AnfNodePtr> new_inputs{graph_node};
+      (void)new_inputs.insert(new_inputs.end(), call_site->inputs().begin() + 1, call_site->inputs().end());
+      (void)new_inputs.insert(new_inputs.end(), info->free_variables.begin(), info->free_variables.end());
+      auto new_call = call_site->func_graph()->NewCNode(new_inputs);
+      new_call->set_abstract(call_site->abstract());
+      (void)tr.Replace(call_site, new_call);
+    }
+  }
+  tr.Commit();
+  rep_graph->set_flag(FUNC_GRAPH_FLAG_NO_INLINE, true);
+}
+
+// Deduplicate the groups of identical graphs whose graphs and callers are not changed in this round, and return the
+// number of the deduplicated groups.
+size_t DedupRound(const FuncGraphManagerPtr &manager, std::vector<FuncGraphPtr> *reps, size_t *graph_num,
+                  size_t *total_node_num, size_t *shared_node_num) {
+  std::vector<DedupGraphInfo> infos;
+  infos.reserve(manager->func_graphs().size());
+  for (const auto &func_graph : manager->func_graphs()) {
+    DedupGraphInfo info;
+    if (BuildGraphInfo(func_graph, manager, &info)) {
+      infos.push_back(std::move(info));
+    }
+  }
+  std::vector<std::vector<DedupGraphInfo *>> groups;
+  mindspore::HashMap<std::string, size_t> group_index;
+  for (auto &info : infos) {
+    auto iter = group_index.find(info.signature);
+    if (iter == group_index.end()) {
+      (void)group_index.emplace(info.signature, groups.size());
+      (void)groups.emplace_back(std::vector<DedupGraphInfo *>{&info});
+    } else {
+      groups[iter->second].push_back(&info);
+    }
+  }
+
+  size_t dedup_group_num = 0;
+  mindspore::HashSet<FuncGraphPtr> changed_graphs;
+  for (const auto &group : groups) {
+    if (group.size() < 2) {
+      continue;
+    }
+    bool changed = std::any_of(group.begin(), group.end(), [&changed_graphs](const DedupGraphInfo *info) {
+      return changed_graphs.count(info->func_graph) != 0 ||
+             std::any_of(info->call_sites.begin(), info->call_sites.end(), [&changed_graphs](const CNodePtr &call) {
+               return changed_graphs.count(call->func_graph()) != 0;
+             });
+    });
+    if (changed) {
+      continue;
+    }
+    for (const auto &info : group) {
+      (void)changed_graphs.insert(info->func_graph);
+      for (const auto &call_site : info->call_sites) {
+        (void)changed_graphs.insert(call_site->func_graph());
+      }
+      *total_node_num += info->node_num;
+    }
+    MS_LOG(INFO) << "Layer dedup shares " << group.front()->func_graph->ToString() << " for " << group.size()
+                 << " graphs of " << group.front()->node_num << " nodes, lifted "
+                 << group.front()->free_variables.size() << " weights.";
+    ShareRepresentative(group, manager);
+    reps->push_back(group.front()->func_graph);
+    *graph_num += group.size();
+    *shared_node_num += group.front()->node_num;
+    ++dedup_group_num;
+  }
+  return dedup_group_num;
+}
+}  // namespace
+
+bool LayerDedup(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager) {
+  MS_EXCEPTION_IF_NULL(root);
+  MS_EXCEPTION_IF_NULL(manager);
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<FuncGraphPtr> reps;
+  size_t graph_num = 0;
+  size_t total_node_num = 0;
+  size_t shared_node_num = 0;
+  for (size_t round = 0; round < kMaxDedupRound; ++round) {
+    if (DedupRound(manager, &reps, &graph_num, &total_node_num, &shared_node_num) == 0) {
+      break;
+    }
+  }
+  if (reps.empty()) {
+    MS_LOG(INFO) << "Layer dedup finds no repeated layers in " << root->ToString();
+    return false;
+  }
+  manager->KeepRoots({root});
+  // An inner layer called only by its outer representative has nothing to share, inline it back.
+  for (const auto &rep : reps) {
+    size_t call_num = 0;
+    for (const auto &iter : rep->func_graph_cnodes_index()) {
+      call_num += IntToSize(iter.second);
+    }
+    if (call_num <= 1) {
+      rep->erase_flag(FUNC_GRAPH_FLAG_NO_INLINE);
+    }
+  }
+  const auto cost = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  MS_LOG(INFO) << "Layer dedup shares " << reps.size() << " graphs for " << graph_num << " repeated layers, "
+               << shared_node_num << " of " << total_node_num
+               << " nodes of the layers are left to be optimized and compiled, cost " << cost << " ms.";
+  return true;
+}
+}  // namespace opt
+}  // namespace mindspore
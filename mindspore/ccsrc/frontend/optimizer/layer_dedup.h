@@ -0,0 +1,33 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_LAYER_DEDUP_H_
+#define MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_LAYER_DEDUP_H_
+
+#include "ir/anf.h"
+#include "ir/manager.h"
+
+namespace mindspore {
+namespace opt {
+// Deduplicate the structurally identical graphs of the repeated layers, e.g. the transformer blocks. The graphs which
+// have the same canonical signature, built from their nodes, primitives, constants and abstracts, share one
+// representative graph. The weights used by the representative are lifted to its parameters, every call site passes
+// its own weights, and the representative is kept from being inlined, so that it is optimized, kernel selected and
+// memory planned only once. Return whether any graph is deduplicated.
+bool LayerDedup(const FuncGraphPtr &root, const FuncGraphManagerPtr &manager);
+}  // namespace opt
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_FRONTEND_OPTIMIZER_LAYER_DEDUP_H_
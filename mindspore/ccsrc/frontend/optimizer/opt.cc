@@ -19,6 +19,11 @@
 #include <deque>
 #include <memory>
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <sstream>
 #include <utility>
 
 #include "utils/hash_map.h"
@@ -33,7 +38,11 @@ namespace opt {
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name, const PrimitivePtr &prim,
                                  const RenormAction &renorm_action, bool has_priority_pattern) {
   auto fn = [prim](const AnfNodePtr &node) -> bool { return IsPrimitiveCNode(node, prim); };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action, has_priority_pattern);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action, has_priority_pattern);
+  if (prim != nullptr) {
+    substitution->prim_names_.push_back(prim->name());
+  }
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -54,7 +63,10 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
       return (prim->Hash() == hash) && (prim->name() == name);
     });
   };
-  return std::make_shared<Substitution>(transform, name, fn, renorm_action, has_priority_pattern);
+  auto substitution = std::make_shared<Substitution>(transform, name, fn, renorm_action, has_priority_pattern);
+  (void)std::transform(prims.begin(), prims.end(), std::back_inserter(substitution->prim_names_),
+                       [](const PrimitivePtr &prim) { return prim->name(); });
+  return substitution;
 }
 
 SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std::string &name,
@@ -86,6 +98,8 @@ AnfNodePtr Substitution::operator()(const OptimizerPtr &optimizer, const AnfNode
   return result;
 }
 
+constexpr SeenNum kMaxSeenNum = std::numeric_limits<SeenNum>::max();
+
 static inline bool isTraversable(const AnfNodePtr &node) {
   if (node->isa<CNode>() || node->isa<Parameter>()) {
     return true;
@@ -97,15 +111,23 @@ static inline bool isTraversable(const AnfNodePtr &node) {
   return (value != nullptr) && (value->isa<FuncGraph>() || value->isa<RefKey>());
 }
 
+static double GetElapsedMs(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
 static AnfNodePtr DoTransform(const OptimizerPtr &optimizer, const AnfNodePtr &node,
-                              const SubstitutionPtr &substitution) {
+                              const SubstitutionPtr &substitution, SubstitutionStat *stat) {
   auto manager = optimizer->manager();
   bool is_match = substitution->predicate_(node);
   if (is_match) {
     TraceGuard trace_guard(std::make_shared<TraceOpt>(node->debug_info()));
     ScopeGuard scope_guard(node->scope());
+    const auto start = std::chrono::steady_clock::now();
     auto res = (*substitution)(optimizer, node);
+    ++stat->attempts;
+    stat->cost += GetElapsedMs(start);
     if (res != nullptr && res != node) {
+      ++stat->hits;
 #ifdef ENABLE_PROFILE
       double t = GetTime();
 #endif
@@ -138,11 +160,17 @@ static void UpdateTransformingListForSubstitutions(const AnfNodePtr &node, std::
   }
 }
 
+// The inputs visited after the base_seen are not pushed again.
 static void UpdateTransformingListForIR(const AnfNodePtr &node, std::deque<AnfNodePtr> *todo, bool change,
-                                        const SubstitutionPtr &substitution) {
+                                        const SubstitutionPtr &substitution, SeenNum base_seen) {
+  auto push_unvisited = [todo, base_seen](const AnfNodePtr &input) {
+    if (input != nullptr && input->seen_ <= base_seen) {
+      (void)todo->emplace_back(input);
+    }
+  };
   auto fg = GetValuePtr<FuncGraph>(node);
   if (fg != nullptr) {
-    (void)todo->emplace_back(fg->output());
+    push_unvisited(fg->output());
   }
 
   // If there is a priority pattern in substitution, don't transform the new node,
@@ -153,7 +181,7 @@ static void UpdateTransformingListForIR(const AnfNodePtr &node, std::deque<AnfNo
     auto cnode = dyn_cast_ptr<CNode>(node);
     if (cnode != nullptr) {
       const auto &inputs = cnode->inputs();
-      (void)todo->insert(todo->end(), inputs.cbegin(), inputs.cend());
+      std::for_each(inputs.cbegin(), inputs.cend(), push_unvisited);
     }
   }
 }
@@ -182,7 +210,46 @@ static void UpdateTransformingListWithUserNodes(const OptimizerPtr &optimizer, c
   }
 }
 
-bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const {
+void SubstitutionList::BuildPrimitiveIndex() {
+  std::vector<std::string> prim_names;
+  for (size_t i = 0; i < list_.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(list_[i]);
+    if (list_[i]->prim_names_.empty()) {
+      generic_index_.push_back(i);
+    }
+    (void)prim_names.insert(prim_names.end(), list_[i]->prim_names_.begin(), list_[i]->prim_names_.end());
+  }
+  // Keep the order of the substitutions in the list for each primitive.
+  for (const auto &prim_name : prim_names) {
+    if (primitive_index_.find(prim_name) != primitive_index_.end()) {
+      continue;
+    }
+    auto &indexes = primitive_index_[prim_name];
+    for (size_t i = 0; i < list_.size(); ++i) {
+      const auto &names = list_[i]->prim_names_;
+      if (names.empty() || std::find(names.begin(), names.end(), prim_name) != names.end()) {
+        indexes.push_back(i);
+      }
+    }
+  }
+}
+
+const std::vector<size_t> &SubstitutionList::GetCandidates(const AnfNodePtr &node) const {
+  auto cnode = dyn_cast_ptr<CNode>(node);
+  if (cnode != nullptr && cnode->size() != 0) {
+    auto prim = GetValuePtr<Primitive>(cnode->input(0));
+    if (prim != nullptr) {
+      auto iter = primitive_index_.find(prim->name());
+      if (iter != primitive_index_.end()) {
+        return iter->second;
+      }
+    }
+  }
+  return generic_index_;
+}
+
+bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                                              SubstitutionStats *stats) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
@@ -202,8 +269,8 @@ bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, con
     node->seen_ = seen;
 
     bool change = false;
-    for (auto &substitution : list_) {
-      auto res = DoTransform(optimizer, node, substitution);
+    for (auto index : GetCandidates(node)) {
+      auto res = DoTransform(optimizer, node, list_[index], &(*stats)[index]);
       if (res != nullptr) {
         change = true;
         changes = true;
@@ -221,14 +288,20 @@ bool SubstitutionList::ApplyIRToSubstitutions(const OptimizerPtr &optimizer, con
 }
 
 bool SubstitutionList::ApplySubstitutionToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
-                                             const SubstitutionPtr &substitution) const {
+                                             const SubstitutionPtr &substitution, SubstitutionStat *stat,
+                                             const std::vector<AnfNodePtr> *seeds, SeenNum base_seen,
+                                             std::vector<AnfNodePtr> *dirty_nodes) const {
 #ifdef ENABLE_PROFILE
   double start = GetTime();
 #endif
   FuncGraphManagerPtr manager = optimizer->manager();
   auto seen = NewSeenGeneration();
   std::deque<AnfNodePtr> todo;
-  todo.emplace_back(func_graph->output());
+  if (seeds == nullptr) {
+    todo.emplace_back(func_graph->output());
+  } else {
+    todo.insert(todo.end(), seeds->begin(), seeds->end());
+  }
   bool changes = false;
 
   auto &all_nodes = manager->all_nodes();
@@ -242,13 +315,20 @@ bool SubstitutionList::ApplySubstitutionToIR(const OptimizerPtr &optimizer, cons
     node->seen_ = seen;
 
     bool change = false;
-    auto res = DoTransform(optimizer, node, substitution);
+    auto res = DoTransform(optimizer, node, substitution, stat);
     if (res != nullptr) {
       change = true;
       changes = true;
       node = res;
+      dirty_nodes->push_back(node);
+      auto users_iter = manager->node_users().find(node);
+      if (users_iter != manager->node_users().end()) {
+        for (const auto &user : users_iter->second) {
+          dirty_nodes->push_back(user.first);
+        }
+      }
     }
-    UpdateTransformingListForIR(node, &todo, change, substitution);
+    UpdateTransformingListForIR(node, &todo, change, substitution, seeds == nullptr ? kMaxSeenNum : base_seen);
     UpdateTransformingListWithUserNodes(optimizer, node, &todo, change, seen);
   }
 
@@ -276,7 +356,8 @@ void SubstitutionList::DisplayStatusOfSubstitution(const mindspore::HashMap<std:
   MS_LOG(DEBUG) << ss.str();
 }
 
-bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const {
+bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                                              SubstitutionStats *stats) const {
   // Add for substitution status counting
   size_t space = 0;
   mindspore::HashMap<std::string, std::vector<bool>> status;
@@ -286,13 +367,28 @@ bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, con
     }
   }
 
+  // The first round sweeps the whole graph for each substitution, the later rounds only revisit the nodes changed
+  // since the last run of each substitution, and the unvisited nodes under them.
   bool changes = false;
   bool loop = true;
+  bool first_round = true;
+  auto base_seen = NewSeenGeneration();
+  std::vector<AnfNodePtr> dirty_nodes;
+  std::vector<size_t> last_dirty_pos(list_.size(), 0);
   while (loop) {
     loop = false;
     for (size_t i = 0; i < list_.size(); i++) {
       const auto &substitution = list_[i];
-      bool change = ApplySubstitutionToIR(optimizer, func_graph, substitution);
+      bool change = false;
+      if (first_round) {
+        change = ApplySubstitutionToIR(optimizer, func_graph, substitution, &(*stats)[i], nullptr, base_seen,
+                                       &dirty_nodes);
+      } else if (last_dirty_pos[i] < dirty_nodes.size()) {
+        std::vector<AnfNodePtr> seeds(dirty_nodes.begin() + SizeToLong(last_dirty_pos[i]), dirty_nodes.end());
+        change = ApplySubstitutionToIR(optimizer, func_graph, substitution, &(*stats)[i], &seeds, base_seen,
+                                       &dirty_nodes);
+      }
+      last_dirty_pos[i] = dirty_nodes.size();
       changes = changes || change;
       loop = loop || change;
 #ifdef ENABLE_DUMP_IR
@@ -317,6 +413,7 @@ bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, con
     if (is_once_) {
       break;
     }
+    first_round = false;
   }
 
   // Display the status of each substitution
@@ -326,11 +423,27 @@ bool SubstitutionList::ApplySubstitutionsToIR(const OptimizerPtr &optimizer, con
   return changes;
 }
 
+void SubstitutionList::DisplayStatistics(const OptimizerPtr &optimizer, const SubstitutionStats &stats,
+                                         double cost) const {
+  std::ostringstream oss;
+  oss << "Pass " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_" << optimizer->CurPass_.name
+      << " costs " << std::fixed << std::setprecision(3) << cost << " ms, attempts/hits/ms of the substitutions:";
+  for (size_t i = 0; i < list_.size(); ++i) {
+    if (stats[i].attempts == 0) {
+      continue;
+    }
+    oss << " " << list_[i]->name_ << " " << stats[i].attempts << "/" << stats[i].hits << "/" << stats[i].cost;
+  }
+  MS_LOG(INFO) << oss.str();
+}
+
 bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const {
   MS_EXCEPTION_IF_NULL(optimizer);
   MS_EXCEPTION_IF_NULL(func_graph);
   FuncGraphManagerPtr manager = optimizer->manager();
   manager->AddFuncGraph(func_graph);
+  const auto start = std::chrono::steady_clock::now();
+  SubstitutionStats stats(list_.size());
   bool changes = false;
   static const auto traverse_mode =
     (common::GetEnv("MS_DEV_TRAVERSE_SUBSTITUTIONS_MODE") != "1" ? kOptTraverseFromIRToSubstitutions
@@ -340,12 +453,17 @@ bool SubstitutionList::operator()(const FuncGraphPtr &func_graph, const Optimize
       optimizer->traverse_nodes_first() && !is_once_ && !global_sensitive_) {
     MS_LOG(DEBUG) << "IR >> SUB, " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_"
                   << optimizer->CurPass_.name;
-    changes = ApplyIRToSubstitutions(optimizer, func_graph);
+    changes = ApplyIRToSubstitutions(optimizer, func_graph, &stats);
   } else {
     MS_LOG(DEBUG) << "SUB >> IR, " << optimizer->name() << "(r" << optimizer->CurPass_.counter << ")_"
                   << optimizer->CurPass_.name;
-    changes = ApplySubstitutionsToIR(optimizer, func_graph);
+    changes = ApplySubstitutionsToIR(optimizer, func_graph, &stats);
+  }
+  last_cost_ = GetElapsedMs(start);
+  if (IS_OUTPUT_ON(mindspore::INFO)) {
+    DisplayStatistics(optimizer, stats, last_cost_);
   }
+  last_stats_ = std::move(stats);
   return changes;
 }
 
@@ -48,6 +48,8 @@ class Substitution {
   RenormAction renorm_action_;
   // Determine whether it is a priority substitution, that is, some patterns need to be matched prior to others.
   bool has_priority_pattern_{false};
+  // The names of the primitives whose cnodes are the only ones the substitution matches, empty if it may match any node.
+  std::vector<std::string> prim_names_;
 
   Substitution(const OptimizerCallerPtr &transform, const std::string &name, const PredicateFuncType &predicate,
                const RenormAction &renorm_action, bool has_priority_pattern)
@@ -71,26 +73,57 @@ SubstitutionPtr MakeSubstitution(const OptimizerCallerPtr &transform, const std:
                                  const PredicateFuncType &predicate, const RenormAction &renorm_action = CHECK_RENORM,
                                  bool has_priority_pattern = false);
 
+struct SubstitutionStat {
+  // The number of the nodes matched by the predicate, and the number of them transformed.
+  size_t attempts{0};
+  size_t hits{0};
+  // The time cost of the transforms in milliseconds.
+  double cost{0};
+};
+using SubstitutionStats = std::vector<SubstitutionStat>;
+
 enum OptTraverseSubstitutionsMode { kOptTraverseFromIRToSubstitutions = 0, kOptTraverseFromSubstitutionsToIR };
 
 class SubstitutionList {
  public:
   explicit SubstitutionList(const std::vector<SubstitutionPtr> &patterns, bool is_once = false,
                             bool global_sensitive = false)
-      : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {}
+      : list_(patterns), is_once_(is_once), global_sensitive_(global_sensitive) {
+    BuildPrimitiveIndex();
+  }
   ~SubstitutionList() = default;
 
   bool operator()(const FuncGraphPtr &func_graph, const OptimizerPtr &optimizer) const;
 
+  // The attempts, hits and time cost of each substitution in the last run, in the order of the list.
+  const SubstitutionStats &last_stats() const { return last_stats_; }
+  // The time cost of the last run in milliseconds.
+  double last_cost() const { return last_cost_; }
+
  private:
-  bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
+  void BuildPrimitiveIndex();
+  const std::vector<size_t> &GetCandidates(const AnfNodePtr &node) const;
+  bool ApplyIRToSubstitutions(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                              SubstitutionStats *stats) const;
+  // Apply the substitution from the output of the graph if the seeds is null, otherwise only from the seeds, and
+  // the nodes visited since the base_seen are not visited again. The changed nodes and their users are appended to the
+  // dirty_nodes.
   bool ApplySubstitutionToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
-                             const SubstitutionPtr &substitution) const;
-  bool ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph) const;
+                             const SubstitutionPtr &substitution, SubstitutionStat *stat,
+                             const std::vector<AnfNodePtr> *seeds, SeenNum base_seen,
+                             std::vector<AnfNodePtr> *dirty_nodes) const;
+  bool ApplySubstitutionsToIR(const OptimizerPtr &optimizer, const FuncGraphPtr &func_graph,
+                              SubstitutionStats *stats) const;
   void DisplayStatusOfSubstitution(const mindspore::HashMap<std::string, std::vector<bool>> &status,
                                    const OptimizerPtr &optimizer, size_t space) const;
+  void DisplayStatistics(const OptimizerPtr &optimizer, const SubstitutionStats &stats, double cost) const;
 
   std::vector<SubstitutionPtr> list_;
+  // The indexes of the substitutions to try on the cnodes of each primitive, and the ones to try on the other nodes.
+  mindspore::HashMap<std::string, std::vector<size_t>> primitive_index_;
+  std::vector<size_t> generic_index_;
+  mutable SubstitutionStats last_stats_;
+  mutable double last_cost_{0};
   // a flag to mark this list of Substitution can only be executed only once
   bool is_once_{false};
   bool global_sensitive_{false};
@@ -15,13 +15,40 @@
  */
 
 #include "frontend/parallel/auto_parallel/costmodel.h"
+#include <atomic>
 #include <cmath>
 #include <numeric>
 #include <utility>
 #include "frontend/parallel/auto_parallel/graph_costmodel.h"
+#include "include/common/thread_pool.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+// The minimum number of tasks of each thread, below which running in parallel does not pay off.
+constexpr size_t kMinParallelTaskNum = 4;
+std::atomic<bool> keep_cheapest_cost_only{false};
+
+void KeepCheapestCost(CostPtrList *clist_ptrs, bool is_training) {
+  MS_EXCEPTION_IF_NULL(clist_ptrs);
+  if (clist_ptrs->size() <= 1) {
+    return;
+  }
+  const auto alpha = CostModelContext::GetInstance()->costmodel_alpha();
+  const auto beta = CostModelContext::GetInstance()->costmodel_beta();
+  auto total_cost = [alpha, beta, is_training](const CostPtr &cost) {
+    return alpha * cost->computation_cost_ +
+           beta * (is_training ? cost->communication_with_partial_para_ : cost->communication_forward_);
+  };
+  auto cheapest = std::min_element(clist_ptrs->begin(), clist_ptrs->end(),
+                                   [&total_cost](const CostPtr &l, const CostPtr &r) {
+                                     return total_cost(l) < total_cost(r);
+                                   });
+  CostPtrList ret = {*cheapest};
+  *clist_ptrs = std::move(ret);
+}
+}  // namespace
+
 void Simplify(CostPtrList *clist_ptrs) {
   const auto run_phase = CostModelContext::GetInstance()->run_phase();
   if (run_phase == TRAINING_PHASE) {
@@ -31,7 +58,25 @@ void Simplify(CostPtrList *clist_ptrs) {
     // inference phase
     SimplifyForDecreasingCommunicationForward(clist_ptrs);
   }
+  if (KeepCheapestCostOnly()) {
+    KeepCheapestCost(clist_ptrs, run_phase == TRAINING_PHASE);
+  }
 }
+
+void SetKeepCheapestCostOnly(bool keep) { keep_cheapest_cost_only = keep; }
+
+bool KeepCheapestCostOnly() { return keep_cheapest_cost_only; }
+
+void ParallelSearch(size_t task_num, const std::function<void(size_t)> &func) {
+  if (!CostModelContext::GetInstance()->dp_algo_parallel_search()) {
+    for (size_t i = 0; i < task_num; ++i) {
+      func(i);
+    }
+    return;
+  }
+  common::ParallelRun(task_num, func, kMinParallelTaskNum);
+}
+
 void SimplifyForDecreasingCommunicationForward(CostPtrList *clist_ptrs) {
   // Sort the cost_list with the computation_cost_ increasing, and communication_forward decreasing order. This method
   // excludes the cost with greater computation_cost_ and greater communication_forward.
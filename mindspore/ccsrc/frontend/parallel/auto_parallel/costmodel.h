@@ -18,6 +18,7 @@
 #define MINDSPORE_CCSRC_FRONTEND_PARALLEL_AUTO_PARALLEL_COSTMODEL_H_
 
 #include <algorithm>
+#include <functional>
 #include <memory>
 #include <string>
 #include <utility>
@@ -365,6 +366,12 @@ void Simplify(CostPtrList *clist);
 void SimplifyForDecreasingCommunicationForward(CostPtrList *clist_ptrs);
 void SimplifyForDecreasingCommunicationWithPartialPara(CostPtrList *clist_ptrs);
 void RefineForPracticalCost(const CostPtr &, bool is_redistribution);
+// Keep only the cheapest cost in each cost list created by 'Simplify'. It is set when the time budget of the strategy
+// searching is exhausted, so that the rest of the searching finishes quickly with the best strategies found so far.
+void SetKeepCheapestCostOnly(bool keep);
+bool KeepCheapestCostOnly();
+// Run the tasks of the strategy searching by common::ParallelRun, or serially if 'dp_algo_parallel_search' is disabled.
+void ParallelSearch(size_t task_num, const std::function<void(size_t)> &func);
 }  // namespace parallel
 }  // namespace mindspore
 
@@ -16,22 +16,67 @@
 
 #include "frontend/parallel/auto_parallel/dp_algo_costmodel.h"
 
+#include <chrono>
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace mindspore {
 namespace parallel {
+namespace {
+double GetElapsedTime(const std::chrono::steady_clock::time_point &start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// The number and the time in seconds of the eliminations of each kind.
+class EliminationTimer {
+ public:
+  void Start() { start_ = std::chrono::steady_clock::now(); }
+  void Stop(const std::string &kind) {
+    auto &item = items_[kind];
+    ++item.first;
+    item.second += GetElapsedTime(start_);
+  }
+  void Print() const {
+    for (const auto &item : items_) {
+      MS_LOG(INFO) << item.first << " elimination: " << item.second.first << " times, " << item.second.second << " s.";
+    }
+  }
+
+ private:
+  std::chrono::steady_clock::time_point start_;
+  std::map<std::string, std::pair<size_t, double>> items_;
+};
+
+void CheckSearchTimeBudget(const std::chrono::steady_clock::time_point &start) {
+  const auto time_budget = CostModelContext::GetInstance()->dp_algo_time_budget();
+  if (time_budget <= 0 || KeepCheapestCostOnly() || GetElapsedTime(start) <= time_budget) {
+    return;
+  }
+  MS_LOG(WARNING) << "The strategy searching exceeds the time budget " << time_budget
+                  << " s, the rest of the searching only keeps the cheapest cost under each strategy, and the result "
+                     "may be suboptimal.";
+  SetKeepCheapestCostOnly(true);
+}
+}  // namespace
+
 Status GetStrategy(const CostGraphPtr &graph) {
   MS_LOG(INFO) << "Searching strategies begins.";
   MS_EXCEPTION_IF_NULL(graph);
   std::vector<EliminationPtr> eliminations;
   bool flag = true;
+  const auto search_start = std::chrono::steady_clock::now();
+  EliminationTimer timer;
+  SetKeepCheapestCostOnly(false);
 
   // Phase 1: Shrink the CostGraph using 6 operations, and record them in the order.
   // Note: the checking and applying of the 6 operations MUST in current order.
   while (flag) {
+    CheckSearchTimeBudget(search_start);
     flag = false;
+    timer.Start();
     auto node = graph->CheckOpElimination();
     if (node != nullptr) {
       // Applying the Operator Elimination
@@ -41,6 +86,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
       auto n_edge = graph->EliminationOp(node);
       auto elimi_op = std::make_shared<OpElimination>(n_edge, l_edge, node, r_edge);
       (void)eliminations.emplace_back(std::move(elimi_op));
+      timer.Stop("Op");
     }
     if (!flag) {
       auto edges = graph->CheckEdgeElimination();
@@ -50,6 +96,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         auto new_edge = graph->EliminationEdges(edges);
         auto elimi_edge = std::make_shared<EdgeElimination>(new_edge, edges);
         (void)eliminations.emplace_back(std::move(elimi_edge));
+        timer.Stop("Edge");
       }
     }
     if (!flag) {
@@ -61,6 +108,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         auto target_node = graph->EliminationMerge(merge_node);
         auto elimi_merge = std::make_shared<MergeElimination>(merge_node, succ_edge, target_node);
         (void)eliminations.emplace_back(std::move(elimi_merge));
+        timer.Stop("Merge");
       }
     }
     if (!flag) {
@@ -72,6 +120,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         auto target_node = graph->EliminationContract(contracted_node);
         auto elimi_contract = std::make_shared<ContractElimination>(target_node, prev_edge, contracted_node);
         (void)eliminations.emplace_back(std::move(elimi_contract));
+        timer.Stop("Contract");
       }
     }
     if (!flag) {
@@ -96,6 +145,7 @@ Status GetStrategy(const CostGraphPtr &graph) {
         auto elimi_tri =
           std::make_shared<TriangleElimination>(eliminated_node, left_edge, left_node_cpy, right_edge, right_node);
         (void)eliminations.emplace_back(std::move(elimi_tri));
+        timer.Stop("Triangle");
       }
     }
     if (!flag) {
@@ -111,19 +161,26 @@ Status GetStrategy(const CostGraphPtr &graph) {
         }
         auto elimi_star = std::make_shared<StarElimination>(star_center, succ_edges, succ_nodes);
         (void)eliminations.emplace_back(std::move(elimi_star));
+        timer.Stop("Star");
       }
     }
   }
+  const auto elimination_time = GetElapsedTime(search_start);
+  SetKeepCheapestCostOnly(false);
 
   // Phase 2: Search the cost_list in the final graph, and determine the optimal one
   if (graph->SearchStrategy() != SUCCESS) {
     MS_LOG(ERROR) << "Searching strategy for the final failed.";
     return FAILED;
   }
+  const auto final_search_time = GetElapsedTime(search_start) - elimination_time;
 
   // Phase 3: Recover the original CostGraph, the determine strategy for each operator
   if (RecoverStrategy(eliminations) == SUCCESS) {
-    MS_LOG(INFO) << "Searching strategies ends.";
+    timer.Print();
+    MS_LOG(INFO) << "Searching strategies ends, " << eliminations.size() << " eliminations: " << elimination_time
+                 << " s, final graph searching: " << final_search_time
+                 << " s, recovering: " << GetElapsedTime(search_start) - elimination_time - final_search_time << " s.";
     return SUCCESS;
   } else {
     MS_LOG(EXCEPTION) << "Searching strategies failed.";
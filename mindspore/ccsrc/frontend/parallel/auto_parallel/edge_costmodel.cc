@@ -208,22 +208,35 @@ CostPtrList Edge::CreateEdgeEliminationCostList(const StrategyPtr &output_st_ptr
 }
 
 void Edge::EdgeEliminationSetNewCost(OperatorInfoPtr, const std::vector<EdgePtr> &edges, OperatorInfoPtr) {
-  bool valid = false;
+  const auto keys = GetStrategyPairs();
+  std::vector<CostPtrList> clists(keys.size());
+  ParallelSearch(keys.size(), [this, &keys, &clists, &edges](size_t index) {
+    clists[index] = CreateEdgeEliminationCostList(keys[index].first, edges, keys[index].second);
+  });
+  if (!SetNewCostMap(keys, &clists)) {
+    MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
+  }
+}
+
+std::vector<CostPtrKey> Edge::GetStrategyPairs() const {
+  std::vector<CostPtrKey> keys;
+  keys.reserve(pre_op_output_.size() * next_op_input_.size());
   for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
     for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-      CostPtrList clist = CreateEdgeEliminationCostList(output_st_ptr, edges, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
-        valid = true;
-      }
+      (void)keys.emplace_back(output_pair.first, input_pair.first);
     }
   }
-  if (!valid) {
-    MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
+  return keys;
+}
+
+bool Edge::SetNewCostMap(const std::vector<CostPtrKey> &keys, std::vector<CostPtrList> *clists) {
+  MS_EXCEPTION_IF_NULL(clists);
+  bool valid = false;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    valid = valid || !(*clists)[i].empty();
+    cost_map_[keys[i]] = std::move((*clists)[i]);
   }
+  return valid;
 }
 
 void Edge::CreateOpEliminationSubCostList(StrategyPtr op_strategy, const CostPtrList &left_cost_list,
@@ -280,21 +293,12 @@ CostPtrList Edge::CreateOpEliminationCostList(const EdgePtr &e1, const StrategyP
 }
 
 void Edge::OpEliminationSetNewCost(const EdgePtr &e1, const OperatorInfoPtr &op, const EdgePtr &e2) {
-  bool valid = false;
-  for (const auto &output_pair : pre_op_output_) {
-    StrategyPtr output_st_ptr = output_pair.first;
-    for (const auto &input_pair : next_op_input_) {
-      StrategyPtr input_st_ptr = input_pair.first;
-
-      CostPtrList clist = CreateOpEliminationCostList(e1, output_st_ptr, op, e2, input_st_ptr);
-      CostPtrKey key = {output_st_ptr, input_st_ptr};
-      cost_map_[key] = clist;
-      if ((!valid) && (!clist.empty())) {
-        valid = true;
-      }
-    }
-  }
-  if (!valid) {
+  const auto keys = GetStrategyPairs();
+  std::vector<CostPtrList> clists(keys.size());
+  ParallelSearch(keys.size(), [this, &keys, &clists, &e1, &op, &e2](size_t index) {
+    clists[index] = CreateOpEliminationCostList(e1, keys[index].first, op, e2, keys[index].second);
+  });
+  if (!SetNewCostMap(keys, &clists)) {
     MS_LOG(EXCEPTION) << "Creating edge: " << edge_name_ << " failed.";
   }
 }
@@ -156,6 +156,11 @@ class Edge {
   bool CheckStrategyCostPossibility() const;
 
  private:
+  // All the pairs of the strategies of prev_op_ and next_op_, which are the keys of 'cost_map_'
+  std::vector<CostPtrKey> GetStrategyPairs() const;
+  // Set the costlists created for the strategy pairs to 'cost_map_', and return whether any of them is available
+  bool SetNewCostMap(const std::vector<CostPtrKey> &keys, std::vector<CostPtrList> *clists);
+
   std::string edge_name_;
   std::shared_ptr<OperatorInfo> prev_op_, next_op_;
   std::map<CostPtrKey, CostPtrList> cost_map_;
@@ -29,6 +29,13 @@ namespace mindspore {
 namespace parallel {
 CostGraphPtr entire_costgraph = nullptr;
 
+namespace {
+bool HasAvailableCost(const std::vector<std::shared_ptr<StrategyWithCost>> &stra_costs) {
+  return std::any_of(stra_costs.begin(), stra_costs.end(),
+                     [](const std::shared_ptr<StrategyWithCost> &stra_cost) { return !stra_cost->cost_list.empty(); });
+}
+}  // namespace
+
 void CostGraph::Init() {
   inputs_tensor_name_list_.clear();
   tuple_getitem_list_.clear();
@@ -1230,15 +1237,17 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) const {
   MS_EXCEPTION_IF_NULL(target_op);
   MS_EXCEPTION_IF_NULL(edge_ptr);
   MS_LOG(INFO) << "Now merging " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
-
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
+  // The new costlists of the strategies of the target_op are independent, and created in parallel.
+  const auto tar_stra_costs = target_op->GetStrategyCost();
+  const auto op_stra_costs = op->GetStrategyCost();
+  ParallelSearch(tar_stra_costs.size(), [this, &tar_stra_costs, &op_stra_costs, &edge_ptr](size_t index) {
+    auto &tar_stra_cost = tar_stra_costs[index];
     MS_EXCEPTION_IF_NULL(tar_stra_cost);
     auto tar_stra = tar_stra_cost->strategy_ptr;
     auto tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
-    for (auto &op_stra_cost : op->GetStrategyCost()) {
+    for (auto &op_stra_cost : op_stra_costs) {
       MS_EXCEPTION_IF_NULL(op_stra_cost);
       auto op_stra = op_stra_cost->strategy_ptr;
       auto op_clist = op_stra_cost->cost_list;
@@ -1249,10 +1258,8 @@ OperatorInfoPtr CostGraph::EliminationMerge(const OperatorInfoPtr &op) const {
     Simplify(&tar_clist_new);
     // Set the new costlist w.r.t the strategy
     tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
-      valid = true;
-    }
-  }
+  });
+  bool valid = HasAvailableCost(tar_stra_costs);
 
   if (!valid) {
     MS_LOG(EXCEPTION) << "Merging " << op->name() << " into " << target_op->name() << " failed.";
@@ -1312,15 +1319,17 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) const
   auto target_op = op->GetAlivePrevEdges()[0]->prev_operator();
   auto edge_ptr = op->GetAlivePrevEdges()[0];
   MS_LOG(INFO) << "Now contracting " << op->name() << " into " << target_op->name() << ".";
-  bool valid = false;
-
-  for (auto &tar_stra_cost : target_op->GetStrategyCost()) {
+  // The new costlists of the strategies of the target_op are independent, and created in parallel.
+  const auto tar_stra_costs = target_op->GetStrategyCost();
+  const auto op_stra_costs = op->GetStrategyCost();
+  ParallelSearch(tar_stra_costs.size(), [this, &tar_stra_costs, &op_stra_costs, &edge_ptr](size_t index) {
+    auto &tar_stra_cost = tar_stra_costs[index];
     MS_EXCEPTION_IF_NULL(tar_stra_cost);
     auto tar_stra = tar_stra_cost->strategy_ptr;
     auto tar_clist_origin = tar_stra_cost->cost_list;
     CostPtrList tar_clist_new;
 
-    for (auto &op_stra_cost : op->GetStrategyCost()) {
+    for (auto &op_stra_cost : op_stra_costs) {
       MS_EXCEPTION_IF_NULL(op_stra_cost);
       auto op_stra = op_stra_cost->strategy_ptr;
       auto op_clist = op_stra_cost->cost_list;
@@ -1331,10 +1340,8 @@ OperatorInfoPtr CostGraph::EliminationContract(const OperatorInfoPtr &op) const
     Simplify(&tar_clist_new);
     // Set the new costlist w.r.t the strategy
     tar_stra_cost->cost_list = tar_clist_new;
-    if ((!valid) && (!tar_clist_new.empty())) {
-      valid = true;
-    }
-  }
+  });
+  bool valid = HasAvailableCost(tar_stra_costs);
   if (!valid) {
     MS_LOG(EXCEPTION) << "Contracting " << op->name() << " into " << target_op->name() << " failed.";
   }
@@ -1433,21 +1440,24 @@ OperatorInfoPtr CostGraph::EliminationTriangle(const OperatorInfoPtr &elimi_op,
     left_edge = right_edge;
     right_edge = tmp;
   }
-  bool valid = false;
-
-  for (auto &left_node_stra_cost : left_node->GetStrategyCost()) {
+  // The new costlists of the strategies of the left_node are independent, and created in parallel.
+  const auto left_node_stra_costs = left_node->GetStrategyCost();
+  const auto elimi_op_stra_costs = elimi_op->GetStrategyCost();
+  const auto right_node_stra_costs = right_node->GetStrategyCost();
+  ParallelSearch(left_node_stra_costs.size(), [&](size_t index) {
+    auto &left_node_stra_cost = left_node_stra_costs[index];
     MS_EXCEPTION_IF_NULL(left_node_stra_cost);
     auto left_node_stra = left_node_stra_cost->strategy_ptr;
     auto left_node_clist_origin = left_node_stra_cost->cost_list;
     CostPtrList left_node_clist_new;
 
-    for (auto &elimi_op_stra_cost : elimi_op->GetStrategyCost()) {
+    for (auto &elimi_op_stra_cost : elimi_op_stra_costs) {
       MS_EXCEPTION_IF_NULL(elimi_op_stra_cost);
       auto elimi_op_stra = elimi_op_stra_cost->strategy_ptr;
       auto elimi_op_clist = elimi_op_stra_cost->cost_list;
       auto left_edge_clist = left_edge->GetCostList(elimi_op_stra, left_node_stra);
 
-      for (auto &right_node_stra_cost : right_node->GetStrategyCost()) {
+      for (auto &right_node_stra_cost : right_node_stra_costs) {
         MS_EXCEPTION_IF_NULL(right_node_stra_cost);
         auto right_node_stra = right_node_stra_cost->strategy_ptr;
         auto right_node_clist = right_node_stra_cost->cost_list;
@@ -1461,10 +1471,8 @@ OperatorInfoPtr CostGraph::EliminationTriangle(const OperatorInfoPtr &elimi_op,
     Simplify(&left_node_clist_new);
     // Set the new costlist w.r.t the strategy
     left_node_stra_cost->cost_list = left_node_clist_new;
-    if ((!valid) && (!left_node_clist_new.empty())) {
-      valid = true;
-    }
-  }
+  });
+  bool valid = HasAvailableCost(left_node_stra_costs);
 
   if (!valid) {
     MS_LOG(EXCEPTION) << "Eliminating triangle: " << elimi_op->name()
@@ -57,6 +57,7 @@ void CostModelContext::ResetCostModel() {
   costmodel_allreduce_fusion_computation_time_parameter_ =
     DEFAULT_COST_MODEL_ALLREDUCE_FUSION_COMPUTATION_TIME_PARAMETER;
   dp_algo_single_loop_ = DEFAULT_DP_ALGO_SINGLE_LOOP;
+  dp_algo_parallel_search_ = DEFAULT_DP_ALGO_PARALLEL_SEARCH;
 }
 
 void CostModelContext::ResetAlgoParameters() {
@@ -68,6 +69,7 @@ void CostModelContext::ResetAlgoParameters() {
   triangle_star_strategy_overwrite_ = DEFAULT_TRIANGLE_STAR_STRATEGY_OVERWRITE;
   dp_algo_enable_approxi_ = DEFAULT_DP_ALGO_ENABLE_APPROX;
   dp_algo_approxi_epsilon_ = DEFAULT_DP_ALGO_APPROX_EPSILON;
+  dp_algo_time_budget_ = DEFAULT_DP_ALGO_TIME_BUDGET;
 }
 
 void CostModelContext::PrintCostModel() {
@@ -83,7 +85,9 @@ void CostModelContext::PrintCostModel() {
   MS_LOG(INFO) << "triangle_star_strategy_overwrite: " << triangle_star_strategy_overwrite_ << ".";
   MS_LOG(INFO) << "dp_algo_enable_approxi: " << dp_algo_enable_approxi_ << ".";
   MS_LOG(INFO) << "dp_algo_approxi_epsilon: " << dp_algo_approxi_epsilon_ << ".";
+  MS_LOG(INFO) << "dp_algo_time_budget: " << dp_algo_time_budget_ << ".";
   MS_LOG(INFO) << "dp_algo_single_loop: " << dp_algo_single_loop_ << ".";
+  MS_LOG(INFO) << "dp_algo_parallel_search: " << dp_algo_parallel_search_ << ".";
   MS_LOG(INFO) << "run_phase: " << run_phase_ << ".";
   MS_LOG(INFO) << "tensor_slice_alignment_enable: " << tensor_slice_alignment_enable_ << ".";
   MS_LOG(INFO) << "tensor_slice_align_size: " << tensor_slice_alignment_size_ << ".";
@@ -104,6 +108,13 @@ void CostModelContext::set_dp_algo_approxi_epsilon(double epsilon) {
   dp_algo_approxi_epsilon_ = epsilon;
 }
 
+void CostModelContext::set_dp_algo_time_budget(double time_budget) {
+  if (time_budget < 0) {
+    MS_LOG(EXCEPTION) << "'algo_time_budget' must be non-negative.";
+  }
+  dp_algo_time_budget_ = time_budget;
+}
+
 void CostModelContext::set_dp_algo_enable_approxi(bool approxi) {
   if (approxi) {
     MS_LOG(INFO) << "dp_algo_enable_approx: true.";
@@ -266,6 +277,11 @@ void CostModelContext::set_dp_algo_single_loop(bool single_loop) {
   dp_algo_single_loop_ = single_loop;
 }
 
+void CostModelContext::set_dp_algo_parallel_search(bool parallel_search) {
+  MS_LOG(INFO) << "dp_algo_parallel_search: " << (parallel_search ? "true." : "false.");
+  dp_algo_parallel_search_ = parallel_search;
+}
+
 struct CostRegister {
   CostRegister() {
     MsContext::device_seter([](const std::string &device_target) {
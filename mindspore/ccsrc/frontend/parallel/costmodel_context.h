@@ -46,6 +46,8 @@ constexpr size_t DEFAULT_TENSOR_SLICE_ALIGNMENT_SIZE = 16;
 #define DEFAULT_DP_ALGO_ENABLE_APPROX false
 constexpr float DEFAULT_DP_ALGO_APPROX_EPSILON = 0.1;
 #define DEFAULT_DP_ALGO_SINGLE_LOOP false
+#define DEFAULT_DP_ALGO_PARALLEL_SEARCH true
+constexpr float DEFAULT_DP_ALGO_TIME_BUDGET = 0.0;
 constexpr int64_t TRAINING_PHASE = 0;
 
 class CostModelContext {
@@ -150,9 +152,15 @@ class CostModelContext {
   void set_dp_algo_enable_approxi(bool approxi);
   bool dp_algo_enable_approxi() const { return dp_algo_enable_approxi_; }
 
+  void set_dp_algo_time_budget(double time_budget);
+  double dp_algo_time_budget() const { return dp_algo_time_budget_; }
+
   void set_dp_algo_single_loop(bool single_loop);
   bool dp_algo_single_loop() const { return dp_algo_single_loop_; }
 
+  void set_dp_algo_parallel_search(bool parallel_search);
+  bool dp_algo_parallel_search() const { return dp_algo_parallel_search_; }
+
  private:
   CostModelContext();
   static std::shared_ptr<CostModelContext> cm_context_inst_;
@@ -194,9 +202,15 @@ class CostModelContext {
   // When APPROXIMATION is enabled in the DP algorithm, the 'epsilon' value used in the APPROXIMATION.
   double dp_algo_approxi_epsilon_;
 
+  // The time budget in seconds of the DP algorithm, 0 means unlimited
+  double dp_algo_time_budget_;
+
   // Whether to generate a single suite of OperatorInfo for a loop.
   bool dp_algo_single_loop_;
 
+  // Whether to run the DP algorithm on the thread pool and reuse the strategies and costs of the identical operators.
+  bool dp_algo_parallel_search_;
+
   int64_t run_phase_;  // 0: 'training', 1: 'inference'
 
   int64_t costmodel_allreduce_fusion_algorithm_;
@@ -27,6 +27,7 @@
 #include "mindspore/core/utils/ms_context.h"
 #include "include/common/utils/anfalgo.h"
 #include "include/common/debug/draw.h"
+#include "include/common/thread_pool.h"
 #ifdef WITH_BACKEND
 #include "ps/ps_context.h"
 #endif
@@ -35,7 +36,9 @@ namespace mindspore {
 namespace parallel {
 bool OperatorLabel::operator<(const OperatorLabel &label) const { return to_string() < label.to_string(); }
 
-bool OperatorLabel::operator==(const OperatorLabel &label) const { return to_string() == label.to_string(); }
+bool OperatorLabel::operator==(const OperatorLabel &label) const {
+  return rank_id == label.rank_id && ms_role == label.ms_role;
+}
 
 bool OperatorLabel::operator!=(const OperatorLabel &label) const { return !(*this == label); }
 
@@ -990,24 +993,29 @@ void GraphSplitter::Run() {
 void GraphSplitter::DyeGraph() {
   MS_EXCEPTION_IF_NULL(func_graph_);
   std::vector<AnfNodePtr> all_nodes = DeepScopedGraphSearch(func_graph_->get_return());
-  (void)std::for_each(all_nodes.begin(), all_nodes.end(), [this](const AnfNodePtr &node) {
+  // The labels only depend on the attributes of each node, so they are generated concurrently for the large graphs.
+  // Mark all nodes with original label at the beginning. This means the node is supposed to be on the process with
+  // default_label_.
+  std::vector<OperatorLabel> labels(all_nodes.size(), default_label_);
+  common::ParallelRun(all_nodes.size(), [this, &all_nodes, &labels](size_t i) {
+    const auto &node = all_nodes[i];
     MS_EXCEPTION_IF_NULL(node);
-    // Mark all nodes with original label at the beginning. This means the node is supposed to be on the process with
-    // default_label_.
-    node_labels_[node] = default_label_;
     if (node->isa<CNode>()) {
       // For CNodes, mark them with the label passed by frontend if has one.
-      CNodePtr cnode = node->cast<CNodePtr>();
-      MS_EXCEPTION_IF_NULL(cnode);
-      OperatorLabel label = GetSplitLabel(cnode);
-      node_labels_[node] = label;
+      labels[i] = GetSplitLabel(node);
     }
 
     // If the node's label is the same as this process's, set its label to this_process_label_.
-    if (this_process_label_.LooseEqual(node_labels_[node])) {
-      node_labels_[node] = this_process_label_;
+    if (this_process_label_.LooseEqual(labels[i])) {
+      labels[i] = this_process_label_;
     }
   });
+  for (size_t i = 0; i < all_nodes.size(); ++i) {
+    if (all_nodes[i]->isa<CNode>() && labels[i] != default_label_) {
+      MS_LOG(INFO) << "CNode which has distributed split label: " << all_nodes[i]->fullname_with_scope();
+    }
+    node_labels_[all_nodes[i]] = labels[i];
+  }
 }
 
 void GraphSplitter::CreateExecutionMode() {
@@ -1059,15 +1067,14 @@ InterProcessOpEdgesInfo GraphSplitter::GenerateInterProcessOperators() {
   InterProcessOpEdgesInfo comm_edges;
   MS_EXCEPTION_IF_NULL(func_graph_);
   std::vector<AnfNodePtr> all_nodes = DeepScopedGraphSearch(func_graph_->get_return());
-  for (auto &node : all_nodes) {
-    MS_EXCEPTION_IF_NULL(node);
-    // Only support to split CNode to other process.
-    if (!node->isa<CNode>()) {
+  // The send/recv nodes are created in the order of the nodes as before.
+  const auto &split_inputs = FindAllInputsToSplit(all_nodes);
+  for (size_t i = 0; i < all_nodes.size(); ++i) {
+    if (split_inputs[i].empty()) {
       continue;
     }
-
     // Generating send/recv nodes for each nodes' inputs will be enough.
-    auto node_inputs_comm_edges = GenerateInterProcessOpsForNodeInputs(node);
+    auto node_inputs_comm_edges = GenerateInterProcessOpsForNodeInputs(all_nodes[i], split_inputs[i]);
     comm_edges.insert(node_inputs_comm_edges.cbegin(), node_inputs_comm_edges.cend());
   }
   MS_LOG(INFO) << "The communication edge number is " << comm_edges.size();
@@ -1124,7 +1131,7 @@ void GraphSplitter::DumpDistributedGraph(const InterProcessOpEdgesInfo &comm_edg
   draw::Draw("single_node_graph.dot", func_graph_);
 }
 
-OperatorLabel GraphSplitter::GetSplitLabel(const AnfNodePtr &node) {
+OperatorLabel GraphSplitter::GetSplitLabel(const AnfNodePtr &node) const {
   MS_EXCEPTION_IF_NULL(node);
   if (!node->isa<CNode>()) {
     MS_LOG(EXCEPTION) << "Only CNode has distributed split label.";
@@ -1135,7 +1142,6 @@ OperatorLabel GraphSplitter::GetSplitLabel(const AnfNodePtr &node) {
     auto prim = GetValueNode<PrimitivePtr>(prim_node);
     MS_EXCEPTION_IF_NULL(prim);
     if (prim->HasAttr(distributed::kOpLabelRankId) && prim->HasAttr(distributed::kOpLabelRole)) {
-      MS_LOG(INFO) << "CNode which has distributed split label: " << cnode->fullname_with_scope();
       uint32_t rank_id = static_cast<uint32_t>(GetValue<int64_t>(prim->GetAttr(distributed::kOpLabelRankId)));
       std::string ms_role = GetValue<std::string>(prim->GetAttr(distributed::kOpLabelRole));
       return {rank_id, ms_role};
@@ -1151,12 +1157,9 @@ OperatorLabel GraphSplitter::GetSplitLabel(const AnfNodePtr &node) {
   return default_label_;
 }
 
-InterProcessOpEdgesInfo GraphSplitter::GenerateInterProcessOpsForNodeInputs(const AnfNodePtr &node) {
-  MS_EXCEPTION_IF_NULL(func_graph_);
-  MS_EXCEPTION_IF_NULL(node);
-  CNodePtr cnode = node->cast<CNodePtr>();
+std::vector<size_t> GraphSplitter::FindInputsToSplit(const CNodePtr &cnode) const {
   MS_EXCEPTION_IF_NULL(cnode);
-  InterProcessOpEdgesInfo comm_edges;
+  std::vector<size_t> split_inputs;
   for (size_t i = 1; i < cnode->inputs().size(); i++) {
     auto input_i = cnode->inputs()[i];
     MS_EXCEPTION_IF_NULL(input_i);
@@ -1165,13 +1168,43 @@ InterProcessOpEdgesInfo GraphSplitter::GenerateInterProcessOpsForNodeInputs(cons
     // there's no need to add communication nodes.
     if (!input_i->isa<CNode>() || IsNodesWithSameLabel(input_i, cnode) ||
         common::AnfAlgo::GetCNodeName(input_i) == "Load") {
-      if (IsOneOfRealGraphInput(func_graph_, input_i) && !IsNodesWithSameLabel(input_i, cnode)) {
-        MS_LOG(INFO) << "The input " << input_i->fullname_with_scope() << " needs to be split.";
-      } else {
+      // The names of the nodes are generated lazily, so they are not logged here, which runs concurrently.
+      if (!IsOneOfRealGraphInput(func_graph_, input_i) || IsNodesWithSameLabel(input_i, cnode)) {
         continue;
       }
     }
+    (void)split_inputs.emplace_back(i);
+  }
+  return split_inputs;
+}
+
+std::vector<std::vector<size_t>> GraphSplitter::FindAllInputsToSplit(const std::vector<AnfNodePtr> &nodes) const {
+  // Finding the inputs to split only reads the graph and the labels, so it runs concurrently.
+  std::vector<std::vector<size_t>> split_inputs(nodes.size());
+  common::ParallelRun(nodes.size(), [this, &nodes, &split_inputs](size_t i) {
+    const auto &node = nodes[i];
+    MS_EXCEPTION_IF_NULL(node);
+    // Only support to split CNode to other process.
+    if (node->isa<CNode>()) {
+      split_inputs[i] = FindInputsToSplit(node->cast<CNodePtr>());
+    }
+  });
+  return split_inputs;
+}
 
+InterProcessOpEdgesInfo GraphSplitter::GenerateInterProcessOpsForNodeInputs(const AnfNodePtr &node,
+                                                                            const std::vector<size_t> &split_inputs) {
+  MS_EXCEPTION_IF_NULL(func_graph_);
+  MS_EXCEPTION_IF_NULL(node);
+  CNodePtr cnode = node->cast<CNodePtr>();
+  MS_EXCEPTION_IF_NULL(cnode);
+  InterProcessOpEdgesInfo comm_edges;
+  for (const auto i : split_inputs) {
+    auto input_i = cnode->inputs()[i];
+    MS_EXCEPTION_IF_NULL(input_i);
+    if (!input_i->isa<CNode>() || common::AnfAlgo::GetCNodeName(input_i) == "Load") {
+      MS_LOG(INFO) << "The input " << input_i->fullname_with_scope() << " needs to be split.";
+    }
     InterProcessEdgeLabel edge_label = GenerateEdgeLabel(input_i, cnode);
     InterProcessOpEdge edge = {input_i, node_labels_[input_i], cnode, node_labels_[cnode], edge_label};
 
@@ -1448,12 +1481,14 @@ void GraphSplitter::AddDependencyForSend(const FusedInterProcessOpPairMap &fused
   (void)func_graph_->manager()->SetEdge(func_graph_->get_return(), 1, final_output_node);
 }
 
-bool GraphSplitter::IsNodesWithSameLabel(const AnfNodePtr &node1, const AnfNodePtr &node2) {
-  if (node_labels_.count(node1) == 0 || node_labels_.count(node2) == 0) {
+bool GraphSplitter::IsNodesWithSameLabel(const AnfNodePtr &node1, const AnfNodePtr &node2) const {
+  auto iter1 = node_labels_.find(node1);
+  auto iter2 = node_labels_.find(node2);
+  if (iter1 == node_labels_.end() || iter2 == node_labels_.end()) {
     MS_LOG(EXCEPTION) << "Either 'node1': " << node1->fullname_with_scope()
                       << " or 'node2': " << node2->fullname_with_scope() << " is not marked with split label.";
   }
-  return node_labels_[node1] == node_labels_[node2];
+  return iter1->second == iter2->second;
 }
 
 bool GraphSplitter::NeedSplitGraph() const {
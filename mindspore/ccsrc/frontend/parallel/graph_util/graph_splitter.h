@@ -367,7 +367,7 @@ class GraphSplitter {
   // Return the split label of this node. Only CNode is supported for now.
   // If the node has no split label, return the label of this process, which means this node should be in this process's
   // graph.
-  OperatorLabel GetSplitLabel(const AnfNodePtr &node);
+  OperatorLabel GetSplitLabel(const AnfNodePtr &node) const;
 
   // Consider Node-X is the split node. Node-In is Node-X's one input, Node-Out takes Node-X as one input.
   // So the graph should be like this:
@@ -375,7 +375,14 @@ class GraphSplitter {
   // After send and recv op is inserted, the graph should be:
   // Node-In-->Send-->Recv-->Node-X-->Send-->Recv-->Node-Out.
   // So method GenerateInterProcessOpsForNodeInputs is for generating Send-Recv pair between Node-In and Node-X.
-  InterProcessOpEdgesInfo GenerateInterProcessOpsForNodeInputs(const AnfNodePtr &node);
+  InterProcessOpEdgesInfo GenerateInterProcessOpsForNodeInputs(const AnfNodePtr &node,
+                                                               const std::vector<size_t> &split_inputs);
+
+  // Return the indexes of the inputs of the node which are on other processes, e.g. Node-In of Node-X above.
+  std::vector<size_t> FindInputsToSplit(const CNodePtr &cnode) const;
+
+  // Return the indexes of the inputs to split of each node, found concurrently.
+  std::vector<std::vector<size_t>> FindAllInputsToSplit(const std::vector<AnfNodePtr> &nodes) const;
 
   InterProcessEdgeLabel GenerateEdgeLabel(const AnfNodePtr &src_node, const AnfNodePtr &dst_node) const;
 
@@ -403,7 +410,7 @@ class GraphSplitter {
   void AddDependencyForSend(const FusedInterProcessOpPairMap &fused_inter_process_op_pairs);
 
   // Judge whether two nodes have the same distributed label.
-  bool IsNodesWithSameLabel(const AnfNodePtr &node1, const AnfNodePtr &node2);
+  bool IsNodesWithSameLabel(const AnfNodePtr &node1, const AnfNodePtr &node2) const;
 
   // Check whether need split distributed graph.
   bool NeedSplitGraph() const;
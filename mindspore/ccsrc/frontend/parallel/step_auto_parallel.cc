@@ -19,6 +19,8 @@
 #include <cinttypes>
 #include <ctime>
 #include <algorithm>
+#include <chrono>
+#include <sstream>
 #include <map>
 #include <memory>
 #include <set>
@@ -45,6 +47,7 @@
 #include "frontend/parallel/step_parallel.h"
 #include "frontend/parallel/parameter_manager.h"
 #include "frontend/parallel/strategy_checkpoint/parallel_strategy_checkpoint.h"
+#include "frontend/parallel/tensor_layout/tensor_redistribution.h"
 #include "ir/anf.h"
 #include "ir/param_info.h"
 #include "ir/tensor.h"
@@ -201,6 +204,10 @@ bool IsOperatorsInTwoSeparateLoops(const CNodePtr &a_cnode, const CNodePtr &b_cn
 // 'configured_stra_ops_' includes all operators that are configured sharding strategies.
 std::map<OperatorInfoPtr, StrategyPtr, OpsPtrCompare> configured_stra_ops_;
 std::set<OperatorInfoPtr> ignore_candidate_;
+// The operators in the identical repeated layers have the same candidate strategies and costs. They are generated
+// for the first one, and copied to the others.
+std::map<std::string, std::vector<std::shared_ptr<StrategyWithCost>>> strategy_cost_cache_;
+size_t strategy_cost_cache_hits_ = 0;
 void InitCostGraph() {
   if (entire_costgraph == nullptr) {
     entire_costgraph = std::make_shared<CostGraph>();
@@ -210,6 +217,9 @@ void InitCostGraph() {
   entire_costgraph->Init();
   configured_stra_ops_.clear();
   ignore_candidate_.clear();
+  strategy_cost_cache_.clear();
+  strategy_cost_cache_hits_ = 0;
+  TensorRedistribution::ClearCostCache();
 }
 
 void SetStrategyToOperator(const OperatorInfoPtr &operator_info, const PrimitivePtr &prim,
@@ -271,6 +281,93 @@ void AddOperatorToIgnoreCandidates(const PrimitivePtr &prim, const OperatorInfoP
   }
 }
 
+// The key of the strategy cost cache is made of everything the strategy generation of an operator depends on. An
+// empty key means the operator is not cached.
+std::string GetStrategyCostCacheKey(const PrimitivePtr &prim, const std::vector<Shapes> &shape_list,
+                                    const std::vector<bool> &parameter_info,
+                                    const std::vector<size_t> &inputs_type_length,
+                                    const std::vector<TypePtr> &outputs_type, const std::vector<ValuePtr> &input_value) {
+  if (!CostModelContext::GetInstance()->dp_algo_parallel_search()) {
+    return "";
+  }
+  if (prim->name() == RESHAPE || prim->name() == VIRTUAL_DATA_SET) {
+    return "";
+  }
+  if (std::any_of(input_value.begin(), input_value.end(),
+                  [](const ValuePtr &value) { return value != nullptr && value->isa<tensor::Tensor>(); })) {
+    return "";
+  }
+  std::ostringstream key;
+  key << prim->name() << "|";
+  std::map<std::string, ValuePtr> sorted_attrs;
+  for (const auto &attr : prim->attrs()) {
+    if (attr.first != "instance_name") {
+      (void)sorted_attrs.emplace(attr.first, attr.second);
+    }
+  }
+  for (const auto &attr : sorted_attrs) {
+    key << attr.first << "=" << (attr.second == nullptr ? "None" : attr.second->ToString()) << ";";
+  }
+  key << "|";
+  for (const auto &shapes : shape_list) {
+    for (const auto &shape : shapes) {
+      key << ShapeToString(shape);
+    }
+    key << ";";
+  }
+  key << "|";
+  for (const auto is_parameter : parameter_info) {
+    key << is_parameter;
+  }
+  key << "|";
+  for (const auto type_length : inputs_type_length) {
+    key << type_length << ",";
+  }
+  key << "|";
+  for (const auto &type : outputs_type) {
+    key << (type == nullptr ? "None" : type->ToString()) << ",";
+  }
+  key << "|";
+  for (const auto &value : input_value) {
+    key << (value == nullptr ? "None" : value->ToString()) << ",";
+  }
+  return key.str();
+}
+
+std::vector<std::shared_ptr<StrategyWithCost>> CopyStrategyCost(
+  const std::vector<std::shared_ptr<StrategyWithCost>> &stra_costs) {
+  std::vector<std::shared_ptr<StrategyWithCost>> ret;
+  for (const auto &stra_cost : stra_costs) {
+    MS_EXCEPTION_IF_NULL(stra_cost);
+    MS_EXCEPTION_IF_NULL(stra_cost->strategy_ptr);
+    auto swc = std::make_shared<StrategyWithCost>(std::make_shared<Strategy>(*stra_cost->strategy_ptr),
+                                                  stra_cost->inputs_ptr, stra_cost->outputs_ptr);
+    for (const auto &cost : stra_cost->cost_list) {
+      MS_EXCEPTION_IF_NULL(cost);
+      swc->cost_list.push_back(std::make_shared<Cost>(*cost));
+    }
+    (void)ret.emplace_back(std::move(swc));
+  }
+  return ret;
+}
+
+Status GenerateStrategiesWithCache(const OperatorInfoPtr &operator_info, const std::string &cache_key) {
+  if (!cache_key.empty()) {
+    const auto &iter = strategy_cost_cache_.find(cache_key);
+    if (iter != strategy_cost_cache_.end()) {
+      operator_info->SetStrategyCost(CopyStrategyCost(iter->second));
+      ++strategy_cost_cache_hits_;
+      MS_LOG(INFO) << "Reuse the strategies and costs generated for the same operator for " << operator_info->name();
+      return SUCCESS;
+    }
+  }
+  auto ret = operator_info->GenerateStrategies(0);
+  if (ret == SUCCESS && !cache_key.empty()) {
+    strategy_cost_cache_[cache_key] = CopyStrategyCost(operator_info->GetStrategyCost());
+  }
+  return ret;
+}
+
 OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &cnode, bool is_last_nodes,
                                       StrategyMap *stra_map) {
   MS_EXCEPTION_IF_NULL(prim);
@@ -349,7 +446,9 @@ OperatorInfoPtr CreateTheOperatorInfo(const PrimitivePtr &prim, const CNodePtr &
     operator_info->addAttr(IN_STRATEGY, attrs[GEN_STRATEGY]);  // for d-rec
   } else {
     MS_LOG(INFO) << "auto-searching strategy...";
-    retGenStra = operator_info->GenerateStrategies(0);
+    const auto &cache_key = GetStrategyCostCacheKey(prim, shape_list, parameter_info, inputs_type_length,
+                                                    outputs_type, input_value);
+    retGenStra = GenerateStrategiesWithCache(operator_info, cache_key);
   }
 
   if (retGenStra != SUCCESS) {
@@ -984,6 +1083,13 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   //
   // OUTPUT: the determined strategy for each operator.
 
+  auto step_start = std::chrono::steady_clock::now();
+  auto get_step_time = [&step_start]() {
+    const auto now = std::chrono::steady_clock::now();
+    const auto step_time = std::chrono::duration<double>(now - step_start).count();
+    step_start = now;
+    return step_time;
+  };
   InitCostGraph();
   // Step 1
   if (CostModelContext::GetInstance()->is_multi_subgraphs()) {
@@ -1001,12 +1107,15 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
       MS_LOG(EXCEPTION) << "Constructing nodes for cost graph failed.";
     }
   }
+  MS_LOG(INFO) << "Constructing nodes costs " << get_step_time() << " s, " << strategy_cost_cache_hits_
+               << " operators reuse the strategies and costs of the same operators.";
   // Step 1.1
   ReshapeCostCompute(all_nodes);
   // Step 2
   ConstructCostGraphEdges(all_nodes);
   MS_LOG(INFO) << "Constructing edges for cost graph succeeded. There are " << entire_costgraph->GetOperators().size()
-               << " operators, and " << entire_costgraph->GetNumEdges() << " edges.";
+               << " operators, and " << entire_costgraph->GetNumEdges() << " edges, costs " << get_step_time()
+               << " s.";
 
   // Step 3: Augment the costgraph.
   AugmentCostGraph(all_nodes);
@@ -1020,6 +1129,7 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   if (entire_costgraph->CalculateMemoryCost() != SUCCESS) {
     MS_LOG(EXCEPTION) << "Calculating memory cost failed.";
   }
+  MS_LOG(INFO) << "Augmenting the cost graph and calculating the memory cost costs " << get_step_time() << " s.";
 
   // Step 4: run the strategy searching algorithm
   bool use_sp = (ParallelContext::GetInstance()->strategy_search_mode() == kShardingPropagation) ||
@@ -1030,7 +1140,7 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
     MS_LOG(ERROR) << "Strategy search for cost-graph fails";
     return FAILED;
   }
-  MS_LOG(INFO) << "Searching strategy succeeded.";
+  MS_LOG(INFO) << "Searching strategy succeeded, costs " << get_step_time() << " s.";
 
   if (entire_costgraph->InitSelectedStrategy() == SUCCESS) {
     MS_LOG(INFO) << "Init selected strategy succeeded.";
@@ -1050,6 +1160,8 @@ Status ParallelStrategySearch(const std::vector<AnfNodePtr> &all_nodes, const Fu
   ops_in_a_loop_.clear();
   configured_stra_ops_.clear();
   ignore_candidate_.clear();
+  strategy_cost_cache_.clear();
+  TensorRedistribution::ClearCostCache();
 
   return SUCCESS;
 }
@@ -138,6 +138,8 @@ Status RedistributionOperatorInfer::InferPermuteByAxis() {
                     [out_dim](const RedistributionOperatorMap::value_type &a) { return a.second == out_dim; })) {
       int64_t cat_dim = in_tensor_map_.GetIndexByValue(out_dim);
       int64_t dev_num = dev_mat_.GetDimByReverseIdx(LongToSize(out_dim));
+      // The choice between AllToAll and AllGather + Split follows enable_all2all only. The cost model estimates an
+      // AllToAll as the AllGather and ReduceScatter it expands to, so its costs can't tell which one is cheaper.
       if (ParallelContext::GetInstance()->enable_all2all()) {
         int64_t dev_dim = in_tensor_map_.GetDimByIdx(LongToUlong(cat_dim));
         Args args_alltoall = {dev_mat_.GetDimByReverseIdx(LongToUlong(dev_dim)), UlongToLong(index), cat_dim, dev_dim,
@@ -66,6 +66,10 @@ class TensorLayout {
 
   Map origin_tensor_map() const { return tensor_map_origin_; }
 
+  Arrangement device_arrangement_origin() const { return device_arrangement_origin_; }
+
+  Arrangement tensor_shape_origin() const { return tensor_shape_origin_; }
+
   std::shared_ptr<TensorLayout> ExpandTensorShape(const Arrangement &expanded_shape) const;
 
   std::shared_ptr<TensorLayout> ExpandDeviceArrangement(const Arrangement &expanded_arrangement) const;
@@ -16,16 +16,73 @@
 
 #include "frontend/parallel/tensor_layout/tensor_redistribution.h"
 #include <functional>
+#include <map>
+#include <mutex>
 #include <numeric>
 #include <memory>
 #include <utility>
 #include <string>
 #include "utils/ms_utils.h"
+#include "include/common/utils/parallel_context.h"
 #include "frontend/parallel/status.h"
 #include "frontend/parallel/tensor_layout/shape_util.h"
 
 namespace mindspore {
 namespace parallel {
+namespace {
+struct RedistributionCost {
+  OperatorList operator_list;
+  bool reshape_flag;
+  bool expand_able;
+  double comm_cost;
+  double forward_comm_cost;
+  double backward_comm_cost;
+  double computation_cost;
+  double memory_cost;
+};
+
+// The same pair of layouts is redistributed by many edges and strategies of the cost graph, so the costs are memoized
+// by the layouts, and cleared when the cost graph is rebuilt.
+std::mutex cost_cache_mutex;
+std::map<Shape, RedistributionCost> cost_cache;
+size_t cost_cache_hits = 0;
+
+void AppendToKey(const Shape &array, Shape *const key) {
+  key->push_back(SizeToLong(array.size()));
+  (void)key->insert(key->end(), array.begin(), array.end());
+}
+
+void AppendToKey(const TensorLayout &layout, Shape *const key) {
+  key->push_back(static_cast<int64_t>(layout.layout_transfer()));
+  key->push_back(static_cast<int64_t>(layout.uniform_split()));
+  AppendToKey(layout.device_arrangement_origin().array(), key);
+  AppendToKey(layout.origin_tensor_map().array(), key);
+  AppendToKey(layout.tensor_shape_origin().array(), key);
+  AppendToKey(layout.device_arrangement().array(), key);
+  AppendToKey(layout.tensor_map().array(), key);
+  AppendToKey(layout.tensor_shape().array(), key);
+}
+}  // namespace
+
+void TensorRedistribution::ClearCostCache() {
+  std::lock_guard<std::mutex> lock(cost_cache_mutex);
+  if (!cost_cache.empty()) {
+    MS_LOG(INFO) << "The redistribution cost cache has " << cost_cache.size() << " entries and " << cost_cache_hits
+                 << " hits.";
+  }
+  cost_cache.clear();
+  cost_cache_hits = 0;
+}
+
+Shape TensorRedistribution::CostCacheKey() const {
+  Shape key = {static_cast<int64_t>(keep_reshape_),
+               static_cast<int64_t>(ParallelContext::GetInstance()->enable_all2all())};
+  AppendToKey(from_origin_, &key);
+  AppendToKey(to_origin_, &key);
+  AppendToKey(dev_list_, &key);
+  return key;
+}
+
 Status TensorRedistribution::Init(const TensorLayout &from, const TensorLayout &to, const RankList &dev_list) {
   from_origin_ = from;
   to_origin_ = to;
@@ -203,6 +260,26 @@ Status TensorRedistribution::InferRedistribution(const TensorLayout &from_layout
 }
 
 Status TensorRedistribution::ComputeCost() {
+  // The operators are only inferred without being constructed, so that the costs can be reused.
+  Shape cache_key;
+  if (!construct_op_flag_) {
+    cache_key = CostCacheKey();
+    std::lock_guard<std::mutex> lock(cost_cache_mutex);
+    auto iter = cost_cache.find(cache_key);
+    if (iter != cost_cache.end()) {
+      const auto &cost = iter->second;
+      operator_list_ = cost.operator_list;
+      reshape_flag_ = cost.reshape_flag;
+      expand_able_ = cost.expand_able;
+      comm_cost_ = cost.comm_cost;
+      forward_comm_cost_ = cost.forward_comm_cost;
+      backward_comm_cost_ = cost.backward_comm_cost;
+      computation_cost_ = cost.computation_cost;
+      memory_cost_ = cost.memory_cost;
+      ++cost_cache_hits;
+      return Status::SUCCESS;
+    }
+  }
   RedistributionOpListPtr redistribution_oplist_ptr = InferTensorRedistributionOperatorList(true);
   if (redistribution_oplist_ptr == nullptr) {
     MS_LOG(ERROR) << "Failure: InferTensorRedistribution failed";
@@ -239,6 +316,11 @@ Status TensorRedistribution::ComputeCost() {
     computation_cost_ += COST_FACTOR * prev_prod;
     memory_cost_ += COST_FACTOR * prev_prod;
   }
+  if (!construct_op_flag_) {
+    std::lock_guard<std::mutex> lock(cost_cache_mutex);
+    cost_cache[cache_key] = {operator_list_, reshape_flag_, expand_able_, comm_cost_, forward_comm_cost_,
+                             backward_comm_cost_, computation_cost_, memory_cost_};
+  }
   return Status::SUCCESS;
 }
 
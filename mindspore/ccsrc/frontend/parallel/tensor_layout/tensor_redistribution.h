@@ -52,8 +52,11 @@ class TensorRedistribution {
   double forward_comm_cost() const { return forward_comm_cost_; }
   double backward_comm_cost() const { return backward_comm_cost_; }
   double memory_cost() const { return memory_cost_; }
+  // Clear the costs memoized by ComputeCost, which is called when the cost graph is rebuilt.
+  static void ClearCostCache();
 
  private:
+  Shape CostCacheKey() const;
   Status InferReshape(const TensorLayout &from_layout, const TensorLayout &to_layout,
                       OperatorVector *const operator_vector, OutPutInfoVector *const output_info_vector);
   Status InferRedistribution(const TensorLayout &from_layout, const TensorLayout &to_layout,
@@ -62,6 +62,12 @@ class COMMON_EXPORT ThreadPool {
   std::vector<std::thread> sync_run_threads_{};
   std::vector<std::shared_ptr<ThreadContext>> contexts_;
 };
+
+// Run 'func' on the indexes [0, task_num) by the thread pool, with at least 'min_task_num_per_thread' indexes on each
+// thread. The 'func' on different indexes must not write the same data. It runs serially when it is called in a task
+// of the thread pool. The exception thrown by any 'func' is rethrown after all the tasks are finished.
+COMMON_EXPORT void ParallelRun(size_t task_num, const std::function<void(size_t)> &func,
+                               size_t min_task_num_per_thread = 1);
 }  // namespace common
 }  // namespace mindspore
 
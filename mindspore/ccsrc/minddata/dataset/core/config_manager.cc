@@ -54,7 +54,8 @@ ConfigManager::ConfigManager()
       save_autoconfig_(false),
       autotune_interval_(kCfgAutoTuneInterval),
       enable_watchdog_(true),
-      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval) {
+      multiprocessing_timeout_interval_(kCfgMultiprocessingTimeoutInterval),
+      tensor_pool_size_(kCfgTensorPoolSize) {
   autotune_json_filepath_ = kEmptyString;
   num_cpu_threads_ = num_cpu_threads_ > 0 ? num_cpu_threads_ : std::numeric_limits<uint16_t>::max();
   num_parallel_workers_ = num_parallel_workers_ < num_cpu_threads_ ? num_parallel_workers_ : num_cpu_threads_;
@@ -94,6 +95,7 @@ Status ConfigManager::FromJson(const nlohmann::json &j) {
   set_cache_port(j.value("cachePort", cache_port_));
   set_num_connections(j.value("numConnections", num_connections_));
   set_cache_prefetch_size(j.value("cachePrefetchSize", cache_prefetch_size_));
+  set_tensor_pool_size(j.value("tensorPoolSize", tensor_pool_size_));
   return Status::OK();
 }
 
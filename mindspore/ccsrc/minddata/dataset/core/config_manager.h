@@ -283,6 +283,14 @@ class ConfigManager {
   // @return - Flag to indicate whether the dataset is dynamic-shape
   bool dynamic_shape() const { return dynamic_shape_; }
 
+  // setter function
+  // @param size - Maximum size in MB of the freed tensor buffers kept for recycling, 0 to disable the tensor pool
+  void set_tensor_pool_size(int32_t size) { tensor_pool_size_ = size; }
+
+  // getter function
+  // @return - Maximum size in MB of the freed tensor buffers kept for recycling
+  int32_t tensor_pool_size() const { return tensor_pool_size_; }
+
  private:
   // Private helper function that takes a nlohmann json format and populates the settings
   // @param j - The json nlohmann json info
@@ -317,6 +325,7 @@ class ConfigManager {
   uint32_t multiprocessing_timeout_interval_;  // Multiprocessing timeout interval in seconds
   std::string autotune_json_filepath_;         // Filepath name of the final AutoTune Configuration JSON file
   bool dynamic_shape_{false};
+  int32_t tensor_pool_size_;  // Capacity in MB of the tensor data pool, 0 means disabled
 };
 }  // namespace dataset
 }  // namespace mindspore
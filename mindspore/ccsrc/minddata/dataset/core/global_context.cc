@@ -28,6 +28,7 @@
 #include "minddata/dataset/engine/perf/profiling.h"
 #endif
 #include "minddata/dataset/util/allocator.h"
+#include "minddata/dataset/util/slab_pool.h"
 #include "minddata/dataset/util/system_pool.h"
 
 namespace mindspore {
@@ -58,6 +59,7 @@ Status GlobalContext::Init() {
   config_manager_ = std::make_shared<ConfigManager>();
   mem_pool_ = std::make_shared<SystemPool>();
   // For testing we can use Dummy pool instead
+  tensor_pool_ = std::make_shared<SlabPool>(mem_pool_, 0);
 
   // Create some tensor allocators for the different types and hook them into the pool.
   tensor_allocator_ = std::make_unique<Allocator<Tensor>>(mem_pool_);
@@ -72,6 +74,20 @@ Status GlobalContext::Init() {
   return Status::OK();
 }
 
+std::shared_ptr<MemoryPool> GlobalContext::tensor_data_pool() const {
+  constexpr size_t kMB = 1048576;
+  int32_t pool_size = config_manager_->tensor_pool_size();
+  size_t capacity = pool_size > 0 ? static_cast<size_t>(pool_size) * kMB : 0;
+  // Follow the config, shrinking the capacity gives the cached buffers back to mem_pool_
+  if (tensor_pool_->capacity() != capacity) {
+    tensor_pool_->SetCapacity(capacity);
+  }
+  if (pool_size > 0) {
+    return tensor_pool_;
+  }
+  return mem_pool_;
+}
+
 // A print method typically used for debugging
 void GlobalContext::Print(std::ostream &out) const {
   out << "GlobalContext contains the following default config: " << *config_manager_ << "\n";
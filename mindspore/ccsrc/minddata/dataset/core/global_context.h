@@ -33,6 +33,7 @@ namespace mindspore {
 namespace dataset {
 // forward declare
 class MemoryPool;
+class SlabPool;
 class Tensor;
 class CVTensor;
 class DeviceTensor;
@@ -86,6 +87,15 @@ class GlobalContext {
   // @return the mem pool
   std::shared_ptr<MemoryPool> mem_pool() const { return mem_pool_; }
 
+  // Getter method
+  // @return the pool for the data area of tensors, i.e. the recycling tensor pool if it is enabled by
+  //     ConfigManager::tensor_pool_size(), otherwise the global mem pool
+  std::shared_ptr<MemoryPool> tensor_data_pool() const;
+
+  // Getter method
+  // @return the recycling tensor pool, whether it is enabled or not
+  std::shared_ptr<SlabPool> tensor_pool() const { return tensor_pool_; }
+
   // Getter method
   // @return the tensor allocator as raw pointer
   const TensorAlloc *tensor_allocator() const { return tensor_allocator_.get(); }
@@ -113,6 +123,7 @@ class GlobalContext {
   static std::once_flag init_instance_flag_;
   static std::unique_ptr<GlobalContext> global_context_;        // The instance of the singleton (global)
   std::shared_ptr<MemoryPool> mem_pool_;                        // A global memory pool
+  std::shared_ptr<SlabPool> tensor_pool_;                       // Recycles tensor data on top of mem_pool_
   std::shared_ptr<ConfigManager> config_manager_;               // The configs
   std::unique_ptr<TensorAlloc> tensor_allocator_;               // An allocator for Tensors
   std::unique_ptr<CVTensorAlloc> cv_tensor_allocator_;          // An allocator for CV Tensors
@@ -22,6 +22,7 @@
 #include "minddata/dataset/core/pybind_support.h"
 #endif
 
+#include "minddata/dataset/engine/datasetops/map_op/map_op.h"
 #include "minddata/dataset/kernels/data/data_utils.h"
 #include "minddata/dataset/util/status.h"
 
@@ -68,7 +69,8 @@ BatchOp::BatchOp(int32_t batch_size, bool drop, bool pad, int32_t op_queue_size,
       pad_info_(pad_map),
       batch_num_(0),
       batch_cnt_(0),
-      python_mp_(nullptr) {
+      python_mp_(nullptr),
+      batch_slots_(nullptr) {
   // Adjust connector queue size.  After batch each row is batch_size times larger
   worker_connector_size_ = std::max(1, worker_connector_size_ / start_batch_size_);
   if (num_workers == 1) {
@@ -89,6 +91,7 @@ Status BatchOp::operator()() {
 
   TensorRow new_row;
   std::unique_ptr<TensorQTable> table = std::make_unique<TensorQTable>();
+  std::shared_ptr<BatchBuffer> batch_buffer = nullptr;
   child_iterator_ = std::make_unique<ChildIterator>(this, 0, 0);
   RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
   int32_t cur_batch_size = 0;
@@ -104,12 +107,17 @@ Status BatchOp::operator()() {
         ep_step++;
         total_step++;
         RETURN_IF_NOT_OK(callback_manager_.StepBegin(CallbackParam(op_current_epochs_ + 1, ep_step, total_step)));
+        // the child MapOp reserved the buffer of this batch before it dispatched the first row
+        if (batch_slots_ != nullptr) {
+          RETURN_IF_NOT_OK(batch_slots_->Pop(&batch_buffer));
+        }
       }
       table->emplace_back(new_row);
       // if # of rows is enough to make 1 batch, send it to worker_queue
       if (table->size() == static_cast<size_t>(cur_batch_size)) {
-        RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->EmplaceBack(
-          std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
+        CBatchInfo info(epoch_num, batch_num++, cnt + 1 - epoch_num);
+        info.batch_buffer_ = std::move(batch_buffer);
+        RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->EmplaceBack(std::make_pair(std::move(table), info)));
         cnt++;
         table = std::make_unique<TensorQTable>();
         RETURN_IF_NOT_OK(GetBatchSize(&cur_batch_size, CBatchInfo(epoch_num, batch_num, cnt - epoch_num)));
@@ -118,11 +126,13 @@ Status BatchOp::operator()() {
     }
     // Reminder logic, execute only when there is a remainder (table is non empty) and don't drop
     if (drop_ == false && table->empty() == false) {
-      RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->EmplaceBack(
-        std::make_pair(std::move(table), CBatchInfo(epoch_num, batch_num++, cnt + 1 - epoch_num))));
+      CBatchInfo info(epoch_num, batch_num++, cnt + 1 - epoch_num);
+      info.batch_buffer_ = std::move(batch_buffer);
+      RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->EmplaceBack(std::make_pair(std::move(table), info)));
       cnt++;
     }
     table = std::make_unique<TensorQTable>();  // this drops when drop == true
+    batch_buffer = nullptr;
     // end of the current epoch, batch_num should start from 0 again
     batch_num = 0;
     epoch_num++;
@@ -239,6 +249,87 @@ Status BatchOp::ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *src, st
   return Status::OK();
 }
 
+Status BatchOp::PadAndBatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size,
+                                const PadInfo &pad_info,
+                                const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                                bool concat_batch) {
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  if ((*src)->size() != batch_size) {
+    RETURN_STATUS_UNEXPECTED("[Internal ERROR] Source table size does not match the batch_size.");
+  }
+  // a single row is not copied by BatchRows, padding it separately costs at most one copy as well
+  if (batch_size == 1) {
+    RETURN_IF_NOT_OK(PadColumns(src, pad_info, column_name_id_map));
+    return BatchRows(src, dest, batch_size, concat_batch);
+  }
+
+  std::set<int32_t> pad_cols;
+  std::vector<std::shared_ptr<Tensor>> pad_vals;
+  std::vector<std::vector<dsize_t>> pad_shapes;
+  RETURN_IF_NOT_OK(GetPadShapes(src, pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
+  auto num_columns = (*src)->front().size();
+  for (size_t i = 0; i < num_columns; i++) {
+    std::shared_ptr<Tensor> new_tensor;
+    if (pad_cols.find(static_cast<int32_t>(i)) != pad_cols.end()) {
+      RETURN_IF_NOT_OK(ConvertRowsToPaddedTensor(src, &new_tensor, batch_size, i, pad_shapes[i], pad_vals[i]));
+    } else {
+      RETURN_IF_NOT_OK(ConvertRowsToTensor(src, &new_tensor, batch_size, i));
+    }
+    dest->emplace_back(new_tensor);
+  }
+  return Status::OK();
+}
+
+Status BatchOp::ConvertRowsToPaddedTensor(const std::unique_ptr<TensorQTable> *src, std::shared_ptr<Tensor> *dst,
+                                          dsize_t batch_size, size_t col, const std::vector<dsize_t> &pad_shape,
+                                          const std::shared_ptr<Tensor> &pad_val) {
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(dst);
+  DataType first_type = (*src)->at(0).at(col)->type();
+  if (!first_type.IsNumeric()) {
+    // string tensors are rebuilt from their elements anyway, pad them row by row before batching
+    for (TensorRow &row : **src) {
+      std::shared_ptr<Tensor> pad_tensor;
+      RETURN_IF_NOT_OK(PadEnd(row[col], &pad_tensor, pad_shape, pad_val));
+      row[col] = pad_tensor;
+    }
+    return ConvertRowsToTensor(src, dst, batch_size, col);
+  }
+
+  float val = 0;
+  if (pad_val != nullptr) {
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      pad_val->type().IsNumeric(),
+      "PadEnd: pad_value and item of dataset are not of the same type, type of pad_value is:" +
+        pad_val->type().ToString() + ", and type of dataset item is:" + first_type.ToString() + ".");
+    std::shared_ptr<Tensor> float_pad_value;
+    RETURN_IF_NOT_OK(TypeCast(pad_val, &float_pad_value, DataType(DataType::DE_FLOAT32)));
+    RETURN_IF_NOT_OK(float_pad_value->GetItemAt<float>(&val, {}));
+  }
+
+  // allocate the batch once with the padded shape and copy every row straight into its slot, instead of
+  // materializing a padded copy of each row first
+  TensorShape new_shape = TensorShape(pad_shape).PrependDim(static_cast<int64_t>(batch_size));
+  std::shared_ptr<Tensor> new_tensor;
+  RETURN_IF_NOT_OK(Tensor::CreateEmpty(new_shape, first_type, &new_tensor));
+  if (new_shape.NumOfElements() != 0) {
+    TensorShape slot_shape(pad_shape);
+    bool need_fill = std::any_of((*src)->begin(), (*src)->end(), [col, &slot_shape](const TensorRow &row) {
+      return row.at(col)->shape() != slot_shape;
+    });
+    if (need_fill) {
+      RETURN_IF_NOT_OK(FillPadValue(new_tensor, val));
+    }
+    dsize_t j = 0;
+    for (const TensorRow &row : **src) {
+      RETURN_IF_NOT_OK(PadEndNumericInto(row.at(col), new_tensor, j++));
+    }
+  }
+  *dst = std::move(new_tensor);
+  return Status::OK();
+}
+
 Status BatchOp::WorkerEntry(int32_t workerId) {
   TaskManager::FindMe()->Post();
   std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair;
@@ -262,6 +353,10 @@ Status BatchOp::WorkerEntry(int32_t workerId) {
 
 Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchInfo> table_pair, TensorRow *new_row) {
   RETURN_UNEXPECTED_IF_NULL(table_pair.first);
+  if (table_pair.second.batch_buffer_ != nullptr) {
+    // the rows were copied into the batch by the MapOp workers already
+    return BatchRowsFromSlots(&table_pair.first, table_pair.second.batch_buffer_, new_row);
+  }
   bool concat_batch = false;
 #ifdef ENABLE_PYTHON
   if (batch_map_func_) {
@@ -269,9 +364,40 @@ Status BatchOp::MakeBatchedRow(std::pair<std::unique_ptr<TensorQTable>, CBatchIn
   }  // pass it through pyfun
 #endif
   if (pad_) {
-    RETURN_IF_NOT_OK(PadColumns(&table_pair.first, pad_info_, column_name_id_map_));
-  }  // do padding if needed
-  RETURN_IF_NOT_OK(BatchRows(&table_pair.first, new_row, table_pair.first->size(), concat_batch));
+    // do padding while batching
+    RETURN_IF_NOT_OK(PadAndBatchRows(&table_pair.first, new_row, table_pair.first->size(), pad_info_,
+                                     column_name_id_map_, concat_batch));
+  } else {
+    RETURN_IF_NOT_OK(BatchRows(&table_pair.first, new_row, table_pair.first->size(), concat_batch));
+  }
+  return Status::OK();
+}
+
+Status BatchOp::BatchRowsFromSlots(const std::unique_ptr<TensorQTable> *src,
+                                   const std::shared_ptr<BatchBuffer> &batch_buffer, TensorRow *dest) {
+  RETURN_UNEXPECTED_IF_NULL(src);
+  RETURN_UNEXPECTED_IF_NULL(batch_buffer);
+  RETURN_UNEXPECTED_IF_NULL(dest);
+  RETURN_IF_NOT_OK(batch_buffer->Take(src->get(), dest));
+  std::set<int32_t> pad_cols;
+  std::vector<std::shared_ptr<Tensor>> pad_vals;
+  std::vector<std::vector<dsize_t>> pad_shapes;
+  if (pad_) {
+    RETURN_IF_NOT_OK(GetPadShapes(src, pad_info_, column_name_id_map_, &pad_cols, &pad_vals, &pad_shapes));
+  }
+  auto batch_size = static_cast<dsize_t>((*src)->size());
+  for (size_t i = 0; i < dest->size(); i++) {
+    if ((*dest)[i] != nullptr) {
+      continue;
+    }
+    std::shared_ptr<Tensor> new_tensor;
+    if (pad_cols.find(static_cast<int32_t>(i)) != pad_cols.end()) {
+      RETURN_IF_NOT_OK(ConvertRowsToPaddedTensor(src, &new_tensor, batch_size, i, pad_shapes[i], pad_vals[i]));
+    } else {
+      RETURN_IF_NOT_OK(ConvertRowsToTensor(src, &new_tensor, batch_size, i));
+    }
+    (*dest)[i] = std::move(new_tensor);
+  }
   return Status::OK();
 }
 
@@ -467,35 +593,47 @@ Status BatchOp::InvokeBatchMapFunc(TensorTable *input, TensorTable *output, CBat
 }
 #endif
 
-Status BatchOp::PadColumns(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
-                           const std::unordered_map<std::string, int32_t> &column_name_id_map) {
-  RETURN_UNEXPECTED_IF_NULL(table);  // placeholder for now, might need this in the future
+Status BatchOp::GetPadShapes(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                             const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                             std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
+                             std::vector<std::vector<dsize_t>> *pad_shapes) {
+  RETURN_UNEXPECTED_IF_NULL(table);
+  RETURN_UNEXPECTED_IF_NULL(pad_cols);
+  RETURN_UNEXPECTED_IF_NULL(pad_vals);
+  RETURN_UNEXPECTED_IF_NULL(pad_shapes);
   CHECK_FAIL_RETURN_UNEXPECTED(
     (*table)->front().size() == column_name_id_map.size(),
     "Invalid parameter, size of column_name_id_map must be equal to num of data columns. map size: " +
       std::to_string(column_name_id_map.size()) + ", column nums: " + std::to_string((*table)->front().size()));
-  std::vector<std::shared_ptr<Tensor>> pad_vals(column_name_id_map.size(),
-                                                nullptr);  // value to pad each column's tensor with, default nullptr
-  std::set<int32_t> pad_cols;
+  // value to pad each column's tensor with, default nullptr
+  pad_vals->assign(column_name_id_map.size(), nullptr);
   // padded_shape provided by user, maximum shapes of current batch of tensors
-  std::vector<std::vector<dsize_t>> pad_shapes(column_name_id_map.size()), max_shapes(column_name_id_map.size());
-  RETURN_IF_NOT_OK(UnpackPadInfo(pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
+  pad_shapes->assign(column_name_id_map.size(), {});
+  std::vector<std::vector<dsize_t>> max_shapes(column_name_id_map.size());
+  RETURN_IF_NOT_OK(UnpackPadInfo(pad_info, column_name_id_map, pad_cols, pad_vals, pad_shapes));
 
   // init each shape in max_shape to {-1,-1...} init each unspecified shape in pad_shape to -1 as well
-  for (size_t col_id : pad_cols) {
+  // a column taken from the batch slots of a MapOp has no tensor left in the rows, its pad shape is fully specified
+  for (size_t col_id : *pad_cols) {
+    if ((*table)->front()[col_id] == nullptr) {
+      continue;
+    }
     max_shapes[col_id] = std::vector<dsize_t>((*table)->front()[col_id]->Rank(), -1);
-    if (pad_shapes[col_id].empty()) {
-      pad_shapes[col_id] = max_shapes[col_id];  // fill pad shape with -1
+    if ((*pad_shapes)[col_id].empty()) {
+      (*pad_shapes)[col_id] = max_shapes[col_id];  // fill pad shape with -1
     }
     CHECK_FAIL_RETURN_UNEXPECTED(
-      pad_shapes[col_id].size() == max_shapes[col_id].size(),
+      (*pad_shapes)[col_id].size() == max_shapes[col_id].size(),
       "Invalid pad_info, rank of pad_shape must be equal to rank of specified column. pad_shapes rank:" +
-        std::to_string(pad_shapes[col_id].size()) + ", column rank: " + std::to_string(max_shapes[col_id].size()));
+        std::to_string((*pad_shapes)[col_id].size()) + ", column rank: " + std::to_string(max_shapes[col_id].size()));
   }
 
   // calculate maximum shape for each column that needs to be padded
   for (const TensorRow &row : **table) {  // iterator each row in a batch
-    for (size_t col_id : pad_cols) {      // iterator each tensor in a row
+    for (size_t col_id : *pad_cols) {     // iterator each tensor in a row
+      if (row[col_id] == nullptr) {
+        continue;
+      }
       CHECK_FAIL_RETURN_UNEXPECTED(
         row[col_id]->Rank() == max_shapes[col_id].size(),
         "Invalid data, data to be padded together need to have the same rank, got shape 1: " +
@@ -507,13 +645,23 @@ Status BatchOp::PadColumns(const std::unique_ptr<TensorQTable> *table, const Pad
   }
 
   // if user sets a dimension to -1 (None in python), use the max value for current dimension
-  for (size_t col_id : pad_cols) {
-    for (size_t dim = 0; dim < pad_shapes[col_id].size(); dim++) {
-      if (pad_shapes[col_id][dim] < 0) {
-        pad_shapes[col_id][dim] = max_shapes[col_id][dim];
+  for (size_t col_id : *pad_cols) {
+    for (size_t dim = 0; dim < (*pad_shapes)[col_id].size(); dim++) {
+      if ((*pad_shapes)[col_id][dim] < 0) {
+        (*pad_shapes)[col_id][dim] = max_shapes[col_id][dim];
       }
     }
   }
+  return Status::OK();
+}
+
+Status BatchOp::PadColumns(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                           const std::unordered_map<std::string, int32_t> &column_name_id_map) {
+  RETURN_UNEXPECTED_IF_NULL(table);  // placeholder for now, might need this in the future
+  std::set<int32_t> pad_cols;
+  std::vector<std::shared_ptr<Tensor>> pad_vals;
+  std::vector<std::vector<dsize_t>> pad_shapes;
+  RETURN_IF_NOT_OK(GetPadShapes(table, pad_info, column_name_id_map, &pad_cols, &pad_vals, &pad_shapes));
 
   // call pad on each tensor that needs to be padded
   for (TensorRow &row : **table) {
@@ -652,6 +800,53 @@ Status BatchOp::ComputeColMap() {
   return Status::OK();
 }
 
+Status BatchOp::PrepareOperator() {
+  RETURN_IF_NOT_OK(DatasetOp::PrepareOperator());
+  // the slots are reserved by the MapOp in the order of the rows, which needs a fixed batch size and no per_batch_map
+  auto map_op = std::dynamic_pointer_cast<MapOp>(child_[0]);
+  if (map_op == nullptr || IsPython() || !in_col_names_.empty()) {
+    return Status::OK();
+  }
+  std::vector<SlotColumn> columns(column_name_id_map_.size());
+  std::set<int32_t> pad_cols;
+  std::vector<std::shared_ptr<Tensor>> pad_vals(columns.size(), nullptr);
+  std::vector<std::vector<dsize_t>> pad_shapes(columns.size());
+  if (pad_) {
+    RETURN_IF_NOT_OK(UnpackPadInfo(pad_info_, column_name_id_map_, &pad_cols, &pad_vals, &pad_shapes));
+  }
+  for (size_t col = 0; col < columns.size(); col++) {
+    SlotColumn &column = columns[col];
+    if (pad_cols.find(static_cast<int32_t>(col)) == pad_cols.end()) {
+      column.enabled = true;
+      continue;
+    }
+    // a column padded to the max shape of each batch has no slot shape to preallocate
+    const std::vector<dsize_t> &pad_shape = pad_shapes[col];
+    if (pad_shape.empty() || std::any_of(pad_shape.begin(), pad_shape.end(), [](dsize_t dim) { return dim <= 0; })) {
+      continue;
+    }
+    if (pad_vals[col] != nullptr) {
+      if (!pad_vals[col]->type().IsNumeric()) {
+        continue;
+      }
+      std::shared_ptr<Tensor> float_pad_value;
+      RETURN_IF_NOT_OK(TypeCast(pad_vals[col], &float_pad_value, DataType(DataType::DE_FLOAT32)));
+      RETURN_IF_NOT_OK(float_pad_value->GetItemAt<float>(&column.pad_val, {}));
+    }
+    column.enabled = true;
+    column.padded = true;
+    column.pad_shape = pad_shape;
+  }
+  if (std::none_of(columns.begin(), columns.end(), [](const SlotColumn &column) { return column.enabled; })) {
+    return Status::OK();
+  }
+  batch_slots_ = std::make_shared<BatchSlots>(start_batch_size_, std::move(columns));
+  map_op->SetBatchSlots(batch_slots_);
+  MS_LOG(INFO) << "The rows of " << map_op->NameWithID() << " are copied into the batch slots of " << NameWithID()
+               << " by its workers.";
+  return Status::OK();
+}
+
 int64_t BatchOp::GetTreeBatchSize() {
 #ifdef ENABLE_PYTHON
   if (batch_size_func_) {
@@ -682,11 +877,13 @@ Status BatchOp::GetNextRowPullMode(TensorRow *const row) {
     }
   }
   RETURN_UNEXPECTED_IF_NULL(table);
-  if (pad_) {
-    RETURN_IF_NOT_OK(PadColumns(&table, pad_info_, column_name_id_map_));
-  }  // do padding if needed
   if (!table->empty()) {
-    RETURN_IF_NOT_OK(BatchRows(&table, row, table->size()));
+    if (pad_) {
+      // do padding while batching
+      RETURN_IF_NOT_OK(PadAndBatchRows(&table, row, table->size(), pad_info_, column_name_id_map_));
+    } else {
+      RETURN_IF_NOT_OK(BatchRows(&table, row, table->size()));
+    }
     batch_cnt_++;
     batch_num_++;
   }
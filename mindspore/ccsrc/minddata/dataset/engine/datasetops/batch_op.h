@@ -30,6 +30,7 @@
 #include "minddata/dataset/core/config_manager.h"
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/batch_slots.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/util/status.h"
 
@@ -53,6 +54,8 @@ struct CBatchInfo {
   int64_t batch_num_;        // i-th batch since the start of current epoch. i starts from 0
   int64_t total_batch_num_;  // i-th batch since the start of first epoch. i starts from 0
   batchCtrl ctrl_;           // No control=0, EOE=1, EOF=2, Quit=3
+  // batch the rows were copied into by the MapOp below, nullptr if they were not
+  std::shared_ptr<BatchBuffer> batch_buffer_;
   const int64_t get_batch_num() const { return batch_num_; }
   const int64_t get_epoch_num() const { return epoch_num_; }
 };
@@ -193,6 +196,12 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   // @return Name of the current Op
   std::string Name() const override { return kBatchOp; }
 
+  // When the child is a MapOp and the batch size is fixed, let the MapOp workers copy their output rows into batch
+  // tensors preallocated with the slot shape of each column, the padded shape if it is fully specified or the shape
+  // of the rows otherwise. A column whose rows do not share the slot shape is batched from the rows as usual.
+  // @return Status The status code returned
+  Status PrepareOperator() override;
+
   // batch the rows in src table then put it to dest table
   // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
   // @param const std::unique_ptr<TensorQTable> *dest - dest_table to hold batched rows
@@ -211,6 +220,20 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   static Status ConvertRowsToTensor(const std::unique_ptr<TensorQTable> *src, std::shared_ptr<Tensor> *dst,
                                     dsize_t batch_size, size_t col);
 
+  // batch the rows in src table and pad the columns in pad_info at the same time, each numeric row is copied
+  // straight into its slot of the padded batch tensor
+  // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
+  // @param TensorRow *dest - row to hold the batched tensors
+  // @param dsize_t batch_size - batch_size
+  // @param const PadInfo &pad_info pad info
+  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param bool concat_batch - whether a single row is kept without the batch dimension
+  // @return Status The status code returned
+  static Status PadAndBatchRows(const std::unique_ptr<TensorQTable> *src, TensorRow *dest, dsize_t batch_size,
+                                const PadInfo &pad_info,
+                                const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                                bool concat_batch = false);
+
   // @param table
   // @param const PadInfo &pad_info pad info
   // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
@@ -265,6 +288,39 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
                               std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
                               std::vector<std::vector<dsize_t>> *pad_shapes);
 
+  // @param const std::unique_ptr<TensorQTable> *table - table that has the rows for batching
+  // @param const PadInfo &pad_info pad info
+  // @param const std::unordered_map<std::string, int32_t>& column_name_id_map - column names to index mapping
+  // @param std::set<int32_t> *pad_cols, col ids to perform pad on
+  // @param std::vector<std::shared_ptr<Tensor>> *pad_vals, padding value for each column
+  // @param std::vector<std::vector<dsize_t>> *pad_shapes, shape each column is padded to in the current batch
+  // @return Status The status code returned
+  static Status GetPadShapes(const std::unique_ptr<TensorQTable> *table, const PadInfo &pad_info,
+                             const std::unordered_map<std::string, int32_t> &column_name_id_map,
+                             std::set<int32_t> *pad_cols, std::vector<std::shared_ptr<Tensor>> *pad_vals,
+                             std::vector<std::vector<dsize_t>> *pad_shapes);
+
+  // convert the rows of a column to a tensor padded to pad_shape
+  // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
+  // @param std::shared_ptr<Tensor> *dst - the batched tensor
+  // @param dsize_t batch_size - batch_size
+  // @param size_t col - column index
+  // @param const std::vector<dsize_t> &pad_shape - shape of each row after padding
+  // @param const std::shared_ptr<Tensor> &pad_val - value to pad with, nullptr pads with 0 or empty string
+  // @return Status The status code returned
+  static Status ConvertRowsToPaddedTensor(const std::unique_ptr<TensorQTable> *src, std::shared_ptr<Tensor> *dst,
+                                          dsize_t batch_size, size_t col, const std::vector<dsize_t> &pad_shape,
+                                          const std::shared_ptr<Tensor> &pad_val);
+
+  // batch the rows handed over to a batch buffer, the columns whose rows were all copied into their slots are taken
+  // as they are, the others are batched from the rows and padded as usual
+  // @param const std::unique_ptr<TensorQTable> *src - table that has the rows for batching
+  // @param const std::shared_ptr<BatchBuffer> &batch_buffer - buffer the rows were copied into
+  // @param TensorRow *dest - row to hold the batched tensors
+  // @return Status The status code returned
+  Status BatchRowsFromSlots(const std::unique_ptr<TensorQTable> *src, const std::shared_ptr<BatchBuffer> &batch_buffer,
+                            TensorRow *dest);
+
   // get the batch size for next batch
   // @return Status The status code returned
   Status GetBatchSize(int32_t *batch_size, CBatchInfo info);
@@ -305,6 +361,7 @@ class BatchOp : public ParallelOp<std::pair<std::unique_ptr<TensorQTable>, CBatc
   py::function batch_map_func_;   // Function pointer of per batch map function
 #endif
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;  // python multiprocessing instance
+  std::shared_ptr<BatchSlots> batch_slots_;                  // slots the child MapOp copies its rows into
 
  protected:
   Status Launch() override;
@@ -0,0 +1,138 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/batch_slots.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "minddata/dataset/kernels/data/data_utils.h"
+
+namespace mindspore {
+namespace dataset {
+BatchBuffer::BatchBuffer(int32_t batch_size, std::shared_ptr<const std::vector<SlotColumn>> columns)
+    : batch_size_(batch_size),
+      columns_(std::move(columns)),
+      tensors_(columns_->size(), nullptr),
+      slot_shapes_(columns_->size(), TensorShape::CreateUnknownRankShape()) {}
+
+Status BatchBuffer::Fill(dsize_t slot, TensorRow *row) {
+  RETURN_UNEXPECTED_IF_NULL(row);
+  CHECK_FAIL_RETURN_UNEXPECTED(slot >= 0 && slot < batch_size_,
+                               "[Internal ERROR] Batch slot " + std::to_string(slot) + " is out of range.");
+  CHECK_FAIL_RETURN_UNEXPECTED(row->size() == columns_->size(),
+                               "[Internal ERROR] Number of columns of the row does not match the batch, expected: " +
+                                 std::to_string(columns_->size()) + ", got: " + std::to_string(row->size()));
+  for (size_t col = 0; col < columns_->size(); col++) {
+    const SlotColumn &column = (*columns_)[col];
+    std::shared_ptr<Tensor> &tensor = (*row)[col];
+    if (!column.enabled || tensor == nullptr || !tensor->type().IsNumeric() || tensor->shape().NumOfElements() == 0) {
+      continue;
+    }
+    std::shared_ptr<Tensor> batch;
+    TensorShape slot_shape = TensorShape::CreateUnknownRankShape();
+    {
+      std::unique_lock<std::mutex> lock(mux_);
+      if (tensors_[col] == nullptr) {
+        slot_shapes_[col] = column.padded ? TensorShape(column.pad_shape) : tensor->shape();
+        RETURN_IF_NOT_OK(
+          Tensor::CreateEmpty(slot_shapes_[col].PrependDim(batch_size_), tensor->type(), &tensors_[col]));
+        if (column.padded) {
+          RETURN_IF_NOT_OK(FillPadValue(tensors_[col], column.pad_val));
+        }
+      }
+      batch = tensors_[col];
+      slot_shape = slot_shapes_[col];
+    }
+    // a row that does not fit keeps its tensor, batching it from the rows gives the same result or the same error
+    bool fit = column.padded ? tensor->Rank() == slot_shape.Rank() : tensor->shape() == slot_shape;
+    if (!fit || tensor->type() != batch->type()) {
+      continue;
+    }
+    RETURN_IF_NOT_OK(PadEndNumericInto(tensor, batch, slot));
+    tensor = nullptr;
+  }
+  return Status::OK();
+}
+
+Status BatchBuffer::Take(TensorQTable *rows, TensorRow *batched) {
+  RETURN_UNEXPECTED_IF_NULL(rows);
+  RETURN_UNEXPECTED_IF_NULL(batched);
+  auto num_rows = static_cast<dsize_t>(rows->size());
+  CHECK_FAIL_RETURN_UNEXPECTED(num_rows > 0 && num_rows <= batch_size_,
+                               "[Internal ERROR] Number of rows does not match the batch slots, got: " +
+                                 std::to_string(num_rows) + ", batch size: " + std::to_string(batch_size_));
+  *batched = TensorRow(columns_->size(), nullptr);
+  std::unique_lock<std::mutex> lock(mux_);
+  for (size_t col = 0; col < columns_->size(); col++) {
+    if (tensors_[col] == nullptr) {  // no row of this column was copied
+      continue;
+    }
+    bool all_copied =
+      std::all_of(rows->begin(), rows->end(), [col](const TensorRow &row) { return row.at(col) == nullptr; });
+    if (all_copied && num_rows == batch_size_) {
+      (*batched)[col] = std::move(tensors_[col]);
+      continue;
+    }
+    const uchar *data = tensors_[col]->GetBuffer();
+    DataType type = tensors_[col]->type();
+    dsize_t slot_size = slot_shapes_[col].NumOfElements() * type.SizeInBytes();
+    if (all_copied) {
+      // the last batch of an epoch is not full, only the leading slots are in use
+      RETURN_IF_NOT_OK(Tensor::CreateFromMemory(slot_shapes_[col].PrependDim(num_rows), type, data, &(*batched)[col]));
+      continue;
+    }
+    for (dsize_t j = 0; j < num_rows; j++) {
+      std::shared_ptr<Tensor> &tensor = (*rows)[j][col];
+      if (tensor == nullptr) {
+        RETURN_IF_NOT_OK(Tensor::CreateFromMemory(slot_shapes_[col], type, data + j * slot_size, &tensor));
+      }
+    }
+  }
+  return Status::OK();
+}
+
+BatchSlots::BatchSlots(int32_t batch_size, std::vector<SlotColumn> columns)
+    : batch_size_(batch_size),
+      columns_(std::make_shared<const std::vector<SlotColumn>>(std::move(columns))),
+      current_(nullptr),
+      next_slot_(0) {}
+
+Status BatchSlots::Reserve(std::shared_ptr<BatchBuffer> *buffer, dsize_t *slot) {
+  RETURN_UNEXPECTED_IF_NULL(buffer);
+  RETURN_UNEXPECTED_IF_NULL(slot);
+  if (current_ == nullptr || next_slot_ == batch_size_) {
+    current_ = std::make_shared<BatchBuffer>(batch_size_, columns_);
+    next_slot_ = 0;
+    std::unique_lock<std::mutex> lock(mux_);
+    buffers_.push_back(current_);
+  }
+  *buffer = current_;
+  *slot = next_slot_++;
+  return Status::OK();
+}
+
+void BatchSlots::EndEpoch() { current_ = nullptr; }
+
+Status BatchSlots::Pop(std::shared_ptr<BatchBuffer> *buffer) {
+  RETURN_UNEXPECTED_IF_NULL(buffer);
+  std::unique_lock<std::mutex> lock(mux_);
+  CHECK_FAIL_RETURN_UNEXPECTED(!buffers_.empty(), "[Internal ERROR] No batch slots were reserved for the batch.");
+  *buffer = std::move(buffers_.front());
+  buffers_.pop_front();
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,111 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_SLOTS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_SLOTS_H_
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/core/tensor_row.h"
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+// How the rows of one column are laid out in the batch tensor.
+struct SlotColumn {
+  bool enabled = false;            // false if the column is always batched from the rows, e.g. padded to the max
+  bool padded = false;             // true if each row is padded to pad_shape, otherwise it keeps its own shape
+  std::vector<dsize_t> pad_shape;  // shape of a slot of a padded column
+  float pad_val = 0;               // value to pad with
+};
+
+// The batch tensors that the rows of one batch are copied into by the MapOp workers. The tensor of a column is
+// allocated by the first row that reaches it, with the padded shape or the shape of that row. A row whose tensor
+// does not fit the slot, or is not numeric, keeps its tensor and the column is batched from the rows as usual.
+class BatchBuffer {
+ public:
+  // @param int32_t batch_size - number of slots
+  // @param std::shared_ptr<const std::vector<SlotColumn>> columns - layout of each column
+  BatchBuffer(int32_t batch_size, std::shared_ptr<const std::vector<SlotColumn>> columns);
+
+  ~BatchBuffer() = default;
+
+  // Copy the tensors of a row into its slot, the copied tensors are released from the row. Called by the MapOp
+  // workers, each one for a different slot.
+  // @param dsize_t slot - index of the row in the batch
+  // @param TensorRow *row - the row, copied tensors are set to nullptr
+  // @return Status The status code returned
+  Status Fill(dsize_t slot, TensorRow *row);
+
+  // Take the batch tensors of the columns whose rows were all copied into their slots. The slots of the other columns
+  // are copied back into the rows that gave up their tensor, so they can be batched from the rows. Called by the
+  // BatchOp once all the rows of the batch are received.
+  // @param TensorQTable *rows - the rows of the batch, in the order of the slots
+  // @param TensorRow *batched - batch tensor of each column, nullptr for the columns to batch from the rows
+  // @return Status The status code returned
+  Status Take(TensorQTable *rows, TensorRow *batched);
+
+ private:
+  int32_t batch_size_;
+  std::shared_ptr<const std::vector<SlotColumn>> columns_;
+  std::vector<std::shared_ptr<Tensor>> tensors_;  // batch tensor of each column, nullptr until the first row
+  std::vector<TensorShape> slot_shapes_;          // shape of a slot of each column
+  std::mutex mux_;                                // guards the allocation of tensors_
+};
+
+// BatchSlots hands the rows of a MapOp over to the BatchOp right above it, so the output of the last transform of a
+// row is copied straight into the batch by the parallel MapOp workers instead of being kept as a separate tensor
+// until the batch is made. Both ops walk the same rows in the same order: the MapOp thread reserves a slot for each
+// row before it dispatches the row to a worker, a new buffer being queued every batch_size rows and at the start of
+// each epoch, and the BatchOp thread pops one buffer for each batch it starts.
+class BatchSlots {
+ public:
+  // @param int32_t batch_size - number of rows in a batch
+  // @param std::vector<SlotColumn> columns - layout of each column
+  BatchSlots(int32_t batch_size, std::vector<SlotColumn> columns);
+
+  ~BatchSlots() = default;
+
+  // Reserve the slot of the next row. Called by the MapOp thread for each row it dispatches.
+  // @param std::shared_ptr<BatchBuffer> *buffer - buffer of the batch of the row
+  // @param dsize_t *slot - index of the row in the batch
+  // @return Status The status code returned
+  Status Reserve(std::shared_ptr<BatchBuffer> *buffer, dsize_t *slot);
+
+  // End the current batch, the next row starts a new one. Called by the MapOp thread at the end of each epoch.
+  void EndEpoch();
+
+  // Pop the buffer of the next batch. Called by the BatchOp thread for the first row of each batch, the buffer is
+  // always reserved by then.
+  // @param std::shared_ptr<BatchBuffer> *buffer - buffer of the batch
+  // @return Status The status code returned
+  Status Pop(std::shared_ptr<BatchBuffer> *buffer);
+
+ private:
+  int32_t batch_size_;
+  std::shared_ptr<const std::vector<SlotColumn>> columns_;
+  std::shared_ptr<BatchBuffer> current_;  // buffer the MapOp thread is reserving slots in
+  dsize_t next_slot_;
+  std::deque<std::shared_ptr<BatchBuffer>> buffers_;  // buffers reserved but not popped by the BatchOp yet
+  std::mutex mux_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_BATCH_SLOTS_H_
@@ -153,11 +153,9 @@ Status BucketBatchByLengthOp::PadAndBatchBucket(int32_t bucket_index, int32_t ba
     }
   }
 
-  // PadColumns will change the data in bucket
-  RETURN_IF_NOT_OK(BatchOp::PadColumns(bucket, pad_info_copy, column_name_id_map_));
-
+  // PadAndBatchRows may change the data in bucket
   TensorRow batched_bucket;
-  RETURN_IF_NOT_OK(BatchOp::BatchRows(bucket, &batched_bucket, batch_size));
+  RETURN_IF_NOT_OK(BatchOp::PadAndBatchRows(bucket, &batched_bucket, batch_size, pad_info_copy, column_name_id_map_));
   (*bucket)->clear();
 
   RETURN_IF_NOT_OK(out_connector_->Add(std::move(batched_bucket)));
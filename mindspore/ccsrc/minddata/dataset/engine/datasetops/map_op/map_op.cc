@@ -38,7 +38,8 @@ MapOp::MapOp(const std::vector<std::string> &in_col_names, const std::vector<std
       tfuncs_(std::move(tensor_funcs)),
       in_columns_(in_col_names),
       out_columns_(out_col_names),
-      python_mp_(nullptr) {
+      python_mp_(nullptr),
+      batch_slots_(nullptr) {
   // Set connector size via config.
   // If caller didn't specify the out_col_names, assume they are same as the in_columns.
   if (out_columns_.empty() || out_columns_[0].empty()) {
@@ -69,14 +70,17 @@ void MapOp::Print(std::ostream &out, bool show_all) const {
   }
 }
 
-// A helper function that fetch worker map job from local queues and extract the data and map job list
-Status MapOp::FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list) {
+// A helper function that fetch worker map job from local queues and extract the data, map job list and batch slot
+Status MapOp::FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                            std::shared_ptr<BatchBuffer> *batch_buffer, dsize_t *batch_slot) {
   std::unique_ptr<MapWorkerJob> worker_job;
   // Fetch the next worker job and TensorRow
   RETURN_IF_NOT_OK(worker_in_queues_[static_cast<const int>(worker_id)]->PopFront(&worker_job));
-  // Extract the TensorRow and job list from the map worker job.
+  // Extract the TensorRow, job list and batch slot from the map worker job.
   *row = std::move(worker_job->tensor_row);
   *job_list = std::move(worker_job->jobs);
+  *batch_buffer = std::move(worker_job->batch_buffer);
+  *batch_slot = worker_job->batch_slot;
 
   return Status::OK();
 }
@@ -144,12 +148,22 @@ Status MapOp::operator()() {
       // Populate map worker job for a worker to execute
       RETURN_IF_NOT_OK(GenerateWorkerJob(&worker_job));
 
+      // Reserve the slot of the row in the batch of the BatchOp above, in the order the rows are dispatched
+      if (batch_slots_ != nullptr) {
+        RETURN_IF_NOT_OK(batch_slots_->Reserve(&worker_job->batch_buffer, &worker_job->batch_slot));
+      }
+
       // Push map worker job to the corresponding worker's queue
       RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
 
       RETURN_IF_NOT_OK(child_iterator_->FetchNextTensorRow(&new_row));
     }
 
+    // The BatchOp above ends the batch at eoe as well
+    if (batch_slots_ != nullptr) {
+      batch_slots_->EndEpoch();
+    }
+
     // Propagate the eoe row to worker
     std::unique_ptr<MapWorkerJob> worker_job = std::make_unique<MapWorkerJob>(std::move(new_row));
     RETURN_IF_NOT_OK(worker_in_queues_[NextWorkerID()]->Add(std::move(worker_job)));
@@ -179,8 +193,10 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
 
   TensorRow in_row;
   std::vector<std::shared_ptr<MapJob>> job_list;
+  std::shared_ptr<BatchBuffer> batch_buffer;
+  dsize_t batch_slot = 0;
   // Fetch next data row and map job list
-  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+  RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list, &batch_buffer, &batch_slot));
 
   // Now that init work is done, drop into the main fetching loop.
   // Map op does not use child iterator, and it needs to manually handle eoe and eof's itself
@@ -197,11 +213,15 @@ Status MapOp::WorkerEntry(int32_t worker_id) {
       TensorRow out_row;
       // Perform the compute function of TensorOp(s) and store the result in new_tensor_table.
       RETURN_IF_NOT_OK(WorkerCompute(in_row, &out_row, job_list));
+      // Copy the output into its slot of the batch while still in parallel, the row only carries what did not fit.
+      if (batch_buffer != nullptr) {
+        RETURN_IF_NOT_OK(batch_buffer->Fill(batch_slot, &out_row));
+      }
       // Push the row onto the connector for next operator to consume.
       RETURN_IF_NOT_OK(worker_out_queues_[worker_id]->EmplaceBack(std::move(out_row)));
     }
     // Fetch next data row and map job list
-    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list));
+    RETURN_IF_NOT_OK(FetchNextWork(worker_id, &in_row, &job_list, &batch_buffer, &batch_slot));
   }
   return Status::OK();
 }
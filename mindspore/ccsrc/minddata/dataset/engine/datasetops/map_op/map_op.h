@@ -26,6 +26,7 @@
 #include "minddata/dataset/api/python/python_mp.h"
 #include "minddata/dataset/callback/ds_callback.h"
 #include "minddata/dataset/engine/dataset_iterator.h"
+#include "minddata/dataset/engine/datasetops/batch_slots.h"
 #include "minddata/dataset/engine/datasetops/map_op/map_job.h"
 #include "minddata/dataset/engine/datasetops/parallel_op.h"
 #include "minddata/dataset/kernels/tensor_op.h"
@@ -43,6 +44,8 @@ struct MapWorkerJob {
   explicit MapWorkerJob(TensorRow tr) : tensor_row(std::move(tr)) {}
   std::vector<std::shared_ptr<MapJob>> jobs;
   TensorRow tensor_row;
+  std::shared_ptr<BatchBuffer> batch_buffer;  // batch the output row is copied into, nullptr if there is none
+  dsize_t batch_slot = 0;                     // index of the row in the batch
 };
 
 // MapOp class implements the Map operator. It will apply a list of operations to each record specified by column names.
@@ -146,12 +149,17 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
   /// \return vector of int
   std::vector<int32_t> GetMPWorkerPIDs() const override;
 
+  /// Hand the output rows over to the batch slots of the BatchOp above, set by the BatchOp before the tree is launched
+  /// \param batch_slots the slots the workers copy the output rows into
+  void SetBatchSlots(std::shared_ptr<BatchSlots> batch_slots) { batch_slots_ = std::move(batch_slots); }
+
  private:
   // A helper function to create jobs for workers.
   Status GenerateWorkerJob(const std::unique_ptr<MapWorkerJob> *worker_job);
 
-  // A helper function that fetch worker map job from local queues and extract the data and map job list
-  Status FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list);
+  // A helper function that fetch worker map job from local queues and extract the data, map job list and batch slot
+  Status FetchNextWork(uint32_t worker_id, TensorRow *row, std::vector<std::shared_ptr<MapJob>> *job_list,
+                       std::shared_ptr<BatchBuffer> *batch_buffer, dsize_t *batch_slot);
 
   //  Tensorops to be read and applied by worker threads
   std::vector<std::shared_ptr<TensorOp>> tfuncs_;
@@ -172,6 +180,8 @@ class MapOp : public ParallelOp<std::unique_ptr<MapWorkerJob>, TensorRow> {
 
   std::shared_ptr<PythonMultiprocessingRuntime> python_mp_;  // python multiprocessing instance
 
+  std::shared_ptr<BatchSlots> batch_slots_;  // batch slots of the BatchOp above, nullptr if rows are not handed over
+
   // Private function for worker/thread to loop continuously. It comprises the main
   // logic of MapOp: getting the data from previous Op, validating user specified column names,
   // applying a list of TensorOps to each of the data, process the results and then
@@ -0,0 +1,187 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/datasetops/source/sampler/permutation_sampler.h"
+
+#include <algorithm>
+#include <string>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int kNumRounds = 4;
+
+// SplitMix64 finalizer, used both to derive the round keys and as the round function
+inline uint64_t Mix(uint64_t x) {
+  x += 0x9E3779B97F4A7C15ull;
+  x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+  x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+  return x ^ (x >> 31);
+}
+}  // namespace
+
+PermutationSamplerRT::PermutationSamplerRT(uint32_t seed, bool reshuffle_each_epoch, int64_t start_index,
+                                           int64_t num_samples, int64_t samples_per_tensor)
+    : SamplerRT(num_samples, samples_per_tensor),
+      seed_(seed),
+      reshuffle_each_epoch_(reshuffle_each_epoch),
+      start_index_(start_index),
+      next_id_(start_index),
+      epoch_(0),
+      half_bits_(1),
+      half_mask_(1),
+      round_keys_{0, 0, 0, 0} {}
+
+Status PermutationSamplerRT::GetNextSample(TensorRow *out) {
+  RETURN_UNEXPECTED_IF_NULL(out);
+  if (next_id_ > num_samples_) {
+    RETURN_STATUS_UNEXPECTED(
+      "[Internal ERROR] Sampler index must be less than or equal to num_samples(total rows in dataset), but got" +
+      std::to_string(next_id_) + ", num_samplers:" + std::to_string(num_samples_));
+  } else if (next_id_ == num_samples_) {
+    (*out) = TensorRow(TensorRow::kFlagEOE);
+  } else {
+    if (HasChildSampler()) {
+      RETURN_IF_NOT_OK(child_[0]->GetNextSample(&child_ids_));
+    }
+
+    std::shared_ptr<Tensor> sampleIds;
+    int64_t last_id = std::min(samples_per_tensor_ + next_id_, num_samples_);
+    RETURN_IF_NOT_OK(CreateSamplerTensor(&sampleIds, last_id - next_id_));
+    auto id_ptr = sampleIds->begin<int64_t>();
+    for (int64_t i = next_id_; i < last_id; i++) {
+      int64_t sampled_id = Permute(i);
+      if (HasChildSampler()) {
+        RETURN_IF_NOT_OK(GetAssociatedChildId(&sampled_id, sampled_id));
+      }
+      *id_ptr = sampled_id;
+      ++id_ptr;
+    }
+    next_id_ = last_id;
+    (*out) = {sampleIds};
+  }
+  return Status::OK();
+}
+
+Status PermutationSamplerRT::InitSampler() {
+  if (is_initialized) {
+    return Status::OK();
+  }
+  // Special value of 0 for num_samples means that the user wants to sample the entire set of data.
+  // If the user asked to sample more rows than exists in the dataset, adjust the num_samples accordingly.
+  if (num_samples_ == 0 || num_samples_ > num_rows_) {
+    num_samples_ = num_rows_;
+  }
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    num_samples_ >= 0 && num_rows_ >= 0,
+    "[Internal ERROR] num_samples and num_rows must be greater than or equal to 0, but got num_samples: " +
+      std::to_string(num_samples_) + ", num_rows: " + std::to_string(num_rows_));
+  // an empty dataset gives an empty epoch, the same as the SequentialSampler replaced by the shuffle pushdown
+  CHECK_FAIL_RETURN_UNEXPECTED(
+    start_index_ >= 0 && (start_index_ < num_samples_ || (num_samples_ == 0 && start_index_ == 0)),
+    "Invalid parameter, start_index must be in [0, num_samples), but got start_index: " +
+      std::to_string(start_index_) + ", num_samples: " + std::to_string(num_samples_));
+  samples_per_tensor_ = samples_per_tensor_ > num_samples_ ? num_samples_ : samples_per_tensor_;
+
+  // the network works on an even number of bits, which keeps the domain below 4 * num_rows and the expected
+  // number of cycle-walking steps below 4
+  int32_t bits = 2;
+  while (bits < 62 && (static_cast<uint64_t>(1) << bits) < static_cast<uint64_t>(num_rows_)) {
+    bits += 2;
+  }
+  half_bits_ = bits / 2;
+  half_mask_ = (static_cast<uint64_t>(1) << half_bits_) - 1;
+  SetEpoch(epoch_);
+
+  is_initialized = true;
+  return Status::OK();
+}
+
+Status PermutationSamplerRT::ResetSampler() {
+  CHECK_FAIL_RETURN_UNEXPECTED(next_id_ == num_samples_, "[Internal ERROR] Reset() Sampler called early or late.");
+  next_id_ = 0;
+  start_index_ = 0;
+
+  if (reshuffle_each_epoch_) {
+    SetEpoch(++epoch_);
+  }
+
+  if (HasChildSampler()) {
+    RETURN_IF_NOT_OK(child_[0]->ResetSampler());
+  }
+
+  return Status::OK();
+}
+
+int64_t PermutationSamplerRT::CalculateNumSamples(int64_t num_rows) {
+  if (start_index_ > 0) {
+    return -1;
+  }
+  return SamplerRT::CalculateNumSamples(num_rows);
+}
+
+void PermutationSamplerRT::SetEpoch(uint64_t epoch) {
+  uint64_t key = Mix(static_cast<uint64_t>(seed_) ^ Mix(epoch));
+  for (auto &round_key : round_keys_) {
+    key = Mix(key);
+    round_key = key;
+  }
+}
+
+uint64_t PermutationSamplerRT::Encrypt(uint64_t value) const {
+  uint64_t left = value >> half_bits_;
+  uint64_t right = value & half_mask_;
+  for (int round = 0; round < kNumRounds; round++) {
+    uint64_t next = left ^ (Mix(right ^ round_keys_[round]) & half_mask_);
+    left = right;
+    right = next;
+  }
+  return (left << half_bits_) | right;
+}
+
+int64_t PermutationSamplerRT::Permute(int64_t position) const {
+  // cycle-walking: a permutation of the larger domain restricted to [0, num_rows) by following each cycle until it
+  // comes back into range, which is again a permutation
+  auto value = static_cast<uint64_t>(position);
+  do {
+    value = Encrypt(value);
+  } while (value >= static_cast<uint64_t>(num_rows_));
+  return static_cast<int64_t>(value);
+}
+
+void PermutationSamplerRT::SamplerPrint(std::ostream &out, bool show_all) const {
+  out << "\nSampler: PermutationSampler";
+  if (show_all) {
+    // Call the super class for displaying any common detailed info
+    SamplerRT::SamplerPrint(out, show_all);
+    // Then add our own info
+    out << "\nSeed: " << seed_;
+    out << "\nStart index: " << start_index_;
+  }
+}
+
+Status PermutationSamplerRT::to_json(nlohmann::json *out_json) {
+  RETURN_UNEXPECTED_IF_NULL(out_json);
+  nlohmann::json args;
+  RETURN_IF_NOT_OK(SamplerRT::to_json(&args));
+  args["sampler_name"] = "PermutationSampler";
+  args["seed"] = seed_;
+  args["reshuffle_each_epoch"] = reshuffle_each_epoch_;
+  args["start_index"] = start_index_;
+  *out_json = args;
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
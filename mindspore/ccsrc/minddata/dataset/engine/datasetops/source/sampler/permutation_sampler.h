@@ -0,0 +1,93 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_PERMUTATION_SAMPLER_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_PERMUTATION_SAMPLER_H_
+
+#include <limits>
+#include <memory>
+
+#include "minddata/dataset/engine/datasetops/source/sampler/sampler.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A random sampler without replacement which never materializes the shuffled ids.
+/// \note The id at position i is computed on the fly by a seeded bijection of [0, num_rows): a balanced Feistel
+///     network over the smallest even number of bits covering num_rows, cycle-walked back into range. Memory use
+///     is constant in the number of rows, and any position of an epoch can be reached without replaying the
+///     previous ones, which is how the first epoch can start at start_index after a reset.
+class PermutationSamplerRT : public SamplerRT {
+ public:
+  // Constructor
+  // @param uint32_t seed - seed of the permutation of the first epoch
+  // @param bool reshuffle_each_epoch - T/F to use a different permutation for each epoch
+  // @param int64_t start_index - position the first epoch starts from, the following ones start from 0
+  // @param int64_t num_samples - number samples to draw
+  // @param int64_t samples_per_tensor - Num of Sampler Ids to fetch via 1 GetNextSample call
+  PermutationSamplerRT(uint32_t seed, bool reshuffle_each_epoch, int64_t start_index, int64_t num_samples,
+                       int64_t samples_per_tensor = std::numeric_limits<int64_t>::max());
+
+  // Destructor.
+  ~PermutationSamplerRT() = default;
+
+  // Op calls this to get next Sample that contains all the sampleIds
+  // @param TensorRow to be returned to StorageOp
+  // @return Status The status code returned
+  Status GetNextSample(TensorRow *out) override;
+
+  // meant to be called by base class or python
+  Status InitSampler() override;
+
+  // for next epoch of sampleIds
+  // @return Status The status code returned
+  Status ResetSampler() override;
+
+  /// \brief Gets the number of samples available
+  /// \note The first epoch returns fewer samples if it starts from a non-zero position, -1 is returned in that case
+  /// \param[in] num_rows The total number of rows in the dataset
+  /// \return int64_t Calculated number of samples
+  int64_t CalculateNumSamples(int64_t num_rows) override;
+
+  /// \brief Map a position of the current epoch to the id sampled at that position
+  /// \param[in] position Position in [0, num_rows)
+  /// \return The id at this position
+  int64_t Permute(int64_t position) const;
+
+  void SamplerPrint(std::ostream &out, bool show_all) const override;
+
+  /// \brief Get the arguments of node
+  /// \param[out] out_json JSON string of all attributes
+  /// \return Status of the function
+  Status to_json(nlohmann::json *out_json) override;
+
+ private:
+  // Set up the round keys of the permutation of the given epoch
+  void SetEpoch(uint64_t epoch);
+
+  // One pass through the Feistel network, a bijection of [0, 2^(2 * half_bits_))
+  uint64_t Encrypt(uint64_t value) const;
+
+  uint32_t seed_;
+  bool reshuffle_each_epoch_;
+  int64_t start_index_;
+  int64_t next_id_;
+  uint64_t epoch_;
+  int32_t half_bits_;
+  uint64_t half_mask_;
+  uint64_t round_keys_[4];
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_DATASETOPS_SOURCE_SAMPLER_PERMUTATION_SAMPLER_H_
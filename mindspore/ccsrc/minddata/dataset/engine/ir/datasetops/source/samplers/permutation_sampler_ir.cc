@@ -0,0 +1,95 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/permutation_sampler_ir.h"
+#include "minddata/dataset/engine/datasetops/source/sampler/permutation_sampler.h"
+#include "minddata/dataset/util/validators.h"
+
+namespace mindspore {
+namespace dataset {
+// The ids are computed on the fly, fetch them in chunks rather than building a tensor of all of them
+constexpr int64_t kPermutationSamplesPerTensor = 1024;
+
+// Constructor
+PermutationSamplerObj::PermutationSamplerObj(uint32_t seed, bool reshuffle_each_epoch, int64_t num_samples)
+    : seed_(seed), reshuffle_each_epoch_(reshuffle_each_epoch), num_samples_(num_samples), start_index_(0) {}
+
+// Destructor
+PermutationSamplerObj::~PermutationSamplerObj() = default;
+
+Status PermutationSamplerObj::ValidateParams() {
+  if (num_samples_ < 0) {
+    RETURN_STATUS_UNEXPECTED("PermutationSampler: num_samples must be greater than or equal to 0, but got: " +
+                             std::to_string(num_samples_));
+  }
+  if (start_index_ < 0) {
+    RETURN_STATUS_UNEXPECTED("PermutationSampler: start_index must be greater than or equal to 0, but got: " +
+                             std::to_string(start_index_));
+  }
+  return Status::OK();
+}
+
+Status PermutationSamplerObj::to_json(nlohmann::json *const out_json) {
+  nlohmann::json args;
+  RETURN_IF_NOT_OK(SamplerObj::to_json(&args));
+  args["sampler_name"] = "PermutationSampler";
+  args["seed"] = seed_;
+  args["reshuffle_each_epoch"] = reshuffle_each_epoch_;
+  args["num_samples"] = num_samples_;
+  args["start_index"] = start_index_;
+  *out_json = args;
+  return Status::OK();
+}
+
+#ifndef ENABLE_ANDROID
+Status PermutationSamplerObj::from_json(nlohmann::json json_obj, int64_t num_samples,
+                                        std::shared_ptr<SamplerObj> *sampler) {
+  RETURN_IF_NOT_OK(ValidateParamInJson(json_obj, "seed", "PermutationSampler"));
+  RETURN_IF_NOT_OK(ValidateParamInJson(json_obj, "reshuffle_each_epoch", "PermutationSampler"));
+  RETURN_IF_NOT_OK(ValidateParamInJson(json_obj, "start_index", "PermutationSampler"));
+  uint32_t seed = json_obj["seed"];
+  bool reshuffle_each_epoch = json_obj["reshuffle_each_epoch"];
+  int64_t start_index = json_obj["start_index"];
+  auto permutation_sampler = std::make_shared<PermutationSamplerObj>(seed, reshuffle_each_epoch, num_samples);
+  permutation_sampler->SetStartIndex(start_index);
+  *sampler = permutation_sampler;
+  // Run common code in super class to add children samplers
+  RETURN_IF_NOT_OK(SamplerObj::from_json(json_obj, sampler));
+  return Status::OK();
+}
+#endif
+
+Status PermutationSamplerObj::SamplerBuild(std::shared_ptr<SamplerRT> *sampler) {
+  // runtime sampler object
+  *sampler = std::make_shared<dataset::PermutationSamplerRT>(seed_, reshuffle_each_epoch_, start_index_, num_samples_,
+                                                             kPermutationSamplesPerTensor);
+  Status s = BuildChildren(sampler);
+  sampler = s.IsOk() ? sampler : nullptr;
+  return s;
+}
+
+std::shared_ptr<SamplerObj> PermutationSamplerObj::SamplerCopy() {
+  auto sampler = std::make_shared<PermutationSamplerObj>(seed_, reshuffle_each_epoch_, num_samples_);
+  sampler->SetStartIndex(start_index_);
+  for (const auto &child : children_) {
+    Status rc = sampler->AddChildSampler(child);
+    if (rc.IsError()) {
+      MS_LOG(ERROR) << "[Internal ERROR] Error in copying the sampler. Message: " << rc;
+    }
+  }
+  return sampler;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -62,6 +62,11 @@ class RandomSamplerObj : public SamplerObj {
 
   Status ValidateParams() override;
 
+  /// \brief Getter functions
+  bool Replacement() const { return replacement_; }
+  int64_t NumSamples() const { return num_samples_; }
+  bool ReshuffleEachEpoch() const { return reshuffle_each_epoch_; }
+
  private:
   bool replacement_;
   int64_t num_samples_;
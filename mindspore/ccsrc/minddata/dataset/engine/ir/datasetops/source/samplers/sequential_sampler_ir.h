@@ -62,6 +62,10 @@ class SequentialSamplerObj : public SamplerObj {
 
   Status ValidateParams() override;
 
+  /// \brief Getter functions
+  int64_t StartIndex() const { return start_index_; }
+  int64_t NumSamples() const { return num_samples_; }
+
  protected:
   int64_t start_index_;
   int64_t num_samples_;
@@ -120,6 +120,9 @@ class TFRecordNode : public NonMappableSourceNode {
   int32_t NumShards() const { return num_shards_; }
   bool ShardEqualRows() const { return shard_equal_rows_; }
 
+  /// \brief Setter function for the shuffle mode, used by the optimizer
+  void SetShuffle(ShuffleMode shuffle) { shuffle_ = shuffle; }
+
   /// \brief Get the arguments of node
   /// \param[out] out_json JSON string of all attributes
   /// \return Status of the function
@@ -0,0 +1,151 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/opt/pre/shuffle_pushdown_pass.h"
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/ir/datasetops/map_node.h"
+#include "minddata/dataset/engine/ir/datasetops/project_node.h"
+#include "minddata/dataset/engine/ir/datasetops/rename_node.h"
+#include "minddata/dataset/engine/ir/datasetops/shuffle_node.h"
+#ifdef ENABLE_PYTHON
+#include "minddata/dataset/engine/ir/datasetops/source/generator_node.h"
+#endif
+#ifndef ENABLE_ANDROID
+#include "minddata/dataset/engine/ir/datasetops/source/minddata_node.h"
+#endif
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/permutation_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/random_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/sequential_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/skip_first_epoch_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/tf_record_node.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+// Only a sampler drawing every row exactly once, in order or at random, can be replaced by a permutation
+bool IsFullPassSampler(const std::shared_ptr<SamplerObj> &sampler) {
+  if (sampler == nullptr || !sampler->GetChild().empty()) {
+    return false;
+  }
+  if (std::dynamic_pointer_cast<SkipFirstEpochSamplerObj>(sampler) != nullptr) {
+    return false;
+  }
+  auto sequential = std::dynamic_pointer_cast<SequentialSamplerObj>(sampler);
+  if (sequential != nullptr) {
+    return sequential->StartIndex() == 0 && sequential->NumSamples() == 0;
+  }
+  auto random = std::dynamic_pointer_cast<RandomSamplerObj>(sampler);
+  if (random != nullptr) {
+    return !random->Replacement() && random->NumSamples() == 0;
+  }
+  return false;
+}
+}  // namespace
+
+// a new shuffle node becomes the pending one, a shuffle below another shuffle is the one pushed down
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) {
+  pending_ = node->IsCached() ? nullptr : node;
+  return Status::OK();
+}
+
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<MapNode> node, bool *const modified) {
+  if (!PassThrough(node)) {
+    pending_ = nullptr;
+  }
+  return Status::OK();
+}
+
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<ProjectNode> node, bool *const modified) {
+  if (!PassThrough(node)) {
+    pending_ = nullptr;
+  }
+  return Status::OK();
+}
+
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<RenameNode> node, bool *const modified) {
+  if (!PassThrough(node)) {
+    pending_ = nullptr;
+  }
+  return Status::OK();
+}
+
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<MappableSourceNode> node, bool *const modified) {
+  if (pending_ != nullptr && !node->IsCached() && IsFullPassSampler(node->Sampler())) {
+    (void)mappable_leaves_.emplace_back(node, pending_);
+  }
+  pending_ = nullptr;
+  return Status::OK();
+}
+
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<TFRecordNode> node, bool *const modified) {
+  // the files can only be reordered if every row of every file is read
+  if (pending_ != nullptr && !node->IsCached() && node->Shuffle() == ShuffleMode::kFalse && node->NumSamples() == 0 &&
+      node->NumShards() == 1) {
+    (void)tfrecord_leaves_.emplace_back(node);
+  }
+  pending_ = nullptr;
+  return Status::OK();
+}
+
+#ifndef ENABLE_ANDROID
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<MindDataNode> node, bool *const modified) {
+  pending_ = nullptr;
+  return Status::OK();
+}
+#endif
+
+#ifdef ENABLE_PYTHON
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<GeneratorNode> node, bool *const modified) {
+  pending_ = nullptr;
+  return Status::OK();
+}
+#endif
+
+Status ShufflePushdownPass::ShuffleNodes::Visit(std::shared_ptr<DatasetNode> node, bool *const modified) {
+  pending_ = nullptr;
+  return Status::OK();
+}
+
+bool ShufflePushdownPass::ShuffleNodes::PassThrough(const std::shared_ptr<DatasetNode> &node) {
+  return pending_ != nullptr && !node->IsCached() && node->Children().size() == 1;
+}
+
+// Walk the tree to push down the shuffle nodes into the leaf nodes.
+Status ShufflePushdownPass::RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) {
+  MS_LOG(INFO) << "Pre pass: shuffle node pushdown pass started.";
+  std::unique_ptr<ShufflePushdownPass::ShuffleNodes> shuffle_nodes =
+    std::make_unique<ShufflePushdownPass::ShuffleNodes>();
+  RETURN_IF_NOT_OK(shuffle_nodes->Run(root_ir, modified));
+
+  for (const auto &[leaf, shuffle] : shuffle_nodes->mappable_leaves()) {
+    MS_LOG(INFO) << "Replacing the Shuffle(" << shuffle->ShuffleSize() << ") node by a PermutationSampler in "
+                 << leaf->Name();
+    leaf->SetSampler(std::make_shared<PermutationSamplerObj>(shuffle->ShuffleSeed(), shuffle->ResetEveryEpoch(), 0));
+    RETURN_IF_NOT_OK(shuffle->Drop());
+    *modified = true;
+  }
+
+  for (const auto &leaf : shuffle_nodes->tfrecord_leaves()) {
+    MS_LOG(INFO) << "Shuffling the files of " << leaf->Name() << " below a Shuffle node.";
+    leaf->SetShuffle(ShuffleMode::kFiles);
+    *modified = true;
+  }
+
+  MS_LOG(INFO) << "Pre pass: shuffle node pushdown pass is complete.";
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,155 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_SHUFFLE_PUSHDOWN_PASS_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_SHUFFLE_PUSHDOWN_PASS_H_
+
+#include <memory>
+#include <utility>
+#include <vector>
+#include "minddata/dataset/engine/opt/pass.h"
+
+namespace mindspore {
+namespace dataset {
+class DatasetNode;
+#ifdef ENABLE_PYTHON
+class GeneratorNode;
+#endif
+class MappableSourceNode;
+class MapNode;
+#ifndef ENABLE_ANDROID
+class MindDataNode;
+#endif
+class ProjectNode;
+class RenameNode;
+class ShuffleNode;
+class TFRecordNode;
+
+/// \class ShufflePushdownPass shuffle_pushdown_pass.h
+/// \brief This is a tree pass that pushes a shuffle node down to the leaf it shuffles. The shuffle node keeps a buffer
+///     of shuffle_size full rows, so the quality of the shuffle is bounded by the memory it can spend.
+///     - For a mappable source read in order (or already randomly), the shuffle node is removed and the leaf samples
+///       with a PermutationSampler instead, which shuffles over the whole dataset with constant memory.
+///     - For a TFRecord source that does not shuffle, the order of the files is shuffled as well, and the shuffle node
+///       is kept as the second level shuffling the rows within its buffer.
+///     A shuffle node is only pushed through Map, Project and Rename nodes which are not cached.
+class ShufflePushdownPass : public IRTreePass {
+  /// \class ShuffleNodes
+  /// \brief This is a NodePass whose job is to find the shuffle nodes that can be pushed down, and their leaf.
+  ///     It works in conjunction with the ShufflePushdownPass.
+  class ShuffleNodes : public IRNodePass {
+   public:
+    /// \brief Constructor
+    ShuffleNodes() = default;
+
+    /// \brief Destructor
+    ~ShuffleNodes() = default;
+
+    /// \brief Start a pushdown from a ShuffleNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<ShuffleNode> node, bool *const modified) override;
+
+    /// \brief Let a pending shuffle through a MapNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MapNode> node, bool *const modified) override;
+
+    /// \brief Let a pending shuffle through a ProjectNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<ProjectNode> node, bool *const modified) override;
+
+    /// \brief Let a pending shuffle through a RenameNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<RenameNode> node, bool *const modified) override;
+
+    /// \brief Complete a pending shuffle in the sampler of a MappableSourceNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MappableSourceNode> node, bool *const modified) override;
+
+    /// \brief Complete a pending shuffle by shuffling the files of a TFRecordNode
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<TFRecordNode> node, bool *const modified) override;
+
+#ifndef ENABLE_ANDROID
+    /// \brief MindDataNode uses its own samplers, stop a pending shuffle
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<MindDataNode> node, bool *const modified) override;
+#endif
+
+#ifdef ENABLE_PYTHON
+    /// \brief GeneratorNode samples in Python, stop a pending shuffle
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<GeneratorNode> node, bool *const modified) override;
+#endif
+
+    /// \brief Stop a pending shuffle on any other node
+    /// \param[in] node The node being visited
+    /// \param[in, out] modified Indicator if the node was changed at all
+    /// \return Status The status code returned
+    Status Visit(std::shared_ptr<DatasetNode> node, bool *const modified) override;
+
+    /// \brief Getter
+    /// \return The mappable leaf nodes whose sampler is replaced, paired with the shuffle node to be removed
+    const std::vector<std::pair<std::shared_ptr<MappableSourceNode>, std::shared_ptr<ShuffleNode>>> &
+    mappable_leaves() const {
+      return mappable_leaves_;
+    }
+
+    /// \brief Getter
+    /// \return The TFRecord leaf nodes whose files are to be shuffled
+    const std::vector<std::shared_ptr<TFRecordNode>> &tfrecord_leaves() const { return tfrecord_leaves_; }
+
+   private:
+    /// \brief Whether the pending shuffle can be pushed through the node
+    bool PassThrough(const std::shared_ptr<DatasetNode> &node);
+
+    std::shared_ptr<ShuffleNode> pending_;
+    std::vector<std::pair<std::shared_ptr<MappableSourceNode>, std::shared_ptr<ShuffleNode>>> mappable_leaves_;
+    std::vector<std::shared_ptr<TFRecordNode>> tfrecord_leaves_;
+  };
+
+ public:
+  /// \brief Constructor
+  ShufflePushdownPass() = default;
+
+  /// \brief Destructor
+  ~ShufflePushdownPass() = default;
+
+  /// \brief Runs a shuffle_pushdown pass to push down the shuffle nodes found in the tree.
+  /// \param[in, out] tree The tree to operate on.
+  /// \param[in, out] Indicate of the tree was modified.
+  /// \return Status The status code returned
+  Status RunOnTree(std::shared_ptr<DatasetNode> root_ir, bool *const modified) override;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_OPT_PRE_SHUFFLE_PUSHDOWN_PASS_H_
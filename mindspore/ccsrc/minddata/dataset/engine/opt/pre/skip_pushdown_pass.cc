@@ -24,6 +24,7 @@
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/ir/datasetops/source/minddata_node.h"
 #endif
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/permutation_sampler_ir.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/skip_first_epoch_sampler_ir.h"
 
 namespace mindspore {
@@ -90,9 +91,17 @@ Status SkipPushdownPass::SkipNodes::Visit(std::shared_ptr<MappableSourceNode> no
   }  // no active skip node above. normal flow
 
   // we have an active skip node above.
+  auto sampler = node->Sampler();
+  auto permutation_sampler = std::dynamic_pointer_cast<PermutationSamplerObj>(sampler);
+  if (permutation_sampler != nullptr && permutation_sampler->GetChild().empty()) {
+    // the permutation can start from any position, no need to generate the skipped ids
+    MS_LOG(INFO) << "Starting PermutationSampler from " << skip_count_;
+    permutation_sampler->SetStartIndex(permutation_sampler->StartIndex() + skip_count_);
+    skip_count_ = 0;
+    return Status::OK();
+  }
   auto new_sampler = std::make_shared<SkipFirstEpochSamplerObj>(skip_count_);
   MS_LOG(INFO) << "Adding SkipFirstEpochSampler(" << skip_count_ << ")";
-  auto sampler = node->Sampler();
   if (sampler != nullptr) {
     RETURN_IF_NOT_OK(new_sampler->AddChildSampler(sampler));
   }
@@ -24,6 +24,7 @@
 #include <string>
 #include <sstream>
 #include <iomanip>
+#include <fstream>
 #ifndef ENABLE_ANDROID
 #include "minddata/dataset/engine/datasetops/source/nonmappable_leaf_op.h"
 #include "minddata/dataset/engine/serdes.h"
@@ -53,7 +54,9 @@ AutoTune::AutoTune(TreeAdapter *tree_adap, ProfilingManager *profiling_mgr)
       phase_3_ID_(0),
       avg_batch_time(0.0),
       phase_3_prev_avg_(0.0),
-      save_autoconfig_(GlobalContext::config_manager()->save_autoconfig()) {
+      save_autoconfig_(GlobalContext::config_manager()->save_autoconfig()),
+      model_(GlobalContext::config_manager()->num_cpu_threads(), MIN_QUEUE_SIZE, MAX_QUEUE_SIZE),
+      model_stable_count_(0) {
   max_workers_ = GlobalContext::config_manager()->num_cpu_threads();
   autotune_json_filepath_ = GlobalContext::config_manager()->get_autotune_json_filepath();
 }
@@ -75,12 +78,21 @@ Status AutoTune::Main() {
   }
   bool output_final_config = save_autoconfig_ && !nodes_offloaded;
   bool output_intermediate_config = save_intermediate_autoconfig_ && output_final_config;
+#ifndef ENABLE_ANDROID
+  const std::string final_config_file = autotune_json_filepath_ + "_" + profiling_manager_->GetRankID() + ".json";
+  if (output_final_config) {
+    // A configuration tuned for the same pipeline in a previous run is the starting point of this run
+    Status rc = LoadAutotuneConfig(final_config_file);
+    if (rc.IsError()) {
+      MS_LOG(INFO) << "Unable to reuse the autotune configuration in " << final_config_file << ": " << rc;
+    }
+  }
+#endif
   RETURN_IF_NOT_OK(ATMainLoop(output_intermediate_config));
   RETURN_IF_NOT_OK(profiling_manager_->Stop());
   PostMainLogging();
 #ifndef ENABLE_ANDROID
-  if (output_final_config &&
-      (SaveAutotuneConfig(autotune_json_filepath_ + "_" + profiling_manager_->GetRankID() + ".json").IsError())) {
+  if (output_final_config && (SaveAutotuneConfig(final_config_file).IsError())) {
     MS_LOG(WARNING) << "Failed to write the final autotune configuration to disk";
   }
 #endif
@@ -155,6 +167,18 @@ Status AutoTune::SaveAutotuneConfig(const std::string &file_name) {
   nlohmann::json out_json;
   out_json["summary"] = summary;
   out_json["tree"] = autotune_config_json_;
+  RETURN_IF_NOT_OK(SetPipelineSignature());
+  out_json["signature"] = pipeline_signature_;
+  nlohmann::json config = nlohmann::json::array();
+  for (const auto &[op_id, op] : ops_) {
+    if (!op->inlined() && op->Name() != "DeviceQueueOp") {
+      config.push_back({{"op_id", op_id},
+                        {"op_name", op->Name()},
+                        {"num_parallel_workers", op->NumWorkers()},
+                        {"prefetch_size", op->ConnectorCapacity()}});
+    }
+  }
+  out_json["config"] = config;
   std::string remark_value = "The following file has been auto-generated by the Dataset AutoTune.";
   if (tree_modifier_->GetRequestsCount() == 0) {
     remark_value += " Dataset Pipeline is not the bottleneck. No configuration changes were made by Dataset AutoTune.";
@@ -179,6 +203,80 @@ Status AutoTune::SetAutotuneConfigJson() {
   }
   return Status::OK();
 }
+
+namespace {
+// Remove the fields tuned by AutoTune, what is left identifies the pipeline
+void EraseTunedFields(nlohmann::json *node) {
+  (void)node->erase("num_parallel_workers");
+  (void)node->erase("connector_queue_size");
+  if (node->contains("children")) {
+    for (auto &child : (*node)["children"]) {
+      EraseTunedFields(&child);
+    }
+  }
+}
+}  // namespace
+
+Status AutoTune::SetPipelineSignature() {
+  if (pipeline_signature_.empty()) {
+    RETURN_IF_NOT_OK(SetAutotuneConfigJson());
+    nlohmann::json pipeline = autotune_config_json_;
+    EraseTunedFields(&pipeline);
+    pipeline_signature_ = std::to_string(std::hash<std::string>{}(pipeline.dump()));
+  }
+  return Status::OK();
+}
+
+Status AutoTune::LoadAutotuneConfig(const std::string &file_name) {
+  Path jsonpath(file_name);
+  if (!jsonpath.Exists()) {
+    return Status::OK();
+  }
+  nlohmann::json saved;
+  std::ifstream json_in(file_name);
+  CHECK_FAIL_RETURN_UNEXPECTED(json_in, "Invalid file, failed to open json file: " + file_name);
+  try {
+    json_in >> saved;
+  } catch (const std::exception &e) {
+    RETURN_STATUS_UNEXPECTED("Invalid file, failed to parse json file: " + file_name + ", error message: " + e.what());
+  }
+  RETURN_IF_NOT_OK(SetPipelineSignature());
+  if (saved.find("signature") == saved.end() || saved["signature"] != pipeline_signature_ ||
+      saved.find("config") == saved.end()) {
+    MS_LOG(INFO) << "The autotune configuration in " << file_name << " was saved for a different pipeline.";
+    return Status::OK();
+  }
+  // a hand-edited, truncated or stale configuration is ignored, and the pipeline is tuned from scratch
+  std::vector<OpConfig> configs;
+  try {
+    for (const auto &entry : saved.at("config")) {
+      OpConfig config{entry.at("op_id").get<int32_t>(), entry.at("num_parallel_workers").get<int32_t>(),
+                      entry.at("prefetch_size").get<int32_t>()};
+      auto itr = ops_.find(config.op_id);
+      if (itr == ops_.end() || itr->second->Name() != entry.at("op_name").get<std::string>()) {
+        MS_LOG(INFO) << "Operator " << config.op_id << " does not match the autotune configuration in " << file_name
+                     << ", which is ignored.";
+        return Status::OK();
+      }
+      configs.push_back(config);
+    }
+  } catch (const std::exception &e) {
+    MS_LOG(INFO) << "Invalid autotune configuration in " << file_name << ", which is ignored. Error message: "
+                 << e.what();
+    return Status::OK();
+  }
+  MS_LOG(INFO) << "Starting Dataset AutoTune from the configuration in " << file_name;
+  for (auto &config : configs) {
+    auto op = ops_[config.op_id];
+    if (config.num_workers > 0 && config.num_workers != op->NumWorkers()) {
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(config.op_id, op->NumWorkers(), &config.num_workers));
+    }
+    if (config.queue_capacity > 0 && config.queue_capacity != op->ConnectorCapacity()) {
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(config.op_id, op->ConnectorCapacity(), config.queue_capacity));
+    }
+  }
+  return Status::OK();
+}
 #endif
 
 Status AutoTune::SummarizeTreeConfiguration(std::vector<std::string> *out) {
@@ -329,6 +427,51 @@ Status AutoTune::GetOpsNumWorker(std::map<int32_t, int32_t> *ops_num_workers) {
   return Status::OK();
 }
 
+Status AutoTune::GetOpsLoad(std::vector<OpLoad> *ops_load) {
+  std::map<int32_t, double> out_ops_queue_util;
+  std::map<int32_t, double> in_ops_queue_util;
+  RETURN_IF_NOT_OK(GetOpsQueueUtil(&out_ops_queue_util, &in_ops_queue_util));
+  std::map<int32_t, double> ops_cpu_util;
+  RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
+  for (const auto &[op_id, op] : ops_) {
+    if (op->Name() == "DeviceQueueOp") {
+      continue;
+    }
+    OpLoad load;
+    load.op_id = op_id;
+    load.num_workers = op->NumWorkers();
+    load.cpu_util = ops_cpu_util[op_id];
+    if (!op->inlined()) {
+      load.queue_capacity = op->ConnectorCapacity();
+      load.queue_size = out_ops_queue_util[op_id] * load.queue_capacity;
+    }
+    load.tunable = load.num_workers > 0 && !SkipOpsCheck(op_id);
+    ops_load->push_back(load);
+  }
+  return Status::OK();
+}
+
+Status AutoTune::GetMemoryInfo(double *process_memory, double *available_memory) {
+  std::vector<float> pss;
+  std::vector<float> available;
+#ifndef ENABLE_ANDROID
+  if (mode_ == AutoTuneMode::kAutoTuneModeEpoch) {
+    RETURN_IF_NOT_OK(
+      profiling_manager_->GetMainProcessMemoryInfoByEpoch(ProcessMemoryMetric::kPSS, cur_epoch_running_, &pss));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSystemMemoryInfoByEpoch(SystemMemoryMetric::kMemoryAvailable,
+                                                                    cur_epoch_running_, &available));
+  } else if (mode_ == AutoTuneMode::kAutoTuneModeStep) {
+    RETURN_IF_NOT_OK(profiling_manager_->GetMainProcessMemoryInfoByStep(
+      ProcessMemoryMetric::kPSS, last_step_autotuned_, cur_step_running_ - 1, &pss));
+    RETURN_IF_NOT_OK(profiling_manager_->GetSystemMemoryInfoByStep(
+      SystemMemoryMetric::kMemoryAvailable, last_step_autotuned_, cur_step_running_ - 1, &available));
+  }
+#endif
+  *process_memory = Mean(pss);
+  *available_memory = Mean(available);
+  return Status::OK();
+}
+
 bool AutoTune::IsSink() const {
   std::shared_ptr<Tracing> node;
   return profiling_manager_->GetTracingNode(kDeviceQueueTracingName, &node).IsOk();
@@ -438,6 +581,7 @@ Status AutoTune::TrackPipelineTime() {
   }
   double avg_time_pipeline = Mean(pipeline_times);
   double avg_time_batch = Mean(batch_times);
+  avg_batch_time = avg_time_batch;
   (void)avg_pipeline_times_.push_back(avg_time_pipeline);
   MS_LOG(INFO) << "Average Pipeline time is " << avg_time_pipeline << " ms. The avg pipeline time for all epochs is "
                << Mean(avg_pipeline_times_) << "ms";
@@ -592,65 +736,50 @@ bool AutoTune::SkipOpsCheck(int op_id) {
 }
 
 Status AutoTune::AnalyseTime() {
+  // update the cost model with the last interval
+  std::vector<OpLoad> ops_load;
+  RETURN_IF_NOT_OK(GetOpsLoad(&ops_load));
+  double process_memory = 0;
+  double available_memory = 0;
+  RETURN_IF_NOT_OK(GetMemoryInfo(&process_memory, &available_memory));
+  if (model_.MemoryBudget() == 0 && available_memory > 0) {
+    model_.SetMemoryBudget(available_memory * MEMORY_BUDGET_PERCENT);
+    MS_LOG(INFO) << "Memory budget of the connectors: " << model_.MemoryBudget() << " MB.";
+  }
+  RETURN_IF_NOT_OK(model_.AddSample(ops_load, avg_batch_time, process_memory));
   // check for connector queue bottleneck
   bool isBottleneck = false;
   RETURN_IF_NOT_OK(IsDSaBottleneck(&isBottleneck));
   if (!isBottleneck) {
     return Status::OK();
   }
-  // collect stats
-  std::map<int32_t, int32_t> ops_num_workers;
-  RETURN_IF_NOT_OK(GetOpsNumWorker(&ops_num_workers));
-  std::map<int32_t, double> out_ops_queue_util;
-  std::map<int32_t, double> in_ops_queue_util;
-  RETURN_IF_NOT_OK(GetOpsQueueUtil(&out_ops_queue_util, &in_ops_queue_util));
-  std::map<int32_t, double> ops_cpu_util;
-  RETURN_IF_NOT_OK(GetOpsCpuUtil(&ops_cpu_util));
-  // check parallel ops in loop
-  for (const auto &op_id : parallel_ops_ids_) {
-    if (SkipOpsCheck(op_id)) {
-      continue;
+  std::vector<OpConfig> configs;
+  RETURN_IF_NOT_OK(model_.Solve(&configs));
+  std::map<int32_t, int32_t> new_workers;
+  bool changed = false;
+  for (auto &config : configs) {
+    new_workers[config.op_id] = config.num_workers;
+    int32_t num_workers = ops_[config.op_id]->NumWorkers();
+    int32_t queue_capacity = ops_[config.op_id]->ConnectorCapacity();
+    if (config.num_workers != num_workers) {
+      RETURN_IF_NOT_OK(RequestNumWorkerChange(config.op_id, num_workers, &config.num_workers));
+      changed = true;
     }
-    // op specifics
-    double output_queue_util = out_ops_queue_util[op_id];
-    double input_queue_util = in_ops_queue_util[op_id];
-    double cpu_util = ops_cpu_util[op_id];
-    int32_t num_workers = ops_num_workers[op_id];
-    CHECK_FAIL_RETURN_UNEXPECTED(num_workers != 0, "ParallelOp with num_workers=0");
-    // derived metrics
-    double queue_diff = input_queue_util - output_queue_util;
-    int64_t queue_capacity;
-    RETURN_IF_NOT_OK(GetOpConnectorCapacity(op_id, &queue_capacity));
-    int64_t new_queue_capacity = queue_capacity;
-    int32_t requested_workers = 0;
-    MS_LOG(DEBUG) << "Op (" << ops_[op_id]->NameWithID() << ") CPU=" << cpu_util / num_workers
-                  << ", in=" << input_queue_util << "out=" << output_queue_util;
-    // map decisions - queue
-    if (queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD) {
-      MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID()
-                   << ") is slow, input connector utilization=" << input_queue_util
-                   << ", output connector utilization=" << output_queue_util << ", diff= " << queue_diff << " > "
-                   << INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD << " threshold.";
-      requested_workers = num_workers + INCREMENT_WORKER;
-      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
-    } else if ((cpu_util / num_workers) > MAP_OP_WORKER_HIGH_THRESHOLD) {
-      MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID() << ") getting high average worker cpu utilization "
-                   << (cpu_util / num_workers) << "% > " << MAP_OP_WORKER_HIGH_THRESHOLD << "% threshold.";
-      requested_workers = num_workers + INCREMENT_WORKER;
-      RETURN_IF_NOT_OK(RequestNumWorkerChange(op_id, num_workers, &requested_workers));
-    }
-    if ((cpu_util / num_workers) < MAP_OP_WORKER_LOW_THRESHOLD &&
-        ((input_queue_util < INPUT_QUEUE_LOW) || (-1 * queue_diff > INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD))) {
-      MS_LOG(INFO) << "Op (" << ops_[op_id]->NameWithID() << ") getting low average worker cpu utilization "
-                   << (cpu_util / num_workers) << "% < " << MAP_OP_WORKER_LOW_THRESHOLD << "% threshold.";
-      new_queue_capacity = queue_capacity + INCREMENT_QUEUE_SIZE;
-      if (requested_workers == 0) {
-        requested_workers = num_workers;
-      }
-      new_queue_capacity = std::max(new_queue_capacity, static_cast<int64_t>(requested_workers));
-      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(op_id, queue_capacity, new_queue_capacity));
+    if (config.queue_capacity != queue_capacity) {
+      RETURN_IF_NOT_OK(RequestConnectorCapacityChange(config.op_id, queue_capacity, config.queue_capacity));
+      changed = true;
     }
   }
+  if (changed) {
+    model_stable_count_ = 0;
+    MS_LOG(INFO) << "Estimated throughput goes from " << model_.EstimateThroughput({}) << " to "
+                 << model_.EstimateThroughput(new_workers) << " batches per second, the estimated memory per row is "
+                 << model_.MemoryPerRow() << " MB.";
+  } else if (++model_stable_count_ >= MODEL_STABLE_ITERATIONS) {
+    MS_LOG(INFO) << "Dataset AutoTune configuration has converged, estimated throughput is "
+                 << model_.EstimateThroughput({}) << " batches per second.";
+    AT_phase_ = AutoTunePhase::kAutoTunePhaseMemory;
+  }
   return Status::OK();
 }
 
@@ -27,6 +27,7 @@
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/engine/tree_adapter.h"
 #include "minddata/dataset/engine/tree_modifier.h"
+#include "minddata/dataset/engine/perf/auto_tune_model.h"
 #include "minddata/dataset/engine/perf/profiling.h"
 
 namespace mindspore {
@@ -74,6 +75,15 @@ class AutoTune {
   /// Setter for autotune_config_json_
   /// \return Status code
   Status SetAutotuneConfigJson();
+
+  /// \brief Compute the signature of the pipeline, which ignores the workers and queue sizes
+  /// \return Status code
+  Status SetPipelineSignature();
+
+  /// \brief Start from the workers and queue sizes of a configuration saved for the same pipeline
+  /// \param file_name Name of the file
+  /// \return Status code
+  Status LoadAutotuneConfig(const std::string &file_name);
 #endif
 
   /// Function to collect info from the tree
@@ -129,21 +139,14 @@ class AutoTune {
   // Warmup specifics
   const int32_t EPOCH_WARMUP = 1;
   const int64_t STEP_WARMUP = 150;
-  // Worker specifics
-  const int32_t INCREMENT_WORKER = 2;
-  const int32_t DECREMENT_WORKER = -1;
-  // Queue Specifics
-  const float_t INPUT_QUEUE_LOW = 0.5;
-
   // Value to maintain checking for device_queue utlization at.
   const float_t DEVICE_CONNECTOR_UTIL_THRESHOLD = 0.75;
 
-  const float_t LEAF_QUEUE_THRESHOLD = 0.9;
-  const float_t INPUT_OUTPUT_QUEUE_DIFF_THRESHOLD = 0.35;
-  const int64_t INCREMENT_QUEUE_SIZE = 4;
-  // CPU Specifics
-  const float_t MAP_OP_WORKER_HIGH_THRESHOLD = 75;
-  const float_t MAP_OP_WORKER_LOW_THRESHOLD = 35;
+  // Model specifics
+  // Number of consecutive iterations without any change before the time phase is complete
+  const int32_t MODEL_STABLE_ITERATIONS = 2;
+  // Share of the available system memory the rows in the connectors may hold
+  const float MEMORY_BUDGET_PERCENT = 0.3;
   // Running mode specifics
   enum AutoTuneMode { kAutoTuneModeEpoch, kAutoTuneModeStep };
   enum AutoTunePhase { kAutoTunePhaseTime, kAutoTunePhaseMemory, kAutoTuneEnd };
@@ -179,12 +182,23 @@ class AutoTune {
   /// \return Status code
   Status GetOpsNumWorker(std::map<int32_t, int32_t> *ops_num_workers);
 
+  /// Get the load of each operator in the pipeline for the cost model
+  /// \param[out] ops_load load of every operator
+  /// \return Status code
+  Status GetOpsLoad(std::vector<OpLoad> *ops_load);
+
+  /// Get the average memory used by the process
+  /// \param[out] process_memory PSS in MB, 0 if not available
+  /// \param[out] available_memory available system memory in MB, 0 if not available
+  /// \return Status code
+  Status GetMemoryInfo(double *process_memory, double *available_memory);
+
   /// Check whether an op is an unsupported by AutoTune
   /// \param op_id ID to check
   /// \return bool to skip or not
   bool SkipOpsCheck(int op_id);
 
-  /// Main AutoTune algorithm
+  /// Main AutoTune algorithm, feeds the cost model and applies the allocation it solves for
   /// \return Status code
   Status AnalyseTime();
 
@@ -300,6 +314,14 @@ class AutoTune {
 
   /// Serialized json of the optimized ir tree that holds the updated configuration (workers and queue size)
   nlohmann::json autotune_config_json_;
+
+  /// Signature of the pipeline the saved configuration belongs to
+  std::string pipeline_signature_;
+
+  /// Cost model estimating the throughput of the operators
+  AutoTuneModel model_;
+  /// Number of consecutive iterations the model did not change the configuration
+  int32_t model_stable_count_;
 };
 }  // namespace dataset
 }  // namespace mindspore
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2021-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "minddata/dataset/engine/perf/auto_tune_model.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr double kPercent = 100.0;
+// weight of the newest sample in the smoothed costs
+constexpr double kCostSmoothing = 0.5;
+// weight kept by the older samples in the memory fit
+constexpr double kMemoryDecay = 0.8;
+// costs below this are too small to be measured, the operator is never the bottleneck
+constexpr double kMinCost = 1e-6;
+// the memory fit needs the number of queued rows to vary
+constexpr double kMinRowsVariance = 1.0;
+// connector slots per worker, enough to keep the workers and the consumer busy
+constexpr int32_t kQueueSlotsPerWorker = 2;
+}  // namespace
+
+AutoTuneModel::AutoTuneModel(int32_t max_workers, int32_t min_queue_size, int32_t max_queue_size)
+    : max_workers_(max_workers),
+      min_queue_size_(min_queue_size),
+      max_queue_size_(max_queue_size),
+      memory_budget_(0),
+      num_samples_(0),
+      weight_sum_(0),
+      rows_sum_(0),
+      memory_sum_(0),
+      rows_rows_sum_(0),
+      rows_memory_sum_(0) {}
+
+Status AutoTuneModel::AddSample(const std::vector<OpLoad> &ops, double batch_time, double process_memory) {
+  CHECK_FAIL_RETURN_UNEXPECTED(batch_time >= 0, "Batch time should not be negative, but got: " +
+                                                  std::to_string(batch_time));
+  if (batch_time == 0) {
+    // no batch in this interval, nothing can be derived from it
+    return Status::OK();
+  }
+  double queued_rows = 0;
+  for (const auto &op : ops) {
+    double cost = op.cpu_util / kPercent * batch_time;
+    auto [itr, inserted] = ops_.try_emplace(op.op_id);
+    OpState &state = itr->second;
+    state.cost = inserted ? cost : (1 - kCostSmoothing) * state.cost + kCostSmoothing * cost;
+    state.num_workers = op.num_workers;
+    state.queue_capacity = op.queue_capacity;
+    state.tunable = op.tunable;
+    queued_rows += op.queue_size;
+  }
+  if (process_memory > 0) {
+    weight_sum_ = kMemoryDecay * weight_sum_ + 1;
+    rows_sum_ = kMemoryDecay * rows_sum_ + queued_rows;
+    memory_sum_ = kMemoryDecay * memory_sum_ + process_memory;
+    rows_rows_sum_ = kMemoryDecay * rows_rows_sum_ + queued_rows * queued_rows;
+    rows_memory_sum_ = kMemoryDecay * rows_memory_sum_ + queued_rows * process_memory;
+  }
+  ++num_samples_;
+  return Status::OK();
+}
+
+double AutoTuneModel::MemoryPerRow() const {
+  if (weight_sum_ <= 1) {
+    return 0;
+  }
+  double mean_rows = rows_sum_ / weight_sum_;
+  double mean_memory = memory_sum_ / weight_sum_;
+  double variance = rows_rows_sum_ / weight_sum_ - mean_rows * mean_rows;
+  if (variance < kMinRowsVariance) {
+    return 0;
+  }
+  double covariance = rows_memory_sum_ / weight_sum_ - mean_rows * mean_memory;
+  return std::max(covariance / variance, 0.0);
+}
+
+double AutoTuneModel::CpuBound() const {
+  double total_cost = 0;
+  for (const auto &[op_id, state] : ops_) {
+    total_cost += state.cost;
+  }
+  return total_cost > kMinCost ? max_workers_ / total_cost : std::numeric_limits<double>::infinity();
+}
+
+double AutoTuneModel::EstimateThroughput(const std::map<int32_t, int32_t> &num_workers) const {
+  if (ops_.empty()) {
+    return 0;
+  }
+  double rate = CpuBound();
+  for (const auto &[op_id, state] : ops_) {
+    auto itr = num_workers.find(op_id);
+    int32_t workers = itr != num_workers.end() ? itr->second : state.num_workers;
+    if (workers > 0 && state.cost > kMinCost) {
+      rate = std::min(rate, workers / state.cost);
+    }
+  }
+  const double ms_per_second = 1000.0;
+  return std::isinf(rate) ? 0 : rate * ms_per_second;
+}
+
+Status AutoTuneModel::Solve(std::vector<OpConfig> *configs) const {
+  RETURN_UNEXPECTED_IF_NULL(configs);
+  configs->clear();
+  std::map<int32_t, int32_t> workers;
+  int32_t total_workers = 0;
+  for (const auto &[op_id, state] : ops_) {
+    total_workers += state.num_workers;
+    if (state.tunable && state.num_workers > 0) {
+      workers[op_id] = state.num_workers;
+    }
+  }
+  if (workers.empty()) {
+    return Status::OK();
+  }
+
+  // water-filling, the slowest operator gets the next worker
+  double cpu_bound = CpuBound();
+  while (total_workers < max_workers_) {
+    int32_t slowest = -1;
+    double slowest_rate = std::numeric_limits<double>::infinity();
+    for (const auto &[op_id, num_workers] : workers) {
+      double cost = ops_.at(op_id).cost;
+      if (cost > kMinCost && num_workers / cost < slowest_rate) {
+        slowest = op_id;
+        slowest_rate = num_workers / cost;
+      }
+    }
+    // more workers only add contention once the cores are saturated
+    if (slowest == -1 || slowest_rate >= cpu_bound) {
+      break;
+    }
+    ++workers[slowest];
+    ++total_workers;
+  }
+
+  // give every connector room for a few rows per worker
+  double fixed_rows = 0;
+  double tunable_rows = 0;
+  for (const auto &[op_id, state] : ops_) {
+    auto itr = workers.find(op_id);
+    if (itr == workers.end()) {
+      fixed_rows += state.queue_capacity;
+      continue;
+    }
+    int32_t capacity = std::max(state.queue_capacity, kQueueSlotsPerWorker * itr->second);
+    capacity = std::clamp(capacity, min_queue_size_, max_queue_size_);
+    configs->push_back({op_id, itr->second, capacity});
+    tunable_rows += capacity;
+  }
+
+  // scale the connectors down when the rows they hold would go beyond the memory budget
+  double memory_per_row = MemoryPerRow();
+  if (memory_budget_ > 0 && memory_per_row > 0 && tunable_rows * memory_per_row > memory_budget_) {
+    double allowed_rows = std::max(memory_budget_ / memory_per_row - fixed_rows, 0.0);
+    double scale = allowed_rows / tunable_rows;
+    for (auto &config : *configs) {
+      auto capacity = static_cast<int32_t>(std::floor(config.queue_capacity * scale));
+      config.queue_capacity = std::clamp(std::max(capacity, config.num_workers), min_queue_size_, max_queue_size_);
+    }
+  }
+  return Status::OK();
+}
+}  // namespace dataset
+}  // namespace mindspore
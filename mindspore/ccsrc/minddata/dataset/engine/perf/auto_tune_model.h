@@ -0,0 +1,124 @@
+/**
+ * Copyright 2021-2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_MODEL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_MODEL_H_
+
+#include <cstdint>
+#include <map>
+#include <vector>
+#include "minddata/dataset/util/status.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Load of an operator measured over one AutoTune interval.
+struct OpLoad {
+  int32_t op_id = -1;
+  int32_t num_workers = 0;     // 0 for an operator without workers
+  int32_t queue_capacity = 0;  // capacity of the output connector, 0 for an inlined operator
+  double queue_size = 0;       // average number of rows in the output connector
+  double cpu_util = 0;         // average CPU utilization in percent of one core, summed over all the threads
+  bool tunable = false;        // whether AutoTune may change the workers and the queue size
+};
+
+/// \brief Configuration suggested for a tunable operator.
+struct OpConfig {
+  int32_t op_id;
+  int32_t num_workers;
+  int32_t queue_capacity;
+};
+
+/// This is the cost model behind AutoTune.
+///
+/// The cost of an operator is the CPU time it spends per batch, derived from its CPU utilization and the time
+/// between two batches. Costs are smoothed over the intervals, so a single noisy measurement can't flip the
+/// allocation back and forth. With every worker using at most one core, an operator with w workers can produce at
+/// most w / cost batches per ms, and the pipeline as a whole can't go beyond max_workers / (sum of the costs).
+///
+/// The memory held by a queued row is fitted from the process memory against the number of rows waiting in the
+/// connectors, and bounds the total capacity of the connectors once a memory budget is given.
+class AutoTuneModel {
+ public:
+  /// Constructor
+  /// \param max_workers Number of CPU threads the pipeline may use
+  /// \param min_queue_size Lower bound of the connector capacity
+  /// \param max_queue_size Upper bound of the connector capacity
+  AutoTuneModel(int32_t max_workers, int32_t min_queue_size, int32_t max_queue_size);
+
+  ~AutoTuneModel() = default;
+
+  /// \brief Set the memory the rows in the connectors may hold in total
+  /// \param budget Memory budget in MB, 0 for no limit
+  void SetMemoryBudget(double budget) { memory_budget_ = budget; }
+
+  /// \return The memory budget in MB, 0 for no limit
+  double MemoryBudget() const { return memory_budget_; }
+
+  /// \brief Update the model with the measurements of one interval
+  /// \param ops Load of every operator of the pipeline
+  /// \param batch_time Average time between two batches in ms
+  /// \param process_memory Average memory used by the process in MB, 0 if unknown
+  /// \return Status object
+  Status AddSample(const std::vector<OpLoad> &ops, double batch_time, double process_memory);
+
+  /// \return Number of samples the model is built on
+  int32_t NumSamples() const { return num_samples_; }
+
+  /// \brief Estimate the throughput of the pipeline for a given number of workers per operator
+  /// \param num_workers Map from op_id to the number of workers, operators not in it keep their current number
+  /// \return Estimated batches per second, 0 if nothing is known yet
+  double EstimateThroughput(const std::map<int32_t, int32_t> &num_workers) const;
+
+  /// \return Estimated memory in MB held by one row waiting in a connector, 0 while unknown
+  double MemoryPerRow() const;
+
+  /// \brief Allocate the workers and the connector capacities of the tunable operators.
+  ///     Workers are given one at a time to the operator with the lowest throughput until the CPU budget is used
+  ///     up or the pipeline is bound by the total CPU time. An operator never loses workers, which keeps the
+  ///     allocation monotonic between two calls. Connectors get room for a few rows per worker, and are scaled
+  ///     down when they could hold more than the memory budget.
+  /// \param[out] configs Suggested configuration of every tunable operator
+  /// \return Status object
+  Status Solve(std::vector<OpConfig> *configs) const;
+
+ private:
+  struct OpState {
+    double cost = 0;  // CPU time per batch in ms
+    int32_t num_workers = 0;
+    int32_t queue_capacity = 0;
+    bool tunable = false;
+  };
+
+  /// \brief Highest throughput the total CPU time allows, in batches per ms
+  double CpuBound() const;
+
+  int32_t max_workers_;
+  int32_t min_queue_size_;
+  int32_t max_queue_size_;
+  double memory_budget_;
+  int32_t num_samples_;
+  std::map<int32_t, OpState> ops_;
+
+  // exponentially weighted sums for the fit of the process memory against the queued rows
+  double weight_sum_;
+  double rows_sum_;
+  double memory_sum_;
+  double rows_rows_sum_;
+  double rows_memory_sum_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_ENGINE_PERF_AUTO_TUNE_MODEL_H_
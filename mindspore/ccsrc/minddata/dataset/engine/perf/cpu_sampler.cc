@@ -28,8 +28,10 @@
 
 #include "minddata/dataset/api/python/pybind_conversion.h"
 #include "minddata/dataset/core/config_manager.h"
+#include "minddata/dataset/core/global_context.h"
 #include "minddata/dataset/engine/execution_tree.h"
 #include "minddata/dataset/util/path.h"
+#include "minddata/dataset/util/slab_pool.h"
 
 namespace mindspore {
 namespace dataset {
@@ -44,7 +46,8 @@ int32_t SystemInfo::num_cpu_ = get_nprocs_conf();
 int32_t SystemInfo::num_cpu_ = 0;
 #endif
 
-constexpr uint64_t kBInMB = 1024;  // Constant for kByte to MByte division conversion
+constexpr uint64_t kBInMB = 1024;         // Constant for kByte to MByte division conversion
+constexpr float kMBToBytes = 1048576.0f;  // Constant for Byte to MByte division conversion
 
 Status SystemInfo::ParseCpuInfo(const std::string &str) {
   SystemStat system_cpu_stat;
@@ -453,6 +456,12 @@ Status CpuSampler::Sample() {
     op_info.CalculateOperatorUtilization();
   }
 
+  // Sample the usage of the tensor pool
+  SlabPoolStats pool_stats = GlobalContext::Instance()->tensor_pool()->GetStats();
+  (void)tensor_pool_info_.emplace_back(TensorPoolInfo{static_cast<float>(pool_stats.bytes_in_use) / kMBToBytes,
+                                                      static_cast<float>(pool_stats.bytes_cached) / kMBToBytes,
+                                                      pool_stats.num_allocations, pool_stats.num_reused});
+
   // Get sampling time.
   (void)ts_.emplace_back(ProfilingTime::GetCurMilliSecond());
 
@@ -537,6 +546,7 @@ void CpuSampler::Clear() {
   main_thread_cpu_info_.reset();
   main_process_info_.reset();
   op_info_by_id_.clear();
+  tensor_pool_info_.clear();
   fetched_all_python_multiprocesses_ = false;
 }
 
@@ -602,6 +612,20 @@ Status CpuSampler::SaveToFile(const std::string &dir_path, const std::string &ra
                                   {"available_sys_memory_mbytes", mem_avail},
                                   {"used_sys_memory_mbytes", mem_used}};
 
+  std::vector<float> pool_in_use, pool_cached;
+  std::vector<uint64_t> pool_allocations, pool_reused;
+  for (const auto &info : tensor_pool_info_) {
+    pool_in_use.push_back(info.in_use_mem);
+    pool_cached.push_back(info.cached_mem);
+    pool_allocations.push_back(info.num_allocations);
+    pool_reused.push_back(info.num_reused);
+  }
+  output["tensor_pool_info"] = {{"capacity_mbytes", GlobalContext::config_manager()->tensor_pool_size()},
+                                {"in_use_mbytes", pool_in_use},
+                                {"cached_mbytes", pool_cached},
+                                {"allocations", pool_allocations},
+                                {"reused_allocations", pool_reused}};
+
   // Discard the content of the file when opening.
   std::ofstream os(file_path, std::ios::trunc);
   os << output;
@@ -60,6 +60,13 @@ typedef struct MemoryInfo_s {
   float pss;
 } MemoryInfo;
 
+typedef struct TensorPoolInfo_s {
+  float in_use_mem;
+  float cached_mem;
+  uint64_t num_allocations;
+  uint64_t num_reused;
+} TensorPoolInfo;
+
 typedef struct SystemMemInfo_s {
   float total_mem;
   float available_mem;
@@ -205,6 +212,7 @@ class CpuSampler : public Sampling {
   std::shared_ptr<ThreadCpuInfo> main_thread_cpu_info_;
   std::shared_ptr<ProcessInfo> main_process_info_;
   std::unordered_map<int32_t, MDOperatorCpuInfo> op_info_by_id_;
+  std::vector<TensorPoolInfo> tensor_pool_info_;  // usage of the recycling tensor pool at each sample
   Path GetFileName(const std::string &dir_path, const std::string &rank_id) override;
 };
 }  // namespace dataset
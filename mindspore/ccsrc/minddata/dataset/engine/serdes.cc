@@ -242,6 +242,8 @@ Status Serdes::ConstructSampler(nlohmann::json json_obj, std::shared_ptr<Sampler
   std::string sampler_name = json_obj["sampler_name"];
   if (sampler_name == "DistributedSampler") {
     RETURN_IF_NOT_OK(DistributedSamplerObj::from_json(json_obj, num_samples, sampler));
+  } else if (sampler_name == "PermutationSampler") {
+    RETURN_IF_NOT_OK(PermutationSamplerObj::from_json(json_obj, num_samples, sampler));
   } else if (sampler_name == "PKSampler") {
     RETURN_IF_NOT_OK(PKSamplerObj::from_json(json_obj, num_samples, sampler));
   } else if (sampler_name == "RandomSampler") {
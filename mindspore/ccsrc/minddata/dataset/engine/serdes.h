@@ -60,6 +60,7 @@
 #include "minddata/dataset/engine/ir/datasetops/source/voc_node.h"
 
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/distributed_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/permutation_sampler_ir.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/pk_sampler_ir.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/prebuilt_sampler_ir.h"
 #include "minddata/dataset/engine/ir/datasetops/source/samplers/random_sampler_ir.h"
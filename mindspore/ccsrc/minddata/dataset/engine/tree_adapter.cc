@@ -36,6 +36,7 @@
 #include "minddata/dataset/engine/opt/pre/getter_pass.h"
 #include "minddata/dataset/engine/opt/pre/input_validation_pass.h"
 #include "minddata/dataset/engine/opt/pre/node_removal_pass.h"
+#include "minddata/dataset/engine/opt/pre/shuffle_pushdown_pass.h"
 #include "minddata/dataset/engine/opt/pre/skip_pushdown_pass.h"
 
 namespace mindspore {
@@ -60,6 +61,10 @@ Status TreeAdapter::PrePass(std::shared_ptr<DatasetNode> ir) {
   MS_LOG(INFO) << "Running pre pass loops.";
   (void)actions.emplace_back(std::make_unique<InputValidationPass>());
   (void)actions.emplace_back(std::make_unique<CacheValidationPass>());
+  if (optimize_) {
+    // Runs ahead of the skip passes, so that a reset can start a PermutationSampler from the skipped position
+    (void)actions.emplace_back(std::make_unique<ShufflePushdownPass>());
+  }
   if (usage_ == kDeReset) {
     (void)actions.emplace_back(std::make_unique<AddSkipPass>());
     (void)actions.emplace_back(std::make_unique<SkipPushdownPass>());
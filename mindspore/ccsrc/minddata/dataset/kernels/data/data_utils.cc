@@ -437,43 +437,103 @@ Status PadEndNumeric(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor>
                                  "PadEnd: invalid pad shape, as rank of input is: " + std::to_string(src->Rank()) +
                                    ", and rank of pad value: " + std::to_string(pad_shape.size()));
     RETURN_IF_NOT_OK(Tensor::CreateEmpty(TensorShape(pad_shape), src->type(), dst));
-    auto tensor_type = src->type().value();
-    if (std::fabs(pad_val) <= std::numeric_limits<float>::epsilon()) {  // if pad with zero, don't care what type it is
-      RETURN_IF_NOT_OK((*dst)->Zero());
-    } else if (tensor_type == DataType::DE_INT8) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int8_t>(static_cast<int8_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_BOOL) {
-      RETURN_IF_NOT_OK((*dst)->Fill<bool>(static_cast<bool>(pad_val)));
-    } else if (tensor_type == DataType::DE_UINT8) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint8_t>(static_cast<uint8_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_INT16) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int16_t>(static_cast<int16_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_FLOAT16) {
-      RETURN_IF_NOT_OK((*dst)->Fill<float16>(static_cast<float16>(pad_val)));
-    } else if (tensor_type == DataType::DE_UINT16) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint16_t>(static_cast<uint16_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_INT32) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int32_t>(static_cast<int32_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_UINT32) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint32_t>(static_cast<uint32_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_INT64) {
-      RETURN_IF_NOT_OK((*dst)->Fill<int64_t>(static_cast<int64_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_UINT64) {
-      RETURN_IF_NOT_OK((*dst)->Fill<uint64_t>(static_cast<uint64_t>(pad_val)));
-    } else if (tensor_type == DataType::DE_FLOAT32) {
-      RETURN_IF_NOT_OK((*dst)->Fill<float>(static_cast<float>(pad_val)));
-    } else if (tensor_type == DataType::DE_FLOAT64) {
-      RETURN_IF_NOT_OK((*dst)->Fill<double>(static_cast<double>(pad_val)));
-    } else {
-      RETURN_STATUS_UNEXPECTED(
-        "PadEnd: Incorrect/Unknown datatype, supported datatype is: [bool, int8, uint8, int16, uint16, int32, uint32, "
-        "int64, uint64, float16, float32, float64].");
-    }
+    RETURN_IF_NOT_OK(FillPadValue(*dst, pad_val));
     std::vector<dsize_t> cur_ind(src->Rank(), 0);
     RETURN_IF_NOT_OK(PadEndNumericHelper(src, *dst, cur_ind, 0));
   }
   return Status::OK();
 }
+Status FillPadValue(const std::shared_ptr<Tensor> &tensor, float pad_val) {
+  RETURN_UNEXPECTED_IF_NULL(tensor);
+  auto tensor_type = tensor->type().value();
+  if (std::fabs(pad_val) <= std::numeric_limits<float>::epsilon()) {  // if pad with zero, don't care what type it is
+    RETURN_IF_NOT_OK(tensor->Zero());
+  } else if (tensor_type == DataType::DE_INT8) {
+    RETURN_IF_NOT_OK(tensor->Fill<int8_t>(static_cast<int8_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_BOOL) {
+    RETURN_IF_NOT_OK(tensor->Fill<bool>(static_cast<bool>(pad_val)));
+  } else if (tensor_type == DataType::DE_UINT8) {
+    RETURN_IF_NOT_OK(tensor->Fill<uint8_t>(static_cast<uint8_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_INT16) {
+    RETURN_IF_NOT_OK(tensor->Fill<int16_t>(static_cast<int16_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_FLOAT16) {
+    RETURN_IF_NOT_OK(tensor->Fill<float16>(static_cast<float16>(pad_val)));
+  } else if (tensor_type == DataType::DE_UINT16) {
+    RETURN_IF_NOT_OK(tensor->Fill<uint16_t>(static_cast<uint16_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_INT32) {
+    RETURN_IF_NOT_OK(tensor->Fill<int32_t>(static_cast<int32_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_UINT32) {
+    RETURN_IF_NOT_OK(tensor->Fill<uint32_t>(static_cast<uint32_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_INT64) {
+    RETURN_IF_NOT_OK(tensor->Fill<int64_t>(static_cast<int64_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_UINT64) {
+    RETURN_IF_NOT_OK(tensor->Fill<uint64_t>(static_cast<uint64_t>(pad_val)));
+  } else if (tensor_type == DataType::DE_FLOAT32) {
+    RETURN_IF_NOT_OK(tensor->Fill<float>(static_cast<float>(pad_val)));
+  } else if (tensor_type == DataType::DE_FLOAT64) {
+    RETURN_IF_NOT_OK(tensor->Fill<double>(static_cast<double>(pad_val)));
+  } else {
+    RETURN_STATUS_UNEXPECTED(
+      "PadEnd: Incorrect/Unknown datatype, supported datatype is: [bool, int8, uint8, int16, uint16, int32, uint32, "
+      "int64, uint64, float16, float32, float64].");
+  }
+  return Status::OK();
+}
+
+Status PadEndNumericInto(const std::shared_ptr<Tensor> &src, const std::shared_ptr<Tensor> &batch, dsize_t index) {
+  CHECK_FAIL_RETURN_UNEXPECTED(src != nullptr && batch != nullptr, "PadEnd: input or output can't be nullptr");
+  CHECK_FAIL_RETURN_UNEXPECTED(src->type() == batch->type(),
+                               "PadEnd: inconsistent data type, batch type is: " + batch->type().ToString() +
+                                 ", and type of dataset item is: " + src->type().ToString() + ".");
+  uchar *slot = nullptr;
+  TensorShape slot_shape = TensorShape::CreateUnknownRankShape();
+  RETURN_IF_NOT_OK(batch->StartAddrOfIndex({index}, &slot, &slot_shape));
+  CHECK_FAIL_RETURN_UNEXPECTED(src->Rank() == slot_shape.Rank(),
+                               "PadEnd: invalid pad shape, as rank of input is: " + std::to_string(src->Rank()) +
+                                 ", and rank of pad value: " + std::to_string(slot_shape.Rank()));
+  const uchar *src_addr = src->GetBuffer();
+  if (src->shape() == slot_shape) {  // nothing to pad, copy the whole tensor at once
+    size_t len = static_cast<size_t>(src->SizeInBytes());
+    if (len > 0) {
+      CHECK_FAIL_RETURN_UNEXPECTED(memcpy_s(slot, len, src_addr, len) == 0, "PadEnd: memcpy error");
+    }
+    return Status::OK();
+  }
+  // copy the overlapping part of the last dimension row by row, walking the other dimensions like an odometer
+  size_t rank = src->Rank();
+  std::vector<dsize_t> extent(rank);
+  for (size_t dim = 0; dim < rank; dim++) {
+    extent[dim] = std::min(src->shape()[dim], slot_shape[dim]);
+    if (extent[dim] == 0) {
+      return Status::OK();
+    }
+  }
+  std::vector<dsize_t> src_strides = src->shape().Strides();
+  std::vector<dsize_t> dst_strides = slot_shape.Strides();
+  dsize_t type_size = src->type().SizeInBytes();
+  size_t len = static_cast<size_t>(extent[rank - 1] * type_size);
+  std::vector<dsize_t> ind(rank, 0);
+  while (true) {
+    dsize_t src_flat_ind = 0, dst_flat_ind = 0;
+    for (size_t dim = 0; dim + 1 < rank; dim++) {
+      src_flat_ind += ind[dim] * src_strides[dim];
+      dst_flat_ind += ind[dim] * dst_strides[dim];
+    }
+    CHECK_FAIL_RETURN_UNEXPECTED(
+      memcpy_s(slot + dst_flat_ind * type_size, len, src_addr + src_flat_ind * type_size, len) == 0,
+      "PadEnd: memcpy error");
+    size_t dim = rank - 1;
+    while (dim > 0 && ++ind[dim - 1] == extent[dim - 1]) {
+      ind[dim - 1] = 0;
+      dim--;
+    }
+    if (dim == 0) {
+      break;
+    }
+  }
+  return Status::OK();
+}
+
 Status PadEndNumericHelper(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> dst,
                            std::vector<dsize_t> cur_ind, size_t cur_dim) {
   if (cur_dim == src->Rank() - 1) {  // if this is the last dimension, copy the data
@@ -90,6 +90,21 @@ Status PadEnd(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> *dst,
 Status PadEndNumeric(const std::shared_ptr<Tensor> &src, std::shared_ptr<Tensor> *dst,
                      const std::vector<dsize_t> &pad_shape, float pad_val);
 
+// Fill a numeric tensor with a pad value, the value is cast to the type of the tensor.
+// @param std::shared_ptr<Tensor> tensor - tensor to fill
+// @param float pad_val - value to fill with
+// @return Status The status code returned
+Status FillPadValue(const std::shared_ptr<Tensor> &tensor, float pad_val);
+
+// Copy a numeric tensor into the slot `index` of the first dimension of a preallocated batch tensor, the slot
+// needs to have the same rank as the input. Dimensions longer than the slot are cut, shorter ones leave the
+// trailing elements of the slot untouched, i.e. the caller is expected to have filled the batch with the pad value.
+// @param std::shared_ptr<Tensor> src - tensor to copy from
+// @param std::shared_ptr<Tensor> batch - tensor to copy to
+// @param dsize_t index - index of the slot in the batch
+// @return Status The status code returned
+Status PadEndNumericInto(const std::shared_ptr<Tensor> &src, const std::shared_ptr<Tensor> &batch, dsize_t index);
+
 // recursive helper function for padding numric tensors. This function could be very expensive if called on a
 // multi-dimensional tensor it is only meant to be called by PadEndNumeric.
 // @tparam T - type of tensor and fill value
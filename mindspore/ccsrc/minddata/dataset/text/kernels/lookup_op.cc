@@ -20,17 +20,22 @@ namespace mindspore {
 namespace dataset {
 
 LookupOp::LookupOp(std::shared_ptr<Vocab> vocab, WordIdType default_id, const DataType &data_type)
-    : vocab_(vocab), default_id_(default_id), type_(data_type) {}
+    : vocab_(vocab), default_id_(default_id), type_(data_type) {
+  if (vocab_ != nullptr) {
+    vocab_trie_ = std::make_unique<VocabTrie>(vocab_->GetVocab());
+  }
+}
 
 Status LookupOp::Compute(const std::shared_ptr<Tensor> &input, std::shared_ptr<Tensor> *output) {
   IO_CHECK(input, output);
   RETURN_UNEXPECTED_IF_NULL(vocab_);
+  RETURN_UNEXPECTED_IF_NULL(vocab_trie_);
   CHECK_FAIL_RETURN_UNEXPECTED(input->type() == DataType::DE_STRING, "Lookup: input is not string datatype.");
 
   std::vector<WordIdType> word_ids;
   word_ids.reserve(input->Size());
   for (auto itr = input->begin<std::string_view>(); itr != input->end<std::string_view>(); ++itr) {
-    WordIdType word_id = vocab_->TokensToIds(std::string(*itr));
+    WordIdType word_id = vocab_trie_->Find(*itr);
     word_ids.emplace_back(word_id == Vocab::kNoTokenExists ? default_id_ : word_id);
     CHECK_FAIL_RETURN_UNEXPECTED(word_ids.back() != Vocab::kNoTokenExists,
                                  "Lookup: invalid data, token: \"" + std::string(*itr) +
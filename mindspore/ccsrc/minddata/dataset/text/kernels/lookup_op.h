@@ -25,6 +25,7 @@
 #include "minddata/dataset/core/tensor.h"
 #include "minddata/dataset/include/dataset/text.h"
 #include "minddata/dataset/kernels/tensor_op.h"
+#include "minddata/dataset/text/vocab_trie.h"
 #include "minddata/dataset/util/status.h"
 
 namespace mindspore {
@@ -58,6 +59,7 @@ class LookupOp : public TensorOp {
 
  private:
   std::shared_ptr<Vocab> vocab_;
+  std::unique_ptr<VocabTrie> vocab_trie_;  // allocation free lookup of string_view tokens
   WordIdType default_id_;
   DataType type_;  // type of tensor after lookup
 };
@@ -33,23 +33,32 @@ WordpieceTokenizerOp::WordpieceTokenizerOp(const std::shared_ptr<Vocab> &vocab,
       vocab_(vocab),
       suffix_indicator_(suffix_indicator),
       max_bytes_per_token_(max_bytes_per_token),
-      unknown_token_(unknown_token) {}
+      unknown_token_(unknown_token),
+      suffix_state_(-1) {
+  if (vocab_ != nullptr) {
+    vocab_trie_ = std::make_unique<VocabTrie>(vocab_->GetVocab());
+    int32_t state = VocabTrie::kRootState;
+    if (vocab_trie_->Traverse(suffix_indicator_, &state)) {
+      suffix_state_ = state;
+    }
+  }
+}
 
-Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const RuneStrArray &runes, const int start,
-                                        bool *out_found, int *out_end) const {
+Status WordpieceTokenizerOp::LookupWord(const std::string &input_token, const int start, bool *out_found,
+                                        int *out_end) const {
   CHECK_FAIL_RETURN_UNEXPECTED(start >= 0 && start < input_token.size(), "WordpieceTokenizer: LookupWord Out of range");
+  RETURN_UNEXPECTED_IF_NULL(vocab_trie_);
   *out_found = false;
-  for (int i = runes.size() - 1; i >= 0; i--) {
-    *out_end = runes[i].offset + runes[i].len;
-    int len = *out_end - start;
-    std::string word = input_token.substr(start, len);
-    if (start > 0) {
-      word = suffix_indicator_ + word;
-    }
-    if (vocab_->TokensToIds(word) != Vocab::kNoTokenExists) {
-      *out_found = true;
-      break;
-    }
+  // subwords not at the beginning of the token are looked up with the suffix indicator prepended
+  int32_t state = start > 0 ? suffix_state_ : VocabTrie::kRootState;
+  if (state < 0) {
+    return Status::OK();
+  }
+  size_t match_len = 0;
+  std::string_view remain(input_token.data() + start, input_token.size() - start);
+  if (vocab_trie_->LongestPrefix(state, remain, &match_len) != Vocab::kNoTokenExists && match_len > 0) {
+    *out_found = true;
+    *out_end = start + static_cast<int>(match_len);
   }
   return Status::OK();
 }
@@ -102,7 +111,7 @@ Status WordpieceTokenizerOp::GetTokens(const std::string &input_token, const uin
   int end = 0;
   for (int start = 0; start < static_cast<int>(input_token.size());) {
     bool found = false;
-    RETURN_IF_NOT_OK(LookupWord(input_token, runes, start, &found, &end));
+    RETURN_IF_NOT_OK(LookupWord(input_token, start, &found, &end));
     if (found) {
       RETURN_IF_NOT_OK(AddSubword(input_token, start, end, out_tokens));
       offsets_start->push_back(static_cast<uint32_t>(basic_start + start));
@@ -0,0 +1,171 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/text/vocab_trie.h"
+
+#include <algorithm>
+#include <queue>
+#include <utility>
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int32_t kAlphabetSize = 256;
+// stop scanning from the beginning of the array once it is densely packed
+constexpr double kDenseRatio = 0.95;
+
+struct BuildRange {
+  int32_t state;
+  size_t begin;
+  size_t end;
+  size_t depth;
+};
+
+// bytes with the bit pattern 10xxxxxx continue a multi-byte UTF-8 character
+inline bool IsCharBoundary(std::string_view key, size_t pos) {
+  return pos >= key.size() || (static_cast<uint8_t>(key[pos]) & 0xC0) != 0x80;
+}
+}  // namespace
+
+VocabTrie::VocabTrie(const std::unordered_map<WordType, WordIdType> &word2id) {
+  std::vector<std::pair<std::string_view, WordIdType>> words;
+  words.reserve(word2id.size());
+  for (const auto &[word, id] : word2id) {
+    (void)words.emplace_back(word, id);
+  }
+  std::sort(words.begin(), words.end());
+
+  units_.resize(kAlphabetSize + 1);
+  used_.resize(units_.size(), false);
+  used_[kRootState] = true;
+
+  std::queue<BuildRange> pending;
+  pending.push({kRootState, 0, words.size(), 0});
+  std::vector<uint8_t> labels;
+  std::vector<size_t> bounds;
+  while (!pending.empty()) {
+    BuildRange range = pending.front();
+    pending.pop();
+    size_t begin = range.begin;
+    // keys are sorted, so the word ending exactly at this node always comes first
+    if (begin < range.end && words[begin].first.size() == range.depth) {
+      units_[range.state].value = words[begin].second;
+      ++begin;
+    }
+    if (begin == range.end) {
+      continue;
+    }
+    labels.clear();
+    bounds.clear();
+    for (size_t i = begin; i < range.end; ++i) {
+      auto label = static_cast<uint8_t>(words[i].first[range.depth]);
+      if (labels.empty() || labels.back() != label) {
+        labels.push_back(label);
+        bounds.push_back(i);
+      }
+    }
+    bounds.push_back(range.end);
+
+    int32_t base = FindBase(labels);
+    units_[range.state].base = base;
+    for (size_t i = 0; i < labels.size(); ++i) {
+      int32_t child = base + labels[i] + 1;
+      units_[child].check = range.state;
+      pending.push({child, bounds[i], bounds[i + 1], range.depth + 1});
+    }
+  }
+
+  // drop the unused tail, lookups are bound checked against the array size
+  auto last = std::find(used_.rbegin(), used_.rend(), true);
+  units_.resize(static_cast<size_t>(std::distance(last, used_.rend())));
+  units_.shrink_to_fit();
+  std::vector<bool>().swap(used_);
+}
+
+int32_t VocabTrie::FindBase(const std::vector<uint8_t> &labels) {
+  size_t first = labels.front() + 1;
+  size_t pos = std::max(next_check_pos_, first);
+  size_t num_occupied = 0;
+  bool first_empty = true;
+  while (true) {
+    if (pos >= used_.size()) {
+      units_.resize(pos + kAlphabetSize + 1);
+      used_.resize(units_.size(), false);
+    }
+    if (used_[pos]) {
+      ++num_occupied;
+      ++pos;
+      continue;
+    }
+    if (first_empty) {
+      first_empty = false;
+      if (static_cast<double>(num_occupied) / static_cast<double>(pos - next_check_pos_ + 1) >= kDenseRatio) {
+        next_check_pos_ = pos;
+      }
+    }
+    size_t base = pos - first;
+    size_t last = base + labels.back() + 1;
+    if (last >= used_.size()) {
+      units_.resize(last + kAlphabetSize + 1);
+      used_.resize(units_.size(), false);
+    }
+    bool fits =
+      std::all_of(labels.begin(), labels.end(), [this, base](uint8_t label) { return !used_[base + label + 1]; });
+    if (fits) {
+      for (auto label : labels) {
+        used_[base + label + 1] = true;
+      }
+      return static_cast<int32_t>(base);
+    }
+    ++pos;
+  }
+}
+
+WordIdType VocabTrie::Find(std::string_view word) const {
+  int32_t state = kRootState;
+  if (!Traverse(word, &state)) {
+    return Vocab::kNoTokenExists;
+  }
+  return units_[state].value;
+}
+
+bool VocabTrie::Traverse(std::string_view key, int32_t *state) const {
+  int32_t current = *state;
+  for (char c : key) {
+    if (!Next(static_cast<uint8_t>(c), &current)) {
+      return false;
+    }
+  }
+  *state = current;
+  return true;
+}
+
+WordIdType VocabTrie::LongestPrefix(int32_t state, std::string_view key, size_t *match_len) const {
+  *match_len = 0;
+  WordIdType id = Vocab::kNoTokenExists;
+  for (size_t i = 0; i < key.size();) {
+    if (!Next(static_cast<uint8_t>(key[i]), &state)) {
+      break;
+    }
+    ++i;
+    if (units_[state].value != Vocab::kNoTokenExists && IsCharBoundary(key, i)) {
+      id = units_[state].value;
+      *match_len = i;
+    }
+  }
+  return id;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,98 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "minddata/dataset/include/dataset/text.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief A read-only double-array trie over the UTF-8 bytes of the words in a Vocab.
+/// \note Lookups walk the key once byte by byte and never allocate, which makes it suitable for the
+///     prefix-heavy matching done by the WordPiece tokenizer and for plain token-to-id lookup.
+class VocabTrie {
+ public:
+  /// \brief State of the root node, i.e. the empty prefix.
+  static constexpr int32_t kRootState = 0;
+
+  /// Constructor.
+  /// \param[in] word2id Map between words and their ids, ids are expected to be non negative.
+  explicit VocabTrie(const std::unordered_map<WordType, WordIdType> &word2id);
+
+  /// Destructor.
+  ~VocabTrie() = default;
+
+  /// \brief Lookup the id of a word.
+  /// \param[in] word Word to be looked up.
+  /// \return ID of the word, or Vocab::kNoTokenExists if the word is not in the trie.
+  WordIdType Find(std::string_view word) const;
+
+  /// \brief Walk the trie from a given state along all bytes of a key.
+  /// \param[in] key Bytes to walk through.
+  /// \param[in, out] state State to start from, updated to the state reached after consuming the key.
+  /// \return Whether all the bytes of the key could be consumed.
+  bool Traverse(std::string_view key, int32_t *state) const;
+
+  /// \brief Find the longest word which is the concatenation of the prefix represented by the given state and a
+  ///     prefix of the key, only matches ending on an UTF-8 character boundary of the key are considered.
+  /// \param[in] state State to start from, e.g. kRootState or the state reached by a suffix indicator.
+  /// \param[in] key Bytes to match.
+  /// \param[out] match_len Length in bytes of the matched prefix of the key, 0 if nothing matched.
+  /// \return ID of the longest matched word, or Vocab::kNoTokenExists if nothing matched.
+  WordIdType LongestPrefix(int32_t state, std::string_view key, size_t *match_len) const;
+
+  /// \brief Number of allocated states, for statistics.
+  size_t NumStates() const { return units_.size(); }
+
+ private:
+  struct Unit {
+    int32_t base = 0;
+    int32_t check = -1;
+    WordIdType value = -1;
+  };
+
+  /// \brief Move to the child of a state through one byte.
+  /// \param[in] label Byte of the transition.
+  /// \param[in, out] state Current state, updated to the child state if it exists.
+  /// \return Whether the transition exists.
+  bool Next(uint8_t label, int32_t *state) const {
+    int64_t target = static_cast<int64_t>(units_[*state].base) + label + 1;
+    if (target >= static_cast<int64_t>(units_.size()) || units_[target].check != *state) {
+      return false;
+    }
+    *state = static_cast<int32_t>(target);
+    return true;
+  }
+
+  /// \brief Reserve free slots for all children of a state and return the chosen base.
+  /// \param[in] labels Sorted bytes of the outgoing transitions.
+  /// \return The base value such that base + label + 1 is free for every label.
+  int32_t FindBase(const std::vector<uint8_t> &labels);
+
+  std::vector<Unit> units_;
+  std::vector<bool> used_;
+  size_t next_check_pos_ = 1;
+};
+}  // namespace dataset
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_TEXT_VOCAB_TRIE_H_
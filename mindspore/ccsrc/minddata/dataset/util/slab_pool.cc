@@ -0,0 +1,209 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "minddata/dataset/util/slab_pool.h"
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+#include <algorithm>
+#include <string>
+#include <utility>
+#include "./securec.h"
+
+namespace mindspore {
+namespace dataset {
+namespace {
+constexpr int kLogMinBlockSize = 12;
+constexpr uint64_t kMB = 1048576;
+}  // namespace
+
+SlabPool::SlabPool(std::shared_ptr<MemoryPool> upstream, size_t capacity)
+    : upstream_(std::move(upstream)),
+      capacity_(capacity),
+      num_allocations_(0),
+      num_reused_(0),
+      bytes_in_use_(0),
+      peak_bytes_in_use_(0),
+      bytes_cached_(0) {}
+
+SlabPool::~SlabPool() { Trim(); }
+
+size_t SlabPool::RoundUp(size_t n, int *size_class) {
+  if (n < kMinBlockSize || n > kMaxBlockSize) {
+    *size_class = -1;
+    return n;
+  }
+  if (n == kMinBlockSize) {
+    *size_class = 0;
+    return n;
+  }
+  // 2^k < n <= 2^(k+1), the interval is split into (1 << kLogClassesPerDoubling) classes of equal step
+  int k = 0;
+  for (size_t v = n - 1; v > 1; v >>= 1) {
+    ++k;
+  }
+  size_t lower = static_cast<size_t>(1) << k;
+  size_t step = lower >> kLogClassesPerDoubling;
+  size_t sub = (n - lower + step - 1) / step;
+  *size_class = ((k - kLogMinBlockSize) << kLogClassesPerDoubling) + static_cast<int>(sub);
+  return lower + sub * step;
+}
+
+int SlabPool::CurrentNode() {
+#if defined(__linux__) && defined(SYS_getcpu)
+  unsigned int cpu = 0;
+  unsigned int node = 0;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0) {
+    return static_cast<int>(node % kMaxNumaNodes);
+  }
+#endif
+  return 0;
+}
+
+Status SlabPool::Allocate(size_t n, void **p) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  int size_class = -1;
+  size_t block_size = RoundUp(n, &size_class);
+  int node = CurrentNode();
+  BlockHeader *header = nullptr;
+  if (size_class >= 0) {
+    NodeCache &cache = nodes_[node];
+    std::unique_lock<std::mutex> lock(cache.mux);
+    auto &free_list = cache.free_lists[size_class];
+    if (!free_list.empty()) {
+      header = free_list.back();
+      free_list.pop_back();
+      lock.unlock();
+      bytes_cached_ -= block_size;
+      ++num_reused_;
+    }
+  }
+  if (header == nullptr) {
+    void *ptr = nullptr;
+    RETURN_IF_NOT_OK(upstream_->Allocate(sizeof(BlockHeader) + block_size, &ptr));
+    header = reinterpret_cast<BlockHeader *>(ptr);
+    header->block_size = block_size;
+    header->size_class = size_class;
+    header->node = node;
+  }
+  ++num_allocations_;
+  uint64_t in_use = bytes_in_use_ += block_size;
+  uint64_t peak = peak_bytes_in_use_.load(std::memory_order_relaxed);
+  while (in_use > peak && !peak_bytes_in_use_.compare_exchange_weak(peak, in_use)) {
+    // a failed exchange reloads peak, retry until it is no longer lower than in_use
+  }
+  *p = reinterpret_cast<char *>(header) + sizeof(BlockHeader);
+  return Status::OK();
+}
+
+Status SlabPool::Reallocate(void **p, size_t old_sz, size_t new_sz) {
+  RETURN_UNEXPECTED_IF_NULL(p);
+  if (*p != nullptr) {
+    auto *header = reinterpret_cast<BlockHeader *>(reinterpret_cast<char *>(*p) - sizeof(BlockHeader));
+    // Do nothing if the block is big enough already.
+    if (header->block_size >= new_sz) {
+      return Status::OK();
+    }
+  }
+  void *q = nullptr;
+  RETURN_IF_NOT_OK(Allocate(new_sz, &q));
+  if (*p != nullptr) {
+    errno_t err = memcpy_s(q, new_sz, *p, std::min(old_sz, new_sz));
+    if (err != EOK) {
+      Deallocate(q);
+      RETURN_STATUS_UNEXPECTED("memcpy_s failed with error code " + std::to_string(err));
+    }
+    Deallocate(*p);
+  }
+  *p = q;
+  return Status::OK();
+}
+
+void SlabPool::Deallocate(void *p) {
+  if (p == nullptr) {
+    return;
+  }
+  auto *header = reinterpret_cast<BlockHeader *>(reinterpret_cast<char *>(p) - sizeof(BlockHeader));
+  uint64_t block_size = header->block_size;
+  bytes_in_use_ -= block_size;
+  if (header->size_class >= 0) {
+    // Reserve room in the cache first so that concurrent frees can't overshoot the capacity.
+    uint64_t cached = bytes_cached_ += block_size;
+    if (cached <= capacity_.load(std::memory_order_relaxed)) {
+      NodeCache &cache = nodes_[header->node];
+      std::unique_lock<std::mutex> lock(cache.mux);
+      cache.free_lists[header->size_class].push_back(header);
+      return;
+    }
+    bytes_cached_ -= block_size;
+  }
+  upstream_->Deallocate(header);
+}
+
+void SlabPool::SetCapacity(size_t capacity) {
+  size_t old_capacity = capacity_.exchange(capacity);
+  if (capacity < old_capacity && bytes_cached_.load() > capacity) {
+    ReleaseUntil(capacity);
+  }
+}
+
+void SlabPool::Trim() { ReleaseUntil(0); }
+
+void SlabPool::ReleaseUntil(uint64_t target) {
+  // Give back the biggest blocks first, they are the most expensive to keep.
+  for (int size_class = kNumSizeClasses - 1; size_class >= 0; --size_class) {
+    for (auto &cache : nodes_) {
+      std::vector<BlockHeader *> released;
+      {
+        std::unique_lock<std::mutex> lock(cache.mux);
+        auto &free_list = cache.free_lists[size_class];
+        while (!free_list.empty() && bytes_cached_.load() > target) {
+          BlockHeader *header = free_list.back();
+          free_list.pop_back();
+          bytes_cached_ -= header->block_size;
+          released.push_back(header);
+        }
+      }
+      for (auto header : released) {
+        upstream_->Deallocate(header);
+      }
+      if (bytes_cached_.load() <= target) {
+        return;
+      }
+    }
+  }
+}
+
+SlabPoolStats SlabPool::GetStats() const {
+  SlabPoolStats stats;
+  stats.num_allocations = num_allocations_.load();
+  stats.num_reused = num_reused_.load();
+  stats.bytes_in_use = bytes_in_use_.load();
+  stats.peak_bytes_in_use = peak_bytes_in_use_.load();
+  stats.bytes_cached = bytes_cached_.load();
+  return stats;
+}
+
+std::ostream &operator<<(std::ostream &os, const SlabPool &s) {
+  SlabPoolStats stats = s.GetStats();
+  os << "Capacity (MB): " << s.capacity() / kMB << "\n"
+     << "Allocations: " << stats.num_allocations << ", reused: " << stats.num_reused << "\n"
+     << "In use (MB): " << stats.bytes_in_use / kMB << ", peak (MB): " << stats.peak_bytes_in_use / kMB << "\n"
+     << "Cached (MB): " << stats.bytes_cached / kMB << "\n";
+  return os;
+}
+}  // namespace dataset
+}  // namespace mindspore
@@ -0,0 +1,134 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SLAB_POOL_H_
+#define MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SLAB_POOL_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+#include "minddata/dataset/util/memory_pool.h"
+
+namespace mindspore {
+namespace dataset {
+/// \brief Counters of a SlabPool, all sizes are in bytes.
+struct SlabPoolStats {
+  uint64_t num_allocations = 0;    // number of Allocate calls
+  uint64_t num_reused = 0;         // number of Allocate calls served from a cached block
+  uint64_t bytes_in_use = 0;       // bytes handed out to the callers and not yet returned
+  uint64_t peak_bytes_in_use = 0;  // high watermark of bytes_in_use
+  uint64_t bytes_cached = 0;       // bytes kept in the free lists for recycling
+};
+
+/// This is a recycling memory pool for tensor data built on top of another MemoryPool, e.g. SystemPool,
+/// Arena or CircularPool.
+///
+/// Requests are rounded up to a size class, four classes per power of two between kMinBlockSize and
+/// kMaxBlockSize, so that buffers of recurring shapes (decoded images, batches) land in the same class.
+/// A freed block is not returned to the upstream pool but parked in the free list of its size class, and
+/// the next request of that class takes it back without touching the upstream pool. This keeps the page
+/// faults and the fragmentation of the system allocator out of the steady state of a pipeline.
+///
+/// Free lists are kept per NUMA node. A block remembers the node of the thread which first allocated it,
+/// i.e. the node its pages were first touched on, and is only recycled to threads running on that node.
+///
+/// The total size of the cached blocks is bounded by the capacity; blocks beyond it, and requests outside
+/// of the size class range, go straight back to the upstream pool.
+class SlabPool : public MemoryPool {
+ public:
+  static constexpr size_t kMinBlockSize = 4096;
+  static constexpr size_t kMaxBlockSize = 1ull << 30;
+  static constexpr int kMaxNumaNodes = 8;
+
+  /// Constructor
+  /// \param upstream The pool the blocks are obtained from
+  /// \param capacity Maximum number of bytes kept in the free lists
+  SlabPool(std::shared_ptr<MemoryPool> upstream, size_t capacity);
+
+  SlabPool(const SlabPool &) = delete;
+  SlabPool &operator=(const SlabPool &) = delete;
+
+  ~SlabPool() override;
+
+  Status Allocate(size_t n, void **p) override;
+
+  Status Reallocate(void **p, size_t old_sz, size_t new_sz) override;
+
+  void Deallocate(void *p) override;
+
+  uint64_t get_max_size() const override { return upstream_->get_max_size(); }
+
+  int PercentFree() const override { return upstream_->PercentFree(); }
+
+  /// \brief Change the maximum number of bytes kept in the free lists, cached blocks beyond it are released.
+  /// \param capacity New capacity in bytes
+  void SetCapacity(size_t capacity);
+
+  /// \return The maximum number of bytes kept in the free lists
+  size_t capacity() const { return capacity_.load(std::memory_order_relaxed); }
+
+  /// \brief Release all the cached blocks to the upstream pool.
+  void Trim();
+
+  /// \return A snapshot of the counters
+  SlabPoolStats GetStats() const;
+
+  /// \brief Round a request up to its size class.
+  /// \param n Size requested
+  /// \param size_class Index of the size class, -1 if n is outside of the size class range
+  /// \return Size of the block serving the request
+  static size_t RoundUp(size_t n, int *size_class);
+
+  friend std::ostream &operator<<(std::ostream &os, const SlabPool &s);
+
+ private:
+  // Number of size classes per power of two
+  static constexpr int kLogClassesPerDoubling = 2;
+  static constexpr int kNumSizeClasses = (30 - 12) * (1 << kLogClassesPerDoubling) + 1;
+
+  // Every block starts with this header, the user address follows it
+  struct alignas(64) BlockHeader {
+    uint64_t block_size;
+    int32_t size_class;
+    int32_t node;
+  };
+
+  struct NodeCache {
+    std::mutex mux;
+    std::array<std::vector<BlockHeader *>, kNumSizeClasses> free_lists;
+  };
+
+  static int CurrentNode();
+
+  // Return cached blocks of all the nodes to the upstream pool until at most target bytes are cached
+  void ReleaseUntil(uint64_t target);
+
+  std::shared_ptr<MemoryPool> upstream_;
+  std::atomic<size_t> capacity_;
+  std::array<NodeCache, kMaxNumaNodes> nodes_;
+  std::atomic<uint64_t> num_allocations_;
+  std::atomic<uint64_t> num_reused_;
+  std::atomic<uint64_t> bytes_in_use_;
+  std::atomic<uint64_t> peak_bytes_in_use_;
+  std::atomic<uint64_t> bytes_cached_;
+};
+}  // namespace dataset
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_MINDDATA_DATASET_UTIL_SLAB_POOL_H_
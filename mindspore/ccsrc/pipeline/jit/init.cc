@@ -364,10 +364,18 @@ PYBIND11_MODULE(_c_expression, m) {
          "Set the epsilon which is used in the approximation of DP algorithm.")
     .def("get_dp_algo_approxi_epsilon", &CostModelContext::dp_algo_approxi_epsilon,
          "Get the epsilon which is used in the approximation of DP algorithm.")
+    .def("set_dp_algo_time_budget", &CostModelContext::set_dp_algo_time_budget,
+         "Set the time budget in seconds of the DP algorithm.")
+    .def("get_dp_algo_time_budget", &CostModelContext::dp_algo_time_budget,
+         "Get the time budget in seconds of the DP algorithm.")
     .def("set_dp_algo_single_loop", &CostModelContext::set_dp_algo_single_loop,
          "Set the flag of generating a single suite of OperatorInfos in for-loop.")
     .def("get_dp_algo_single_loop", &CostModelContext::dp_algo_single_loop,
          "Get the flag of whether or not generating a single suite of OperatorInfos in for-loop.")
+    .def("set_dp_algo_parallel_search", &CostModelContext::set_dp_algo_parallel_search,
+         "Set the flag of running the DP algorithm in parallel and reusing the costs of the identical operators.")
+    .def("get_dp_algo_parallel_search", &CostModelContext::dp_algo_parallel_search,
+         "Get the flag of running the DP algorithm in parallel and reusing the costs of the identical operators.")
     .def("reset_cost_model", &CostModelContext::ResetCostModel, "Reset the CostModelContext.")
     .def("reset_algo_parameters", &CostModelContext::ResetAlgoParameters, "Reset the AlgoParameters.");
 
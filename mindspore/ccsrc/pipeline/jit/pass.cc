@@ -47,6 +47,7 @@
 #include "frontend/optimizer/comm_op_attrs.h"
 #include "frontend/optimizer/environ_conversion.h"
 #include "frontend/optimizer/comm_op_reuse_tag.h"
+#include "frontend/optimizer/layer_dedup.h"
 #include "utils/log_adapter.h"
 #include "pipeline/jit/pipeline_split.h"
 #include "pipeline/pynative/pynative_execute.h"
@@ -715,6 +716,19 @@ bool AddCommOpReusePass(const ResourcePtr &resource) {
   return true;
 }
 
+bool LayerDedupPass(const ResourcePtr &resource) {
+  MS_EXCEPTION_IF_NULL(resource);
+  // Deduplicate the repeated layers before they are inlined, enabled by MS_DEV_LAYER_DEDUP=1, which is read for every
+  // compile. The parallel strategy search and the redistribution need the layers to be inlined, so it does not work in
+  // the parallel mode.
+  const bool enable_layer_dedup = (common::GetEnv("MS_DEV_LAYER_DEDUP") == "1");
+  if (!enable_layer_dedup || parallel_mode()) {
+    return true;
+  }
+  (void)opt::LayerDedup(resource->func_graph(), resource->manager());
+  return true;
+}
+
 bool AddCacheEmbeddingPass(const ResourcePtr &resource) {
   MS_EXCEPTION_IF_NULL(resource);
 #ifdef WITH_BACKEND
@@ -923,6 +937,7 @@ bool AddEmbeddingCachePass(const ResourcePtr &resource) {
 
 std::vector<PassItem> kVmPasses = {
   {"simplify_data_structures", SimplifyDataStructuresPass},
+  {"layer_dedup", LayerDedupPass},
   {"opt_a", OptPassAGroup},
   {"clean_after_opta", CleanAfterOptAPass},
   {"opt_b", OptPassBGroup},
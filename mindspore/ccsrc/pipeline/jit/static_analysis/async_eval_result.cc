@@ -80,6 +80,7 @@ void AnalysisSchedule::HandleException(const std::exception &ex) {
   // Since it may contains invalid results when exception raised.
   auto &prim_eval_cache = AnalysisResultCacheMgr::GetInstance().prim_eval_cache();
   if (prim_eval_cache != nullptr) {
+    prim_eval_cache->DropPending();
     prim_eval_cache->Clear();
   }
 }
@@ -230,6 +231,7 @@ std::string AsyncAbstractFuncAtom::ToString() const {
 }
 
 void AnalysisResultCacheMgr::Clear() {
+  prim_eval_cache_->Flush();
   prim_eval_cache_->Clear();
   std::lock_guard<std::mutex> lock(lock_);
   cache_.clear();
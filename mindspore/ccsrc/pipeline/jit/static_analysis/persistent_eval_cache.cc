@@ -0,0 +1,546 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/jit/static_analysis/persistent_eval_cache.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#if defined(_WIN32)
+#include <process.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+#include "securec/include/securec.h"
+#include "ir/dtype.h"
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+#include "utils/ms_context.h"
+#include "utils/ms_utils.h"
+
+#ifndef MSVERSION
+#define MSVERSION ""
+#endif
+
+namespace mindspore {
+namespace abstract {
+namespace {
+constexpr char kCacheFileName[] = "prim_eval_cache.bin";
+constexpr char kCacheMagic[] = "MSPEVC01";
+constexpr size_t kCacheMagicSize = 8;
+constexpr uint64_t kFnvOffset = 14695981039346656037ULL;
+constexpr uint64_t kFnvPrime = 1099511628211ULL;
+
+struct CacheHeader {
+  char magic[kCacheMagicSize];
+  uint64_t version;
+  uint64_t entry_num;
+};
+
+// The hash must be the same in all the processes, so std::hash is not used.
+uint64_t Fnv1aHash(const char *data, size_t size) {
+  uint64_t hash = kFnvOffset;
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ static_cast<uint8_t>(data[i])) * kFnvPrime;
+  }
+  return hash;
+}
+
+int GetProcessId() {
+#if defined(_WIN32)
+  return _getpid();
+#else
+  return static_cast<int>(getpid());
+#endif
+}
+
+uint64_t CacheVersion() {
+  static const std::string version = std::string(kCacheMagic) + MSVERSION;
+  return Fnv1aHash(version.data(), version.size());
+}
+
+bool EncodeValue(const ValuePtr &value, std::ostringstream *buf) {
+  MS_EXCEPTION_IF_NULL(value);
+  if (value->isa<BoolImm>() || value->isa<IntegerImm>()) {
+    *buf << value->type_name() << ':' << value->ToString();
+  } else if (value->isa<FP32Imm>()) {
+    *buf << "f:" << std::hexfloat << GetValue<float>(value) << std::defaultfloat;
+  } else if (value->isa<FP64Imm>()) {
+    *buf << "d:" << std::hexfloat << GetValue<double>(value) << std::defaultfloat;
+  } else if (value->isa<StringImm>()) {
+    const auto &str = GetValue<std::string>(value);
+    *buf << "s:" << str.size() << ':' << str;
+  } else if (value->isa<None>()) {
+    *buf << 'n';
+  } else if (value->isa<Type>()) {
+    *buf << "t:" << value->ToString();
+  } else if (value->isa<ValueSequence>()) {
+    *buf << (value->isa<ValueTuple>() ? '(' : '[');
+    for (const auto &element : value->cast_ptr<ValueSequence>()->value()) {
+      if (!EncodeValue(element, buf)) {
+        return false;
+      }
+      *buf << ',';
+    }
+    *buf << (value->isa<ValueTuple>() ? ')' : ']');
+  } else {
+    return false;
+  }
+  return true;
+}
+
+bool EncodeShape(const AbstractTensor &tensor, std::ostringstream *buf) {
+  auto shape = tensor.shape();
+  MS_EXCEPTION_IF_NULL(shape);
+  if (tensor.get_min_value() != nullptr || tensor.get_max_value() != nullptr || tensor.get_shape_value() != nullptr) {
+    return false;
+  }
+  for (const auto &dims : {shape->shape(), shape->min_shape(), shape->max_shape()}) {
+    *buf << '[';
+    for (const auto dim : dims) {
+      *buf << dim << ',';
+    }
+    *buf << ']';
+  }
+  return true;
+}
+
+// The key of the args, which are encoded exactly, since the same key must give the same infer result.
+bool EncodeArg(const AbstractBasePtr &abs, std::ostringstream *buf) {
+  MS_EXCEPTION_IF_NULL(abs);
+  if (abs->isa<AbstractTensor>()) {
+    auto tensor = abs->cast_ptr<AbstractTensor>();
+    bool is_ref = abs->isa<AbstractRefTensor>();
+    if ((!is_ref && !abs->IsSameTypeId(AbstractTensor::kTypeId)) || !abs->GetValueTrack()->isa<AnyValue>()) {
+      return false;
+    }
+    MS_EXCEPTION_IF_NULL(tensor->element());
+    *buf << (is_ref ? 'R' : 'T') << tensor->element()->BuildType()->ToString();
+    return EncodeShape(*tensor, buf);
+  }
+  if (abs->isa<AbstractScalar>()) {
+    *buf << 'S' << abs->BuildType()->ToString() << '=';
+    auto value = abs->GetValueTrack();
+    if (value->isa<AnyValue>()) {
+      *buf << '?';
+      return true;
+    }
+    return EncodeValue(value, buf);
+  }
+  if (abs->IsSameTypeId(AbstractTuple::kTypeId) || abs->IsSameTypeId(AbstractList::kTypeId)) {
+    *buf << (abs->isa<AbstractTuple>() ? '(' : '[');
+    for (const auto &element : abs->cast_ptr<AbstractSequence>()->elements()) {
+      if (!EncodeArg(element, buf)) {
+        return false;
+      }
+      *buf << ',';
+    }
+    *buf << (abs->isa<AbstractTuple>() ? ')' : ']');
+    return true;
+  }
+  if (abs->isa<AbstractNone>()) {
+    *buf << 'N';
+    return true;
+  }
+  if (abs->isa<AbstractType>()) {
+    *buf << 'Y' << abs->GetValueTrack()->ToString();
+    return true;
+  }
+  return false;
+}
+
+bool IsPersistentNumberType(TypeId type_id) { return type_id > kNumberTypeBegin && type_id < kNumberTypeEnd; }
+
+void EncodeDims(const ShapeVector &dims, std::ostringstream *buf) {
+  *buf << ' ' << dims.size();
+  for (const auto dim : dims) {
+    *buf << ' ' << dim;
+  }
+}
+
+// The result is encoded as space separated tokens, e.g. "( 2 T 43 2 4 8 0 0 S 30 ?" for a tuple of a float32 tensor
+// of shape [4, 8] and an int64 scalar.
+bool EncodeResult(const AbstractBasePtr &abs, std::ostringstream *buf) {
+  MS_EXCEPTION_IF_NULL(abs);
+  if (abs->IsSameTypeId(AbstractTensor::kTypeId)) {
+    auto tensor = abs->cast_ptr<AbstractTensor>();
+    MS_EXCEPTION_IF_NULL(tensor->element());
+    auto type_id = tensor->element()->BuildType()->type_id();
+    if (!abs->GetValueTrack()->isa<AnyValue>() || !IsPersistentNumberType(type_id) ||
+        tensor->get_min_value() != nullptr || tensor->get_max_value() != nullptr ||
+        tensor->get_shape_value() != nullptr) {
+      return false;
+    }
+    auto shape = tensor->shape();
+    MS_EXCEPTION_IF_NULL(shape);
+    *buf << " T " << static_cast<int>(type_id);
+    EncodeDims(shape->shape(), buf);
+    EncodeDims(shape->min_shape(), buf);
+    EncodeDims(shape->max_shape(), buf);
+    return true;
+  }
+  if (abs->isa<AbstractScalar>()) {
+    auto type_id = abs->BuildType()->type_id();
+    if (!IsPersistentNumberType(type_id)) {
+      return false;
+    }
+    *buf << " S " << static_cast<int>(type_id);
+    auto value = abs->GetValueTrack();
+    if (value->isa<AnyValue>()) {
+      *buf << " ?";
+    } else if (value->isa<BoolImm>()) {
+      *buf << " b " << GetValue<bool>(value);
+    } else if (value->isa<Int64Imm>()) {
+      *buf << " i " << GetValue<int64_t>(value);
+    } else if (value->isa<Int32Imm>()) {
+      *buf << " j " << GetValue<int32_t>(value);
+    } else if (value->isa<FP32Imm>()) {
+      uint32_t bits = 0;
+      auto float_value = GetValue<float>(value);
+      (void)memcpy_s(&bits, sizeof(bits), &float_value, sizeof(float_value));
+      *buf << " f " << bits;
+    } else {
+      return false;
+    }
+    return true;
+  }
+  if (abs->IsSameTypeId(AbstractTuple::kTypeId) || abs->IsSameTypeId(AbstractList::kTypeId)) {
+    const auto &elements = abs->cast_ptr<AbstractSequence>()->elements();
+    *buf << (abs->isa<AbstractTuple>() ? " ( " : " [ ") << elements.size();
+    return std::all_of(elements.begin(), elements.end(),
+                       [buf](const AbstractBasePtr &element) { return EncodeResult(element, buf); });
+  }
+  if (abs->isa<AbstractNone>()) {
+    *buf << " N";
+    return true;
+  }
+  return false;
+}
+
+bool DecodeDims(std::istringstream *buf, ShapeVector *dims) {
+  size_t rank = 0;
+  if (!(*buf >> rank)) {
+    return false;
+  }
+  dims->resize(rank);
+  for (size_t i = 0; i < rank; ++i) {
+    if (!(*buf >> (*dims)[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+AbstractBasePtr DecodeResult(std::istringstream *buf) {
+  std::string tag;
+  if (!(*buf >> tag)) {
+    return nullptr;
+  }
+  if (tag == "T") {
+    int type_id = 0;
+    ShapeVector shape;
+    ShapeVector min_shape;
+    ShapeVector max_shape;
+    if (!(*buf >> type_id) || !DecodeDims(buf, &shape) || !DecodeDims(buf, &min_shape) ||
+        !DecodeDims(buf, &max_shape)) {
+      return nullptr;
+    }
+    return std::make_shared<AbstractTensor>(TypeIdToType(static_cast<TypeId>(type_id)),
+                                            std::make_shared<Shape>(shape, min_shape, max_shape));
+  }
+  if (tag == "S") {
+    int type_id = 0;
+    std::string kind;
+    if (!(*buf >> type_id >> kind)) {
+      return nullptr;
+    }
+    auto type = TypeIdToType(static_cast<TypeId>(type_id));
+    ValuePtr value = nullptr;
+    if (kind == "?") {
+      value = kAnyValue;
+    } else if (kind == "b") {
+      bool bool_value = false;
+      value = (*buf >> bool_value) ? MakeValue(bool_value) : nullptr;
+    } else if (kind == "i") {
+      int64_t int_value = 0;
+      value = (*buf >> int_value) ? MakeValue(int_value) : nullptr;
+    } else if (kind == "j") {
+      int32_t int_value = 0;
+      value = (*buf >> int_value) ? MakeValue(int_value) : nullptr;
+    } else if (kind == "f") {
+      uint32_t bits = 0;
+      float float_value = 0;
+      if (*buf >> bits) {
+        (void)memcpy_s(&float_value, sizeof(float_value), &bits, sizeof(bits));
+        value = MakeValue(float_value);
+      }
+    }
+    return value == nullptr ? nullptr : std::make_shared<AbstractScalar>(value, type);
+  }
+  if (tag == "(" || tag == "[") {
+    size_t size = 0;
+    if (!(*buf >> size)) {
+      return nullptr;
+    }
+    AbstractBasePtrList elements;
+    for (size_t i = 0; i < size; ++i) {
+      auto element = DecodeResult(buf);
+      if (element == nullptr) {
+        return nullptr;
+      }
+      (void)elements.emplace_back(element);
+    }
+    if (tag == "(") {
+      return std::make_shared<AbstractTuple>(elements);
+    }
+    return std::make_shared<AbstractList>(elements);
+  }
+  if (tag == "N") {
+    return std::make_shared<AbstractNone>();
+  }
+  return nullptr;
+}
+}  // namespace
+
+PersistentPrimEvalCache::PersistentPrimEvalCache(const std::string &file_path) : file_path_(file_path) {}
+
+PersistentPrimEvalCache::~PersistentPrimEvalCache() { Unload(); }
+
+std::unique_ptr<PersistentPrimEvalCache> PersistentPrimEvalCache::CreateFromEnv() {
+  const auto &cache_dir = common::GetEnv("MS_DEV_PRIM_EVAL_CACHE_PATH");
+  if (cache_dir.empty()) {
+    return nullptr;
+  }
+#if defined(_WIN32)
+  MS_LOG(WARNING) << "The persistent primitive eval cache is not supported on windows.";
+  return nullptr;
+#else
+  const auto &real_dir = FileUtils::CreateNotExistDirs(cache_dir, true);
+  if (!real_dir.has_value()) {
+    MS_LOG(WARNING) << "Create the primitive eval cache directory " << cache_dir << " failed, the cache is disabled.";
+    return nullptr;
+  }
+  MS_LOG(INFO) << "Enable the persistent primitive eval cache in " << real_dir.value();
+  return std::make_unique<PersistentPrimEvalCache>(real_dir.value() + "/" + kCacheFileName);
+#endif
+}
+
+std::string PersistentPrimEvalCache::BuildKey(const std::string &prim_name,
+                                              const mindspore::HashMap<std::string, ValuePtr> &attrs,
+                                              const AbstractBasePtrList &args) {
+  auto context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(context);
+  std::ostringstream buf;
+  buf << prim_name << '@' << context->get_param<std::string>(MS_CTX_DEVICE_TARGET) << '{';
+  std::vector<std::string> attr_names;
+  (void)std::transform(attrs.begin(), attrs.end(), std::back_inserter(attr_names),
+                       [](const auto &attr) { return attr.first; });
+  std::sort(attr_names.begin(), attr_names.end());
+  for (const auto &name : attr_names) {
+    buf << name << '=';
+    if (!EncodeValue(attrs.at(name), &buf)) {
+      return "";
+    }
+    buf << ';';
+  }
+  buf << "}(";
+  for (const auto &arg : args) {
+    if (!EncodeArg(arg, &buf)) {
+      return "";
+    }
+    buf << ',';
+  }
+  buf << ')';
+  return buf.str();
+}
+
+AbstractBasePtr PersistentPrimEvalCache::Get(const std::string &key) {
+  std::string value;
+  auto iter = pending_.find(key);
+  if (iter != pending_.end()) {
+    value = iter->second;
+  } else if (!Load() || !FindInFile(key, &value)) {
+    return nullptr;
+  }
+  std::istringstream buf(value);
+  auto abs = DecodeResult(&buf);
+  if (abs == nullptr) {
+    MS_LOG(WARNING) << "The primitive eval cache of " << key << " is broken: " << value;
+  }
+  return abs;
+}
+
+void PersistentPrimEvalCache::Put(const std::string &key, const AbstractBasePtr &abs) {
+  std::ostringstream buf;
+  if (!EncodeResult(abs, &buf)) {
+    MS_LOG(DEBUG) << "Skip persisting the eval result " << abs->ToString() << " of " << key;
+    return;
+  }
+  pending_[key] = buf.str();
+}
+
+bool PersistentPrimEvalCache::Load() {
+#if defined(_WIN32)
+  return false;
+#else
+  if (loaded_) {
+    return data_ != nullptr;
+  }
+  loaded_ = true;
+  auto fd = open(file_path_.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat file_stat;
+  if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(CacheHeader)) {
+    (void)close(fd);
+    return false;
+  }
+  auto size = static_cast<size_t>(file_stat.st_size);
+  auto data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  (void)close(fd);
+  if (data == MAP_FAILED) {
+    MS_LOG(WARNING) << "Map the primitive eval cache file " << file_path_ << " failed.";
+    return false;
+  }
+  data_ = data;
+  data_size_ = size;
+  auto header = static_cast<const CacheHeader *>(data_);
+  if (memcmp(header->magic, kCacheMagic, kCacheMagicSize) != 0 || header->version != CacheVersion() ||
+      header->entry_num > (data_size_ - sizeof(CacheHeader)) / sizeof(Entry)) {
+    MS_LOG(INFO) << "Ignore the primitive eval cache file " << file_path_ << " of another version.";
+    Unload();
+    loaded_ = true;
+    return false;
+  }
+  entries_ = reinterpret_cast<const Entry *>(static_cast<const char *>(data_) + sizeof(CacheHeader));
+  entry_num_ = header->entry_num;
+  MS_LOG(INFO) << "Load " << entry_num_ << " primitive eval results from " << file_path_;
+  return true;
+#endif
+}
+
+void PersistentPrimEvalCache::Unload() {
+#if !defined(_WIN32)
+  if (data_ != nullptr) {
+    (void)munmap(data_, data_size_);
+  }
+#endif
+  data_ = nullptr;
+  data_size_ = 0;
+  entries_ = nullptr;
+  entry_num_ = 0;
+  loaded_ = false;
+}
+
+bool PersistentPrimEvalCache::FindInFile(const std::string &key, std::string *value) const {
+  auto hash = Fnv1aHash(key.data(), key.size());
+  auto begin = entries_;
+  auto end = entries_ + entry_num_;
+  auto iter = std::lower_bound(begin, end, hash, [](const Entry &entry, uint64_t h) { return entry.hash < h; });
+  auto data = static_cast<const char *>(data_);
+  for (; iter != end && iter->hash == hash; ++iter) {
+    if (iter->key_offset > data_size_ || iter->key_size > data_size_ - iter->key_offset ||
+        iter->value_offset > data_size_ || iter->value_size > data_size_ - iter->value_offset) {
+      MS_LOG(WARNING) << "The primitive eval cache file " << file_path_ << " is broken.";
+      return false;
+    }
+    if (iter->key_size == key.size() && memcmp(data + iter->key_offset, key.data(), key.size()) == 0) {
+      value->assign(data + iter->value_offset, iter->value_size);
+      return true;
+    }
+  }
+  return false;
+}
+
+void PersistentPrimEvalCache::Flush() {
+  if (pending_.empty()) {
+    return;
+  }
+  // Merge the results in the current file, which may have been replaced by other processes since it was mapped.
+  Unload();
+  std::map<std::string, std::string> results;
+  if (Load()) {
+    auto data = static_cast<const char *>(data_);
+    for (size_t i = 0; i < entry_num_; ++i) {
+      const auto &entry = entries_[i];
+      if (entry.key_offset + entry.key_size > data_size_ || entry.value_offset + entry.value_size > data_size_) {
+        break;
+      }
+      (void)results.emplace(std::string(data + entry.key_offset, entry.key_size),
+                            std::string(data + entry.value_offset, entry.value_size));
+    }
+  }
+  Unload();
+  for (auto &item : pending_) {
+    results[item.first] = std::move(item.second);
+  }
+  pending_.clear();
+
+  std::vector<std::pair<uint64_t, const std::pair<const std::string, std::string> *>> sorted_results;
+  sorted_results.reserve(results.size());
+  for (const auto &item : results) {
+    (void)sorted_results.emplace_back(Fnv1aHash(item.first.data(), item.first.size()), &item);
+  }
+  std::sort(sorted_results.begin(), sorted_results.end(),
+            [](const auto &a, const auto &b) { return a.first < b.first; });
+  CacheHeader header{};
+  (void)memcpy_s(header.magic, kCacheMagicSize, kCacheMagic, kCacheMagicSize);
+  header.version = CacheVersion();
+  header.entry_num = sorted_results.size();
+  std::vector<Entry> entries;
+  uint64_t offset = sizeof(CacheHeader) + sizeof(Entry) * sorted_results.size();
+  for (const auto &[hash, item] : sorted_results) {
+    Entry entry{hash, offset, item->first.size(), offset + item->first.size(), item->second.size()};
+    offset = entry.value_offset + entry.value_size;
+    (void)entries.emplace_back(entry);
+  }
+
+  // Write a temporary file and rename it, so that the file is always complete for the other processes.
+  const auto tmp_path = file_path_ + "." + std::to_string(GetProcessId()) + ".tmp";
+  {
+    std::ofstream ofs(tmp_path, std::ios::binary | std::ios::trunc);
+    if (!ofs.is_open()) {
+      MS_LOG(WARNING) << "Open the primitive eval cache file " << tmp_path << " failed.";
+      return;
+    }
+    (void)ofs.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    (void)ofs.write(reinterpret_cast<const char *>(entries.data()), sizeof(Entry) * entries.size());
+    for (const auto &result : sorted_results) {
+      (void)ofs.write(result.second->first.data(), result.second->first.size());
+      (void)ofs.write(result.second->second.data(), result.second->second.size());
+    }
+    if (!ofs.good()) {
+      MS_LOG(WARNING) << "Write the primitive eval cache file " << tmp_path << " failed.";
+      ofs.close();
+      (void)std::remove(tmp_path.c_str());
+      return;
+    }
+  }
+  if (std::rename(tmp_path.c_str(), file_path_.c_str()) != 0) {
+    MS_LOG(WARNING) << "Rename the primitive eval cache file " << tmp_path << " to " << file_path_ << " failed.";
+    (void)std::remove(tmp_path.c_str());
+    return;
+  }
+  MS_LOG(INFO) << "Save " << entries.size() << " primitive eval results to " << file_path_;
+}
+}  // namespace abstract
+}  // namespace mindspore
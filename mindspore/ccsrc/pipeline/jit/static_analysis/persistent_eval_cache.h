@@ -0,0 +1,78 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_PERSISTENT_EVAL_CACHE_H_
+#define MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_PERSISTENT_EVAL_CACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include "abstract/abstract_value.h"
+#include "ir/value.h"
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace abstract {
+// The on-disk cache of the infer results of the python primitives of MindSpore, which is shared by the processes
+// compiling the same networks, e.g. the ranks of a distributed job. The cache file is mapped read only when it is first
+// queried, and is ignored if it is written by another version of MindSpore. The new results are merged into a new file
+// which replaces the old one on flush, so that the processes mapping the old one are not affected. Only the results of
+// the tensors without values and the scalars are persisted. The infers of the primitives defined out of MindSpore are
+// not persisted, since their code is not covered by the version. It is not thread safe, and guarded by the
+// PrimitiveEvalCache.
+class PersistentPrimEvalCache {
+ public:
+  explicit PersistentPrimEvalCache(const std::string &file_path);
+  ~PersistentPrimEvalCache();
+
+  // Create the cache in the directory set by env MS_DEV_PRIM_EVAL_CACHE_PATH, return nullptr if it is not set.
+  static std::unique_ptr<PersistentPrimEvalCache> CreateFromEnv();
+  // Build the key of the infer of the primitive, return an empty string if the attrs or the args can not be persisted.
+  static std::string BuildKey(const std::string &prim_name, const mindspore::HashMap<std::string, ValuePtr> &attrs,
+                              const AbstractBasePtrList &args);
+
+  AbstractBasePtr Get(const std::string &key);
+  void Put(const std::string &key, const AbstractBasePtr &abs);
+  // Write the new results to the cache file, together with the ones already in it.
+  void Flush();
+  // Drop the new results which are not flushed.
+  void ClearPending() { pending_.clear(); }
+
+ private:
+  struct Entry {
+    uint64_t hash;
+    uint64_t key_offset;
+    uint64_t key_size;
+    uint64_t value_offset;
+    uint64_t value_size;
+  };
+
+  bool Load();
+  void Unload();
+  bool FindInFile(const std::string &key, std::string *value) const;
+
+  std::string file_path_;
+  bool loaded_{false};
+  void *data_{nullptr};
+  size_t data_size_{0};
+  const Entry *entries_{nullptr};
+  size_t entry_num_{0};
+  std::map<std::string, std::string> pending_;
+};
+}  // namespace abstract
+}  // namespace mindspore
+#endif  // MINDSPORE_CCSRC_PIPELINE_JIT_STATIC_ANALYSIS_PERSISTENT_EVAL_CACHE_H_
@@ -32,6 +32,7 @@
 #include "pipeline/jit/debug/trace.h"
 #include "include/common/debug/anf_ir_dump.h"
 #include "pipeline/jit/static_analysis/async_eval_result.h"
+#include "pipeline/jit/static_analysis/persistent_eval_cache.h"
 
 namespace mindspore {
 namespace abstract {
@@ -80,23 +81,76 @@ void DecreaseStackFrameDepth() {
 size_t StackFrameDepth() { return stack_frame_depth; }
 size_t StackFrameMaxDepth() { return stack_frame_max_depth; }
 
-EvalResultPtr PrimitiveEvalCache::Get(const PrimitivePtr &prim, const AbstractBasePtrList &args) const {
+namespace {
+constexpr char kMindSporeModulePrefix[] = "mindspore.";
+
+// The python infer of the primitives defined out of MindSpore, or the ones calling the user functions, may change
+// without changing the version of MindSpore, so their results are not persisted.
+bool IsPersistablePrim(const PrimitivePtr &prim) {
+  static const std::set<std::string> user_func_prims = {"Custom", "PyFunc"};
+  if (user_func_prims.count(prim->name()) != 0) {
+    return false;
+  }
+  auto prim_py = dyn_cast<PrimitivePy>(prim);
+  if (prim_py == nullptr) {
+    return true;
+  }
+  py::gil_scoped_acquire py_guard;
+  const auto &py_obj = prim_py->GetPyObj();
+  if (!py_obj || py_obj.is_none()) {
+    return false;
+  }
+  auto module_name = py::str(py_obj.get_type().attr("__module__")).cast<std::string>();
+  return module_name.rfind(kMindSporeModulePrefix, 0) == 0;
+}
+}  // namespace
+
+PrimitiveEvalCache::PrimitiveEvalCache() : persistent_cache_(PersistentPrimEvalCache::CreateFromEnv()) {}
+
+PrimitiveEvalCache::~PrimitiveEvalCache() = default;
+
+EvalResultPtr PrimitiveEvalCache::Get(const PrimitivePtr &prim, const AbstractBasePtrList &args) {
+  {
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto cache_iter = prim_cache_.find(prim->name());
+    if (cache_iter != prim_cache_.end()) {
+      auto &cache = cache_iter->second;
+      auto iter = cache.find(PrimitiveEvalCacheKey{prim->attrs(), args});
+      if (iter != cache.end()) {
+        return iter->second;
+      }
+    }
+  }
+  // Check the python class out of the lock, the gil may be held by the thread waiting for the lock.
+  if (persistent_cache_ == nullptr || !IsPersistablePrim(prim)) {
+    return nullptr;
+  }
   std::lock_guard<std::mutex> guard(mutex_);
-  auto cache_iter = prim_cache_.find(prim->name());
-  if (cache_iter == prim_cache_.end()) {
+  const auto &key = PersistentPrimEvalCache::BuildKey(prim->name(), prim->attrs(), args);
+  if (key.empty()) {
     return nullptr;
   }
-  auto &cache = cache_iter->second;
-  auto iter = cache.find(PrimitiveEvalCacheKey{prim->attrs(), args});
-  if (iter == cache.end()) {
+  auto abs = persistent_cache_->Get(key);
+  if (abs == nullptr) {
     return nullptr;
   }
-  return iter->second;
+  MS_LOG(DEBUG) << "Persistent primitive eval cache hit: " << key;
+  auto result = std::make_shared<EvalResult>(abs, std::make_shared<AttrValueMap>());
+  (void)prim_cache_[prim->name()].emplace(PrimitiveEvalCacheKey{prim->attrs(), args}, result);
+  return result;
 }
 
 void PrimitiveEvalCache::Put(const PrimitivePtr &prim, AttrValueMap &&attrs, const AbstractBasePtrList &args,
                              const EvalResultPtr &result) {
+  const bool persistable = persistent_cache_ != nullptr && IsPersistablePrim(prim);
   std::lock_guard<std::mutex> guard(mutex_);
+  // The results adding attributes to the primitive are not persisted, the attributes are not kept in the file.
+  if (persistable && (result->attribute() == nullptr || result->attribute()->empty())) {
+    const auto &key = PersistentPrimEvalCache::BuildKey(prim->name(), attrs, args);
+    if (!key.empty()) {
+      persistent_cache_->Put(key, result->abstract());
+    }
+  }
   (void)prim_cache_[prim->name()].emplace(PrimitiveEvalCacheKey{std::move(attrs), args}, result);
 }
 
@@ -105,6 +159,20 @@ void PrimitiveEvalCache::Clear() {
   prim_cache_.clear();
 }
 
+void PrimitiveEvalCache::DropPending() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (persistent_cache_ != nullptr) {
+    persistent_cache_->ClearPending();
+  }
+}
+
+void PrimitiveEvalCache::Flush() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  if (persistent_cache_ != nullptr) {
+    persistent_cache_->Flush();
+  }
+}
+
 AnalysisResult AnalysisEngine::Run(const FuncGraphPtr &func_graph, const AbstractBasePtrList &args_spec_list) {
   StaticAnalysisException::Instance().ClearException();
   AnalysisResult result;
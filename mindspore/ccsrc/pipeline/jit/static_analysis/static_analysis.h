@@ -268,19 +268,29 @@ struct PrimitiveEvalCacheEqual {
   }
 };
 
+class PersistentPrimEvalCache;
+
 class PrimitiveEvalCache {
  public:
   using EvalCache =
     std::unordered_map<PrimitiveEvalCacheKey, EvalResultPtr, PrimitiveEvalCacheHash, PrimitiveEvalCacheEqual>;
   using PrimToEvalCache = mindspore::HashMap<std::string, EvalCache>;
-  EvalResultPtr Get(const PrimitivePtr &prim, const AbstractBasePtrList &args) const;
+  PrimitiveEvalCache();
+  ~PrimitiveEvalCache();
+  EvalResultPtr Get(const PrimitivePtr &prim, const AbstractBasePtrList &args);
   void Put(const PrimitivePtr &prim, AttrValueMap &&attrs, const AbstractBasePtrList &args,
            const EvalResultPtr &result);
   void Clear();
+  // Save the new results to the persistent cache, if it is enabled.
+  void Flush();
+  // Drop the new results which are not saved to the persistent cache yet.
+  void DropPending();
 
  private:
   mutable std::mutex mutex_;
   PrimToEvalCache prim_cache_;
+  // The results shared with the other processes, which is consulted when the results are not in prim_cache_.
+  std::unique_ptr<PersistentPrimEvalCache> persistent_cache_;
 };
 
 using PrimitiveEvalCachePtr = std::shared_ptr<PrimitiveEvalCache>;
@@ -400,6 +400,7 @@ ValuePtr ForwardExecutor::RunOpForward(const FrontendOpRunInfoPtr &op_run_info)
   MS_EXCEPTION_IF_NULL(op_run_info);
   MS_LOG(DEBUG) << "RunOp name: " << op_run_info->base_op_run_info.op_name;
   if (op_run_info->base_op_run_info.op_name == prim::kPrimMixedPrecisionCast->name()) {
+    graph_capture()->AbandonCapture("mixed precision cast can't run in graph");
     return RunMixedPrecisionCastOp(op_run_info);
   }
 
@@ -411,6 +412,7 @@ ValuePtr ForwardExecutor::RunOpForward(const FrontendOpRunInfoPtr &op_run_info)
   bool prim_cache_hit = GetOutputAbstract(op_run_info);
   // 4.Get output
   const auto &out_value = GetOutput(op_run_info, prim_cache_hit);
+  graph_capture()->RecordOp(op_run_info, out_value);
   // 5. Do op grad
   grad()->ProcessOpGradInfo(op_run_info, out_value);
   return out_value;
@@ -629,6 +631,9 @@ void ForwardExecutor::ExecuteLazyTask() {
 }
 
 void ForwardExecutor::ProcessBeforeNewGraph(const py::object &cell, const py::args &args) {
+  if (IsFirstCell() && !grad()->grad_flag() && GraphCapture::IsEnable()) {
+    graph_capture()->BeginCapture(cell, args);
+  }
   if (py::isinstance<Cell>(cell)) {
     PushForwardCell(cell);
   }
@@ -738,6 +743,7 @@ void ForwardExecutor::ClearRes() {
   lazy_build_ = false;
   prim_abs_list_.clear();
   std::stack<CellPtr>().swap(forward_cell_stack_);
+  graph_capture()->Clear();
   session_backends_.clear();
   mindrt_backends_.clear();
   kNotConstPrimOrConstInput.clear();
@@ -25,6 +25,7 @@
 #include "pipeline/pynative/forward/do_cast.h"
 #include "pipeline/pynative/grad/grad.h"
 #include "pipeline/pynative/dynamic_shape.h"
+#include "pipeline/pynative/graph_capture.h"
 #include "backend/common/session/session_factory.h"
 #include "backend/common/session/session_basic.h"
 #include "backend/graph_compiler/backend.h"
@@ -48,7 +49,9 @@ using MindrtBackendMap = std::map<std::string, std::shared_ptr<compile::MindRTBa
 class ForwardExecutor {
  public:
   ForwardExecutor()
-      : cast_operation_(std::make_shared<CastOperation>()), dynamic_shape_(std::make_shared<DynamicShape>()) {}
+      : cast_operation_(std::make_shared<CastOperation>()),
+        dynamic_shape_(std::make_shared<DynamicShape>()),
+        graph_capture_(std::make_shared<GraphCapture>()) {}
   ~ForwardExecutor() = default;
 
   std::function<void(py::object *, const FrontendOpRunInfoPtr &)> RunOpS = [this](auto &&PH1, auto &&PH2) {
@@ -70,6 +73,10 @@ class ForwardExecutor {
     MS_EXCEPTION_IF_NULL(dynamic_shape_);
     return dynamic_shape_;
   }
+  inline GraphCapturePtr graph_capture() const {
+    MS_EXCEPTION_IF_NULL(graph_capture_);
+    return graph_capture_;
+  }
   const MindrtBackendMap &mindrt_backend() const { return mindrt_backends_; }
   const std::stack<CellPtr> &forward_cell_stack() const { return forward_cell_stack_; }
   inline bool IsFirstCell() const { return forward_cell_stack_.empty(); }
@@ -119,6 +126,7 @@ class ForwardExecutor {
   GradExecutorWeakPtr grad_executor_;
   CastOperationPtr cast_operation_;
   DynamicShapePtr dynamic_shape_;
+  GraphCapturePtr graph_capture_;
   SessionBackendMap session_backends_;
   MindrtBackendMap mindrt_backends_;
   mindspore::HashMap<std::string, abstract::AbstractBasePtr> node_abs_map_;
@@ -0,0 +1,365 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "pipeline/pynative/graph_capture.h"
+#include <set>
+#include <vector>
+#include <algorithm>
+#include "pipeline/pynative/pynative_utils.h"
+#include "pipeline/jit/action.h"
+#include "backend/graph_compiler/transform.h"
+#include "include/common/utils/convert_utils_py.h"
+#include "pybind_api/ir/tensor_py.h"
+#include "utils/ms_utils.h"
+#include "utils/flags.h"
+#include "ir/cell.h"
+
+namespace mindspore {
+namespace pynative {
+namespace {
+// The number of consecutive steps with the same signature before the graph of a key is compiled.
+constexpr size_t kCaptureStableSteps = 2;
+// The number of steps a key is captured before giving up on it when its signature keeps changing.
+constexpr size_t kMaxCaptureSteps = 8;
+// The number of keys which are captured.
+constexpr size_t kMaxCaptureRecords = 64;
+// The ops which run python functions or are executed by the vm, they can't be put in a graph.
+const std::set<std::string> kUnsupportedCapturePrims = {"InsertGradientOf", "stop_gradient", "mixed_precision_cast",
+                                                        "HookBackward", "CellBackwardHook"};
+const std::vector<std::string> kSideEffectFlags = {GRAPH_FLAG_SIDE_EFFECT_IO, GRAPH_FLAG_SIDE_EFFECT_MEM,
+                                                   GRAPH_FLAG_SIDE_EFFECT_HIDDEN, GRAPH_FLAG_SIDE_EFFECT_PROPAGATE};
+
+bool ContainsTensor(const ValuePtr &v) {
+  MS_EXCEPTION_IF_NULL(v);
+  if (v->isa<tensor::Tensor>()) {
+    return true;
+  }
+  if (v->isa<ValueSequence>()) {
+    const auto &elements = v->cast<ValueSequencePtr>()->value();
+    return std::any_of(elements.begin(), elements.end(), [](const ValuePtr &e) { return ContainsTensor(e); });
+  }
+  return false;
+}
+
+std::string GetTensorGuard(const tensor::TensorPtr &tensor) {
+  MS_EXCEPTION_IF_NULL(tensor);
+  std::string guard = "T" + std::to_string(static_cast<int>(tensor->data_type())) + "[";
+  for (const auto &dim : tensor->shape()) {
+    guard += std::to_string(dim) + ",";
+  }
+  return guard + "]";
+}
+}  // namespace
+
+bool GraphCapture::IsEnable() { return common::GetEnv("MS_DEV_PYNATIVE_GRAPH_CAPTURE") == "1"; }
+
+std::string GraphCapture::GetGuardKey(const py::object &cell, const py::args &args) const {
+  if (!py::isinstance<Cell>(cell)) {
+    return "";
+  }
+  std::string key = PyNativeAlgo::PyParser::GetIdByPyObj(cell);
+  if (py::hasattr(cell, "training") && py::cast<bool>(py::getattr(cell, "training"))) {
+    key += "_train";
+  }
+  std::vector<std::string> tensor_ids;
+  for (size_t i = 0; i < args.size(); ++i) {
+    const auto &arg = args[i];
+    if (py::isinstance<tensor::Tensor>(arg)) {
+      const auto &tensor = py::cast<tensor::TensorPtr>(arg);
+      key += "_" + GetTensorGuard(tensor);
+      // The same tensor may be given to several inputs, which are the same node of the captured graph.
+      const auto &id = tensor->id();
+      const auto iter = std::find(tensor_ids.begin(), tensor_ids.end(), id);
+      if (iter != tensor_ids.end()) {
+        key += "=" + std::to_string(iter - tensor_ids.begin());
+      }
+      tensor_ids.emplace_back(id);
+    } else if (py::isinstance<py::int_>(arg) || py::isinstance<py::float_>(arg) || py::isinstance<py::str>(arg) ||
+               py::isinstance<py::none>(arg)) {
+      key += "_" + PyNativeAlgo::PyParser::GetIdByPyObj(arg);
+    } else {
+      MS_LOG(DEBUG) << "The input " << i << " of cell can't be guarded, type " << py::str(arg.get_type());
+      return "";
+    }
+  }
+  return key;
+}
+
+void GraphCapture::BeginCapture(const py::object &cell, const py::args &args) {
+  capturing_ = false;
+  key_ = GetGuardKey(cell, args);
+  if (key_.empty()) {
+    return;
+  }
+  auto iter = records_.find(key_);
+  if (iter == records_.end()) {
+    if (records_.size() >= kMaxCaptureRecords) {
+      return;
+    }
+    iter = records_.emplace(key_, CaptureRecord()).first;
+  }
+  if (iter->second.disabled || iter->second.resource != nullptr) {
+    return;
+  }
+  fg_ = std::make_shared<FuncGraph>();
+  signature_.clear();
+  op_num_ = 0;
+  node_map_.clear();
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (!py::isinstance<tensor::Tensor>(args[i])) {
+      continue;
+    }
+    const auto &tensor = py::cast<tensor::TensorPtr>(args[i]);
+    auto param = fg_->add_parameter();
+    param->set_abstract(tensor->ToAbstract()->Broaden());
+    node_map_[PyNativeAlgo::Common::GetIdByValue(tensor)] = std::make_pair(param, "a" + std::to_string(i));
+  }
+  capturing_ = true;
+  // The python control flow depending on the values of the tensors, such as if x.sum() > 0, is not in the graph.
+  tensor::TensorPy::SetSyncAsNumpyCallback(
+    [this]() { AbandonCapture("the value of a tensor is read by python while capturing"); });
+  MS_LOG(DEBUG) << "Begin capture, key " << key_;
+}
+
+AnfNodePtr GraphCapture::GetInput(const ValuePtr &v, std::string *label) {
+  MS_EXCEPTION_IF_NULL(v);
+  MS_EXCEPTION_IF_NULL(label);
+  if (v->isa<tensor::Tensor>()) {
+    const auto &id = PyNativeAlgo::Common::GetIdByValue(v);
+    const auto iter = node_map_.find(id);
+    if (iter != node_map_.end()) {
+      *label = iter->second.second;
+      return iter->second.first;
+    }
+    const auto &tensor = v->cast<tensor::TensorPtr>();
+    if (tensor->is_parameter()) {
+      // The weights are the parameters after the inputs, their values are given by the default parameters.
+      auto param = fg_->add_parameter();
+      param->set_name(id);
+      param->debug_info()->set_name(id);
+      param->set_default_param(tensor);
+      param->set_abstract(tensor->ToAbstract()->Broaden());
+      *label = "w:" + id;
+      node_map_[id] = std::make_pair(param, *label);
+      return param;
+    }
+    // A tensor which is not produced in the step is a constant of the graph, the label keeps its identity so that the
+    // tensors created again in every step never make the signature stable.
+    auto node = NewValueNode(v);
+    node->set_abstract(v->ToAbstract());
+    *label = "c:" + id;
+    node_map_[id] = std::make_pair(node, *label);
+    return node;
+  }
+  if (v->isa<ValueSequence>() && ContainsTensor(v)) {
+    const auto &elements = v->cast<ValueSequencePtr>()->value();
+    std::vector<AnfNodePtr> inputs{NewValueNode(prim::kPrimMakeTuple)};
+    AbstractBasePtrList abs_list;
+    *label = "(";
+    for (const auto &element : elements) {
+      std::string element_label;
+      const auto &node = GetInput(element, &element_label);
+      (void)inputs.emplace_back(node);
+      (void)abs_list.emplace_back(node->abstract());
+      *label += element_label + ",";
+    }
+    *label += ")";
+    auto cnode = fg_->NewCNode(inputs);
+    cnode->set_abstract(std::make_shared<abstract::AbstractTuple>(abs_list));
+    return cnode;
+  }
+  auto node = NewValueNode(v);
+  node->set_abstract(v->ToAbstract());
+  *label = PyNativeAlgo::Common::GetIdByValue(v);
+  return node;
+}
+
+void GraphCapture::SetOutputNode(const ValuePtr &v, const AnfNodePtr &node, const std::string &label) {
+  MS_EXCEPTION_IF_NULL(v);
+  MS_EXCEPTION_IF_NULL(node);
+  if (v->isa<tensor::Tensor>()) {
+    node_map_[PyNativeAlgo::Common::GetIdByValue(v)] = std::make_pair(node, label);
+    return;
+  }
+  const auto &abs = node->abstract();
+  if (!v->isa<ValueSequence>() || abs == nullptr || !abs->isa<abstract::AbstractSequence>()) {
+    return;
+  }
+  const auto &elements = v->cast<ValueSequencePtr>()->value();
+  const auto &abs_elements = abs->cast<abstract::AbstractSequencePtr>()->elements();
+  for (size_t i = 0; i < elements.size() && i < abs_elements.size(); ++i) {
+    if (!ContainsTensor(elements[i])) {
+      continue;
+    }
+    auto item = fg_->NewCNode({NewValueNode(prim::kPrimTupleGetItem), node, NewValueNode(SizeToLong(i))});
+    item->set_abstract(abs_elements[i]);
+    SetOutputNode(elements[i], item, label + "." + std::to_string(i));
+  }
+}
+
+void GraphCapture::RecordOp(const FrontendOpRunInfoPtr &op_run_info, const ValuePtr &out_value) {
+  if (!capturing_) {
+    return;
+  }
+  MS_EXCEPTION_IF_NULL(op_run_info);
+  MS_EXCEPTION_IF_NULL(out_value);
+  const auto &prim = op_run_info->op_prim;
+  MS_EXCEPTION_IF_NULL(prim);
+  const auto &op_name = op_run_info->base_op_run_info.op_name;
+  if (kUnsupportedCapturePrims.find(op_name) != kUnsupportedCapturePrims.end()) {
+    AbandonCapture("op " + op_name + " can't run in graph");
+    return;
+  }
+  if (std::any_of(kSideEffectFlags.begin(), kSideEffectFlags.end(),
+                  [&prim](const std::string &flag) { return prim->HasAttr(flag); })) {
+    AbandonCapture("op " + op_name + " has side effect");
+    return;
+  }
+  if (PyNativeAlgo::Common::IsDynamicShape(op_run_info)) {
+    AbandonCapture("op " + op_name + " is dynamic shape");
+    return;
+  }
+
+  std::vector<AnfNodePtr> inputs{NewValueNode(prim)};
+  std::string op_label = op_name + prim->GetAttrsText() + "(";
+  for (const auto &input_value : op_run_info->input_value) {
+    std::string input_label;
+    (void)inputs.emplace_back(GetInput(input_value, &input_label));
+    op_label += input_label + ",";
+  }
+  auto cnode = fg_->NewCNodeInOrder(inputs);
+  const auto &abs = op_run_info->base_op_run_info.abstract;
+  cnode->set_abstract(abs);
+  op_label += ")";
+  if (abs != nullptr) {
+    op_label += abs->BuildType()->ToString() + abs->BuildShape()->ToString();
+  }
+  signature_ += op_label + ";";
+  SetOutputNode(out_value, cnode, "o" + std::to_string(op_num_++));
+}
+
+void GraphCapture::AbandonCapture(const std::string &reason) {
+  if (!capturing_) {
+    return;
+  }
+  MS_LOG(INFO) << "Abandon the graph capture of " << key_ << ", " << reason;
+  records_[key_].disabled = true;
+  capturing_ = false;
+  tensor::TensorPy::SetSyncAsNumpyCallback(nullptr);
+  fg_ = nullptr;
+  node_map_.clear();
+}
+
+void GraphCapture::EndCapture(const py::object &out) {
+  if (!capturing_) {
+    return;
+  }
+  capturing_ = false;
+  tensor::TensorPy::SetSyncAsNumpyCallback(nullptr);
+  auto &record = records_[key_];
+  std::string label;
+  const auto &output = GetInput(PyNativeAlgo::DataConvert::PyObjToValue(out), &label);
+  fg_->set_output(output);
+  signature_ += "return " + label;
+
+  ++record.capture_count;
+  if (record.signature == signature_) {
+    ++record.stable_count;
+  } else {
+    record.signature = std::move(signature_);
+    record.stable_count = 1;
+  }
+  if (record.stable_count >= kCaptureStableSteps) {
+    CompileGraph(&record);
+  } else if (record.capture_count >= kMaxCaptureSteps) {
+    MS_LOG(INFO) << "The steps of " << key_ << " keep changing, stop capturing it";
+    record.disabled = true;
+    record.signature.clear();
+  }
+  fg_ = nullptr;
+  node_map_.clear();
+}
+
+void GraphCapture::CompileGraph(CaptureRecord *record) {
+  MS_EXCEPTION_IF_NULL(record);
+  MS_EXCEPTION_IF_NULL(fg_);
+  MS_LOG(INFO) << "Compile the captured graph of " << key_ << ", op num " << op_num_;
+  auto resource = std::make_shared<pipeline::Resource>();
+  resource->set_func_graph(fg_);
+  auto manager = resource->manager();
+  MS_EXCEPTION_IF_NULL(manager);
+  manager->AddFuncGraph(fg_, true);
+  try {
+    compile::SetMindRTEnable();
+    resource->SetBackendAsync([]() { return compile::CreateBackend(); });
+    (void)pipeline::TaskEmitAction(resource);
+    (void)pipeline::ExecuteAction(resource);
+  } catch (const std::exception &ex) {
+    // The cell still runs eagerly, the capture is only an optimization.
+    MS_LOG(WARNING) << "Compile the captured graph of " << key_ << " failed, it keeps running in PyNative. "
+                    << ex.what();
+    record->disabled = true;
+    return;
+  }
+  record->resource = resource;
+  record->signature.clear();
+}
+
+void GraphCapture::ReplayGraphInner(py::object *ret, const py::object &cell, const py::args &args) {
+  MS_EXCEPTION_IF_NULL(ret);
+  const auto &key = GetGuardKey(cell, args);
+  if (key.empty()) {
+    return;
+  }
+  const auto iter = records_.find(key);
+  if (iter == records_.end() || iter->second.resource == nullptr) {
+    return;
+  }
+  const auto &resource = iter->second.resource;
+  const auto &fg = resource->func_graph();
+  MS_EXCEPTION_IF_NULL(fg);
+  VectorRef arg_list;
+  for (size_t i = 0; i < args.size(); ++i) {
+    if (py::isinstance<tensor::Tensor>(args[i])) {
+      arg_list.push_back(PyNativeAlgo::DataConvert::PyObjToValue(args[i]));
+    }
+  }
+  const auto &params = fg->parameters();
+  for (size_t i = arg_list.size(); i < params.size(); ++i) {
+    const auto &param = params[i]->cast<ParameterPtr>();
+    MS_EXCEPTION_IF_NULL(param);
+    arg_list.push_back(param->default_param());
+  }
+  compile::VmEvalFuncPtr run = resource->GetResult(pipeline::kOutput).cast<compile::VmEvalFuncPtr>();
+  MS_EXCEPTION_IF_NULL(run);
+  MS_LOG(DEBUG) << "Replay the captured graph of " << key;
+  BaseRef value = (*run)(arg_list);
+  *ret = BaseRefToPyData(value, fg->output()->abstract());
+}
+
+void GraphCapture::Clear() {
+  if (capturing_) {
+    tensor::TensorPy::SetSyncAsNumpyCallback(nullptr);
+  }
+  capturing_ = false;
+  key_.clear();
+  fg_ = nullptr;
+  signature_.clear();
+  node_map_.clear();
+  records_.clear();
+}
+}  // namespace pynative
+}  // namespace mindspore
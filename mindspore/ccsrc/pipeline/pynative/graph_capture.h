@@ -0,0 +1,87 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_MINDSPORE_CCSRC_PIPELINE_PYNATIVE_GRAPH_CAPTURE_H_
+#define MINDSPORE_MINDSPORE_CCSRC_PIPELINE_PYNATIVE_GRAPH_CAPTURE_H_
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <functional>
+#include "pipeline/pynative/base.h"
+#include "pipeline/jit/resource.h"
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace pynative {
+// Graph capture of the top cells which run without grad.
+// While a top cell runs eagerly, every op of the step is recorded into a FuncGraph whose parameters are the tensor
+// inputs of the cell followed by the weights. A step is identified by a guard key made of the cell, its training flag
+// and the shapes and types of its inputs. When the ops, the shapes and the dataflow of a key are the same for
+// kCaptureStableSteps steps in a row, the graph of the last step is compiled once by the MindRT backend, and the next
+// calls of the cell with the same key replay it through the graph runtime instead of dispatching every op. Any
+// difference of the key falls back to the eager execution, which captures the new key again. The key doesn't cover the
+// values of the tensors, so a key whose step reads a tensor value in python, e.g. by asnumpy() or bool(), is not
+// captured.
+class GraphCapture {
+ public:
+  GraphCapture() = default;
+  ~GraphCapture() = default;
+
+  // The capture is enabled by the environment variable MS_DEV_PYNATIVE_GRAPH_CAPTURE=1. Python side effects of the
+  // construct, such as print or the forward hooks, only run in the eager steps.
+  static bool IsEnable();
+
+  std::function<void(py::object *, const py::object &, const py::args &)> ReplayGraph = [this](auto &&PH1, auto &&PH2,
+                                                                                               auto &&PH3) {
+    ReplayGraphInner(std::forward<decltype(PH1)>(PH1), std::forward<decltype(PH2)>(PH2),
+                     std::forward<decltype(PH3)>(PH3));
+  };
+  void BeginCapture(const py::object &cell, const py::args &args);
+  void RecordOp(const FrontendOpRunInfoPtr &op_run_info, const ValuePtr &out_value);
+  void AbandonCapture(const std::string &reason);
+  void EndCapture(const py::object &out);
+  inline bool capturing() const { return capturing_; }
+  void Clear();
+
+ private:
+  struct CaptureRecord {
+    std::string signature;
+    size_t capture_count{0};
+    size_t stable_count{0};
+    bool disabled{false};
+    pipeline::ResourcePtr resource{nullptr};
+  };
+
+  void ReplayGraphInner(py::object *ret, const py::object &cell, const py::args &args);
+  std::string GetGuardKey(const py::object &cell, const py::args &args) const;
+  AnfNodePtr GetInput(const ValuePtr &v, std::string *label);
+  void SetOutputNode(const ValuePtr &v, const AnfNodePtr &node, const std::string &label);
+  void CompileGraph(CaptureRecord *record);
+
+  bool capturing_{false};
+  std::string key_;
+  FuncGraphPtr fg_{nullptr};
+  std::string signature_;
+  size_t op_num_{0};
+  // The node and the label in the signature of the values of the step, by the value id.
+  mindspore::HashMap<std::string, std::pair<AnfNodePtr, std::string>> node_map_;
+  mindspore::HashMap<std::string, CaptureRecord> records_;
+};
+using GraphCapturePtr = std::shared_ptr<GraphCapture>;
+}  // namespace pynative
+}  // namespace mindspore
+#endif  // MINDSPORE_MINDSPORE_CCSRC_PIPELINE_PYNATIVE_GRAPH_CAPTURE_H_
@@ -202,6 +202,9 @@ void PyNativeExecutor::NewGraph(const py::object &cell, const py::args &args) co
 
 void PyNativeExecutor::EndGraph(const py::object &cell, const py::object &out, const py::args &args) const {
   forward_executor()->ProcessBeforeEndGraph(cell, args);
+  if (forward_executor()->IsFirstCell()) {
+    forward_executor()->graph_capture()->EndCapture(out);
+  }
 
   if (!grad_flag()) {
     MS_LOG(DEBUG) << "Grad flag is false";
@@ -212,6 +215,19 @@ void PyNativeExecutor::EndGraph(const py::object &cell, const py::object &out, c
   forward_executor()->ProcessAfterEndGraph();
 }
 
+py::object PyNativeExecutor::ReplayGraph(const py::object &cell, const py::args &args) const {
+  py::object ret = py::none();
+  if (!GraphCapture::IsEnable() || grad_flag() || !forward_executor()->IsFirstCell()) {
+    return ret;
+  }
+  PyNativeExecutorTry(forward_executor()->graph_capture()->ReplayGraph, &ret, cell, args);
+  if (!py::isinstance<py::none>(ret)) {
+    // The graph replaces the whole step of the top cell, which is not ended by end_graph.
+    forward_executor()->set_lazy_build(false);
+  }
+  return ret;
+}
+
 void PyNativeExecutor::GradNet(const prim::GradOperationPtr &grad, const py::object &cell, const py::object &weights,
                                const py::object &grad_position, const py::args &args) const {
   const py::object ret;
@@ -232,6 +248,7 @@ REGISTER_PYBIND_DEFINE(PynativeExecutor_, ([](const py::module *m) {
                            .def("is_first_cell", &PyNativeExecutor::IsFirstCell, "check if the first cell.")
                            .def("new_graph", &PyNativeExecutor::NewGraph, "pynative new a graph.")
                            .def("end_graph", &PyNativeExecutor::EndGraph, "pynative end a graph.")
+                           .def("replay_graph", &PyNativeExecutor::ReplayGraph, "pynative replay a captured graph.")
                            .def("check_graph", &PyNativeExecutor::CheckGraph, "pynative check a grad graph.")
                            .def("check_run", &PyNativeExecutor::CheckAlreadyRun, "pynative check graph run before.")
                            .def("grad_ms_function", &PyNativeExecutor::GradMsFunction, "pynative grad for ms_function.")
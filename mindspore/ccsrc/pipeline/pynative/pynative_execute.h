@@ -67,6 +67,7 @@ class PyNativeExecutor : public std::enable_shared_from_this<PyNativeExecutor> {
   void SetHookChanged(const py::object &cell) const;
   void NewGraph(const py::object &cell, const py::args &args) const;
   void EndGraph(const py::object &cell, const py::object &out, const py::args &args) const;
+  py::object ReplayGraph(const py::object &cell, const py::args &args) const;
   void GradNet(const prim::GradOperationPtr &grad, const py::object &cell, const py::object &weights,
                const py::object &grad_position, const py::args &args) const;
   py::object GradMsFunction(const py::object &out, const py::args &args) const;
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef ENABLE_AVX512
+
+#include <x86intrin.h>
+#include "nnacl/fp32/matmul_int4_weight_fp32.h"
+
+// Dequantize 16 int4 values into one register once and multiply them with at most 4 rows of a.
+int Int4WeightDotAVX512(const float *a, int a_stride, int rows, const uint8_t *b, int len, float *dots) {
+  __m512 acc[C4NUM] = {_mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps(), _mm512_setzero_ps()};
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  int k = 0;
+  for (; k <= len - C16NUM; k += C16NUM) {
+    __m128i packed = _mm_loadl_epi64((const __m128i *)(b + k / C2NUM));
+    __m128i lo = _mm_and_si128(packed, mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(packed, C4NUM), mask);
+    __m512 w = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(_mm_unpacklo_epi8(lo, hi)));
+    for (int i = 0; i < rows; ++i) {
+      acc[i] = _mm512_fmadd_ps(_mm512_loadu_ps(a + i * a_stride + k), w, acc[i]);
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    dots[i] = _mm512_reduce_add_ps(acc[i]);
+  }
+  return k;
+}
+#endif
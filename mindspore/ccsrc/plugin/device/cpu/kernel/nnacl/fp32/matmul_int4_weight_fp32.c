@@ -0,0 +1,237 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32/matmul_int4_weight_fp32.h"
+#include "nnacl/errorcode.h"
+#include <float.h>
+#include <math.h>
+#include <string.h>
+#ifdef ENABLE_AVX512
+#include "nnacl/intrinsics/ms_simd_cpu_info.h"
+#endif
+#ifdef ENABLE_AVX
+#include <x86intrin.h>
+#endif
+#ifdef ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
+#define INT4_MAX_VALUE 15
+
+void QuantizeWeightToInt4Fp32(const float *src, uint8_t *dst, float *scales, float *mins, int deep, int col,
+                              int group_size, bool deep_major) {
+  int deep_half = UP_DIV(deep, C2NUM);
+  int group_num = UP_DIV(deep, group_size);
+  memset(dst, 0, (size_t)col * deep_half);
+  int deep_stride = deep_major ? 1 : col;
+  for (int n = 0; n < col; ++n) {
+    const float *src_col = deep_major ? src + n * deep : src + n;
+    uint8_t *dst_col = dst + n * deep_half;
+    for (int g = 0; g < group_num; ++g) {
+      int start = g * group_size;
+      int end = MSMIN(start + group_size, deep);
+      float min_value = FLT_MAX;
+      float max_value = -FLT_MAX;
+      for (int k = start; k < end; ++k) {
+        min_value = MSMIN(min_value, src_col[k * deep_stride]);
+        max_value = MSMAX(max_value, src_col[k * deep_stride]);
+      }
+      float scale = (max_value - min_value) / INT4_MAX_VALUE;
+      if (scale < FLT_EPSILON) {
+        scale = 1.0f;
+      }
+      scales[n * group_num + g] = scale;
+      mins[n * group_num + g] = min_value;
+      for (int k = start; k < end; ++k) {
+        int q = (int)roundf((src_col[k * deep_stride] - min_value) / scale);
+        q = MSMIN(MSMAX(q, 0), INT4_MAX_VALUE);
+        dst_col[k / C2NUM] |= (uint8_t)(q << ((k % C2NUM) * C4NUM));
+      }
+    }
+  }
+}
+
+int PackQuantWeightToInt4Fp32(const int8_t *src, const float *quant_scales, const float *quant_offsets, uint8_t *dst,
+                              float *scales, float *mins, int deep, int col, int group_size, bool deep_major) {
+  int deep_half = UP_DIV(deep, C2NUM);
+  int group_num = UP_DIV(deep, group_size);
+  memset(dst, 0, (size_t)col * deep_half);
+  int deep_stride = deep_major ? 1 : col;
+  for (int n = 0; n < col; ++n) {
+    const int8_t *src_col = deep_major ? src + n * deep : src + n;
+    uint8_t *dst_col = dst + n * deep_half;
+    for (int g = 0; g < group_num; ++g) {
+      int start = g * group_size;
+      int end = MSMIN(start + group_size, deep);
+      int min_value = INT8_MAX;
+      int max_value = INT8_MIN;
+      for (int k = start; k < end; ++k) {
+        min_value = MSMIN(min_value, src_col[k * deep_stride]);
+        max_value = MSMAX(max_value, src_col[k * deep_stride]);
+      }
+      if (max_value - min_value > INT4_MAX_VALUE) {
+        return NNACL_ERR;
+      }
+      // q * scale + offset = (q - min_value) * scale + (min_value * scale + offset)
+      scales[n * group_num + g] = quant_scales[n];
+      mins[n * group_num + g] = min_value * quant_scales[n] + quant_offsets[n];
+      for (int k = start; k < end; ++k) {
+        int q = src_col[k * deep_stride] - min_value;
+        dst_col[k / C2NUM] |= (uint8_t)(q << ((k % C2NUM) * C4NUM));
+      }
+    }
+  }
+  return NNACL_OK;
+}
+
+void Int4WeightGroupSumFp32(const float *a, float *a_sums, int row, int deep, int group_size) {
+  int group_num = UP_DIV(deep, group_size);
+  for (int r = 0; r < row; ++r) {
+    const float *src = a + r * deep;
+    for (int g = 0; g < group_num; ++g) {
+      int end = MSMIN((g + 1) * group_size, deep);
+      float sum = 0.0f;
+      for (int k = g * group_size; k < end; ++k) {
+        sum += src[k];
+      }
+      a_sums[r * group_num + g] = sum;
+    }
+  }
+}
+
+#if defined(ENABLE_AVX)
+// Dequantize 16 int4 values once and multiply them with at most 4 rows of a.
+static int Int4WeightDotAVX(const float *a, int a_stride, int rows, const uint8_t *b, int len, float *dots) {
+  __m256 acc[C4NUM] = {_mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps()};
+  const __m128i mask = _mm_set1_epi8(0x0F);
+  int k = 0;
+  for (; k <= len - C16NUM; k += C16NUM) {
+    __m128i packed = _mm_loadl_epi64((const __m128i *)(b + k / C2NUM));
+    __m128i lo = _mm_and_si128(packed, mask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(packed, C4NUM), mask);
+    __m128i values = _mm_unpacklo_epi8(lo, hi);
+    __m256 w0 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(values));
+    __m256 w1 = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(_mm_srli_si128(values, C8NUM)));
+    for (int i = 0; i < rows; ++i) {
+      const float *src = a + i * a_stride + k;
+      acc[i] = _mm256_fmadd_ps(_mm256_loadu_ps(src), w0, acc[i]);
+      acc[i] = _mm256_fmadd_ps(_mm256_loadu_ps(src + C8NUM), w1, acc[i]);
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(acc[i]), _mm256_extractf128_ps(acc[i], 1));
+    sum = _mm_hadd_ps(sum, sum);
+    sum = _mm_hadd_ps(sum, sum);
+    dots[i] = _mm_cvtss_f32(sum);
+  }
+  return k;
+}
+#elif defined(ENABLE_NEON)
+static inline float ReduceAddNeon(float32x4_t value) {
+  float32x2_t sum = vadd_f32(vget_low_f32(value), vget_high_f32(value));
+  return vget_lane_f32(vpadd_f32(sum, sum), 0);
+}
+
+// Dequantize 16 int4 values once and multiply them with at most 4 rows of a.
+static int Int4WeightDotNEON(const float *a, int a_stride, int rows, const uint8_t *b, int len, float *dots) {
+  float32x4_t acc[C4NUM] = {vdupq_n_f32(0.0f), vdupq_n_f32(0.0f), vdupq_n_f32(0.0f), vdupq_n_f32(0.0f)};
+  const uint8x8_t mask = vdup_n_u8(0x0F);
+  int k = 0;
+  for (; k <= len - C16NUM; k += C16NUM) {
+    uint8x8_t packed = vld1_u8(b + k / C2NUM);
+    uint8x8x2_t values = vzip_u8(vand_u8(packed, mask), vshr_n_u8(packed, C4NUM));
+    uint16x8_t values0 = vmovl_u8(values.val[0]);
+    uint16x8_t values1 = vmovl_u8(values.val[1]);
+    float32x4_t w[C4NUM] = {vcvtq_f32_u32(vmovl_u16(vget_low_u16(values0))),
+                            vcvtq_f32_u32(vmovl_u16(vget_high_u16(values0))),
+                            vcvtq_f32_u32(vmovl_u16(vget_low_u16(values1))),
+                            vcvtq_f32_u32(vmovl_u16(vget_high_u16(values1)))};
+    for (int i = 0; i < rows; ++i) {
+      const float *src = a + i * a_stride + k;
+      for (int j = 0; j < C4NUM; ++j) {
+        acc[i] = vmlaq_f32(acc[i], vld1q_f32(src + j * C4NUM), w[j]);
+      }
+    }
+  }
+  for (int i = 0; i < rows; ++i) {
+    dots[i] = ReduceAddNeon(acc[i]);
+  }
+  return k;
+}
+#endif
+
+// b starts at an even depth, so the first value is always the low nibble.
+static void Int4WeightDot(const float *a, int a_stride, int rows, const uint8_t *b, int len, float *dots) {
+  int k = 0;
+#if defined(ENABLE_AVX512)
+  if (X86_Avx512_Support()) {
+    k = Int4WeightDotAVX512(a, a_stride, rows, b, len, dots);
+  } else {
+    k = Int4WeightDotAVX(a, a_stride, rows, b, len, dots);
+  }
+#elif defined(ENABLE_AVX)
+  k = Int4WeightDotAVX(a, a_stride, rows, b, len, dots);
+#elif defined(ENABLE_NEON)
+  k = Int4WeightDotNEON(a, a_stride, rows, b, len, dots);
+#else
+  for (int i = 0; i < rows; ++i) {
+    dots[i] = 0.0f;
+  }
+#endif
+  for (; k < len; ++k) {
+    float w = (float)((b[k / C2NUM] >> ((k % C2NUM) * C4NUM)) & 0x0F);
+    for (int i = 0; i < rows; ++i) {
+      dots[i] += a[i * a_stride + k] * w;
+    }
+  }
+}
+
+void MatmulInt4WeightFp32(const float *a, const uint8_t *b, const float *scales, const float *mins,
+                          const float *a_sums, const float *bias, float *c, int act_type, int row, int deep, int col,
+                          int group_size, int start_oc, int end_oc) {
+  int deep_half = UP_DIV(deep, C2NUM);
+  int group_num = UP_DIV(deep, group_size);
+  // Every int4 value is dequantized once for 4 rows, and the weight is streamed once for them.
+  for (int r = 0; r < row; r += C4NUM) {
+    int rows = MSMIN(C4NUM, row - r);
+    const float *cur_a = a + r * deep;
+    const float *cur_a_sums = a_sums + r * group_num;
+    for (int n = start_oc; n < end_oc; ++n) {
+      const uint8_t *cur_b = b + n * deep_half;
+      const float *cur_scales = scales + n * group_num;
+      const float *cur_mins = mins + n * group_num;
+      float dst[C4NUM] = {0.0f, 0.0f, 0.0f, 0.0f};
+      for (int g = 0; g < group_num; ++g) {
+        int k = g * group_size;
+        float dots[C4NUM];
+        Int4WeightDot(cur_a + k, deep, rows, cur_b + k / C2NUM, MSMIN(group_size, deep - k), dots);
+        for (int i = 0; i < rows; ++i) {
+          dst[i] += cur_scales[g] * dots[i] + cur_mins[g] * cur_a_sums[i * group_num + g];
+        }
+      }
+      for (int i = 0; i < rows; ++i) {
+        float value = bias == NULL ? dst[i] : dst[i] + bias[n];
+        if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+          value = MSMAX(0.0f, value);
+        }
+        if (act_type == ActType_Relu6) {
+          value = MSMIN(6.0f, value);
+        }
+        c[(r + i) * col + n] = value;
+      }
+    }
+  }
+}
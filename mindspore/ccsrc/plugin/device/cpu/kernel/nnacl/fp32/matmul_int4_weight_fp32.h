@@ -0,0 +1,56 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_INT4_WEIGHT_FP32_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_INT4_WEIGHT_FP32_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nnacl/op_base.h"
+
+// The int4 weight is stored as [col, UP_DIV(deep, 2)] bytes, the low nibble of a byte is the even depth and the high
+// nibble is the odd one. Every group_size values along the depth of a column share one scale and one min, and the
+// weight is dequantized as q * scale + min, in which q is in [0, 15].
+#ifdef __cplusplus
+extern "C" {
+#endif
+// src is [col, deep] if deep_major is true, otherwise [deep, col]. group_size must be even.
+void QuantizeWeightToInt4Fp32(const float *src, uint8_t *dst, float *scales, float *mins, int deep, int col,
+                              int group_size, bool deep_major);
+
+// src is the weight quantized with at most 4 bits, whose value of column n is q * quant_scales[n] + quant_offsets[n].
+// The quantized values are stored as int4 directly rather than being dequantized and quantized again, so no error of
+// the second quantization is added. Return NNACL_ERR if the values of a group span more than the range of int4.
+// src is [col, deep] if deep_major is true, otherwise [deep, col]. group_size must be even.
+int PackQuantWeightToInt4Fp32(const int8_t *src, const float *quant_scales, const float *quant_offsets, uint8_t *dst,
+                              float *scales, float *mins, int deep, int col, int group_size, bool deep_major);
+
+// The sums of every group of a, which are multiplied by the mins of the weight.
+void Int4WeightGroupSumFp32(const float *a, float *a_sums, int row, int deep, int group_size);
+
+// c[row, col] = a[row, deep] * dequant(b)^T + bias, only the columns in [start_oc, end_oc) are computed.
+void MatmulInt4WeightFp32(const float *a, const uint8_t *b, const float *scales, const float *mins,
+                          const float *a_sums, const float *bias, float *c, int act_type, int row, int deep, int col,
+                          int group_size, int start_oc, int end_oc);
+
+#ifdef ENABLE_AVX512
+int Int4WeightDotAVX512(const float *a, int a_stride, int rows, const uint8_t *b, int len, float *dots);
+#endif
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_INT4_WEIGHT_FP32_H_
@@ -0,0 +1,218 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "nnacl/fp32/matmul_sparse_weight_fp32.h"
+#include <string.h>
+#ifdef ENABLE_AVX
+#include <x86intrin.h>
+#endif
+#ifdef ENABLE_NEON
+#include <arm_neon.h>
+#endif
+
+static inline float SparseWeightValue(const float *src, int k, int n, int deep, int col, bool deep_major) {
+  if (n >= col) {
+    return 0.0f;
+  }
+  return deep_major ? src[n * deep + k] : src[k * col + n];
+}
+
+int SparseWeightBlockNumFp32(const float *src, int deep, int col, bool deep_major, int *nnz) {
+  int block_num = 0;
+  int value_num = 0;
+  for (int n = 0; n < col; n += C8NUM) {
+    for (int k = 0; k < deep; ++k) {
+      int block_nnz = 0;
+      for (int i = 0; i < C8NUM; ++i) {
+        block_nnz += SparseWeightValue(src, k, n + i, deep, col, deep_major) != 0.0f ? 1 : 0;
+      }
+      block_num += block_nnz > 0 ? 1 : 0;
+      value_num += block_nnz;
+    }
+  }
+  if (nnz != NULL) {
+    *nnz = value_num;
+  }
+  return block_num;
+}
+
+void PackSparseWeightFp32(const float *src, float *values, int *depths, int *offsets, int deep, int col,
+                          bool deep_major) {
+  int block_num = 0;
+  for (int n = 0; n < col; n += C8NUM) {
+    offsets[n / C8NUM] = block_num;
+    for (int k = 0; k < deep; ++k) {
+      float block[C8NUM];
+      bool is_zero = true;
+      for (int i = 0; i < C8NUM; ++i) {
+        block[i] = SparseWeightValue(src, k, n + i, deep, col, deep_major);
+        is_zero = is_zero && block[i] == 0.0f;
+      }
+      if (is_zero) {
+        continue;
+      }
+      memcpy(values + block_num * C8NUM, block, sizeof(block));
+      depths[block_num] = k;
+      block_num++;
+    }
+  }
+  offsets[UP_DIV(col, C8NUM)] = block_num;
+}
+
+void UnpackSparseWeightFp32(const float *values, const int *depths, const int *offsets, float *dst, int deep, int col,
+                            bool deep_major) {
+  memset(dst, 0, (size_t)deep * col * sizeof(float));
+  for (int b = 0; b < UP_DIV(col, C8NUM); ++b) {
+    int n_start = b * C8NUM;
+    int n_num = MSMIN(C8NUM, col - n_start);
+    for (int j = offsets[b]; j < offsets[b + 1]; ++j) {
+      int k = depths[j];
+      for (int i = 0; i < n_num; ++i) {
+        int n = n_start + i;
+        dst[deep_major ? n * deep + k : k * col + n] = values[j * C8NUM + i];
+      }
+    }
+  }
+}
+
+// Multiply the blocks of 8 output channels with at most 8 rows of a, every block is loaded once for the rows.
+static void SparseWeightBlockDot(const float *a, int deep, int rows, const float *values, const int *depths,
+                                 int block_num, float dst[C8NUM][C8NUM]) {
+#if defined(ENABLE_AVX)
+  if (rows == C8NUM) {
+    // the accumulators are kept in registers when all the rows are full.
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps(), acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps(), acc4 = _mm256_setzero_ps(), acc5 = _mm256_setzero_ps();
+    __m256 acc6 = _mm256_setzero_ps(), acc7 = _mm256_setzero_ps();
+    for (int j = 0; j < block_num; ++j) {
+      __m256 w = _mm256_loadu_ps(values + j * C8NUM);
+      const float *src = a + depths[j];
+      acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(src), w, acc0);
+      acc1 = _mm256_fmadd_ps(_mm256_broadcast_ss(src + deep), w, acc1);
+      acc2 = _mm256_fmadd_ps(_mm256_broadcast_ss(src + C2NUM * deep), w, acc2);
+      acc3 = _mm256_fmadd_ps(_mm256_broadcast_ss(src + C3NUM * deep), w, acc3);
+      acc4 = _mm256_fmadd_ps(_mm256_broadcast_ss(src + C4NUM * deep), w, acc4);
+      acc5 = _mm256_fmadd_ps(_mm256_broadcast_ss(src + C5NUM * deep), w, acc5);
+      acc6 = _mm256_fmadd_ps(_mm256_broadcast_ss(src + C6NUM * deep), w, acc6);
+      acc7 = _mm256_fmadd_ps(_mm256_broadcast_ss(src + C7NUM * deep), w, acc7);
+    }
+    _mm256_storeu_ps(dst[0], acc0);
+    _mm256_storeu_ps(dst[1], acc1);
+    _mm256_storeu_ps(dst[C2NUM], acc2);
+    _mm256_storeu_ps(dst[C3NUM], acc3);
+    _mm256_storeu_ps(dst[C4NUM], acc4);
+    _mm256_storeu_ps(dst[C5NUM], acc5);
+    _mm256_storeu_ps(dst[C6NUM], acc6);
+    _mm256_storeu_ps(dst[C7NUM], acc7);
+    return;
+  }
+  for (int i = 0; i < rows; ++i) {
+    __m256 acc = _mm256_setzero_ps();
+    const float *src = a + i * deep;
+    for (int j = 0; j < block_num; ++j) {
+      acc = _mm256_fmadd_ps(_mm256_broadcast_ss(src + depths[j]), _mm256_loadu_ps(values + j * C8NUM), acc);
+    }
+    _mm256_storeu_ps(dst[i], acc);
+  }
+#elif defined(ENABLE_NEON)
+  int i = 0;
+  for (; i <= rows - C4NUM; i += C4NUM) {
+    const float *src = a + i * deep;
+    float32x4_t acc00 = vdupq_n_f32(0.0f), acc01 = vdupq_n_f32(0.0f), acc10 = vdupq_n_f32(0.0f);
+    float32x4_t acc11 = vdupq_n_f32(0.0f), acc20 = vdupq_n_f32(0.0f), acc21 = vdupq_n_f32(0.0f);
+    float32x4_t acc30 = vdupq_n_f32(0.0f), acc31 = vdupq_n_f32(0.0f);
+    for (int j = 0; j < block_num; ++j) {
+      float32x4_t w0 = vld1q_f32(values + j * C8NUM);
+      float32x4_t w1 = vld1q_f32(values + j * C8NUM + C4NUM);
+      const float *cur = src + depths[j];
+      float32x4_t value = vdupq_n_f32(cur[0]);
+      acc00 = vmlaq_f32(acc00, value, w0);
+      acc01 = vmlaq_f32(acc01, value, w1);
+      value = vdupq_n_f32(cur[deep]);
+      acc10 = vmlaq_f32(acc10, value, w0);
+      acc11 = vmlaq_f32(acc11, value, w1);
+      value = vdupq_n_f32(cur[C2NUM * deep]);
+      acc20 = vmlaq_f32(acc20, value, w0);
+      acc21 = vmlaq_f32(acc21, value, w1);
+      value = vdupq_n_f32(cur[C3NUM * deep]);
+      acc30 = vmlaq_f32(acc30, value, w0);
+      acc31 = vmlaq_f32(acc31, value, w1);
+    }
+    vst1q_f32(dst[i], acc00);
+    vst1q_f32(dst[i] + C4NUM, acc01);
+    vst1q_f32(dst[i + 1], acc10);
+    vst1q_f32(dst[i + 1] + C4NUM, acc11);
+    vst1q_f32(dst[i + C2NUM], acc20);
+    vst1q_f32(dst[i + C2NUM] + C4NUM, acc21);
+    vst1q_f32(dst[i + C3NUM], acc30);
+    vst1q_f32(dst[i + C3NUM] + C4NUM, acc31);
+  }
+  for (; i < rows; ++i) {
+    const float *src = a + i * deep;
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (int j = 0; j < block_num; ++j) {
+      float32x4_t value = vdupq_n_f32(src[depths[j]]);
+      acc0 = vmlaq_f32(acc0, value, vld1q_f32(values + j * C8NUM));
+      acc1 = vmlaq_f32(acc1, value, vld1q_f32(values + j * C8NUM + C4NUM));
+    }
+    vst1q_f32(dst[i], acc0);
+    vst1q_f32(dst[i] + C4NUM, acc1);
+  }
+#else
+  for (int i = 0; i < rows; ++i) {
+    memset(dst[i], 0, C8NUM * sizeof(float));
+  }
+  for (int j = 0; j < block_num; ++j) {
+    const float *w = values + j * C8NUM;
+    const float *src = a + depths[j];
+    for (int i = 0; i < rows; ++i) {
+      for (int n = 0; n < C8NUM; ++n) {
+        dst[i][n] += src[i * deep] * w[n];
+      }
+    }
+  }
+#endif
+}
+
+void MatmulSparseWeightFp32(const float *a, const float *values, const int *depths, const int *offsets,
+                            const float *bias, float *c, int act_type, int row, int deep, int col, int start_block,
+                            int end_block) {
+  for (int r = 0; r < row; r += C8NUM) {
+    int rows = MSMIN(C8NUM, row - r);
+    const float *cur_a = a + r * deep;
+    for (int b = start_block; b < end_block; ++b) {
+      float dst[C8NUM][C8NUM];
+      int offset = offsets[b];
+      SparseWeightBlockDot(cur_a, deep, rows, values + offset * C8NUM, depths + offset, offsets[b + 1] - offset, dst);
+      int n_start = b * C8NUM;
+      int n_num = MSMIN(C8NUM, col - n_start);
+      for (int i = 0; i < rows; ++i) {
+        float *cur_c = c + (r + i) * col + n_start;
+        for (int n = 0; n < n_num; ++n) {
+          float value = bias == NULL ? dst[i][n] : dst[i][n] + bias[n_start + n];
+          if (act_type == ActType_Relu || act_type == ActType_Relu6) {
+            value = MSMAX(0.0f, value);
+          }
+          if (act_type == ActType_Relu6) {
+            value = MSMIN(6.0f, value);
+          }
+          cur_c[n] = value;
+        }
+      }
+    }
+  }
+}
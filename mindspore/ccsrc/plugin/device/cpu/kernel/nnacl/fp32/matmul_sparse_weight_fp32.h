@@ -0,0 +1,58 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_NNACL_FP32_MATMUL_SPARSE_WEIGHT_FP32_H_
+#define MINDSPORE_NNACL_FP32_MATMUL_SPARSE_WEIGHT_FP32_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "nnacl/op_base.h"
+
+// The sparse weight is stored by blocks of 8 output channels at one depth, and only the blocks having a non-zero value
+// are kept. The blocks of the output channels [8 * i, 8 * i + 8) are values[offsets[i], offsets[i + 1]), each of them
+// is 8 floats, and depths[j] is the depth of the j-th block. The output channels beyond col are padded with zeros.
+// The sparse weight encoded in the model by the converter is the header followed by offsets, depths and values.
+typedef struct SparseWeightHeader {
+  int32_t deep_;
+  int32_t col_;
+  int32_t deep_major_;
+  int32_t block_num_;
+} SparseWeightHeader;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+// src is [col, deep] if deep_major is true, otherwise [deep, col]. Returns the number of the non-zero blocks, and the
+// number of the non-zero values is returned by nnz if it isn't NULL.
+int SparseWeightBlockNumFp32(const float *src, int deep, int col, bool deep_major, int *nnz);
+
+// offsets has UP_DIV(col, 8) + 1 values, values and depths are sized by SparseWeightBlockNumFp32.
+void PackSparseWeightFp32(const float *src, float *values, int *depths, int *offsets, int deep, int col,
+                          bool deep_major);
+
+// the reverse of PackSparseWeightFp32, the zero blocks of dst are filled.
+void UnpackSparseWeightFp32(const float *values, const int *depths, const int *offsets, float *dst, int deep, int col,
+                            bool deep_major);
+
+// c[row, col] = a[row, deep] * b + bias, only the output channels in [start_block * 8, end_block * 8) are computed.
+void MatmulSparseWeightFp32(const float *a, const float *values, const int *depths, const int *offsets,
+                            const float *bias, float *c, int act_type, int row, int deep, int col, int start_block,
+                            int end_block);
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // MINDSPORE_NNACL_FP32_MATMUL_SPARSE_WEIGHT_FP32_H_
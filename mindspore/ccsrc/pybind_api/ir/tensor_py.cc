@@ -30,6 +30,8 @@ namespace {
 struct TensorToNumpyRegister {
   TensorToNumpyRegister() { python_adapter::PyAdapterCallback::SetTensorToNumpyHandler(tensor::TensorPy::AsNumpy); }
 } callback_register;
+
+std::function<void()> sync_as_numpy_callback = nullptr;
 }  // namespace
 constexpr ssize_t kPyBufItemSize1 = 1;
 constexpr ssize_t kPyBufItemSize2 = 2;
@@ -366,7 +368,14 @@ void TensorPy::FlushFromCache(const Tensor &tensor) {
   }
 }
 
+void TensorPy::SetSyncAsNumpyCallback(const std::function<void()> &callback) { sync_as_numpy_callback = callback; }
+
 py::array TensorPy::SyncAsNumpy(const Tensor &tensor) {
+  // Copy the callback, which may remove itself.
+  auto callback = sync_as_numpy_callback;
+  if (callback != nullptr) {
+    callback();
+  }
   {
     py::gil_scoped_release gil_release;
     if (tensor.NeedWait()) {
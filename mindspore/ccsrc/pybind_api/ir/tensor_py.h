@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_CCSRC_UTILS_TENSOR_PY_H_
 #define MINDSPORE_CCSRC_UTILS_TENSOR_PY_H_
 
+#include <functional>
 #include <memory>
 #include <string>
 #include <vector>
@@ -107,6 +108,9 @@ class TensorPy {
 
   static py::array SyncAsNumpy(const Tensor &tensor);
 
+  // brief Set the callback run before the data of a tensor is synchronized to numpy, nullptr to remove it.
+  static void SetSyncAsNumpyCallback(const std::function<void()> &callback);
+
   static py::array AsNumpy(const Tensor &tensor);
 
   static py::tuple GetPyTupleShape(const Tensor &tensor);
@@ -73,6 +73,7 @@ void *AutoMemoryOffload::Get(const void *key, void *stream, const HashSet<const
   if (stream == nullptr) {
     return nullptr;
   }
+  PrepareHostPtrFromFile(key);
   void *host_ptr = nullptr;
   bool from_init = false;
   GetHostPtr(key, &host_ptr, &from_init);
@@ -85,6 +86,7 @@ void *AutoMemoryOffload::Get(const void *key, void *stream, const HashSet<const
     return nullptr;
   }
   mem_handler_->SwapIn(host_ptr, device_ptr, mem_size, stream);
+  statistics_.swap_in_size += mem_size;
   if (!from_init) {
     (void)swap_host_ptr_.erase(key);
     mem_handler_->FreeHost(host_ptr);
@@ -220,6 +222,7 @@ void *AutoMemoryOffload::SwapOut(const void *key, void *stream) {
   auto updated_iter = from_init ? updated_device_mem_.find(key) : updated_device_mem_.end();
   if (!from_init || updated_iter != updated_device_mem_.end()) {
     mem_handler_->SwapOut(device_ptr, host_ptr, mem_size, stream);
+    statistics_.swap_out_size += mem_size;
     if (updated_iter != updated_device_mem_.end()) {
       (void)updated_device_mem_.erase(updated_iter);
     }
@@ -233,11 +236,13 @@ void *AutoMemoryOffload::SwapIn(const void *key, void *stream) {
   if (iter == mem_result_.end()) {
     MS_LOG(EXCEPTION) << "Can not find device ptr for key " << key;
   }
+  PrepareHostPtrFromFile(key);
   bool from_init = true;
   void *host_ptr = nullptr;
   GetHostPtr(key, &host_ptr, &from_init);
   MS_EXCEPTION_IF_NULL(host_ptr);
   mem_handler_->SwapIn(host_ptr, iter->second, mem_size, stream);
+  statistics_.swap_in_size += mem_size;
   if (!from_init) {
     mem_handler_->FreeHost(host_ptr);
     (void)swap_host_ptr_.erase(key);
@@ -245,6 +250,68 @@ void *AutoMemoryOffload::SwapIn(const void *key, void *stream) {
   return iter->second;
 }
 
+void AutoMemoryOffload::FileWrite(const void *key) {
+  if (file_offload_ == nullptr) {
+    return;
+  }
+  const auto &iter = swap_host_ptr_.find(key);
+  if (iter == swap_host_ptr_.end() || iter->second == nullptr) {
+    return;
+  }
+  const auto mem_size = GetMemSize(key);
+  file_offload_->AsyncWrite(key, iter->second, mem_size);
+  statistics_.file_write_size += mem_size;
+  file_writing_host_ptr_[key] = iter->second;
+  (void)swap_host_ptr_.erase(iter);
+}
+
+void AutoMemoryOffload::ReleaseFileWrittenHostMem() {
+  if (file_offload_ == nullptr) {
+    return;
+  }
+  for (auto iter = file_writing_host_ptr_.begin(); iter != file_writing_host_ptr_.end();) {
+    if (!file_offload_->IsFinished(iter->first)) {
+      ++iter;
+      continue;
+    }
+    mem_handler_->FreeHost(iter->second);
+    (void)file_keys_.insert(iter->first);
+    iter = file_writing_host_ptr_.erase(iter);
+  }
+}
+
+void AutoMemoryOffload::FileRead(const void *key) {
+  if (file_offload_ == nullptr) {
+    return;
+  }
+  // The write is not finished yet, the host memory has not been released and is still valid.
+  const auto &writing_iter = file_writing_host_ptr_.find(key);
+  if (writing_iter != file_writing_host_ptr_.end()) {
+    swap_host_ptr_[key] = writing_iter->second;
+    (void)file_writing_host_ptr_.erase(writing_iter);
+    return;
+  }
+  if (file_keys_.count(key) == 0) {
+    return;
+  }
+  const auto mem_size = GetMemSize(key);
+  auto host_ptr = mem_handler_->MallocHost(mem_size);
+  file_offload_->AsyncRead(key, host_ptr, mem_size);
+  statistics_.file_read_size += mem_size;
+  swap_host_ptr_[key] = host_ptr;
+  (void)file_keys_.erase(key);
+}
+
+void AutoMemoryOffload::PrepareHostPtrFromFile(const void *key) {
+  if (file_offload_ == nullptr) {
+    return;
+  }
+  if (swap_host_ptr_.count(key) == 0) {
+    FileRead(key);
+  }
+  statistics_.file_stall_time += file_offload_->Wait(key);
+}
+
 size_t AutoMemoryOffload::GetMemSize(const void *key) {
   const auto &iter = mem_size_.find(key);
   if (iter == mem_size_.end()) {
@@ -259,6 +326,17 @@ void AutoMemoryOffload::GetOrMallocHostPtr(const void *key, size_t mem_size, voi
   if (*host_ptr != nullptr) {
     return;
   }
+  // The data in the file or being written to the file is out of date as the key is swapped out again.
+  (void)file_keys_.erase(key);
+  const auto &writing_iter = file_writing_host_ptr_.find(key);
+  if (writing_iter != file_writing_host_ptr_.end()) {
+    (void)file_offload_->Wait(key);
+    *host_ptr = writing_iter->second;
+    *from_init = false;
+    swap_host_ptr_[key] = *host_ptr;
+    (void)file_writing_host_ptr_.erase(writing_iter);
+    return;
+  }
   *host_ptr = mem_handler_->MallocHost(mem_size);
   *from_init = false;
   swap_host_ptr_[key] = *host_ptr;
@@ -295,6 +373,14 @@ void AutoMemoryOffload::Clear() {
     }
   }
   swap_host_ptr_.clear();
+  if (file_offload_ != nullptr) {
+    file_offload_->WaitAll();
+  }
+  for (const auto &item : file_writing_host_ptr_) {
+    mem_handler_->FreeHost(item.second);
+  }
+  file_writing_host_ptr_.clear();
+  file_keys_.clear();
   init_host_ptr_.clear();
   init_from_host_keys_.clear();
 }
@@ -23,6 +23,7 @@
 #include <memory>
 
 #include "runtime/device/memory_manager.h"
+#include "runtime/device/file_memory_offload.h"
 #include "utils/hash_map.h"
 #include "utils/hash_set.h"
 
@@ -53,6 +54,15 @@ class MemHandler {
   std::map<void *, std::shared_ptr<std::vector<uint8_t>>> host_mem_block_map_;
 };
 
+// The traffic between the memory tiers and the time waiting for the file tier, in bytes and microseconds.
+struct MemOffloadStatistics {
+  size_t swap_in_size{0};
+  size_t swap_out_size{0};
+  size_t file_write_size{0};
+  size_t file_read_size{0};
+  double file_stall_time{0};
+};
+
 class AutoMemoryOffload {
  public:
   explicit AutoMemoryOffload(std::shared_ptr<MemHandler> mem_handler) : mem_handler_(std::move(mem_handler)) {}
@@ -71,7 +81,18 @@ class AutoMemoryOffload {
   // Return the device ptr where the data is copied to
   void *SwapIn(const void *key, void *stream);
 
+  void SetFileOffload(const std::shared_ptr<FileMemoryOffload> &file_offload) { file_offload_ = file_offload; }
+  // Move the host memory swapped out of the key to its file, the host memory is released when the write is finished.
+  void FileWrite(const void *key);
+  // Read the data of the key back from its file to the host memory before it is swapped in.
+  void FileRead(const void *key);
+  // Release the host memory whose data has been written to the files.
+  void ReleaseFileWrittenHostMem();
+  const MemOffloadStatistics &statistics() const { return statistics_; }
+  void ResetStatistics() { statistics_ = MemOffloadStatistics(); }
+
  private:
+  void PrepareHostPtrFromFile(const void *key);
   size_t GetMemSize(const void *key);
   void GetHostPtr(const void *key, void **host_ptr, bool *from_init);
   void GetOrMallocHostPtr(const void *key, size_t mem_size, void **host_ptr, bool *from_init);
@@ -83,6 +104,10 @@ class AutoMemoryOffload {
   HashSet<const void *> continuous_mem_key_;
   HashMap<const void *, void *> init_host_ptr_;
   HashMap<const void *, void *> swap_host_ptr_;
+  std::shared_ptr<FileMemoryOffload> file_offload_{nullptr};
+  HashMap<const void *, void *> file_writing_host_ptr_;
+  HashSet<const void *> file_keys_;
+  MemOffloadStatistics statistics_;
 };
 }  // namespace device
 }  // namespace mindspore
@@ -0,0 +1,164 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/device/file_memory_offload.h"
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+#include <chrono>
+#ifdef _MSC_VER
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include "utils/file_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace device {
+namespace {
+int GetProcessId() {
+#ifdef _MSC_VER
+  return _getpid();
+#else
+  return static_cast<int>(getpid());
+#endif
+}
+}  // namespace
+
+FileMemoryOffload::FileMemoryOffload(const std::string &file_dir) {
+  const auto &real_dir = FileUtils::CreateNotExistDirs(file_dir, true);
+  if (!real_dir.has_value()) {
+    MS_LOG(EXCEPTION) << "Create the memory offload directory " << file_dir << " failed.";
+  }
+  file_dir_ = real_dir.value();
+  file_prefix_ = file_dir_ + "/mem_offload_" + std::to_string(GetProcessId()) + "_" +
+                 std::to_string(reinterpret_cast<uintptr_t>(this)) + "_";
+  io_thread_ = std::thread(&FileMemoryOffload::Run, this);
+}
+
+FileMemoryOffload::~FileMemoryOffload() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  task_cond_.notify_all();
+  if (io_thread_.joinable()) {
+    io_thread_.join();
+  }
+  for (const auto &item : file_paths_) {
+    (void)std::remove(item.second.c_str());
+  }
+}
+
+std::string FileMemoryOffload::GetFilePath(const void *key) {
+  const auto &iter = file_paths_.find(key);
+  if (iter != file_paths_.end()) {
+    return iter->second;
+  }
+  const auto &path = file_prefix_ + std::to_string(file_paths_.size());
+  file_paths_[key] = path;
+  return path;
+}
+
+void FileMemoryOffload::AsyncWrite(const void *key, const void *host_ptr, size_t mem_size) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push({key, const_cast<void *>(host_ptr), mem_size, true});
+    ++pending_io_num_[key];
+  }
+  task_cond_.notify_one();
+}
+
+void FileMemoryOffload::AsyncRead(const void *key, void *host_ptr, size_t mem_size) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.push({key, host_ptr, mem_size, false});
+    ++pending_io_num_[key];
+  }
+  task_cond_.notify_one();
+}
+
+bool FileMemoryOffload::IsFinished(const void *key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const auto &iter = pending_io_num_.find(key);
+  return iter == pending_io_num_.end() || iter->second == 0;
+}
+
+double FileMemoryOffload::Wait(const void *key) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const auto &iter = pending_io_num_.find(key);
+  if ((iter == pending_io_num_.end() || iter->second == 0) && !io_failed_) {
+    return 0;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  finish_cond_.wait(lock, [this, key]() { return io_failed_ || pending_io_num_[key] == 0; });
+  if (io_failed_) {
+    MS_LOG(EXCEPTION) << "Memory offload file io failed, please check the space of the directory " << file_dir_;
+  }
+  return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+void FileMemoryOffload::WaitAll() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  finish_cond_.wait(lock, [this]() {
+    return io_failed_ ||
+           std::all_of(pending_io_num_.begin(), pending_io_num_.end(), [](const auto &item) { return item.second == 0; });
+  });
+}
+
+// The file paths are only accessed by the io thread.
+bool FileMemoryOffload::DoIo(const IoTask &task) {
+  const auto &path = GetFilePath(task.key_);
+  auto file = std::fopen(path.c_str(), task.is_write_ ? "wb" : "rb");
+  if (file == nullptr) {
+    MS_LOG(ERROR) << "Open memory offload file " << path << " failed.";
+    return false;
+  }
+  const auto size = task.is_write_ ? std::fwrite(task.host_ptr_, 1, task.mem_size_, file)
+                                   : std::fread(task.host_ptr_, 1, task.mem_size_, file);
+  (void)std::fclose(file);
+  if (size != task.mem_size_) {
+    MS_LOG(ERROR) << (task.is_write_ ? "Write " : "Read ") << task.mem_size_ << " bytes of memory offload file "
+                  << path << " failed, only " << size << " bytes are done.";
+    return false;
+  }
+  return true;
+}
+
+void FileMemoryOffload::Run() {
+  while (true) {
+    IoTask task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      task_cond_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      if (tasks_.empty()) {
+        return;
+      }
+      task = tasks_.front();
+      tasks_.pop();
+    }
+    const bool success = DoIo(task);
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      --pending_io_num_[task.key_];
+      io_failed_ = io_failed_ || !success;
+    }
+    finish_cond_.notify_all();
+  }
+}
+}  // namespace device
+}  // namespace mindspore
@@ -0,0 +1,75 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_DEVICE_FILE_MEMORY_OFFLOAD_H_
+#define MINDSPORE_CCSRC_RUNTIME_DEVICE_FILE_MEMORY_OFFLOAD_H_
+
+#include <string>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "utils/hash_map.h"
+
+namespace mindspore {
+namespace device {
+// The file tier of the memory offload, which keeps the data swapped out to host memory in files, e.g. on a local
+// NVMe disk, when the host memory is not enough. The files are written and read by a background thread, so that
+// the host memory can be released behind the write and filled ahead of the swap in, while the kernels are running.
+class FileMemoryOffload {
+ public:
+  explicit FileMemoryOffload(const std::string &file_dir);
+  ~FileMemoryOffload();
+
+  // Start to write the data of the host memory to the file of the key, the host memory must be kept until the write
+  // is finished.
+  void AsyncWrite(const void *key, const void *host_ptr, size_t mem_size);
+  // Start to read the data of the key from its file to the host memory.
+  void AsyncRead(const void *key, void *host_ptr, size_t mem_size);
+  // Whether all the io of the key are finished.
+  bool IsFinished(const void *key);
+  // Wait for all the io of the key and return the waiting time in microseconds.
+  double Wait(const void *key);
+  void WaitAll();
+
+ private:
+  struct IoTask {
+    const void *key_;
+    void *host_ptr_;
+    size_t mem_size_;
+    bool is_write_;
+  };
+
+  void Run();
+  bool DoIo(const IoTask &task);
+  std::string GetFilePath(const void *key);
+
+  std::string file_dir_;
+  std::string file_prefix_;
+  std::mutex mutex_;
+  std::condition_variable task_cond_;
+  std::condition_variable finish_cond_;
+  std::queue<IoTask> tasks_;
+  HashMap<const void *, size_t> pending_io_num_;
+  HashMap<const void *, std::string> file_paths_;
+  bool io_failed_{false};
+  bool stop_{false};
+  std::thread io_thread_;
+};
+}  // namespace device
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_DEVICE_FILE_MEMORY_OFFLOAD_H_
@@ -50,6 +50,31 @@ namespace mindspore {
 namespace device {
 constexpr size_t kAtomicCleanInputSize = 2;
 namespace {
+constexpr size_t kMBToByte = 1024 << 10;
+constexpr char kMemOffloadPathEnv[] = "MS_DEV_MEM_OFFLOAD_PATH";
+constexpr char kMemOffloadHostSizeEnv[] = "MS_DEV_MEM_OFFLOAD_HOST_SIZE";
+
+// The file tier of the memory scheduler is enabled by MS_DEV_MEM_OFFLOAD_PATH, and the host memory used for the
+// swapped out memory is limited by MS_DEV_MEM_OFFLOAD_HOST_SIZE in MB.
+void SetMemSchedulerFileOffload(const std::shared_ptr<MemScheduler> &mem_scheduler) {
+  const auto &file_dir = common::GetEnv(kMemOffloadPathEnv);
+  if (file_dir.empty()) {
+    return;
+  }
+  const auto &host_size_str = common::GetEnv(kMemOffloadHostSizeEnv);
+  size_t host_mem_size = 0;
+  if (!host_size_str.empty()) {
+    try {
+      host_mem_size = std::stoul(host_size_str) * kMBToByte;
+    } catch (const std::exception &e) {
+      MS_LOG(EXCEPTION) << "The value of " << kMemOffloadHostSizeEnv << " should be an integer in MB, but got "
+                        << host_size_str;
+    }
+  }
+  MS_LOG(INFO) << "Memory offload file dir: " << file_dir << ", host mem size: " << host_mem_size;
+  mem_scheduler->SetFileOffload(file_dir, host_mem_size);
+}
+
 std::vector<AnfNodePtr> GetGraphInputs(const session::KernelGraph &graph) {
   auto graph_inputs = graph.inputs();
   std::vector<AnfNodePtr> result(graph_inputs.begin(), graph_inputs.end());
@@ -1830,6 +1855,7 @@ void KernelRuntime::UseMemSchedulerIfNeeded(const session::KernelGraph &graph) {
     return;
   }
   mem_scheduler->SetMemHandler(std::make_shared<MemHandler>(mem_manager_));
+  SetMemSchedulerFileOffload(mem_scheduler);
   mem_scheduler->SetTotalStep(graph.execution_order().size());
 
   if (mem_scheduler->need_record_event()) {
@@ -19,12 +19,18 @@
 #include <memory>
 #include <utility>
 #include <algorithm>
+#include <numeric>
 #include "utils/log_adapter.h"
 
 namespace mindspore {
 namespace device {
 constexpr size_t kFirstGetMemEventIndex = 1;
 constexpr size_t kInitOrMallocMemEventIndex = 0;
+// Used to estimate the file io time when the compute time is measured, about 1GB/s.
+constexpr double kFileBytesPerMicrosecond = 1000;
+// Used when the compute time is not measured yet.
+constexpr size_t kDefaultFileWriteBehindSteps = 1;
+constexpr size_t kDefaultFileReadAheadSteps = 2;
 
 MemEventPtrList &MemOffloadStrategy::GetPreComputeEvents(size_t step) {
   if (pre_compute_events_.size() <= step) {
@@ -47,6 +53,7 @@ void MemOffloadStrategy::Execute() {
   if (need_swap_) {
     GenEventSpan();
     GenSwapEventSet();
+    GenFileEventSet();
   } else {
     GenContinuousMemAllocSteps();
   }
@@ -185,6 +192,113 @@ void MemOffloadStrategy::GenSwapEventSet() {
   }
 }
 
+void MemOffloadStrategy::GenFileEventSet() {
+  file_events_.clear();
+  if (host_mem_size_ == 0 || swap_events_.empty()) {
+    return;
+  }
+  // The host memory is held from the swap out to the swap in. Only the memory malloced in the graph, such as the
+  // optimizer states and the activations, owns its host memory, the one initialized from host keeps its host data.
+  struct HostMemSpan {
+    MemEventPtr event;
+    size_t swap_out_index;
+    size_t mem_size;
+    double idle_time;
+  };
+  std::vector<HostMemSpan> spans;
+  std::vector<size_t> host_mem_used(total_step_, 0);
+  for (const auto &item : mem_events_) {
+    const auto &mem_events = item.second;
+    if (mem_events.size() <= 1 || IsHighPriorityMem(item.first) ||
+        mem_events[kInitOrMallocMemEventIndex]->type != kMalloc) {
+      continue;
+    }
+    const auto mem_size = mem_events[kInitOrMallocMemEventIndex]->mem_size;
+    for (size_t i = kFirstGetMemEventIndex; i < mem_events.size(); ++i) {
+      const auto &event = mem_events[i];
+      const auto swap_out_index = mem_events[i - 1]->index;
+      if (swap_events_.count(event) == 0 || swap_out_index >= event->index) {
+        continue;
+      }
+      double idle_time = static_cast<double>(event->index - swap_out_index);
+      if (compute_time_.size() == total_step_) {
+        idle_time = std::accumulate(compute_time_.begin() + swap_out_index + 1, compute_time_.begin() + event->index,
+                                    0.0);
+      }
+      spans.push_back({event, swap_out_index, mem_size, idle_time});
+      for (size_t step = swap_out_index; step <= event->index; ++step) {
+        host_mem_used[step] += mem_size;
+      }
+    }
+  }
+  if (*std::max_element(host_mem_used.begin(), host_mem_used.end()) <= host_mem_size_) {
+    return;
+  }
+  // Move the memory idle for the longest time to the files first, which hides the file io best.
+  std::sort(spans.begin(), spans.end(),
+            [](const HostMemSpan &l, const HostMemSpan &r) { return l.idle_time > r.idle_time; });
+  for (const auto &span : spans) {
+    const auto write_end_index = GetWriteBehindIndex(span.swap_out_index, span.mem_size);
+    const auto read_index = GetReadAheadIndex(span.event->index, span.mem_size);
+    if (write_end_index + 1 >= read_index) {
+      continue;
+    }
+    bool out_of_host_mem = false;
+    for (size_t step = write_end_index + 1; step < read_index; ++step) {
+      out_of_host_mem = out_of_host_mem || host_mem_used[step] > host_mem_size_;
+    }
+    if (!out_of_host_mem) {
+      continue;
+    }
+    for (size_t step = write_end_index + 1; step < read_index; ++step) {
+      host_mem_used[step] -= span.mem_size;
+    }
+    (void)file_events_.emplace(span.event, read_index);
+  }
+  const auto max_host_mem_used = *std::max_element(host_mem_used.begin(), host_mem_used.end());
+  MS_LOG(INFO) << "Move " << file_events_.size() << " swapped out memory to files, host mem size: " << host_mem_size_
+               << ", host mem used: " << max_host_mem_used;
+  if (max_host_mem_used > host_mem_size_) {
+    MS_LOG(WARNING) << "The host memory used by the memory offload " << max_host_mem_used
+                    << " is still more than the host mem size " << host_mem_size_
+                    << ", as the file io can not be hidden by the compute.";
+  }
+}
+
+size_t MemOffloadStrategy::GetWriteBehindIndex(size_t swap_out_index, size_t mem_size) const {
+  if (compute_time_.size() != total_step_) {
+    return swap_out_index + kDefaultFileWriteBehindSteps;
+  }
+  const double io_time = static_cast<double>(mem_size) / kFileBytesPerMicrosecond;
+  double compute_time = 0;
+  size_t index = swap_out_index + 1;
+  while (index + 1 < total_step_) {
+    compute_time += compute_time_[index];
+    if (compute_time >= io_time) {
+      break;
+    }
+    ++index;
+  }
+  return index;
+}
+
+size_t MemOffloadStrategy::GetReadAheadIndex(size_t swap_in_index, size_t mem_size) const {
+  if (compute_time_.size() != total_step_) {
+    return swap_in_index > kDefaultFileReadAheadSteps ? swap_in_index - kDefaultFileReadAheadSteps : 0;
+  }
+  const double io_time = static_cast<double>(mem_size) / kFileBytesPerMicrosecond;
+  double compute_time = 0;
+  size_t index = swap_in_index;
+  while (index > 0) {
+    --index;
+    compute_time += compute_time_[index];
+    if (compute_time >= io_time) {
+      break;
+    }
+  }
+  return index;
+}
+
 void MemOffloadStrategy::AddToSwapEventSetIfOutOfMem(const std::shared_ptr<MemEvent> &event, size_t span,
                                                      std::vector<size_t> *mem_used) {
   const auto start_index = (GetPreMemEventIndex(event->index, span) + 1) % total_step_;
@@ -354,6 +468,17 @@ void MemOffloadStrategy::GenComputeMemEvents() {
         swap_out_event->key = item.first;
         swap_out_event->mem_size = first_event->mem_size;
         (void)post_compute_events_[pre_index].emplace_back(swap_out_event);
+        const auto &file_iter = file_events_.find(event);
+        if (file_iter != file_events_.end()) {
+          auto file_write_event = std::make_shared<MemEvent>(kFileWrite, pre_index);
+          file_write_event->key = item.first;
+          file_write_event->mem_size = first_event->mem_size;
+          (void)post_compute_events_[pre_index].emplace_back(file_write_event);
+          auto file_read_event = std::make_shared<MemEvent>(kFileRead, file_iter->second);
+          file_read_event->key = item.first;
+          file_read_event->mem_size = first_event->mem_size;
+          (void)pre_compute_events_[file_iter->second].emplace_back(file_read_event);
+        }
         // avoid swap-in-event follow init-event
         if (i != kFirstGetMemEventIndex || first_event->type != kInit) {
           auto swap_in_event = std::make_shared<MemEvent>(kSwapIn, event->index);
@@ -27,7 +27,7 @@ namespace mindspore {
 namespace device {
 enum MemPriority { kMemPriorityLow, kMemPriorityHigh };
 
-enum MemEventType { kInit, kMalloc, kGet, kFree, kSwapIn, kSwapOut };
+enum MemEventType { kInit, kMalloc, kGet, kFree, kSwapIn, kSwapOut, kFileWrite, kFileRead };
 
 struct MemEvent {
   MemEvent(const MemEventType &in_type, size_t in_index) : type(in_type), index(in_index) {}
@@ -113,6 +113,9 @@ class MemOffloadStrategy {
 
   void set_mem_size(size_t mem_size) { mem_size_ = mem_size; }
 
+  // The host memory size for the swapped out memory, the rest is moved to the file tier. 0 means unlimited.
+  void set_host_mem_size(size_t host_mem_size) { host_mem_size_ = host_mem_size; }
+
   bool need_swap() const { return need_swap_; }
 
  private:
@@ -126,6 +129,12 @@ class MemOffloadStrategy {
 
   void GenSwapEventSet();
 
+  void GenFileEventSet();
+
+  size_t GetWriteBehindIndex(size_t swap_out_index, size_t mem_size) const;
+
+  size_t GetReadAheadIndex(size_t swap_in_index, size_t mem_size) const;
+
   void GenComputeMemEvents();
 
   void GenFreeEvent(const MemEventPtr &last_event);
@@ -167,6 +176,9 @@ class MemOffloadStrategy {
   std::multimap<size_t, std::pair<MemEventPtr, size_t>> event_span_;
   std::multimap<size_t, std::pair<MemEventPtr, size_t>> continuous_input_event_span_;
   std::set<MemEventPtr> swap_events_;
+  size_t host_mem_size_{0};
+  // The swap events whose host memory is moved to the file tier, and the step to read it back.
+  std::map<MemEventPtr, size_t> file_events_;
   std::vector<size_t> min_mem_used_;
   size_t mem_used_without_swap_{0};
   size_t min_mem_needed_{0};
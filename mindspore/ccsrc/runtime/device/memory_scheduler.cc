@@ -53,6 +53,14 @@ void MemScheduler::AddContinuousMemInfo(bool is_input, size_t compute_index, siz
                                                     address_key_list);
 }
 
+void MemScheduler::SetFileOffload(const std::string &file_dir, size_t host_mem_size) {
+  file_offload_ = std::make_shared<FileMemoryOffload>(file_dir);
+  host_mem_size_ = host_mem_size;
+  if (auto_mem_offload_ != nullptr) {
+    auto_mem_offload_->SetFileOffload(file_offload_);
+  }
+}
+
 void MemScheduler::Record(const void *key, const MemEventType &event_type, size_t mem_size) {
   if (key == nullptr) {
     return;
@@ -166,6 +174,9 @@ bool MemScheduler::PreCompute(void *stream) {
     return true;
   }
   MS_EXCEPTION_IF_NULL(mem_handler_);
+  if (optimized_) {
+    auto_mem_offload_->ReleaseFileWrittenHostMem();
+  }
   auto &events = strategy_->GetPreComputeEvents(current_step_);
   for (auto &event : events) {
     MS_EXCEPTION_IF_NULL(event);
@@ -181,6 +192,8 @@ bool MemScheduler::PreCompute(void *stream) {
       ret = PreComputeSwapIn(event, stream);
     } else if (event->type == kGet) {
       ret = PreComputeGet(event, stream);
+    } else if (event->type == kFileRead) {
+      auto_mem_offload_->FileRead(event->key);
     }
     if (!ret) {
       cur_step_allocated_continuous_mem_.clear();
@@ -208,10 +221,25 @@ bool MemScheduler::PostCompute(void *stream) {
     MS_LOG(DEBUG) << "Post compute " << current_step_ << ": " << event->key << " v " << event->type;
     if (event->type == kSwapOut && optimized_) {
       auto_mem_offload_->SwapOut(event->key, stream);
+    } else if (event->type == kFileWrite && optimized_) {
+      auto_mem_offload_->FileWrite(event->key);
     }
     auto_mem_offload_->Free(event->key);
   }
   ++current_step_;
+  if (optimized_ && current_step_ == total_step_) {
+    const auto &statistics = auto_mem_offload_->statistics();
+    MS_LOG(INFO) << "Memory offload traffic of the step, swap in: " << statistics.swap_in_size
+                 << ", swap out: " << statistics.swap_out_size << ", file write: " << statistics.file_write_size
+                 << ", file read: " << statistics.file_read_size
+                 << ", file stall time(us): " << statistics.file_stall_time;
+    statistics_.swap_in_size += statistics.swap_in_size;
+    statistics_.swap_out_size += statistics.swap_out_size;
+    statistics_.file_write_size += statistics.file_write_size;
+    statistics_.file_read_size += statistics.file_read_size;
+    statistics_.file_stall_time += statistics.file_stall_time;
+    auto_mem_offload_->ResetStatistics();
+  }
   return true;
 }
 
@@ -231,6 +259,7 @@ void MemScheduler::OptMemUsage(float mem_used_factor) {
   auto available_mem_size = mem_handler_->GetAvailableMemSize();
   available_mem_size = FloatToSize(available_mem_size * mem_used_factor);
   strategy_->set_mem_size(available_mem_size);
+  strategy_->set_host_mem_size(file_offload_ == nullptr ? 0 : host_mem_size_);
   strategy_->Execute();
 }
 
@@ -22,6 +22,7 @@
 #include <memory>
 #include <queue>
 #include <utility>
+#include <string>
 #include "runtime/device/memory_offload_strategy.h"
 #include "runtime/device/auto_mem_offload.h"
 
@@ -43,8 +44,15 @@ class MemScheduler {
   void SetMemHandler(const std::shared_ptr<MemHandler> &handler) {
     mem_handler_ = handler;
     auto_mem_offload_ = std::make_shared<AutoMemoryOffload>(handler);
+    auto_mem_offload_->SetFileOffload(file_offload_);
   }
 
+  // Move the swapped out memory beyond the host mem size to the files in the directory.
+  void SetFileOffload(const std::string &file_dir, size_t host_mem_size);
+
+  // The memory offload traffic accumulated over the finished steps.
+  const MemOffloadStatistics &statistics() const { return statistics_; }
+
   void Init(const void *key, void *host_ptr, size_t mem_size, MemPriority priority = kMemPriorityLow);
 
   void *GetOrMalloc(const void *key, size_t mem_size, MemPriority priority = kMemPriorityLow);
@@ -121,6 +129,9 @@ class MemScheduler {
   double compute_start_time_{0};
 
   std::shared_ptr<AutoMemoryOffload> auto_mem_offload_;
+  std::shared_ptr<FileMemoryOffload> file_offload_{nullptr};
+  size_t host_mem_size_{0};
+  MemOffloadStatistics statistics_;
   std::shared_ptr<MemHandler> mem_handler_{nullptr};
   std::shared_ptr<MemOffloadStrategy> strategy_{nullptr};
 };
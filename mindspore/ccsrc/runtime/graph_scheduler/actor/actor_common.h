@@ -50,14 +50,16 @@ constexpr int kSuccess = 0;
 constexpr int kFailure = 1;
 
 enum class GraphExecutionStrategy {
-  kPipeline,                   // The actor running is triggered only by data.
-  kStep,                       // The actor running need be triggered by control in addition.
-  kPipelineWithExecutionOrder  // The actor running is triggered by data with the persistent execution order.
+  kPipeline,                    // The actor running is triggered only by data.
+  kStep,                        // The actor running need be triggered by control in addition.
+  kPipelineWithExecutionOrder,  // The actor running is triggered by data with the persistent execution order.
+  kStaticSchedule               // The kernels of the CPU graphs run in a precomputed schedule without kernel actors.
 };
 static const std::map<GraphExecutionStrategy, std::string> kGraphExecutionStrategyStr = {
   {GraphExecutionStrategy::kPipeline, "pipeline"},
   {GraphExecutionStrategy::kStep, "step"},
   {GraphExecutionStrategy::kPipelineWithExecutionOrder, "pipeline_with_execution_order"},
+  {GraphExecutionStrategy::kStaticSchedule, "static_schedule"},
 };
 
 const char kDataPrepareActorNameSuffix[] = "_DataPrepareActor";
@@ -51,6 +51,13 @@ void SuperKernelActor::Init() {
     auto device_address = AnfAlgo::GetMutableOutputAddr(output_node, data_arrow->from_output_index_, false);
     data->data_ = device_address.get();
   }
+
+  // Compile the static schedule which replaces the graph executor.
+  MS_EXCEPTION_IF_NULL(device_contexts_[0]);
+  if (device_contexts_[0]->graph_executor_ == nullptr) {
+    static_schedule_executor_ = std::make_unique<StaticScheduleExecutor>(graph_, device_contexts_[0]);
+    static_schedule_executor_->Compile();
+  }
 }
 
 size_t SuperKernelActor::FetchInputNodePosition(const AnfNodePtr &intput_node) {
@@ -81,7 +88,9 @@ void SuperKernelActor::Run(OpContext<DeviceTensor> *const context) {
     const std::vector<tensor::Tensor> inputs;
     std::vector<tensor::Tensor> outputs;
     const std::map<string, string> compile_options;
-    auto ret = device_contexts_[0]->graph_executor_->RunGraph(graph_, inputs, &outputs, compile_options);
+    auto ret = (static_schedule_executor_ != nullptr)
+                 ? static_schedule_executor_->Run()
+                 : device_contexts_[0]->graph_executor_->RunGraph(graph_, inputs, &outputs, compile_options);
     if (!ret) {
       std::string error_info = "Launch graph failed, graph id: " + std::to_string(graph_->graph_id());
       SET_OPCONTEXT_FAIL_RET_WITH_ERROR((*context), error_info);
@@ -25,6 +25,7 @@
 #include <queue>
 #include "runtime/graph_scheduler/actor/debug_aware_actor.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
+#include "runtime/graph_scheduler/static_schedule_executor.h"
 #include "runtime/hardware/device_context.h"
 #include "ir/anf.h"
 
@@ -65,6 +66,9 @@ class SuperKernelActor : public DebugAwareActor {
 
   KernelGraphPtr graph_;
 
+  // The graph is launched by the static schedule executor if the device has no graph executor.
+  StaticScheduleExecutorPtr static_schedule_executor_;
+
   std::map<AnfNodePtr, DeviceAddress *> ref_node_addr_map_;
 
   // The lists of device tensors which need free by dynamic ref count, will be cleared at the end of step.
@@ -20,12 +20,16 @@
 #include <utility>
 #include <algorithm>
 #include <functional>
+#include <atomic>
+#include <sstream>
 #include "runtime/graph_scheduler/graph_scheduler.h"
 #include "runtime/pynative/op_executor.h"
 #include "runtime/device/device_address.h"
 #include "runtime/device/ms_device_shape_transfer.h"
 #include "runtime/pynative/op_runtime_info.h"
 #include "include/common/utils/convert_utils.h"
+#include "include/common/thread_pool.h"
+#include "ir/graph_utils.h"
 #include "common/graph_kernel/graph_kernel_flags.h"
 #include "utils/ms_context.h"
 #include "ir/tensor.h"
@@ -51,6 +55,41 @@
 namespace mindspore {
 namespace runtime {
 namespace {
+// The key of the content of a kernel graph, made of the operators, their attributes and the abstracts of the nodes in
+// topological order, and the inputs of each node by their positions. The graphs with the same key need the same
+// kernels.
+std::string GetKernelGraphContentKey(const KernelGraphPtr &graph) {
+  MS_EXCEPTION_IF_NULL(graph);
+  std::ostringstream key;
+  std::map<AnfNodePtr, size_t> node_index;
+  for (const auto &node : TopoSort(graph->get_return())) {
+    MS_EXCEPTION_IF_NULL(node);
+    (void)node_index.emplace(node, node_index.size());
+    if (node->isa<CNode>()) {
+      key << "C(";
+      for (const auto &input : node->cast<CNodePtr>()->inputs()) {
+        auto iter = node_index.find(input);
+        key << (iter == node_index.end() ? "-" : std::to_string(iter->second)) << ",";
+      }
+      key << ")";
+    } else if (node->isa<ValueNode>()) {
+      const auto &value = GetValueNode(node);
+      if (value != nullptr && value->isa<Primitive>()) {
+        const auto &prim = value->cast<PrimitivePtr>();
+        key << "V" << prim->name() << prim->GetAttrsText();
+      } else if (value != nullptr && !value->isa<tensor::Tensor>()) {
+        key << "V" << value->ToString();
+      } else {
+        key << "V";
+      }
+    } else {
+      key << "P";
+    }
+    key << (node->abstract() == nullptr ? "" : node->abstract()->ToString()) << ";";
+  }
+  return key.str();
+}
+
 // Whether device address of anf node is valid and device address type
 // is consistent with device type, for example, device address type
 // DeviceType::kGPU should be used on GPU device
@@ -564,6 +603,15 @@ void OptimizeNopNode(KernelGraph *graph) {
 GraphId GraphCompiler::CompileGraph(const GraphSegmentPtr &segment, const AnfNodePtrList &outputs,
                                     const DeviceContext *device_context, device::RunMode run_mode,
                                     bool run_in_pynative) {
+  auto graph = ConstructKernelGraph(segment, outputs, device_context, run_mode);
+  if (!run_in_pynative) {
+    OptimizeGraphAndCreateKernel(graph, device_context);
+  }
+  return FinishCompileGraph(graph, outputs, device_context, run_in_pynative);
+}
+
+KernelGraphPtr GraphCompiler::ConstructKernelGraph(const GraphSegmentPtr &segment, const AnfNodePtrList &outputs,
+                                                   const DeviceContext *device_context, device::RunMode run_mode) {
   MS_EXCEPTION_IF_NULL(session_);
   MS_EXCEPTION_IF_NULL(segment);
   MS_LOG(INFO) << "Status record: start compile graph.";
@@ -601,7 +649,13 @@ GraphId GraphCompiler::CompileGraph(const GraphSegmentPtr &segment, const AnfNod
   } else {
     graph->set_run_mode(run_mode);
   }
+  return graph;
+}
 
+GraphId GraphCompiler::FinishCompileGraph(const KernelGraphPtr &graph, const AnfNodePtrList &outputs,
+                                          const DeviceContext *device_context, bool run_in_pynative) {
+  MS_EXCEPTION_IF_NULL(session_);
+  MS_EXCEPTION_IF_NULL(graph);
   GraphId graph_id = 0;
   if (run_in_pynative) {
     MS_EXCEPTION_IF_NULL(session_);
@@ -609,7 +663,7 @@ GraphId GraphCompiler::CompileGraph(const GraphSegmentPtr &segment, const AnfNod
     graphkernel::GraphKernelFlags::GetInstance().CheckSupport();
     graph_id = graph->graph_id();
   } else {
-    graph_id = CompileGraphImpl(graph, device_context, run_in_pynative);
+    graph_id = FinishCompileGraphImpl(graph, device_context, run_in_pynative);
   }
   session_->InitAllBucket(graph, device_context);
 
@@ -718,26 +772,141 @@ GraphId GraphCompiler::CompileWholeGraphForGraphRunMode(const FuncGraphPtr &func
 
 GraphId GraphCompiler::CompileGraphImpl(const KernelGraphPtr &graph, const DeviceContext *device_context,
                                         bool run_in_pynative) const {
+  OptimizeGraphAndCreateKernel(graph, device_context);
+  return FinishCompileGraphImpl(graph, device_context, run_in_pynative);
+}
+
+void GraphCompiler::OptimizeGraphAndCreateKernel(const KernelGraphPtr &graph,
+                                                 const DeviceContext *device_context) const {
+  OptimizeGraph(graph, device_context);
+
+  // Generate 'KernelMod' for all kernels and set 'KernelMod' into kernel,
+  // 'KernelMod' is real executive object of kernel.
+  device_context->kernel_executor_->CreateKernel(graph->execution_order());
+}
+
+void GraphCompiler::OptimizeGraph(const KernelGraphPtr &graph, const DeviceContext *device_context) const {
   MS_EXCEPTION_IF_NULL(graph);
   MS_EXCEPTION_IF_NULL(device_context);
+  MS_EXCEPTION_IF_NULL(device_context->kernel_executor_);
+#ifdef ENABLE_DUMP_IR
   const auto &ms_context = MsContext::GetInstance();
   MS_EXCEPTION_IF_NULL(ms_context);
-  MS_EXCEPTION_IF_NULL(session_);
-
-#ifdef ENABLE_DUMP_IR
-  bool save_graphs = ms_context->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG);
   // Dump .pb graph before graph optimization.
-  if (save_graphs) {
+  if (ms_context->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG)) {
     DumpIRProto(graph, "before_opt_" + std::to_string(graph->graph_id()));
   }
 #endif
 
   // Execute optimization pass.
   device_context->kernel_executor_->OptimizeGraph(graph);
+}
 
-  // Generate 'KernelMod' for all kernels and set 'KernelMod' into kernel,
-  // 'KernelMod' is real executive object of kernel.
-  device_context->kernel_executor_->CreateKernel(graph->execution_order());
+size_t GraphCompiler::OptimizeGraphsAndCreateKernels(
+  const std::vector<std::pair<KernelGraphPtr, const DeviceContext *>> &graphs, bool reuse_kernels) {
+  // The graphs of the same content as a graph compiled before are compiled after the first graphs of each content, so
+  // that they share the kernels or hit the kernel compiling caches filled by the first ones instead of compiling the
+  // same kernels at the same time.
+  std::vector<std::string> keys(graphs.size());
+  std::map<std::string, size_t> first_graph_index;
+  std::vector<size_t> first_graphs;
+  std::vector<size_t> same_graphs;
+  for (size_t i = 0; i < graphs.size(); ++i) {
+    const auto &graph = graphs[i].first;
+    const auto &device_context = graphs[i].second;
+    MS_EXCEPTION_IF_NULL(graph);
+    MS_EXCEPTION_IF_NULL(device_context);
+    keys[i] = device_context->device_context_key().ToString() + ":" + GetKernelGraphContentKey(graph);
+    if (compiled_graphs_.count(keys[i]) > 0 || !first_graph_index.emplace(keys[i], i).second) {
+      (void)same_graphs.emplace_back(i);
+    } else {
+      (void)first_graphs.emplace_back(i);
+    }
+  }
+
+  common::ParallelRun(first_graphs.size(), [this, &graphs, &first_graphs](size_t i) {
+    const auto &graph = graphs[first_graphs[i]];
+    OptimizeGraphAndCreateKernel(graph.first, graph.second);
+  });
+  // The kernels are launched with the addresses of each graph, and only the kernels of static shape are shared, which
+  // are not resized.
+  if (reuse_kernels) {
+    for (const auto i : first_graphs) {
+      if (!graphs[i].first->is_dynamic_shape()) {
+        (void)compiled_graphs_.emplace(keys[i], graphs[i].first);
+      }
+    }
+  }
+
+  std::atomic<size_t> reused_graph_num{0};
+  auto compile_same_graph = [this, &graphs, &keys, &same_graphs, reuse_kernels, &reused_graph_num](size_t i) {
+    const auto &graph = graphs[same_graphs[i]];
+    auto iter = compiled_graphs_.find(keys[same_graphs[i]]);
+    if (!reuse_kernels || iter == compiled_graphs_.end() || graph.first->is_dynamic_shape()) {
+      OptimizeGraphAndCreateKernel(graph.first, graph.second);
+      return;
+    }
+    OptimizeGraph(graph.first, graph.second);
+    if (ReuseKernels(iter->second, graph.first)) {
+      ++reused_graph_num;
+    } else {
+      graph.second->kernel_executor_->CreateKernel(graph.first->execution_order());
+    }
+  };
+  common::ParallelRun(same_graphs.size(), compile_same_graph);
+  return reused_graph_num;
+}
+
+bool GraphCompiler::ReuseKernels(const KernelGraphPtr &compiled_graph, const KernelGraphPtr &graph) const {
+  MS_EXCEPTION_IF_NULL(compiled_graph);
+  MS_EXCEPTION_IF_NULL(graph);
+  const auto &compiled_nodes = compiled_graph->execution_order();
+  const auto &nodes = graph->execution_order();
+  if (compiled_nodes.size() != nodes.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    MS_EXCEPTION_IF_NULL(compiled_nodes[i]);
+    MS_EXCEPTION_IF_NULL(nodes[i]);
+    const auto compiled_kernel_info = dynamic_cast<device::KernelInfo *>(compiled_nodes[i]->kernel_info());
+    if (compiled_kernel_info == nullptr || compiled_kernel_info->kernel_mod() == nullptr ||
+        compiled_kernel_info->select_kernel_build_info() == nullptr ||
+        common::AnfAlgo::GetCNodeName(compiled_nodes[i]) != common::AnfAlgo::GetCNodeName(nodes[i])) {
+      return false;
+    }
+    const auto kernel_info = dynamic_cast<device::KernelInfo *>(nodes[i]->kernel_info());
+    if (kernel_info != nullptr && kernel_info->select_kernel_build_info() != nullptr &&
+        !(*kernel_info->select_kernel_build_info() == *compiled_kernel_info->select_kernel_build_info())) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto compiled_kernel_info = dynamic_cast<device::KernelInfo *>(compiled_nodes[i]->kernel_info());
+    if (nodes[i]->kernel_info() == nullptr) {
+      nodes[i]->set_kernel_info(std::make_shared<device::KernelInfo>());
+    }
+    const auto kernel_info = dynamic_cast<device::KernelInfo *>(nodes[i]->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    if (kernel_info->select_kernel_build_info() == nullptr) {
+      auto builder = std::make_shared<KernelBuildInfoBuilder>(compiled_kernel_info->GetMutableSelectKernelBuildInfo());
+      kernel_info->set_select_kernel_build_info(builder->Build());
+    }
+    kernel_info->set_kernel_mod(compiled_kernel_info->GetKernelModPtr());
+  }
+  return true;
+}
+
+GraphId GraphCompiler::FinishCompileGraphImpl(const KernelGraphPtr &graph, const DeviceContext *device_context,
+                                              bool run_in_pynative) const {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(device_context);
+  const auto &ms_context = MsContext::GetInstance();
+  MS_EXCEPTION_IF_NULL(ms_context);
+  MS_EXCEPTION_IF_NULL(session_);
+#ifdef ENABLE_DUMP_IR
+  bool save_graphs = ms_context->get_param<bool>(MS_CTX_SAVE_GRAPHS_FLAG);
+#endif
 
   // Read the output and input ref map and set to the kernel graph.
   AddOutInRefToGraph(graph);
@@ -22,6 +22,7 @@
 #include <string>
 #include <map>
 #include <set>
+#include <utility>
 #include "utils/hash_map.h"
 #include "runtime/hardware/device_context.h"
 #include "runtime/graph_scheduler/actor/actor_common.h"
@@ -101,6 +102,23 @@ class GraphCompiler {
   GraphId CompileGraph(const GraphSegmentPtr &segment, const AnfNodePtrList &outputs,
                        const DeviceContext *device_context, device::RunMode run_mode, bool run_in_pynative = false);
 
+  // The three steps of 'CompileGraph' for a segment, so that the graphs of several segments can be compiled
+  // concurrently. The kernel graph is constructed and optimized by the common passes in 'ConstructKernelGraph', which
+  // changes the session and has to run serially. 'OptimizeGraphAndCreateKernel' only changes the graph itself and runs
+  // concurrently for different graphs. 'FinishCompileGraph' runs serially again.
+  KernelGraphPtr ConstructKernelGraph(const GraphSegmentPtr &segment, const AnfNodePtrList &outputs,
+                                      const DeviceContext *device_context, device::RunMode run_mode);
+  void OptimizeGraphAndCreateKernel(const KernelGraphPtr &graph, const DeviceContext *device_context) const;
+  GraphId FinishCompileGraph(const KernelGraphPtr &graph, const AnfNodePtrList &outputs,
+                             const DeviceContext *device_context, bool run_in_pynative = false);
+
+  // Run 'OptimizeGraphAndCreateKernel' on the graphs concurrently. The first graph of each content is compiled before
+  // the others. With 'reuse_kernels', a graph of the same content as a graph compiled before, by this call or by an
+  // earlier one, e.g. an identical stage of a pipeline, shares the kernels of that graph rather than creating them
+  // again. Return the number of graphs sharing the kernels.
+  size_t OptimizeGraphsAndCreateKernels(const std::vector<std::pair<KernelGraphPtr, const DeviceContext *>> &graphs,
+                                        bool reuse_kernels);
+
   // Construct kernel graph from function graph and compile kernel graph in Graph mode,
   // the detailed implementation of compiling graph is in 'CompileGraphImpl'.
   GraphId CompileWholeGraphForGraphRunMode(const FuncGraphPtr &func_graph, const DeviceContext *device_context);
@@ -195,6 +213,17 @@ class GraphCompiler {
  private:
   DISABLE_COPY_AND_ASSIGN(GraphCompiler);
 
+  // Execute the optimization passes of the device, the first part of 'OptimizeGraphAndCreateKernel'.
+  void OptimizeGraph(const KernelGraphPtr &graph, const DeviceContext *device_context) const;
+
+  // Set the kernels of the optimized 'compiled_graph' to the same nodes of the optimized 'graph'. Return false and set
+  // nothing if the graphs are not the same after the optimization.
+  bool ReuseKernels(const KernelGraphPtr &compiled_graph, const KernelGraphPtr &graph) const;
+
+  // The rest of 'CompileGraphImpl' after the kernels are created.
+  GraphId FinishCompileGraphImpl(const KernelGraphPtr &graph, const DeviceContext *device_context,
+                                 bool run_in_pynative) const;
+
   // Add operators' output and input reference map to the graph.
   void AddOutInRefToGraph(const KernelGraphPtr &graph) const;
 
@@ -216,6 +245,8 @@ class GraphCompiler {
   mindspore::HashMap<GraphInfo, KernelGraphPtr> run_op_graphs_;
   // Single op kernel graph output nodes cache for PyNative mode.
   mindspore::HashMap<GraphId, std::vector<KernelWithIndex>> run_op_graph_output_nodes_;
+  // The graphs whose kernels are shared by 'OptimizeGraphsAndCreateKernels', by the device and the content of graph.
+  std::map<std::string, KernelGraphPtr> compiled_graphs_;
 
   // The member variable 'session_' will be removed after removing session module.
   // Now all the GraphCompiler share the same 'session_'.
@@ -17,6 +17,7 @@
 #include "runtime/graph_scheduler/graph_scheduler.h"
 #include <queue>
 #include "runtime/graph_scheduler/scheduler_helper.h"
+#include "runtime/graph_scheduler/static_schedule_executor.h"
 #include "runtime/graph_scheduler/actor/memory_manager_actor.h"
 #include "runtime/graph_scheduler/actor/debug_actor.h"
 #include "runtime/graph_scheduler/actor/recorder_actor.h"
@@ -501,6 +502,16 @@ ActorSet *GraphScheduler::Transform(const GraphCompilerInfo &graph_compiler_info
     execution_order_running_ = true;
     graph_compiler_info.strategy_ = GraphExecutionStrategy::kPipeline;
   }
+  if (graph_compiler_info.strategy_ == GraphExecutionStrategy::kStaticSchedule) {
+    // The graphs which can be statically scheduled are launched by the super kernel actor like the sink graphs.
+    for (size_t i = 0; i < graph_compiler_info.graphs_.size(); ++i) {
+      const auto &graph = graph_compiler_info.graphs_[i];
+      if (StaticScheduleExecutor::IsSupported(graph, graph_compiler_info.device_contexts_[i])) {
+        graph->set_run_mode(device::RunMode::kGraphMode);
+      }
+    }
+    graph_compiler_info.strategy_ = GraphExecutionStrategy::kPipeline;
+  }
   PersistDeviceTensor(graph_compiler_info);
   const auto &actor_set = Build(graph_compiler_info);
   MS_EXCEPTION_IF_NULL(actor_set);
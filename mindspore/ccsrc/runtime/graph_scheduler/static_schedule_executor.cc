@@ -0,0 +1,421 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "runtime/graph_scheduler/static_schedule_executor.h"
+#include <algorithm>
+#include <atomic>
+#include <utility>
+#include "mindrt/src/actor/actormgr.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "utils/anf_utils.h"
+#include "utils/log_adapter.h"
+
+namespace mindspore {
+namespace runtime {
+namespace {
+// The alignment of the buffers in the arena, one cache line so that the kernels of a wavefront never share one.
+constexpr size_t kArenaAlignSize = 64;
+
+size_t AlignArenaSize(size_t size) { return (size + kArenaAlignSize - 1) / kArenaAlignSize * kArenaAlignSize; }
+
+bool HasMonadInput(const CNodePtr &kernel) {
+  MS_EXCEPTION_IF_NULL(kernel);
+  const auto &inputs = kernel->inputs();
+  return std::any_of(inputs.begin(), inputs.end(), [](const AnfNodePtr &input) { return HasAbstractMonad(input); });
+}
+
+// The skipped inplace kernels are not launched. Like the kernel actors, their users read the output of the first input
+// of the chain of the skipped kernels, after the kernels producing the other inputs of the skipped ones.
+KernelWithIndex FetchRealInput(const CNodePtr &kernel, size_t input_index, std::vector<KernelWithIndex> *depends) {
+  MS_EXCEPTION_IF_NULL(depends);
+  auto input_with_index = common::AnfAlgo::GetPrevNodeOutput(kernel, input_index, false);
+  MS_EXCEPTION_IF_NULL(input_with_index.first);
+  while (IsSkippedKernelActor(input_with_index.first)) {
+    const auto skipped_node = input_with_index.first;
+    for (size_t i = 1; i < common::AnfAlgo::GetInputTensorNum(skipped_node); ++i) {
+      (void)depends->emplace_back(common::AnfAlgo::GetPrevNodeOutput(skipped_node, i, false));
+    }
+    input_with_index = common::AnfAlgo::GetPrevNodeOutput(skipped_node, 0, false);
+    MS_EXCEPTION_IF_NULL(input_with_index.first);
+  }
+  return input_with_index;
+}
+}  // namespace
+
+size_t StaticSchedulePlanner::AddBuffer(size_t size, bool persistent) {
+  (void)buffers_.emplace_back(Buffer{size, persistent, SIZE_MAX, 0, 0});
+  return buffers_.size() - 1;
+}
+
+void StaticSchedulePlanner::AddKernel(const std::vector<size_t> &inputs, const std::vector<size_t> &outputs,
+                                      const std::vector<size_t> &workspaces) {
+  (void)kernels_.emplace_back(KernelBuffers{inputs, outputs, workspaces});
+}
+
+void StaticSchedulePlanner::Plan() {
+  AssignWavefronts();
+  AssignOffsets();
+}
+
+size_t StaticSchedulePlanner::offset(size_t buffer_id) const {
+  if (buffer_id >= buffers_.size() || buffers_[buffer_id].persistent_) {
+    MS_LOG(EXCEPTION) << "The buffer " << buffer_id << " has no offset in the arena.";
+  }
+  return buffers_[buffer_id].offset_;
+}
+
+bool StaticSchedulePlanner::is_persistent(size_t buffer_id) const {
+  if (buffer_id >= buffers_.size()) {
+    MS_LOG(EXCEPTION) << "The buffer id " << buffer_id << " is out of range: " << buffers_.size();
+  }
+  return buffers_[buffer_id].persistent_;
+}
+
+void StaticSchedulePlanner::AssignWavefronts() {
+  // The first wavefront from which a buffer can be read (after its last write) and written (after its last read or
+  // write), keeping the read after write, write after read and write after write orders of the execution order.
+  std::vector<size_t> read_after(buffers_.size(), 0);
+  std::vector<size_t> write_after(buffers_.size(), 0);
+  wavefronts_.clear();
+
+  for (size_t kernel_index = 0; kernel_index < kernels_.size(); ++kernel_index) {
+    const auto &kernel = kernels_[kernel_index];
+    size_t wavefront = 0;
+    for (auto input : kernel.inputs_) {
+      wavefront = std::max(wavefront, read_after[input]);
+    }
+    for (auto output : kernel.outputs_) {
+      wavefront = std::max(wavefront, write_after[output]);
+    }
+
+    for (auto input : kernel.inputs_) {
+      write_after[input] = std::max(write_after[input], wavefront + 1);
+    }
+    for (auto output : kernel.outputs_) {
+      read_after[output] = wavefront + 1;
+      write_after[output] = std::max(write_after[output], wavefront + 1);
+    }
+
+    auto update_lifetime = [this, wavefront](const std::vector<size_t> &buffer_ids) {
+      for (auto buffer_id : buffer_ids) {
+        auto &buffer = buffers_[buffer_id];
+        buffer.first_wavefront_ = std::min(buffer.first_wavefront_, wavefront);
+        buffer.last_wavefront_ = std::max(buffer.last_wavefront_, wavefront);
+      }
+    };
+    update_lifetime(kernel.inputs_);
+    update_lifetime(kernel.outputs_);
+    update_lifetime(kernel.workspaces_);
+
+    if (wavefront >= wavefronts_.size()) {
+      wavefronts_.resize(wavefront + 1);
+    }
+    (void)wavefronts_[wavefront].emplace_back(kernel_index);
+  }
+}
+
+void StaticSchedulePlanner::AssignOffsets() {
+  // Greedy placement from the biggest buffer: each one goes to the lowest offset which doesn't overlap a placed
+  // buffer alive in the same wavefronts.
+  std::vector<size_t> order;
+  for (size_t i = 0; i < buffers_.size(); ++i) {
+    // The buffers never used by a kernel don't need memory.
+    if (!buffers_[i].persistent_ && buffers_[i].first_wavefront_ != SIZE_MAX) {
+      (void)order.emplace_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [this](size_t lhs, size_t rhs) { return buffers_[lhs].size_ > buffers_[rhs].size_; });
+
+  arena_size_ = 0;
+  std::vector<size_t> placed;
+  std::vector<std::pair<size_t, size_t>> conflicts;
+  for (auto buffer_id : order) {
+    auto &buffer = buffers_[buffer_id];
+    size_t size = AlignArenaSize(buffer.size_);
+    conflicts.clear();
+    for (auto placed_id : placed) {
+      const auto &other = buffers_[placed_id];
+      if (other.first_wavefront_ <= buffer.last_wavefront_ && buffer.first_wavefront_ <= other.last_wavefront_) {
+        (void)conflicts.emplace_back(other.offset_, other.offset_ + AlignArenaSize(other.size_));
+      }
+    }
+    std::sort(conflicts.begin(), conflicts.end());
+
+    size_t offset = 0;
+    for (const auto &conflict : conflicts) {
+      if (conflict.first >= offset + size) {
+        break;
+      }
+      offset = std::max(offset, conflict.second);
+    }
+    buffer.offset_ = offset;
+    arena_size_ = std::max(arena_size_, offset + size);
+    (void)placed.emplace_back(buffer_id);
+  }
+}
+
+StaticScheduleExecutor::~StaticScheduleExecutor() { FreeMemory(); }
+
+bool StaticScheduleExecutor::IsSupported(const KernelGraphPtr &graph, const DeviceContext *device_context) {
+  MS_EXCEPTION_IF_NULL(graph);
+  MS_EXCEPTION_IF_NULL(device_context);
+  if (device_context->GetDeviceType() != device::DeviceType::kCPU || graph->is_graph_run_mode() ||
+      graph->is_dynamic_shape() || graph->summary_node_exist() || graph->execution_order().empty()) {
+    return false;
+  }
+
+  for (const auto &kernel : graph->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    // The kernels not launched by the kernel actor are served by the other actors.
+    if (!IsKernelActor(kernel) || IsRpcActor(kernel) || common::AnfAlgo::IsCommunicationOp(kernel) ||
+        common::AnfAlgo::IsDynamicShape(kernel) || AnfAlgo::GetKernelMod(kernel) == nullptr) {
+      MS_LOG(INFO) << "The graph " << graph->graph_id() << " can't be statically scheduled because of the kernel "
+                   << kernel->fullname_with_scope();
+      return false;
+    }
+  }
+  return true;
+}
+
+size_t StaticScheduleExecutor::FetchBufferId(DeviceTensor *device_tensor, bool persistent) {
+  MS_EXCEPTION_IF_NULL(device_tensor);
+  const auto &iter = buffer_ids_.find(device_tensor);
+  if (iter != buffer_ids_.end()) {
+    return iter->second;
+  }
+  auto buffer_id = planner_.AddBuffer(device_tensor->GetSize(), persistent);
+  buffer_ids_[device_tensor] = buffer_id;
+  (void)buffer_device_tensors_.emplace_back(device_tensor);
+  return buffer_id;
+}
+
+void StaticScheduleExecutor::Compile() {
+  MS_EXCEPTION_IF_NULL(graph_);
+  MS_EXCEPTION_IF_NULL(device_context_);
+  MS_EXCEPTION_IF_NULL(device_context_->device_res_manager_);
+
+  // The device tensors of the graph inputs, the value nodes and the graph outputs keep their own memory.
+  for (const auto &input_node : graph_->input_nodes()) {
+    MS_EXCEPTION_IF_NULL(input_node);
+    if (!AnfAlgo::OutputAddrExist(input_node, 0, false)) {
+      continue;
+    }
+    auto device_tensor = AnfAlgo::GetMutableOutputAddr(input_node, 0, false).get();
+    (void)FetchBufferId(device_tensor, true);
+    // The memory of the non persistent inputs is needed before the launch, to receive the copied input data.
+    auto parameter = input_node->cast<ParameterPtr>();
+    if (parameter != nullptr && !IsPersistentDeviceTensor(input_node) &&
+        parameter->IsUsedByRealKernelInGraph(graph_->graph_id()) && device_tensor->GetPtr() == nullptr) {
+      if (!device_context_->device_res_manager_->AllocateMemory(device_tensor)) {
+        MS_LOG(EXCEPTION) << "Allocate memory failed for the input: " << input_node->DebugString()
+                          << ", alloc size: " << device_tensor->GetSize() << "B.";
+      }
+      (void)input_device_tensors_.emplace_back(device_tensor);
+    }
+  }
+  for (const auto &value_node : graph_->graph_value_nodes()) {
+    MS_EXCEPTION_IF_NULL(value_node);
+    if (AnfAlgo::OutputAddrExist(value_node, 0, false)) {
+      (void)FetchBufferId(AnfAlgo::GetMutableOutputAddr(value_node, 0, false).get(), true);
+    }
+  }
+  for (const auto &output_with_index : common::AnfAlgo::GetAllOutputWithIndex(graph_->output())) {
+    const auto &output_node = output_with_index.first;
+    MS_EXCEPTION_IF_NULL(output_node);
+    if (!AnfUtils::IsRealCNodeKernel(output_node) ||
+        !AnfAlgo::OutputAddrExist(output_node, output_with_index.second, false)) {
+      continue;
+    }
+    auto device_tensor = AnfAlgo::GetMutableOutputAddr(output_node, output_with_index.second, false).get();
+    if (buffer_ids_.count(device_tensor) == 0) {
+      (void)output_device_tensors_.emplace_back(device_tensor);
+    }
+    (void)FetchBufferId(device_tensor, true);
+  }
+
+  // The kernels with side effect keep their execution order by writing the same empty buffer.
+  auto side_effect_buffer = planner_.AddBuffer(0, true);
+  (void)buffer_device_tensors_.emplace_back(nullptr);
+
+  for (const auto &kernel : graph_->execution_order()) {
+    MS_EXCEPTION_IF_NULL(kernel);
+    if (IsSkippedKernelActor(kernel)) {
+      continue;
+    }
+    auto kernel_info = dynamic_cast<KernelInfo *>(kernel->kernel_info());
+    MS_EXCEPTION_IF_NULL(kernel_info);
+    KernelLaunchInfo launch_info;
+    launch_info.kernel_ = kernel;
+    std::vector<size_t> inputs;
+    std::vector<size_t> outputs;
+    std::vector<size_t> workspaces;
+    std::vector<KernelWithIndex> depends;
+    for (size_t i = 0; i < common::AnfAlgo::GetInputTensorNum(kernel); ++i) {
+      // An input not written by a previous kernel comes from outside of the graph and keeps its own memory.
+      const auto &input_with_index = FetchRealInput(kernel, i, &depends);
+      auto device_tensor = AnfAlgo::GetMutableOutputAddr(input_with_index.first, input_with_index.second, false).get();
+      (void)inputs.emplace_back(FetchBufferId(device_tensor, true));
+      (void)launch_info.input_device_tensors_.emplace_back(device_tensor);
+      (void)launch_info.inputs_.emplace_back(std::make_shared<kernel::Address>());
+    }
+    // The inputs of the skipped kernels are only read for the order, they are not passed to the launch.
+    for (const auto &depend : depends) {
+      if (AnfAlgo::OutputAddrExist(depend.first, depend.second, false)) {
+        auto device_tensor = AnfAlgo::GetMutableOutputAddr(depend.first, depend.second, false).get();
+        (void)inputs.emplace_back(FetchBufferId(device_tensor, true));
+      }
+    }
+    for (const auto &output_address : kernel_info->output_address_list()) {
+      (void)outputs.emplace_back(FetchBufferId(output_address.get(), false));
+      (void)launch_info.output_device_tensors_.emplace_back(output_address.get());
+      (void)launch_info.outputs_.emplace_back(std::make_shared<kernel::Address>());
+    }
+    for (const auto &workspace_address : kernel_info->workspace_address_list()) {
+      (void)workspaces.emplace_back(FetchBufferId(workspace_address.get(), false));
+      (void)launch_info.workspace_device_tensors_.emplace_back(workspace_address.get());
+      (void)launch_info.workspaces_.emplace_back(std::make_shared<kernel::Address>());
+    }
+    if (HasMonadInput(kernel)) {
+      (void)outputs.emplace_back(side_effect_buffer);
+    }
+    planner_.AddKernel(inputs, outputs, workspaces);
+    (void)launch_infos_.emplace_back(std::move(launch_info));
+  }
+  planner_.Plan();
+
+  // Bind the intermediate device tensors to their offsets in the arena.
+  if (planner_.arena_size() > 0) {
+    arena_ = device_context_->device_res_manager_->AllocateMemory(planner_.arena_size());
+    if (arena_ == nullptr) {
+      MS_LOG(EXCEPTION) << "Allocate the static schedule arena failed for the graph " << graph_->graph_id()
+                        << ", alloc size: " << planner_.arena_size() << "B.";
+    }
+  }
+  for (size_t buffer_id = 0; buffer_id < planner_.buffer_num(); ++buffer_id) {
+    auto device_tensor = buffer_device_tensors_[buffer_id];
+    if (device_tensor == nullptr || planner_.is_persistent(buffer_id)) {
+      continue;
+    }
+    if (device_tensor->GetPtr() != nullptr && device_tensor->from_mem_pool()) {
+      device_context_->device_res_manager_->FreeMemory(device_tensor);
+    }
+    device_tensor->set_ptr(static_cast<uint8_t *>(arena_) + planner_.offset(buffer_id));
+    device_tensor->set_from_mem_pool(false);
+  }
+
+  MS_LOG(INFO) << "The graph " << graph_->graph_id() << " is statically scheduled, kernel num: "
+               << launch_infos_.size() << ", wavefront num: " << planner_.wavefronts().size()
+               << ", arena size: " << planner_.arena_size() << "B.";
+}
+
+bool StaticScheduleExecutor::LaunchKernel(KernelLaunchInfo *launch_info) const {
+  MS_EXCEPTION_IF_NULL(launch_info);
+  for (size_t i = 0; i < launch_info->input_device_tensors_.size(); ++i) {
+    launch_info->inputs_[i]->addr = launch_info->input_device_tensors_[i]->GetMutablePtr();
+    launch_info->inputs_[i]->size = launch_info->input_device_tensors_[i]->GetSize();
+  }
+  for (size_t i = 0; i < launch_info->output_device_tensors_.size(); ++i) {
+    launch_info->outputs_[i]->addr = launch_info->output_device_tensors_[i]->GetMutablePtr();
+    launch_info->outputs_[i]->size = launch_info->output_device_tensors_[i]->GetSize();
+  }
+  for (size_t i = 0; i < launch_info->workspace_device_tensors_.size(); ++i) {
+    launch_info->workspaces_[i]->addr = launch_info->workspace_device_tensors_[i]->GetMutablePtr();
+    launch_info->workspaces_[i]->size = launch_info->workspace_device_tensors_[i]->GetSize();
+  }
+  return device_context_->kernel_executor_->LaunchKernel(launch_info->kernel_, launch_info->inputs_,
+                                                         launch_info->workspaces_, launch_info->outputs_);
+}
+
+bool StaticScheduleExecutor::RunWavefront(const std::vector<size_t> &wavefront) {
+  auto thread_pool = ActorMgr::GetActorMgrRef()->GetActorThreadPool();
+  if (wavefront.size() == 1 || thread_pool == nullptr) {
+    for (auto kernel_index : wavefront) {
+      if (!LaunchKernel(&launch_infos_[kernel_index])) {
+        MS_LOG(ERROR) << "Launch kernel failed: " << launch_infos_[kernel_index].kernel_->fullname_with_scope();
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Every task takes the next kernel which is not started, so that the threads which finish first take over the
+  // remaining kernels, and the kernels of the busy threads are run by the caller.
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  auto func = [this, &wavefront, &next, &failed](void *, int, float, float) -> int {
+    for (size_t i = next++; i < wavefront.size() && !failed; i = next++) {
+      auto &launch_info = launch_infos_[wavefront[i]];
+      try {
+        if (LaunchKernel(&launch_info)) {
+          continue;
+        }
+        MS_LOG(ERROR) << "Launch kernel failed: " << launch_info.kernel_->fullname_with_scope();
+      } catch (const std::exception &e) {
+        MS_LOG(ERROR) << "Launch kernel exception: " << launch_info.kernel_->fullname_with_scope() << ", " << e.what();
+      }
+      failed = true;
+    }
+    return failed ? THREAD_ERROR : THREAD_OK;
+  };
+  auto task_num = static_cast<int>(std::min(wavefront.size(), thread_pool->GetKernelThreadNum() + 1));
+  return thread_pool->ParallelLaunch(func, nullptr, task_num) == THREAD_OK && !failed;
+}
+
+bool StaticScheduleExecutor::Run() {
+  MS_EXCEPTION_IF_NULL(device_context_);
+  MS_EXCEPTION_IF_NULL(device_context_->device_res_manager_);
+  // The output actor may have moved the memory of the graph outputs to the output tensors of the previous step.
+  for (auto device_tensor : output_device_tensors_) {
+    if (device_tensor->GetPtr() == nullptr && !device_context_->device_res_manager_->AllocateMemory(device_tensor)) {
+      MS_LOG(ERROR) << "Allocate memory failed for the output of graph " << graph_->graph_id()
+                    << ", alloc size: " << device_tensor->GetSize() << "B.";
+      return false;
+    }
+  }
+
+  for (const auto &wavefront : planner_.wavefronts()) {
+    if (!RunWavefront(wavefront)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void StaticScheduleExecutor::FreeMemory() {
+  if (device_context_ == nullptr || device_context_->device_res_manager_ == nullptr) {
+    return;
+  }
+  for (size_t buffer_id = 0; buffer_id < planner_.buffer_num(); ++buffer_id) {
+    auto device_tensor = buffer_device_tensors_[buffer_id];
+    if (device_tensor != nullptr && !planner_.is_persistent(buffer_id)) {
+      device_tensor->set_ptr(nullptr);
+    }
+  }
+  if (arena_ != nullptr) {
+    device_context_->device_res_manager_->FreeMemory(arena_);
+    arena_ = nullptr;
+  }
+  for (auto device_tensor : input_device_tensors_) {
+    if (device_tensor->GetPtr() != nullptr && device_tensor->from_mem_pool()) {
+      device_context_->device_res_manager_->FreeMemory(device_tensor);
+    }
+  }
+  input_device_tensors_.clear();
+}
+}  // namespace runtime
+}  // namespace mindspore
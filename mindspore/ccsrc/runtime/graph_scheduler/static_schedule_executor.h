@@ -0,0 +1,136 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_SCHEDULE_EXECUTOR_H_
+#define MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_SCHEDULE_EXECUTOR_H_
+
+#include <vector>
+#include <memory>
+#include <map>
+#include "runtime/graph_scheduler/actor/actor_common.h"
+#include "runtime/hardware/device_context.h"
+#include "kernel/kernel.h"
+
+namespace mindspore {
+namespace runtime {
+using kernel::AddressPtr;
+
+// The static plan of a kernel sequence: the kernels are grouped in wavefronts which only depend on the previous ones,
+// and the buffers which are neither inputs nor outputs of the sequence get a fixed offset in one memory arena. Two
+// buffers share memory only if the wavefronts using them don't overlap, so the plan is valid for any interleaving of
+// the kernels of a wavefront.
+class StaticSchedulePlanner {
+ public:
+  StaticSchedulePlanner() = default;
+  ~StaticSchedulePlanner() = default;
+
+  // Register a buffer and return its id, the persistent buffers keep their own memory and are not put in the arena.
+  size_t AddBuffer(size_t size, bool persistent);
+  // Register the next kernel of the execution order by the buffers it reads, writes and uses as workspace.
+  void AddKernel(const std::vector<size_t> &inputs, const std::vector<size_t> &outputs,
+                 const std::vector<size_t> &workspaces);
+
+  // Compute the wavefronts and the arena offsets.
+  void Plan();
+
+  // The kernel indexes of each wavefront, in the execution order inside a wavefront.
+  const std::vector<std::vector<size_t>> &wavefronts() const { return wavefronts_; }
+  // The offset of a non persistent buffer in the arena.
+  size_t offset(size_t buffer_id) const;
+  size_t arena_size() const { return arena_size_; }
+  size_t buffer_num() const { return buffers_.size(); }
+  bool is_persistent(size_t buffer_id) const;
+
+ private:
+  struct Buffer {
+    size_t size_;
+    bool persistent_;
+    size_t first_wavefront_;
+    size_t last_wavefront_;
+    size_t offset_;
+  };
+  struct KernelBuffers {
+    std::vector<size_t> inputs_;
+    std::vector<size_t> outputs_;
+    std::vector<size_t> workspaces_;
+  };
+
+  void AssignWavefronts();
+  void AssignOffsets();
+
+  std::vector<Buffer> buffers_;
+  std::vector<KernelBuffers> kernels_;
+  std::vector<std::vector<size_t>> wavefronts_;
+  size_t arena_size_{0};
+};
+
+// The static schedule executor launches the kernels of a CPU kernel graph without kernel actors: the execution order
+// is compiled once into the wavefronts of a StaticSchedulePlanner, the intermediate device tensors are bound to their
+// offsets in one arena allocated at compile time, and every step only walks the wavefronts, launching the kernels of
+// a wavefront on the idle threads of the actor thread pool. It replaces the per kernel messages, memory requests and
+// mailboxes of the actor runtime, which dominate the step time of the graphs with many small kernels.
+class StaticScheduleExecutor {
+ public:
+  StaticScheduleExecutor(const KernelGraphPtr &graph, const DeviceContext *device_context)
+      : graph_(graph), device_context_(device_context) {}
+  ~StaticScheduleExecutor();
+
+  // Whether the graph can be executed by the static schedule: a CPU graph of static shape whose kernels are all
+  // launched by the kernel executor.
+  static bool IsSupported(const KernelGraphPtr &graph, const DeviceContext *device_context);
+
+  // Build the schedule, allocate the arena and the memory of the graph inputs.
+  void Compile();
+  // Launch all the kernels of the graph, return false if one of them fails.
+  bool Run();
+
+  const StaticSchedulePlanner &planner() const { return planner_; }
+
+ private:
+  struct KernelLaunchInfo {
+    CNodePtr kernel_;
+    std::vector<DeviceTensor *> input_device_tensors_;
+    std::vector<DeviceTensor *> output_device_tensors_;
+    std::vector<DeviceTensor *> workspace_device_tensors_;
+    std::vector<AddressPtr> inputs_;
+    std::vector<AddressPtr> outputs_;
+    std::vector<AddressPtr> workspaces_;
+  };
+
+  size_t FetchBufferId(DeviceTensor *device_tensor, bool persistent);
+  bool LaunchKernel(KernelLaunchInfo *launch_info) const;
+  bool RunWavefront(const std::vector<size_t> &wavefront);
+  void FreeMemory();
+
+  KernelGraphPtr graph_;
+  const DeviceContext *device_context_;
+
+  StaticSchedulePlanner planner_;
+  std::map<DeviceTensor *, size_t> buffer_ids_;
+  std::vector<DeviceTensor *> buffer_device_tensors_;
+  std::vector<KernelLaunchInfo> launch_infos_;
+
+  // The graph outputs produced by kernels, their memory may be taken away by the output actor at the end of step.
+  std::vector<DeviceTensor *> output_device_tensors_;
+  // The memory allocated by this executor which is released with it.
+  void *arena_{nullptr};
+  std::vector<DeviceTensor *> input_device_tensors_;
+};
+using StaticScheduleExecutorPtr = std::unique_ptr<StaticScheduleExecutor>;
+}  // namespace runtime
+}  // namespace mindspore
+
+#endif  // MINDSPORE_CCSRC_RUNTIME_FRAMEWORK_STATIC_SCHEDULE_EXECUTOR_H_
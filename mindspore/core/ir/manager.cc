@@ -214,6 +214,7 @@ void FuncGraphManager::Reset() {
   all_nodes_ = AnfNodeSet();
   node_users_ = NodeUsersMap();
   signals_ = std::make_shared<Signals>();
+  changed_func_graphs_.clear();
   func_graph_parents_total_ = std::make_shared<FuncGraphParentsTotalComputer>(this);
   func_graph_parent_ = std::make_shared<ParentComputer>(this);
   children_ = std::make_shared<ChildrenComputer>(this);
@@ -238,6 +239,7 @@ FuncGraphSet &FuncGraphManager::func_graph_parents_total(const FuncGraphPtr &fg)
     MS_LOG(EXCEPTION) << "The parameter 'fg' should not be null.";
   }
   MS_LOG(DEBUG) << "Start func_graph_parents_total func graph " << fg->ToString();
+  UpdateComputers();
   func_graph_parents_total_->Recompute(fg);
   MS_LOG(DEBUG) << "End func_graph_parents func graph " << fg->ToString();
   return func_graph_parents_total_->func_graph_parents_total_analysis()[fg];
@@ -247,6 +249,7 @@ FuncGraphPtr FuncGraphManager::parent(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(func_graph_parent_);
   MS_LOG(DEBUG) << "Start parents func graph " << fg->ToString();
+  UpdateComputers();
   func_graph_parent_->Recompute(fg);
   if (func_graph_parent_->parent_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager:" << fg->ToString();
@@ -260,6 +263,7 @@ FuncGraphSet &FuncGraphManager::children(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(children_);
   MS_LOG(DEBUG) << "Start child func graph " << fg->ToString();
+  UpdateComputers();
   children_->Recompute(fg);
   return children_->children_analysis()[fg];
 }
@@ -268,6 +272,7 @@ FuncGraphSet &FuncGraphManager::scopes(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
   MS_EXCEPTION_IF_NULL(scopes_);
   MS_LOG(DEBUG) << "Start scopes func graph:" << fg->ToString();
+  UpdateComputers();
   scopes_->Recompute(fg);
   MS_LOG(DEBUG) << "End scopes func graph:" << fg->ToString();
   return scopes_->scope_analysis()[fg];
@@ -275,18 +280,21 @@ FuncGraphSet &FuncGraphManager::scopes(const FuncGraphPtr &fg) const {
 
 FVTotalMap &FuncGraphManager::free_variables_total() const {
   MS_EXCEPTION_IF_NULL(free_variables_total_);
+  UpdateComputers();
   free_variables_total_->Recompute();
   return free_variables_total_->fv_total_analysis();
 }
 
 FuncGraphSet &FuncGraphManager::func_graphs_used_total(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(func_graphs_used_total_);
+  UpdateComputers();
   func_graphs_used_total_->Recompute(fg);
   return func_graphs_used_total_->func_graph_used_total_analysis()[fg];
 }
 
 bool FuncGraphManager::recursive(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(fg);
+  UpdateComputers();
   recursive_->Recompute(fg);
   if (recursive_->recursive_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager: " << fg->ToString();
@@ -316,6 +324,7 @@ std::shared_ptr<std::list<FuncGraphPtr>> FuncGraphManager::recursive_graphs(cons
 bool FuncGraphManager::func_graph_meta_fg_prim_total(const FuncGraphPtr &fg) const {
   MS_EXCEPTION_IF_NULL(meta_fg_prim_total_);
   MS_EXCEPTION_IF_NULL(fg);
+  UpdateComputers();
   meta_fg_prim_total_->Recompute(fg);
   if (meta_fg_prim_total_->meta_fg_prim_total_analysis().count(fg) == 0) {
     MS_LOG(WARNING) << "This func graph is not in manager: " << fg->ToString();
@@ -324,6 +333,69 @@ bool FuncGraphManager::func_graph_meta_fg_prim_total(const FuncGraphPtr &fg) con
   return meta_fg_prim_total_->meta_fg_prim_total_analysis()[fg];
 }
 
+void FuncGraphManager::UpdateComputers() const {
+  if (changed_func_graphs_.empty()) {
+    return;
+  }
+  // The analyses based on the used func graphs and the free variables in total are changed for the changed func
+  // graphs and the ones using them directly or indirectly.
+  FuncGraphSet affected;
+  std::vector<FuncGraphPtr> todo(changed_func_graphs_.begin(), changed_func_graphs_.end());
+  changed_func_graphs_.clear();
+  while (!todo.empty()) {
+    auto fg = std::move(todo.back());
+    todo.pop_back();
+    if (fg == nullptr || affected.contains(fg)) {
+      continue;
+    }
+    affected.add(fg);
+    for (const auto &iter : fg->func_graph_cnodes_index()) {
+      const auto &user = iter.first->first;
+      if (user != nullptr && user->func_graph() != nullptr && !affected.contains(user->func_graph())) {
+        todo.push_back(user->func_graph());
+      }
+    }
+  }
+  // The parent is changed if the parents in total of the func graph or of its parents are changed.
+  FuncGraphSet parent_affected;
+  auto &parents_total = func_graph_parents_total_->func_graph_parents_total_analysis();
+  for (const auto &iter : func_graph_parent_->parent_analysis()) {
+    const auto &fg = iter.first;
+    auto parents_iter = parents_total.find(fg);
+    if (affected.contains(fg) || parents_iter == parents_total.end() ||
+        std::any_of(parents_iter->second.begin(), parents_iter->second.end(),
+                    [&affected](const FuncGraphPtr &parent) { return affected.contains(parent); })) {
+      parent_affected.add(fg);
+    }
+  }
+  // The children and the scope are changed if the used func graphs in total or their parents are changed.
+  FuncGraphSet children_affected;
+  auto &used_total = func_graphs_used_total_->func_graph_used_total_analysis();
+  for (const auto &iter : children_->children_analysis()) {
+    const auto &fg = iter.first;
+    auto used_iter = used_total.find(fg);
+    if (affected.contains(fg) || used_iter == used_total.end() ||
+        std::any_of(used_iter->second.begin(), used_iter->second.end(),
+                    [&parent_affected](const FuncGraphPtr &used) { return parent_affected.contains(used); })) {
+      children_affected.add(fg);
+    }
+  }
+  for (const auto &iter : scopes_->scope_analysis()) {
+    if (children_->children_analysis().count(iter.first) == 0) {
+      children_affected.add(iter.first);
+    }
+  }
+  func_graph_parents_total_->Invalidate(affected);
+  func_graphs_used_total_->Invalidate(affected);
+  recursive_->Invalidate(affected);
+  meta_fg_prim_total_->Invalidate(affected);
+  func_graph_parent_->Invalidate(parent_affected);
+  children_->Invalidate(children_affected);
+  scopes_->Invalidate(children_affected);
+  // The free variables in total are computed for all the func graphs at once.
+  free_variables_total_->Reset();
+}
+
 // Add a func graph to this manager, optionally as a root func graph.
 void FuncGraphManager::AddFuncGraph(const FuncGraphPtr &func_graph, bool is_root) {
   MS_EXCEPTION_IF_NULL(func_graph);
@@ -364,6 +436,7 @@ void FuncGraphManager::Clear() noexcept {
   node_users_.clear();
   roots_.clear();
 
+  changed_func_graphs_.clear();
   signals_->InvalidateComputer();
 }
 
@@ -696,7 +769,7 @@ void FuncGraphManager::OnEdgeAdded(const AnfNodePtr &node, int index, const AnfN
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->AddFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->AddFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        changed_func_graphs_.add(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ) || IsPrimitiveCNode(node, prim::kPrimVmap) ||
@@ -705,7 +778,7 @@ void FuncGraphManager::OnEdgeAdded(const AnfNodePtr &node, int index, const AnfN
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->AddFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      changed_func_graphs_.add(fg);
     }
   }
 }
@@ -718,7 +791,7 @@ void FuncGraphManager::OnEdgeRemoved(const AnfNodePtr &node, int index, const An
       auto used = GetValueNode<FuncGraphPtr>(input);
       used->DropFuncGraphCNodeIndex(std::make_shared<CNodeIndexPair>(std::make_pair(node, index)));
       if (fg->DropFuncGraphUsed(used)) {
-        signals_->InvalidateComputer();
+        changed_func_graphs_.add(fg);
       }
     }
     if (IsPrimitiveCNode(node, prim::kPrimJ) || IsPrimitiveCNode(node, prim::kPrimVmap) ||
@@ -727,7 +800,7 @@ void FuncGraphManager::OnEdgeRemoved(const AnfNodePtr &node, int index, const An
     }
   } else if (fg != nullptr && fg != input->func_graph()) {
     if (fg->DropFreeVariable(input)) {
-      signals_->InvalidateComputer();
+      changed_func_graphs_.add(fg);
     }
   }
 }
@@ -777,6 +850,8 @@ void FuncGraphManager::EraseOneGraph(const FuncGraphPtr &fg) {
   if (!erase_ret) {
     return;
   }
+  // Erase the analyses of the dropped func graph.
+  changed_func_graphs_.add(fg->shared_from_base<FuncGraph>());
   fg->DecAttachedMngCnt();
   if (fg->attached_mng_cnt() == 0) {
     fg->ClearAllManagerInfo();
@@ -96,6 +96,14 @@ class DepComputer {
 
   void OnInvalidateComputer() { Reset(); }
 
+  // Invalidate the analysis of the func graphs only, the analysis of the other func graphs are kept.
+  void Invalidate(const FuncGraphSet &func_graphs) {
+    ExtraInvalidate(func_graphs);
+    for (const auto &fg : func_graphs) {
+      (void)func_graphs_validate_.erase(fg);
+    }
+  }
+
   void Recompute();
 
   void Recompute(const FuncGraphPtr &fg);
@@ -107,6 +115,14 @@ class DepComputer {
  protected:
   // subclass can reset their own member;
   virtual void ExtraReset() {}
+  // subclass can erase the analysis of the func graphs from their own member;
+  virtual void ExtraInvalidate(const FuncGraphSet &) {}
+  template <typename T>
+  static void EraseAnalysis(const FuncGraphSet &func_graphs, T *analysis) {
+    for (const auto &fg : func_graphs) {
+      (void)analysis->erase(fg);
+    }
+  }
   // subclass do the real compute
   virtual void RealRecompute() {}
   virtual void RealRecompute(FuncGraphPtr) {}
@@ -133,6 +149,9 @@ class FuncGraphParentsTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_parents_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    EraseAnalysis(func_graphs, &func_graph_parents_total_analysis_);
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -156,6 +175,7 @@ class ParentComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { parent_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphSet &func_graphs) override { EraseAnalysis(func_graphs, &parent_analysis_); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -174,6 +194,7 @@ class ChildrenComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { children_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphSet &func_graphs) override { EraseAnalysis(func_graphs, &children_analysis_); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -192,6 +213,7 @@ class ScopeComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { scope_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphSet &func_graphs) override { EraseAnalysis(func_graphs, &scope_analysis_); }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -228,6 +250,9 @@ class FuncGraphsUsedTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { func_graph_used_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    EraseAnalysis(func_graphs, &func_graph_used_total_analysis_);
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -255,6 +280,10 @@ class RecursiveComputer final : public DepComputer {
     recursive_analysis_.clear();
     recursive_map_.clear();
   }
+  void ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    EraseAnalysis(func_graphs, &recursive_analysis_);
+    EraseAnalysis(func_graphs, &recursive_map_);
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 };
@@ -272,6 +301,9 @@ class FuncGraphMetaFgPrimTotalComputer final : public DepComputer {
 
  protected:
   void ExtraReset() override { meta_fg_prim_total_analysis_.clear(); }
+  void ExtraInvalidate(const FuncGraphSet &func_graphs) override {
+    EraseAnalysis(func_graphs, &meta_fg_prim_total_analysis_);
+  }
 
   void RealRecompute(FuncGraphPtr fg) override;
 
@@ -358,6 +390,9 @@ class MS_CORE_API FuncGraphManager : public std::enable_shared_from_this<FuncGra
   void OnEdgeAdded(const AnfNodePtr &node, int index, const AnfNodePtr &input);
   void OnEdgeRemoved(const AnfNodePtr &node, int index, const AnfNodePtr &input);
   void MoveAllNodes(const FuncGraphPtr &source, const FuncGraphPtr &target);
+  // Invalidate the analyses affected by the func graphs whose free variables or used func graphs are changed since
+  // the last query, instead of recomputing all the analyses from scratch.
+  void UpdateComputers() const;
 
   FuncGraphSet roots_;        // Managed roots.
   FuncGraphSet func_graphs_;  // Managed func graphs.
@@ -372,6 +407,8 @@ class MS_CORE_API FuncGraphManager : public std::enable_shared_from_this<FuncGra
   std::shared_ptr<FuncGraphsUsedTotalComputer> func_graphs_used_total_;
   std::shared_ptr<RecursiveComputer> recursive_;
   std::shared_ptr<FuncGraphMetaFgPrimTotalComputer> meta_fg_prim_total_;
+  // The func graphs whose free variables or used func graphs are changed since the last query of the analyses.
+  mutable FuncGraphSet changed_func_graphs_;
 
   bool is_manage_;
 };
@@ -68,6 +68,30 @@ static const char *const kMSCacheSerializePath = "serialize_path";
 // weight path
 static const char *const kWeight = "weight";
 static const char *const kWeightPath = "weight_path";
+// map the copy of the model buf for each numa node of the model pool from shared memory
+static const char *const kWeightSharedMemory = "shared_memory";
+// decode and pack the weights of the packed ops at their first execution instead of while compiling graph
+static const char *const kWeightLazyMaterialize = "lazy_materialize";
+// pipeline the model pool over the stage models split offline, the model of the pool is the first stage
+static const char *const kPipeline = "pipeline";
+static const char *const kPipelineStageModels = "stage_models";
+static const char *const kPipelineMicroBatchNum = "micro_batch_num";
+// conv algorithm tuning
+static const char *const kConvTuning = "conv_tuning";
+static const char *const kConvTuningFile = "tuning_file";
+// resize plan cache
+static const char *const kResizePlan = "resize_plan";
+static const char *const kResizePlanMaxNum = "max_plan_num";
+static const char *const kResizeBucketAxis = "bucket_axis";
+static const char *const kResizeBucketSize = "bucket_size";
+// int4 weight-only quantization
+static const char *const kWeightInt4 = "weight_int4";
+static const char *const kWeightInt4Enable = "enable";
+static const char *const kWeightInt4GroupSize = "group_size";
+// recompute the forward activations of the train session in backward, the checkpoints are separated by commas
+static const char *const kRecompute = "recompute";
+static const char *const kRecomputeEnable = "enable";
+static const char *const kRecomputeCheckpoints = "checkpoints";
 
 static const char *const kIsOptimized = "isOptimized";
 }  // namespace lite
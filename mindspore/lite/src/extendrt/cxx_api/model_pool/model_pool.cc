@@ -24,6 +24,7 @@
 #include "src/litert/pack_weight_manager.h"
 #include "src/extendrt/numa_adapter.h"
 #include "src/common/common.h"
+#include "src/common/utils.h"
 namespace mindspore {
 namespace {
 constexpr int kNumDeviceInfo = 2;
@@ -105,6 +106,55 @@ int GetDefaultThreadNum() {
     return kDefaultThreadsNum;
   }
 }
+
+bool IsWeightSharedMemory(const std::map<std::string, std::map<std::string, std::string>> &config_info) {
+  auto section = config_info.find(lite::kWeight);
+  if (section == config_info.end()) {
+    return false;
+  }
+  auto iter = section->second.find(lite::kWeightSharedMemory);
+  if (iter == section->second.end()) {
+    return false;
+  }
+  auto shared_memory = lite::GenericParseValue<bool>(iter->second);
+  return shared_memory.IsSome() && shared_memory.Get();
+}
+
+std::vector<std::string> GetPipelineStageModels(
+  const std::map<std::string, std::map<std::string, std::string>> &config_info) {
+  auto section = config_info.find(lite::kPipeline);
+  if (section == config_info.end()) {
+    return {};
+  }
+  auto iter = section->second.find(lite::kPipelineStageModels);
+  if (iter == section->second.end() || iter->second.empty()) {
+    return {};
+  }
+  std::vector<std::string> stage_models;
+  for (auto &stage_model : lite::StrSplit(iter->second, ",")) {
+    if (!stage_model.empty()) {
+      stage_models.push_back(stage_model);
+    }
+  }
+  return stage_models;
+}
+
+size_t GetPipelineMicroBatchNum(const std::map<std::string, std::map<std::string, std::string>> &config_info) {
+  auto section = config_info.find(lite::kPipeline);
+  if (section == config_info.end()) {
+    return 1;
+  }
+  auto iter = section->second.find(lite::kPipelineMicroBatchNum);
+  if (iter == section->second.end()) {
+    return 1;
+  }
+  auto micro_batch_num = lite::GenericParseValue<int>(iter->second);
+  if (micro_batch_num.IsNone() || micro_batch_num.Get() <= 0) {
+    MS_LOG(WARNING) << "invalid micro batch num: " << iter->second << ", the inputs are not split.";
+    return 1;
+  }
+  return static_cast<size_t>(micro_batch_num.Get());
+}
 }  // namespace
 
 Status ModelPool::DistinguishPhysicalAndLogicalByNuma(const std::vector<int> &physical_core_list,
@@ -724,11 +774,12 @@ Status ModelPool::CreateWorkers(const char *graph_buf, size_t size, const ModelP
     MS_LOG(ERROR) << "model pool config size is wrong.";
     return kLiteError;
   }
-  bool create_worker_success = true;
+  std::atomic_bool create_worker_success(true);
   for (size_t i = 0; i < model_pool_info_[strategy].all_workers_num_; i++) {
     model_pool_config[i]->strategy = strategy;
     int numa_node_id = model_pool_config[i]->numa_id;
-    auto ret = lite::PackWeightManager::GetInstance()->InitPackWeight(graph_buf, size, numa_node_id);
+    auto ret = lite::PackWeightManager::GetInstance()->InitPackWeight(
+      graph_buf, size, numa_node_id, IsWeightSharedMemory(model_pool_config[i]->config_info));
     MS_CHECK_FALSE_MSG(ret != kSuccess, kLiteError, "InitWeightManagerByBuf failed.");
     auto new_model_buf = lite::PackWeightManager::GetInstance()->GetNumaModelBuf(graph_buf, numa_node_id);
     MS_CHECK_TRUE_MSG(new_model_buf != nullptr, kLiteError, "get model buf is nullptr from PackWeightManager");
@@ -750,7 +801,7 @@ Status ModelPool::CreateWorkers(const char *graph_buf, size_t size, const ModelP
   // wait for all workers to be created successfully
   for (auto &worker_info : all_workers_[strategy]) {
     auto &worker = worker_info->worker;
-    worker->WaitCreateWorkerDone();
+    worker->WaitCreateDone();
     if (!create_worker_success) {
       MS_LOG(ERROR) << "worker init failed.";
       return kLiteError;
@@ -871,6 +922,15 @@ Status ModelPool::Init(const char *model_buf, size_t size, const std::shared_ptr
     return kLiteError;
   }
 
+  if (runner_config != nullptr && !GetPipelineStageModels(runner_config->GetConfigInfo()).empty()) {
+    status = InitPipeline(model_buf, size, runner_config);
+    if (status != kSuccess) {
+      MS_LOG(ERROR) << "init pipeline failed.";
+      return kLiteError;
+    }
+    return kSuccess;
+  }
+
   status = InitBaseStrategy(model_buf, size, runner_config);
   if (status != kSuccess) {
     MS_LOG(ERROR) << "init base strategy failed.";
@@ -929,6 +989,13 @@ Status ModelPool::InitByPath(const std::string &model_path, const std::shared_pt
 }
 
 Status ModelPool::UpdateConfig(const std::string &section, const std::pair<std::string, std::string> &config) {
+  for (auto &stage : pipeline_stages_) {
+    auto status = stage->UpdateConfig(section, config);
+    if (status != kSuccess) {
+      MS_LOG(ERROR) << "pipeline stage update config failed, status=" << status;
+      return status;
+    }
+  }
   for (auto &item : all_workers_) {
     auto &workers = item.second;
     for (auto &worker_info : workers) {
@@ -1009,6 +1076,9 @@ Strategy ModelPool::UpdateStrategy() {
 
 Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                           const MSKernelCallBack &before, const MSKernelCallBack &after) {
+  if (use_pipeline_) {
+    return PipelinePredict(inputs, outputs, before, after);
+  }
   predict_task_mutex_.lock();
   int max_wait_worker_node_id = 0;
   int max_wait_worker_num = 0;
@@ -1050,6 +1120,412 @@ Status ModelPool::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTen
   return kSuccess;
 }
 
+Status ModelPool::SetPipelineBindList(size_t stage_num, const std::shared_ptr<RunnerConfig> &runner_config,
+                                      std::vector<std::vector<int>> *bind_core_list,
+                                      std::vector<int> *bind_numa_list) {
+  // the cores are grouped by the user core list, or by the numa nodes, or all the physical cores are a group
+  std::vector<std::vector<int>> core_groups;
+  std::vector<int> group_numa_id;
+  auto context = runner_config->GetContext();
+  if (context != nullptr && !context->GetThreadAffinityCoreList().empty()) {
+    core_groups.push_back(context->GetThreadAffinityCoreList());
+    group_numa_id.push_back(kInvalidNumaId);
+  } else if (numa_available_) {
+    for (size_t i = 0; i < numa_physical_cores_.size(); i++) {
+      if (!numa_physical_cores_[i].empty()) {
+        core_groups.push_back(numa_physical_cores_[i]);
+        group_numa_id.push_back(static_cast<int>(i));
+      }
+    }
+  } else {
+    std::vector<int> physical_core_list;
+    std::vector<int> logical_core_list;
+    auto status = DistinguishPhysicalAndLogical(&physical_core_list, &logical_core_list);
+    if (status != kSuccess || physical_core_list.empty()) {
+      physical_core_list.clear();
+      for (int i = 0; i < lite::GetCoreNum(); i++) {
+        physical_core_list.push_back(i);
+      }
+    }
+    core_groups.push_back(physical_core_list);
+    group_numa_id.push_back(kInvalidNumaId);
+  }
+  if (core_groups.empty()) {
+    MS_LOG(ERROR) << "no core is available for the pipeline stages.";
+    return kLiteError;
+  }
+  // the adjacent stages are placed on the same group, and the stages of a group share its cores evenly
+  std::vector<std::vector<size_t>> group_stages(core_groups.size());
+  for (size_t i = 0; i < stage_num; i++) {
+    group_stages[i * core_groups.size() / stage_num].push_back(i);
+  }
+  bind_core_list->resize(stage_num);
+  bind_numa_list->resize(stage_num);
+  for (size_t i = 0; i < core_groups.size(); i++) {
+    auto &stages = group_stages[i];
+    if (stages.empty()) {
+      continue;
+    }
+    auto &cores = core_groups[i];
+    if (cores.size() < stages.size()) {
+      MS_LOG(ERROR) << "core num[" << cores.size() << "] is less than the pipeline stage num[" << stages.size()
+                    << "] on numa node " << group_numa_id[i];
+      return kLiteError;
+    }
+    auto stage_core_num = cores.size() / stages.size();
+    for (size_t j = 0; j < stages.size(); j++) {
+      auto begin = cores.begin() + j * stage_core_num;
+      auto end = (j == stages.size() - 1) ? cores.end() : begin + stage_core_num;
+      bind_core_list->at(stages[j]) = std::vector<int>(begin, end);
+      bind_numa_list->at(stages[j]) = group_numa_id[i];
+    }
+  }
+  return kSuccess;
+}
+
+ModelPoolConfig ModelPool::CreatePipelineStageConfig(const std::shared_ptr<RunnerConfig> &runner_config,
+                                                     const std::vector<std::vector<int>> &bind_core_list,
+                                                     const std::vector<int> &bind_numa_list) {
+  ModelPoolConfig stage_config;
+  auto user_context = runner_config->GetContext();
+  for (size_t i = 0; i < bind_core_list.size(); i++) {
+    auto context = std::make_shared<Context>();
+    if (context == nullptr) {
+      MS_LOG(ERROR) << "New Context failed.";
+      return {};
+    }
+    auto worker_config = std::make_shared<WorkerConfig>();
+    if (worker_config == nullptr) {
+      MS_LOG(ERROR) << "new stage config failed.";
+      return {};
+    }
+    context->SetThreadNum(static_cast<int32_t>(bind_core_list[i].size()));
+    context->SetThreadAffinity(bind_core_list[i]);
+    worker_config->numa_id = bind_numa_list[i];
+    auto &new_device_list = context->MutableDeviceInfo();
+    std::shared_ptr<CPUDeviceInfo> device_info = std::make_shared<CPUDeviceInfo>();
+    if (device_info == nullptr) {
+      MS_LOG(ERROR) << "device_info is nullptr.";
+      return {};
+    }
+    std::shared_ptr<Allocator> allocator = nullptr;
+    if (user_context != nullptr && !user_context->MutableDeviceInfo().empty() &&
+        user_context->MutableDeviceInfo().front()->GetAllocator() != nullptr) {
+      allocator = user_context->MutableDeviceInfo().front()->GetAllocator();
+    } else {
+      allocator = std::make_shared<DynamicMemAllocator>(worker_config->numa_id);
+    }
+    if (allocator == nullptr) {
+      MS_LOG(ERROR) << "new allocator failed.";
+      return {};
+    }
+    device_info->SetAllocator(allocator);
+    device_info->SetEnableFP16(false);
+    new_device_list.push_back(device_info);
+    worker_config->config_info = runner_config->GetConfigInfo();
+    worker_config->context = context;
+    worker_config->worker_id = i;
+    worker_config->strategy = BASE;
+    stage_config.push_back(worker_config);
+  }
+  return stage_config;
+}
+
+Status ModelPool::CreatePipelineStages(const std::vector<std::pair<const char *, size_t>> &stage_bufs,
+                                       const std::shared_ptr<RunnerConfig> &runner_config) {
+  std::vector<std::vector<int>> bind_core_list;
+  std::vector<int> bind_numa_list;
+  auto status = SetPipelineBindList(stage_bufs.size(), runner_config, &bind_core_list, &bind_numa_list);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "SetPipelineBindList failed.";
+    return kLiteError;
+  }
+  pipeline_stage_config_ = CreatePipelineStageConfig(runner_config, bind_core_list, bind_numa_list);
+  if (pipeline_stage_config_.size() != stage_bufs.size()) {
+    MS_LOG(ERROR) << "CreatePipelineStageConfig failed.";
+    return kLiteError;
+  }
+  // every stage model is only copied to the numa node of its stage, so the weights are not duplicated
+  std::vector<char *> numa_model_bufs;
+  for (size_t i = 0; i < stage_bufs.size(); i++) {
+    auto &stage_config = pipeline_stage_config_[i];
+    auto ret = lite::PackWeightManager::GetInstance()->InitPackWeight(
+      stage_bufs[i].first, stage_bufs[i].second, stage_config->numa_id, IsWeightSharedMemory(stage_config->config_info));
+    MS_CHECK_FALSE_MSG(ret != kSuccess, kLiteError, "InitWeightManagerByBuf failed.");
+    auto new_model_buf =
+      lite::PackWeightManager::GetInstance()->GetNumaModelBuf(stage_bufs[i].first, stage_config->numa_id);
+    MS_CHECK_TRUE_MSG(new_model_buf != nullptr, kLiteError, "get model buf is nullptr from PackWeightManager");
+    numa_model_bufs.push_back(new_model_buf);
+    auto stage = std::make_shared<PipelineStage>();
+    if (stage == nullptr) {
+      MS_LOG(ERROR) << "pipeline stage is nullptr.";
+      return kLiteNullptr;
+    }
+    status = stage->Init();
+    if (status != kSuccess) {
+      MS_LOG(ERROR) << "pipeline stage init failed.";
+      return status;
+    }
+    if (!pipeline_stages_.empty()) {
+      pipeline_stages_.back()->SetNextStage(stage.get());
+    }
+    pipeline_stages_.push_back(stage);
+  }
+  std::atomic_bool create_stage_success(true);
+  for (size_t i = 0; i < pipeline_stages_.size(); i++) {
+    worker_thread_vec_.push_back(std::thread(&PipelineStage::CreateThreadStage, pipeline_stages_[i],
+                                             numa_model_bufs[i], stage_bufs[i].second, pipeline_stage_config_[i],
+                                             &create_stage_success));
+  }
+  // wait for all stages to be created
+  for (auto &stage : pipeline_stages_) {
+    stage->WaitCreateDone();
+  }
+  if (!create_stage_success) {
+    MS_LOG(ERROR) << "pipeline stage init failed.";
+    return kLiteError;
+  }
+  model_pool_inputs_ = pipeline_stages_.front()->GetInputs();
+  model_pool_outputs_ = pipeline_stages_.back()->GetOutputs();
+  return kSuccess;
+}
+
+Status ModelPool::InitPipelineTensors() {
+  // the inputs of a stage are the outputs of the former stages or the inputs of the first stage, and every tensor
+  // is released by the last stage using it except the outputs of the last stage, which are the outputs of the pool.
+  std::set<std::string> produced_tensors;
+  std::map<std::string, size_t> last_used_stage;
+  for (size_t i = 0; i < pipeline_stages_.size(); i++) {
+    for (auto &input : pipeline_stages_[i]->GetInputs()) {
+      if (i != 0 && produced_tensors.find(input.Name()) == produced_tensors.end()) {
+        MS_LOG(ERROR) << "input " << input.Name() << " of pipeline stage " << i
+                      << " is neither an output of the former stages nor an input of the first stage.";
+        return kLiteError;
+      }
+      produced_tensors.insert(input.Name());
+      last_used_stage[input.Name()] = i;
+    }
+    for (auto &output : pipeline_stages_[i]->GetOutputs()) {
+      produced_tensors.insert(output.Name());
+      last_used_stage[output.Name()] = i;
+    }
+  }
+  for (auto &output : pipeline_stages_.back()->GetOutputs()) {
+    (void)last_used_stage.erase(output.Name());
+  }
+  std::vector<std::vector<std::string>> release_tensors(pipeline_stages_.size());
+  for (auto &item : last_used_stage) {
+    release_tensors[item.second].push_back(item.first);
+  }
+  for (size_t i = 0; i < pipeline_stages_.size(); i++) {
+    pipeline_stages_[i]->SetReleaseTensors(release_tensors[i]);
+  }
+  return kSuccess;
+}
+
+Status ModelPool::InitPipeline(const char *model_buf, size_t size, const std::shared_ptr<RunnerConfig> &runner_config) {
+  auto context = runner_config->GetContext();
+  if (context != nullptr) {
+    for (auto &device_info : context->MutableDeviceInfo()) {
+      if (device_info->GetDeviceType() != kCPU) {
+        MS_LOG(ERROR) << "pipeline only supports the cpu device.";
+        return kLiteNotSupport;
+      }
+    }
+  }
+  auto config_info = runner_config->GetConfigInfo();
+  micro_batch_num_ = GetPipelineMicroBatchNum(config_info);
+  // the model of the pool is the first stage
+  std::vector<std::pair<const char *, size_t>> stage_bufs = {std::make_pair(model_buf, size)};
+  std::vector<char *> stage_files;
+  Status status = kSuccess;
+  for (auto &stage_model : GetPipelineStageModels(config_info)) {
+    size_t stage_size = 0;
+    auto stage_buf = lite::ReadFile(stage_model.c_str(), &stage_size);
+    if (stage_buf == nullptr) {
+      MS_LOG(ERROR) << "read stage model failed, model path: " << stage_model;
+      status = kLiteNullptr;
+      break;
+    }
+    stage_files.push_back(stage_buf);
+    stage_bufs.push_back(std::make_pair(stage_buf, stage_size));
+  }
+  if (status == kSuccess) {
+    status = CreatePipelineStages(stage_bufs, runner_config);
+  }
+  // the stages are built from the copies for their numa nodes
+  for (auto &stage_file : stage_files) {
+    delete[] stage_file;
+  }
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "CreatePipelineStages failed.";
+    return status;
+  }
+  status = InitPipelineTensors();
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "InitPipelineTensors failed.";
+    return status;
+  }
+  MS_LOG(INFO) << "pipeline stage num: " << pipeline_stages_.size() << " | micro batch num: " << micro_batch_num_;
+  use_pipeline_ = true;
+  return kSuccess;
+}
+
+Status ModelPool::SplitMicroBatch(const std::vector<MSTensor> &inputs,
+                                  std::vector<std::vector<MSTensor>> *micro_inputs) {
+  // the inputs are split along the first dim, which must be the batch of all the inputs
+  size_t micro_batch_num = micro_batch_num_;
+  int64_t batch = -1;
+  for (auto &input : inputs) {
+    auto shape = input.Shape();
+    if (shape.empty() || shape.front() <= 0 || (batch != -1 && shape.front() != batch) ||
+        input.DataType() == DataType::kObjectTypeString) {
+      micro_batch_num = 1;
+      break;
+    }
+    batch = shape.front();
+  }
+  if (micro_batch_num > 1 && batch % static_cast<int64_t>(micro_batch_num) != 0) {
+    MS_LOG(DEBUG) << "batch " << batch << " can not be split into " << micro_batch_num << " micro batches evenly.";
+    micro_batch_num = 1;
+  }
+  if (micro_batch_num == 1) {
+    micro_inputs->push_back(inputs);
+    return kSuccess;
+  }
+  auto micro_batch = batch / static_cast<int64_t>(micro_batch_num);
+  for (size_t i = 0; i < micro_batch_num; i++) {
+    std::vector<MSTensor> micro_input;
+    for (auto &input : inputs) {
+      auto data = static_cast<uint8_t *>(const_cast<MSTensor &>(input).MutableData());
+      if (data == nullptr) {
+        MS_LOG(ERROR) << "data of input " << input.Name() << " is nullptr.";
+        return kLiteNullptr;
+      }
+      auto shape = input.Shape();
+      shape.front() = micro_batch;
+      auto micro_size = input.DataSize() / micro_batch_num;
+      auto tensor =
+        mindspore::MSTensor::CreateRefTensor(input.Name(), input.DataType(), shape, data + i * micro_size, micro_size);
+      if (tensor == nullptr) {
+        MS_LOG(ERROR) << "create micro batch tensor failed.";
+        return kLiteError;
+      }
+      micro_input.push_back(*tensor);
+      delete tensor;
+    }
+    micro_inputs->push_back(micro_input);
+  }
+  return kSuccess;
+}
+
+Status ModelPool::ConcatMicroBatch(std::vector<PipelineTask> *tasks, std::vector<MSTensor> *outputs) {
+  std::vector<MSTensor> new_outputs;
+  for (auto &model_output : model_pool_outputs_) {
+    std::vector<MSTensor> micro_outputs;
+    for (auto &task : *tasks) {
+      auto iter = task.tensors.find(model_output.Name());
+      if (iter == task.tensors.end()) {
+        MS_LOG(ERROR) << "output " << model_output.Name() << " is not found in the pipeline task.";
+        return kLiteError;
+      }
+      micro_outputs.push_back(iter->second);
+    }
+    if (micro_outputs.size() == 1) {
+      new_outputs.push_back(micro_outputs.front());
+      continue;
+    }
+    auto shape = micro_outputs.front().Shape();
+    if (shape.empty()) {
+      MS_LOG(ERROR) << "output " << model_output.Name() << " of the micro batches can not be concatenated.";
+      return kLiteError;
+    }
+    int64_t batch = 0;
+    size_t data_size = 0;
+    for (auto &micro_output : micro_outputs) {
+      batch += micro_output.Shape().front();
+      data_size += micro_output.DataSize();
+    }
+    shape.front() = batch;
+    auto tensor = mindspore::MSTensor::CreateTensor(model_output.Name(), model_output.DataType(), shape, nullptr, 0);
+    if (tensor == nullptr) {
+      MS_LOG(ERROR) << "create output tensor failed.";
+      return kLiteError;
+    }
+    auto data = static_cast<uint8_t *>(tensor->MutableData());
+    if (data == nullptr || tensor->DataSize() != data_size) {
+      MS_LOG(ERROR) << "malloc data of output " << model_output.Name() << " failed.";
+      delete tensor;
+      return kLiteError;
+    }
+    size_t offset = 0;
+    for (auto &micro_output : micro_outputs) {
+      (void)memcpy(data + offset, micro_output.MutableData(), micro_output.DataSize());
+      offset += micro_output.DataSize();
+    }
+    new_outputs.push_back(*tensor);
+    delete tensor;
+  }
+  bool user_set_outputs = outputs->size() == new_outputs.size();
+  for (size_t i = 0; user_set_outputs && i < outputs->size(); i++) {
+    user_set_outputs = outputs->at(i).Data() != nullptr && outputs->at(i).DataSize() == new_outputs[i].DataSize();
+  }
+  if (!user_set_outputs) {
+    outputs->clear();
+    outputs->insert(outputs->end(), new_outputs.begin(), new_outputs.end());
+    return kSuccess;
+  }
+  /* user set graph-output-tensor from outside */
+  for (size_t i = 0; i < outputs->size(); i++) {
+    (void)memcpy(outputs->at(i).MutableData(), new_outputs[i].MutableData(), new_outputs[i].DataSize());
+    outputs->at(i).SetShape(new_outputs[i].Shape());
+  }
+  return kSuccess;
+}
+
+Status ModelPool::PipelinePredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                                  const MSKernelCallBack &before, const MSKernelCallBack &after) {
+  if (inputs.size() != model_pool_inputs_.size()) {
+    MS_LOG(ERROR) << "model input size is: " << model_pool_inputs_.size()
+                  << ", but get input size is: " << inputs.size();
+    return kLiteError;
+  }
+  std::vector<std::vector<MSTensor>> micro_inputs;
+  auto status = SplitMicroBatch(inputs, &micro_inputs);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "split micro batch failed.";
+    return status;
+  }
+  // the first stage runs the next micro batch while the later stages are running the former ones
+  std::vector<PipelineTask> tasks(micro_inputs.size());
+  for (size_t i = 0; i < tasks.size(); i++) {
+    for (size_t j = 0; j < model_pool_inputs_.size(); j++) {
+      tasks[i].tensors[model_pool_inputs_[j].Name()] = micro_inputs[i][j];
+    }
+    tasks[i].before = before;
+    tasks[i].after = after;
+    pipeline_stages_.front()->PushTask(&tasks[i]);
+  }
+  for (auto &task : tasks) {
+    PipelineStage::WaitTaskDone(&task);
+  }
+  for (auto &task : tasks) {
+    if (task.status != kSuccess) {
+      MS_LOG(ERROR) << "pipeline predict failed.";
+      return task.status;
+    }
+  }
+  return ConcatMicroBatch(&tasks, outputs);
+}
+
+std::vector<float> ModelPool::GetPipelineUtilization() {
+  std::vector<float> utilization;
+  for (auto &stage : pipeline_stages_) {
+    utilization.push_back(stage->Utilization());
+  }
+  return utilization;
+}
+
 ModelPool::~ModelPool() {
   for (auto &item : model_pool_info_) {
     auto strategy = item.first;
@@ -1057,6 +1533,12 @@ ModelPool::~ModelPool() {
       model_pool_info_[strategy].predict_task_queue_->SetPredictTaskDone();
     }
   }
+  for (size_t i = 0; i < pipeline_stages_.size(); i++) {
+    auto &stage = pipeline_stages_[i];
+    MS_LOG(INFO) << "pipeline stage id: " << i << " | stage task num: " << stage->TaskNum()
+                 << " | stage utilization: " << stage->Utilization();
+    stage->Stop();
+  }
   if (tasks_ != nullptr) {
     delete[] tasks_;
     tasks_ = nullptr;
@@ -29,6 +29,7 @@
 #include "include/api/model_parallel_runner.h"
 #include "src/extendrt/cxx_api/model_pool/model_worker.h"
 #include "src/extendrt/cxx_api/model_pool/predict_task_queue.h"
+#include "src/extendrt/cxx_api/model_pool/pipeline_stage.h"
 namespace mindspore {
 using ModelPoolConfig = std::vector<std::shared_ptr<WorkerConfig>>;
 
@@ -70,6 +71,9 @@ class ModelPool {
   Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                  const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
+  // the utilization of each pipeline stage, empty if the pool is not a pipeline
+  std::vector<float> GetPipelineUtilization();
+
  private:
   ModelPoolConfig CreateBaseStrategyModelPoolConfig(const std::shared_ptr<RunnerConfig> &runner_config,
                                                     Strategy strategy);
@@ -130,6 +134,27 @@ class ModelPool {
 
   Strategy UpdateStrategy();
 
+  Status InitPipeline(const char *model_buf, size_t size, const std::shared_ptr<RunnerConfig> &runner_config);
+
+  Status SetPipelineBindList(size_t stage_num, const std::shared_ptr<RunnerConfig> &runner_config,
+                             std::vector<std::vector<int>> *bind_core_list, std::vector<int> *bind_numa_list);
+
+  ModelPoolConfig CreatePipelineStageConfig(const std::shared_ptr<RunnerConfig> &runner_config,
+                                            const std::vector<std::vector<int>> &bind_core_list,
+                                            const std::vector<int> &bind_numa_list);
+
+  Status CreatePipelineStages(const std::vector<std::pair<const char *, size_t>> &stage_bufs,
+                              const std::shared_ptr<RunnerConfig> &runner_config);
+
+  Status InitPipelineTensors();
+
+  Status SplitMicroBatch(const std::vector<MSTensor> &inputs, std::vector<std::vector<MSTensor>> *micro_inputs);
+
+  Status ConcatMicroBatch(std::vector<PipelineTask> *tasks, std::vector<MSTensor> *outputs);
+
+  Status PipelinePredict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
+                         const MSKernelCallBack &before, const MSKernelCallBack &after);
+
  private:
   bool use_advanced_strategy_ = true;
   bool use_gpu_ = false;
@@ -162,6 +187,13 @@ class ModelPool {
   // numa id -> core id
   std::vector<std::vector<int>> numa_physical_cores_;
   std::vector<std::vector<int>> numa_logical_cores_;
+
+  // pipeline: the stage models run one after another on their own cores, each micro batch of the inputs flows
+  // through the stages, so that the stages run different micro batches at the same time.
+  bool use_pipeline_ = false;
+  size_t micro_batch_num_ = 1;
+  ModelPoolConfig pipeline_stage_config_;
+  std::vector<std::shared_ptr<PipelineStage>> pipeline_stages_;
 };
 }  // namespace mindspore
 #endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_MODEL_POOL_H_
@@ -19,53 +19,96 @@
 #include "src/common/common.h"
 #include "nnacl/op_base.h"
 namespace mindspore {
-void ModelWorker::PrintWorkerInfo() {
-  MS_LOG(ERROR) << "worker id: " << worker_config_->worker_id << " | strategy: " << worker_config_->strategy
-                << " | bind core mode: " << worker_config_->context->GetThreadAffinityMode()
-                << " | bind core id list: " << worker_config_->context->GetThreadAffinityCoreList()
-                << " | inter op parallel num: " << worker_config_->context->GetInterOpParallelNum()
-                << " | worker thread num: " << worker_config_->context->GetThreadNum()
-                << " | worker bind numa id: " << worker_config_->numa_id
-                << " | worker task queue id: " << worker_config_->task_queue_id;
+void ModelThread::PrintThreadInfo() {
+  MS_LOG(ERROR) << name_ << " id: " << config_->worker_id << " | strategy: " << config_->strategy
+                << " | bind core mode: " << config_->context->GetThreadAffinityMode()
+                << " | bind core id list: " << config_->context->GetThreadAffinityCoreList()
+                << " | inter op parallel num: " << config_->context->GetInterOpParallelNum()
+                << " | thread num: " << config_->context->GetThreadNum() << " | bind numa id: " << config_->numa_id
+                << " | task queue id: " << config_->task_queue_id;
 }
 
-bool ModelWorker::IsAvailable() {
-  bool expected = true;
-  return available_.compare_exchange_strong(expected, false);
+void ModelThread::WaitCreateDone() {
+  std::unique_lock<std::mutex> create_lock(create_done_mutex_);
+  while (!create_done_) {
+    create_done_condition_.wait(create_lock);
+  }
 }
 
-void ModelWorker::WaitCreateWorkerDone() {
-  std::unique_lock<std::mutex> create_work_lock(create_work_done_mutex_);
-  while (!create_work_done_) {
-    create_work_done_condition_.wait(create_work_lock);
+Status ModelThread::CreateModel(const char *model_buf, size_t size, const std::shared_ptr<WorkerConfig> &config,
+                                std::atomic_bool *create_success) {
+  config_ = config;
+  MS_LOG(DEBUG) << name_ << " bind core id list: " << config_->context->GetThreadAffinityCoreList();
+  MS_LOG(DEBUG) << name_ << " thread num: " << config_->context->GetThreadNum();
+  numa::NUMAAdapter::GetInstance()->Bind(config_->numa_id);
+  auto status = InitModel(model_buf, size);
+  std::lock_guard<std::mutex> create_lock(create_done_mutex_);
+  if (status != kSuccess) {
+    PrintThreadInfo();
+    MS_LOG(ERROR) << "init failed in " << name_ << ".";
+    *create_success = false;
   }
-  return;
+  create_done_ = true;
+  create_done_condition_.notify_one();
+  return status;
+}
+
+Status ModelThread::InitModel(const char *model_buf, size_t size) {
+  MS_CHECK_TRUE_MSG(model_buf != nullptr, kLiteError, "model_buf is nullptr.");
+  model_ = std::make_shared<Model>();
+  if (model_ == nullptr) {
+    MS_LOG(ERROR) << "model is nullptr.";
+    return kLiteNullptr;
+  }
+  mindspore::ModelType model_type = kMindIR_Lite;
+  for (auto &section : config_->config_info) {
+    for (auto &config : section.second) {
+      auto status = model_->UpdateConfig(section.first, std::make_pair(config.first, config.second));
+      if (status != kSuccess) {
+        MS_LOG(ERROR) << "Update Config failed, status=" << status;
+        return status;
+      }
+    }
+  }
+  auto status = model_->Build(model_buf, size, model_type, config_->context);
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "model build failed in " << name_ << ".";
+    return status;
+  }
+  origin_inputs_ = model_->GetInputs();
+  origin_outputs_ = model_->GetOutputs();
+  if (origin_inputs_.empty() || origin_outputs_.empty()) {
+    MS_LOG(ERROR) << name_ << " get empty input/output.";
+    return kLiteError;
+  }
+  return kSuccess;
+}
+
+Status ModelThread::UpdateConfig(const std::string &section, const std::pair<std::string, std::string> &config) {
+  std::lock_guard<std::mutex> model_lock(mtx_model_);
+  MS_LOG(DEBUG) << "UpdateConfig now.";
+  return model_->UpdateConfig(section, config);
+}
+
+bool ModelWorker::IsAvailable() {
+  bool expected = true;
+  return available_.compare_exchange_strong(expected, false);
 }
 
 void ModelWorker::CreateThreadWorker(const char *model_buf, size_t size,
                                      const std::shared_ptr<WorkerConfig> &worker_config,
                                      const std::shared_ptr<PredictTaskQueue> &predict_task_queue,
-                                     bool *create_success) {
-  worker_config_ = worker_config;
-  MS_LOG(DEBUG) << "worker bind core id list: " << worker_config_->context->GetThreadAffinityCoreList();
-  MS_LOG(DEBUG) << "worker thread num: " << worker_config_->context->GetThreadNum();
+                                     std::atomic_bool *create_success) {
   predict_task_queue_ = predict_task_queue;
-  numa::NUMAAdapter::GetInstance()->Bind(worker_config_->numa_id);
-  auto status = Init(model_buf, size);
+  auto status = CreateModel(model_buf, size, worker_config, create_success);
   if (status != kSuccess) {
-    PrintWorkerInfo();
-    MS_LOG(ERROR) << "init failed in model worker.";
-    *create_success = false;
-    create_work_done_ = true;
-    create_work_done_condition_.notify_one();
+    return;
   }
   Run();
 }
 
 void ModelWorker::Run() {
-  int task_queue_id = worker_config_->task_queue_id;
-  create_work_done_ = true;
-  create_work_done_condition_.notify_one();
+  int task_queue_id = config_->task_queue_id;
   while (!predict_task_queue_->IsPredictTaskDone()) {
     auto task = predict_task_queue_->GetPredictTask(task_queue_id, this);
     if (task == nullptr) {
@@ -79,7 +122,7 @@ void ModelWorker::Run() {
     auto after = task->after;
     auto status = Predict(*inputs, outputs, before, after);
     if (status != kSuccess) {
-      PrintWorkerInfo();
+      PrintThreadInfo();
       MS_LOG(ERROR) << "model predict failed.";
       task->ready = true;
       predict_task_queue_->ActiveTask(task);
@@ -90,47 +133,6 @@ void ModelWorker::Run() {
   }
 }
 
-Status ModelWorker::Init(const char *model_buf, size_t size) {
-  MS_CHECK_TRUE_MSG(model_buf != nullptr, kLiteError, "model_buf is nullptr in model worker.");
-  model_ = std::make_shared<Model>();
-  if (model_ == nullptr) {
-    MS_LOG(ERROR) << "model is nullptr.";
-    return kLiteNullptr;
-  }
-  mindspore::ModelType model_type = kMindIR_Lite;
-  for (auto &section : worker_config_->config_info) {
-    for (auto &config : section.second) {
-      auto status = model_->UpdateConfig(section.first, std::make_pair(config.first, config.second));
-      if (status != kSuccess) {
-        MS_LOG(ERROR) << "Update Config failed, status=" << status;
-        return status;
-      }
-    }
-  }
-  auto status = model_->Build(model_buf, size, model_type, worker_config_->context);
-  if (status != kSuccess) {
-    MS_LOG(ERROR) << "model build failed in ModelPool Init";
-    return status;
-  }
-  origin_worker_inputs_ = model_->GetInputs();
-  origin_worker_outputs_ = model_->GetOutputs();
-  if (origin_worker_outputs_.empty() || origin_worker_outputs_.empty()) {
-    MS_LOG(ERROR) << "model worker get empty input/output.";
-    return kLiteError;
-  }
-  return kSuccess;
-}
-
-Status ModelWorker::UpdateConfig(const std::string &section, const std::pair<std::string, std::string> &config) {
-  std::lock_guard<std::mutex> worker_lock(mtx_worker_);
-  MS_LOG(DEBUG) << "UpdateConfig now.";
-  return model_->UpdateConfig(section, config);
-}
-
-std::vector<MSTensor> ModelWorker::GetInputs() { return origin_worker_inputs_; }
-
-std::vector<MSTensor> ModelWorker::GetOutputs() { return origin_worker_outputs_; }
-
 std::pair<std::vector<std::vector<int64_t>>, bool> ModelWorker::GetModelResize(
   const std::vector<MSTensor> &model_inputs, const std::vector<MSTensor> &inputs) {
   std::vector<std::vector<int64_t>> dims;
@@ -169,11 +171,11 @@ Status ModelWorker::CopyOutputTensor(std::vector<MSTensor> model_outputs, std::v
 
 Status ModelWorker::Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                             const MSKernelCallBack &before, const MSKernelCallBack &after) {
-  std::lock_guard<std::mutex> worker_lock(mtx_worker_);
+  std::lock_guard<std::mutex> worker_lock(mtx_model_);
   available_ = false;
   auto model_input = model_->GetInputs();
   if (model_input.size() != inputs.size()) {
-    PrintWorkerInfo();
+    PrintThreadInfo();
     MS_LOG(ERROR) << "model input size is: " << model_input.size() << ", but get input size is: " << inputs.size();
     available_ = true;
     return kLiteError;
@@ -185,7 +187,7 @@ Status ModelWorker::Predict(const std::vector<MSTensor> &inputs, std::vector<MST
     auto status = model_->Resize(model_->GetInputs(), dims);
     if (status != kSuccess) {
       MS_LOG(ERROR) << "model pool resize failed.";
-      PrintWorkerInfo();
+      PrintThreadInfo();
       available_ = true;
       return kLiteError;
     }
@@ -207,7 +209,7 @@ Status ModelWorker::Predict(const std::vector<MSTensor> &inputs, std::vector<MST
   auto status = model_->Predict(model_input, &model_output, before, after);
   if (status != kSuccess) {
     MS_LOG(ERROR) << "model predict failed.";
-    PrintWorkerInfo();
+    PrintThreadInfo();
     available_ = true;
     return status;
   }
@@ -16,6 +16,8 @@
 
 #ifndef MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_MODEL_WORKER_H_
 #define MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_MODEL_WORKER_H_
+#include <atomic>
+#include <condition_variable>
 #include <queue>
 #include <string>
 #include <mutex>
@@ -39,29 +41,61 @@ struct WorkerConfig {
   Strategy strategy;
 };
 
-class ModelWorker {
+// the thread owning a model built with the worker config, shared by the model worker and the pipeline stage.
+class ModelThread {
  public:
-  ModelWorker() = default;
+  explicit ModelThread(std::string name) : name_(std::move(name)) {}
 
-  ~ModelWorker() = default;
-
-  Status Init(const char *model_buf, size_t size);
+  virtual ~ModelThread() = default;
 
   Status UpdateConfig(const std::string &section, const std::pair<std::string, std::string> &config);
 
-  std::vector<MSTensor> GetInputs();
+  std::vector<MSTensor> GetInputs() { return origin_inputs_; }
+
+  std::vector<MSTensor> GetOutputs() { return origin_outputs_; }
+
+  void WaitCreateDone();
 
-  std::vector<MSTensor> GetOutputs();
+ protected:
+  // bind the numa node and build the model in the calling thread, then notify the creator waiting in WaitCreateDone.
+  // create_success is shared by all the threads created together, which is only set to false.
+  Status CreateModel(const char *model_buf, size_t size, const std::shared_ptr<WorkerConfig> &config,
+                     std::atomic_bool *create_success);
+
+  void PrintThreadInfo();
+
+ protected:
+  std::shared_ptr<mindspore::Model> model_ = nullptr;
+  std::shared_ptr<WorkerConfig> config_ = nullptr;
+  std::vector<MSTensor> origin_inputs_;
+  std::vector<MSTensor> origin_outputs_;
+  std::mutex mtx_model_;
+
+ private:
+  Status InitModel(const char *model_buf, size_t size);
+
+ private:
+  std::string name_;
+  // Init thread
+  bool create_done_ = false;
+  std::mutex create_done_mutex_;
+  std::condition_variable create_done_condition_;
+};
+
+class ModelWorker : public ModelThread {
+ public:
+  ModelWorker() : ModelThread("model worker") {}
+
+  ~ModelWorker() override = default;
 
   Status Predict(const std::vector<MSTensor> &inputs, std::vector<MSTensor> *outputs,
                  const MSKernelCallBack &before = nullptr, const MSKernelCallBack &after = nullptr);
 
-  void WaitCreateWorkerDone();
-
   bool IsAvailable();
 
   void CreateThreadWorker(const char *model_buf, size_t size, const std::shared_ptr<WorkerConfig> &worker_config,
-                          const std::shared_ptr<PredictTaskQueue> &predict_task_queue, bool *create_success);
+                          const std::shared_ptr<PredictTaskQueue> &predict_task_queue,
+                          std::atomic_bool *create_success);
 
  private:
   void Run();
@@ -71,20 +105,9 @@ class ModelWorker {
 
   Status CopyOutputTensor(std::vector<MSTensor> model_outputs, std::vector<MSTensor> *user_outputs);
 
-  void PrintWorkerInfo();
-
  private:
-  std::shared_ptr<mindspore::Model> model_ = nullptr;
-  std::shared_ptr<WorkerConfig> worker_config_ = nullptr;
   std::shared_ptr<PredictTaskQueue> predict_task_queue_ = nullptr;
-  std::vector<MSTensor> origin_worker_inputs_;
-  std::vector<MSTensor> origin_worker_outputs_;
-  // Init worker
-  bool create_work_done_ = false;
-  std::mutex create_work_done_mutex_;
-  std::condition_variable create_work_done_condition_;
   // run
-  std::mutex mtx_worker_;
   std::atomic_bool available_ = true;
 };
 }  // namespace mindspore
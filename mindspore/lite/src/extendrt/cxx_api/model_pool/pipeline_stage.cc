@@ -0,0 +1,185 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "src/extendrt/cxx_api/model_pool/pipeline_stage.h"
+#include "src/common/log_adapter.h"
+#include "src/common/utils.h"
+namespace mindspore {
+namespace {
+constexpr size_t kNumMaxStageQueueSize = 1000;
+constexpr uint64_t kUtilizationLogIntervalUs = 60 * 1000 * 1000;
+}  // namespace
+
+Status PipelineStage::Init() {
+  if (!task_queue_.Init(kNumMaxStageQueueSize + 1)) {
+    MS_LOG(ERROR) << "HQueue init failed.";
+    return kLiteError;
+  }
+  return kSuccess;
+}
+
+void PipelineStage::CreateThreadStage(const char *model_buf, size_t size,
+                                      const std::shared_ptr<WorkerConfig> &stage_config,
+                                      std::atomic_bool *create_success) {
+  auto status = CreateModel(model_buf, size, stage_config, create_success);
+  if (status != kSuccess) {
+    return;
+  }
+  create_time_us_ = lite::GetTimeUs();
+  last_log_time_us_ = create_time_us_;
+  Run();
+}
+
+void PipelineStage::PushTask(PipelineTask *task) {
+  while (!task_queue_.Enqueue(task)) {
+  }
+  // take the lock so that the notification is not lost between the empty check and the wait of the stage thread
+  std::lock_guard<std::mutex> task_lock(mtx_task_);
+  task_push_cond_.notify_one();
+}
+
+PipelineTask *PipelineStage::PopTask() {
+  std::unique_lock<std::mutex> task_lock(mtx_task_);
+  while (task_queue_.Empty() && !stop_) {
+    task_push_cond_.wait(task_lock);
+  }
+  return task_queue_.Dequeue();
+}
+
+void PipelineStage::Stop() {
+  std::lock_guard<std::mutex> task_lock(mtx_task_);
+  stop_ = true;
+  task_push_cond_.notify_all();
+}
+
+void PipelineStage::FinishTask(PipelineTask *task) {
+  std::lock_guard<std::mutex> task_done_lock(task->task_done_mutex);
+  task->ready = true;
+  task->task_done_condition.notify_one();
+}
+
+void PipelineStage::WaitTaskDone(PipelineTask *task) {
+  std::unique_lock<std::mutex> task_done_lock(task->task_done_mutex);
+  while (!task->ready) {
+    task->task_done_condition.wait(task_done_lock);
+  }
+  task->ready = false;
+}
+
+void PipelineStage::LogUtilization(uint64_t now_us) {
+  if (now_us - last_log_time_us_ < kUtilizationLogIntervalUs) {
+    return;
+  }
+  last_log_time_us_ = now_us;
+  MS_LOG(INFO) << "pipeline stage id: " << config_->worker_id << " | stage task num: " << task_num_
+               << " | stage utilization: " << Utilization();
+}
+
+float PipelineStage::Utilization() const {
+  uint64_t create_time_us = create_time_us_;
+  if (create_time_us == 0) {
+    return 0.0f;
+  }
+  auto elapsed_us = lite::GetTimeUs() - create_time_us;
+  if (elapsed_us == 0) {
+    return 0.0f;
+  }
+  return static_cast<float>(busy_time_us_) / static_cast<float>(elapsed_us);
+}
+
+void PipelineStage::Run() {
+  while (!stop_) {
+    auto task = PopTask();
+    if (task == nullptr) {
+      continue;
+    }
+    auto begin_time_us = lite::GetTimeUs();
+    auto status = RunTask(task);
+    auto end_time_us = lite::GetTimeUs();
+    busy_time_us_ += end_time_us - begin_time_us;
+    task_num_++;
+    LogUtilization(end_time_us);
+    if (status != kSuccess) {
+      PrintThreadInfo();
+      MS_LOG(ERROR) << "pipeline stage run task failed.";
+      task->status = status;
+      FinishTask(task);
+      continue;
+    }
+    if (next_stage_ == nullptr) {
+      FinishTask(task);
+    } else {
+      next_stage_->PushTask(task);
+    }
+  }
+}
+
+Status PipelineStage::RunTask(PipelineTask *task) {
+  std::lock_guard<std::mutex> stage_lock(mtx_model_);
+  auto model_inputs = model_->GetInputs();
+  std::vector<MSTensor> inputs;
+  for (auto &model_input : model_inputs) {
+    auto iter = task->tensors.find(model_input.Name());
+    if (iter == task->tensors.end()) {
+      MS_LOG(ERROR) << "input " << model_input.Name() << " of stage " << config_->worker_id
+                    << " is not found in the pipeline task.";
+      return kLiteError;
+    }
+    inputs.push_back(iter->second);
+  }
+  bool need_resize = false;
+  std::vector<std::vector<int64_t>> dims;
+  for (size_t i = 0; i < model_inputs.size(); i++) {
+    if (model_inputs[i].Shape() != inputs[i].Shape()) {
+      need_resize = true;
+    }
+    dims.push_back(inputs[i].Shape());
+  }
+  if (need_resize) {
+    auto status = model_->Resize(model_inputs, dims);
+    if (status != kSuccess) {
+      MS_LOG(ERROR) << "pipeline stage resize failed.";
+      return status;
+    }
+  }
+  for (size_t i = 0; i < model_inputs.size(); i++) {
+    model_inputs[i].SetData(inputs[i].MutableData());
+  }
+  auto model_outputs = model_->GetOutputs();
+  auto status = model_->Predict(model_inputs, &model_outputs, task->before, task->after);
+  for (size_t i = 0; i < model_inputs.size(); i++) {
+    model_inputs[i].SetData(nullptr);
+  }
+  if (status != kSuccess) {
+    MS_LOG(ERROR) << "model predict failed in pipeline stage.";
+    return status;
+  }
+  // the output buffers of the model are reused by the next task, so the later stages get a copy
+  for (auto &output : model_outputs) {
+    auto copy_tensor = mindspore::MSTensor::CreateTensor(output.Name(), output.DataType(), output.Shape(),
+                                                         output.MutableData(), output.DataSize());
+    if (copy_tensor == nullptr) {
+      MS_LOG(ERROR) << "pipeline stage copy output tensor failed.";
+      return kLiteError;
+    }
+    task->tensors[output.Name()] = *copy_tensor;
+    delete copy_tensor;
+  }
+  for (auto &name : release_tensors_) {
+    (void)task->tensors.erase(name);
+  }
+  return kSuccess;
+}
+}  // namespace mindspore
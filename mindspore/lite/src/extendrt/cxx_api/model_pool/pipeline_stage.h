@@ -0,0 +1,96 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PIPELINE_STAGE_H_
+#define MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PIPELINE_STAGE_H_
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "include/api/model.h"
+#include "src/extendrt/cxx_api/model_pool/model_worker.h"
+#include "thread/hqueue.h"
+namespace mindspore {
+// one micro batch flowing through the pipeline stages
+struct PipelineTask {
+  // the inputs of the first stage and the outputs of the finished stages, found by tensor name
+  std::map<std::string, MSTensor> tensors;
+  MSKernelCallBack before = nullptr;
+  MSKernelCallBack after = nullptr;
+  Status status = kSuccess;
+  std::atomic_bool ready{false};
+  std::condition_variable task_done_condition;
+  std::mutex task_done_mutex;
+};
+
+class PipelineStage : public ModelThread {
+ public:
+  PipelineStage() : ModelThread("pipeline stage") {}
+
+  ~PipelineStage() override = default;
+
+  Status Init();
+
+  // thread function of the stage: bind the numa node, build the stage model and run the tasks pushed to the stage.
+  void CreateThreadStage(const char *model_buf, size_t size, const std::shared_ptr<WorkerConfig> &stage_config,
+                         std::atomic_bool *create_success);
+
+  void SetNextStage(PipelineStage *next_stage) { next_stage_ = next_stage; }
+
+  // the tensors which are not used by the later stages, erased from the task after running the stage
+  void SetReleaseTensors(const std::vector<std::string> &names) { release_tensors_ = names; }
+
+  void PushTask(PipelineTask *task);
+
+  void Stop();
+
+  static void WaitTaskDone(PipelineTask *task);
+
+  // ratio of the time spent running the stage model to the time since the stage was created
+  float Utilization() const;
+
+  size_t TaskNum() const { return task_num_; }
+
+ private:
+  void Run();
+
+  PipelineTask *PopTask();
+
+  Status RunTask(PipelineTask *task);
+
+  static void FinishTask(PipelineTask *task);
+
+  void LogUtilization(uint64_t now_us);
+
+ private:
+  PipelineStage *next_stage_ = nullptr;
+  std::vector<std::string> release_tensors_;
+  // run
+  HQueue<PipelineTask> task_queue_;
+  std::mutex mtx_task_;
+  std::condition_variable task_push_cond_;
+  std::atomic_bool stop_{false};
+  // utilization
+  std::atomic<uint64_t> create_time_us_{0};
+  std::atomic<uint64_t> busy_time_us_{0};
+  std::atomic<size_t> task_num_{0};
+  uint64_t last_log_time_us_ = 0;
+};
+}  // namespace mindspore
+#endif  // MINDSPORE_LITE_SRC_EXTENDRT_CXX_API_MODEL_POOL_PIPELINE_STAGE_H_
@@ -141,7 +141,7 @@ Status ModelImpl::Build() {
 
   auto create_callback = CreateTrainSessionCallbackHolder();
   if (create_callback != nullptr) {
-    auto session = create_callback(graph_->graph_data_, cfg_, inner_context);
+    auto session = create_callback(graph_->graph_data_, cfg_, inner_context, &config_info_);
     if (session != nullptr) {
       session_ = session;
       MS_LOG(DEBUG) << "Build model success.";
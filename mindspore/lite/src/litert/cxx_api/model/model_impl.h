@@ -44,9 +44,9 @@ void clearVectorOfPointers(std::vector<T> *v) {
 
 namespace mindspore {
 
-typedef std::shared_ptr<lite::LiteSession>(CreateTrainSessionProto)(std::shared_ptr<Graph::GraphData> graph_data,
-                                                                    std::shared_ptr<TrainCfg> cfg,
-                                                                    lite::InnerContext *context);
+typedef std::shared_ptr<lite::LiteSession>(CreateTrainSessionProto)(
+  std::shared_ptr<Graph::GraphData> graph_data, std::shared_ptr<TrainCfg> cfg, lite::InnerContext *context,
+  const std::map<std::string, std::map<std::string, std::string>> *config_info);
 CreateTrainSessionProto *CreateTrainSessionCallbackHolder(CreateTrainSessionProto *proto = nullptr);
 
 using ExpressionLoader = std::function<Status(const char *, Graph *)>;
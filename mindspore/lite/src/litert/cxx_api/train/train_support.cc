@@ -14,7 +14,9 @@
  * limitations under the License.
  */
 
+#include <map>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <algorithm>
 #include "include/api/types.h"
@@ -40,8 +42,9 @@
 #include "src/train/static_allocator.h"
 
 namespace mindspore {
-std::shared_ptr<lite::LiteSession> CreateTrainSession(std::shared_ptr<Graph::GraphData> graph_data,
-                                                      std::shared_ptr<TrainCfg> cfg, lite::InnerContext *context) {
+std::shared_ptr<lite::LiteSession> CreateTrainSession(
+  std::shared_ptr<Graph::GraphData> graph_data, std::shared_ptr<TrainCfg> cfg, lite::InnerContext *context,
+  const std::map<std::string, std::map<std::string, std::string>> *config_info) {
   MS_CHECK_TRUE_MSG(graph_data != nullptr, nullptr, "graph data cannot be nullptr");
   bool is_train_session = graph_data->IsTrainModel();
   if (is_train_session) {
@@ -73,6 +76,7 @@ std::shared_ptr<lite::LiteSession> CreateTrainSession(std::shared_ptr<Graph::Gra
       }
     }
 
+    session->SetConfigInfo(config_info);
     auto ret = session->TrainInit(context, &train_cfg);
     if (ret != mindspore::lite::RET_OK) {
       MS_LOG(ERROR) << "init session failed";
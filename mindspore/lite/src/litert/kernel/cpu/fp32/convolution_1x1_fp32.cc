@@ -64,7 +64,16 @@ void Convolution1x1CPUKernel::InitConv1x1MatmulParam() {
 }
 
 int Convolution1x1CPUKernel::InitConv1x1Param() {
-  if ((matmul_param_->row_ > (row_tile_ * op_parameter_->thread_num_)) && (matmul_param_->row_ > matmul_param_->col_)) {
+  if (weight_sparse_) {
+    // the output is written by the sparse kernel directly, and the threads are cut by the blocks of output channel.
+    multi_thread_by_hw_ = false;
+    thread_count_ = MSMIN(op_parameter_->thread_num_, UP_DIV(matmul_param_->col_, C8NUM));
+    if (thread_count_ <= 0) {
+      MS_LOG(ERROR) << "thread_count_ must be greater than 0!";
+      return RET_ERROR;
+    }
+  } else if ((matmul_param_->row_ > (row_tile_ * op_parameter_->thread_num_)) &&
+             (matmul_param_->row_ > matmul_param_->col_)) {
     multi_thread_by_hw_ = true;
     thread_count_ = MSMIN(op_parameter_->thread_num_, UP_DIV(matmul_param_->row_, row_tile_));
     if (thread_count_ <= 0) {
@@ -127,11 +136,19 @@ int Convolution1x1CPUKernel::Prepare() {
     int size = input_channel * UP_ROUND(output_channel, col_tile_) * sizeof(float);
     set_workspace_size(size);
   }
+  // the sparse kernel writes the output of nhwc, with the rows read from the input directly.
+  weight_sparse_ = !op_parameter_->is_train_session_ && conv_param_->group_ == 1 && origin_weight_ != nullptr &&
+                   out_tensors_.front()->format() != NC4HW4 &&
+                   SparseWeightFp32::IsBlockSparse(in_tensors_.at(kWeightIndex));
   int error_code = InitConvWeightBias();
   if (error_code != RET_OK) {
     MS_LOG(ERROR) << "Convolution1x1 init weight and bias failed.";
     return error_code;
   }
+  if (weight_sparse_ && sparse_weight_.block_num() == 0) {
+    MS_LOG(ERROR) << "Convolution1x1 pack sparse weight failed.";
+    return RET_ERROR;
+  }
   return RET_OK;
 }
 
@@ -222,9 +239,54 @@ int Convolution1x1RunHw(void *cdata, int task_id, float lhs_scale, float rhs_sca
   return RET_OK;
 }
 
+int Convolution1x1CPUKernel::DoConv1x1Sparse(int task_id) {
+  int block_num = sparse_weight_.block_num();
+  int block_stride = UP_DIV(block_num, thread_count_);
+  int start_block = task_id * block_stride;
+  int end_block = MSMIN(block_num, start_block + block_stride);
+  sparse_weight_.Run(input_ptr_, reinterpret_cast<float *>(bias_data_), output_ptr_, matmul_param_->act_type_,
+                     matmul_param_->row_, start_block, end_block);
+  return RET_OK;
+}
+
+int Convolution1x1RunSparse(void *cdata, int task_id, float lhs_scale, float rhs_scale) {
+  auto conv1x1 = reinterpret_cast<Convolution1x1CPUKernel *>(cdata);
+  auto error_code = conv1x1->DoConv1x1Sparse(task_id);
+  if (error_code != RET_OK) {
+    MS_LOG(ERROR) << "Convolution1x1RunSparse error task_id[" << task_id << "] error_code[" << error_code << "]";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+int Convolution1x1CPUKernel::RunSparseWeight() {
+  auto src_in = reinterpret_cast<float *>(in_tensors_[0]->data());
+  auto src_out = reinterpret_cast<float *>(out_tensors_[0]->data());
+  CHECK_NULL_RETURN(src_in);
+  CHECK_NULL_RETURN(src_out);
+  for (int batch_index = 0; batch_index < conv_param_->input_batch_; batch_index++) {
+    output_ptr_ = src_out + batch_index * matmul_param_->row_ * matmul_param_->col_;
+    auto tmp_in = src_in + batch_index * conv_param_->input_h_ * conv_param_->input_w_ * conv_param_->input_channel_;
+    if (pre_trans_input_) {
+      Conv1x1InputPack(tmp_in, input_ptr_, conv_param_, sizeof(float));
+    } else {
+      input_ptr_ = tmp_in;
+    }
+    auto ret = ParallelLaunch(this->ms_context_, Convolution1x1RunSparse, this, thread_count_);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Convolution1x1RunSparse failed.";
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
 int Convolution1x1CPUKernel::Run() {
   CHECK_NULL_RETURN(in_tensors_[0]);
   CHECK_NULL_RETURN(out_tensors_[0]);
+  if (weight_sparse_) {
+    return RunSparseWeight();
+  }
   auto src_in = reinterpret_cast<float *>(in_tensors_[0]->data());
   auto src_out = reinterpret_cast<float *>(out_tensors_[0]->data());
   CHECK_NULL_RETURN(src_in);
@@ -286,6 +348,13 @@ void Convolution1x1CPUKernel::PackWeight() {
 
   void *origin_weight = (op_parameter_->is_train_session_) ? filter_tensor->data() : origin_weight_;
   MS_ASSERT(origin_weight != nullptr);
+  if (weight_sparse_) {
+    // the filter is [output_channel, input_channel], which is the weight of deep major.
+    if (sparse_weight_.Pack(reinterpret_cast<float *>(origin_weight), input_channel, output_channel, true) != RET_OK) {
+      MS_LOG(ERROR) << "pack sparse weight failed.";
+    }
+    return;
+  }
 #ifdef ENABLE_AVX
   RowMajor2Col16Major(reinterpret_cast<float *>(origin_weight), reinterpret_cast<float *>(packed_weight_),
                       output_channel, input_channel);
@@ -304,7 +373,7 @@ int Convolution1x1CPUKernel::MallocWeightBiasData() {
   auto output_channel = filter_tensor->Batch();
   MS_CHECK_TRUE_RET(input_channel > 0 && output_channel > 0, RET_ERROR);
   int size = input_channel * UP_ROUND(output_channel, col_tile_) * sizeof(float);
-  if (!op_parameter_->is_train_session_) {
+  if (!op_parameter_->is_train_session_ && !weight_sparse_) {
     CHECK_LESS_RETURN(MAX_MALLOC_SIZE, size);
     packed_weight_ =
       lite::PackWeightManager::GetInstance()->GetPackData(in_tensors_[1]->data(), size, &weight_is_packed_);
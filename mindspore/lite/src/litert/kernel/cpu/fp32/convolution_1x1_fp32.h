@@ -28,6 +28,7 @@
 #include "nnacl/fp32/common_func_fp32.h"
 #include "nnacl/matmul_parameter.h"
 #include "nnacl/fp32/matmul_fp32.h"
+#include "src/litert/kernel/cpu/fp32/sparse_weight_fp32.h"
 
 namespace mindspore::kernel {
 class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
@@ -44,6 +45,7 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
  public:
   int DoConv1x1(int task_id);
   int DoConv1x1Hw(int task_id);
+  int DoConv1x1Sparse(int task_id);
 
  private:
   int InitConv1x1Param();
@@ -52,6 +54,7 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
   void PackWeight() override;
   void FreeTmpBuffer();
   void PackMatmulInput(const float *src_ptr, float *dst_ptr, int row, int col) const;
+  int RunSparseWeight();
 
  private:
   MatMulParameter *matmul_param_ = nullptr;
@@ -64,6 +67,9 @@ class Convolution1x1CPUKernel : public ConvolutionBaseCPUKernel {
   float *output_ptr_ = nullptr;
   int row_tile_ = 0;
   int col_tile_ = 0;
+  // the weight encoded as block-sparse by the converter, which is run by its non-zero blocks of 8 output channels.
+  bool weight_sparse_ = false;
+  SparseWeightFp32 sparse_weight_;
 };
 }  // namespace mindspore::kernel
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_CONVOLUTION_1X1_FP32_H_
@@ -15,6 +15,9 @@
  */
 
 #include "src/litert/kernel/cpu/fp32/convolution_delegate_fp32.h"
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include "src/litert/kernel_registry.h"
 #include "src/litert/kernel/cpu/fp32/convolution_fp32.h"
 #include "src/litert/kernel/cpu/fp32/convolution_1x1_fp32.h"
@@ -24,6 +27,9 @@
 #include "src/litert/kernel/cpu/fp32/convolution_depthwise_slidewindow_x86_fp32.h"
 #include "src/litert/kernel/cpu/base/group_convolution_creator.h"
 #include "src/litert/kernel/cpu/fp32/group_convolution_fp32.h"
+#include "src/litert/pack_weight_manager.h"
+#include "src/common/common.h"
+#include "src/common/utils.h"
 #include "nnacl/base/conv_common_base.h"
 #include "schema/model_generated.h"
 #include "include/errorcode.h"
@@ -47,6 +53,28 @@ using mindspore::schema::PrimitiveType_Conv2DFusion;
 namespace mindspore::kernel {
 namespace {
 constexpr int kMaxDwConvSWSize = 32;
+constexpr int kTuningRunTimes = 3;
+
+// The output unit to tune winograd with, which is the one selected by the cost model if winograd is preferred by it,
+// otherwise the largest one supported by the shape. Return 0 if winograd is not applicable.
+int GetTuningWinogradOutputUnit(const ConvParameter *conv_param) {
+  int out_unit = 0;
+  if (CheckIfUseWinograd(&out_unit, conv_param)) {
+    return out_unit;
+  }
+  if ((conv_param->kernel_h_ == 1 && conv_param->kernel_w_ == 1) || conv_param->kernel_h_ != conv_param->kernel_w_ ||
+      conv_param->dilation_h_ != 1 || conv_param->dilation_w_ != 1 || conv_param->stride_h_ != 1 ||
+      conv_param->stride_w_ != 1 || conv_param->input_channel_ == 1) {
+    return 0;
+  }
+  out_unit = 0;
+  for (int unit = C2NUM; unit <= conv_param->output_h_ && unit <= conv_param->output_w_; ++unit) {
+    if (CheckWinogradInputOutputUnit(unit + conv_param->kernel_w_ - 1, unit)) {
+      out_unit = unit;
+    }
+  }
+  return out_unit;
+}
 }  // namespace
 
 float *ConvolutionDelegateCPUKernel::CopyData(const lite::Tensor *tensor) {
@@ -214,37 +242,165 @@ bool ConvolutionDelegateCPUKernel::CheckAvxUseSWConv(const ConvParameter *conv_p
   return false;
 }
 
-kernel::LiteKernel *ConvolutionDelegateCPUKernel::CpuConvFp32NHWCKernelSelect() {
-  kernel::LiteKernel *kernel = nullptr;
+kernel::LiteKernel *ConvolutionDelegateCPUKernel::CreateConvKernel(ConvAlgorithm algorithm, OpParameter *parameter,
+                                                                   const std::vector<lite::Tensor *> &inputs,
+                                                                   const std::vector<lite::Tensor *> &outputs,
+                                                                   int out_unit) {
+  auto ctx = static_cast<const lite::InnerContext *>(this->ms_context_);
+  switch (algorithm) {
+    case kConvAlgoWinograd:
+      return new (std::nothrow)
+        kernel::ConvolutionWinogradCPUKernel(parameter, inputs, outputs, ctx, out_unit, origin_weight_, origin_bias_);
+#ifdef ENABLE_AVX
+    case kConvAlgoSlideWindow:
+      return new (std::nothrow)
+        kernel::ConvolutionSWCPUKernel(parameter, inputs, outputs, ctx, origin_weight_, origin_bias_);
+#endif
+    case kConvAlgo1x1:
+      return new (std::nothrow)
+        kernel::Convolution1x1CPUKernel(parameter, inputs, outputs, ctx, origin_weight_, origin_bias_);
+    case kConvAlgoIm2Col:
+      return new (std::nothrow)
+        kernel::ConvolutionCPUKernel(parameter, inputs, outputs, ctx, origin_weight_, origin_bias_);
+    default:
+      MS_LOG(ERROR) << "Unsupported conv algorithm " << algorithm << " for " << name_;
+      return nullptr;
+  }
+}
+
+ConvAlgorithm ConvolutionDelegateCPUKernel::SelectConvAlgorithm(int *out_unit) {
   auto conv_param = reinterpret_cast<ConvParameter *>(op_parameter_);
+  if (CheckIfUseWinograd(out_unit, conv_param)) {
+    return kConvAlgoWinograd;
+  }
+  // the 1x1 weight encoded as block-sparse by the converter runs by its non-zero blocks.
+  if (conv_param->kernel_h_ == 1 && conv_param->kernel_w_ == 1 && conv_param->group_ == 1 &&
+      SparseWeightFp32::IsBlockSparse(in_tensors_.at(kWeightIndex))) {
+    return kConvAlgo1x1;
+  }
+#ifdef ENABLE_AVX
+  if (CheckAvxUseSWConv(conv_param)) {
+    return kConvAlgoSlideWindow;
+  }
+#endif
+  if (conv_param->kernel_h_ == 1 && conv_param->kernel_w_ == 1) {
+    return kConvAlgo1x1;
+  }
+  return kConvAlgoIm2Col;
+}
 
-  int out_unit;
-  if (CheckIfUseWinograd(&out_unit, conv_param)) {
-    kernel = new (std::nothrow) kernel::ConvolutionWinogradCPUKernel(
-      op_parameter_, in_tensors_, out_tensors_, static_cast<const lite::InnerContext *>(this->ms_context_), out_unit,
-      origin_weight_, origin_bias_);
+int ConvolutionDelegateCPUKernel::BenchmarkConvAlgorithm(ConvAlgorithm algorithm, int out_unit, uint64_t *cost_us) {
+  // The candidate runs on its own copy of the parameter and the activations, so the kernel to be selected is not
+  // affected, and the parameter is freed together with the candidate.
+  auto parameter = reinterpret_cast<OpParameter *>(malloc(sizeof(ConvParameter)));
+  CHECK_NULL_RETURN(parameter);
+  (void)memcpy(parameter, op_parameter_, sizeof(ConvParameter));
+  auto input = in_tensors_.at(kInputIndex);
+  auto output = out_tensors_.at(kOutputIndex);
+  lite::Tensor tmp_input(input->data_type(), input->shape(), input->format());
+  lite::Tensor tmp_output(output->data_type(), output->shape(), output->format());
+  if (tmp_input.MallocData() != RET_OK || tmp_output.MallocData() != RET_OK) {
+    MS_LOG(ERROR) << "Malloc data for conv tuning failed.";
+    free(parameter);
+    return RET_ERROR;
+  }
+  (void)memset(tmp_input.data(), 0, tmp_input.Size());
+  auto inputs = in_tensors_;
+  inputs[kInputIndex] = &tmp_input;
+  std::vector<lite::Tensor *> outputs = {&tmp_output};
+  std::unique_ptr<kernel::LiteKernel> candidate(CreateConvKernel(algorithm, parameter, inputs, outputs, out_unit));
+  if (candidate == nullptr) {
+    free(parameter);
+    return RET_ERROR;
+  }
+  if (candidate->Prepare() != RET_OK || candidate->ReSize() != RET_OK) {
+    MS_LOG(WARNING) << "Prepare conv algorithm " << algorithm << " for tuning failed.";
+    return RET_ERROR;
+  }
+  if (candidate->workspace_size() > 0) {
+    candidate->AllocWorkspace();
+    CHECK_NULL_RETURN(candidate->workspace());
+  }
+  // The first run warms up the caches and the thread pool.
+  if (candidate->Run() != RET_OK) {
+    MS_LOG(WARNING) << "Run conv algorithm " << algorithm << " for tuning failed.";
+    return RET_ERROR;
   }
+  *cost_us = UINT64_MAX;
+  for (int i = 0; i < kTuningRunTimes; ++i) {
+    auto start = lite::GetTimeUs();
+    if (candidate->Run() != RET_OK) {
+      return RET_ERROR;
+    }
+    *cost_us = std::min(*cost_us, lite::GetTimeUs() - start);
+  }
+  return RET_OK;
+}
 
+ConvAlgorithm ConvolutionDelegateCPUKernel::TuneConvAlgorithm(int *out_unit) {
+  auto config = GetConfig(lite::kConvTuning);
+  auto file_iter = config.find(lite::kConvTuningFile);
+  if (file_iter == config.end() || file_iter->second.empty()) {
+    return kConvAlgoUnknown;
+  }
+  // The weights of the training are updated in place, and the shared packed weights are looked up by the origin ones,
+  // so neither of them can be packed by the candidates.
+  if (op_parameter_->is_train_session_ || lite::PackWeightManager::GetInstance()->IsPackDataShared()) {
+    MS_LOG(INFO) << "Conv tuning is not supported in training or with shared weights, " << name_ << " is not tuned.";
+    return kConvAlgoUnknown;
+  }
+  auto conv_param = reinterpret_cast<ConvParameter *>(op_parameter_);
+  int winograd_out_unit = GetTuningWinogradOutputUnit(conv_param);
+  auto tuning_cache = ConvTuningCache::GetInstance(file_iter->second);
+  auto key = ConvTuningCache::BuildKey(conv_param, op_parameter_->thread_num_);
+  auto algorithm = tuning_cache->Get(key);
+  if (algorithm != kConvAlgoUnknown) {
+    *out_unit = winograd_out_unit;
+    return algorithm;
+  }
+
+  std::vector<ConvAlgorithm> candidates = {kConvAlgoIm2Col};
+  if (conv_param->kernel_h_ == 1 && conv_param->kernel_w_ == 1) {
+    candidates.push_back(kConvAlgo1x1);
+  }
+  if (winograd_out_unit > 0) {
+    candidates.push_back(kConvAlgoWinograd);
+  }
 #ifdef ENABLE_AVX
-  if (kernel == nullptr && CheckAvxUseSWConv(conv_param)) {
-    kernel = new (std::nothrow) kernel::ConvolutionSWCPUKernel(
-      op_parameter_, in_tensors_, out_tensors_, static_cast<const lite::InnerContext *>(this->ms_context_),
-      origin_weight_, origin_bias_);
+  if (CheckAvxUseSWConv(conv_param)) {
+    candidates.push_back(kConvAlgoSlideWindow);
   }
 #endif
-
-  if (kernel == nullptr) {
-    if (conv_param->kernel_h_ == 1 && conv_param->kernel_w_ == 1) {
-      kernel = new (std::nothrow) kernel::Convolution1x1CPUKernel(
-        op_parameter_, in_tensors_, out_tensors_, static_cast<const lite::InnerContext *>(this->ms_context_),
-        origin_weight_, origin_bias_);
-    } else {
-      kernel = new (std::nothrow) kernel::ConvolutionCPUKernel(
-        op_parameter_, in_tensors_, out_tensors_, static_cast<const lite::InnerContext *>(this->ms_context_),
-        origin_weight_, origin_bias_);
+  uint64_t best_cost = UINT64_MAX;
+  for (auto candidate : candidates) {
+    uint64_t cost = UINT64_MAX;
+    if (BenchmarkConvAlgorithm(candidate, winograd_out_unit, &cost) != RET_OK) {
+      continue;
+    }
+    MS_LOG(DEBUG) << "Conv " << name_ << " algorithm " << candidate << " costs " << cost << " us.";
+    if (cost < best_cost) {
+      best_cost = cost;
+      algorithm = candidate;
     }
   }
-  return kernel;
+  if (algorithm == kConvAlgoUnknown) {
+    MS_LOG(WARNING) << "All the conv algorithms fail to run for tuning, " << name_ << " is not tuned.";
+    return kConvAlgoUnknown;
+  }
+  MS_LOG(INFO) << "Conv " << name_ << " is tuned to algorithm " << algorithm << ", which costs " << best_cost << " us.";
+  tuning_cache->Put(key, algorithm);
+  *out_unit = winograd_out_unit;
+  return algorithm;
+}
+
+kernel::LiteKernel *ConvolutionDelegateCPUKernel::CpuConvFp32NHWCKernelSelect() {
+  int out_unit = 0;
+  auto algorithm = TuneConvAlgorithm(&out_unit);
+  if (algorithm == kConvAlgoUnknown) {
+    algorithm = SelectConvAlgorithm(&out_unit);
+  }
+  conv_algorithm_ = algorithm;
+  return CreateConvKernel(algorithm, op_parameter_, in_tensors_, out_tensors_, out_unit);
 }
 
 kernel::LiteKernel *ConvolutionDelegateCPUKernel::CpuConvFp32KernelSelect() {
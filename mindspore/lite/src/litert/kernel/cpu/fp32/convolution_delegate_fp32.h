@@ -18,6 +18,7 @@
 
 #include <vector>
 #include "src/litert/lite_kernel.h"
+#include "src/litert/kernel/cpu/fp32/convolution_tuning_fp32.h"
 #include "nnacl/conv_parameter.h"
 #include "nnacl/op_base.h"
 
@@ -85,6 +86,14 @@ class ConvolutionDelegateCPUKernel : public LiteKernel {
   kernel::LiteKernel *CpuConvFp32NC4KernelSelect();
   kernel::LiteKernel *CpuConvFp32NHWCKernelSelect();
   bool CheckAvxUseSWConv(const ConvParameter *conv_param);
+  kernel::LiteKernel *CreateConvKernel(ConvAlgorithm algorithm, OpParameter *parameter,
+                                       const std::vector<lite::Tensor *> &inputs,
+                                       const std::vector<lite::Tensor *> &outputs, int out_unit);
+  ConvAlgorithm SelectConvAlgorithm(int *out_unit);
+  // Select the algorithm by benchmarking the applicable ones when the tuning file is configured, and the result is
+  // saved in the tuning file for the later sessions. Return kConvAlgoUnknown if it is not tuned.
+  ConvAlgorithm TuneConvAlgorithm(int *out_unit);
+  int BenchmarkConvAlgorithm(ConvAlgorithm algorithm, int out_unit, uint64_t *cost_us);
   // If inferShape process can't complete in Init part, initialization of weight and bis will be implemented in runtime
   // via Resize() API. However,data of const tensor(weight and bias) doesn't exist anymore in runtime stage.Thus,
   // copying data of const tensor is necessary. Otherwise, just pass origin raw pointer of data.
@@ -117,6 +126,8 @@ class ConvolutionDelegateCPUKernel : public LiteKernel {
 
  protected:
   kernel::LiteKernel *conv_kernel_{nullptr};
+  // the algorithm of conv_kernel_ in the NHWC path
+  ConvAlgorithm conv_algorithm_{kConvAlgoUnknown};
   float *origin_weight_{nullptr};
   float *origin_bias_{nullptr};
   bool need_free_weight_{false};
@@ -0,0 +1,139 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32/convolution_tuning_fp32.h"
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include "src/common/log_adapter.h"
+
+namespace mindspore::kernel {
+namespace {
+#if defined(ENABLE_AVX512)
+constexpr char kInstructionSet[] = "avx512";
+#elif defined(ENABLE_AVX)
+constexpr char kInstructionSet[] = "avx";
+#elif defined(ENABLE_SSE)
+constexpr char kInstructionSet[] = "sse";
+#elif defined(ENABLE_ARM64)
+constexpr char kInstructionSet[] = "arm64";
+#elif defined(ENABLE_ARM32)
+constexpr char kInstructionSet[] = "arm32";
+#else
+constexpr char kInstructionSet[] = "c";
+#endif
+
+std::string ReadCpuModel() {
+  std::string cpu_model = "unknown";
+#if !defined(_WIN32) && !defined(MS_COMPILE_IOS)
+  std::ifstream infile("/proc/cpuinfo", std::ios::in);
+  std::string line;
+  while (getline(infile, line)) {
+    // "model name" on x86, "Hardware" on arm.
+    if (line.find("model name") != 0 && line.find("Hardware") != 0) {
+      continue;
+    }
+    auto pos = line.find(':');
+    if (pos != std::string::npos) {
+      pos = line.find_first_not_of(' ', pos + 1);
+    }
+    if (pos != std::string::npos) {
+      cpu_model = line.substr(pos);
+    }
+    break;
+  }
+#endif
+  return cpu_model;
+}
+
+const std::string &CpuModel() {
+  static const std::string cpu_model = ReadCpuModel();
+  return cpu_model;
+}
+}  // namespace
+
+ConvTuningCache *ConvTuningCache::GetInstance(const std::string &file_path) {
+  static std::mutex instances_mutex;
+  static std::map<std::string, std::unique_ptr<ConvTuningCache>> instances;
+  std::lock_guard<std::mutex> lock(instances_mutex);
+  auto &instance = instances[file_path];
+  if (instance == nullptr) {
+    instance = std::make_unique<ConvTuningCache>(file_path);
+  }
+  return instance.get();
+}
+
+std::string ConvTuningCache::BuildKey(const ConvParameter *conv_param, int thread_num) {
+  std::ostringstream key;
+  key << CpuModel() << "|" << kInstructionSet << "|" << thread_num << "|" << conv_param->input_batch_ << ","
+      << conv_param->input_h_ << "," << conv_param->input_w_ << "," << conv_param->input_channel_ << ","
+      << conv_param->output_h_ << "," << conv_param->output_w_ << "," << conv_param->output_channel_ << ","
+      << conv_param->kernel_h_ << "," << conv_param->kernel_w_ << "," << conv_param->stride_h_ << ","
+      << conv_param->stride_w_ << "," << conv_param->dilation_h_ << "," << conv_param->dilation_w_ << ","
+      << conv_param->pad_u_ << "," << conv_param->pad_d_ << "," << conv_param->pad_l_ << "," << conv_param->pad_r_
+      << "," << static_cast<int>(conv_param->act_type_);
+  return key.str();
+}
+
+void ConvTuningCache::Load() {
+  loaded_ = true;
+  std::ifstream infile(file_path_, std::ios::in);
+  if (!infile.is_open()) {
+    MS_LOG(INFO) << "The conv tuning file " << file_path_ << " does not exist, it will be created.";
+    return;
+  }
+  std::string line;
+  while (getline(infile, line)) {
+    auto pos = line.rfind('\t');
+    if (pos == std::string::npos) {
+      continue;
+    }
+    auto algorithm = std::atoi(line.substr(pos + 1).c_str());
+    if (algorithm < kConvAlgoIm2Col || algorithm > kConvAlgoSlideWindow) {
+      MS_LOG(WARNING) << "Invalid conv tuning record: " << line;
+      continue;
+    }
+    algorithms_[line.substr(0, pos)] = static_cast<ConvAlgorithm>(algorithm);
+  }
+  MS_LOG(INFO) << "Load " << algorithms_.size() << " conv tuning records from " << file_path_;
+}
+
+ConvAlgorithm ConvTuningCache::Get(const std::string &key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!loaded_) {
+    Load();
+  }
+  auto iter = algorithms_.find(key);
+  return iter == algorithms_.end() ? kConvAlgoUnknown : iter->second;
+}
+
+void ConvTuningCache::Put(const std::string &key, ConvAlgorithm algorithm) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!loaded_) {
+    Load();
+  }
+  algorithms_[key] = algorithm;
+  // Each record is appended by one write, so the records of the processes sharing the file are not interleaved.
+  std::ofstream outfile(file_path_, std::ios::out | std::ios::app);
+  if (!outfile.is_open()) {
+    MS_LOG(WARNING) << "Open conv tuning file " << file_path_ << " failed, the tuning result is not persisted.";
+    return;
+  }
+  outfile << (key + "\t" + std::to_string(static_cast<int>(algorithm)) + "\n") << std::flush;
+}
+}  // namespace mindspore::kernel
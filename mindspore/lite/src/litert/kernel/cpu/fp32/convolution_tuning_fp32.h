@@ -0,0 +1,60 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_CONVOLUTION_TUNING_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_CONVOLUTION_TUNING_FP32_H_
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "nnacl/conv_parameter.h"
+
+namespace mindspore::kernel {
+enum ConvAlgorithm : int {
+  kConvAlgoUnknown = -1,
+  kConvAlgoIm2Col = 0,
+  kConvAlgo1x1 = 1,
+  kConvAlgoWinograd = 2,
+  kConvAlgoSlideWindow = 3,
+};
+
+// The convolution algorithms selected by benchmarking, which are persisted in a text file of "key\talgorithm" lines.
+// The key is made up of the cpu model, the instruction set, the thread number and the shape of the convolution, so
+// the file can be shared by the sessions and the processes running on the same kind of machines.
+class ConvTuningCache {
+ public:
+  explicit ConvTuningCache(std::string file_path) : file_path_(std::move(file_path)) {}
+  ~ConvTuningCache() = default;
+
+  static ConvTuningCache *GetInstance(const std::string &file_path);
+  static std::string BuildKey(const ConvParameter *conv_param, int thread_num);
+
+  ConvAlgorithm Get(const std::string &key);
+  // Record the algorithm and append it to the tuning file.
+  void Put(const std::string &key, ConvAlgorithm algorithm);
+
+ private:
+  void Load();
+
+  std::string file_path_;
+  bool loaded_ = false;
+  std::mutex mutex_;
+  std::unordered_map<std::string, ConvAlgorithm> algorithms_;
+};
+}  // namespace mindspore::kernel
+
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_CONVOLUTION_TUNING_FP32_H_
@@ -27,6 +27,7 @@ namespace mindspore::kernel {
 int FullconnectionCPUKernel::Prepare() {
   CHECK_NULL_RETURN(matmul_base_);
   matmul_base_->set_name(name_);
+  matmul_base_->SetConfig(config_);
   matmul_base_->set_workspace(workspace());
   return matmul_base_->FullConnectionPrepare();
 }
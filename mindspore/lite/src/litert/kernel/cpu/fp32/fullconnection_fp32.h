@@ -94,6 +94,7 @@ class FullconnectionCPUKernel : public LiteKernel {
   int Prepare() override;
   int ReSize() override;
   int Run() override;
+  bool IsSparseWeight() const { return matmul_base_ != nullptr && matmul_base_->IsSparseWeight(); }
 
   void set_in_tensors(const std::vector<lite::Tensor *> &in_tensors) override {
     this->in_tensors_ = in_tensors;
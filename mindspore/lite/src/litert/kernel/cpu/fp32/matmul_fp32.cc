@@ -32,6 +32,7 @@ namespace mindspore::kernel {
 int MatmulCPUKernel::Prepare() {
   CHECK_NULL_RETURN(matmul_base_);
   matmul_base_->set_name(name_);
+  matmul_base_->SetConfig(config_);
   matmul_base_->set_workspace(workspace());
   return matmul_base_->MatmulPrepare();
 }
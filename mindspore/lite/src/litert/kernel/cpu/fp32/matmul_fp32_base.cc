@@ -16,9 +16,12 @@
 
 #include "src/litert/kernel/cpu/fp32/matmul_fp32_base.h"
 #include <algorithm>
+#include "nnacl/errorcode.h"
 #include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/matmul_int4_weight_fp32.h"
 #include "nnacl/fp32/pack_fp32.h"
 #include "nnacl/fp32/pack_fp32_opt.h"
+#include "src/common/utils.h"
 
 using mindspore::lite::kCHWDimNumber;
 using mindspore::lite::kHWDimNumber;
@@ -29,6 +32,12 @@ using mindspore::lite::RET_OK;
 using mindspore::schema::PrimitiveType_MatMulFusion;
 
 namespace mindspore::kernel {
+namespace {
+constexpr int kDefaultInt4GroupSize = 32;
+// the valid bound of the variance correction of the quant params, see WeightDecoder::DequantPerChannelData.
+constexpr float kMaxVarCorr = 10.0f;
+}  // namespace
+
 int MatmulRun(void *cdata, int task_id, float, float) {
   CHECK_NULL_RETURN(cdata);
   auto op = reinterpret_cast<const MatmulFp32BaseCPUKernel *>(cdata);
@@ -56,6 +65,8 @@ MatmulFp32BaseCPUKernel::~MatmulFp32BaseCPUKernel() {
   if (params_->b_const_) {
     lite::PackWeightManager::GetInstance()->Free(matrix_b_.pack_ptr);
   }
+  FreeInt4Weight();
+  sparse_weight_.Free();
 }
 
 void MatmulFp32BaseCPUKernel::InitGlobalVariable() {
@@ -101,6 +112,29 @@ int MatmulFp32BaseCPUKernel::ParallelRunByBatch(int task_id) const {
 
 int MatmulFp32BaseCPUKernel::ParallelRunByRow(int task_id) const { return RET_ERROR; }
 
+int MatmulFp32BaseCPUKernel::ParallelRunInt4Weight(int task_id) const {
+  int col_stride = UP_DIV(params_->col_, thread_count_);
+  int start_oc = task_id * col_stride;
+  int end_oc = MSMIN(params_->col_, start_oc + col_stride);
+  if (start_oc >= end_oc) {
+    return RET_OK;
+  }
+  auto a = reinterpret_cast<const float *>(in_tensors_[FIRST_INPUT]->data());
+  MatmulInt4WeightFp32(a, int4_weight_, int4_scales_, int4_mins_, int4_a_sums_, matrix_c_.pack_ptr, output_data_,
+                       params_->act_type_, row_num_, params_->deep_, params_->col_, int4_group_size_, start_oc, end_oc);
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::ParallelRunSparseWeight(int task_id) const {
+  int block_num = sparse_weight_.block_num();
+  int block_stride = UP_DIV(block_num, thread_count_);
+  int start_block = task_id * block_stride;
+  int end_block = MSMIN(block_num, start_block + block_stride);
+  auto a = reinterpret_cast<const float *>(in_tensors_[FIRST_INPUT]->data());
+  sparse_weight_.Run(a, matrix_c_.pack_ptr, output_data_, params_->act_type_, row_num_, start_block, end_block);
+  return RET_OK;
+}
+
 int MatmulFp32BaseCPUKernel::ParallelRunByOC(int task_id) const {
   int start_oc = split_points_[task_id];
   int end_oc = col_step_;
@@ -257,6 +291,132 @@ void MatmulFp32BaseCPUKernel::FreePackedMatrixB() {
   matrix_b_.pack_ptr = nullptr;
 }
 
+bool MatmulFp32BaseCPUKernel::CheckInt4WeightConditions() {
+  auto config = GetConfig(lite::kWeightInt4);
+  auto iter = config.find(lite::kWeightInt4Enable);
+  if (iter == config.end()) {
+    return false;
+  }
+  auto enable = lite::GenericParseValue<bool>(iter->second);
+  if (enable.IsNone() || !enable.Get()) {
+    return false;
+  }
+  int group_size = kDefaultInt4GroupSize;
+  iter = config.find(lite::kWeightInt4GroupSize);
+  if (iter != config.end()) {
+    auto group_size_opt = lite::GenericParseValue<int>(iter->second);
+    if (group_size_opt.IsNone() || group_size_opt.Get() <= 0 || group_size_opt.Get() % C2NUM != 0) {
+      MS_LOG(WARNING) << "The group size of int4 weight must be a positive even number, but got " << iter->second
+                      << ", the default group size " << kDefaultInt4GroupSize << " is used.";
+    } else {
+      group_size = group_size_opt.Get();
+    }
+  }
+  // matrix-a is read by row directly, and the weight of training is updated by the optimizer.
+  if (!params_->b_const_ || params_->a_const_ || params_->a_transpose_ || b_batch_ != 1 ||
+      op_parameter_->is_train_session_) {
+    MS_LOG(INFO) << name_ << " doesn't support int4 weight, it will run with fp32 weight.";
+    return false;
+  }
+  int4_group_size_ = group_size;
+  return true;
+}
+
+int MatmulFp32BaseCPUKernel::QuantizeWeightToInt4() {
+  auto weight = in_tensors_[SECOND_INPUT];
+  MS_CHECK_TRUE_MSG(weight->data() != nullptr, RET_ERROR, "matrix-b source ptr is a nullptr.");
+  int deep_half = UP_DIV(params_->deep_, C2NUM);
+  int group_num = UP_DIV(params_->deep_, int4_group_size_);
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(params_->col_, deep_half, RET_ERROR);
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(params_->col_, group_num, RET_ERROR);
+  FreeInt4Weight();
+  size_t weight_size = static_cast<size_t>(params_->col_ * deep_half);
+  size_t quant_param_size = static_cast<size_t>(params_->col_ * group_num) * sizeof(float);
+  int4_weight_ = reinterpret_cast<uint8_t *>(malloc(weight_size));
+  int4_scales_ = reinterpret_cast<float *>(malloc(quant_param_size));
+  int4_mins_ = reinterpret_cast<float *>(malloc(quant_param_size));
+  if (int4_weight_ == nullptr || int4_scales_ == nullptr || int4_mins_ == nullptr) {
+    MS_LOG(ERROR) << "malloc int4 weight failed.";
+    FreeInt4Weight();
+    return RET_ERROR;
+  }
+  if (weight->data_type() == kNumberTypeInt8) {
+    auto ret = PackQuantWeightToInt4();
+    if (ret != RET_OK) {
+      FreeInt4Weight();
+      return ret;
+    }
+  } else {
+    QuantizeWeightToInt4Fp32(reinterpret_cast<float *>(weight->data()), int4_weight_, int4_scales_, int4_mins_,
+                             params_->deep_, params_->col_, int4_group_size_, params_->b_transpose_);
+  }
+  // the source weight is not read after preparing, which the session frees once the graph is prepared.
+  MS_LOG(INFO) << name_ << " runs with int4 weight of " << weight_size + C2NUM * quant_param_size
+               << " bytes instead of the source weight of " << weight->Size() << " bytes.";
+  return RET_OK;
+}
+
+int MatmulFp32BaseCPUKernel::PackQuantWeightToInt4() {
+  auto weight = in_tensors_[SECOND_INPUT];
+  auto quant_params = weight->quant_params();
+  MS_CHECK_TRUE_MSG(!quant_params.empty(), RET_ERROR, "the quant params of matrix-b are empty.");
+  // the same dequantization as WeightDecoder::DequantData, in which the corrections only apply by channel.
+  bool per_channel = quant_params.size() != 1;
+  std::vector<float> quant_scales(params_->col_);
+  std::vector<float> quant_offsets(params_->col_);
+  for (int n = 0; n < params_->col_; ++n) {
+    const auto &quant_param = per_channel ? quant_params.at(n) : quant_params.front();
+    double var_corr = 1.0;
+    double mean_corr = 0.0;
+    if (per_channel) {
+      var_corr = (quant_param.var_corr < 0 || quant_param.var_corr > kMaxVarCorr) ? 1.0 : quant_param.var_corr;
+      mean_corr = quant_param.mean_corr;
+    }
+    quant_scales[n] = static_cast<float>(quant_param.scale * var_corr);
+    quant_offsets[n] = static_cast<float>(-quant_param.zeroPoint * quant_param.scale * var_corr + mean_corr);
+  }
+  auto ret = PackQuantWeightToInt4Fp32(reinterpret_cast<int8_t *>(weight->data()), quant_scales.data(),
+                                       quant_offsets.data(), int4_weight_, int4_scales_, int4_mins_, params_->deep_,
+                                       params_->col_, int4_group_size_, params_->b_transpose_);
+  if (ret != NNACL_OK) {
+    MS_LOG(ERROR) << "The quantized matrix-b of " << name_ << " exceeds the range of int4.";
+    return RET_ERROR;
+  }
+  return RET_OK;
+}
+
+void MatmulFp32BaseCPUKernel::FreeInt4Weight() {
+  if (int4_weight_ != nullptr) {
+    free(int4_weight_);
+    int4_weight_ = nullptr;
+  }
+  if (int4_scales_ != nullptr) {
+    free(int4_scales_);
+    int4_scales_ = nullptr;
+  }
+  if (int4_mins_ != nullptr) {
+    free(int4_mins_);
+    int4_mins_ = nullptr;
+  }
+}
+
+bool MatmulFp32BaseCPUKernel::CheckSparseWeightConditions() {
+  // the weight encoded by the converter is decoded to dense, so the other kernels can still run it. Matrix-a is read
+  // by row directly, and the weight of training is updated by the optimizer.
+  if (!params_->b_const_ || params_->a_const_ || params_->a_transpose_ || b_batch_ != 1 ||
+      op_parameter_->is_train_session_ || params_->deep_ <= 0 || params_->col_ <= 0) {
+    return false;
+  }
+  return SparseWeightFp32::IsBlockSparse(in_tensors_[SECOND_INPUT]);
+}
+
+int MatmulFp32BaseCPUKernel::PackSparseWeight() {
+  auto src_ptr = reinterpret_cast<float *>(in_tensors_[SECOND_INPUT]->data());
+  MS_CHECK_TRUE_MSG(src_ptr != nullptr, RET_ERROR, "matrix-b source ptr is a nullptr.");
+  MS_LOG(INFO) << name_ << " runs with sparse weight.";
+  return sparse_weight_.Pack(src_ptr, params_->deep_, params_->col_, params_->b_transpose_);
+}
+
 int MatmulFp32BaseCPUKernel::PackBiasMatrix() {
   if (in_tensors_.size() != FOURTH_INPUT) {
     return RET_OK;
@@ -317,8 +477,11 @@ int MatmulFp32BaseCPUKernel::Prepare() {
   CHECK_LESS_RETURN(out_tensors_.size(), 1);
   MS_CHECK_TRUE_MSG(in_tensors_[FIRST_INPUT]->data_type() == kNumberTypeFloat32, RET_ERROR,
                     "matrix-a's data type is invalid.");
-  MS_CHECK_TRUE_MSG(in_tensors_[SECOND_INPUT]->data_type() == kNumberTypeFloat32, RET_ERROR,
-                    "matrix-b's data type is invalid.");
+  // the int8 matrix-b is the weight quantized with at most 4 bits, which is kept quantized for the int4 weight.
+  bool b_quantized = in_tensors_[SECOND_INPUT]->data_type() == kNumberTypeInt8;
+  MS_CHECK_TRUE_MSG(in_tensors_[SECOND_INPUT]->data_type() == kNumberTypeFloat32 ||
+                      (b_quantized && !in_tensors_[SECOND_INPUT]->quant_params().empty()),
+                    RET_ERROR, "matrix-b's data type is invalid.");
   if (in_tensors_.size() == FOURTH_INPUT) {
     MS_CHECK_TRUE_MSG(in_tensors_[THIRD_INPUT]->IsConst(), RET_ERROR, "matrix-c must be const when existing.");
     MS_CHECK_TRUE_MSG(in_tensors_[THIRD_INPUT]->data_type() == kNumberTypeFloat32, RET_ERROR,
@@ -336,7 +499,19 @@ int MatmulFp32BaseCPUKernel::Prepare() {
     MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "pack const-matrix a failed.");
     matrix_a_.has_packed = true;
   }
-  if (params_->b_const_) {
+  weight_int4_ = CheckInt4WeightConditions();
+  if (b_quantized && !weight_int4_) {
+    MS_LOG(ERROR) << name_ << " can only run with the quantized matrix-b as int4 weight.";
+    return RET_ERROR;
+  }
+  weight_sparse_ = !weight_int4_ && CheckSparseWeightConditions();
+  if (weight_int4_) {
+    ret = QuantizeWeightToInt4();
+    MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "quantize const-matrix b to int4 failed.");
+  } else if (weight_sparse_) {
+    ret = PackSparseWeight();
+    MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "pack const-matrix b to sparse failed.");
+  } else if (params_->b_const_) {
     ret = PackMatrixB();
     MS_CHECK_TRUE_MSG(ret == RET_OK, RET_ERROR, "pack const-matrix b failed.");
     matrix_b_.has_packed = true;
@@ -445,10 +620,24 @@ int MatmulFp32BaseCPUKernel::ReSize() {
   if (op_parameter_->is_train_session_) {
     set_workspace_size((matrix_a_.pack_size + matrix_b_.pack_size) * static_cast<int>(sizeof(float)));
   }
-  ret = GetThreadCuttingPolicy();
-  if (ret != RET_OK) {
-    MS_LOG(ERROR) << "ThreadCuttingPolicy error!";
-    return ret;
+  if (weight_int4_) {
+    // the output is written by the int4 kernel directly, and the threads are cut by the output channel.
+    out_need_aligned_ = false;
+    col_step_ = params_->col_;
+    thread_count_ = MSMIN(op_parameter_->thread_num_, params_->col_);
+    parallel_fun_ = &MatmulFp32BaseCPUKernel::ParallelRunInt4Weight;
+  } else if (weight_sparse_) {
+    // the output is written by the sparse kernel directly, and the threads are cut by the blocks of output channel.
+    out_need_aligned_ = false;
+    col_step_ = params_->col_;
+    thread_count_ = MSMIN(op_parameter_->thread_num_, UP_DIV(params_->col_, C8NUM));
+    parallel_fun_ = &MatmulFp32BaseCPUKernel::ParallelRunSparseWeight;
+  } else {
+    ret = GetThreadCuttingPolicy();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "ThreadCuttingPolicy error!";
+      return ret;
+    }
   }
   if (!matrix_c_.has_packed) {
     ret = PackBiasMatrix();
@@ -676,7 +865,46 @@ void MatmulFp32BaseCPUKernel::GetThreadCuttingInfoByRow() {
   thread_count_ = split_points_.size();
 }
 
+int MatmulFp32BaseCPUKernel::RunInt4Weight() {
+  auto a = reinterpret_cast<const float *>(in_tensors_[FIRST_INPUT]->data());
+  CHECK_NULL_RETURN(a);
+  output_data_ = reinterpret_cast<float *>(out_tensors_.front()->data());
+  CHECK_NULL_RETURN(output_data_);
+  int group_num = UP_DIV(params_->deep_, int4_group_size_);
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(row_num_, group_num, RET_ERROR);
+  size_t a_sums_size = static_cast<size_t>(row_num_ * group_num) * sizeof(float);
+  int4_a_sums_ = reinterpret_cast<float *>(ms_context_->allocator->Malloc(a_sums_size));
+  MS_CHECK_TRUE_MSG(int4_a_sums_ != nullptr, RET_ERROR, "malloc the group sums of matrix-a failed.");
+  Int4WeightGroupSumFp32(a, int4_a_sums_, row_num_, params_->deep_, int4_group_size_);
+  auto ret = ParallelLaunch(this->ms_context_, MatmulRun, this, thread_count_);
+  ms_context_->allocator->Free(int4_a_sums_);
+  int4_a_sums_ = nullptr;
+  output_data_ = nullptr;
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MatmulRun failed with int4 weight";
+  }
+  return ret;
+}
+
+int MatmulFp32BaseCPUKernel::RunSparseWeight() {
+  CHECK_NULL_RETURN(in_tensors_[FIRST_INPUT]->data());
+  output_data_ = reinterpret_cast<float *>(out_tensors_.front()->data());
+  CHECK_NULL_RETURN(output_data_);
+  auto ret = ParallelLaunch(this->ms_context_, MatmulRun, this, thread_count_);
+  output_data_ = nullptr;
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MatmulRun failed with sparse weight";
+  }
+  return ret;
+}
+
 int MatmulFp32BaseCPUKernel::Run() {
+  if (weight_int4_) {
+    return RunInt4Weight();
+  }
+  if (weight_sparse_) {
+    return RunSparseWeight();
+  }
   auto out_data = reinterpret_cast<float *>(out_tensors_.front()->data());
   CHECK_NULL_RETURN(out_data);
   if (!out_need_aligned_) {
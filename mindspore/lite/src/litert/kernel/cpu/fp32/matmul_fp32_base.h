@@ -23,6 +23,7 @@
 #include "nnacl/matmul_parameter.h"
 #include "include/errorcode.h"
 #include "src/common/common.h"
+#include "src/litert/kernel/cpu/fp32/sparse_weight_fp32.h"
 
 using mindspore::lite::RET_ERROR;
 using mindspore::lite::RET_MEMORY_FAILED;
@@ -48,6 +49,7 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   int FullConnectionReSize();
   int MatmulReSize();
   int Run() override;
+  bool IsSparseWeight() const { return weight_sparse_; }
 
   using ParallelRun = int (MatmulFp32BaseCPUKernel::*)(int task_id) const;
   ParallelRun parallel_fun_ = nullptr;
@@ -66,6 +68,8 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   virtual int ParallelRunByOC(int task_id) const;
   virtual int ParallelRunByBatch(int task_id) const;
   int ParallelRunIsNotPackByBatch(int task_id) const;
+  int ParallelRunInt4Weight(int task_id) const;
+  int ParallelRunSparseWeight(int task_id) const;
   int BackupConstMatrix(MatrixInfo *matrix_info, int index);
   virtual void InitGlobalVariable();
   int PackMatrixA();
@@ -86,6 +90,14 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   void InitShapeA();
   void InitShapeB();
   int InitBroadcastParams();
+  bool CheckInt4WeightConditions();
+  int QuantizeWeightToInt4();
+  int PackQuantWeightToInt4();
+  void FreeInt4Weight();
+  int RunInt4Weight();
+  bool CheckSparseWeightConditions();
+  int PackSparseWeight();
+  int RunSparseWeight();
 
  protected:
   MatMulParameter *params_ = nullptr;
@@ -112,6 +124,16 @@ class MatmulFp32BaseCPUKernel : public LiteKernel {
   bool pack_opt_{false};  // indicate whether packing can be multi-threads, currently, only support in ARM64 && packA.
   MatrixPackFun matrix_a_pack_fun_ = nullptr;
   MatrixPackFun matrix_b_pack_fun_ = nullptr;
+  // the const matrix-b quantized to int4 by group along the deep, see nnacl/fp32/matmul_int4_weight_fp32.h.
+  bool weight_int4_{false};
+  int int4_group_size_{0};
+  uint8_t *int4_weight_{nullptr};
+  float *int4_scales_{nullptr};
+  float *int4_mins_{nullptr};
+  float *int4_a_sums_{nullptr};
+  // the const matrix-b encoded as block-sparse by the converter, kept by the non-zero blocks of 8 output channels.
+  bool weight_sparse_{false};
+  SparseWeightFp32 sparse_weight_;
 };
 }  // namespace mindspore::kernel
 #endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_MATMUL_FP32_BASE_H_
@@ -0,0 +1,81 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "src/litert/kernel/cpu/fp32/sparse_weight_fp32.h"
+#include "include/errorcode.h"
+#include "nnacl/fp32/matmul_sparse_weight_fp32.h"
+#include "schema/model_generated.h"
+
+using mindspore::lite::RET_ERROR;
+using mindspore::lite::RET_OK;
+
+namespace mindspore::kernel {
+bool SparseWeightFp32::IsBlockSparse(const lite::Tensor *weight) {
+  return weight != nullptr && weight->data_type() == kNumberTypeFloat32 && weight->data() != nullptr &&
+         weight->compress_type() == schema::WeightQuantCompressType_BLOCK_SPARSE;
+}
+
+int SparseWeightFp32::Pack(const float *src, int deep, int col, bool deep_major) {
+  MS_CHECK_TRUE_MSG(src != nullptr && deep > 0 && col > 0, RET_ERROR, "sparse weight is invalid.");
+  Free();
+  int nnz = 0;
+  int block_num = SparseWeightBlockNumFp32(src, deep, col, deep_major, &nnz);
+  MS_CHECK_INT_MUL_NOT_OVERFLOW(block_num + 1, C8NUM, RET_ERROR);
+  // one more block is allocated, so that the buffers are valid when all the values are zeros.
+  size_t value_block_num = static_cast<size_t>(block_num) + 1;
+  size_t offset_num = static_cast<size_t>(UP_DIV(col, C8NUM)) + 1;
+  values_ = reinterpret_cast<float *>(malloc(value_block_num * C8NUM * sizeof(float)));
+  depths_ = reinterpret_cast<int *>(malloc(value_block_num * sizeof(int)));
+  offsets_ = reinterpret_cast<int *>(malloc(offset_num * sizeof(int)));
+  if (values_ == nullptr || depths_ == nullptr || offsets_ == nullptr) {
+    MS_LOG(ERROR) << "malloc sparse weight failed.";
+    Free();
+    return RET_ERROR;
+  }
+  PackSparseWeightFp32(src, values_, depths_, offsets_, deep, col, deep_major);
+  deep_ = deep;
+  col_ = col;
+  MS_LOG(INFO) << "Sparse weight of " << deep << " x " << col << ", the density of the values is "
+               << static_cast<float>(nnz) / (static_cast<float>(col) * deep) << " and the density of the blocks is "
+               << static_cast<float>(block_num) / (static_cast<float>(UP_DIV(col, C8NUM)) * deep);
+  return RET_OK;
+}
+
+void SparseWeightFp32::Free() {
+  if (values_ != nullptr) {
+    free(values_);
+    values_ = nullptr;
+  }
+  if (depths_ != nullptr) {
+    free(depths_);
+    depths_ = nullptr;
+  }
+  if (offsets_ != nullptr) {
+    free(offsets_);
+    offsets_ = nullptr;
+  }
+  deep_ = 0;
+  col_ = 0;
+}
+
+void SparseWeightFp32::Run(const float *a, const float *bias, float *c, int act_type, int row, int start_block,
+                           int end_block) const {
+  if (start_block >= end_block) {
+    return;
+  }
+  MatmulSparseWeightFp32(a, values_, depths_, offsets_, bias, c, act_type, row, deep_, col_, start_block, end_block);
+}
+}  // namespace mindspore::kernel
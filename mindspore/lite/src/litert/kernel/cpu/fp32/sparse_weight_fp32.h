@@ -0,0 +1,47 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_WEIGHT_FP32_H_
+#define MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_WEIGHT_FP32_H_
+
+#include "nnacl/op_base.h"
+#include "src/tensor.h"
+
+namespace mindspore::kernel {
+// The const weight of a matmul or a 1x1 convolution kept by the non-zero blocks of 8 output channels, see
+// nnacl/fp32/matmul_sparse_weight_fp32.h. The converter encodes the weights which are sparse enough to run faster so.
+class SparseWeightFp32 {
+ public:
+  SparseWeightFp32() = default;
+  ~SparseWeightFp32() { Free(); }
+
+  static bool IsBlockSparse(const lite::Tensor *weight);
+  // src is [col, deep] if deep_major is true, otherwise [deep, col].
+  int Pack(const float *src, int deep, int col, bool deep_major);
+  void Free();
+  int block_num() const { return UP_DIV(col_, C8NUM); }
+  // c[row, col] = a[row, deep] * weight + bias, only the output channels of the blocks [start_block, end_block).
+  void Run(const float *a, const float *bias, float *c, int act_type, int row, int start_block, int end_block) const;
+
+ private:
+  int deep_ = 0;
+  int col_ = 0;
+  float *values_ = nullptr;
+  int *depths_ = nullptr;
+  int *offsets_ = nullptr;
+};
+}  // namespace mindspore::kernel
+#endif  // MINDSPORE_LITE_SRC_RUNTIME_KERNEL_CPU_FP32_SPARSE_WEIGHT_FP32_H_
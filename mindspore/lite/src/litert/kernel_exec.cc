@@ -77,6 +77,13 @@ std::string KernelExec::ToString() const {
 }
 
 int KernelExec::DoExecute() {
+  if (materializer_ != nullptr) {
+    auto ret = Materialize();
+    if (ret != lite::RET_OK) {
+      MS_LOG(ERROR) << "Materialize kernel " << this->name() << " failed: " << ret;
+      return ret;
+    }
+  }
   auto ret = kernel_->Execute();
   if ((ret == lite::RET_OK) && (desc_.provider != kBuiltin)) {
     for (auto *output : out_tensors()) {
@@ -21,6 +21,7 @@
 #include <memory>
 #include <utility>
 #include <algorithm>
+#include <functional>
 #include "src/common/utils.h"
 #include "src/common/log_util.h"
 #ifdef ENABLE_ARM
@@ -375,6 +376,20 @@ class KernelExec {
 
   bool GetOpenGLTextureEnable() { return enable_gl_texture_; }
 
+  // The lazy kernel is prepared by the materializer at its first execution instead of while compiling graph.
+  void set_materializer(const std::function<int(KernelExec *)> &materializer) { materializer_ = materializer; }
+
+  bool IsLazy() const { return materializer_ != nullptr; }
+
+  int Materialize() {
+    if (materializer_ == nullptr) {
+      return lite::RET_OK;
+    }
+    auto materializer = std::move(materializer_);
+    materializer_ = nullptr;
+    return materializer(this);
+  }
+
  protected:
   std::shared_ptr<Kernel> kernel_ = nullptr;
   KernelKey desc_;
@@ -387,6 +402,7 @@ class KernelExec {
   SubGraphType subgraph_type_ = kNotSubGraph;
   const lite::InnerContext *context_ = nullptr;
   bool enable_gl_texture_ = false;
+  std::function<int(KernelExec *)> materializer_ = nullptr;
 };
 
 typedef LiteKernel *(*KernelCreator)(const std::vector<lite::Tensor *> &inputs,
@@ -15,6 +15,7 @@
  */
 
 #include "src/litert/lite_session.h"
+#include <algorithm>
 #include <set>
 #include "src/litert/pack_weight_manager.h"
 #include "src/litert/runtime_pass.h"
@@ -65,6 +66,8 @@ extern void mindspore_log_init();
 #endif
 namespace lite {
 namespace {
+constexpr double kTimeUsToMs = 1000.0;
+
 bool ExistCustomCpuKernel() {
 #ifndef CUSTOM_KERNEL_REGISTRY_CLIP
   const std::string kArchCPU = "CPU";
@@ -224,6 +227,7 @@ lite::Tensor *LiteSession::ConvertTensor(const schema::Tensor &src_tensor) {
   if (src_tensor.name() != nullptr) {
     dst_tensor->set_tensor_name(src_tensor.name()->str());
   }
+  dst_tensor->set_compress_type(src_tensor.weightQuantCompressType());
   return dst_tensor;
 }
 
@@ -233,6 +237,10 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
   uint32_t tensor_count = model->graph_.all_tensors_.size();
   auto model_input_indices = model->graph_.input_indices_;
   auto model_output_indices = model->graph_.output_indices_;
+  std::vector<bool> lazy_decode_tensors;
+  if (lazy_materialize_) {
+    lazy_decode_tensors = GetLazyDecodeTensors(lite_model);
+  }
 
   for (uint32_t i = 0; i < tensor_count; ++i) {
     auto *src_tensor = model->graph_.all_tensors_[i];
@@ -245,7 +253,12 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
       MS_LOG(ERROR) << "Convert new " << i << "th tensor failed!";
       return RET_NULL_PTR;
     }
-    auto ret = ConvertTensorsData(lite_model, i, dst_tensor);
+    auto ret = RET_OK;
+    if (lazy_materialize_ && lazy_decode_tensors[i]) {
+      lazy_decode_tensors_[dst_tensor] = i;
+    } else {
+      ret = ConvertTensorsData(lite_model, i, dst_tensor);
+    }
     if (ret != RET_OK) {
       MS_LOG(ERROR) << "Convert data of " << i << "th tensor failed";
       delete dst_tensor;
@@ -274,6 +287,177 @@ int LiteSession::ConvertTensors(const lite::Model *model) {
   return RET_OK;
 }
 
+void LiteSession::InitLazyMaterialize(const lite::Model *model) {
+  lazy_materialize_ = false;
+  if (config_info_ == nullptr) {
+    return;
+  }
+  auto section_iter = config_info_->find(kWeight);
+  if (section_iter == config_info_->end()) {
+    return;
+  }
+  auto iter = section_iter->second.find(kWeightLazyMaterialize);
+  if (iter == section_iter->second.end() || iter->second != "true") {
+    return;
+  }
+  // the weights are read from the model buf at the first execution, and only the cpu kernels are prepared lazily.
+  bool cpu_only = std::all_of(context_->device_list_.begin(), context_->device_list_.end(),
+                              [](const DeviceContext &device) {
+                                return device.device_type_ == DT_CPU && device.provider_.empty();
+                              });
+  if (model->model_type_ != ModelType_MSLite || is_train_session_ || delegate_ != nullptr || !cpu_only ||
+      !reinterpret_cast<const lite::LiteModel *>(model)->keep_model_buf() ||
+      PackWeightManager::GetInstance()->IsPackDataShared()) {
+    MS_LOG(INFO) << "Lazy materialize is not supported by the model or the context, which is ignored.";
+    return;
+  }
+  lazy_materialize_ = true;
+  lazy_model_ = reinterpret_cast<const lite::LiteModel *>(model);
+}
+
+std::vector<bool> LiteSession::GetLazyDecodeTensors(const lite::LiteModel *model) const {
+  auto tensor_count = model->graph_.all_tensors_.size();
+  // the data of the tensor is not read while compiling only if all its consumers are packed ops not dequantized.
+  std::vector<int> consumer_state(tensor_count, 0);
+  for (auto *node : model->graph_.all_nodes_) {
+    bool lazy = IsPackedOp(node->node_type_) && node->quant_type_ != schema::QuantType_QUANT_WEIGHT &&
+                !(node->quant_type_ == schema::QuantType_QUANT_ALL && context_->float_mode);
+    for (auto index : node->input_indices_) {
+      if (index >= tensor_count) {
+        continue;
+      }
+      if (!lazy) {
+        consumer_state[index] = -1;
+      } else if (consumer_state[index] == 0) {
+        consumer_state[index] = 1;
+      }
+    }
+  }
+  std::vector<bool> lazy_decode_tensors(tensor_count, false);
+  for (size_t i = 0; i < tensor_count; ++i) {
+    if (consumer_state[i] != 1 || IsContain(model->graph_.input_indices_, static_cast<uint32_t>(i))) {
+      continue;
+    }
+    auto src_tensor = model->GetSchemaTensor(i);
+    if (src_tensor == nullptr || src_tensor->handler() == nullptr || src_tensor->data() == nullptr ||
+        src_tensor->length() == 0) {
+      continue;
+    }
+    // the float weights are cast to the data type of the subgraph while scheduling.
+    auto data_type = static_cast<TypeId>(src_tensor->handler()->dataType());
+    if (data_type == kNumberTypeFloat32 || data_type == kNumberTypeFloat16 || data_type == kObjectTypeTensorType) {
+      continue;
+    }
+    lazy_decode_tensors[i] = WeightDecoder::NeedDecompress(*src_tensor);
+  }
+  return lazy_decode_tensors;
+}
+
+int LiteSession::DecodeLazyTensors(const std::vector<Tensor *> &tensors) {
+  for (auto *tensor : tensors) {
+    auto iter = lazy_decode_tensors_.find(tensor);
+    if (iter == lazy_decode_tensors_.end()) {
+      continue;
+    }
+    auto ret = ConvertTensorsData(lazy_model_, iter->second, tensor);
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Convert data of " << iter->second << "th tensor failed";
+      return ret;
+    }
+    lazy_decode_tensors_.erase(iter);
+  }
+  return RET_OK;
+}
+
+int LiteSession::InitLazyKernels() {
+  if (!lazy_materialize_) {
+    return RET_OK;
+  }
+  std::vector<kernel::KernelExec *> eager_nodes;
+  for (auto *kernel : kernels_) {
+    if (kernel->desc().arch == kernel::kDelegate || kernel->desc().arch == kernel::kGPU) {
+      continue;
+    }
+    auto subgraph_type = kernel->subgraph_type();
+    bool cpu_subgraph = subgraph_type == kernel::kCpuFP32SubGraph || subgraph_type == kernel::kCpuFP16SubGraph;
+    for (auto *node : static_cast<kernel::SubGraphKernel *>(kernel)->nodes()) {
+      // the kernels are resized with the shapes inferred at runtime, which needs the kernels prepared.
+      if (cpu_subgraph && is_infershape_ == RET_OK && node->desc().provider == kernel::kBuiltin &&
+          IsPackedOp(static_cast<int>(node->type()))) {
+        lazy_kernels_.insert(node);
+      } else {
+        eager_nodes.push_back(node);
+      }
+    }
+  }
+  for (auto *node : eager_nodes) {
+    auto ret = DecodeLazyTensors(node->in_tensors());
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Decode the weights of node: " << node->name() << " failed.";
+      return ret;
+    }
+  }
+  for (auto *node : lazy_kernels_) {
+    for (auto *tensor : node->in_tensors()) {
+      // the weights decoded at the first execution have no data yet, which are counted as well.
+      if (tensor->IsConst() || lazy_decode_tensors_.find(tensor) != lazy_decode_tensors_.end()) {
+        lazy_tensor_ref_count_[tensor]++;
+      }
+    }
+    node->set_materializer([this](kernel::KernelExec *kernel) { return MaterializeKernel(kernel); });
+  }
+  MS_LOG(INFO) << lazy_kernels_.size() << " kernels are prepared and " << lazy_decode_tensors_.size()
+               << " tensors are decoded at their first execution.";
+  return RET_OK;
+}
+
+int LiteSession::MaterializeKernel(kernel::KernelExec *kernel) {
+  {
+    std::lock_guard<std::mutex> lock(lazy_mutex_);
+    auto ret = DecodeLazyTensors(kernel->in_tensors());
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Decode the weights of kernel: " << kernel->name() << " failed.";
+      return ret;
+    }
+  }
+  auto ret = kernel->Prepare();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "node: " << kernel->name() << " prepare failed.";
+    return ret;
+  }
+  std::lock_guard<std::mutex> lock(lazy_mutex_);
+  lazy_kernels_.erase(kernel);
+  materialized_kernel_num_++;
+  // same as FreePackOpWeight, the origin weight is freed once all the packed ops using it are prepared.
+  for (auto *tensor : kernel->in_tensors()) {
+    auto iter = lazy_tensor_ref_count_.find(tensor);
+    if (iter == lazy_tensor_ref_count_.end()) {
+      continue;
+    }
+    if (--iter->second <= 0) {
+      tensor->FreeData();
+      lazy_tensor_ref_count_.erase(iter);
+    }
+  }
+  return RET_OK;
+}
+
+int LiteSession::MaterializeLazyKernels() {
+  std::vector<kernel::KernelExec *> lazy_kernels;
+  {
+    std::lock_guard<std::mutex> lock(lazy_mutex_);
+    lazy_kernels.assign(lazy_kernels_.begin(), lazy_kernels_.end());
+  }
+  for (auto *kernel : lazy_kernels) {
+    auto ret = kernel->Materialize();
+    if (ret != RET_OK) {
+      MS_LOG(ERROR) << "Materialize kernel " << kernel->name() << " failed: " << ret;
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
 void LiteSession::InitGraphInputTensors(const lite::Model *model) {
   MS_ASSERT(model != nullptr);
   auto graph_in_size = model->graph_.input_indices_.size();
@@ -491,7 +675,8 @@ void LiteSession::FreePackOpWeight(const std::vector<kernel::KernelExec *> &kern
   for (auto *kernel : kernels) {
     MS_ASSERT(kernel != nullptr);
     if (kernel->subgraph_type() == kernel::kNotSubGraph) {
-      if (!IsPackedOp(static_cast<int>(kernel->type()))) {
+      // the weight of the lazy kernel is freed after it is prepared at its first execution.
+      if (!IsPackedOp(static_cast<int>(kernel->type())) || kernel->IsLazy()) {
         continue;
       }
     } else {
@@ -501,7 +686,8 @@ void LiteSession::FreePackOpWeight(const std::vector<kernel::KernelExec *> &kern
     auto inputs = kernel->in_tensors();
     for (auto *tensor : inputs) {
       MS_ASSERT(tensor != nullptr);
-      if (!tensor->IsConst()) {
+      // the weight shared with a lazy kernel is freed after the lazy kernel is prepared.
+      if (!tensor->IsConst() || lazy_tensor_ref_count_.find(tensor) != lazy_tensor_ref_count_.end()) {
         continue;
       }
       tensor->FreeData();
@@ -516,6 +702,8 @@ int LiteSession::CompileGraph(Model *model) {
     is_running_.store(false);
     return ret;
   }
+  compile_begin_time_ = GetTimeUs();
+  InitLazyMaterialize(model);
 
   if (model->model_type_ != ModelType_MSLite) {
     ret = reinterpret_cast<AbstractBaseModel *>(model)->ConvertTensors(&this->tensors_);
@@ -579,6 +767,7 @@ int LiteSession::CompileGraph(Model *model) {
     return ret;
   }
 
+  compile_end_time_ = GetTimeUs();
   is_running_.store(false);
 #if defined(LINUX_RUNTIME)
   (void)malloc_trim(0);
@@ -629,6 +818,11 @@ int LiteSession::PrepareKernels(const Model *model) {
     MS_LOG(ERROR) << "SetTensorInitRefCount failed.";
     return ret;
   }
+  ret = InitLazyKernels();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "InitLazyKernels failed.";
+    return ret;
+  }
 
   for (auto kernel : this->kernels_) {
     if (kernel->desc().arch == kernel::kDelegate) {
@@ -646,6 +840,9 @@ int LiteSession::PrepareKernels(const Model *model) {
         return RET_ERROR;
       }
       for (auto &node : subgraph_kernel->nodes()) {
+        if (node->IsLazy()) {
+          continue;
+        }
         ret = node->Prepare();
         if (ret != RET_OK) {
           MS_LOG(ERROR) << "node: " << node->name() << " prepare failed.";
@@ -723,9 +920,17 @@ int LiteSession::RunGraph(const KernelCallBack &before, const KernelCallBack &af
     return ret;
   }
   MS_ASSERT(this->context_ != nullptr);
+  auto run_begin_time = first_run_done_ ? 0 : GetTimeUs();
   ret = executor_->Run(this->inputs_, this->outputs_, this->kernels_, before, after);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "RunGraph failed : " << ret;
+  } else if (!first_run_done_) {
+    first_run_done_ = true;
+    auto run_end_time = GetTimeUs();
+    MS_LOG(INFO) << "Time to first inference: " << (run_end_time - compile_begin_time_) / kTimeUsToMs
+                 << " ms, in which compiling takes " << (compile_end_time_ - compile_begin_time_) / kTimeUsToMs
+                 << " ms and the first run takes " << (run_end_time - run_begin_time) / kTimeUsToMs << " ms, "
+                 << materialized_kernel_num_ << " kernels are materialized in the first run.";
   }
   is_running_.store(false);
   return ret;
@@ -1154,6 +1359,127 @@ int LiteSession::BindGLTexture2DMemory(const std::map<std::string, unsigned int>
   return RET_OK;
 }
 
+void LiteSession::InitResizePlanConfig() {
+  if (resize_plan_config_inited_) {
+    return;
+  }
+  resize_plan_config_inited_ = true;
+  if (config_info_ == nullptr) {
+    return;
+  }
+  auto section_iter = config_info_->find(kResizePlan);
+  if (section_iter == config_info_->end()) {
+    return;
+  }
+  const auto &config = section_iter->second;
+  auto iter = config.find(kResizePlanMaxNum);
+  if (iter != config.end()) {
+    auto max_plan_num = GenericParseValue<size_t>(iter->second);
+    if (!max_plan_num.IsNone()) {
+      max_resize_plan_num_ = max_plan_num.Get();
+    }
+  }
+  iter = config.find(kResizeBucketAxis);
+  if (iter != config.end()) {
+    auto bucket_axis = GenericParseValue<int>(iter->second);
+    if (!bucket_axis.IsNone()) {
+      resize_bucket_axis_ = bucket_axis.Get();
+    }
+  }
+  iter = config.find(kResizeBucketSize);
+  if (iter != config.end()) {
+    auto bucket_size = GenericParseValue<int>(iter->second);
+    if (!bucket_size.IsNone()) {
+      resize_bucket_size_ = bucket_size.Get();
+    }
+  }
+  MS_LOG(INFO) << "Resize plan config: max plan num " << max_resize_plan_num_ << ", bucket axis "
+               << resize_bucket_axis_ << ", bucket size " << resize_bucket_size_;
+  if (max_resize_plan_num_ > 0 && !ResizePlanValid()) {
+    MS_LOG(WARNING) << "The resize plans are not supported by the session, which needs the runtime allocator and the "
+                       "cpu subgraphs only, so the config of the resize plan takes no effect.";
+  }
+}
+
+bool LiteSession::ResizePlanValid() {
+  if (max_resize_plan_num_ == 0 || is_train_session_ || ExistCustomCpuKernel()) {
+    return false;
+  }
+  // only the memory planned is cached, which is not there without the runtime allocator.
+  if (RuntimeAllocatorValid() != RET_OK) {
+    return false;
+  }
+  // The plans only hold the shapes, so the tensor lists, whose elements are inferred too, are not supported.
+  if (std::any_of(tensors_.begin(), tensors_.end(),
+                  [](const Tensor *tensor) { return tensor->data_type() == kObjectTypeTensorType; })) {
+    return false;
+  }
+  return std::all_of(kernels_.begin(), kernels_.end(), [](const kernel::KernelExec *kernel) {
+    return kernel->desc().arch == kernel::KERNEL_ARCH::kCPU &&
+           (kernel->subgraph_type() == kernel::kCpuFP32SubGraph || kernel->subgraph_type() == kernel::kCpuFP16SubGraph);
+  });
+}
+
+void LiteSession::BucketResizeDims(std::vector<std::vector<int>> *dims) {
+  if (resize_bucket_axis_ < 0 || resize_bucket_size_ <= 1 || !ResizePlanValid()) {
+    return;
+  }
+  auto axis = static_cast<size_t>(resize_bucket_axis_);
+  for (auto &shape : *dims) {
+    if (axis < shape.size() && shape[axis] > 0 && shape[axis] % resize_bucket_size_ != 0) {
+      auto padded_dim = (shape[axis] + resize_bucket_size_ - 1) / resize_bucket_size_ * resize_bucket_size_;
+      MS_LOG(INFO) << "Pad the dim " << shape[axis] << " of the axis " << axis << " to " << padded_dim
+                   << " by the bucket size of the resize plan.";
+      shape[axis] = padded_dim;
+    }
+  }
+}
+
+bool LiteSession::ResizePlanMatched(const ResizePlan &plan) const {
+  return std::all_of(plan.tensor_infos.begin(), plan.tensor_infos.end(), [](const auto &tensor_info) {
+    auto tensor = std::get<0>(tensor_info);
+    return tensor->shape() == std::get<1>(tensor_info) && tensor->data_type() == std::get<2>(tensor_info);
+  });
+}
+
+void LiteSession::SaveResizePlan(const std::vector<std::vector<int>> &dims) {
+  if (!ResizePlanValid() || resize_plans_.size() >= max_resize_plan_num_ || runtime_allocator_ == nullptr) {
+    return;
+  }
+  ResizePlan plan;
+  std::set<Tensor *> visited;
+  auto add_tensor = [&plan, &visited](Tensor *tensor) {
+    if (!tensor->IsConst() && visited.insert(tensor).second) {
+      plan.tensor_infos.emplace_back(tensor, tensor->shape(), tensor->data_type());
+    }
+  };
+  for (auto kernel : kernels_) {
+    auto sub_graph = reinterpret_cast<kernel::SubGraphKernel *>(kernel);
+    for (auto tensor : sub_graph->in_tensors()) {
+      add_tensor(tensor);
+    }
+    for (auto node : sub_graph->nodes()) {
+      for (auto tensor : node->in_tensors()) {
+        add_tensor(tensor);
+      }
+      for (auto tensor : node->out_tensors()) {
+        add_tensor(tensor);
+      }
+    }
+  }
+  for (auto &graph_output : isolate_graph_output_map_) {
+    add_tensor(graph_output.second);
+  }
+  for (auto &tensor_info : plan.tensor_infos) {
+    if (std::get<0>(tensor_info)->allocator() == runtime_allocator_) {
+      plan.runtime_allocator_tensors.push_back(std::get<0>(tensor_info));
+    }
+  }
+  plan.runtime_allocator_offsets = runtime_allocator_->GetOffsetMap();
+  plan.runtime_allocator_size = runtime_allocator_->total_size();
+  resize_plans_[dims] = std::move(plan);
+}
+
 int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
                         const std::vector<std::vector<int>> &dims) {
   bool expected = false;
@@ -1161,11 +1487,21 @@ int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
     MS_LOG(ERROR) << "Not support multi-threading";
     return RET_ERROR;
   }
+  // the lazy kernels are prepared before they are resized.
+  auto ret = MaterializeLazyKernels();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "MaterializeLazyKernels failed.";
+    is_running_.store(false);
+    return ret;
+  }
+  InitResizePlanConfig();
+  auto resize_dims = dims;
+  BucketResizeDims(&resize_dims);
   std::vector<std::vector<int>> old_dims;
   for (size_t i = 0; i < inputs_.size(); ++i) {
     old_dims.push_back(inputs_[i]->shape());
   }
-  auto ret = ResizeInputs(inputs, dims);
+  ret = ResizeInputs(inputs, resize_dims);
   if (ret != RET_OK) {
     ResetInputsShape(old_dims);
     is_running_.store(false);
@@ -1183,7 +1519,20 @@ int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
     return ret;
   }
 
-  if (RuntimeAllocatorInit() != RET_OK) {
+  auto plan_iter = ResizePlanValid() ? resize_plans_.find(resize_dims) : resize_plans_.end();
+  bool plan_hit = plan_iter != resize_plans_.end() && ResizePlanMatched(plan_iter->second);
+  if (plan_hit) {
+    const auto &plan = plan_iter->second;
+    ret = RuntimeAllocatorRestore(plan.runtime_allocator_tensors, plan.runtime_allocator_offsets,
+                                  plan.runtime_allocator_size);
+  } else {
+    if (plan_iter != resize_plans_.end()) {
+      MS_LOG(INFO) << "The inferred shapes do not match the resize plan, which is planned again.";
+      (void)resize_plans_.erase(plan_iter);
+    }
+    ret = RuntimeAllocatorInit();
+  }
+  if (ret != RET_OK) {
     MS_LOG(ERROR) << "Runtime allocator in resize failed.";
     is_running_.store(false);
     return RET_ERROR;
@@ -1194,6 +1543,9 @@ int LiteSession::Resize(const std::vector<mindspore::lite::Tensor *> &inputs,
     MS_LOG(ERROR) << "GraphOptimizePass failed.";
     return RET_ERROR;
   }
+  if (!plan_hit) {
+    SaveResizePlan(resize_dims);
+  }
 
   is_running_.store(false);
 #if defined(LINUX_RUNTIME)
@@ -1439,6 +1791,22 @@ int LiteSession::RuntimeAllocatorInit() {
   return RET_OK;
 }
 
+int LiteSession::RuntimeAllocatorRestore(const std::vector<Tensor *> &tensors,
+                                         const std::unordered_map<Tensor *, size_t> &offset_map, size_t total_size) {
+  MS_CHECK_TRUE_MSG(runtime_allocator_ != nullptr, RET_ERROR, "RuntimeAllocator is null.");
+  runtime_allocator_->Clear(context_->allocator);
+  for (auto tensor : tensors) {
+    tensor->set_allocator(runtime_allocator_);
+  }
+  runtime_allocator_->RestoreOffsetMap(offset_map, total_size);
+  auto ret = RuntimeAllocatorSetData();
+  if (ret != RET_OK) {
+    MS_LOG(ERROR) << "using optimize allocator failed.";
+    return ret;
+  }
+  return RET_OK;
+}
+
 int LiteSession::RuntimeAllocatorSetData() {
   void *data = runtime_allocator_->MallocOptData();
   if (data == nullptr) {
@@ -1648,7 +2016,7 @@ int lite::LiteSession::LoadModelAndCompileByBuf(const char *model_buf, mindspore
     MS_LOG(ERROR) << "Import model failed";
     return RET_ERROR;
   }
-  auto status = lite::PackWeightManager::GetInstance()->InitPackWeightByBuf(model_buf, buf_size);
+  auto status = lite::PackWeightManager::GetInstance()->InitPackWeightByBuf(lite_buf, lite_buf_size);
   MS_CHECK_FALSE_MSG(status != RET_OK, RET_ERROR, "InitPackWeightByBuf failed.");
   auto ret = CompileGraph(model);
   model->buf = nullptr;
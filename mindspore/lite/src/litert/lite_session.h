@@ -21,8 +21,12 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <map>
 #include <atomic>
+#include <mutex>
+#include <tuple>
+#include <utility>
 #include "src/litert/kernel_exec.h"
 #include "src/litert/lite_model.h"
 #include "src/litert/inner_context.h"
@@ -130,7 +134,7 @@ class LiteSession {
   static int ReSizeKernels(
     const std::vector<kernel::KernelExec *> &kernels,
     const std::unordered_map<Tensor *, Tensor *> &isolate_input_map = std::unordered_map<Tensor *, Tensor *>());
-  static void FreePackOpWeight(const std::vector<kernel::KernelExec *> &kernels);
+  void FreePackOpWeight(const std::vector<kernel::KernelExec *> &kernels);
   std::string ParseWeightPath();
 
  private:
@@ -159,8 +163,58 @@ class LiteSession {
   void RuntimeAllocatorInitGraphOutput();
   void RuntimeAllocatorInitSubgraph();
   virtual int RuntimeAllocatorValid();
+  int RuntimeAllocatorRestore(const std::vector<Tensor *> &tensors,
+                              const std::unordered_map<Tensor *, size_t> &offset_map, size_t total_size);
   RuntimeAllocatorPtr runtime_allocator_ = nullptr;
 
+ private:
+  // The memory planned for the input shapes resized to before, so that resizing back to them skips the memory planning.
+  // The shape inference still runs, because it sets the format and the data type of the tensors and the parameters of
+  // the ops, e.g. the pads of the convolution with the same pad mode, which the kernels' ReSize depends on.
+  // Only the runtime allocator plans the memory, so the plans are cached only where it is valid, i.e. on arm64 with a
+  // single subgraph, which is neither parallel nor trained. Elsewhere the config of the resize plan takes no effect.
+  struct ResizePlan {
+    // the shapes and the data types inferred, to check that the memory planned still fits the tensors
+    std::vector<std::tuple<Tensor *, std::vector<int>, TypeId>> tensor_infos;
+    std::vector<Tensor *> runtime_allocator_tensors;
+    std::unordered_map<Tensor *, size_t> runtime_allocator_offsets;
+    size_t runtime_allocator_size = 0;
+  };
+  void InitResizePlanConfig();
+  bool ResizePlanValid();
+  // Pad the dims of the bucket axis up to a multiple of the bucket size, to bound the number of the resize plans, only
+  // when the plans are cached. The caller fills the padded inputs.
+  void BucketResizeDims(std::vector<std::vector<int>> *dims);
+  bool ResizePlanMatched(const ResizePlan &plan) const;
+  void SaveResizePlan(const std::vector<std::vector<int>> &dims);
+  bool resize_plan_config_inited_ = false;
+  size_t max_resize_plan_num_ = 0;
+  int resize_bucket_axis_ = -1;
+  int resize_bucket_size_ = 0;
+  std::map<std::vector<std::vector<int>>, ResizePlan> resize_plans_;
+
+ private:
+  // The packed ops of the cpu subgraphs decode their compressed weights and pack them at their first execution, so
+  // that the kernels never executed, e.g. in the untaken branches of the control flow, cost nothing while compiling.
+  void InitLazyMaterialize(const lite::Model *model);
+  std::vector<bool> GetLazyDecodeTensors(const lite::LiteModel *model) const;
+  int DecodeLazyTensors(const std::vector<Tensor *> &tensors);
+  int InitLazyKernels();
+  int MaterializeKernel(kernel::KernelExec *kernel);
+  int MaterializeLazyKernels();
+  bool lazy_materialize_ = false;
+  const lite::LiteModel *lazy_model_ = nullptr;
+  std::mutex lazy_mutex_;
+  // the tensors whose data is decoded from the model at the first execution, and their index in the model
+  std::unordered_map<Tensor *, size_t> lazy_decode_tensors_;
+  std::unordered_set<kernel::KernelExec *> lazy_kernels_;
+  // the number of the lazy kernels which have not been materialized of each const tensor
+  std::unordered_map<Tensor *, int> lazy_tensor_ref_count_;
+  size_t materialized_kernel_num_ = 0;
+  uint64_t compile_begin_time_ = 0;
+  uint64_t compile_end_time_ = 0;
+  bool first_run_done_ = false;
+
  protected:
   InnerContext *context_ = nullptr;
   mindspore::Context *ms_context_ = nullptr;
@@ -15,15 +15,169 @@
  */
 
 #include "src/litert/pack_weight.h"
+#include <cerrno>
+#include <cstring>
+#include <sstream>
+#include <string_view>
+#include <thread>
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 #include "src/extendrt/dynamic_mem_allocator.h"
+#ifdef BFC_MEMORY
+#include "src/extendrt/numa_adapter.h"
+#endif
 namespace mindspore::lite {
-STATUS PackWeight::InitWeightManagerByBuf(const char *model_buf, size_t model_size, int numa_id, bool copy_buf) {
+namespace {
+#if defined(__linux__) && !defined(__ANDROID__)
+constexpr size_t kSharedBufHeaderSize = 64;
+constexpr uint64_t kSharedBufReady = 0x4D534C4954455742;  // "MSLITEWB"
+constexpr int kSharedBufMaxRetry = 8;
+
+struct SharedBufHeader {
+  uint64_t ready;
+  uint64_t size;
+};
+#endif
+
+// The pages are placed on the numa node by the first touch of a thread bound to it.
+void CopyOnNumaNode(char *dst, const char *src, size_t size, int numa_id) {
+#ifdef BFC_MEMORY
+  if (numa_id >= 0 && numa::NUMAAdapter::GetInstance()->Available()) {
+    std::thread copy_thread([dst, src, size, numa_id]() {
+      numa::NUMAAdapter::GetInstance()->Bind(numa_id);
+      memcpy(dst, src, size);
+    });
+    copy_thread.join();
+    return;
+  }
+#endif
+  memcpy(dst, src, size);
+}
+
+#if defined(__linux__) && !defined(__ANDROID__)
+bool IsSameFile(int fd, const std::string &path) {
+  struct stat fd_stat = {};
+  struct stat path_stat = {};
+  return fstat(fd, &fd_stat) == 0 && stat(path.c_str(), &path_stat) == 0 && fd_stat.st_dev == path_stat.st_dev &&
+         fd_stat.st_ino == path_stat.st_ino;
+}
+
+// Create the segment and fill it under the exclusive lock, which is downgraded to a shared one once it is ready.
+STATUS FillSharedModelBuf(int fd, const std::string &path, const char *model_buf, size_t model_size, int numa_id) {
+  auto total_size = kSharedBufHeaderSize + model_size;
+  if (ftruncate(fd, static_cast<off_t>(total_size)) != 0) {
+    MS_LOG(WARNING) << "truncate shared memory " << path << " failed.";
+    return RET_ERROR;
+  }
+  auto addr = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (addr == MAP_FAILED) {
+    MS_LOG(WARNING) << "map shared memory " << path << " failed.";
+    return RET_ERROR;
+  }
+  auto header = static_cast<SharedBufHeader *>(addr);
+  CopyOnNumaNode(static_cast<char *>(addr) + kSharedBufHeaderSize, model_buf, model_size, numa_id);
+  header->size = model_size;
+  __atomic_store_n(&header->ready, kSharedBufReady, __ATOMIC_RELEASE);
+  munmap(addr, total_size);
+  return flock(fd, LOCK_SH) == 0 ? RET_OK : RET_ERROR;
+}
+
+// Map the copy of the model buf from the segment named by the content of the model and the numa node. The first
+// process creates and fills the segment holding an exclusive flock, the others block on a shared one until it is
+// ready. A segment found unready under the shared lock was left by a process that died before filling it, so it is
+// removed and created again. The copy is mapped private, so the pages are shared until written by some process.
+STATUS MapSharedModelBuf(const std::string &path, const char *model_buf, size_t model_size, int numa_id,
+                         SharedModelBuf *shared_buf) {
+  auto total_size = kSharedBufHeaderSize + model_size;
+  for (int retry = 0; retry < kSharedBufMaxRetry; ++retry) {
+    int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+    if (fd >= 0) {
+      // the name may have been removed as a stale segment by others before it is locked
+      if (flock(fd, LOCK_EX) != 0 || !IsSameFile(fd, path)) {
+        close(fd);
+        continue;
+      }
+      if (FillSharedModelBuf(fd, path, model_buf, model_size, numa_id) != RET_OK) {
+        unlink(path.c_str());
+        close(fd);
+        return RET_ERROR;
+      }
+    } else if (errno == EEXIST) {
+      fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+        continue;
+      }
+      if (flock(fd, LOCK_SH) != 0) {
+        close(fd);
+        continue;
+      }
+    } else {
+      MS_LOG(WARNING) << "create shared memory " << path << " failed.";
+      return RET_ERROR;
+    }
+    struct stat file_stat = {};
+    void *addr = MAP_FAILED;
+    if (fstat(fd, &file_stat) == 0 && static_cast<size_t>(file_stat.st_size) >= total_size) {
+      addr = mmap(nullptr, total_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    }
+    if (addr == MAP_FAILED ||
+        __atomic_load_n(&static_cast<SharedBufHeader *>(addr)->ready, __ATOMIC_ACQUIRE) != kSharedBufReady ||
+        static_cast<SharedBufHeader *>(addr)->size != model_size) {
+      MS_LOG(WARNING) << "shared memory " << path << " is stale, create it again.";
+      if (addr != MAP_FAILED) {
+        munmap(addr, total_size);
+      }
+      if (IsSameFile(fd, path)) {
+        unlink(path.c_str());
+      }
+      close(fd);
+      continue;
+    }
+    if (memcmp(static_cast<char *>(addr) + kSharedBufHeaderSize, model_buf, model_size) != 0) {
+      MS_LOG(WARNING) << "shared memory " << path << " does not hold the model.";
+      munmap(addr, total_size);
+      close(fd);
+      return RET_ERROR;
+    }
+    shared_buf->addr = addr;
+    shared_buf->size = total_size;
+    shared_buf->path = path;
+    shared_buf->fd = fd;
+    return RET_OK;
+  }
+  MS_LOG(WARNING) << "map shared memory " << path << " failed after " << kSharedBufMaxRetry << " retries.";
+  return RET_ERROR;
+}
+#endif
+}  // namespace
+
+STATUS PackWeight::InitWeightManagerByBuf(const char *model_buf, size_t model_size, int numa_id, bool copy_buf,
+                                          bool shared_memory) {
   MS_CHECK_TRUE_MSG(model_buf != nullptr, RET_ERROR, "model buf is nullptr in pack weight manager.");
-  copy_buf_ = copy_buf;
-  if (model_buf_map_.find(model_buf) != model_buf_map_.end() &&
-      find(numa_model_buf_[model_buf].begin(), numa_model_buf_[model_buf].end(), numa_id) !=
-        numa_model_buf_[model_buf].end()) {
-    MS_LOG(DEBUG) << "same numa id, use same model buf.";
+  MS_CHECK_TRUE_MSG(model_size != 0, RET_ERROR, "model size is 0 in pack weight manager.");
+  std::lock_guard<std::mutex> lock(mtx_weight_);
+  auto buf_iter = buf_model_weight_.find(model_buf);
+  if (!copy_buf && buf_iter != buf_model_weight_.end() && buf_iter->second.weight->model_buf == model_buf &&
+      buf_iter->second.size == model_size) {
+    MS_LOG(DEBUG) << "the model buf is copied by pack weight manager.";
+    return RET_OK;
+  }
+  auto content_hash = std::hash<std::string_view>()(std::string_view(model_buf, model_size));
+  auto *model_const_weight = FindModelWeight(model_buf, model_size, content_hash, numa_id);
+  if (model_const_weight != nullptr) {
+    MS_LOG(DEBUG) << "same model content and numa id, use same weight.";
+    if (copy_buf) {
+      numa_model_buf_[std::make_pair(model_buf, numa_id)] = model_const_weight->model_buf;
+      // the copy kept by a weight registered by the buf of a model is not registered yet.
+      RegisterModelBuf(model_const_weight->model_buf, model_size, model_const_weight);
+    } else {
+      RegisterModelBuf(model_buf, model_size, model_const_weight);
+    }
     return RET_OK;
   }
   // model buf and weight use same allocator, create in weight pack manager
@@ -37,54 +191,152 @@ STATUS PackWeight::InitWeightManagerByBuf(const char *model_buf, size_t model_si
     MS_LOG(ERROR) << "allocator is nullptr in pack weight manager.";
     return RET_ERROR;
   }
-  auto *model_const_weight = new (std::nothrow) ModelConstWeight();
+  model_const_weight = new (std::nothrow) ModelConstWeight();
   if (model_const_weight == nullptr) {
     MS_LOG(ERROR) << "model const weight is nullptr.";
     return RET_ERROR;
   }
-  if (copy_buf_) {
-    auto new_model_buf = static_cast<char *>(allocator->Malloc(model_size));
-    if (new_model_buf == nullptr) {
-      MS_LOG(ERROR) << "new model buf is nullptr in pack weight manager.";
-      return RET_ERROR;
+  model_const_weight->allocator = allocator;
+  model_const_weight->numa_id = numa_id;
+  model_const_weight->model_size = model_size;
+  model_const_weight->content_hash = content_hash;
+  // the copy is kept even if the model is run on its own buf, to verify the content of the models sharing the weight.
+  if (CopyModelBuf(model_const_weight, model_buf, copy_buf && shared_memory) != RET_OK) {
+    MS_LOG(ERROR) << "new model buf is nullptr in pack weight manager.";
+    delete model_const_weight;
+    return RET_ERROR;
+  }
+  if (copy_buf) {
+    numa_model_buf_[std::make_pair(model_buf, numa_id)] = model_const_weight->model_buf;
+    RegisterModelBuf(model_const_weight->model_buf, model_size, model_const_weight);
+  } else {
+    RegisterModelBuf(model_buf, model_size, model_const_weight);
+  }
+  model_weights_.push_back(model_const_weight);
+  hash_model_weight_[content_hash].push_back(model_const_weight);
+  return RET_OK;
+}
+
+std::string PackWeight::SharedModelBufPath(size_t content_hash, size_t model_size, int numa_id) {
+  std::ostringstream path;
+  path << "/dev/shm/mslite_weight_" << std::hex << content_hash << std::dec << "_" << model_size << "_" << numa_id;
+  return path.str();
+}
+
+ModelConstWeight *PackWeight::FindModelWeight(const char *model_buf, size_t model_size, size_t content_hash,
+                                              int numa_id) {
+  auto iter = hash_model_weight_.find(content_hash);
+  if (iter == hash_model_weight_.end()) {
+    return nullptr;
+  }
+  for (auto *weight : iter->second) {
+    if (weight->numa_id != numa_id || weight->model_size != model_size) {
+      continue;
     }
-    memcpy(new_model_buf, model_buf, model_size);
-    if (numa_model_buf_.find(model_buf) == numa_model_buf_.end()) {
-      numa_model_buf_[model_buf] = {numa_id};
-      model_buf_map_[model_buf] = {new_model_buf};
-    } else {
-      numa_model_buf_[model_buf].push_back(numa_id);
-      model_buf_map_[model_buf].push_back(new_model_buf);
+    // the copy is compared to rule out the collision of hash.
+    if (weight->model_buf != nullptr && memcmp(weight->model_buf, model_buf, model_size) == 0) {
+      return weight;
     }
-    buf_model_weight_[new_model_buf] = model_const_weight;
-    buf_model_weight_[new_model_buf]->allocator = allocator;
-    model_const_weight->numa_id = numa_id;
-  } else {
-    buf_model_weight_[model_buf] = model_const_weight;
-    buf_model_weight_[model_buf]->allocator = allocator;
   }
+  return nullptr;
+}
+
+STATUS PackWeight::CopyModelBuf(ModelConstWeight *weight, const char *model_buf, bool shared_memory) {
+  auto model_size = weight->model_size;
+  if (shared_memory) {
+#if defined(__linux__) && !defined(__ANDROID__)
+    auto path = SharedModelBufPath(weight->content_hash, model_size, weight->numa_id);
+    if (MapSharedModelBuf(path, model_buf, model_size, weight->numa_id, &weight->shared_buf) == RET_OK) {
+      weight->model_buf = static_cast<char *>(weight->shared_buf.addr) + kSharedBufHeaderSize;
+      return RET_OK;
+    }
+    MS_LOG(WARNING) << "map model buf from shared memory failed, copy it in the process.";
+#else
+    MS_LOG(WARNING) << "shared memory is not supported, copy the model buf in the process.";
+#endif
+  }
+  weight->model_buf = static_cast<char *>(weight->allocator->Malloc(model_size));
+  if (weight->model_buf == nullptr) {
+    MS_LOG(ERROR) << "malloc model buf failed.";
+    return RET_ERROR;
+  }
+  memcpy(weight->model_buf, model_buf, model_size);
   return RET_OK;
 }
 
+void PackWeight::RegisterModelBuf(const char *model_buf, size_t model_size, ModelConstWeight *weight) {
+  // the bufs overlapped by the new one have been released.
+  auto iter = buf_model_weight_.lower_bound(model_buf);
+  if (iter != buf_model_weight_.begin()) {
+    auto prev = std::prev(iter);
+    if (prev->first + prev->second.size > model_buf) {
+      iter = prev;
+    }
+  }
+  while (iter != buf_model_weight_.end() && iter->first < model_buf + model_size) {
+    iter = buf_model_weight_.erase(iter);
+  }
+  buf_model_weight_[model_buf] = {model_size, weight};
+}
+
+ModelConstWeight *PackWeight::FindWeightByData(const void *data, size_t *offset) {
+  auto data_ptr = static_cast<const char *>(data);
+  auto iter = buf_model_weight_.upper_bound(data_ptr);
+  if (iter == buf_model_weight_.begin()) {
+    return nullptr;
+  }
+  --iter;
+  if (data_ptr >= iter->first + iter->second.size) {
+    return nullptr;
+  }
+  *offset = static_cast<size_t>(data_ptr - iter->first);
+  return iter->second.weight;
+}
+
+void **PackWeight::FindPackedData(const void *origin_data, ModelConstWeight **weight) {
+  for (auto *item : model_weights_) {
+    auto iter = item->origin_and_packed_pair.find(origin_data);
+    if (iter != item->origin_and_packed_pair.end()) {
+      *weight = item;
+      return &iter->second;
+    }
+  }
+  size_t offset = 0;
+  auto *buf_weight = FindWeightByData(origin_data, &offset);
+  if (buf_weight != nullptr) {
+    auto iter = buf_weight->offset_and_packed_pair.find(offset);
+    if (iter != buf_weight->offset_and_packed_pair.end()) {
+      *weight = buf_weight;
+      return &iter->second;
+    }
+  }
+  return nullptr;
+}
+
 char *PackWeight::GetNumaModelBuf(const char *model_buf, int numa_id) {
-  if (model_buf_map_.find(model_buf) == model_buf_map_.end() ||
-      find(numa_model_buf_[model_buf].begin(), numa_model_buf_[model_buf].end(), numa_id) ==
-        numa_model_buf_[model_buf].end()) {
+  std::lock_guard<std::mutex> lock(mtx_weight_);
+  auto iter = numa_model_buf_.find(std::make_pair(model_buf, numa_id));
+  if (iter == numa_model_buf_.end()) {
     MS_LOG(ERROR) << "can not find numa id in saved model buf.";
     return nullptr;
   }
-  auto numa_id_list = numa_model_buf_[model_buf];
-  auto it = find(numa_id_list.begin(), numa_id_list.end(), numa_id) - numa_id_list.begin();
-  return model_buf_map_[model_buf][it];
+  return iter->second;
 }
 
 STATUS PackWeight::StoreOriginTensorData(const char *model_buf, const void *origin_tensor_data) {
   std::lock_guard<std::mutex> lock(mtx_weight_);
-  if (buf_model_weight_.find(model_buf) == buf_model_weight_.end()) {
+  auto iter = buf_model_weight_.find(model_buf);
+  if (iter == buf_model_weight_.end()) {
     MS_LOG(ERROR) << "can not find model buf in store origin Tensor";
     return RET_ERROR;
   }
-  auto &model_weight = buf_model_weight_[model_buf];
+  auto &model_weight = iter->second.weight;
+  auto data_ptr = static_cast<const char *>(origin_tensor_data);
+  if (data_ptr >= model_buf && data_ptr < model_buf + iter->second.size) {
+    // keyed by the offset, so the model loaded from another buf of the same content finds the packed data.
+    model_weight->offset_and_packed_pair.insert(std::make_pair(static_cast<size_t>(data_ptr - model_buf), nullptr));
+    return RET_OK;
+  }
   auto &packed_pair = model_weight->origin_and_packed_pair;
   if (packed_pair.find(origin_tensor_data) != packed_pair.end()) {
     MS_LOG(DEBUG) << "origin tensor data already store by other model.";
@@ -98,41 +350,46 @@ void *PackWeight::ReplaceFp16Data(void *origin_fp16_data, size_t size) {
   std::lock_guard<std::mutex> lock(mtx_weight_);
   if (fp16_fp32_data_pair_.find(origin_fp16_data) != fp16_fp32_data_pair_.end()) {
     return fp16_fp32_data_pair_[origin_fp16_data];
-  } else {
-    for (auto &item : buf_model_weight_) {
-      if (item.second->origin_and_packed_pair.find(origin_fp16_data) != item.second->origin_and_packed_pair.end()) {
-        auto &model_weight = item.second;
-        auto &origin_and_packed_pair = model_weight->origin_and_packed_pair;
-        if (origin_and_packed_pair.find(origin_fp16_data) == origin_and_packed_pair.end()) {
-          MS_LOG(ERROR) << "origin fp16 data not find.";
-          return nullptr;
-        }
-        auto allocator = model_weight->allocator;
-        void *data = allocator->Malloc(size);
-        if (data == nullptr) {
-          MS_LOG(ERROR) << "malloc failed.";
-          return nullptr;
-        }
-        origin_and_packed_pair.insert(std::make_pair(data, nullptr));
-        model_weight->fp16_fp32_data.insert(data);
-        origin_and_packed_pair.erase(origin_fp16_data);
-        fp16_fp32_data_pair_.insert(std::make_pair(origin_fp16_data, data));
-        return data;
-      }
+  }
+  size_t offset = 0;
+  auto *buf_weight = FindWeightByData(origin_fp16_data, &offset);
+  if (buf_weight != nullptr) {
+    auto iter = buf_weight->offset_fp16_fp32_data.find(offset);
+    if (iter != buf_weight->offset_fp16_fp32_data.end()) {
+      return iter->second;
     }
   }
-  MS_LOG(ERROR) << "ReplaceFp16Data failed.";
-  return nullptr;
+  ModelConstWeight *model_weight = nullptr;
+  if (FindPackedData(origin_fp16_data, &model_weight) == nullptr) {
+    MS_LOG(ERROR) << "ReplaceFp16Data failed.";
+    return nullptr;
+  }
+  auto allocator = model_weight->allocator;
+  void *data = allocator->Malloc(size);
+  if (data == nullptr) {
+    MS_LOG(ERROR) << "malloc failed.";
+    return nullptr;
+  }
+  model_weight->origin_and_packed_pair.insert(std::make_pair(data, nullptr));
+  model_weight->fp16_fp32_data.insert(data);
+  if (model_weight->origin_and_packed_pair.erase(origin_fp16_data) != 0) {
+    fp16_fp32_data_pair_.insert(std::make_pair(origin_fp16_data, data));
+  } else {
+    model_weight->offset_and_packed_pair.erase(offset);
+    model_weight->offset_fp16_fp32_data.insert(std::make_pair(offset, data));
+  }
+  return data;
 }
 
 STATUS PackWeight::ReplaceOriginTensorData(const char *model_buf, std::vector<Tensor *> *tensors, int tensor_index) {
   std::lock_guard<std::mutex> lock(mtx_weight_);
-  if (buf_model_weight_.find(model_buf) == buf_model_weight_.end()) {
+  auto iter = buf_model_weight_.find(model_buf);
+  if (iter == buf_model_weight_.end()) {
     MS_LOG(ERROR) << "can not find model buf in store origin Tensor";
     return RET_ERROR;
   }
   auto &tensor = tensors->at(tensor_index);
-  auto &model_weight = buf_model_weight_[model_buf];
+  auto &model_weight = iter->second.weight;
   if (model_weight->tensors_data.find(tensor_index) == model_weight->tensors_data.end()) {
     auto allocator = model_weight->allocator;
     void *new_data = allocator->Malloc(tensor->Size());
@@ -158,45 +415,48 @@ STATUS PackWeight::ReplaceOriginTensorData(const char *model_buf, std::vector<Te
 void *PackWeight::GetPackData(const void *tensor_data, const size_t size, bool *is_packed) {
   std::lock_guard<std::mutex> lock(mtx_weight_);
   MS_CHECK_TRUE_RET(tensor_data != nullptr, nullptr);
-  for (auto &item : buf_model_weight_) {
-    auto &model_weight = item.second;
-    auto &origin_packed_weight = model_weight->origin_and_packed_pair;
-    if (origin_packed_weight.find(tensor_data) == origin_packed_weight.end()) {
-      continue;
-    }
-    auto packed_tensor_data = origin_packed_weight[tensor_data];
-    if (packed_tensor_data != nullptr) {
-      *is_packed = true;
-      return packed_tensor_data;
-    } else {
-      auto weight_allocator = model_weight->allocator;
-      packed_tensor_data = weight_allocator->Malloc(size);
-      if (packed_tensor_data == nullptr) {
-        MS_LOG(ERROR) << "malloc failed.";
-        return nullptr;
-      }
-      origin_packed_weight[tensor_data] = packed_tensor_data;
-      *is_packed = false;
-      return packed_tensor_data;
-    }
+  ModelConstWeight *model_weight = nullptr;
+  auto packed_slot = FindPackedData(tensor_data, &model_weight);
+  if (packed_slot == nullptr) {
+    *is_packed = false;
+    MS_LOG(ERROR) << "can not find tensor data in origin tensor data.";
+    return nullptr;
+  }
+  if (*packed_slot != nullptr) {
+    *is_packed = true;
+    return *packed_slot;
   }
+  auto weight_allocator = model_weight->allocator;
+  void *packed_tensor_data = weight_allocator->Malloc(size);
+  if (packed_tensor_data == nullptr) {
+    MS_LOG(ERROR) << "malloc failed.";
+    return nullptr;
+  }
+  *packed_slot = packed_tensor_data;
   *is_packed = false;
-  MS_LOG(ERROR) << "can not find tensor data in origin tensor data.";
-  return nullptr;
+  return packed_tensor_data;
 }
 
 void PackWeight::FreePackedWeight(ModelConstWeight *weight) {
   MS_CHECK_TRUE_RET_VOID(weight != nullptr);
+  auto allocator = weight->allocator;
+  MS_CHECK_TRUE_RET_VOID(allocator != nullptr);
   for (auto &origin_and_packed_pair : weight->origin_and_packed_pair) {
     auto &packed_data = origin_and_packed_pair.second;
-    auto allocator = weight->allocator;
-    MS_CHECK_TRUE_RET_VOID(allocator != nullptr);
     if (packed_data != nullptr) {
       allocator->Free(packed_data);
       packed_data = nullptr;
     }
   }
   weight->origin_and_packed_pair.clear();
+  for (auto &offset_and_packed_pair : weight->offset_and_packed_pair) {
+    auto &packed_data = offset_and_packed_pair.second;
+    if (packed_data != nullptr) {
+      allocator->Free(packed_data);
+      packed_data = nullptr;
+    }
+  }
+  weight->offset_and_packed_pair.clear();
 }
 
 void PackWeight::FreeTensorData(ModelConstWeight *weight) {
@@ -225,25 +485,44 @@ void PackWeight::FreeFp16ToFp32Data(ModelConstWeight *weight) {
   weight->fp16_fp32_data.clear();
 }
 
+void PackWeight::FreeModelBuf(ModelConstWeight *weight) {
+  MS_CHECK_TRUE_RET_VOID(weight != nullptr);
+  if (weight->model_buf == nullptr) {
+    return;
+  }
+#if defined(__linux__) && !defined(__ANDROID__)
+  auto &shared_buf = weight->shared_buf;
+  if (shared_buf.addr != nullptr) {
+    munmap(shared_buf.addr, shared_buf.size);
+    // no other process holds the lock, the name is removed unless it is taken by a new segment.
+    if (flock(shared_buf.fd, LOCK_EX | LOCK_NB) == 0 && IsSameFile(shared_buf.fd, shared_buf.path)) {
+      unlink(shared_buf.path.c_str());
+    }
+    close(shared_buf.fd);
+    shared_buf.fd = -1;
+    shared_buf.addr = nullptr;
+    weight->model_buf = nullptr;
+    return;
+  }
+#endif
+  MS_CHECK_TRUE_RET_VOID(weight->allocator != nullptr);
+  weight->allocator->Free(weight->model_buf);
+  weight->model_buf = nullptr;
+}
+
 PackWeight::~PackWeight() {
   std::lock_guard<std::mutex> lock(mtx_weight_);
-  for (auto &item : buf_model_weight_) {
-    FreePackedWeight(item.second);
-    FreeFp16ToFp32Data(item.second);
-    FreeTensorData(item.second);
-  }
-  // free model buf
-  if (copy_buf_) {
-    for (auto &item : buf_model_weight_) {
-      auto model_buf = const_cast<char *>(item.first);
-      if (item.second != nullptr) {
-        auto &allocator = item.second->allocator;
-        allocator->Free(model_buf);
-        delete item.second;
-        item.second = nullptr;
-      }
-    }
-    buf_model_weight_.clear();
+  for (auto &weight : model_weights_) {
+    FreePackedWeight(weight);
+    FreeFp16ToFp32Data(weight);
+    FreeTensorData(weight);
+    FreeModelBuf(weight);
+    delete weight;
+    weight = nullptr;
   }
+  model_weights_.clear();
+  hash_model_weight_.clear();
+  buf_model_weight_.clear();
+  numa_model_buf_.clear();
 }
 }  // namespace mindspore::lite
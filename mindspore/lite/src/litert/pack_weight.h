@@ -28,20 +28,42 @@
 #include "src/tensor.h"
 #include "src/litert/lite_session.h"
 namespace mindspore::lite {
+// The copy of the model buf mapped from a shared memory segment, which is shared by the processes loading the model
+// of the same content on the same numa node.
+struct SharedModelBuf {
+  void *addr = nullptr;
+  size_t size = 0;
+  std::string path;
+  // holds a shared lock of the segment while it is mapped, the last process releasing it removes its name
+  int fd = -1;
+};
+
+// The weights of the models of the same content on the same numa node are shared, whichever buf they are loaded from.
 struct ModelConstWeight {
-  // origin tensor data <-> packed tensor data
+  // origin tensor data <-> packed tensor data, the origin data out of the model buf
   std::map<const void *, void *> origin_and_packed_pair;
+  // offset of origin tensor data in the model buf <-> packed tensor data
+  std::map<size_t, void *> offset_and_packed_pair;
   std::shared_ptr<Allocator> allocator = nullptr;
   int numa_id = -1;
   std::unordered_map<int, void *> tensors_data;
   std::set<void *> fp16_fp32_data;
+  // offset of origin fp16 tensor data in the model buf <-> fp32 tensor data
+  std::map<size_t, void *> offset_fp16_fp32_data;
+  size_t model_size = 0;
+  size_t content_hash = 0;
+  // the copy of the model buf owned by the weight. The weight registered by the buf of a model keeps a copy too, which
+  // the bufs of the same content hash are compared with, since the buf of the model may have been released.
+  char *model_buf = nullptr;
+  SharedModelBuf shared_buf;
 };
 
 class PackWeight {
  public:
   PackWeight() = default;
   ~PackWeight();
-  STATUS InitWeightManagerByBuf(const char *model_buf, size_t model_size, int numa_id = -1, bool copy_buf = false);
+  STATUS InitWeightManagerByBuf(const char *model_buf, size_t model_size, int numa_id = -1, bool copy_buf = false,
+                                bool shared_memory = false);
   char *GetNumaModelBuf(const char *model_buf, int numa_id);
   STATUS StoreOriginTensorData(const char *model_buf, const void *origin_tensor_data);
   void *GetPackData(const void *tensor_data, const size_t size, bool *is_packed);
@@ -49,15 +71,31 @@ class PackWeight {
   void *ReplaceFp16Data(void *origin_fp16_data, size_t size);
 
  private:
+  struct ModelBufInfo {
+    size_t size = 0;
+    ModelConstWeight *weight = nullptr;
+  };
+  static std::string SharedModelBufPath(size_t content_hash, size_t model_size, int numa_id);
+  ModelConstWeight *FindModelWeight(const char *model_buf, size_t model_size, size_t content_hash, int numa_id);
+  STATUS CopyModelBuf(ModelConstWeight *weight, const char *model_buf, bool shared_memory);
+  void RegisterModelBuf(const char *model_buf, size_t model_size, ModelConstWeight *weight);
+  // find the registered model buf holding the data, and the offset of the data in it
+  ModelConstWeight *FindWeightByData(const void *data, size_t *offset);
+  // the slot of the packed data of the origin data, nullptr if the origin data is not stored.
+  void **FindPackedData(const void *origin_data, ModelConstWeight **weight);
   void FreePackedWeight(ModelConstWeight *weight);
   void FreeTensorData(ModelConstWeight *weight);
   void FreeFp16ToFp32Data(ModelConstWeight *weight);
+  void FreeModelBuf(ModelConstWeight *weight);
 
-  bool copy_buf_ = false;
   std::mutex mtx_weight_;
-  std::unordered_map<const char *, ModelConstWeight *> buf_model_weight_;
-  std::unordered_map<const char *, std::vector<int>> numa_model_buf_;
-  std::unordered_map<const char *, std::vector<char *>> model_buf_map_;
+  std::vector<ModelConstWeight *> model_weights_;
+  // content hash of model buf -> weights
+  std::unordered_map<size_t, std::vector<ModelConstWeight *>> hash_model_weight_;
+  // start address of the registered model buf -> its size and weight
+  std::map<const char *, ModelBufInfo> buf_model_weight_;
+  // the copy of the model buf for each numa node
+  std::map<std::pair<const char *, int>, char *> numa_model_buf_;
   std::unordered_map<void *, void *> fp16_fp32_data_pair_;
 };
 }  // namespace mindspore::lite
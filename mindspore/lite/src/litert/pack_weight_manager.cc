@@ -39,10 +39,15 @@ bool PackWeightManager::IsCopyTensor(int op_type) {
   return false;
 }
 
+bool PackWeightManager::IsPackDataShared() const {
+#ifdef SHARING_MODEL_WEIGHT
+  return pack_weight_ != nullptr;
+#else
+  return false;
+#endif
+}
+
 STATUS PackWeightManager::InitPackWeightByBuf(const char *model_buf, size_t model_size) {
-  if (is_parallel_) {
-    return RET_OK;
-  }
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     pack_weight_ = std::make_shared<PackWeight>();
@@ -53,7 +58,8 @@ STATUS PackWeightManager::InitPackWeightByBuf(const char *model_buf, size_t mode
   return RET_OK;
 }
 
-STATUS PackWeightManager::InitPackWeight(const char *model_buf, size_t model_size, int numa_id) {
+STATUS PackWeightManager::InitPackWeight(const char *model_buf, size_t model_size, int numa_id,
+                                         bool shared_memory) {
 #ifdef SHARING_MODEL_WEIGHT
   if (pack_weight_ == nullptr) {
     pack_weight_ = std::make_shared<PackWeight>();
@@ -62,7 +68,7 @@ STATUS PackWeightManager::InitPackWeight(const char *model_buf, size_t model_siz
       return RET_ERROR;
     }
   }
-  auto status = pack_weight_->InitWeightManagerByBuf(model_buf, model_size, numa_id, true);
+  auto status = pack_weight_->InitWeightManagerByBuf(model_buf, model_size, numa_id, true, shared_memory);
   if (status != RET_OK) {
     MS_LOG(ERROR) << "InitWeightManagerByBuf failed.";
     return RET_ERROR;
@@ -29,13 +29,18 @@ class PackWeightManager {
  public:
   static PackWeightManager *GetInstance();
   ~PackWeightManager() = default;
-  STATUS InitPackWeight(const char *model_buf, size_t model_size, int numa_id = -1);
+  // The weights are shared by the models of the same content on the same numa node, which are found by the hash of
+  // the model buf. The copy of the model buf for the numa node is mapped from a shared memory segment if
+  // shared_memory is true, so that it is also shared by the processes loading the same model.
+  STATUS InitPackWeight(const char *model_buf, size_t model_size, int numa_id = -1, bool shared_memory = false);
   STATUS InitPackWeightByBuf(const char *model_buf, size_t model_size);
   char *GetNumaModelBuf(const char *model_buf, int numa_id);
   STATUS StoreOriginTensorData(Model *model, std::vector<Tensor *> *all_tensors);
   void *GetPackData(const void *tensor_data, const size_t size, bool *is_packed);
   void Free(void *tensor_data);
   bool IsCopyTensor(int op_type);
+  // Whether the packed weights are shared by the models, in which case they are looked up by the origin weights.
+  bool IsPackDataShared() const;
   void *ReplaceFp16Data(void *origin_fp16_data, size_t size, bool *replace);
 
  private:
@@ -94,6 +94,12 @@ void RuntimeAllocator::Clear(AllocatorPtr default_allocator) {
   used_list_.clear();
 }
 
+void RuntimeAllocator::RestoreOffsetMap(const std::unordered_map<lite::Tensor *, size_t> &offset_map,
+                                        size_t total_size) {
+  offset_map_ = offset_map;
+  total_size_ = total_size;
+}
+
 void RuntimeAllocator::MallocTensorData(lite::Tensor *tensor) {
   size_t size = tensor->Size();
   size_t offset = FindMinFree(size);
@@ -44,6 +44,9 @@ class RuntimeAllocator : public Allocator {
   void FreeTensorData(lite::Tensor *tensor);
   void *MallocOptData();
   const std::unordered_map<lite::Tensor *, size_t> &GetOffsetMap() const { return offset_map_; }
+  size_t total_size() const { return total_size_; }
+  // Restore the offsets planned for the same shapes of the tensors before, after the allocator is cleared.
+  void RestoreOffsetMap(const std::unordered_map<lite::Tensor *, size_t> &offset_map, size_t total_size);
   void Clear(AllocatorPtr default_allocator);
 
  private:
@@ -25,6 +25,7 @@
 #include "include/errorcode.h"
 #include "src/common/graph_util.h"
 #include "src/common/utils.h"
+#include "src/common/common.h"
 #include "src/litert/kernel_registry.h"
 #ifndef CUSTOM_KERNEL_REGISTRY_CLIP
 #include "include/registry/register_kernel.h"
@@ -1035,6 +1036,42 @@ void Scheduler::ResetByExecutionPlan(std::string node_name, TypeId *data_type) {
   return;
 }
 
+const Tensor *Scheduler::FindInt4QuantWeight(const std::vector<Tensor *> &in_tensors, const OpParameter *op_parameter,
+                                              TypeId kernel_data_type) const {
+  auto op_type = op_parameter->type_;
+  if ((op_type != schema::PrimitiveType_MatMulFusion && op_type != schema::PrimitiveType_FullConnection) ||
+      kernel_data_type != kNumberTypeFloat32 || is_train_session_ || config_info_ == nullptr ||
+      op_parameter->quant_type_ != static_cast<int>(schema::QuantType_QUANT_WEIGHT) ||
+      in_tensors.size() < kInputSize1) {
+    return nullptr;
+  }
+  auto section = config_info_->find(kWeightInt4);
+  if (section == config_info_->end()) {
+    return nullptr;
+  }
+  auto iter = section->second.find(kWeightInt4Enable);
+  if (iter == section->second.end()) {
+    return nullptr;
+  }
+  auto enable = GenericParseValue<bool>(iter->second);
+  if (enable.IsNone() || !enable.Get()) {
+    return nullptr;
+  }
+  // the same conditions as MatmulFp32BaseCPUKernel::CheckInt4WeightConditions, so that the kernel always runs with the
+  // int4 weight once the weight is kept quantized.
+  auto matmul_param = reinterpret_cast<const MatMulParameter *>(op_parameter);
+  bool b_transpose = op_type == schema::PrimitiveType_FullConnection || matmul_param->b_transpose_;
+  if (in_tensors[0]->IsConst() || (op_type == schema::PrimitiveType_MatMulFusion && matmul_param->a_transpose_)) {
+    return nullptr;
+  }
+  auto weight = in_tensors[1];
+  if (weight->shape().size() != DIMENSION_2D) {
+    return nullptr;
+  }
+  int col = b_transpose ? weight->shape()[0] : weight->shape()[1];
+  return WeightDecoder::IsInt4QuantWeight(weight, col) ? weight : nullptr;
+}
+
 int Scheduler::FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
                              OpParameter *op_parameter, const kernel::KernelKey &desc, TypeId kernel_data_type,
                              kernel::KernelExec **kernel) {
@@ -1052,7 +1089,8 @@ int Scheduler::FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std:
     cpu_desc.data_type = kNumberTypeFloat16;
   }
   auto ret = WeightDecoder::DequantNode(op_parameter, in_tensors, kernel_data_type, src_model_->graph_.version_,
-                                        context_->float_mode);
+                                        context_->float_mode,
+                                        FindInt4QuantWeight(in_tensors, op_parameter, kernel_data_type));
   if (ret != RET_OK) {
     MS_LOG(DEBUG) << "Dequant input tensors failed: " << ret;
     return RET_NOT_SUPPORT;
@@ -80,6 +80,9 @@ class Scheduler {
   int FindCpuKernel(const std::vector<Tensor *> &in_tensors, const std::vector<Tensor *> &out_tensors,
                     OpParameter *op_parameter, const kernel::KernelKey &desc, TypeId kernel_data_type,
                     kernel::KernelExec **kernel);
+  // the weight of the MatMul with int4 weight which is consumed in its quantized data type, nullptr if there is none.
+  const Tensor *FindInt4QuantWeight(const std::vector<Tensor *> &in_tensors, const OpParameter *op_parameter,
+                                    TypeId kernel_data_type) const;
   int CheckCpuValid(const std::vector<kernel::KernelExec *> *dst_kernels) const;
   void ResetByExecutionPlan(std::string node_name, TypeId *data_type);
 
@@ -16,6 +16,7 @@
 
 #include "src/litert/sub_graph_split.h"
 #include <cstdlib>
+#include <functional>
 #include <utility>
 #include <algorithm>
 #include <iterator>
@@ -27,6 +28,7 @@
 #include "src/common/ops/populate/populate_register.h"
 #include "src/litert/scheduler.h"
 #include "src/litert/tensor_category.h"
+#include "src/litert/thread_cost_model.h"
 #include "nnacl/pooling_parameter.h"
 #include "include/model.h"
 #include "nnacl/base/conv_common_base.h"
@@ -1146,7 +1148,6 @@ void SearchSubGraph::SubGraphSplitByOperator() {
     Subgraph subgraph;
     subgraph.ends_.push_back(out);
     subgraph.device_ = DT_CPU;
-    subgraph.thread_ = context_->thread_num_ > kOperatorMaxThreadNum ? kOperatorMaxThreadNum : context_->thread_num_;
 
     InsertNodeBegin(static_cast<uint32_t>(out), &subgraph, &outputs_vec);
     for (auto new_out : outputs_vec) {
@@ -1157,6 +1158,124 @@ void SearchSubGraph::SubGraphSplitByOperator() {
       sub_graphs_.push_back(std::move(subgraph));
     }
   }
+  AssignOperatorThreads(&sub_graphs_);
   ConvertSubGraphToModel(&sub_graphs_);
 }
+
+size_t SearchSubGraph::CalculateOperatorCost(uint32_t node_index) {
+  LiteGraph::Node *node = model_->graph_.all_nodes_[node_index];
+  if (node->output_indices_.empty()) {
+    return 1;
+  }
+  auto is_shape_known = [](const lite::Tensor *tensor) {
+    const auto &shape = tensor->shape();
+    return std::all_of(shape.begin(), shape.end(), [](int dim) { return dim > 0; });
+  };
+  auto output = src_tensors_->at(node->output_indices_.front());
+  if (!is_shape_known(output)) {
+    return 1;
+  }
+  auto type = GetPrimitiveType(node->primitive_, SCHEMA_VERSION::SCHEMA_CUR);
+  if (type == schema::PrimitiveType_Conv2DFusion && node->input_indices_.size() > 1) {
+    auto weight = src_tensors_->at(node->input_indices_.at(1));
+    if (output->shape().size() == DIMENSION_4D && weight->shape().size() == DIMENSION_4D && is_shape_known(weight)) {
+      return MSMAX(static_cast<size_t>(CalculateConv2DFusion(node).cost()), static_cast<size_t>(1));
+    }
+  }
+  auto output_num = static_cast<size_t>(MSMAX(output->ElementsNum(), 1));
+  if ((type == schema::PrimitiveType_MatMulFusion || type == schema::PrimitiveType_FullConnection) &&
+      !node->input_indices_.empty()) {
+    /* every output is a dot product along the last dim of the input */
+    auto input = src_tensors_->at(node->input_indices_.front());
+    if (!input->shape().empty() && is_shape_known(input)) {
+      return output_num * static_cast<size_t>(input->shape().back());
+    }
+  }
+  return output_num;
+}
+
+void SearchSubGraph::AssignOperatorThreads(std::vector<Subgraph> *sub_graphs) {
+  std::unordered_map<uint32_t, size_t> node_sub_index;
+  for (size_t i = 0; i < sub_graphs->size(); i++) {
+    for (auto node_index : sub_graphs->at(i).nodes_) {
+      node_sub_index[node_index] = i;
+    }
+  }
+  std::vector<std::set<size_t>> depends(sub_graphs->size());
+  for (size_t i = 0; i < sub_graphs->size(); i++) {
+    Subgraph &subgraph = sub_graphs->at(i);
+    subgraph.cost_.empty();
+    for (auto node_index : subgraph.nodes_) {
+      subgraph.cost_.mul_cost_ += CalculateOperatorCost(node_index);
+      for (auto input : model_->graph_.all_nodes_[node_index]->input_indices_) {
+        if (tensors_.at(input).type_ == CONST) {
+          continue;
+        }
+        for (auto in_node : tensors_.at(input).out_nodes_) {
+          auto iter = node_sub_index.find(in_node);
+          if (iter != node_sub_index.end() && iter->second != i) {
+            depends.at(i).insert(iter->second);
+          }
+        }
+      }
+    }
+  }
+
+  /* subgraphs at the same stage wait for the same number of subgraphs before them and run concurrently */
+  std::vector<size_t> stages(sub_graphs->size(), SIZE_MAX);
+  std::function<size_t(size_t)> get_stage = [&](size_t index) {
+    if (stages.at(index) == SIZE_MAX) {
+      stages.at(index) = 0;
+      for (auto depend : depends.at(index)) {
+        stages.at(index) = MSMAX(stages.at(index), get_stage(depend) + 1);
+      }
+    }
+    return stages.at(index);
+  };
+  std::map<size_t, std::vector<size_t>> stage_subs;
+  for (size_t i = 0; i < sub_graphs->size(); i++) {
+    stage_subs[get_stage(i)].push_back(i);
+  }
+
+  /* the threads are shared by the concurrent subgraphs in proportion to their costs, and a subgraph gets no more
+   * threads than its cost keeps busy */
+  auto total_thread = static_cast<size_t>(context_->thread_num_);
+  for (auto &stage_sub : stage_subs) {
+    auto &subs = stage_sub.second;
+    if (subs.size() == 1) {
+      sub_graphs->at(subs.front()).thread_ = MSMIN(total_thread, static_cast<size_t>(kOperatorMaxThreadNum));
+      continue;
+    }
+    std::vector<size_t> max_threads;
+    for (auto index : subs) {
+      ThreadCostContext cost_context = {static_cast<int64_t>(sub_graphs->at(index).cost_.mul_cost_), 0, 0, 1.0f};
+      auto max_thread = static_cast<size_t>(MSMIN(ThreadCostModel::ThreadNum(&cost_context), kOperatorMaxThreadNum));
+      max_threads.push_back(max_thread);
+      sub_graphs->at(index).thread_ = 1;
+    }
+    /* give the next thread to the subgraph with the largest cost per thread */
+    auto busier = [sub_graphs](size_t lhs, size_t rhs) {
+      const Subgraph &l = sub_graphs->at(lhs);
+      const Subgraph &r = sub_graphs->at(rhs);
+      return l.cost_.mul_cost_ * r.thread_ > r.cost_.mul_cost_ * l.thread_;
+    };
+    for (size_t left = total_thread > subs.size() ? total_thread - subs.size() : 0; left > 0; left--) {
+      size_t best = subs.size();
+      for (size_t i = 0; i < subs.size(); i++) {
+        if (sub_graphs->at(subs.at(i)).thread_ < max_threads.at(i) &&
+            (best == subs.size() || busier(subs.at(i), subs.at(best)))) {
+          best = i;
+        }
+      }
+      if (best == subs.size()) {
+        break;
+      }
+      sub_graphs->at(subs.at(best)).thread_++;
+    }
+    for (auto index : subs) {
+      MS_LOG(INFO) << "Operator subgraph " << index << " at stage " << stage_sub.first << ", cost "
+                   << sub_graphs->at(index).cost_.mul_cost_ << ", thread num " << sub_graphs->at(index).thread_;
+    }
+  }
+}
 }  // namespace mindspore::lite
@@ -105,6 +105,10 @@ class SearchSubGraph {
   void InsertHeadNode(uint32_t index, Subgraph *subgraph);
   void OptimizeAfterFusion(std::vector<Subgraph> *sub_graphs, uint32_t root_node_index);
 
+ private: /* split by operator */
+  size_t CalculateOperatorCost(uint32_t node_index);
+  void AssignOperatorThreads(std::vector<Subgraph> *sub_graphs);
+
  private: /* split by offline */
   void SubGraphSplitByOffLineParallel();
   void UpdateOfflineParallelFlag();
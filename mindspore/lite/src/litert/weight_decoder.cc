@@ -13,12 +13,14 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include "src/litert/weight_decoder.h"
 #include "src/litert/huffman_decode.h"
 #include "tools/converter/quantizer/fse_decoder.h"
 #include "nnacl/conv_parameter.h"
+#include "nnacl/fp32/matmul_sparse_weight_fp32.h"
 
 namespace mindspore::lite {
 #ifndef WEIGHT_DECODE_CLIP
@@ -364,6 +366,43 @@ STATUS WeightDecoder::IndexingDecompress(const SchemaTensorWrapper &src_tensor,
   return RET_OK;
 }
 
+STATUS WeightDecoder::BlockSparseDecompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor) {
+  MS_ASSERT(src_tensor.data() != nullptr);
+  MS_LOG(DEBUG) << "un-sparse block-sparse weight";
+  MS_CHECK_TRUE_MSG(dst_tensor->data_type() == kNumberTypeFloat32, RET_ERROR, "block-sparse weight is not float32.");
+  MS_CHECK_TRUE_MSG(src_tensor.length() >= sizeof(SparseWeightHeader), RET_ERROR, "block-sparse weight is too short.");
+  auto header = static_cast<const SparseWeightHeader *>(src_tensor.data());
+  auto deep = header->deep_;
+  auto col = header->col_;
+  auto block_num = header->block_num_;
+  auto shape_valid =
+    deep > 0 && col > 0 && block_num >= 0 && static_cast<int64_t>(deep) * col == dst_tensor->ElementsNum();
+  MS_CHECK_TRUE_MSG(shape_valid, RET_ERROR, "the shape of block-sparse weight does not match the tensor.");
+  size_t offset_num = static_cast<size_t>(UP_DIV(col, C8NUM)) + 1;
+  size_t expect_size = sizeof(SparseWeightHeader) + (offset_num + static_cast<size_t>(block_num)) * sizeof(int) +
+                       static_cast<size_t>(block_num) * C8NUM * sizeof(float);
+  MS_CHECK_TRUE_MSG(src_tensor.length() == expect_size, RET_ERROR, "the size of block-sparse weight is invalid.");
+  auto offsets = reinterpret_cast<const int *>(header + 1);
+  auto depths = offsets + offset_num;
+  auto values = reinterpret_cast<const float *>(depths + block_num);
+  for (size_t i = 0; i + 1 < offset_num; ++i) {
+    MS_CHECK_TRUE_MSG(offsets[i] >= 0 && offsets[i] <= offsets[i + 1] && offsets[i + 1] <= block_num, RET_ERROR,
+                      "the offsets of block-sparse weight are invalid.");
+  }
+  MS_CHECK_TRUE_MSG(offsets[offset_num - 1] == block_num, RET_ERROR, "the offsets of block-sparse weight are invalid.");
+  for (int i = 0; i < block_num; ++i) {
+    MS_CHECK_TRUE_MSG(depths[i] >= 0 && depths[i] < deep, RET_ERROR, "the depths of block-sparse weight are invalid.");
+  }
+  MS_CHECK_FALSE_MSG(dst_tensor->data() != nullptr, RET_ERROR, "data_c not null");
+  if (dst_tensor->MallocData() != RET_OK) {
+    MS_LOG(ERROR) << "Malloc tensor data failed";
+    return RET_NULL_PTR;
+  }
+  UnpackSparseWeightFp32(values, depths, offsets, reinterpret_cast<float *>(dst_tensor->data()), deep, col,
+                         header->deep_major_ != 0);
+  return RET_OK;
+}
+
 int WeightDecoder::DequantTensor(Tensor *tensor, int preferred_dim, TypeId dst_data_type) {
   MS_ASSERT(tensor != nullptr);
   if (!tensor->IsConst() ||
@@ -479,7 +518,8 @@ bool NeedBitUppackCheck(const SchemaTensorWrapper &src_tensor) {
 }
 
 int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors,
-                               TypeId dst_data_type, const std::string &model_version, bool float_mode) {
+                               TypeId dst_data_type, const std::string &model_version, bool float_mode,
+                               const Tensor *keep_tensor) {
 #ifndef WEIGHT_DECODE_CLIP
   if (op_parameter->quant_type_ != static_cast<int>(schema::QuantType_QUANT_WEIGHT) &&
       !(op_parameter->quant_type_ == static_cast<int>(schema::QuantType_QUANT_ALL) && float_mode)) {
@@ -488,6 +528,10 @@ int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vecto
   int index = 0;
   for (auto &tensor : in_tensors) {
     MS_CHECK_TRUE_RET(tensor != nullptr, RET_ERROR);
+    if (tensor == keep_tensor) {
+      index++;
+      continue;
+    }
     auto preferred_dim = GetPreferredDim(in_tensors, op_parameter, index++, tensor->shape(), model_version);
     auto ret = WeightDecoder::DequantTensor(tensor, preferred_dim, dst_data_type);
     if (ret != RET_OK && ret != RET_NO_CHANGE) {
@@ -508,6 +552,21 @@ int WeightDecoder::DequantNode(const OpParameter *op_parameter, const std::vecto
 #endif
 }
 
+bool WeightDecoder::IsInt4QuantWeight(const Tensor *tensor, int channel_num) {
+  MS_ASSERT(tensor != nullptr);
+  if (!tensor->IsConst() || tensor->data_type() != kNumberTypeInt8 || !tensor->quant_clusters().empty()) {
+    return false;
+  }
+  auto quant_params = tensor->quant_params();
+  if (quant_params.size() != kPerTensor && quant_params.size() != static_cast<size_t>(channel_num)) {
+    return false;
+  }
+  return std::all_of(quant_params.begin(), quant_params.end(), [](const LiteQuantParam &quant_param) {
+    return quant_param.inited && quant_param.bitNum >= kBitNum1 && quant_param.bitNum <= kBitNum4 &&
+           quant_param.clusters.empty();
+  });
+}
+
 int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor) {
   MS_ASSERT(src_tensor.handler() != nullptr);
   MS_ASSERT(dst_tensor != nullptr);
@@ -519,6 +578,8 @@ int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite:
     return IndexingDecompress(src_tensor, dst_tensor);
   } else if (src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_SPARSE) {
     return SparseDecompress(src_tensor, dst_tensor);
+  } else if (src_tensor.handler()->weightQuantCompressType() == schema::WeightQuantCompressType_BLOCK_SPARSE) {
+    return BlockSparseDecompress(src_tensor, dst_tensor);
   }
   if (!NeedBitUppackCheck(src_tensor)) {
     return RET_NO_CHANGE;
@@ -537,4 +598,14 @@ int WeightDecoder::DecompressTensor(const SchemaTensorWrapper &src_tensor, lite:
   return RET_NO_CHANGE;
 #endif
 }
+
+bool WeightDecoder::NeedDecompress(const SchemaTensorWrapper &src_tensor) {
+  MS_ASSERT(src_tensor.handler() != nullptr);
+#ifndef WEIGHT_DECODE_CLIP
+  return src_tensor.handler()->weightQuantCompressType() != schema::WeightQuantCompressType_NONE ||
+         NeedBitUppackCheck(src_tensor);
+#else
+  return false;
+#endif
+}
 }  // namespace mindspore::lite
@@ -34,6 +34,7 @@
 static constexpr int kPerTensor = 1;
 static constexpr int kBitNumMix = 0;
 static constexpr int kBitNum1 = 1;
+static constexpr int kBitNum4 = 4;
 static constexpr int kBitNum8 = 8;
 static constexpr int kBitNum16 = 16;
 static constexpr int kBitNum32 = 32;
@@ -42,9 +43,15 @@ namespace mindspore::lite {
 
 class WeightDecoder {
  public:
+  // keep_tensor is not dequantized, which is consumed by the kernel in its quantized data type directly.
   static int DequantNode(const OpParameter *op_parameter, const std::vector<Tensor *> &in_tensors, TypeId dst_data_type,
-                         const std::string &model_version, bool float_mode);
+                         const std::string &model_version, bool float_mode, const Tensor *keep_tensor = nullptr);
+  // Whether the tensor is the const int8 weight quantized by tensor or by the channels of channel_num with at most 4
+  // bits, which the MatMul with int4 weight consumes directly.
+  static bool IsInt4QuantWeight(const Tensor *tensor, int channel_num);
   static int DecompressTensor(const SchemaTensorWrapper &src_tensor, lite::Tensor *dst_tensor);
+  // Whether the data of the tensor is compressed, which is decoded by DecompressTensor.
+  static bool NeedDecompress(const SchemaTensorWrapper &src_tensor);
 
   template <typename T>
   static int GetPreferredDim(const std::vector<T *> &in_tensors, const OpParameter *op_parameter, int index,
@@ -111,6 +118,9 @@ class WeightDecoder {
 
   static STATUS IndexingDecompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor);
 
+  // the float32 weight encoded by the non-zero blocks by the converter, see nnacl/fp32/matmul_sparse_weight_fp32.h.
+  static STATUS BlockSparseDecompress(const SchemaTensorWrapper &src_tensor, Tensor *dst_tensor);
+
   static bool IsChannelFirst(int index, const OpParameter *op_parameter);
 
   // A * stride_a + bucket_index * stride_b + C
@@ -175,6 +175,11 @@ class Tensor {
 
   void set_quant_clusters(const std::vector<float> &clusters);
 
+  // the schema::WeightQuantCompressType the const data is stored with in the model, before it is decompressed.
+  int compress_type() const { return compress_type_; }
+
+  void set_compress_type(int compress_type) { compress_type_ = compress_type; }
+
   virtual bool IsConst() const {
     return (this->category_ == CONST_TENSOR || this->category_ == CONST_SCALAR) && this->data_ != nullptr;
   }
@@ -245,6 +250,7 @@ class Tensor {
   int init_ref_count_ = 0;
   std::vector<LiteQuantParam> quant_params_;
   std::vector<float> quant_clusters_;
+  int compress_type_ = 0;
   AllocatorPtr allocator_ = nullptr;
   bool own_data_{false};
   float scale_ = 1.0f;
@@ -25,6 +25,8 @@
 #include <queue>
 #include <map>
 #include <set>
+#include <cmath>
+#include <functional>
 #include "include/errorcode.h"
 #include "src/litert/lite_model.h"
 #include "src/litert/kernel_exec_util.h"
@@ -33,6 +35,7 @@
 #include "src/common/prim_util.h"
 #include "src/common/tensor_util.h"
 #include "src/common/utils.h"
+#include "src/common/common.h"
 #include "src/train/optimizer_kernel.h"
 #include "src/train/train_utils.h"
 #include "src/train/train_export.h"
@@ -295,7 +298,22 @@ int TrainSession::AllocTensors(const std::vector<kernel::KernelExec *> &kernels)
     }
   }
   // Set Tensor data
-  auto size = allocator.total_size();
+  auto ret = AllocTensorsData(allocator.total_size());
+  if (ret != RET_OK) {
+    return ret;
+  }
+  for (auto kernel : train_kernels_) {
+    for (auto tensor : kernel->out_tensors()) {
+      auto it = offset_map.find(tensor);
+      if (it != offset_map.end()) {
+        tensor->set_data(reinterpret_cast<void *>(reinterpret_cast<char *>(tensors_data_) + it->second));
+      }
+    }
+  }
+  return RET_OK;
+}
+
+int TrainSession::AllocTensorsData(size_t size) {
   if (size > tensors_data_size_) {
     free(tensors_data_);
     tensors_data_ = nullptr;
@@ -311,14 +329,264 @@ int TrainSession::AllocTensors(const std::vector<kernel::KernelExec *> &kernels)
     tensors_data_ = buf;
     tensors_data_size_ = size;
   }
+  return RET_OK;
+}
+
+void TrainSession::InitRecomputeConfig() {
+  recompute_ = false;
+  recompute_checkpoints_.clear();
+  if (config_info_ == nullptr) {
+    return;
+  }
+  auto section = config_info_->find(kRecompute);
+  if (section == config_info_->end()) {
+    return;
+  }
+  auto iter = section->second.find(kRecomputeEnable);
+  if (iter == section->second.end()) {
+    return;
+  }
+  auto enable = GenericParseValue<bool>(iter->second);
+  if (enable.IsNone() || !enable.Get()) {
+    return;
+  }
+  recompute_ = true;
+  iter = section->second.find(kRecomputeCheckpoints);
+  if (iter != section->second.end() && !iter->second.empty()) {
+    for (auto &name : StrSplit(iter->second, ",")) {
+      if (!name.empty()) {
+        recompute_checkpoints_.push_back(name);
+      }
+    }
+  }
+}
+
+int TrainSession::AllocTrainTensors() {
+  if (recompute_ && IS_STATIC_ALLOCATOR(allocator_) && !context_->IsCpuFloat16Enabled()) {
+    return AllocTensorsWithRecompute();
+  }
+  recompute_steps_.clear();
+  return AllocTensors(train_kernels_);
+}
+
+std::set<lite::Tensor *> TrainSession::GetRecomputeKeptTensors() {
+  std::unordered_map<lite::Tensor *, std::set<kernel::KernelExec *>> consumers;
+  for (auto kernel : train_kernels_) {
+    for (auto tensor : kernel->in_tensors()) {
+      consumers[tensor].insert(kernel);
+    }
+  }
+  // The outputs of the graph are read by the user, so they are never freed.
+  std::set<lite::Tensor *> kept;
   for (auto kernel : train_kernels_) {
     for (auto tensor : kernel->out_tensors()) {
-      auto it = offset_map.find(tensor);
-      if (it != offset_map.end()) {
-        tensor->set_data(reinterpret_cast<void *>(reinterpret_cast<char *>(tensors_data_) + it->second));
+      auto iter = consumers.find(tensor);
+      size_t consumer_num = iter == consumers.end() ? 0 : iter->second.size();
+      if (consumer_num == 0 || tensor->init_ref_count() > static_cast<int>(consumer_num)) {
+        kept.insert(tensor);
+      }
+    }
+  }
+  return kept;
+}
+
+bool TrainSession::IsRecomputeSupported(kernel::KernelExec *kernel) const {
+  // Replaying these kernels updates their states or draws other random numbers.
+  static const std::set<schema::PrimitiveType> unsupported_kernels = {
+    schema::PrimitiveType_BatchNorm,   schema::PrimitiveType_FusedBatchNorm,       schema::PrimitiveType_Dropout,
+    schema::PrimitiveType_Assign,      schema::PrimitiveType_AssignAdd,            schema::PrimitiveType_RandomNormal,
+    schema::PrimitiveType_UniformReal, schema::PrimitiveType_RandomStandardNormal};
+  return unsupported_kernels.find(kernel->type()) == unsupported_kernels.end() && !IsLossKernel(kernel) &&
+         !IsGradKernel(kernel) && !IsOptimizer(kernel);
+}
+
+size_t TrainSession::BuildRecomputeSteps(const std::set<lite::Tensor *> &kept, std::vector<RecomputeStep> *steps) {
+  auto backward_iter = std::find_if(train_kernels_.begin(), train_kernels_.end(), [this](kernel::KernelExec *kernel) {
+    return IsGradKernel(kernel) || IsOptimizer(kernel);
+  });
+  auto backward_start = static_cast<size_t>(backward_iter - train_kernels_.begin());
+  auto outputs_size = [](const kernel::KernelExec *kernel) {
+    size_t size = 0;
+    for (auto tensor : kernel->out_tensors()) {
+      size += tensor->Size();
+    }
+    return size;
+  };
+  std::vector<kernel::KernelExec *> candidates;
+  size_t total_size = 0;
+  for (size_t i = 0; i < backward_start; ++i) {
+    auto kernel = train_kernels_.at(i);
+    const auto &outputs = kernel->out_tensors();
+    if (!IsRecomputeSupported(kernel) ||
+        std::any_of(outputs.begin(), outputs.end(), [&kept](lite::Tensor *t) { return kept.count(t) != 0; })) {
+      continue;
+    }
+    candidates.push_back(kernel);
+    total_size += outputs_size(kernel);
+  }
+  // The outputs of the checkpoints stay alive until backward, the other candidates are replayed from them.
+  std::set<kernel::KernelExec *> recomputed;
+  const auto &checkpoints = recompute_checkpoints_;
+  if (!checkpoints.empty()) {
+    for (auto kernel : candidates) {
+      if (std::find(checkpoints.begin(), checkpoints.end(), kernel->name()) == checkpoints.end()) {
+        recomputed.insert(kernel);
+      }
+    }
+  } else if (!candidates.empty()) {
+    // Keeping one checkpoint every total / sqrt(n) bytes bounds both the kept and the replayed activations.
+    auto budget = static_cast<size_t>(total_size / std::sqrt(static_cast<double>(candidates.size())));
+    size_t accumulated = 0;
+    for (auto kernel : candidates) {
+      accumulated += outputs_size(kernel);
+      if (accumulated >= budget) {
+        accumulated = 0;
+        continue;
+      }
+      recomputed.insert(kernel);
+    }
+  }
+  std::unordered_map<lite::Tensor *, kernel::KernelExec *> producers;
+  for (auto kernel : recomputed) {
+    for (auto tensor : kernel->out_tensors()) {
+      producers[tensor] = kernel;
+    }
+  }
+  std::set<kernel::KernelExec *> replayed;
+  std::function<void(kernel::KernelExec *)> replay = [&](kernel::KernelExec *kernel) {
+    if (!replayed.insert(kernel).second) {
+      return;
+    }
+    for (auto tensor : kernel->in_tensors()) {
+      auto iter = producers.find(tensor);
+      if (iter != producers.end()) {
+        replay(iter->second);
+      }
+    }
+    steps->push_back({kernel, true, {}});
+  };
+  steps->clear();
+  for (size_t i = 0; i < train_kernels_.size(); ++i) {
+    auto kernel = train_kernels_.at(i);
+    if (i >= backward_start) {
+      for (auto tensor : kernel->in_tensors()) {
+        auto iter = producers.find(tensor);
+        if (iter != producers.end()) {
+          replay(iter->second);
+        }
+      }
+    }
+    steps->push_back({kernel, false, {}});
+  }
+  return replayed.size();
+}
+
+size_t TrainSession::PlanRecomputeSteps(const std::set<lite::Tensor *> &kept, std::vector<RecomputeStep> *steps) {
+  // Every execution of a kernel produces new instances of its outputs, a replayed tensor has one instance in forward
+  // and another one in backward, and each of them is freed after its own last use.
+  constexpr size_t kNoInstance = SIZE_MAX;
+  std::unordered_map<lite::Tensor *, size_t> current;
+  std::vector<size_t> last_use;
+  std::vector<std::vector<size_t>> in_instances(steps->size());
+  std::vector<std::vector<size_t>> out_instances(steps->size());
+  for (size_t s = 0; s < steps->size(); ++s) {
+    auto kernel = steps->at(s).kernel;
+    for (auto tensor : kernel->in_tensors()) {
+      auto iter = current.find(tensor);
+      if (iter == current.end()) {
+        in_instances[s].push_back(kNoInstance);
+        continue;
+      }
+      last_use[iter->second] = s;
+      in_instances[s].push_back(iter->second);
+    }
+    for (auto tensor : kernel->out_tensors()) {
+      current[tensor] = last_use.size();
+      out_instances[s].push_back(last_use.size());
+      last_use.push_back(s);
+    }
+  }
+  OptAllocator allocator;
+  std::vector<size_t> offsets(last_use.size(), 0);
+  std::vector<bool> released(last_use.size(), false);
+  for (size_t s = 0; s < steps->size(); ++s) {
+    auto &step = steps->at(s);
+    const auto &inputs = step.kernel->in_tensors();
+    const auto &outputs = step.kernel->out_tensors();
+    step.out_offsets.clear();
+    for (size_t j = 0; j < outputs.size(); ++j) {
+      auto id = out_instances[s][j];
+      bool in_place = false;
+      for (size_t i = 0; s != 0 && IsInPlaceKernel(step.kernel) && i < inputs.size(); ++i) {
+        auto in_id = in_instances[s][i];
+        if (in_id != kNoInstance && !released[in_id] && last_use[in_id] == s &&
+            inputs[i]->category() == lite::Category::VAR && kept.count(inputs[i]) == 0 &&
+            inputs[i]->Size() == outputs[j]->Size()) {
+          offsets[id] = offsets[in_id];
+          released[in_id] = true;
+          in_place = true;
+          break;
+        }
+      }
+      if (!in_place) {
+        offsets[id] = allocator.Malloc(outputs[j]->Size());
+      }
+      step.out_offsets.push_back(offsets[id]);
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+      auto in_id = in_instances[s][i];
+      if (in_id == kNoInstance || released[in_id] || last_use[in_id] != s || kept.count(inputs[i]) != 0) {
+        continue;
+      }
+      released[in_id] = true;
+      allocator.Free(offsets[in_id]);
+    }
+    // The forward outputs which are only used in backward are replaced by the replayed ones.
+    for (size_t j = 0; j < outputs.size(); ++j) {
+      auto id = out_instances[s][j];
+      if (!released[id] && last_use[id] == s && kept.count(outputs[j]) == 0) {
+        released[id] = true;
+        allocator.Free(offsets[id]);
       }
     }
   }
+  return allocator.total_size();
+}
+
+int TrainSession::AllocTensorsWithRecompute() {
+  auto kept = GetRecomputeKeptTensors();
+  std::vector<RecomputeStep> plain_steps;
+  for (auto kernel : train_kernels_) {
+    plain_steps.push_back({kernel, false, {}});
+  }
+  auto plain_size = PlanRecomputeSteps(kept, &plain_steps);
+  std::vector<RecomputeStep> steps;
+  auto replay_num = BuildRecomputeSteps(kept, &steps);
+  auto size = replay_num == 0 ? plain_size : PlanRecomputeSteps(kept, &steps);
+  if (size >= plain_size) {
+    MS_LOG(INFO) << "Recomputation does not reduce the memory of the activations, it is disabled.";
+    recompute_steps_.clear();
+    return AllocTensors(train_kernels_);
+  }
+  MS_LOG(INFO) << "Recompute " << replay_num << " forward kernels in backward, the memory of the activations is "
+               << "reduced from " << plain_size << " bytes to " << size << " bytes.";
+  // The buffer sized by the plain order while compiling is released, otherwise the recomputation saves nothing.
+  if (size < tensors_data_size_) {
+    free(tensors_data_);
+    tensors_data_ = nullptr;
+    tensors_data_size_ = 0;
+  }
+  auto ret = AllocTensorsData(size);
+  if (ret != RET_OK) {
+    return ret;
+  }
+  recompute_steps_ = std::move(steps);
+  // The replayed outputs are placed when they are recomputed.
+  for (auto &step : recompute_steps_) {
+    for (size_t i = 0; !step.replay && i < step.out_offsets.size(); ++i) {
+      step.kernel->out_tensors().at(i)->set_data(reinterpret_cast<char *>(tensors_data_) + step.out_offsets[i]);
+    }
+  }
   return RET_OK;
 }
 
@@ -326,6 +594,7 @@ int TrainSession::CompileGraph(lite::Model *model) { return lite::RET_ERROR; }
 
 int TrainSession::CompileTrainGraph(std::shared_ptr<Model> model) {
   model_ = model;
+  InitRecomputeConfig();
   auto restore = ReplaceOps();
   sched_cb_ = std::make_unique<SchedulerCb>(sched_mix_precision_callback_);
   if (sched_cb_ == nullptr) {
@@ -390,6 +659,23 @@ int TrainSession::ExecKernels(const KernelCallBack &before, const KernelCallBack
   return RET_OK;
 }
 
+int TrainSession::ExecRecomputeKernels(const KernelCallBack &before, const KernelCallBack &after) {
+  for (auto &step : recompute_steps_) {
+    auto kernel = step.kernel;
+    MS_ASSERT(kernel != nullptr);
+    for (size_t i = 0; i < step.out_offsets.size(); ++i) {
+      kernel->out_tensors().at(i)->set_data(reinterpret_cast<char *>(tensors_data_) + step.out_offsets[i]);
+    }
+    // The callbacks see every kernel once, the replays are hidden from them.
+    auto ret = step.replay ? kernel->Execute() : kernel->Execute(before, after);
+    if (RET_OK != ret) {
+      MS_LOG(ERROR) << "Execute kernel failed, name: " << kernel->name();
+      return ret;
+    }
+  }
+  return RET_OK;
+}
+
 void TrainSession::RestoreTensorData() {
   for (auto &restored_origin_tensor : restored_origin_tensors_) {
     auto *origin_tensor = restored_origin_tensor.first;
@@ -565,6 +851,8 @@ int TrainSession::RunGraph(const KernelCallBack &before, const KernelCallBack &a
   auto &run_kernels = (train_mode_) ? train_kernels_ : inference_kernels_;
   if (context_->IsCpuFloat16Enabled()) {
     ret = MixPrecisionExecKernels(before, after, run_kernels);
+  } else if (train_mode_ && !recompute_steps_.empty()) {
+    ret = ExecRecomputeKernels(before, after);
   } else {
     ret = ExecKernels(before, after, run_kernels);
   }
@@ -611,7 +899,7 @@ int TrainSession::Train() {
     }
   }
   // allocate tensors
-  auto ret = AllocTensors(train_kernels_);
+  auto ret = AllocTrainTensors();
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "failed to allocate tensor space";
     return RET_ERROR;
@@ -1087,7 +1375,7 @@ int TrainSession::Resize(const std::vector<lite::Tensor *> &inputs, const std::v
     MS_LOG(ERROR) << "failed to allocate space";
     return RET_ERROR;
   }
-  ret = AllocTensors(train_kernels_);
+  ret = train_mode_ ? AllocTrainTensors() : AllocTensors(train_kernels_);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "train alloc failed after resize.";
     return RET_ERROR;
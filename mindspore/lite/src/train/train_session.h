@@ -21,6 +21,7 @@
 #include <unordered_map>
 #include <memory>
 #include <map>
+#include <set>
 #include "include/train/train_cfg.h"
 #include "src/litert/lite_session.h"
 
@@ -165,6 +166,22 @@ class TrainSession : virtual public lite::LiteSession {
                                 const std::unordered_map<lite::Tensor *, size_t> &offset_map,
                                 std::unordered_map<lite::Tensor *, int> *ref_count, uint32_t input_idx);
 
+  // One execution of a train kernel, a replayed forward kernel recomputes the activations freed after forward.
+  struct RecomputeStep {
+    kernel::KernelExec *kernel = nullptr;
+    bool replay = false;
+    std::vector<size_t> out_offsets;
+  };
+  void InitRecomputeConfig();
+  int AllocTrainTensors();
+  int AllocTensorsData(size_t size);
+  int AllocTensorsWithRecompute();
+  std::set<lite::Tensor *> GetRecomputeKeptTensors();
+  bool IsRecomputeSupported(kernel::KernelExec *kernel) const;
+  size_t BuildRecomputeSteps(const std::set<lite::Tensor *> &kept, std::vector<RecomputeStep> *steps);
+  size_t PlanRecomputeSteps(const std::set<lite::Tensor *> &kept, std::vector<RecomputeStep> *steps);
+  int ExecRecomputeKernels(const KernelCallBack &before, const KernelCallBack &after);
+
   std::map<Tensor *, Tensor *> restored_origin_tensors_;
   int virtual_batch_idx_ = 0;
   int virtual_batch_multiplier_ = 0;
@@ -174,6 +191,9 @@ class TrainSession : virtual public lite::LiteSession {
   bool train_mode_ = false;
   void *tensors_data_ = nullptr;
   size_t tensors_data_size_ = 0;
+  bool recompute_ = false;
+  std::vector<std::string> recompute_checkpoints_;
+  std::vector<RecomputeStep> recompute_steps_;
   std::shared_ptr<Allocator> allocator_;
 };
 
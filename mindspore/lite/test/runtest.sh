@@ -172,4 +172,5 @@ fi
 if [ "$MSLITE_ENABLE_SERVER_INFERENCE" = on ];then
   echo 'run ModelParallelRunner api ut test'
   ./lite-test --gtest_filter="ModelParallelRunnerTest.*"
+  ./lite-test --gtest_filter="ModelPoolPipelineTest.*"
 fi
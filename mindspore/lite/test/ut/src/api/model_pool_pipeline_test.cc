@@ -0,0 +1,300 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <fstream>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "common/common_test.h"
+#include "include/api/context.h"
+#include "include/api/model_parallel_runner.h"
+#include "schema/inner/model_generated.h"
+#include "src/common/common.h"
+#include "src/common/utils.h"
+#define private public
+#include "src/extendrt/cxx_api/model_pool/model_pool.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr int64_t kBatch = 4;
+constexpr int64_t kChannel = 3;
+constexpr size_t kMicroBatchNum = 2;
+const char kStageModelPath[] = "./pipeline_stage1.ms";
+
+struct NodeDef {
+  schema::PrimitiveType type;
+  std::vector<std::string> inputs;
+  std::vector<std::string> outputs;
+};
+
+// an elementwise graph of the float tensors [kBatch, kChannel] found by their names
+std::vector<char> CreateModelBuf(const std::vector<NodeDef> &nodes, const std::vector<std::string> &inputs,
+                                 const std::vector<std::string> &outputs) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  meta_graph->version = Version();
+  std::map<std::string, uint32_t> tensor_index;
+  auto get_index = [&meta_graph, &tensor_index](const std::string &name) {
+    auto iter = tensor_index.find(name);
+    if (iter != tensor_index.end()) {
+      return iter->second;
+    }
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = lite::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = kNumberTypeFloat32;
+    tensor->dims = {static_cast<int>(kBatch), static_cast<int>(kChannel)};
+    tensor->offset = -1;
+    tensor->name = name;
+    meta_graph->allTensors.emplace_back(std::move(tensor));
+    auto index = static_cast<uint32_t>(meta_graph->allTensors.size() - 1);
+    tensor_index[name] = index;
+    return index;
+  };
+  auto sub_graph = std::make_unique<schema::SubGraphT>();
+  sub_graph->name = "graph";
+  for (auto &input : inputs) {
+    meta_graph->inputIndex.push_back(get_index(input));
+  }
+  for (size_t i = 0; i < nodes.size(); i++) {
+    auto node = std::make_unique<schema::CNodeT>();
+    for (auto &input : nodes[i].inputs) {
+      node->inputIndex.push_back(get_index(input));
+    }
+    for (auto &output : nodes[i].outputs) {
+      node->outputIndex.push_back(get_index(output));
+    }
+    node->primitive = std::make_unique<schema::PrimitiveT>();
+    node->primitive->value.type = nodes[i].type;
+    if (nodes[i].type == schema::PrimitiveType_Abs) {
+      node->primitive->value.value = new schema::AbsT;
+    } else {
+      node->primitive->value.value = new schema::NegT;
+    }
+    node->name = "node" + std::to_string(i);
+    meta_graph->nodes.emplace_back(std::move(node));
+    sub_graph->nodeIndices.push_back(static_cast<uint32_t>(i));
+  }
+  for (auto &output : outputs) {
+    meta_graph->outputIndex.push_back(get_index(output));
+  }
+  sub_graph->inputIndices = meta_graph->inputIndex;
+  sub_graph->outputIndices = meta_graph->outputIndex;
+  for (uint32_t i = 0; i < meta_graph->allTensors.size(); i++) {
+    sub_graph->tensorIndices.push_back(i);
+  }
+  meta_graph->subGraph.emplace_back(std::move(sub_graph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  schema::FinishMetaGraphBuffer(builder, offset);
+  auto buf = reinterpret_cast<char *>(builder.GetBufferPointer());
+  return std::vector<char>(buf, buf + builder.GetSize());
+}
+
+std::shared_ptr<RunnerConfig> CreateRunnerConfig() {
+  auto config = std::make_shared<RunnerConfig>();
+  auto context = std::make_shared<Context>();
+  context->SetThreadNum(1);
+  context->MutableDeviceInfo().push_back(std::make_shared<CPUDeviceInfo>());
+  config->SetContext(context);
+  config->SetWorkersNum(1);
+  return config;
+}
+
+MSTensor *CreateInput(const std::string &name, int64_t batch, std::vector<float> *data) {
+  data->resize(batch * kChannel);
+  for (size_t i = 0; i < data->size(); i++) {
+    data->at(i) = static_cast<float>(i % 5) - 2.0f;
+  }
+  return MSTensor::CreateTensor(name, DataType::kNumberTypeFloat32, {batch, kChannel}, data->data(),
+                                data->size() * sizeof(float));
+}
+}  // namespace
+
+class ModelPoolPipelineTest : public mindspore::CommonTest {
+ public:
+  ModelPoolPipelineTest() = default;
+
+  // the first stage computes a = abs(x) and an unused b = neg(x), the second stage computes y = neg(a)
+  void SetUp() override {
+    stage0_buf_ = CreateModelBuf({{schema::PrimitiveType_Abs, {"x"}, {"a"}}, {schema::PrimitiveType_Neg, {"x"}, {"b"}}},
+                                 {"x"}, {"a", "b"});
+    auto stage1_buf = CreateModelBuf({{schema::PrimitiveType_Neg, {"a"}, {"y"}}}, {"a"}, {"y"});
+    std::ofstream stage1_file(kStageModelPath, std::ios::binary);
+    stage1_file.write(stage1_buf.data(), static_cast<std::streamsize>(stage1_buf.size()));
+    stage1_file.close();
+    full_buf_ = CreateModelBuf({{schema::PrimitiveType_Abs, {"x"}, {"a"}}, {schema::PrimitiveType_Neg, {"a"}, {"y"}}},
+                               {"x"}, {"y"});
+  }
+
+  void TearDown() override { (void)remove(kStageModelPath); }
+
+  std::shared_ptr<RunnerConfig> CreatePipelineConfig() {
+    auto config = CreateRunnerConfig();
+    config->SetConfigInfo(lite::kPipeline, {{lite::kPipelineStageModels, kStageModelPath},
+                                            {lite::kPipelineMicroBatchNum, std::to_string(kMicroBatchNum)}});
+    return config;
+  }
+
+ protected:
+  std::vector<char> stage0_buf_;
+  std::vector<char> full_buf_;
+};
+
+TEST_F(ModelPoolPipelineTest, SplitMicroBatch) {
+  ModelPool pool;
+  pool.micro_batch_num_ = kMicroBatchNum;
+  std::vector<float> data;
+  auto input = CreateInput("x", kBatch, &data);
+  ASSERT_NE(input, nullptr);
+  std::vector<std::vector<MSTensor>> micro_inputs;
+  ASSERT_EQ(pool.SplitMicroBatch({*input}, &micro_inputs), kSuccess);
+  ASSERT_EQ(micro_inputs.size(), kMicroBatchNum);
+  auto micro_size = input->DataSize() / kMicroBatchNum;
+  for (size_t i = 0; i < kMicroBatchNum; i++) {
+    ASSERT_EQ(micro_inputs[i].size(), 1);
+    auto &micro_input = micro_inputs[i].front();
+    ASSERT_EQ(micro_input.Name(), "x");
+    ASSERT_EQ(micro_input.Shape(), std::vector<int64_t>({kBatch / static_cast<int64_t>(kMicroBatchNum), kChannel}));
+    ASSERT_EQ(micro_input.DataSize(), micro_size);
+    // the micro batches refer to the slices of the input
+    ASSERT_EQ(micro_input.MutableData(), static_cast<uint8_t *>(input->MutableData()) + i * micro_size);
+  }
+
+  // the batch which can not be split evenly is not split
+  std::vector<float> odd_data;
+  auto odd_input = CreateInput("x", kBatch - 1, &odd_data);
+  ASSERT_NE(odd_input, nullptr);
+  micro_inputs.clear();
+  ASSERT_EQ(pool.SplitMicroBatch({*odd_input}, &micro_inputs), kSuccess);
+  ASSERT_EQ(micro_inputs.size(), 1);
+  ASSERT_EQ(micro_inputs.front().front().Shape(), odd_input->Shape());
+
+  // neither are the inputs of different batches
+  micro_inputs.clear();
+  ASSERT_EQ(pool.SplitMicroBatch({*input, *odd_input}, &micro_inputs), kSuccess);
+  ASSERT_EQ(micro_inputs.size(), 1);
+  ASSERT_EQ(micro_inputs.front().size(), 2);
+  delete input;
+  delete odd_input;
+}
+
+TEST_F(ModelPoolPipelineTest, ConcatMicroBatch) {
+  ModelPool pool;
+  std::vector<float> data;
+  auto output = CreateInput("y", kBatch, &data);
+  ASSERT_NE(output, nullptr);
+  pool.model_pool_outputs_ = {*output};
+  std::vector<PipelineTask> tasks(kMicroBatchNum);
+  auto micro_batch = kBatch / static_cast<int64_t>(kMicroBatchNum);
+  auto micro_size = output->DataSize() / kMicroBatchNum;
+  for (size_t i = 0; i < kMicroBatchNum; i++) {
+    auto micro_output = MSTensor::CreateTensor("y", DataType::kNumberTypeFloat32, {micro_batch, kChannel},
+                                               static_cast<uint8_t *>(output->MutableData()) + i * micro_size,
+                                               micro_size);
+    ASSERT_NE(micro_output, nullptr);
+    tasks[i].tensors["y"] = *micro_output;
+    delete micro_output;
+  }
+  std::vector<MSTensor> outputs;
+  ASSERT_EQ(pool.ConcatMicroBatch(&tasks, &outputs), kSuccess);
+  ASSERT_EQ(outputs.size(), 1);
+  ASSERT_EQ(outputs.front().Shape(), output->Shape());
+  ASSERT_EQ(memcmp(outputs.front().MutableData(), data.data(), output->DataSize()), 0);
+
+  // the outputs set by the user are filled in place
+  std::vector<float> user_data(data.size(), 0.0f);
+  auto user_output = MSTensor::CreateRefTensor("y", DataType::kNumberTypeFloat32, {kBatch, kChannel},
+                                               user_data.data(), user_data.size() * sizeof(float));
+  ASSERT_NE(user_output, nullptr);
+  outputs = {*user_output};
+  ASSERT_EQ(pool.ConcatMicroBatch(&tasks, &outputs), kSuccess);
+  ASSERT_EQ(outputs.front().MutableData(), user_data.data());
+  ASSERT_EQ(user_data, data);
+  delete user_output;
+  delete output;
+}
+
+TEST_F(ModelPoolPipelineTest, ReleaseTensors) {
+  ModelPool pool;
+  ASSERT_EQ(pool.InitByBuf(stage0_buf_.data(), stage0_buf_.size(), CreatePipelineConfig()), kSuccess);
+  ASSERT_EQ(pool.pipeline_stages_.size(), 2);
+  // x and the unused b are released by the first stage, a by the second one, y is the output of the pool
+  auto release0 = pool.pipeline_stages_[0]->release_tensors_;
+  std::sort(release0.begin(), release0.end());
+  ASSERT_EQ(release0, std::vector<std::string>({"b", "x"}));
+  ASSERT_EQ(pool.pipeline_stages_[1]->release_tensors_, std::vector<std::string>({"a"}));
+}
+
+TEST_F(ModelPoolPipelineTest, StageInputNotProduced) {
+  // the second stage needs a, which is neither produced by the first stage nor an input of it
+  auto stage0_buf = CreateModelBuf({{schema::PrimitiveType_Neg, {"x"}, {"y"}}}, {"x"}, {"y"});
+  auto stage1_buf = CreateModelBuf({{schema::PrimitiveType_Abs, {"a"}, {"z"}}}, {"a"}, {"z"});
+  std::ofstream stage1_file(kStageModelPath, std::ios::binary);
+  stage1_file.write(stage1_buf.data(), static_cast<std::streamsize>(stage1_buf.size()));
+  stage1_file.close();
+  ModelPool pool;
+  ASSERT_NE(pool.InitByBuf(stage0_buf.data(), stage0_buf.size(), CreatePipelineConfig()), kSuccess);
+}
+
+TEST_F(ModelPoolPipelineTest, SameAsUnsplitModel) {
+  ModelPool full_pool;
+  ASSERT_EQ(full_pool.InitByBuf(full_buf_.data(), full_buf_.size(), CreateRunnerConfig()), kSuccess);
+  ModelPool pipeline_pool;
+  ASSERT_EQ(pipeline_pool.InitByBuf(stage0_buf_.data(), stage0_buf_.size(), CreatePipelineConfig()), kSuccess);
+  ASSERT_TRUE(pipeline_pool.use_pipeline_);
+  ASSERT_EQ(pipeline_pool.GetOutputs().size(), 1);
+  ASSERT_EQ(pipeline_pool.GetOutputs().front().Name(), "y");
+
+  std::vector<float> data;
+  auto input = CreateInput("x", kBatch, &data);
+  ASSERT_NE(input, nullptr);
+  std::vector<MSTensor> full_outputs;
+  ASSERT_EQ(full_pool.Predict({*input}, &full_outputs), kSuccess);
+  std::vector<MSTensor> pipeline_outputs;
+  ASSERT_EQ(pipeline_pool.Predict({*input}, &pipeline_outputs), kSuccess);
+  ASSERT_EQ(full_outputs.size(), 1);
+  ASSERT_EQ(pipeline_outputs.size(), 1);
+  ASSERT_EQ(pipeline_outputs.front().Shape(), full_outputs.front().Shape());
+  ASSERT_EQ(pipeline_outputs.front().DataSize(), full_outputs.front().DataSize());
+  ASSERT_EQ(memcmp(pipeline_outputs.front().MutableData(), full_outputs.front().MutableData(),
+                   full_outputs.front().DataSize()),
+            0);
+
+  // every micro batch runs through both stages
+  auto utilization = pipeline_pool.GetPipelineUtilization();
+  ASSERT_EQ(utilization.size(), 2);
+  for (size_t i = 0; i < utilization.size(); i++) {
+    ASSERT_EQ(pipeline_pool.pipeline_stages_[i]->TaskNum(), kMicroBatchNum);
+    ASSERT_GE(utilization[i], 0.0f);
+    ASSERT_LE(utilization[i], 1.0f);
+  }
+  delete input;
+}
+}  // namespace mindspore
@@ -15,14 +15,20 @@
  */
 
 #include <cmath>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #include "schema/inner/model_generated.h"
 #include "common/common_test.h"
 #include "include/context.h"
 #include "include/errorcode.h"
 #include "src/common/log_adapter.h"
+#define private public
 #include "src/litert/lite_session.h"
+#undef private
 #include "src/common/file_utils.h"
+#include "src/common/common.h"
 
 namespace mindspore {
 class InferTest : public mindspore::CommonTest {
@@ -30,6 +36,100 @@ class InferTest : public mindspore::CommonTest {
   InferTest() {}
 };
 
+namespace {
+constexpr int kConvInChannel = 3;
+constexpr int kConvOutChannel = 8;
+constexpr int kConvKernelSize = 3;
+constexpr int kConvStride = 2;
+
+// a convolution with the same pad mode and the stride of 2, whose pads depend on the input shape
+lite::Model *ImportSamePadConvModel() {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, 1};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_Conv2DFusion;
+  auto primitive = new schema::Conv2DFusionT;
+  primitive->pad_mode = schema::PadMode_SAME;
+  primitive->in_channel = kConvInChannel;
+  primitive->out_channel = kConvOutChannel;
+  primitive->format = schema::Format_NHWC;
+  primitive->stride = std::vector<int64_t>{kConvStride, kConvStride};
+  primitive->kernel_size = std::vector<int64_t>{kConvKernelSize, kConvKernelSize};
+  primitive->dilation = std::vector<int64_t>{1, 1};
+  node->primitive->value.value = primitive;
+  node->name = "Conv2D";
+  meta_graph->nodes.emplace_back(std::move(node));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+
+  auto input = std::make_unique<schema::TensorT>();
+  input->nodeType = lite::NodeType_Parameter;
+  input->format = schema::Format_NHWC;
+  input->dataType = TypeId::kNumberTypeFloat32;
+  input->dims = {1, 28, 28, kConvInChannel};
+  input->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(input));
+
+  auto weight = std::make_unique<schema::TensorT>();
+  weight->nodeType = lite::NodeType_ValueNode;
+  weight->format = schema::Format_KHWC;
+  weight->dataType = TypeId::kNumberTypeFloat32;
+  weight->dims = {kConvOutChannel, kConvKernelSize, kConvKernelSize, kConvInChannel};
+  std::vector<float> weight_data(kConvOutChannel * kConvKernelSize * kConvKernelSize * kConvInChannel);
+  for (size_t i = 0; i < weight_data.size(); ++i) {
+    weight_data[i] = static_cast<float>(i % 7) * 0.1f - 0.3f;
+  }
+  weight->data.resize(weight_data.size() * sizeof(float));
+  memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  weight->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(weight));
+
+  auto output = std::make_unique<schema::TensorT>();
+  output->nodeType = lite::NodeType_Parameter;
+  output->format = schema::Format_NHWC;
+  output->dataType = TypeId::kNumberTypeFloat32;
+  output->offset = -1;
+  meta_graph->allTensors.emplace_back(std::move(output));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  return lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+}
+
+lite::LiteSession *CreateCpuSession() {
+  auto context = new lite::InnerContext;
+  context->device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+  context->thread_num_ = 2;
+  if (context->Init() != lite::RET_OK) {
+    delete context;
+    return nullptr;
+  }
+  return lite::LiteSession::CreateSession(context);
+}
+
+// resize the session to the shape, run it with a fixed input and return the output
+std::vector<float> ResizeAndRun(lite::LiteSession *session, const std::vector<int> &shape) {
+  auto inputs = session->GetInputs();
+  if (inputs.size() != 1 || session->Resize(inputs, {shape}) != lite::RET_OK) {
+    return {};
+  }
+  auto input_data = reinterpret_cast<float *>(inputs.front()->MutableData());
+  for (int i = 0; i < inputs.front()->ElementsNum(); ++i) {
+    input_data[i] = static_cast<float>(i % 11) * 0.2f - 1.0f;
+  }
+  if (session->RunGraph() != lite::RET_OK) {
+    return {};
+  }
+  auto output = session->GetOutputs().begin()->second;
+  auto output_data = reinterpret_cast<float *>(output->MutableData());
+  return std::vector<float>(output_data, output_data + output->ElementsNum());
+}
+}  // namespace
+
 TEST_F(InferTest, TestConvNode) {
   auto meta_graph = std::make_shared<schema::MetaGraphT>();
   meta_graph->name = "graph";
@@ -142,6 +242,51 @@ TEST_F(InferTest, TestConvNode) {
   MS_LOG(INFO) << "Passed";
 }
 
+/// Feature: the resize plan cache of the session.
+/// Description: resize a convolution with the same pad mode from shape A to shape B and back to A, whose pads differ,
+///              with the resize plans cached.
+/// Expectation: the outputs of shape A are the same as the ones of a session which is never resized to B, and the
+///              plans are cached only where the runtime allocator is valid, i.e. on arm64.
+TEST_F(InferTest, TestConvResizePlan) {
+  const std::vector<int> shape_a = {1, 31, 31, kConvInChannel};
+  const std::vector<int> shape_b = {1, 32, 32, kConvInChannel};
+  std::map<std::string, std::map<std::string, std::string>> config_info = {
+    {lite::kResizePlan, {{lite::kResizePlanMaxNum, "4"}}}};
+
+  auto model = ImportSamePadConvModel();
+  ASSERT_NE(nullptr, model);
+  auto session = CreateCpuSession();
+  ASSERT_NE(nullptr, session);
+  session->SetConfigInfo(&config_info);
+  ASSERT_EQ(lite::RET_OK, session->CompileGraph(model));
+  auto first_output = ResizeAndRun(session, shape_a);
+  ASSERT_FALSE(first_output.empty());
+  ASSERT_FALSE(ResizeAndRun(session, shape_b).empty());
+  auto plan_output = ResizeAndRun(session, shape_a);
+  // a plan for each of the shapes, where the runtime allocator plans the memory
+  size_t expect_plan_num = session->RuntimeAllocatorValid() == lite::RET_OK ? 2 : 0;
+  ASSERT_EQ(session->resize_plans_.size(), expect_plan_num);
+
+  auto fresh_model = ImportSamePadConvModel();
+  ASSERT_NE(nullptr, fresh_model);
+  auto fresh_session = CreateCpuSession();
+  ASSERT_NE(nullptr, fresh_session);
+  ASSERT_EQ(lite::RET_OK, fresh_session->CompileGraph(fresh_model));
+  auto fresh_output = ResizeAndRun(fresh_session, shape_a);
+  ASSERT_FALSE(fresh_output.empty());
+
+  ASSERT_EQ(plan_output.size(), fresh_output.size());
+  ASSERT_EQ(first_output.size(), fresh_output.size());
+  for (size_t i = 0; i < fresh_output.size(); ++i) {
+    ASSERT_FLOAT_EQ(plan_output[i], fresh_output[i]);
+    ASSERT_FLOAT_EQ(first_output[i], fresh_output[i]);
+  }
+  delete session;
+  delete model;
+  delete fresh_session;
+  delete fresh_model;
+}
+
 TEST_F(InferTest, TestAddNode) {
   auto meta_graph = std::make_shared<schema::MetaGraphT>();
   meta_graph->name = "graph";
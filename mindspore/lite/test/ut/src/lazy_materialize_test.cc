@@ -0,0 +1,203 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "schema/inner/model_generated.h"
+#include "src/common/common.h"
+#include "src/litert/lite_model.h"
+#define private public
+#include "src/litert/lite_session.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr int kRow = 4;
+constexpr int kDeep = 16;
+constexpr int kCol = 8;
+constexpr int kWeightIndex = 1;
+constexpr int kPackedBitNum = 4;
+constexpr int kBitNumPerByte = 8;
+constexpr float kQuantScale = 0.05f;
+using ConfigInfos = std::map<std::string, std::map<std::string, std::string>>;
+
+std::unique_ptr<schema::TensorT> CreateTensorT(TypeId data_type, const std::vector<int> &dims, int node_type) {
+  auto tensor = std::make_unique<schema::TensorT>();
+  tensor->nodeType = node_type;
+  tensor->format = schema::Format_NHWC;
+  tensor->dataType = data_type;
+  tensor->dims = dims;
+  tensor->offset = -1;
+  return tensor;
+}
+
+void AddQuantParam(schema::TensorT *tensor, int num_bits) {
+  auto quant_param = std::make_unique<schema::QuantParamT>();
+  quant_param->scale = kQuantScale;
+  quant_param->zeroPoint = 0;
+  quant_param->numBits = num_bits;
+  quant_param->inited = true;
+  tensor->quantParams.emplace_back(std::move(quant_param));
+}
+
+// a matmul of the input and a const weight. The int8 model is full quantized, with the weight bit-packed to 4 bits,
+// which is decoded when the matmul is prepared.
+lite::Model *ImportMatMulModel(bool int8) {
+  auto meta_graph = std::make_shared<schema::MetaGraphT>();
+  meta_graph->name = "graph";
+  meta_graph->version = Version();
+  auto node = std::make_unique<schema::CNodeT>();
+  node->inputIndex = {0, kWeightIndex};
+  node->outputIndex = {2};
+  node->primitive = std::make_unique<schema::PrimitiveT>();
+  node->primitive->value.type = schema::PrimitiveType_MatMulFusion;
+  node->primitive->value.value = new schema::MatMulFusionT;
+  node->name = "matmul";
+  node->quantType = int8 ? schema::QuantType_QUANT_ALL : schema::QuantType_QUANT_NONE;
+  meta_graph->nodes.emplace_back(std::move(node));
+
+  auto data_type = int8 ? kNumberTypeInt8 : kNumberTypeFloat32;
+  auto input = CreateTensorT(data_type, {kRow, kDeep}, lite::NodeType_Parameter);
+  auto weight = CreateTensorT(data_type, {kDeep, kCol}, lite::NodeType_ValueNode);
+  auto output = CreateTensorT(data_type, {kRow, kCol}, lite::NodeType_Parameter);
+  if (int8) {
+    AddQuantParam(input.get(), kBitNumPerByte);
+    AddQuantParam(weight.get(), kPackedBitNum);
+    AddQuantParam(output.get(), kBitNumPerByte);
+    weight->data.resize(kDeep * kCol * kPackedBitNum / kBitNumPerByte);
+    for (size_t i = 0; i < weight->data.size(); ++i) {
+      weight->data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+  } else {
+    std::vector<float> weight_data(kDeep * kCol);
+    for (size_t i = 0; i < weight_data.size(); ++i) {
+      weight_data[i] = static_cast<float>(i % 7) * 0.1f - 0.3f;
+    }
+    weight->data.resize(weight_data.size() * sizeof(float));
+    memcpy(weight->data.data(), weight_data.data(), weight->data.size());
+  }
+  meta_graph->allTensors.emplace_back(std::move(input));
+  meta_graph->allTensors.emplace_back(std::move(weight));
+  meta_graph->allTensors.emplace_back(std::move(output));
+  meta_graph->inputIndex = {0};
+  meta_graph->outputIndex = {2};
+  auto sub_graph = std::make_unique<schema::SubGraphT>();
+  sub_graph->name = "graph";
+  sub_graph->inputIndices = {0};
+  sub_graph->outputIndices = {2};
+  sub_graph->nodeIndices = {0};
+  sub_graph->tensorIndices = {0, 1, 2};
+  meta_graph->subGraph.emplace_back(std::move(sub_graph));
+
+  flatbuffers::FlatBufferBuilder builder(1024);
+  auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+  builder.Finish(offset);
+  schema::FinishMetaGraphBuffer(builder, offset);
+  auto model = lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  if (model != nullptr) {
+    // the lazy weights are read from the model buf at the first execution
+    reinterpret_cast<lite::LiteModel *>(model)->set_keep_model_buf(true);
+  }
+  return model;
+}
+}  // namespace
+
+class LazyMaterializeTest : public mindspore::CommonTest {
+ public:
+  LazyMaterializeTest() = default;
+
+  std::unique_ptr<lite::LiteSession> CreateSession(lite::Model *model, const ConfigInfos *config_info) {
+    lite::Context context;
+    context.device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+    context.thread_num_ = 1;
+    auto session = std::unique_ptr<lite::LiteSession>(lite::LiteSession::CreateSession(&context));
+    if (session == nullptr) {
+      return nullptr;
+    }
+    session->SetConfigInfo(config_info);
+    if (session->CompileGraph(model) != lite::RET_OK) {
+      return nullptr;
+    }
+    return session;
+  }
+
+  std::vector<char> Run(lite::LiteSession *session) {
+    auto input = session->GetInputs().front();
+    auto input_data = reinterpret_cast<int8_t *>(input->MutableData());
+    if (input->data_type() == kNumberTypeInt8) {
+      for (int i = 0; i < input->ElementsNum(); ++i) {
+        input_data[i] = static_cast<int8_t>(i % 13 - 6);
+      }
+    } else {
+      for (int i = 0; i < input->ElementsNum(); ++i) {
+        reinterpret_cast<float *>(input_data)[i] = static_cast<float>(i % 11) * 0.2f - 1.0f;
+      }
+    }
+    if (session->RunGraph() != lite::RET_OK) {
+      return {};
+    }
+    auto output = session->GetOutputs().begin()->second;
+    auto output_data = reinterpret_cast<char *>(output->MutableData());
+    return std::vector<char>(output_data, output_data + output->Size());
+  }
+
+  void CompareLazyAndEager(bool int8) {
+    auto model = std::unique_ptr<lite::Model>(ImportMatMulModel(int8));
+    ASSERT_NE(model, nullptr);
+    auto eager = CreateSession(model.get(), nullptr);
+    ASSERT_NE(eager, nullptr);
+    ConfigInfos config_info = {{lite::kWeight, {{lite::kWeightLazyMaterialize, "true"}}}};
+    auto lazy = CreateSession(model.get(), &config_info);
+    ASSERT_NE(lazy, nullptr);
+    ASSERT_TRUE(lazy->lazy_materialize_);
+    ASSERT_EQ(lazy->lazy_kernels_.size(), 1);
+    auto weight = lazy->tensors_.at(kWeightIndex);
+    // the origin weight is kept, or not decoded yet, till the matmul is prepared
+    ASSERT_EQ(lazy->lazy_tensor_ref_count_.count(weight), 1);
+    ASSERT_EQ(lazy->lazy_tensor_ref_count_[weight], 1);
+    if (int8) {
+      ASSERT_EQ(lazy->lazy_decode_tensors_.count(weight), 1);
+      ASSERT_EQ(weight->data(), nullptr);
+    } else {
+      ASSERT_NE(weight->data(), nullptr);
+    }
+
+    auto eager_output = Run(eager.get());
+    auto lazy_output = Run(lazy.get());
+    ASSERT_FALSE(eager_output.empty());
+    ASSERT_EQ(lazy_output, eager_output);
+    // the origin weight is released once the matmul is prepared at its first execution, the decoded one is freed
+    // as the eager session does, while the float one refers to the model buf.
+    ASSERT_TRUE(lazy->lazy_kernels_.empty());
+    ASSERT_TRUE(lazy->lazy_decode_tensors_.empty());
+    ASSERT_TRUE(lazy->lazy_tensor_ref_count_.empty());
+    if (int8) {
+      ASSERT_EQ(weight->data(), nullptr);
+      ASSERT_EQ(eager->tensors_.at(kWeightIndex)->data(), nullptr);
+    }
+    ASSERT_EQ(Run(lazy.get()), eager_output);
+  }
+};
+
+TEST_F(LazyMaterializeTest, Fp32MatMul) { CompareLazyAndEager(false); }
+
+TEST_F(LazyMaterializeTest, BitPackedInt8MatMul) { CompareLazyAndEager(true); }
+}  // namespace mindspore
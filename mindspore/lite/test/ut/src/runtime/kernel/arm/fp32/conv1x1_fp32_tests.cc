@@ -14,9 +14,14 @@
  * limitations under the License.
  */
 #include <iostream>
+#include <memory>
+#include <vector>
 #include "common/common_test.h"
 #include "nnacl/matmul_parameter.h"
+#include "schema/model_generated.h"
+#define private public
 #include "src/litert/kernel/cpu/fp32/convolution_1x1_fp32.h"
+#undef private
 
 namespace mindspore {
 using mindspore::lite::Tensor;
@@ -135,4 +140,79 @@ TEST_F(TestConv1x1Fp32, Input1x1PrePack4) {
   EXPECT_EQ(0, CompareOutputData(out, correct, 54));
   delete conv_param;
 }
+
+TEST_F(TestConv1x1Fp32, Conv1x1SparseWeight) {
+  constexpr int kInputHW = 5;
+  constexpr int kOutputHW = 3;
+  constexpr int kStride = 2;
+  constexpr int kInputChannel = 16;
+  constexpr int kOutputChannel = 20;
+  std::vector<float> in(kInputHW * kInputHW * kInputChannel);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<float>(static_cast<int>(i * 7 % 19) - 9) / 10;
+  }
+  // only one of every 3 input channels of a block of 8 output channels has non-zero values.
+  std::vector<float> weight(kOutputChannel * kInputChannel, 0.0f);
+  for (int n = 0; n < kOutputChannel; ++n) {
+    for (int k = (n / C8NUM) % C3NUM; k < kInputChannel; k += C3NUM) {
+      weight[n * kInputChannel + k] = static_cast<float>(static_cast<int>((n * kInputChannel + k) * 11 % 23) - 11) / 50;
+    }
+  }
+  std::vector<float> bias(kOutputChannel);
+  for (int n = 0; n < kOutputChannel; ++n) {
+    bias[n] = static_cast<float>(n % 5 - 2) / 10;
+  }
+  std::vector<float> except_result(kOutputHW * kOutputHW * kOutputChannel);
+  for (int h = 0; h < kOutputHW; ++h) {
+    for (int w = 0; w < kOutputHW; ++w) {
+      auto cur_in = in.data() + (h * kStride * kInputHW + w * kStride) * kInputChannel;
+      for (int n = 0; n < kOutputChannel; ++n) {
+        float value = bias[n];
+        for (int k = 0; k < kInputChannel; ++k) {
+          value += cur_in[k] * weight[n * kInputChannel + k];
+        }
+        except_result[(h * kOutputHW + w) * kOutputChannel + n] = value;
+      }
+    }
+  }
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(ctx->Init(), lite::RET_OK);
+
+  // The sparse kernel is selected by the weight encoded as block-sparse only.
+  for (bool block_sparse : {false, true}) {
+    lite::Tensor input(kNumberTypeFloat32, {1, kInputHW, kInputHW, kInputChannel}, mindspore::NHWC);
+    lite::Tensor filter(kNumberTypeFloat32, {kOutputChannel, 1, 1, kInputChannel}, mindspore::NHWC,
+                        lite::Category::CONST_TENSOR);
+    lite::Tensor bias_tensor(kNumberTypeFloat32, {kOutputChannel}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+    lite::Tensor output(kNumberTypeFloat32, {1, kOutputHW, kOutputHW, kOutputChannel}, mindspore::NHWC);
+    ASSERT_EQ(input.MallocData(), lite::RET_OK);
+    ASSERT_EQ(filter.MallocData(), lite::RET_OK);
+    ASSERT_EQ(bias_tensor.MallocData(), lite::RET_OK);
+    ASSERT_EQ(output.MallocData(), lite::RET_OK);
+    memcpy(input.data(), in.data(), input.Size());
+    memcpy(filter.data(), weight.data(), filter.Size());
+    memcpy(bias_tensor.data(), bias.data(), bias_tensor.Size());
+    filter.set_compress_type(block_sparse ? schema::WeightQuantCompressType_BLOCK_SPARSE
+                                          : schema::WeightQuantCompressType_NONE);
+
+    auto conv_param = reinterpret_cast<ConvParameter *>(malloc(sizeof(ConvParameter)));
+    ASSERT_NE(conv_param, nullptr);
+    memset(conv_param, 0, sizeof(ConvParameter));
+    conv_param->op_parameter_.thread_num_ = ctx->thread_num_;
+    conv_param->kernel_h_ = conv_param->kernel_w_ = 1;
+    conv_param->stride_h_ = conv_param->stride_w_ = kStride;
+    conv_param->dilation_h_ = conv_param->dilation_w_ = 1;
+    conv_param->group_ = 1;
+    kernel::Convolution1x1CPUKernel kernel(reinterpret_cast<OpParameter *>(conv_param), {&input, &filter, &bias_tensor},
+                                           {&output}, ctx.get(), reinterpret_cast<float *>(filter.data()),
+                                           reinterpret_cast<float *>(bias_tensor.data()));
+    ASSERT_EQ(kernel.Prepare(), lite::RET_OK);
+    ASSERT_EQ(kernel.weight_sparse_, block_sparse);
+    ASSERT_EQ(kernel.ReSize(), lite::RET_OK);
+    ASSERT_EQ(kernel.Run(), lite::RET_OK);
+    ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(output.data()), except_result.data(),
+                                   output.ElementsNum(), 0.0001));
+  }
+}
 }  // namespace mindspore
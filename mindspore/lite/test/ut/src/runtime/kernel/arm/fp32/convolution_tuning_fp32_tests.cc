@@ -0,0 +1,174 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <map>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "src/common/common.h"
+#include "src/litert/kernel/cpu/fp32/convolution_tuning_fp32.h"
+#include "src/litert/kernel/cpu/fp32/convolution_delegate_fp32.h"
+
+namespace mindspore {
+class TestConvTuningFp32 : public mindspore::CommonTest {
+ public:
+  TestConvTuningFp32() {}
+  void SetUp() override {
+    (void)std::remove(kTuningFile);
+    (void)std::remove(kSelectFile);
+    (void)std::remove(kPresetFile);
+  }
+  void TearDown() override {
+    (void)std::remove(kTuningFile);
+    (void)std::remove(kSelectFile);
+    (void)std::remove(kPresetFile);
+  }
+
+  static constexpr char kTuningFile[] = "./conv_tuning_test.txt";
+  static constexpr char kSelectFile[] = "./conv_tuning_select_test.txt";
+  static constexpr char kPresetFile[] = "./conv_tuning_preset_test.txt";
+};
+
+namespace {
+// Exposes the algorithm of the kernel which the delegate runs.
+class ConvTuningDelegateKernel : public kernel::ConvolutionDelegateCPUKernel {
+ public:
+  using kernel::ConvolutionDelegateCPUKernel::ConvolutionDelegateCPUKernel;
+  kernel::ConvAlgorithm SelectedAlgorithm() const {
+    return conv_kernel_ == nullptr ? kernel::kConvAlgoUnknown : conv_algorithm_;
+  }
+};
+
+void InitTuningConvParam(ConvParameter *conv_param) {
+  conv_param->op_parameter_.thread_num_ = 1;
+  conv_param->input_batch_ = 1;
+  conv_param->input_h_ = 16;
+  conv_param->input_w_ = 16;
+  conv_param->input_channel_ = 16;
+  conv_param->output_batch_ = 1;
+  conv_param->output_h_ = 16;
+  conv_param->output_w_ = 16;
+  conv_param->output_channel_ = 16;
+  conv_param->kernel_h_ = 3;
+  conv_param->kernel_w_ = 3;
+  conv_param->stride_h_ = 1;
+  conv_param->stride_w_ = 1;
+  conv_param->dilation_h_ = 1;
+  conv_param->dilation_w_ = 1;
+  conv_param->pad_u_ = 1;
+  conv_param->pad_d_ = 1;
+  conv_param->pad_l_ = 1;
+  conv_param->pad_r_ = 1;
+  conv_param->group_ = 1;
+}
+
+// Prepare a 3x3 conv delegate with the tuning file, and return the algorithm of the kernel it runs.
+kernel::ConvAlgorithm PrepareTuningConv(const std::string &tuning_file, std::string *key) {
+  auto conv_param = reinterpret_cast<ConvParameter *>(malloc(sizeof(ConvParameter)));
+  if (conv_param == nullptr) {
+    return kernel::kConvAlgoUnknown;
+  }
+  (void)memset(conv_param, 0, sizeof(ConvParameter));
+  InitTuningConvParam(conv_param);
+  *key = kernel::ConvTuningCache::BuildKey(conv_param, conv_param->op_parameter_.thread_num_);
+
+  lite::Tensor input(kNumberTypeFloat32, {1, 16, 16, 16}, mindspore::NHWC);
+  lite::Tensor weight(kNumberTypeFloat32, {16, 3, 3, 16}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor bias(kNumberTypeFloat32, {16}, mindspore::NHWC, lite::Category::CONST_TENSOR);
+  lite::Tensor output(kNumberTypeFloat32, {1, 16, 16, 16}, mindspore::NHWC);
+  if (input.MallocData() != lite::RET_OK || weight.MallocData() != lite::RET_OK ||
+      bias.MallocData() != lite::RET_OK || output.MallocData() != lite::RET_OK) {
+    free(conv_param);
+    return kernel::kConvAlgoUnknown;
+  }
+  auto weight_data = reinterpret_cast<float *>(weight.data());
+  for (int i = 0; i < weight.ElementsNum(); ++i) {
+    weight_data[i] = static_cast<float>(i % 7) * 0.1f;
+  }
+  (void)memset(bias.data(), 0, bias.Size());
+  (void)memset(input.data(), 0, input.Size());
+
+  lite::InnerContext ctx;
+  ctx.thread_num_ = 1;
+  if (ctx.Init() != lite::RET_OK) {
+    free(conv_param);
+    return kernel::kConvAlgoUnknown;
+  }
+  std::map<std::string, std::map<std::string, std::string>> config = {
+    {lite::kConvTuning, {{lite::kConvTuningFile, tuning_file}}}};
+  auto selected = kernel::kConvAlgoUnknown;
+  {
+    ConvTuningDelegateKernel kernel(reinterpret_cast<OpParameter *>(conv_param), {&input, &weight, &bias}, {&output},
+                                    &ctx);
+    kernel.SetConfig(&config);
+    if (kernel.Prepare() == lite::RET_OK) {
+      selected = kernel.SelectedAlgorithm();
+    }
+  }
+  return selected;
+}
+}  // namespace
+
+TEST_F(TestConvTuningFp32, TuningCacheReload) {
+  ConvParameter conv_param = {};
+  conv_param.input_batch_ = 1;
+  conv_param.input_h_ = 56;
+  conv_param.input_w_ = 56;
+  conv_param.input_channel_ = 64;
+  conv_param.output_h_ = 56;
+  conv_param.output_w_ = 56;
+  conv_param.output_channel_ = 64;
+  conv_param.kernel_h_ = 3;
+  conv_param.kernel_w_ = 3;
+  conv_param.stride_h_ = 1;
+  conv_param.stride_w_ = 1;
+  conv_param.dilation_h_ = 1;
+  conv_param.dilation_w_ = 1;
+  auto key = kernel::ConvTuningCache::BuildKey(&conv_param, 4);
+  {
+    kernel::ConvTuningCache cache(kTuningFile);
+    ASSERT_EQ(cache.Get(key), kernel::kConvAlgoUnknown);
+    cache.Put(key, kernel::kConvAlgoWinograd);
+    ASSERT_EQ(cache.Get(key), kernel::kConvAlgoWinograd);
+  }
+  // The tuning result is reloaded by another session, and the key differs by the thread number.
+  kernel::ConvTuningCache cache(kTuningFile);
+  ASSERT_EQ(cache.Get(key), kernel::kConvAlgoWinograd);
+  ASSERT_EQ(cache.Get(kernel::ConvTuningCache::BuildKey(&conv_param, 2)), kernel::kConvAlgoUnknown);
+}
+
+// The fastest algorithm written to the tuning file is the one the conv delegate runs.
+TEST_F(TestConvTuningFp32, TunedAlgorithmIsSelected) {
+  std::string key;
+  auto selected = PrepareTuningConv(kSelectFile, &key);
+  ASSERT_NE(selected, kernel::kConvAlgoUnknown);
+  kernel::ConvTuningCache cache(kSelectFile);
+  ASSERT_EQ(cache.Get(key), selected);
+}
+
+// The algorithm read from the tuning file is run even if the heuristics prefer another one.
+TEST_F(TestConvTuningFp32, PresetAlgorithmIsSelected) {
+  ConvParameter conv_param = {};
+  InitTuningConvParam(&conv_param);
+  {
+    kernel::ConvTuningCache cache(kPresetFile);
+    cache.Put(kernel::ConvTuningCache::BuildKey(&conv_param, conv_param.op_parameter_.thread_num_),
+              kernel::kConvAlgoIm2Col);
+  }
+  std::string key;
+  ASSERT_EQ(PrepareTuningConv(kPresetFile, &key), kernel::kConvAlgoIm2Col);
+}
+}  // namespace mindspore
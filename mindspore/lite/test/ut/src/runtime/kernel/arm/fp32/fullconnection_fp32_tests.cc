@@ -14,16 +14,24 @@
  * limitations under the License.
  */
 #include <sys/time.h>
+#include <algorithm>
 #include <iostream>
+#include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #include "common/common_test.h"
 #include "nnacl/fp32/matmul_fp32.h"
+#include "nnacl/fp32/matmul_int4_weight_fp32.h"
+#include "src/common/common.h"
 #include "src/common/file_utils.h"
+#include "src/common/utils.h"
 #include "src/litert/tensor_category.h"
 #include "src/common/log_adapter.h"
 #include "src/litert/kernel/cpu/fp32/fullconnection_fp32.h"
 #include "src/litert/infer_manager.h"
 #include "src/litert/kernel_registry.h"
+#include "schema/model_generated.h"
 
 namespace mindspore {
 using mindspore::lite::Tensor;
@@ -272,4 +280,318 @@ TEST_F(TestFcFp32, FcTest4_Vec2Batch) {
   DestroyTensors(inputs);
   DestroyTensors(outputs);
 }
+
+TEST_F(TestFcFp32, FcInt4WeightTest) {
+  constexpr int kRow = 5;
+  constexpr int kDeep = 70;
+  constexpr int kCol = 6;
+  constexpr int kGroupSize = 32;
+  std::vector<float> in(kRow * kDeep);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<float>(static_cast<int>(i * 7 % 19) - 9) / 10;
+  }
+  std::vector<float> weight(kCol * kDeep);
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<float>(static_cast<int>(i * 11 % 23) - 11) / 50;
+  }
+  std::vector<float> bias = {0.1, -0.2, 0.3, -0.4, 0.5, -0.6};
+  std::vector<lite::Tensor *> inputs;
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kDeep}, in));
+  inputs.push_back(
+    CreateTensor<float>(kNumberTypeFloat32, {kCol, kDeep}, weight, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  inputs.push_back(
+    CreateTensor<float>(kNumberTypeFloat32, {kCol}, bias, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  std::vector<lite::Tensor *> outputs;
+  outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kCol}, {}));
+
+  auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  memset(param, 0, sizeof(MatMulParameter));
+  param->b_transpose_ = true;
+  param->a_transpose_ = false;
+  param->has_bias_ = true;
+  param->act_type_ = ActType_No;
+  param->op_parameter_.type_ = schema::PrimitiveType_FullConnection;
+  KernelInferShape(inputs, outputs, reinterpret_cast<OpParameter *>(param));
+
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(ctx->Init(), RET_OK);
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_FullConnection};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  auto *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+  ASSERT_NE(kernel, nullptr);
+  std::map<std::string, std::map<std::string, std::string>> config = {
+    {lite::kWeightInt4, {{lite::kWeightInt4Enable, "true"}, {lite::kWeightInt4GroupSize, std::to_string(kGroupSize)}}}};
+  kernel->SetConfig(&config);
+  ASSERT_EQ(kernel->Prepare(), RET_OK);
+  ASSERT_EQ(kernel->Run(), RET_OK);
+
+  // The output is the same as the one of the dequantized weight.
+  constexpr int kGroupNum = UP_DIV(kDeep, kGroupSize);
+  std::vector<uint8_t> int4_weight(kCol * UP_DIV(kDeep, C2NUM));
+  std::vector<float> scales(kCol * kGroupNum);
+  std::vector<float> mins(kCol * kGroupNum);
+  QuantizeWeightToInt4Fp32(weight.data(), int4_weight.data(), scales.data(), mins.data(), kDeep, kCol, kGroupSize,
+                           true);
+  std::vector<float> except_result(kRow * kCol);
+  for (int r = 0; r < kRow; ++r) {
+    for (int n = 0; n < kCol; ++n) {
+      float value = bias[n];
+      for (int k = 0; k < kDeep; ++k) {
+        int q = (int4_weight[n * UP_DIV(kDeep, C2NUM) + k / C2NUM] >> ((k % C2NUM) * C4NUM)) & 0x0F;
+        int group_index = n * kGroupNum + k / kGroupSize;
+        value += in[r * kDeep + k] * (q * scales[group_index] + mins[group_index]);
+      }
+      except_result[r * kCol + n] = value;
+    }
+  }
+  ASSERT_EQ(0, CompareOutputData(static_cast<float *>(outputs[0]->data()), except_result.data(),
+                                 outputs[0]->ElementsNum(), 0.0001));
+  delete kernel;
+  DestroyTensors(inputs);
+  DestroyTensors(outputs);
+}
+
+TEST_F(TestFcFp32, FcInt4QuantWeightTest) {
+  constexpr int kRow = 3;
+  constexpr int kDeep = 40;
+  constexpr int kCol = 4;
+  constexpr int kBitNum = 4;
+  std::vector<float> in(kRow * kDeep);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<float>(static_cast<int>(i * 7 % 19) - 9) / 10;
+  }
+  // the weight quantized by channel with 4 bits, which is consumed by the kernel without being dequantized.
+  std::vector<int8_t> weight(kCol * kDeep);
+  for (size_t i = 0; i < weight.size(); ++i) {
+    weight[i] = static_cast<int8_t>(static_cast<int>(i * 5 % 16) - 8);
+  }
+  std::vector<lite::LiteQuantParam> quant_params(kCol);
+  for (int n = 0; n < kCol; ++n) {
+    quant_params[n].scale = 0.01 * (n + 1);
+    quant_params[n].zeroPoint = n - 1;
+    quant_params[n].bitNum = kBitNum;
+    quant_params[n].inited = true;
+  }
+  std::vector<lite::Tensor *> inputs;
+  inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kDeep}, in));
+  inputs.push_back(
+    CreateTensor<int8_t>(kNumberTypeInt8, {kCol, kDeep}, weight, mindspore::NHWC, lite::Category::CONST_TENSOR));
+  inputs[1]->set_quant_params(quant_params);
+  std::vector<lite::Tensor *> outputs;
+  outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kCol}, {}));
+
+  auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  memset(param, 0, sizeof(MatMulParameter));
+  param->b_transpose_ = true;
+  param->a_transpose_ = false;
+  param->has_bias_ = false;
+  param->act_type_ = ActType_No;
+  param->op_parameter_.type_ = schema::PrimitiveType_FullConnection;
+  KernelInferShape(inputs, outputs, reinterpret_cast<OpParameter *>(param));
+
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(ctx->Init(), RET_OK);
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_FullConnection};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  ASSERT_NE(creator, nullptr);
+  auto *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx.get(), desc);
+  ASSERT_NE(kernel, nullptr);
+  std::map<std::string, std::map<std::string, std::string>> config = {
+    {lite::kWeightInt4, {{lite::kWeightInt4Enable, "true"}}}};
+  kernel->SetConfig(&config);
+  ASSERT_EQ(kernel->Prepare(), RET_OK);
+  // the weight is not read after preparing.
+  inputs[1]->FreeData();
+  ASSERT_EQ(kernel->Run(), RET_OK);
+
+  // The output is the same as the one of the weight dequantized as (q - zero_point) * scale.
+  std::vector<float> except_result(kRow * kCol);
+  for (int r = 0; r < kRow; ++r) {
+    for (int n = 0; n < kCol; ++n) {
+      float value = 0.0f;
+      for (int k = 0; k < kDeep; ++k) {
+        value += in[r * kDeep + k] *
+                 static_cast<float>((weight[n * kDeep + k] - quant_params[n].zeroPoint) * quant_params[n].scale);
+      }
+      except_result[r * kCol + n] = value;
+    }
+  }
+  ASSERT_EQ(0, CompareOutputData(static_cast<float *>(outputs[0]->data()), except_result.data(),
+                                 outputs[0]->ElementsNum(), 0.0001));
+  delete kernel;
+  DestroyTensors(inputs);
+  DestroyTensors(outputs);
+}
+
+namespace {
+// a fullconnection kernel of the const weight and bias, the weight is run as block-sparse if it's encoded so.
+kernel::LiteKernel *CreateFcKernel(const std::vector<lite::Tensor *> &inputs,
+                                   const std::vector<lite::Tensor *> &outputs, const lite::InnerContext *ctx,
+                                   bool block_sparse) {
+  auto param = static_cast<MatMulParameter *>(malloc(sizeof(MatMulParameter)));
+  if (param == nullptr) {
+    return nullptr;
+  }
+  memset(param, 0, sizeof(MatMulParameter));
+  param->b_transpose_ = true;
+  param->a_transpose_ = false;
+  param->has_bias_ = true;
+  param->act_type_ = ActType_Relu;
+  param->op_parameter_.type_ = schema::PrimitiveType_FullConnection;
+  param->op_parameter_.thread_num_ = ctx->thread_num_;
+  // the converter encodes the sparse weight, which is decoded to dense when the model is loaded.
+  inputs[SECOND_INPUT]->set_compress_type(block_sparse ? schema::WeightQuantCompressType_BLOCK_SPARSE
+                                                       : schema::WeightQuantCompressType_NONE);
+  KernelInferShape(inputs, outputs, reinterpret_cast<OpParameter *>(param));
+  kernel::KernelKey desc = {kernel::KERNEL_ARCH::kCPU, kNumberTypeFloat32, NHWC, schema::PrimitiveType_FullConnection};
+  auto creator = lite::KernelRegistry::GetInstance()->GetCreator(desc);
+  if (creator == nullptr) {
+    free(param);
+    return nullptr;
+  }
+  auto *kernel = creator(inputs, outputs, reinterpret_cast<OpParameter *>(param), ctx, desc);
+  if (kernel == nullptr) {
+    return nullptr;
+  }
+  if (kernel->Prepare() != RET_OK) {
+    delete kernel;
+    return nullptr;
+  }
+  return kernel;
+}
+
+// only one of every block_step depths of a block of 8 output channels has non-zero values.
+std::vector<float> CreateBlockSparseWeight(int col, int deep, int block_step) {
+  std::vector<float> weight(col * deep, 0.0f);
+  for (int n = 0; n < col; ++n) {
+    for (int k = (n / C8NUM) % block_step; k < deep; k += block_step) {
+      weight[n * deep + k] = static_cast<float>(static_cast<int>((n * deep + k) * 11 % 23) - 11) / 50;
+    }
+  }
+  return weight;
+}
+
+// the shortest of the runs, which is less disturbed by the other processes than the average.
+uint64_t MeasureRunTime(kernel::LiteKernel *kernel) {
+  constexpr int kWarmUpNum = 3;
+  constexpr int kLoopNum = 20;
+  for (int i = 0; i < kWarmUpNum; ++i) {
+    if (kernel->Run() != RET_OK) {
+      return UINT64_MAX;
+    }
+  }
+  uint64_t min_cost = UINT64_MAX;
+  for (int i = 0; i < kLoopNum; ++i) {
+    auto start = lite::GetTimeUs();
+    if (kernel->Run() != RET_OK) {
+      return UINT64_MAX;
+    }
+    min_cost = std::min(min_cost, lite::GetTimeUs() - start);
+  }
+  return min_cost;
+}
+}  // namespace
+
+TEST_F(TestFcFp32, FcSparseWeightTest) {
+  constexpr int kRow = 11;
+  constexpr int kDeep = 40;
+  constexpr int kCol = 20;
+  std::vector<float> in(kRow * kDeep);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<float>(static_cast<int>(i * 7 % 19) - 9) / 10;
+  }
+  auto weight = CreateBlockSparseWeight(kCol, kDeep, C3NUM);
+  std::vector<float> bias(kCol);
+  for (int n = 0; n < kCol; ++n) {
+    bias[n] = static_cast<float>(n % 5 - 2) / 10;
+  }
+  std::vector<float> except_result(kRow * kCol);
+  for (int r = 0; r < kRow; ++r) {
+    for (int n = 0; n < kCol; ++n) {
+      float value = bias[n];
+      for (int k = 0; k < kDeep; ++k) {
+        value += in[r * kDeep + k] * weight[n * kDeep + k];
+      }
+      except_result[r * kCol + n] = value > 0.0f ? value : 0.0f;
+    }
+  }
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 2;
+  ASSERT_EQ(ctx->Init(), RET_OK);
+
+  // The sparse kernel is selected by the weight encoded as block-sparse only.
+  for (bool block_sparse : {false, true}) {
+    std::vector<lite::Tensor *> inputs;
+    inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kDeep}, in));
+    inputs.push_back(
+      CreateTensor<float>(kNumberTypeFloat32, {kCol, kDeep}, weight, mindspore::NHWC, lite::Category::CONST_TENSOR));
+    inputs.push_back(
+      CreateTensor<float>(kNumberTypeFloat32, {kCol}, bias, mindspore::NHWC, lite::Category::CONST_TENSOR));
+    std::vector<lite::Tensor *> outputs;
+    outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kCol}, {}));
+    auto *kernel = CreateFcKernel(inputs, outputs, ctx.get(), block_sparse);
+    ASSERT_NE(kernel, nullptr);
+    ASSERT_EQ(static_cast<kernel::FullconnectionCPUKernel *>(kernel)->IsSparseWeight(), block_sparse);
+    ASSERT_EQ(kernel->Run(), RET_OK);
+    ASSERT_EQ(0, CompareOutputData(static_cast<float *>(outputs[0]->data()), except_result.data(),
+                                   outputs[0]->ElementsNum(), 0.0001));
+    delete kernel;
+    DestroyTensors(inputs);
+    DestroyTensors(outputs);
+  }
+}
+
+// The converter encodes the weights of at most half of the blocks non-zero as block-sparse, at which the sparse kernel
+// has to run faster than the dense one. The dense one is about as fast at any density.
+TEST_F(TestFcFp32, FcSparseWeightSpeedVsDensity) {
+  constexpr int kRow = 64;
+  constexpr int kDeep = 512;
+  constexpr int kCol = 512;
+  constexpr float kMaxBlockDensity = 0.5f;
+  std::vector<float> in(kRow * kDeep);
+  for (size_t i = 0; i < in.size(); ++i) {
+    in[i] = static_cast<float>(static_cast<int>(i * 7 % 19) - 9) / 10;
+  }
+  std::vector<float> bias(kCol, 0.0f);
+  auto ctx = std::make_shared<lite::InnerContext>();
+  ctx->thread_num_ = 1;
+  ASSERT_EQ(ctx->Init(), RET_OK);
+
+  // the density of the non-zero blocks is 1 / block_step
+  for (int block_step : {C1NUM, C2NUM, C4NUM, C10NUM}) {
+    auto weight = CreateBlockSparseWeight(kCol, kDeep, block_step);
+    uint64_t run_cost[2] = {0, 0};
+    for (bool block_sparse : {false, true}) {
+      std::vector<lite::Tensor *> inputs;
+      inputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kDeep}, in));
+      inputs.push_back(
+        CreateTensor<float>(kNumberTypeFloat32, {kCol, kDeep}, weight, mindspore::NHWC, lite::Category::CONST_TENSOR));
+      inputs.push_back(
+        CreateTensor<float>(kNumberTypeFloat32, {kCol}, bias, mindspore::NHWC, lite::Category::CONST_TENSOR));
+      std::vector<lite::Tensor *> outputs;
+      outputs.push_back(CreateTensor<float>(kNumberTypeFloat32, {kRow, kCol}, {}));
+      auto *kernel = CreateFcKernel(inputs, outputs, ctx.get(), block_sparse);
+      ASSERT_NE(kernel, nullptr);
+      ASSERT_EQ(static_cast<kernel::FullconnectionCPUKernel *>(kernel)->IsSparseWeight(), block_sparse);
+      run_cost[block_sparse] = MeasureRunTime(kernel);
+      ASSERT_NE(run_cost[block_sparse], UINT64_MAX);
+      delete kernel;
+      DestroyTensors(inputs);
+      DestroyTensors(outputs);
+    }
+    float block_density = 1.0f / block_step;
+    MS_LOG(INFO) << "Fullconnection fp32 weight of block density " << block_density << ", dense : " << run_cost[0]
+                 << " us, sparse : " << run_cost[1] << " us";
+    if (block_density <= kMaxBlockDensity) {
+      EXPECT_LT(run_cost[1], run_cost[0]);
+    }
+  }
+}
 }  // namespace mindspore
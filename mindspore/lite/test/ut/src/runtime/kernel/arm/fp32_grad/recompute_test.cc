@@ -0,0 +1,125 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/context.h"
+#include "include/errorcode.h"
+#include "include/train/train_cfg.h"
+#include "src/common/common.h"
+#include "src/litert/inner_context.h"
+#include "src/train/static_allocator.h"
+#define private public
+#include "src/train/train_session.h"
+#undef private
+
+using mindspore::lite::RET_OK;
+namespace mindspore {
+namespace {
+constexpr float kRecomputeErrBound = 1e-5;
+constexpr int kLabelNum = 10;
+constexpr int kInputValueNum = 7;
+using ConfigInfos = std::map<std::string, std::map<std::string, std::string>>;
+}  // namespace
+
+class RecomputeTest : public mindspore::CommonTest {
+ public:
+  RecomputeTest() {}
+
+  // a lenet train session accumulating the gradients, so that they can be read after a step
+  std::unique_ptr<lite::TrainSession> CreateLenetSession(const ConfigInfos *config_info) {
+    lite::Context context;
+    context.device_list_[0].device_info_.cpu_device_info_.cpu_bind_mode_ = lite::NO_BIND;
+    context.thread_num_ = 1;
+    context.allocator = std::make_shared<StaticAllocator>();
+    auto session = std::make_unique<lite::TrainSession>();
+    session->SetConfigInfo(config_info);
+    lite::TrainCfg cfg;
+    cfg.accumulate_gradients_ = true;
+    auto *inner_context = new (std::nothrow) lite::InnerContext(&context);
+    if (inner_context == nullptr || session->TrainInit(inner_context, &cfg) != RET_OK) {
+      return nullptr;
+    }
+    auto model = std::shared_ptr<lite::Model>(lite::Model::Import("./nets/lenet_train.ms"));
+    if (model == nullptr || session->CompileTrainGraph(model) != RET_OK || session->Train() != RET_OK) {
+      return nullptr;
+    }
+    return session;
+  }
+
+  void RunTrainStep(lite::TrainSession *session) {
+    for (auto input : session->GetInputs()) {
+      auto data = input->MutableData();
+      ASSERT_NE(data, nullptr);
+      for (int i = 0; i < input->ElementsNum(); ++i) {
+        if (input->data_type() == kNumberTypeInt32) {
+          reinterpret_cast<int *>(data)[i] = i % kLabelNum;
+        } else {
+          reinterpret_cast<float *>(data)[i] = static_cast<float>(i % kInputValueNum) / kInputValueNum - 0.5f;
+        }
+      }
+    }
+    ASSERT_EQ(session->RunGraph(), RET_OK);
+  }
+};
+
+TEST_F(RecomputeTest, LenetGradients) {
+  auto plain = CreateLenetSession(nullptr);
+  ASSERT_NE(plain, nullptr);
+  ConfigInfos config_info = {{lite::kRecompute, {{lite::kRecomputeEnable, "true"}}}};
+  auto recompute = CreateLenetSession(&config_info);
+  ASSERT_NE(recompute, nullptr);
+  ASSERT_FALSE(recompute->recompute_steps_.empty());
+  // the buffer of the activations is the peak memory of the train kernels
+  EXPECT_LT(recompute->tensors_data_size_, plain->tensors_data_size_);
+
+  RunTrainStep(plain.get());
+  RunTrainStep(recompute.get());
+  auto plain_outputs = plain->GetOutputs();
+  auto recompute_outputs = recompute->GetOutputs();
+  ASSERT_EQ(recompute_outputs.size(), plain_outputs.size());
+  for (auto &output : plain_outputs) {
+    auto iter = recompute_outputs.find(output.first);
+    ASSERT_NE(iter, recompute_outputs.end());
+    ASSERT_EQ(iter->second->ElementsNum(), output.second->ElementsNum());
+    ASSERT_EQ(0, CompareOutputData(reinterpret_cast<float *>(iter->second->data()),
+                                   reinterpret_cast<float *>(output.second->data()), output.second->ElementsNum(),
+                                   kRecomputeErrBound));
+  }
+  auto plain_gradients = plain->GetGradients();
+  auto recompute_gradients = recompute->GetGradients();
+  ASSERT_FALSE(plain_gradients.empty());
+  ASSERT_EQ(recompute_gradients.size(), plain_gradients.size());
+  for (size_t i = 0; i < plain_gradients.size(); ++i) {
+    ASSERT_EQ(recompute_gradients[i]->ElementsNum(), plain_gradients[i]->ElementsNum());
+    EXPECT_EQ(0, CompareOutputData(reinterpret_cast<float *>(recompute_gradients[i]->data()),
+                                   reinterpret_cast<float *>(plain_gradients[i]->data()),
+                                   plain_gradients[i]->ElementsNum(), kRecomputeErrBound));
+  }
+  DestroyTensors(plain_gradients);
+  DestroyTensors(recompute_gradients);
+}
+
+TEST_F(RecomputeTest, Disabled) {
+  ConfigInfos config_info = {{lite::kRecompute, {{lite::kRecomputeEnable, "false"}}}};
+  auto session = CreateLenetSession(&config_info);
+  ASSERT_NE(session, nullptr);
+  EXPECT_FALSE(session->recompute_);
+  EXPECT_TRUE(session->recompute_steps_.empty());
+}
+}  // namespace mindspore
@@ -0,0 +1,190 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifdef SHARING_MODEL_WEIGHT
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#if defined(__linux__) && !defined(__ANDROID__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include "common/common_test.h"
+#define private public
+#include "src/litert/pack_weight.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr size_t kModelSize = 64 * 1024;
+constexpr size_t kTensorOffset = 1024;
+constexpr size_t kPackedSize = 256;
+constexpr int kPatternPrime = 131;
+}  // namespace
+
+class PackWeightTest : public mindspore::CommonTest {
+ public:
+  PackWeightTest() = default;
+
+  std::vector<char> CreateModelBuf() {
+    std::vector<char> model_buf(kModelSize);
+    for (size_t i = 0; i < kModelSize; ++i) {
+      model_buf[i] = static_cast<char>(i % kPatternPrime);
+    }
+    return model_buf;
+  }
+};
+
+TEST_F(PackWeightTest, ShareByContent) {
+  auto model_buf = CreateModelBuf();
+  auto same_buf = CreateModelBuf();
+  auto other_buf = CreateModelBuf();
+  other_buf[kModelSize - 1] ^= 1;
+  lite::PackWeight pack_weight;
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(model_buf.data(), kModelSize, -1, true), lite::RET_OK);
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(same_buf.data(), kModelSize, -1, true), lite::RET_OK);
+  auto numa_buf = pack_weight.GetNumaModelBuf(model_buf.data(), -1);
+  ASSERT_NE(numa_buf, nullptr);
+  ASSERT_EQ(pack_weight.GetNumaModelBuf(same_buf.data(), -1), numa_buf);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 1);
+
+  // the same size but not the same content
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(other_buf.data(), kModelSize, -1, true), lite::RET_OK);
+  auto other_numa_buf = pack_weight.GetNumaModelBuf(other_buf.data(), -1);
+  ASSERT_NE(other_numa_buf, numa_buf);
+  ASSERT_EQ(memcmp(other_numa_buf, other_buf.data(), kModelSize), 0);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 2);
+
+  // the buf of a model of the same content finds the data packed for the copy
+  auto model_copy = CreateModelBuf();
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(model_copy.data(), kModelSize), lite::RET_OK);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 2);
+  ASSERT_EQ(pack_weight.StoreOriginTensorData(numa_buf, numa_buf + kTensorOffset), lite::RET_OK);
+  bool is_packed = true;
+  auto packed_data = pack_weight.GetPackData(numa_buf + kTensorOffset, kPackedSize, &is_packed);
+  ASSERT_NE(packed_data, nullptr);
+  ASSERT_FALSE(is_packed);
+  ASSERT_EQ(pack_weight.GetPackData(model_copy.data() + kTensorOffset, kPackedSize, &is_packed), packed_data);
+  ASSERT_TRUE(is_packed);
+}
+
+TEST_F(PackWeightTest, ShareByCallerBuf) {
+  auto model_buf = CreateModelBuf();
+  auto same_buf = CreateModelBuf();
+  auto other_buf = CreateModelBuf();
+  other_buf[kModelSize - 1] ^= 1;
+  lite::PackWeight pack_weight;
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(model_buf.data(), kModelSize), lite::RET_OK);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 1);
+  auto weight = pack_weight.model_weights_[0];
+  // the weight keeps its own copy to verify the content with
+  ASSERT_NE(weight->model_buf, nullptr);
+  ASSERT_NE(weight->model_buf, model_buf.data());
+  ASSERT_EQ(pack_weight.StoreOriginTensorData(model_buf.data(), model_buf.data() + kTensorOffset), lite::RET_OK);
+  bool is_packed = true;
+  auto packed_data = pack_weight.GetPackData(model_buf.data() + kTensorOffset, kPackedSize, &is_packed);
+  ASSERT_NE(packed_data, nullptr);
+  ASSERT_FALSE(is_packed);
+
+  // the buf of the first model is rewritten after it is released, the same content is still verified by the copy
+  std::fill(model_buf.begin(), model_buf.end(), 0);
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(same_buf.data(), kModelSize), lite::RET_OK);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 1);
+  ASSERT_EQ(pack_weight.buf_model_weight_[same_buf.data()].weight, weight);
+  ASSERT_EQ(pack_weight.GetPackData(same_buf.data() + kTensorOffset, kPackedSize, &is_packed), packed_data);
+  ASSERT_TRUE(is_packed);
+
+  // the same size but not the same content
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(other_buf.data(), kModelSize), lite::RET_OK);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 2);
+  ASSERT_NE(pack_weight.buf_model_weight_[other_buf.data()].weight, weight);
+
+  // a copy for the numa node reuses the one kept by the weight
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(same_buf.data(), kModelSize, -1, true), lite::RET_OK);
+  ASSERT_EQ(pack_weight.GetNumaModelBuf(same_buf.data(), -1), weight->model_buf);
+  ASSERT_EQ(pack_weight.buf_model_weight_[weight->model_buf].weight, weight);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 2);
+}
+
+TEST_F(PackWeightTest, SplitByNuma) {
+  auto model_buf = CreateModelBuf();
+  lite::PackWeight pack_weight;
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(model_buf.data(), kModelSize, 0, true), lite::RET_OK);
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(model_buf.data(), kModelSize, 1, true), lite::RET_OK);
+  auto numa0_buf = pack_weight.GetNumaModelBuf(model_buf.data(), 0);
+  auto numa1_buf = pack_weight.GetNumaModelBuf(model_buf.data(), 1);
+  ASSERT_NE(numa0_buf, nullptr);
+  ASSERT_NE(numa1_buf, nullptr);
+  ASSERT_NE(numa0_buf, numa1_buf);
+  ASSERT_EQ(memcmp(numa0_buf, model_buf.data(), kModelSize), 0);
+  ASSERT_EQ(memcmp(numa1_buf, model_buf.data(), kModelSize), 0);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 2);
+  ASSERT_EQ(pack_weight.model_weights_[0]->numa_id, 0);
+  ASSERT_EQ(pack_weight.model_weights_[1]->numa_id, 1);
+
+  // the packed data is not shared across the numa nodes
+  ASSERT_EQ(pack_weight.StoreOriginTensorData(numa0_buf, numa0_buf + kTensorOffset), lite::RET_OK);
+  ASSERT_EQ(pack_weight.StoreOriginTensorData(numa1_buf, numa1_buf + kTensorOffset), lite::RET_OK);
+  bool is_packed = true;
+  auto numa0_packed = pack_weight.GetPackData(numa0_buf + kTensorOffset, kPackedSize, &is_packed);
+  auto numa1_packed = pack_weight.GetPackData(numa1_buf + kTensorOffset, kPackedSize, &is_packed);
+  ASSERT_NE(numa0_packed, nullptr);
+  ASSERT_NE(numa1_packed, nullptr);
+  ASSERT_NE(numa0_packed, numa1_packed);
+  ASSERT_FALSE(is_packed);
+
+  ASSERT_EQ(pack_weight.InitWeightManagerByBuf(model_buf.data(), kModelSize, 0, true), lite::RET_OK);
+  ASSERT_EQ(pack_weight.GetNumaModelBuf(model_buf.data(), 0), numa0_buf);
+  ASSERT_EQ(pack_weight.model_weights_.size(), 2);
+}
+
+#if defined(__linux__) && !defined(__ANDROID__)
+TEST_F(PackWeightTest, RecoverStaleSharedBuf) {
+  auto model_buf = CreateModelBuf();
+  auto content_hash = std::hash<std::string_view>()(std::string_view(model_buf.data(), kModelSize));
+  auto path = lite::PackWeight::SharedModelBufPath(content_hash, kModelSize, -1);
+  // the segment left by a process that died before filling it, no lock is held
+  (void)unlink(path.c_str());
+  int fd = open(path.c_str(), O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(ftruncate(fd, static_cast<off_t>(kModelSize)), 0);
+  close(fd);
+
+  auto first = std::make_unique<lite::PackWeight>();
+  ASSERT_EQ(first->InitWeightManagerByBuf(model_buf.data(), kModelSize, -1, true, true), lite::RET_OK);
+  ASSERT_EQ(first->model_weights_.size(), 1);
+  auto &first_shared = first->model_weights_[0]->shared_buf;
+  ASSERT_NE(first_shared.addr, nullptr);
+  ASSERT_EQ(first_shared.path, path);
+  ASSERT_EQ(memcmp(first->GetNumaModelBuf(model_buf.data(), -1), model_buf.data(), kModelSize), 0);
+
+  // the lock is held by the open file, so another manager maps the segment like another process
+  auto second = std::make_unique<lite::PackWeight>();
+  ASSERT_EQ(second->InitWeightManagerByBuf(model_buf.data(), kModelSize, -1, true, true), lite::RET_OK);
+  ASSERT_NE(second->model_weights_[0]->shared_buf.addr, nullptr);
+  ASSERT_EQ(memcmp(second->GetNumaModelBuf(model_buf.data(), -1), model_buf.data(), kModelSize), 0);
+
+  // the last one releasing the segment removes its name
+  first.reset();
+  ASSERT_EQ(access(path.c_str(), F_OK), 0);
+  second.reset();
+  ASSERT_NE(access(path.c_str(), F_OK), 0);
+}
+#endif
+}  // namespace mindspore
+#endif
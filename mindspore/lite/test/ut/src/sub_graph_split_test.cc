@@ -0,0 +1,144 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "schema/inner/model_generated.h"
+#include "src/tensor.h"
+#define private public
+#include "src/litert/sub_graph_split.h"
+#undef private
+
+namespace mindspore {
+namespace {
+constexpr int kThreadNum = 8;
+constexpr int kLargeBranchChannel = 4;
+constexpr int kSmallBranchChannel = 1;
+constexpr int kBranchHW = 1024;
+constexpr int kConcatAxis = 3;
+}  // namespace
+
+class SubGraphSplitTest : public mindspore::CommonTest {
+ public:
+  SubGraphSplitTest() = default;
+
+  std::unique_ptr<schema::TensorT> CreateTensorT(const std::vector<int> &dims) {
+    auto tensor = std::make_unique<schema::TensorT>();
+    tensor->nodeType = lite::NodeType_Parameter;
+    tensor->format = schema::Format_NHWC;
+    tensor->dataType = kNumberTypeFloat32;
+    tensor->dims = dims;
+    tensor->offset = -1;
+    return tensor;
+  }
+
+  std::unique_ptr<schema::CNodeT> CreateAbs(uint32_t input, uint32_t output, const std::string &name) {
+    auto node = std::make_unique<schema::CNodeT>();
+    node->inputIndex = {input};
+    node->outputIndex = {output};
+    node->primitive = std::make_unique<schema::PrimitiveT>();
+    node->primitive->value.type = schema::PrimitiveType_Abs;
+    node->primitive->value.value = new schema::AbsT;
+    node->name = name;
+    return node;
+  }
+
+  // two branches of an abs on 4M and 1M elements, concatenated by the third node
+  lite::Model *ImportTwoBranchModel() {
+    auto meta_graph = std::make_shared<schema::MetaGraphT>();
+    meta_graph->name = "graph";
+    meta_graph->version = Version();
+    meta_graph->nodes.emplace_back(CreateAbs(0, 2, "large"));
+    meta_graph->nodes.emplace_back(CreateAbs(1, 3, "small"));
+    auto concat = std::make_unique<schema::CNodeT>();
+    concat->inputIndex = {2, 3};
+    concat->outputIndex = {4};
+    concat->primitive = std::make_unique<schema::PrimitiveT>();
+    concat->primitive->value.type = schema::PrimitiveType_Concat;
+    auto concat_primitive = new schema::ConcatT;
+    concat_primitive->axis = kConcatAxis;
+    concat->primitive->value.value = concat_primitive;
+    concat->name = "concat";
+    meta_graph->nodes.emplace_back(std::move(concat));
+    for (auto channel : {kLargeBranchChannel, kSmallBranchChannel, kLargeBranchChannel, kSmallBranchChannel,
+                         kLargeBranchChannel + kSmallBranchChannel}) {
+      meta_graph->allTensors.emplace_back(CreateTensorT({1, kBranchHW, kBranchHW, channel}));
+    }
+    meta_graph->inputIndex = {0, 1};
+    meta_graph->outputIndex = {4};
+    auto sub_graph = std::make_unique<schema::SubGraphT>();
+    sub_graph->name = "graph";
+    sub_graph->inputIndices = {0, 1};
+    sub_graph->outputIndices = {4};
+    sub_graph->nodeIndices = {0, 1, 2};
+    sub_graph->tensorIndices = {0, 1, 2, 3, 4};
+    meta_graph->subGraph.emplace_back(std::move(sub_graph));
+
+    flatbuffers::FlatBufferBuilder builder(1024);
+    auto offset = schema::MetaGraph::Pack(builder, meta_graph.get());
+    builder.Finish(offset);
+    schema::FinishMetaGraphBuffer(builder, offset);
+    return lite::Model::Import(reinterpret_cast<char *>(builder.GetBufferPointer()), builder.GetSize());
+  }
+};
+
+TEST_F(SubGraphSplitTest, TestAssignOperatorThreadsTwoBranch) {
+  auto model = std::unique_ptr<lite::Model>(ImportTwoBranchModel());
+  ASSERT_NE(model, nullptr);
+  std::vector<lite::Tensor *> src_tensors;
+  for (auto tensor : model->graph_.all_tensors_) {
+    std::vector<int> shape(tensor->dims()->begin(), tensor->dims()->end());
+    src_tensors.push_back(new lite::Tensor(kNumberTypeFloat32, shape));
+  }
+  lite::InnerContext context;
+  context.thread_num_ = kThreadNum;
+  ASSERT_EQ(context.Init(), lite::RET_OK);
+  std::map<int, OpParameter *> op_parameters;
+  std::vector<size_t> output_nodes = {2};
+  lite::SearchSubGraph search_sub_graph(&context, model.get(), &src_tensors, &op_parameters, &output_nodes);
+
+  std::vector<lite::SearchSubGraph::Subgraph> sub_graphs(3);
+  for (uint32_t i = 0; i < sub_graphs.size(); i++) {
+    sub_graphs[i].nodes_ = {i};
+    sub_graphs[i].device_ = lite::DT_CPU;
+  }
+  search_sub_graph.AssignOperatorThreads(&sub_graphs);
+
+  /* the branches run concurrently and share the threads in proportion to their costs */
+  auto &large = sub_graphs[0];
+  auto &small = sub_graphs[1];
+  ASSERT_EQ(large.cost_.mul_cost_, static_cast<size_t>(kBranchHW * kBranchHW * kLargeBranchChannel));
+  ASSERT_EQ(small.cost_.mul_cost_, static_cast<size_t>(kBranchHW * kBranchHW * kSmallBranchChannel));
+  ASSERT_GE(small.thread_, static_cast<size_t>(1));
+  ASSERT_GT(large.thread_, small.thread_);
+  ASSERT_LE(large.thread_ + small.thread_, static_cast<size_t>(kThreadNum));
+  auto total_cost = static_cast<double>(large.cost_.mul_cost_ + small.cost_.mul_cost_);
+  for (auto sub : {&large, &small}) {
+    auto share = kThreadNum * static_cast<double>(sub->cost_.mul_cost_) / total_cost;
+    EXPECT_LE(std::fabs(static_cast<double>(sub->thread_) - share), 1.0);
+  }
+  /* the concat waits for both branches and runs alone with all the threads */
+  ASSERT_EQ(sub_graphs[2].thread_, static_cast<size_t>(kThreadNum));
+
+  for (auto tensor : src_tensors) {
+    delete tensor;
+  }
+}
+}  // namespace mindspore
@@ -0,0 +1,198 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "include/model.h"
+#include "schema/inner/model_generated.h"
+#include "src/tensor.h"
+#define private public
+#include "tools/converter/micro/coder/allocator/memory_manager.h"
+#undef private
+#include "tools/converter/micro/coder/opcoders/op_coder.h"
+
+namespace mindspore {
+namespace {
+constexpr int kGraphNum = 16;
+constexpr int kNodeNum = 40;
+constexpr int kMinElements = 16;
+constexpr int kMaxElements = 256;
+}  // namespace
+
+class FakeCoder : public lite::micro::OperatorCoder {
+ public:
+  FakeCoder(const std::vector<lite::Tensor *> &in_tensors, const std::vector<lite::Tensor *> &out_tensors,
+            const lite::LiteGraph::Node *node, size_t node_index)
+      : OperatorCoder(in_tensors, out_tensors, node, node_index, lite::micro::kX86) {}
+  ~FakeCoder() override = default;
+  int Prepare(lite::micro::CoderContext *const context) override { return lite::RET_OK; }
+  int DoCode(lite::micro::CoderContext *const context) override { return lite::RET_OK; }
+};
+
+class MemoryManagerTest : public mindspore::CommonTest {
+ public:
+  MemoryManagerTest() = default;
+
+  lite::Tensor *NewTensor(const std::vector<int> &shape) {
+    tensors_.emplace_back(std::make_unique<lite::Tensor>(kNumberTypeFloat32, shape));
+    return tensors_.back().get();
+  }
+
+  lite::Tensor *AddNode(int type, const std::vector<lite::Tensor *> &inputs, const std::vector<int> &output_shape) {
+    auto output = NewTensor(output_shape);
+    auto node = std::make_unique<lite::LiteGraph::Node>();
+    node->name_ = std::string(schema::EnumNamePrimitiveType(static_cast<schema::PrimitiveType>(type))) +
+                  std::to_string(nodes_.size());
+    auto coder = std::make_unique<FakeCoder>(inputs, std::vector<lite::Tensor *>{output}, node.get(), coders_.size());
+    coder->set_type(type);
+    nodes_.push_back(std::move(node));
+    coders_.push_back(std::move(coder));
+    return output;
+  }
+
+  // the same as the ref count initialized by the coder session
+  void InitTensorsRef() {
+    for (auto &tensor : tensors_) {
+      int ref_count = 0;
+      for (auto &coder : coders_) {
+        auto inputs = coder->input_tensors();
+        ref_count += std::find(inputs.begin(), inputs.end(), tensor.get()) != inputs.end() ? 1 : 0;
+      }
+      tensor->set_ref_count(ref_count);
+    }
+  }
+
+  // the tensors alive at the same time do not overlap, unless they share the memory by the plan
+  void CheckNoOverlap(lite::micro::MemoryManager *manager) {
+    auto offsets = manager->variables_offset();
+    for (auto *a : manager->tensors_) {
+      for (auto *b : manager->tensors_) {
+        size_t a_offset = 0;
+        size_t b_offset = 0;
+        if (a == b || manager->FindRoot(a, &a_offset) == manager->FindRoot(b, &b_offset)) {
+          continue;
+        }
+        if (manager->define_index_[a] > manager->last_use_index_[b] ||
+            manager->define_index_[b] > manager->last_use_index_[a]) {
+          continue;
+        }
+        ASSERT_TRUE(offsets[a] + a->Size() <= offsets[b] || offsets[b] + b->Size() <= offsets[a]);
+      }
+    }
+  }
+
+ protected:
+  std::vector<std::unique_ptr<lite::Tensor>> tensors_;
+  std::vector<std::unique_ptr<lite::LiteGraph::Node>> nodes_;
+  std::vector<std::unique_ptr<lite::micro::OperatorCoder>> coders_;
+};
+
+TEST_F(MemoryManagerTest, AliasConcatInputs) {
+  auto input = NewTensor({1, 3, 4});
+  auto a = AddNode(schema::PrimitiveType_Abs, {input}, {1, 3, 4});
+  auto b = AddNode(schema::PrimitiveType_MatMulFusion, {input}, {1, 5, 4});
+  auto output = AddNode(schema::PrimitiveType_Concat, {a, b}, {1, 8, 4});
+  InitTensorsRef();
+  lite::micro::MemoryManager manager;
+  ASSERT_EQ(manager.AssignMemory(coders_, {output}), lite::RET_OK);
+  // the inputs are the slices of the output, the concat is not coded
+  auto offsets = manager.variables_offset();
+  ASSERT_EQ(offsets[a], offsets[output]);
+  ASSERT_EQ(offsets[b], offsets[output] + a->Size());
+  ASSERT_EQ(manager.in_place_outputs().count(output), 1);
+  ASSERT_LT(manager.GetAllocatedSize(), manager.GetOrderedSize());
+  CheckNoOverlap(&manager);
+}
+
+TEST_F(MemoryManagerTest, RejectConcatAlongInnerAxis) {
+  // the dims before the axis are not 1, the inputs are interleaved in the output
+  auto input = NewTensor({1, 2, 4, 3});
+  auto a = AddNode(schema::PrimitiveType_Abs, {input}, {1, 2, 4, 3});
+  auto b = AddNode(schema::PrimitiveType_Neg, {input}, {1, 2, 4, 3});
+  auto output = AddNode(schema::PrimitiveType_Concat, {a, b}, {1, 2, 4, 6});
+  InitTensorsRef();
+  lite::micro::MemoryManager manager;
+  ASSERT_EQ(manager.AssignMemory(coders_, {output}), lite::RET_OK);
+  ASSERT_EQ(manager.alias_.count(a), 0);
+  ASSERT_EQ(manager.alias_.count(b), 0);
+  ASSERT_TRUE(manager.in_place_outputs().empty());
+  auto offsets = manager.variables_offset();
+  ASSERT_NE(offsets[a], offsets[output]);
+  ASSERT_NE(offsets[b], offsets[output]);
+  ASSERT_LE(manager.GetAllocatedSize(), manager.GetOrderedSize());
+  CheckNoOverlap(&manager);
+}
+
+TEST_F(MemoryManagerTest, InPlaceChain) {
+  auto input = NewTensor({2, 8});
+  auto abs = AddNode(schema::PrimitiveType_Abs, {input}, {2, 8});
+  auto reshape = AddNode(schema::PrimitiveType_Reshape, {abs}, {16});
+  auto neg = AddNode(schema::PrimitiveType_Neg, {reshape}, {16});
+  InitTensorsRef();
+  lite::micro::MemoryManager manager;
+  ASSERT_EQ(manager.AssignMemory(coders_, {neg}), lite::RET_OK);
+  auto offsets = manager.variables_offset();
+  ASSERT_EQ(offsets[abs], offsets[neg]);
+  ASSERT_EQ(offsets[reshape], offsets[neg]);
+  // only the reshape is skipped, the elementwise op still computes in place
+  ASSERT_EQ(manager.in_place_outputs().count(reshape), 1);
+  ASSERT_EQ(manager.in_place_outputs().count(neg), 0);
+  ASSERT_EQ(manager.GetAllocatedSize(), abs->Size());
+  ASSERT_LT(manager.GetAllocatedSize(), manager.GetOrderedSize());
+}
+
+TEST_F(MemoryManagerTest, PlannedNotLargerThanOrdered) {
+  const std::vector<int> types = {schema::PrimitiveType_Abs, schema::PrimitiveType_Reshape,
+                                  schema::PrimitiveType_Concat, schema::PrimitiveType_MatMulFusion};
+  for (int seed = 0; seed < kGraphNum; ++seed) {
+    tensors_.clear();
+    coders_.clear();
+    nodes_.clear();
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> elements(kMinElements, kMaxElements);
+    std::vector<lite::Tensor *> pool = {NewTensor({elements(rng)})};
+    for (int i = 0; i < kNodeNum; ++i) {
+      auto type = types[rng() % types.size()];
+      auto input = pool[rng() % pool.size()];
+      if (type == schema::PrimitiveType_Concat) {
+        auto other = pool[rng() % pool.size()];
+        if (other == input) {
+          continue;
+        }
+        pool.push_back(AddNode(type, {input, other}, {input->ElementsNum() + other->ElementsNum()}));
+      } else if (type == schema::PrimitiveType_MatMulFusion) {
+        pool.push_back(AddNode(type, {input}, {elements(rng)}));
+      } else {
+        pool.push_back(AddNode(type, {input}, {input->ElementsNum()}));
+      }
+    }
+    InitTensorsRef();
+    std::vector<lite::Tensor *> outputs;
+    for (auto *tensor : pool) {
+      if (tensor->ref_count() == 0) {
+        outputs.push_back(tensor);
+      }
+    }
+    lite::micro::MemoryManager manager;
+    ASSERT_EQ(manager.AssignMemory(coders_, outputs), lite::RET_OK);
+    ASSERT_LE(manager.GetAllocatedSize(), manager.GetOrderedSize());
+    CheckNoOverlap(&manager);
+  }
+}
+}  // namespace mindspore
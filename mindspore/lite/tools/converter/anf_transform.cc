@@ -79,6 +79,7 @@
 #include "tools/optimizer/graph/specify_graph_input_format.h"
 #include "tools/optimizer/graph/dump_graph.h"
 #include "tools/optimizer/graph/eliminate_redundant_cast_pass.h"
+#include "tools/optimizer/graph/sparse_weight_pass.h"
 #include "tools/converter/quantizer/quantization_optimizer.h"
 #include "tools/optimizer/parallel/split_strategy.h"
 #include "tools/optimizer/parallel/spliter.h"
@@ -573,6 +574,16 @@ FuncGraphPtr AnfTransform::TransformFuncGraph(const FuncGraphPtr &old_graph,
     MS_LOG(ERROR) << "Do Quantize failed.";
     return nullptr;
   }
+  // the weights left float32 by the quantization and sparse enough are encoded as block-sparse for the lite runtime,
+  // which the code generated by micro doesn't decode.
+  if (param->export_mindir != kMindIR && !param->train_model && !param->microParam.enable_micro) {
+    auto sparse_weight_pass = std::make_shared<opt::SparseWeightPass>();
+    MS_CHECK_TRUE_RET(sparse_weight_pass != nullptr, nullptr);
+    if (!sparse_weight_pass->Run(old_graph)) {
+      MS_LOG(ERROR) << "Run sparse weight pass failed.";
+      return nullptr;
+    }
+  }
   status = DoFormatForMindIR(old_graph, param);
   if (status != RET_OK) {
     return nullptr;
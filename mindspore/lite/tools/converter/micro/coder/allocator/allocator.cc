@@ -131,10 +131,11 @@ void MemoryAllocator::RecordOriginWeightsAddr(const std::vector<std::unique_ptr<
   }
 }
 
-int MemoryAllocator::AssignTensors(const std::vector<std::unique_ptr<OperatorCoder>> &nodes) {
+int MemoryAllocator::AssignTensors(const std::vector<Tensor *> &outputs,
+                                   const std::vector<std::unique_ptr<OperatorCoder>> &nodes) {
   // intend to support multi memory assign algorithm
   auto manager = std::make_unique<MemoryManager>();
-  int ret = manager->AssignMemory(nodes);
+  int ret = manager->AssignMemory(nodes, outputs);
   if (ret != RET_OK) {
     MS_LOG(ERROR) << "assign memory failed";
     return RET_ERROR;
@@ -143,13 +144,15 @@ int MemoryAllocator::AssignTensors(const std::vector<std::unique_ptr<OperatorCod
   RecordTensorsAddr(offsets);
 
   tensors_size_ = manager->GetAllocatedSize();
+  ordered_tensors_size_ = manager->GetOrderedSize();
+  in_place_outputs_ = manager->in_place_outputs();
   return RET_OK;
 }
 
-int MemoryAllocator::Assign(const std::vector<Tensor *> &inputs,
+int MemoryAllocator::Assign(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
                             const std::vector<std::unique_ptr<OperatorCoder>> &nodes) {
   AssignGraphInputs(inputs);
   RecordOriginWeightsAddr(nodes);
-  return AssignTensors(nodes);
+  return AssignTensors(outputs, nodes);
 }
 }  // namespace mindspore::lite::micro
@@ -17,6 +17,7 @@
 #ifndef MINDSPORE_LITE_TOOLS_CONVERTER_MICRO_CODER_ALLOCATOR_ALLOCATOR_H_
 #define MINDSPORE_LITE_TOOLS_CONVERTER_MICRO_CODER_ALLOCATOR_ALLOCATOR_H_
 #include <map>
+#include <set>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -56,7 +57,8 @@ class MemoryAllocator {
   /*
    * assign model's input, original weights and all tensors memory addr
    */
-  int Assign(const std::vector<Tensor *> &inputs, const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
+  int Assign(const std::vector<Tensor *> &inputs, const std::vector<Tensor *> &outputs,
+             const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
 
   // allocator holds the space malloced by opcoders, will free before session coder destroy
   void Free();
@@ -137,11 +139,16 @@ class MemoryAllocator {
    */
   std::map<std::string, Tensor *> saved_weights() const { return saved_weights_addr_; }
   size_t total_buffer_size() const { return tensors_size_ + workspace_size_; }
+  size_t tensors_size() const { return tensors_size_; }
+  // the size of the tensors when they are assigned in the execution order without in-place and aliasing
+  size_t ordered_tensors_size() const { return ordered_tensors_size_; }
+  // whether the output already holds its data before its op runs, in which case the op need not copy it
+  bool IsOutputInPlace(Tensor *tensor) const { return in_place_outputs_.find(tensor) != in_place_outputs_.end(); }
   void enable_is_next() { is_next_ = true; }
   void *MallocWeightTensor(TypeId type_id, size_t size, MallocType type);
 
  private:
-  int AssignTensors(const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
+  int AssignTensors(const std::vector<Tensor *> &outputs, const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
   void AssignGraphInputs(const std::vector<Tensor *> &inputs);
   void AssignWorkspaces(void *addr, size_t size);
   void RecordOriginWeightsAddr(const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
@@ -153,6 +160,7 @@ class MemoryAllocator {
   std::map<void *, std::string> workspaces_addr_;
   size_t workspace_size_{0};
   size_t tensors_size_{0};
+  size_t ordered_tensors_size_{0};
   size_t weight_index_{0};
 
   bool is_next_{false};
@@ -162,6 +170,7 @@ class MemoryAllocator {
   std::map<Tensor *, std::string> origin_weights_addr_;
   std::map<Tensor *, std::string> malloc_weights_addr_;
   std::map<Tensor *, std::string> tensors_addr_;
+  std::set<Tensor *> in_place_outputs_;
 };
 }  // namespace mindspore::lite::micro
 #endif  // MINDSPORE_LITE_TOOLS_CONVERTER_MICRO_CODER_ALLOCATOR_ALLOCATOR_H_
@@ -15,6 +15,7 @@
  */
 
 #include "tools/converter/micro/coder/allocator/memory_manager.h"
+#include <algorithm>
 #include <vector>
 #include "mindspore/ccsrc/plugin/device/cpu/kernel/nnacl/op_base.h"
 #include "tools/converter/micro/coder/opcoders/op_coder.h"
@@ -27,13 +28,63 @@ static size_t AlignMemorySize(size_t size) {
   return ((size + kDefaultMemAlignSize - 1) / kDefaultMemAlignSize) * kDefaultMemAlignSize;
 }
 
-int MemoryManager::AssignMemory(const std::vector<std::unique_ptr<OperatorCoder>> &nodes) {
+namespace {
+// the ops whose output element only depends on the input elements of the same index, or which only copy the data.
+const std::set<int> kInPlaceOps = {
+  schema::PrimitiveType_Activation, schema::PrimitiveType_AddFusion, schema::PrimitiveType_SubFusion,
+  schema::PrimitiveType_MulFusion,  schema::PrimitiveType_DivFusion, schema::PrimitiveType_RealDiv,
+  schema::PrimitiveType_Maximum,    schema::PrimitiveType_Minimum,   schema::PrimitiveType_SquaredDifference,
+  schema::PrimitiveType_Abs,        schema::PrimitiveType_Cos,       schema::PrimitiveType_Log,
+  schema::PrimitiveType_Square,     schema::PrimitiveType_Sqrt,      schema::PrimitiveType_Rsqrt,
+  schema::PrimitiveType_Sin,        schema::PrimitiveType_Floor,     schema::PrimitiveType_Ceil,
+  schema::PrimitiveType_Round,      schema::PrimitiveType_Neg,       schema::PrimitiveType_Erf};
+const std::set<int> kReshapeOps = {schema::PrimitiveType_Reshape, schema::PrimitiveType_Flatten,
+                                   schema::PrimitiveType_ExpandDims, schema::PrimitiveType_Squeeze,
+                                   schema::PrimitiveType_Unsqueeze};
+
+bool IsInPlaceDataType(TypeId data_type) {
+  return data_type == kNumberTypeFloat32 || data_type == kNumberTypeFloat || data_type == kNumberTypeInt32;
+}
+}  // namespace
+
+int MemoryManager::AssignMemory(const std::vector<std::unique_ptr<OperatorCoder>> &nodes,
+                                const std::vector<Tensor *> &outputs) {
+  // the assignment in the execution order is the baseline, which is kept if the planning does not save memory.
+  std::map<Tensor *, int> ref_counts;
+  for (const auto &node : nodes) {
+    for (const auto &input : node->input_tensors()) {
+      ref_counts[input] = input->ref_count();
+    }
+  }
+  AssignInOrder(nodes);
+  ordered_size_ = membuf_list_.empty() ? 0 : membuf_list_.back()->offset_ + membuf_list_.back()->size_;
+  allocated_size_ = ordered_size_;
+  for (const auto &item : ref_counts) {
+    item.first->set_ref_count(item.second);
+  }
+
+  AnalyzeLifetime(nodes, outputs);
+  AliasConcatInputs(nodes);
+  AliasInPlaceOutputs(nodes);
+  std::map<Tensor *, size_t> offsets;
+  size_t planned_size = PlanMemory(&offsets);
+  if (planned_size < ordered_size_) {
+    variables_offset_ = offsets;
+    allocated_size_ = planned_size;
+  } else {
+    in_place_outputs_.clear();
+  }
+  MS_LOG(INFO) << "the tensors take " << allocated_size_ << " bytes, and " << ordered_size_
+               << " bytes when assigned in the execution order.";
+  return RET_OK;
+}
+
+void MemoryManager::AssignInOrder(const std::vector<std::unique_ptr<OperatorCoder>> &nodes) {
   for (const auto &node : nodes) {
     AssignOutputs(node);
     StoreMembufListInfo(node);
     ReleaseInputs(node);
   }
-  return RET_OK;
 }
 
 void MemoryManager::StoreMembufListInfo(const std::unique_ptr<OperatorCoder> &node) {
@@ -46,11 +97,206 @@ void MemoryManager::StoreMembufListInfo(const std::unique_ptr<OperatorCoder> &no
   all_membuf_list_info_.emplace_back(info);
 }
 
-size_t MemoryManager::GetAllocatedSize() const {
-  if (membuf_list_.empty()) {
-    return 0;
+size_t MemoryManager::GetAllocatedSize() const { return allocated_size_; }
+
+void MemoryManager::AnalyzeLifetime(const std::vector<std::unique_ptr<OperatorCoder>> &nodes,
+                                    const std::vector<Tensor *> &outputs) {
+  graph_outputs_.insert(outputs.begin(), outputs.end());
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    auto inputs = nodes[i]->input_tensors();
+    std::set<Tensor *> unique_inputs(inputs.begin(), inputs.end());
+    for (auto *input : unique_inputs) {
+      last_use_index_[input] = i;
+      consumer_num_[input]++;
+    }
+    for (auto *output : nodes[i]->output_tensors()) {
+      if (output != nullptr && define_index_.find(output) == define_index_.end()) {
+        define_index_[output] = i;
+        tensors_.push_back(output);
+      }
+    }
+  }
+  // the graph outputs and the outputs without consumer live till the end.
+  for (auto *tensor : tensors_) {
+    if (graph_outputs_.find(tensor) != graph_outputs_.end() || consumer_num_[tensor] == 0) {
+      last_use_index_[tensor] = nodes.size();
+    }
+  }
+}
+
+Tensor *MemoryManager::FindRoot(Tensor *tensor, size_t *offset) const {
+  *offset = 0;
+  auto iter = alias_.find(tensor);
+  while (iter != alias_.end()) {
+    *offset += iter->second.second;
+    tensor = iter->second.first;
+    iter = alias_.find(tensor);
+  }
+  return tensor;
+}
+
+void MemoryManager::AliasConcatInputs(const std::vector<std::unique_ptr<OperatorCoder>> &nodes) {
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto &node = nodes[i];
+    auto inputs = node->input_tensors();
+    auto outputs = node->output_tensors();
+    if (node->type() != schema::PrimitiveType_Concat || outputs.size() != 1 ||
+        outputs[0]->data_type() != kNumberTypeFloat32) {
+      continue;
+    }
+    auto output = outputs[0];
+    auto out_shape = output->shape();
+    // the inputs are the contiguous slices of the output only if the dims before the concat axis are all 1.
+    size_t axis = out_shape.size();
+    for (auto *input : inputs) {
+      auto in_shape = input->shape();
+      if (in_shape.size() != out_shape.size()) {
+        axis = 0;
+        break;
+      }
+      for (size_t j = 0; j < in_shape.size() && j < axis; ++j) {
+        if (in_shape[j] != out_shape[j]) {
+          axis = j;
+          break;
+        }
+      }
+    }
+    bool contiguous = std::all_of(out_shape.begin(), out_shape.begin() + std::min(axis, out_shape.size()),
+                                  [](int dim) { return dim == 1; });
+    std::set<Tensor *> unique_inputs(inputs.begin(), inputs.end());
+    bool can_alias = contiguous && unique_inputs.size() == inputs.size();
+    size_t total_size = 0;
+    for (auto *input : inputs) {
+      // the input is written by its producer into the output directly, so it is only consumed by the concat.
+      can_alias = can_alias && define_index_.find(input) != define_index_.end() && consumer_num_[input] == 1 &&
+                  graph_outputs_.find(input) == graph_outputs_.end() && alias_.find(input) == alias_.end() &&
+                  input->data_type() == output->data_type();
+      total_size += input->Size();
+    }
+    if (!can_alias || total_size != output->Size()) {
+      continue;
+    }
+    size_t offset = 0;
+    for (auto *input : inputs) {
+      alias_[input] = std::make_pair(output, offset);
+      offset += input->Size();
+    }
+    in_place_outputs_.insert(output);
+  }
+}
+
+void MemoryManager::AliasInPlaceOutputs(const std::vector<std::unique_ptr<OperatorCoder>> &nodes) {
+  for (size_t i = 0; i < nodes.size(); ++i) {
+    const auto &node = nodes[i];
+    auto outputs = node->output_tensors();
+    bool is_reshape = kReshapeOps.find(node->type()) != kReshapeOps.end();
+    if ((!is_reshape && kInPlaceOps.find(node->type()) == kInPlaceOps.end()) || outputs.size() != 1 ||
+        !IsInPlaceDataType(outputs[0]->data_type())) {
+      continue;
+    }
+    auto output = outputs[0];
+    for (auto *input : node->input_tensors()) {
+      // the input dies at this node, and the elementwise op reads each element before writing the same index.
+      if (define_index_.find(input) == define_index_.end() || last_use_index_[input] != i ||
+          input->data_type() != output->data_type() || input->Size() != output->Size() ||
+          (!is_reshape && input->shape() != output->shape())) {
+        continue;
+      }
+      size_t input_offset = 0;
+      size_t output_offset = 0;
+      auto input_root = FindRoot(input, &input_offset);
+      auto output_root = FindRoot(output, &output_offset);
+      if (input_root == output_root || output_offset < input_offset) {
+        continue;
+      }
+      alias_[input_root] = std::make_pair(output_root, output_offset - input_offset);
+      if (is_reshape) {
+        in_place_outputs_.insert(output);
+      }
+      break;
+    }
+  }
+}
+
+std::vector<MemoryManager::MemBlock> MemoryManager::BuildBlocks() const {
+  std::map<Tensor *, MemBlock> blocks;
+  for (auto *tensor : tensors_) {
+    size_t offset = 0;
+    auto root = FindRoot(tensor, &offset);
+    auto iter = blocks.find(root);
+    if (iter == blocks.end()) {
+      MemBlock block;
+      block.root = root;
+      block.start = define_index_.at(tensor);
+      block.end = last_use_index_.at(tensor);
+      iter = blocks.insert(std::make_pair(root, block)).first;
+    }
+    auto &block = iter->second;
+    block.size = std::max(block.size, AlignMemorySize(offset + tensor->Size()));
+    block.start = std::min(block.start, define_index_.at(tensor));
+    block.end = std::max(block.end, last_use_index_.at(tensor));
+  }
+  std::vector<MemBlock> result;
+  for (auto &item : blocks) {
+    result.push_back(item.second);
+  }
+  return result;
+}
+
+// Place each block at the smallest gap fitting it among the placed blocks whose lifetimes overlap its lifetime.
+size_t MemoryManager::PlaceBlocks(std::vector<MemBlock> *blocks) {
+  size_t total_size = 0;
+  std::vector<const MemBlock *> placed;
+  for (auto &block : *blocks) {
+    std::vector<const MemBlock *> overlapped;
+    for (auto *other : placed) {
+      if (other->start <= block.end && block.start <= other->end) {
+        overlapped.push_back(other);
+      }
+    }
+    std::sort(overlapped.begin(), overlapped.end(),
+              [](const MemBlock *a, const MemBlock *b) { return a->offset < b->offset; });
+    size_t best_offset = SIZE_MAX;
+    size_t best_gap = SIZE_MAX;
+    size_t offset = 0;
+    for (auto *other : overlapped) {
+      if (other->offset >= offset + block.size && other->offset - offset < best_gap) {
+        best_gap = other->offset - offset;
+        best_offset = offset;
+      }
+      offset = std::max(offset, other->offset + other->size);
+    }
+    block.offset = best_offset == SIZE_MAX ? offset : best_offset;
+    total_size = std::max(total_size, block.offset + block.size);
+    placed.push_back(&block);
+  }
+  return total_size;
+}
+
+size_t MemoryManager::PlanMemory(std::map<Tensor *, size_t> *offsets) {
+  auto blocks = BuildBlocks();
+  // greedy by size, and greedy by the area of size and lifetime, the better one is taken.
+  auto by_size = blocks;
+  std::stable_sort(by_size.begin(), by_size.end(), [](const MemBlock &a, const MemBlock &b) {
+    return a.size != b.size ? a.size > b.size : a.start < b.start;
+  });
+  auto by_area = blocks;
+  std::stable_sort(by_area.begin(), by_area.end(), [](const MemBlock &a, const MemBlock &b) {
+    return a.size * (a.end - a.start + 1) > b.size * (b.end - b.start + 1);
+  });
+  auto size_of_by_size = PlaceBlocks(&by_size);
+  auto size_of_by_area = PlaceBlocks(&by_area);
+  auto &best = size_of_by_size <= size_of_by_area ? by_size : by_area;
+  std::map<Tensor *, size_t> block_offsets;
+  for (auto &block : best) {
+    block_offsets[block.root] = block.offset;
+  }
+  for (auto *tensor : tensors_) {
+    size_t offset = 0;
+    auto root = FindRoot(tensor, &offset);
+    (*offsets)[tensor] = block_offsets[root] + offset;
   }
-  return membuf_list_.back()->offset_ + membuf_list_.back()->size_;
+  return std::min(size_of_by_size, size_of_by_area);
 }
 
 void MemoryManager::AssignOutputs(const std::unique_ptr<OperatorCoder> &node) {
@@ -97,7 +343,7 @@ void MemoryManager::ReleaseInputs(const std::unique_ptr<OperatorCoder> &node) {
 
 void MemoryManager::AssignNewMembuf(Tensor *key, size_t size) {
   MS_LOG(DEBUG) << "assign new membuf: " << size;
-  size_t offset = GetAllocatedSize();
+  size_t offset = membuf_list_.empty() ? 0 : membuf_list_.back()->offset_ + membuf_list_.back()->size_;
   auto membuf = std::make_shared<Membuf>(key, kReused, size, offset);
   MS_CHECK_PTR_IF_NULL(membuf);
   membuf_list_.push_back(membuf);
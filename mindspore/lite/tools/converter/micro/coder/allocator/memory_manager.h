@@ -18,6 +18,7 @@
 #define MINDSPORE_LITE_TOOLS_CONVERTER_MICRO_CODER_ALLOCATOR_MEMORY_MANAGER_H_
 
 #include <map>
+#include <set>
 #include <vector>
 #include <memory>
 #include <utility>
@@ -46,11 +47,24 @@ class MemoryManager {
   MemoryManager() = default;
   ~MemoryManager() = default;
 
-  int AssignMemory(const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
+  int AssignMemory(const std::vector<std::unique_ptr<OperatorCoder>> &nodes, const std::vector<Tensor *> &outputs);
   size_t GetAllocatedSize() const;
+  // the size needed when the tensors are assigned in the execution order without in-place and aliasing
+  size_t GetOrderedSize() const { return ordered_size_; }
   std::map<Tensor *, size_t> variables_offset() { return variables_offset_; }
+  // the outputs whose data are already in place before their ops run, such as the aliased outputs of concat
+  std::set<Tensor *> in_place_outputs() const { return in_place_outputs_; }
 
  private:
+  struct MemBlock {
+    Tensor *root = nullptr;
+    size_t size = 0;
+    size_t start = 0;
+    size_t end = 0;
+    size_t offset = 0;
+  };
+
+  void AssignInOrder(const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
   void AssignOutputs(const std::unique_ptr<OperatorCoder> &node);
   void ReleaseInputs(const std::unique_ptr<OperatorCoder> &node);
 
@@ -64,10 +78,31 @@ class MemoryManager {
 
   void StoreMembufListInfo(const std::unique_ptr<OperatorCoder> &node);
 
+  // the lifetime-aware planning, in which the tensors sharing memory are grouped to the blocks.
+  void AnalyzeLifetime(const std::vector<std::unique_ptr<OperatorCoder>> &nodes, const std::vector<Tensor *> &outputs);
+  Tensor *FindRoot(Tensor *tensor, size_t *offset) const;
+  void AliasConcatInputs(const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
+  void AliasInPlaceOutputs(const std::vector<std::unique_ptr<OperatorCoder>> &nodes);
+  std::vector<MemBlock> BuildBlocks() const;
+  static size_t PlaceBlocks(std::vector<MemBlock> *blocks);
+  size_t PlanMemory(std::map<Tensor *, size_t> *offsets);
+
  private:
   std::vector<MembufPtr> membuf_list_;
   std::vector<std::pair<size_t, std::vector<MembufPtr>>> all_membuf_list_info_;
   std::map<Tensor *, size_t> variables_offset_;
+  size_t allocated_size_{0};
+  size_t ordered_size_{0};
+
+  std::vector<Tensor *> tensors_;
+  // the index of the node producing the tensor and the index of its last consumer
+  std::map<Tensor *, size_t> define_index_;
+  std::map<Tensor *, size_t> last_use_index_;
+  std::map<Tensor *, size_t> consumer_num_;
+  std::set<Tensor *> graph_outputs_;
+  // tensor -> the tensor it is aliased to and its offset in the memory of that tensor
+  std::map<Tensor *, std::pair<Tensor *, size_t>> alias_;
+  std::set<Tensor *> in_place_outputs_;
 };
 }  // namespace mindspore::lite::micro
 #endif  // MINDSPORE_LITE_TOOLS_CONVERTER_MICRO_CODER_ALLOCATOR_MEMORY_MANAGER_H_
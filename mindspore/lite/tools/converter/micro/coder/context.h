@@ -71,6 +71,14 @@ class CoderContext {
 
   void set_total_buffer_size(size_t size) { total_buffer_size_ = size; }
   size_t total_buffer_size() const { return total_buffer_size_; }
+  void set_peak_buffer_size(size_t size) { peak_buffer_size_ = size; }
+  size_t peak_buffer_size() const { return peak_buffer_size_; }
+  void set_tensors_buffer_size(size_t size, size_t ordered_size) {
+    tensors_buffer_size_ = size;
+    ordered_tensors_buffer_size_ = ordered_size;
+  }
+  size_t tensors_buffer_size() const { return tensors_buffer_size_; }
+  size_t ordered_tensors_buffer_size() const { return ordered_tensors_buffer_size_; }
 
   void set_graph_inputs(const std::vector<Tensor *> &graph_inputs) { graph_inputs_ = graph_inputs; }
   void set_graph_outputs(const std::vector<Tensor *> &graph_outputs) { graph_outputs_ = graph_outputs; }
@@ -113,6 +121,11 @@ class CoderContext {
   std::map<Tensor *, std::string> tensors_map_;
   // workspace's size.
   size_t total_buffer_size_{0};
+  // the peak ram of the tensors and workspaces, less than the workspace's size when it is enlarged for dequant.
+  size_t peak_buffer_size_{0};
+  // the size of the tensors in the workspace, and the size when they are assigned in the execution order.
+  size_t tensors_buffer_size_{0};
+  size_t ordered_tensors_buffer_size_{0};
   // model's input tensor data's address.
   std::string input_name_;
   // model's output tensor's address
@@ -304,6 +304,19 @@ void CodeManageResourceState(std::ofstream &ofs) {
 }
 
 void CodeInitResourceImplement(std::ofstream &ofs, const std::unique_ptr<CoderContext> &ctx) {
+  ofs << "/**\n";
+  if (ctx->total_buffer_size() > ctx->peak_buffer_size()) {
+    ofs << "  * the buffer of " << ctx->total_buffer_size()
+        << " bytes is sized by the max workspace of the weight dequantization,\n"
+        << "  * peak ram of the tensors and workspaces: " << ctx->peak_buffer_size()
+        << " bytes, in which the tensors take " << ctx->tensors_buffer_size() << " bytes,\n";
+  } else {
+    ofs << "  * peak ram of the buffer: " << ctx->total_buffer_size() << " bytes, in which the tensors take "
+        << ctx->tensors_buffer_size() << " bytes,\n";
+  }
+  ofs << "  * and the tensors take " << ctx->ordered_tensors_buffer_size()
+      << " bytes when assigned in the execution order without in-place and aliasing.\n"
+      << "  **/\n";
   ofs << "int "
       << "GetBufferSize() {\n"
       << "  return " << ctx->total_buffer_size() << ";\n"
@@ -31,6 +31,9 @@ namespace mindspore::lite::micro {
 int ReshapeBaseCoder::Prepare(CoderContext *const context) { return RET_OK; }
 
 int ReshapeBaseCoder::DoCode(CoderContext *const context) {
+  if (allocator_->IsOutputInPlace(output_tensor_)) {
+    return RET_OK;
+  }
   Serializer coder;
 
   size_t size = input_tensor_->Size();
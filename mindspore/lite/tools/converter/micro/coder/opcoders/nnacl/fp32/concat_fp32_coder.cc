@@ -34,6 +34,10 @@ int ConcatFP32Coder::ReSize() {
 }
 
 int ConcatFP32Coder::DoCode(CoderContext *const context) {
+  if (allocator_->IsOutputInPlace(output_tensor_)) {
+    // the inputs are the slices of the output, which are written by their producers directly.
+    return RET_OK;
+  }
   Collect(context,
           {
             "nnacl/base/concat_base.h",
@@ -51,6 +51,8 @@ int CoderSession::EndCode() {
                               ? allocator_->total_buffer_size()
                               : de_quant_max_workspace_size;
   context_->set_total_buffer_size(final_total_size);
+  context_->set_peak_buffer_size(allocator_->total_buffer_size());
+  context_->set_tensors_buffer_size(allocator_->tensors_size(), allocator_->ordered_tensors_size());
   context_->set_graph_inputs(coder_graph_->input_tensors());
   context_->set_graph_outputs(coder_graph_->output_tensors());
   Configurator *config = Configurator::GetInstance();
@@ -70,7 +72,8 @@ int CoderSession::Run() {
   MS_LOG(INFO) << "start run opcoders";
   // 1. assign memory
   std::vector<lite::Tensor *> inputs = coder_graph_->input_tensors();
-  int ret = allocator_->Assign(inputs, op_coders_);
+  std::vector<lite::Tensor *> outputs = coder_graph_->output_tensors();
+  int ret = allocator_->Assign(inputs, outputs, op_coders_);
   MS_CHECK_RET_CODE(ret, "assign memory failed");
   // 2. prepare, init model parameters
   for (const auto &op_coder : op_coders_) {
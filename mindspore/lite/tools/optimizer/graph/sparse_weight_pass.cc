@@ -0,0 +1,160 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#define USE_DEPRECATED_API
+#include "tools/optimizer/graph/sparse_weight_pass.h"
+#include <memory>
+#include "ops/fusion/conv2d_fusion.h"
+#include "ops/fusion/full_connection.h"
+#include "ops/fusion/mat_mul_fusion.h"
+#include "ops/op_utils.h"
+#include "tools/optimizer/common/gllo_utils.h"
+#include "include/errorcode.h"
+#include "nnacl/op_base.h"
+#include "nnacl/fp32/matmul_sparse_weight_fp32.h"
+
+namespace mindspore {
+namespace opt {
+namespace {
+constexpr size_t kInputIndex = 1;
+constexpr size_t kWeightIndex = 2;
+constexpr size_t kMatrixRank = 2;
+constexpr size_t kConvWeightRank = 4;
+constexpr size_t kConvKernelH = 1;
+constexpr size_t kConvKernelW = 2;
+constexpr size_t kConvInChannel = 3;
+// The sparse kernel runs faster than the packed dense one of avx2 below about 0.7 of the non-zero blocks, and is about
+// 1.6 times as fast at 0.5, see the FcSparseWeightSpeedVsDensity test of the fullconnection kernel. Packing the sparse
+// weight costs more than the dense one, which is paid once when the model is loaded.
+constexpr float kMaxBlockDensity = 0.5f;
+}  // namespace
+
+bool SparseWeightPass::GetWeightShape(const CNodePtr &cnode, const tensor::TensorPtr &weight, int *deep, int *col,
+                                      bool *deep_major) const {
+  MS_ASSERT(cnode != nullptr && weight != nullptr && deep != nullptr && col != nullptr && deep_major != nullptr);
+  auto shape = weight->shape();
+  if (CheckPrimitiveType(cnode, prim::kPrimMatMulFusion)) {
+    auto prim = ops::GetOperator<ops::MatMulFusion>(cnode->input(0));
+    MS_CHECK_TRUE_RET(prim != nullptr, false);
+    // matrix-a is read by row directly.
+    if (shape.size() != kMatrixRank || (prim->GetAttr(ops::kTransposeA) != nullptr && prim->get_transpose_a())) {
+      return false;
+    }
+    *deep_major = prim->GetAttr(ops::kTransposeB) != nullptr && prim->get_transpose_b();
+    *deep = static_cast<int>(*deep_major ? shape[1] : shape[0]);
+    *col = static_cast<int>(*deep_major ? shape[0] : shape[1]);
+  } else if (CheckPrimitiveType(cnode, prim::kPrimFullConnection)) {
+    if (shape.size() != kMatrixRank) {
+      return false;
+    }
+    *deep_major = true;
+    *deep = static_cast<int>(shape[1]);
+    *col = static_cast<int>(shape[0]);
+  } else if (CheckPrimitiveType(cnode, prim::kPrimConv2DFusion)) {
+    auto prim = ops::GetOperator<ops::Conv2DFusion>(cnode->input(0));
+    MS_CHECK_TRUE_RET(prim != nullptr, false);
+    int64_t group = prim->GetAttr(ops::kGroup) == nullptr ? 1 : prim->get_group();
+    // the weight of the 1x1 conv is [output_channel, 1, 1, input_channel].
+    if (group != 1 || shape.size() != kConvWeightRank || shape[kConvKernelH] != 1 || shape[kConvKernelW] != 1) {
+      return false;
+    }
+    *deep_major = true;
+    *deep = static_cast<int>(shape[kConvInChannel]);
+    *col = static_cast<int>(shape[0]);
+  } else {
+    return false;
+  }
+  return *deep > 0 && *col > 0;
+}
+
+int SparseWeightPass::EncodeWeight(const ParameterPtr &weight_node, const tensor::TensorPtr &weight, int deep, int col,
+                                   bool deep_major) const {
+  MS_ASSERT(weight_node != nullptr && weight != nullptr);
+  auto src = static_cast<const float *>(weight->data_c());
+  MS_CHECK_TRUE_RET(src != nullptr, lite::RET_ERROR);
+  MS_CHECK_TRUE_RET(static_cast<int64_t>(deep) * col == weight->DataSize(), lite::RET_ERROR);
+  int nnz = 0;
+  int block_num = SparseWeightBlockNumFp32(src, deep, col, deep_major, &nnz);
+  auto total_block_num = static_cast<float>(UP_DIV(col, C8NUM)) * deep;
+  float block_density = block_num / total_block_num;
+  MS_LOG(INFO) << weight_node->fullname_with_scope() << " of " << deep << " x " << col
+               << ", the density of the values is " << static_cast<float>(nnz) / (static_cast<float>(col) * deep)
+               << " and the density of the blocks is " << block_density;
+  if (block_density > kMaxBlockDensity) {
+    return lite::RET_NO_CHANGE;
+  }
+
+  size_t offset_num = static_cast<size_t>(UP_DIV(col, C8NUM)) + 1;
+  size_t size = sizeof(SparseWeightHeader) + (offset_num + static_cast<size_t>(block_num)) * sizeof(int) +
+                static_cast<size_t>(block_num) * C8NUM * sizeof(float);
+  auto compress_tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, weight->shape(), size, kBlockSparse);
+  MS_CHECK_TRUE_MSG(compress_tensor != nullptr, lite::RET_ERROR, "compress_tensor is nullptr.");
+  auto header = static_cast<SparseWeightHeader *>(compress_tensor->data_c());
+  MS_CHECK_TRUE_MSG(header != nullptr, lite::RET_ERROR, "the data of compress_tensor is nullptr.");
+  header->deep_ = deep;
+  header->col_ = col;
+  header->deep_major_ = deep_major ? 1 : 0;
+  header->block_num_ = block_num;
+  auto offsets = reinterpret_cast<int *>(header + 1);
+  auto depths = offsets + offset_num;
+  auto values = reinterpret_cast<float *>(depths + block_num);
+  PackSparseWeightFp32(src, values, depths, offsets, deep, col, deep_major);
+  weight_node->set_default_param(compress_tensor);
+  weight_node->set_abstract(compress_tensor->ToAbstract());
+  MS_LOG(INFO) << weight_node->fullname_with_scope() << " is encoded as block-sparse, origin size:" << weight->Size()
+               << " compress tensor size:" << compress_tensor->Size();
+  return lite::RET_OK;
+}
+
+bool SparseWeightPass::Run(const FuncGraphPtr &func_graph) {
+  MS_CHECK_TRUE_RET(func_graph != nullptr, false);
+  auto node_list = TopoSort(func_graph->get_return());
+  for (auto &node : node_list) {
+    if (!utils::isa<CNodePtr>(node)) {
+      continue;
+    }
+    auto cnode = node->cast<CNodePtr>();
+    if (IsMarkedTrainOp(cnode) || cnode->size() <= kWeightIndex) {
+      continue;
+    }
+    auto weight_node = cnode->input(kWeightIndex);
+    if (!utils::isa<ParameterPtr>(weight_node) || !weight_node->cast<ParameterPtr>()->has_default() ||
+        IsParamOrValueNodeWithData(cnode->input(kInputIndex)) || visited_weights_.count(weight_node) != 0) {
+      continue;
+    }
+    auto weight = GetTensorInfo(weight_node);
+    if (weight == nullptr || weight->data_type() != kNumberTypeFloat32 ||
+        weight->compression_type() != kNoCompression) {
+      continue;
+    }
+    int deep = 0;
+    int col = 0;
+    bool deep_major = false;
+    if (!GetWeightShape(cnode, weight, &deep, &col, &deep_major)) {
+      continue;
+    }
+    // the weight shared by the nodes is measured once.
+    (void)visited_weights_.insert(weight_node);
+    auto ret = EncodeWeight(weight_node->cast<ParameterPtr>(), weight, deep, col, deep_major);
+    if (ret != lite::RET_OK && ret != lite::RET_NO_CHANGE) {
+      MS_LOG(ERROR) << "Encode the sparse weight of " << cnode->fullname_with_scope() << " failed.";
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace opt
+}  // namespace mindspore
@@ -0,0 +1,47 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef MINDSPORE_LITE_TOOLS_OPTIMIZER_GRAPH_SPARSE_WEIGHT_PASS_H_
+#define MINDSPORE_LITE_TOOLS_OPTIMIZER_GRAPH_SPARSE_WEIGHT_PASS_H_
+#include <set>
+#include "backend/common/optimizer/optimizer.h"
+#include "ir/anf.h"
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace opt {
+// Measure the sparsity of the float32 const weights of MatMulFusion, FullConnection and 1x1 Conv2DFusion, and encode
+// the ones having few enough non-zero blocks of 8 output channels as block-sparse, which the runtime runs by the
+// sparse kernels, see nnacl/fp32/matmul_sparse_weight_fp32.h.
+class SparseWeightPass : public Pass {
+ public:
+  SparseWeightPass() : Pass("sparse_weight_pass") {}
+  ~SparseWeightPass() override = default;
+  bool Run(const FuncGraphPtr &func_graph) override;
+
+ private:
+  // the weight is [col, deep] if deep_major is true, otherwise [deep, col].
+  bool GetWeightShape(const CNodePtr &cnode, const tensor::TensorPtr &weight, int *deep, int *col,
+                      bool *deep_major) const;
+  int EncodeWeight(const ParameterPtr &weight_node, const tensor::TensorPtr &weight, int deep, int col,
+                   bool deep_major) const;
+
+  std::set<AnfNodePtr> visited_weights_;
+};
+}  // namespace opt
+}  // namespace mindspore
+
+#endif  // MINDSPORE_LITE_TOOLS_OPTIMIZER_GRAPH_SPARSE_WEIGHT_PASS_H_
@@ -746,6 +746,20 @@ class _PynativeExecutor:
         """
         self._executor.end_graph(obj, output, *args, *(kwargs.values()))
 
+    def replay_graph(self, obj, *args, **kwargs):
+        """
+        Run the graph captured from the previous steps of the top cell without grad.
+
+        Args:
+            obj (Cell): The cell instance.
+            args (tuple): Cell input arguments.
+            kwargs (dict): keyword arguments.
+
+        Return:
+            The output of the graph, or None if no captured graph matches the inputs.
+        """
+        return self._executor.replay_graph(obj, *args, *(kwargs.values()))
+
     def check_graph(self, obj, *args, **kwargs):
         """
         Determines the order of the function or cell.
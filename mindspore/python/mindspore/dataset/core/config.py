@@ -43,7 +43,8 @@ __all__ = ['set_sending_batches', 'load', '_init_device_info',
            'set_autotune_interval', 'get_autotune_interval',
            'set_auto_offload', 'get_auto_offload',
            'set_enable_watchdog', 'get_enable_watchdog',
-           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval']
+           'set_multiprocessing_timeout_interval', 'get_multiprocessing_timeout_interval',
+           'set_tensor_pool_size', 'get_tensor_pool_size']
 
 INT32_MAX = 2147483647
 UINT32_MAX = 4294967295
@@ -769,6 +770,48 @@ def get_multiprocessing_timeout_interval():
     return _config.get_multiprocessing_timeout_interval()
 
 
+def set_tensor_pool_size(size):
+    """
+    Set the maximum size (in MB) of the freed tensor buffers kept for recycling.
+
+    When it is positive, the data buffers of the tensors created by the pipeline are rounded up to size classes
+    and, once freed, kept in a pool instead of being returned to the system allocator, so that buffers of
+    recurring shapes are reused by the following steps. This reduces page faults and memory fragmentation of
+    long running pipelines at the cost of keeping up to `size` MB of idle memory.
+
+    Args:
+        size (int): Maximum size (in MB) of the tensor pool, 0 disables the pool. System default: 0.
+
+    Raises:
+        TypeError: If `size` is not of type int.
+        ValueError: If `size` < 0 or `size` > INT32_MAX(2147483647).
+
+    Examples:
+        >>> # Keep up to 2GB of freed tensor buffers for recycling.
+        >>> ds.config.set_tensor_pool_size(2048)
+    """
+    if not isinstance(size, int) or isinstance(size, bool):
+        raise TypeError("size isn't of type int.")
+    if size < 0 or size > INT32_MAX:
+        raise ValueError("Size given is not within the required range [0, INT32_MAX(2147483647)].")
+    _config.set_tensor_pool_size(size)
+
+
+def get_tensor_pool_size():
+    """
+    Get the global configuration of the maximum size (in MB) of the freed tensor buffers kept for recycling.
+
+    Returns:
+        int, maximum size (in MB) of the tensor pool, 0 means the pool is disabled (default is 0).
+
+    Examples:
+        >>> # Get the global configuration of the tensor pool size.
+        >>> # If set_tensor_pool_size() is never called before, the default value(0) will be returned.
+        >>> tensor_pool_size = ds.config.get_tensor_pool_size()
+    """
+    return _config.get_tensor_pool_size()
+
+
 def set_dynamic_shape(is_dynamic):
     """
     Set the dynamic shape flag of the dataset.
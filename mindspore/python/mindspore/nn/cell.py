@@ -592,6 +592,12 @@ class Cell(Cell_):
         if self._dynamic_shape_inputs is not None:
             self._check_compile_dynamic_shape(*args)
 
+        # Replay the graph captured from the previous steps of the top cell, see MS_DEV_PYNATIVE_GRAPH_CAPTURE.
+        if _pynative_executor.is_first_cell():
+            output = _pynative_executor.replay_graph(self, *args, **kwargs)
+            if output is not None:
+                return output
+
         try:
             _pynative_executor.new_graph(self, *args, **kwargs)
             output = self._run_construct(args, kwargs)
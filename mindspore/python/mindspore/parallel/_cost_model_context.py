@@ -296,6 +296,34 @@ class _CostModelContext:
             raise ValueError("Context handle is none in context!!!")
         return self._context_handle.get_dp_algo_single_loop()
 
+    def set_dp_algo_parallel_search(self, parallel_search):
+        """
+        Set the flag of running the DP algorithm in parallel and reusing the costs of the identical operators.
+
+        Args:
+            parallel_search (bool): The parameter for the parallel search flag.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if not isinstance(parallel_search, bool):
+            raise TypeError("For 'set_dp_algo_parallel_search', the argument 'parallel_search' must be bool, "
+                            "but got the type : {}".format(type(parallel_search)))
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        self._context_handle.set_dp_algo_parallel_search(parallel_search)
+
+    def get_dp_algo_parallel_search(self):
+        """
+        Get the flag of running the DP algorithm in parallel and reusing the costs of the identical operators.
+
+        Raises:
+            ValueError: If context handle is none.
+        """
+        if self._context_handle is None:
+            raise ValueError("Context handle is none in context!!!")
+        return self._context_handle.get_dp_algo_parallel_search()
+
     def set_costmodel_allreduce_fusion_algorithm(self, algorithm):
         """
         Set costmodel allreduce fusion algorithm.
@@ -652,3 +680,20 @@ def _get_algo_single_loop():
     Get the flag of whether or not generating a single suite of OperatorInfos in for-loop.
     """
     return cost_model_context().get_dp_algo_single_loop()
+
+
+def _set_algo_parallel_search(parallel_search=True):
+    """
+    Set the flag of running the DP algorithm in parallel and reusing the costs of the identical operators.
+
+    Args:
+        parallel_search (bool): The parameter for the parallel search flag.
+    """
+    cost_model_context().set_dp_algo_parallel_search(parallel_search)
+
+
+def _get_algo_parallel_search():
+    """
+    Get the flag of running the DP algorithm in parallel and reusing the costs of the identical operators.
+    """
+    return cost_model_context().get_dp_algo_parallel_search()
@@ -175,6 +175,27 @@ class _AlgoParameterConfig:
         self.check_config_handle()
         return self._config_handle.get_dp_algo_approxi_epsilon()
 
+    def set_dp_algo_time_budget(self, time_budget):
+        """
+        Set the time budget in seconds of the DP algorithm.
+        Default: 0.0, which means unlimited.
+
+        Args:
+            time_budget (float): The time budget, should be non-negative.
+        """
+        self.check_config_handle()
+        self._config_handle.set_dp_algo_time_budget(time_budget)
+
+    def get_dp_algo_time_budget(self):
+        """
+        Get the time budget in seconds of the DP algorithm.
+
+        Returns:
+            The time budget.
+        """
+        self.check_config_handle()
+        return self._config_handle.get_dp_algo_time_budget()
+
     def reset_algo_parameters(self):
         """
         Reset algorithm parameter attributes.
@@ -205,7 +226,8 @@ set_algo_parameters_config_func_map = {
     "tensor_slice_align_enable": _algo_parameter_config().set_tensor_slice_align_enable,
     "tensor_slice_align_size": _algo_parameter_config().set_tensor_slice_align_size,
     "enable_algo_approxi": _algo_parameter_config().set_dp_algo_enable_approxi,
-    "algo_approxi_epsilon": _algo_parameter_config().set_dp_algo_approxi_epsilon}
+    "algo_approxi_epsilon": _algo_parameter_config().set_dp_algo_approxi_epsilon,
+    "algo_time_budget": _algo_parameter_config().set_dp_algo_time_budget}
 
 
 get_algo_parameters_config_func_map = {
@@ -214,12 +236,13 @@ get_algo_parameters_config_func_map = {
     "tensor_slice_align_enable": _algo_parameter_config().get_tensor_slice_align_enable,
     "tensor_slice_align_size": _algo_parameter_config().get_tensor_slice_align_size,
     "enable_algo_approxi": _algo_parameter_config().get_dp_algo_enable_approxi,
-    "algo_approxi_epsilon": _algo_parameter_config().get_dp_algo_approxi_epsilon}
+    "algo_approxi_epsilon": _algo_parameter_config().get_dp_algo_approxi_epsilon,
+    "algo_time_budget": _algo_parameter_config().get_dp_algo_time_budget}
 
 
 @args_type_check(tensor_slice_align_enable=bool, tensor_slice_align_size=int,
                  fully_use_devices=bool, elementwise_op_strategy_follow=bool,
-                 enable_algo_approxi=bool, algo_approxi_epsilon=float)
+                 enable_algo_approxi=bool, algo_approxi_epsilon=float, algo_time_budget=float)
 def set_algo_parameters(**kwargs):
     """
     Set parameters in the algorithm for parallel strategy searching. See a typical use in
@@ -244,6 +267,10 @@ def set_algo_parameters(**kwargs):
         algo_approxi_epsilon (float): The epsilon value used in the approximation algorithm. Default: 0.1. This value
             describes the extent of approximation. For example, the number of candidate strategies of an operator is S,
             if 'enable_algo_approxi' is true, then the remaining strategies is of size: min{S, 1/epsilon}.
+        algo_time_budget (float): The time budget in seconds of the strategy searching. Default: 0.0, which means
+            unlimited. When the searching exceeds the budget, the rest of the searching only keeps the cheapest cost
+            under each candidate strategy, which returns the best strategies found so far quickly but may be
+            suboptimal.
         tensor_slice_align_enable (bool): Whether to check the shape of tensor slice of MatMul. Default: False. Due to
             properties of some hardware, MatMul kernel only with large shapes can show advantages. If this flag is true,
             then the slice shape of MatMul is checked to prevent irregular shapes.
@@ -270,7 +297,7 @@ def get_algo_parameters(attr_key):
 
     Args:
         attr_key (str): The key of the attribute. The keys include: "fully_use_devices",
-            "elementwise_op_strategy_follow", "enable_algo_approxi", "algo_approxi_epsilon",
+            "elementwise_op_strategy_follow", "enable_algo_approxi", "algo_approxi_epsilon", "algo_time_budget",
             "tensor_slice_align_enable","tensor_slice_align_size".
 
     Returns:
@@ -297,6 +324,7 @@ def reset_algo_parameters():
     - elementwise_op_strategy_follow: False.
     - enable_algo_approxi: False.
     - algo_approxi_epsilon: 0.1.
+    - algo_time_budget: 0.0.
     - tensor_slice_align_enable: False.
     - tensor_slice_align_size: 16.
     """
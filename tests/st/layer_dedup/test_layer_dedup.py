@@ -0,0 +1,97 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import numpy as np
+import pytest
+
+import mindspore.context as context
+import mindspore.nn as nn
+from mindspore import Tensor, Parameter
+from mindspore.nn import TrainOneStepCell, WithLossCell
+from mindspore.nn.optim import Momentum
+from mindspore.ops import operations as P
+
+context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+
+
+class Block(nn.Cell):
+    def __init__(self, hidden, index):
+        super(Block, self).__init__()
+        self.weight1 = Parameter(Tensor(np.full((hidden, hidden), 0.01 * (index + 1)), np.float32), name="weight1")
+        self.weight2 = Parameter(Tensor(np.full((hidden, hidden), 0.02 * (index + 1)), np.float32), name="weight2")
+        self.matmul = P.MatMul()
+        self.relu = P.ReLU()
+        self.add = P.Add()
+        self.mul = P.Mul()
+        self.tanh = P.Tanh()
+
+    def construct(self, x):
+        out = self.matmul(x, self.weight1)
+        out = self.relu(out)
+        out = self.matmul(out, self.weight2)
+        out = self.tanh(out)
+        out = self.mul(out, 0.5)
+        out = self.add(out, x)
+        out = self.relu(out)
+        out = self.add(out, x)
+        return self.mul(out, 0.5)
+
+
+class Net(nn.Cell):
+    def __init__(self, hidden, layer_num):
+        super(Net, self).__init__()
+        self.blocks = nn.CellList([Block(hidden, i) for i in range(layer_num)])
+
+    def construct(self, x):
+        for block in self.blocks:
+            x = block(x)
+        return x
+
+
+def numpy_forward(x, layer_num, hidden):
+    for i in range(layer_num):
+        weight1 = np.full((hidden, hidden), 0.01 * (i + 1), np.float32)
+        weight2 = np.full((hidden, hidden), 0.02 * (i + 1), np.float32)
+        out = np.maximum(np.matmul(x, weight1), 0)
+        out = np.tanh(np.matmul(out, weight2)) * 0.5 + x
+        x = (np.maximum(out, 0) + x) * 0.5
+    return x
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_layer_dedup_forward_and_train(monkeypatch):
+    """
+    Feature: Layer deduplicated compilation.
+    Description: Compile a net of repeated blocks with MS_DEV_LAYER_DEDUP=1, run the forward and train some steps.
+    Expectation: The forward is the same as the numpy result with the weights of every block, and the loss of the
+        training decreases.
+    """
+    monkeypatch.setenv('MS_DEV_LAYER_DEDUP', '1')
+    hidden = 8
+    layer_num = 6
+    x = np.random.randn(4, hidden).astype(np.float32)
+    net = Net(hidden, layer_num)
+    output = net(Tensor(x))
+    assert np.allclose(output.asnumpy(), numpy_forward(x, layer_num, hidden), rtol=1e-4, atol=1e-5)
+
+    label = Tensor(np.zeros((4, hidden), np.float32))
+    net_with_loss = WithLossCell(net, nn.MSELoss())
+    optimizer = Momentum(net.trainable_params(), learning_rate=0.1, momentum=0.9)
+    train_net = TrainOneStepCell(net_with_loss, optimizer)
+    train_net.set_train()
+    losses = [train_net(Tensor(x), label).asnumpy() for _ in range(5)]
+    assert losses[-1] < losses[0]
@@ -0,0 +1,124 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+# ============================================================================
+
+import os
+import time
+import numpy as np
+import pytest
+import mindspore
+from mindspore import context, ops, nn, Tensor, Parameter
+
+
+class NetSmallOps(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.relu = ops.ReLU()
+        self.add = ops.Add()
+        self.mul = ops.Mul()
+        self.weight = Parameter(Tensor(np.ones((2, 2)), mindspore.float32), name="weight")
+
+    def construct(self, x, y, scale):
+        out = self.relu(x)
+        for _ in range(100):
+            out = self.add(out, y)
+        return self.mul(out, self.weight) * scale, out.shape
+
+
+class NetValueBranch(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.relu = ops.ReLU()
+        self.add = ops.Add()
+        self.sub = ops.Sub()
+
+    def construct(self, x):
+        out = self.relu(x)
+        if x.sum() > 0:
+            return self.add(out, 1)
+        return self.sub(out, 1)
+
+
+def run_steps(graph_capture, net, inputs_list):
+    os.environ['MS_DEV_PYNATIVE_GRAPH_CAPTURE'] = '1' if graph_capture else '0'
+    outputs = []
+    total_time = 0
+    for i, inputs in enumerate(inputs_list):
+        time1 = time.time()
+        output, shape = net(*inputs)
+        outputs.append((output.asnumpy(), shape))
+        if i > 2:
+            total_time += (time.time() - time1) * 1000
+    os.environ['MS_DEV_PYNATIVE_GRAPH_CAPTURE'] = '0'
+    return outputs, total_time / max(len(inputs_list) - 3, 1)
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_pynative_graph_capture():
+    """
+    Feature: Graph capture of PyNative top cells.
+    Description: Run the steps of a net eagerly and with graph capture, change the shapes and the scalar inputs between
+        the steps, and update the weight.
+    Expectation: The outputs of the captured graphs are the same as the eager ones, and the steps of the other shapes
+        fall back to the eager execution.
+    """
+    context.set_context(mode=context.PYNATIVE_MODE)
+    inputs_list = []
+    for i in range(10):
+        shape = (2, 2) if i != 6 else (1, 2)
+        x = Tensor(np.full(shape, i - 5), mindspore.float32)
+        y = Tensor(np.full(shape, 0.5), mindspore.float32)
+        inputs_list.append((x, y, 2 if i < 8 else 3))
+
+    eager_net = NetSmallOps()
+    capture_net = NetSmallOps()
+    eager_outputs, eager_time = run_steps(False, eager_net, inputs_list)
+    capture_outputs, capture_time = run_steps(True, capture_net, inputs_list)
+    for eager, capture in zip(eager_outputs, capture_outputs):
+        assert np.allclose(eager[0], capture[0])
+        assert eager[1] == capture[1]
+
+    # The weight is an input of the captured graph, not a constant.
+    capture_net.weight.set_data(Tensor(np.full((2, 2), 2), mindspore.float32))
+    os.environ['MS_DEV_PYNATIVE_GRAPH_CAPTURE'] = '1'
+    output, _ = capture_net(*inputs_list[0])
+    os.environ['MS_DEV_PYNATIVE_GRAPH_CAPTURE'] = '0'
+    assert np.allclose(output.asnumpy(), eager_outputs[0][0] * 2)
+    print("eager avg_time:", eager_time, "graph capture avg_time:", capture_time)
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.platform_x86_gpu_training
+@pytest.mark.env_onecard
+def test_pynative_graph_capture_value_branch():
+    """
+    Feature: Graph capture of PyNative top cells.
+    Description: Run a net whose python control flow depends on the value of the input, with inputs of the same shape
+        taking the other branch after the first steps.
+    Expectation: The step reading the tensor value is not captured, and the outputs are the same as the eager ones.
+    """
+    context.set_context(mode=context.PYNATIVE_MODE)
+    inputs = [Tensor(np.full((2, 2), 1 if i < 4 else -1), mindspore.float32) for i in range(8)]
+    eager_net = NetValueBranch()
+    capture_net = NetValueBranch()
+    eager_outputs = [eager_net(x).asnumpy() for x in inputs]
+    os.environ['MS_DEV_PYNATIVE_GRAPH_CAPTURE'] = '1'
+    capture_outputs = [capture_net(x).asnumpy() for x in inputs]
+    os.environ['MS_DEV_PYNATIVE_GRAPH_CAPTURE'] = '0'
+    for eager, capture in zip(eager_outputs, capture_outputs):
+        assert np.allclose(eager, capture)
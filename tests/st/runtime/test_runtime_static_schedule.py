@@ -0,0 +1,74 @@
+# Copyright 2022 Huawei Technologies Co., Ltd
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+# http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+
+import os
+import time
+import numpy as np
+import pytest
+import mindspore
+from mindspore import context, ops, nn, Tensor
+
+
+class NetSmallKernels(nn.Cell):
+    def __init__(self):
+        super().__init__()
+        self.relu = ops.ReLU()
+        self.add = ops.Add()
+
+    def construct(self, input_x1, input_x2, input_x3, input_x4):
+        output1 = self.relu(input_x1)
+        output2 = self.relu(input_x2)
+        output3 = self.relu(input_x3)
+        output4 = self.relu(input_x4)
+        for _ in range(250):
+            output1 = self.add(output1, 1)
+            output2 = self.add(output2, 1)
+            output3 = self.add(output3, 1)
+            output4 = self.add(output4, 1)
+        output = output1 + output2 + output3 + output4
+        return output
+
+
+def run_step_latency(static_schedule, inputs, expect_output):
+    os.environ['MS_DEV_STATIC_SCHEDULE'] = '1' if static_schedule else '0'
+    net = NetSmallKernels()
+    total_time = 0
+    total_count = 0
+    for i in range(100):
+        time1 = time.time()
+        output = net(*inputs).asnumpy()
+        time2 = time.time()
+        if i > 1:
+            total_count += 1
+            total_time += (time2 - time1) * 1000
+        assert (output == expect_output).all()
+    os.environ['MS_DEV_STATIC_SCHEDULE'] = '0'
+    return total_time / total_count
+
+
+@pytest.mark.level1
+@pytest.mark.platform_x86_cpu
+@pytest.mark.env_onecard
+def test_static_schedule_step_latency():
+    """
+    Feature: Static schedule of the CPU kernel graphs.
+    Description: Run the net of many small kernels by the kernel actors and by the static schedule.
+    Expectation: The outputs of both runtimes are the expected values, and the per step latencies are reported.
+    """
+    context.set_context(mode=context.GRAPH_MODE, device_target="CPU")
+    inputs = [Tensor(np.ones(2), mindspore.float32) for _ in range(4)]
+    expect = np.array([1004, 1004])
+    actor_time = run_step_latency(False, inputs, expect)
+    static_time = run_step_latency(True, inputs, expect)
+    print("actor runtime avg_time:", actor_time, "static schedule avg_time:", static_time)
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <map>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/engine/perf/auto_tune_model.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestAutoTuneModel : public UT::Common {
+ public:
+  // A leaf op with 2 workers at 180% CPU, a map op with 4 workers at 60% CPU and an inlined op at 5% CPU
+  static std::vector<OpLoad> Pipeline(double queued_rows) {
+    return {{0, 2, 16, queued_rows, 180, true}, {1, 4, 16, 2, 60, true}, {2, 0, 0, 0, 5, false}};
+  }
+};
+
+/// Feature: AutoTuneModel
+/// Description: Test the allocation of the workers under a CPU budget
+/// Expectation: Workers go to the slowest op until the budget is used up, no op loses workers
+TEST_F(MindDataTestAutoTuneModel, TestSolveWorkers) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTuneModel-TestSolveWorkers.";
+  AutoTuneModel model(12, 1, 128);
+  ASSERT_OK(model.AddSample(Pipeline(8), 10, 0));
+  std::vector<OpConfig> configs;
+  ASSERT_OK(model.Solve(&configs));
+  ASSERT_EQ(configs.size(), 2);
+  // 18 ms and 6 ms of CPU time per batch, the 6 extra workers all go to the leaf op
+  EXPECT_EQ(configs[0].op_id, 0);
+  EXPECT_EQ(configs[0].num_workers, 8);
+  EXPECT_EQ(configs[0].queue_capacity, 16);
+  EXPECT_EQ(configs[1].op_id, 1);
+  EXPECT_EQ(configs[1].num_workers, 4);
+  std::map<int32_t, int32_t> workers = {{0, 8}};
+  EXPECT_GT(model.EstimateThroughput(workers), model.EstimateThroughput({}));
+
+  // solving again from the new allocation does not change it
+  ASSERT_OK(model.AddSample({{0, 8, 16, 8, 180, true}, {1, 4, 16, 2, 60, true}, {2, 0, 0, 0, 5, false}}, 10, 0));
+  std::vector<OpConfig> again;
+  ASSERT_OK(model.Solve(&again));
+  EXPECT_EQ(again[0].num_workers, 8);
+  EXPECT_EQ(again[1].num_workers, 4);
+}
+
+/// Feature: AutoTuneModel
+/// Description: Test that no worker is added once the pipeline is bound by the total CPU time
+/// Expectation: The allocation is unchanged although the CPU budget is not used up
+TEST_F(MindDataTestAutoTuneModel, TestSolveCpuBound) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTuneModel-TestSolveCpuBound.";
+  AutoTuneModel model(16, 1, 128);
+  // 40 ms of CPU time per batch in total, 16 cores allow 0.4 batches per ms, which 4 workers of op 0 reach
+  ASSERT_OK(model.AddSample({{0, 4, 16, 8, 100, true}, {1, 1, 16, 2, 300, false}}, 10, 0));
+  std::vector<OpConfig> configs;
+  ASSERT_OK(model.Solve(&configs));
+  ASSERT_EQ(configs.size(), 1);
+  EXPECT_EQ(configs[0].num_workers, 4);
+}
+
+/// Feature: AutoTuneModel
+/// Description: Test the fit of the memory per queued row and the memory budget of the connectors
+/// Expectation: The memory per row is recovered and the connectors are scaled down to the budget
+TEST_F(MindDataTestAutoTuneModel, TestMemoryBudget) {
+  MS_LOG(INFO) << "Doing MindDataTestAutoTuneModel-TestMemoryBudget.";
+  AutoTuneModel model(6, 1, 128);
+  EXPECT_EQ(model.MemoryPerRow(), 0);
+  const double memory_per_row = 3;
+  for (int i = 0; i < 4; i++) {
+    double queued_rows = 4 + 2 * i;
+    ASSERT_OK(model.AddSample(Pipeline(queued_rows), 10, 1000 + memory_per_row * (queued_rows + 2)));
+  }
+  EXPECT_NEAR(model.MemoryPerRow(), memory_per_row, 1e-6);
+
+  std::vector<OpConfig> configs;
+  ASSERT_OK(model.Solve(&configs));
+  EXPECT_EQ(configs[0].queue_capacity, 16);
+  EXPECT_EQ(configs[1].queue_capacity, 16);
+  // room for 16 rows only, the connectors keep one slot per worker
+  model.SetMemoryBudget(16.5 * memory_per_row);
+  ASSERT_OK(model.Solve(&configs));
+  EXPECT_EQ(configs[0].queue_capacity, 8);
+  EXPECT_EQ(configs[1].queue_capacity, 8);
+}
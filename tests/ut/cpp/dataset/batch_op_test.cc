@@ -15,7 +15,10 @@
  */
 #include <memory>
 #include <string>
+#include <unordered_map>
+#include <vector>
 #include "minddata/dataset/core/client.h"
+#include "minddata/dataset/engine/datasetops/batch_op.h"
 // #include "minddata/dataset/core/pybind_support.h"
 // #include "minddata/dataset/core/tensor.h"
 // #include "minddata/dataset/core/tensor_shape.h"
@@ -136,3 +139,153 @@ TEST_F(MindDataTestBatchOp, DISABLED_TestSimpleBatchPadding) {
     EXPECT_TRUE(rc.IsOk());
   }
 }
+
+// Feature: Test Batch op padding while batching
+// Description: Batch rows of different shapes with PadAndBatchRows, which copies each row into the padded batch
+// Expectation: The output should be equal to padding every row first and batching afterwards
+TEST_F(MindDataTestBatchOp, TestPadAndBatchRows) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchOp-TestPadAndBatchRows.";
+  std::shared_ptr<Tensor> pad_value;
+  ASSERT_OK(Tensor::CreateScalar<float>(-1, &pad_value));
+  PadInfo pad_info;
+  pad_info.insert({"col_2d", std::make_pair(TensorShape({-1, 3}), pad_value)});
+  pad_info.insert({"col_str", std::make_pair(TensorShape::CreateUnknownRankShape(), nullptr)});
+  std::unordered_map<std::string, int32_t> column_name_id_map = {{"col_2d", 0}, {"col_str", 1}, {"col_1d", 2}};
+
+  auto make_table = []() {
+    auto table = std::make_unique<TensorQTable>();
+    std::vector<std::vector<dsize_t>> shapes = {{2, 4}, {3, 1}, {1, 3}};
+    for (size_t i = 0; i < shapes.size(); i++) {
+      std::vector<int32_t> values(shapes[i][0] * shapes[i][1]);
+      for (size_t j = 0; j < values.size(); j++) {
+        values[j] = static_cast<int32_t>(i * 10 + j);
+      }
+      std::shared_ptr<Tensor> col_2d, col_str, col_1d;
+      EXPECT_OK(Tensor::CreateFromVector(values, TensorShape(shapes[i]), &col_2d));
+      EXPECT_OK(Tensor::CreateFromVector(std::vector<std::string>(i + 1, "a"), &col_str));
+      EXPECT_OK(Tensor::CreateFromVector(std::vector<int64_t>{static_cast<int64_t>(i), 1}, &col_1d));
+      table->emplace_back(TensorRow(static_cast<row_id_type>(i), {col_2d, col_str, col_1d}));
+    }
+    return table;
+  };
+
+  auto expected_table = make_table();
+  TensorRow expected;
+  ASSERT_OK(BatchOp::PadColumns(&expected_table, pad_info, column_name_id_map));
+  ASSERT_OK(BatchOp::BatchRows(&expected_table, &expected, expected_table->size()));
+
+  auto table = make_table();
+  TensorRow output;
+  ASSERT_OK(BatchOp::PadAndBatchRows(&table, &output, table->size(), pad_info, column_name_id_map));
+  ASSERT_EQ(output.size(), expected.size());
+  for (size_t i = 0; i < output.size(); i++) {
+    EXPECT_EQ(*output[i], *expected[i]);
+  }
+  EXPECT_EQ(output[0]->shape(), TensorShape({3, 3, 3}));
+  int32_t value = 0;
+  ASSERT_OK(output[0]->GetItemAt<int32_t>(&value, {0, 1, 2}));
+  EXPECT_EQ(value, 6);
+  ASSERT_OK(output[0]->GetItemAt<int32_t>(&value, {1, 2, 1}));
+  EXPECT_EQ(value, -1);
+}
+
+// Feature: Test the batch slots a MapOp hands its rows over to the Batch op with
+// Description: Copy the rows into the slots reserved in the order of the rows, across a partial batch and an epoch end
+// Expectation: The batch tensors taken from the slots should be equal to the rows padded and batched by the Batch op
+TEST_F(MindDataTestBatchOp, TestBatchSlots) {
+  MS_LOG(INFO) << "Doing MindDataTestBatchOp-TestBatchSlots.";
+  std::shared_ptr<Tensor> pad_value;
+  ASSERT_OK(Tensor::CreateScalar<float>(-1, &pad_value));
+  PadInfo pad_info;
+  pad_info.insert({"col_2d", std::make_pair(TensorShape({3, 3}), pad_value)});
+  std::unordered_map<std::string, int32_t> column_name_id_map = {{"col_2d", 0}, {"col_str", 1}, {"col_1d", 2}};
+  std::vector<SlotColumn> columns(column_name_id_map.size());
+  columns[0].enabled = true;
+  columns[0].padded = true;
+  columns[0].pad_shape = {3, 3};
+  columns[0].pad_val = -1;
+  columns[1].enabled = true;
+  columns[2].enabled = true;
+
+  auto make_row = [](size_t i, dsize_t len_1d) {
+    std::vector<dsize_t> shape = {static_cast<dsize_t>(i % 3 + 1), 2};
+    std::vector<int32_t> values(shape[0] * shape[1]);
+    for (size_t j = 0; j < values.size(); j++) {
+      values[j] = static_cast<int32_t>(i * 10 + j);
+    }
+    std::shared_ptr<Tensor> col_2d, col_str, col_1d;
+    EXPECT_OK(Tensor::CreateFromVector(values, TensorShape(shape), &col_2d));
+    EXPECT_OK(Tensor::CreateFromVector(std::vector<std::string>(1, "a"), &col_str));
+    EXPECT_OK(Tensor::CreateFromVector(std::vector<int64_t>(len_1d, static_cast<int64_t>(i)), &col_1d));
+    return TensorRow(static_cast<row_id_type>(i), {col_2d, col_str, col_1d});
+  };
+
+  // 3 rows in the first epoch make a full and a partial batch, the second epoch starts a new batch
+  const int32_t batch_size = 2;
+  std::vector<size_t> epoch_rows = {3, 2};
+  BatchSlots slots(batch_size, columns);
+  size_t i = 0;
+  for (size_t num_rows : epoch_rows) {
+    std::vector<std::shared_ptr<BatchBuffer>> buffers;
+    std::vector<std::unique_ptr<TensorQTable>> tables;
+    for (size_t r = 0; r < num_rows; r++, i++) {
+      std::shared_ptr<BatchBuffer> buffer;
+      dsize_t slot = 0;
+      ASSERT_OK(slots.Reserve(&buffer, &slot));
+      EXPECT_EQ(slot, static_cast<dsize_t>(r % batch_size));
+      if (slot == 0) {
+        buffers.push_back(buffer);
+        tables.push_back(std::make_unique<TensorQTable>());
+      }
+      TensorRow row = make_row(i, 2);
+      ASSERT_OK(buffer->Fill(slot, &row));
+      EXPECT_EQ(row[0], nullptr);
+      EXPECT_NE(row[1], nullptr);
+      EXPECT_EQ(row[2], nullptr);
+      tables.back()->push_back(std::move(row));
+    }
+    slots.EndEpoch();
+
+    size_t first = i - num_rows;
+    for (size_t b = 0; b < buffers.size(); b++) {
+      std::shared_ptr<BatchBuffer> popped;
+      ASSERT_OK(slots.Pop(&popped));
+      EXPECT_EQ(popped, buffers[b]);
+      TensorRow batched;
+      ASSERT_OK(popped->Take(tables[b].get(), &batched));
+      ASSERT_EQ(batched.size(), column_name_id_map.size());
+      EXPECT_EQ(batched[1], nullptr);
+
+      auto expected_table = std::make_unique<TensorQTable>();
+      for (size_t j = 0; j < tables[b]->size(); j++) {
+        expected_table->push_back(make_row(first + b * batch_size + j, 2));
+      }
+      TensorRow expected;
+      ASSERT_OK(BatchOp::PadAndBatchRows(&expected_table, &expected, expected_table->size(), pad_info,
+                                         column_name_id_map));
+      EXPECT_EQ(*batched[0], *expected[0]);
+      EXPECT_EQ(*batched[2], *expected[2]);
+    }
+  }
+  std::shared_ptr<BatchBuffer> buffer;
+  EXPECT_ERROR(slots.Pop(&buffer));
+
+  // a row that does not fit its slot keeps its tensor, the slot of the column is copied back into the other row
+  TensorQTable table;
+  for (dsize_t len_1d = 2; len_1d <= 3; len_1d++) {
+    dsize_t slot = 0;
+    ASSERT_OK(slots.Reserve(&buffer, &slot));
+    TensorRow row = make_row(i++, len_1d);
+    ASSERT_OK(buffer->Fill(slot, &row));
+    table.push_back(std::move(row));
+  }
+  EXPECT_EQ(table[0][2], nullptr);
+  EXPECT_NE(table[1][2], nullptr);
+  ASSERT_OK(slots.Pop(&buffer));
+  TensorRow batched;
+  ASSERT_OK(buffer->Take(&table, &batched));
+  EXPECT_EQ(batched[0]->shape(), TensorShape({batch_size, 3, 3}));
+  EXPECT_EQ(batched[2], nullptr);
+  ASSERT_NE(table[0][2], nullptr);
+  EXPECT_EQ(*table[0][2], *make_row(i - 2, 2)[2]);
+}
@@ -0,0 +1,187 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/common.h"
+#include "minddata/dataset/engine/datasetops/source/sampler/permutation_sampler.h"
+#include "minddata/dataset/engine/ir/datasetops/dataset_node.h"
+#include "minddata/dataset/engine/ir/datasetops/source/samplers/permutation_sampler_ir.h"
+#include "minddata/dataset/engine/ir/datasetops/source/image_folder_node.h"
+#include "minddata/dataset/engine/opt/pre/shuffle_pushdown_pass.h"
+#include "minddata/dataset/engine/tree_adapter.h"
+#include "minddata/dataset/include/dataset/samplers.h"
+#include "minddata/dataset/include/dataset/vision.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestShufflePushdownPass : public UT::DatasetOpTesting {
+ public:
+  class DummyRandomAccessOp : public RandomAccessOp {
+   public:
+    explicit DummyRandomAccessOp(uint64_t num_rows) { num_rows_ = num_rows; }
+  };
+
+  // drain one epoch of a sampler
+  static Status GetEpoch(SamplerRT *sampler, std::vector<int64_t> *out) {
+    TensorRow row;
+    RETURN_IF_NOT_OK(sampler->GetNextSample(&row));
+    while (!row.eoe()) {
+      for (const auto &t : row) {
+        for (auto it = t->begin<int64_t>(); it != t->end<int64_t>(); ++it) {
+          out->push_back(*it);
+        }
+      }
+      RETURN_IF_NOT_OK(sampler->GetNextSample(&row));
+    }
+    return Status::OK();
+  }
+};
+
+/// Feature: PermutationSampler
+/// Description: Test that every epoch of PermutationSampler is a permutation, reproducible and reshuffled on reset
+/// Expectation: Each id is sampled exactly once per epoch, the same seed gives the same order
+TEST_F(MindDataTestShufflePushdownPass, TestPermutationSampler) {
+  MS_LOG(INFO) << "Doing MindDataTestShufflePushdownPass-TestPermutationSampler.";
+  const int64_t num_rows = 1000;
+  DummyRandomAccessOp dummy_random_access_op(num_rows);
+  PermutationSamplerRT sampler(5, true, 0, 0, 64);
+  ASSERT_OK(sampler.HandshakeRandomAccessOp(&dummy_random_access_op));
+
+  std::vector<int64_t> first;
+  ASSERT_OK(GetEpoch(&sampler, &first));
+  ASSERT_EQ(first.size(), num_rows);
+  std::vector<bool> seen(num_rows, false);
+  int64_t num_fixed = 0;
+  for (int64_t i = 0; i < num_rows; i++) {
+    ASSERT_TRUE(first[i] >= 0 && first[i] < num_rows);
+    EXPECT_FALSE(seen[first[i]]);
+    seen[first[i]] = true;
+    num_fixed += static_cast<int64_t>(first[i] == i);
+  }
+  EXPECT_LT(num_fixed, num_rows / 10);
+
+  PermutationSamplerRT same_seed(5, true, 0, 0, 7);
+  ASSERT_OK(same_seed.HandshakeRandomAccessOp(&dummy_random_access_op));
+  std::vector<int64_t> again;
+  ASSERT_OK(GetEpoch(&same_seed, &again));
+  EXPECT_EQ(first, again);
+
+  ASSERT_OK(sampler.ResetSampler());
+  std::vector<int64_t> second;
+  ASSERT_OK(GetEpoch(&sampler, &second));
+  ASSERT_EQ(second.size(), num_rows);
+  EXPECT_NE(first, second);
+}
+
+/// Feature: PermutationSampler
+/// Description: Test PermutationSampler starting the first epoch from a non-zero position
+/// Expectation: The first epoch is the tail of the full permutation, the next epoch is complete
+TEST_F(MindDataTestShufflePushdownPass, TestPermutationSamplerStartIndex) {
+  MS_LOG(INFO) << "Doing MindDataTestShufflePushdownPass-TestPermutationSamplerStartIndex.";
+  const int64_t num_rows = 37;
+  const int64_t start_index = 10;
+  DummyRandomAccessOp dummy_random_access_op(num_rows);
+  PermutationSamplerRT full(0, false, 0, 0);
+  ASSERT_OK(full.HandshakeRandomAccessOp(&dummy_random_access_op));
+  std::vector<int64_t> expected;
+  ASSERT_OK(GetEpoch(&full, &expected));
+
+  PermutationSamplerRT resumed(0, false, start_index, 0);
+  ASSERT_OK(resumed.HandshakeRandomAccessOp(&dummy_random_access_op));
+  std::vector<int64_t> out;
+  ASSERT_OK(GetEpoch(&resumed, &out));
+  EXPECT_EQ(out, std::vector<int64_t>(expected.begin() + start_index, expected.end()));
+
+  ASSERT_OK(resumed.ResetSampler());
+  out.clear();
+  ASSERT_OK(GetEpoch(&resumed, &out));
+  EXPECT_EQ(out, expected);
+}
+
+/// Feature: PermutationSampler
+/// Description: Test PermutationSampler on an empty dataset, which replaces a SequentialSampler accepting it
+/// Expectation: Every epoch is empty instead of an error
+TEST_F(MindDataTestShufflePushdownPass, TestPermutationSamplerEmpty) {
+  MS_LOG(INFO) << "Doing MindDataTestShufflePushdownPass-TestPermutationSamplerEmpty.";
+  DummyRandomAccessOp dummy_random_access_op(0);
+  PermutationSamplerRT sampler(5, true, 0, 0, 64);
+  ASSERT_OK(sampler.HandshakeRandomAccessOp(&dummy_random_access_op));
+  for (int epoch = 0; epoch < 2; epoch++) {
+    std::vector<int64_t> out;
+    ASSERT_OK(GetEpoch(&sampler, &out));
+    EXPECT_TRUE(out.empty());
+    ASSERT_OK(sampler.ResetSampler());
+  }
+}
+
+/// Feature: ShufflePushdownPass
+/// Description: Test pushing a Shuffle through a Map into an ImageFolder read with a SequentialSampler
+/// Expectation: The Shuffle node is removed and the leaf samples with a PermutationSampler
+TEST_F(MindDataTestShufflePushdownPass, TestPushdownMappableSource) {
+  MS_LOG(INFO) << "Doing MindDataTestShufflePushdownPass-TestPushdownMappableSource.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>());
+  EXPECT_NE(ds, nullptr);
+  std::shared_ptr<TensorTransform> decode = std::make_shared<vision::Decode>();
+  ds = ds->Map({decode})->Shuffle(4)->Batch(2);
+  EXPECT_NE(ds, nullptr);
+
+  auto tree_adapter = std::make_shared<TreeAdapter>();
+  tree_adapter->SetOptimize(true);
+  ASSERT_OK(tree_adapter->Compile(ds->IRNode(), 1));
+
+  // Root -> Batch -> Map -> ImageFolder
+  std::shared_ptr<DatasetNode> node = tree_adapter->RootIRNode();
+  std::vector<std::string> names;
+  while (!node->Children().empty()) {
+    node = node->Children()[0];
+    names.push_back(node->Name());
+  }
+  EXPECT_EQ(names, (std::vector<std::string>{kBatchNode, kMapNode, kImageFolderNode}));
+  auto leaf = std::dynamic_pointer_cast<ImageFolderNode>(node);
+  ASSERT_NE(leaf, nullptr);
+  EXPECT_NE(std::dynamic_pointer_cast<PermutationSamplerObj>(leaf->Sampler()), nullptr);
+
+  // all the rows are still produced
+  uint64_t i = 0;
+  TensorRow row;
+  ASSERT_OK(tree_adapter->GetNext(&row));
+  while (!row.empty()) {
+    i++;
+    ASSERT_OK(tree_adapter->GetNext(&row));
+  }
+  EXPECT_EQ(i, 22);
+}
+
+/// Feature: ShufflePushdownPass
+/// Description: Test that the pass is not applied when the sampler does not read the whole dataset
+/// Expectation: The Shuffle node is kept
+TEST_F(MindDataTestShufflePushdownPass, TestNoPushdownPartialSampler) {
+  MS_LOG(INFO) << "Doing MindDataTestShufflePushdownPass-TestNoPushdownPartialSampler.";
+  std::string folder_path = datasets_root_path_ + "/testPK/data/";
+  std::shared_ptr<Dataset> ds = ImageFolder(folder_path, false, std::make_shared<SequentialSampler>(0, 10));
+  EXPECT_NE(ds, nullptr);
+  ds = ds->Shuffle(4);
+  EXPECT_NE(ds, nullptr);
+
+  auto tree_adapter = std::make_shared<TreeAdapter>();
+  tree_adapter->SetOptimize(true);
+  ASSERT_OK(tree_adapter->Compile(ds->IRNode(), 1));
+  std::shared_ptr<DatasetNode> node = tree_adapter->RootIRNode()->Children()[0];
+  EXPECT_EQ(node->Name(), kShuffleNode);
+}
@@ -0,0 +1,181 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <memory>
+#include <thread>
+#include <vector>
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/core/global_context.h"
+#include "minddata/dataset/core/tensor.h"
+#include "minddata/dataset/util/slab_pool.h"
+#include "minddata/dataset/util/system_pool.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestSlabPool : public UT::Common {
+ public:
+  MindDataTestSlabPool() = default;
+};
+
+/// Feature: SlabPool
+/// Description: Test rounding of requests to size classes
+/// Expectation: Sizes inside the range are rounded up to the next size class, others are left untouched
+TEST_F(MindDataTestSlabPool, TestRoundUp) {
+  int size_class = 0;
+  EXPECT_EQ(SlabPool::RoundUp(100, &size_class), 100);
+  EXPECT_EQ(size_class, -1);
+  EXPECT_EQ(SlabPool::RoundUp(4096, &size_class), 4096);
+  EXPECT_EQ(size_class, 0);
+  EXPECT_EQ(SlabPool::RoundUp(4097, &size_class), 5120);
+  EXPECT_EQ(size_class, 1);
+  EXPECT_EQ(SlabPool::RoundUp(8192, &size_class), 8192);
+  EXPECT_EQ(size_class, 4);
+  // a 224x224x3 uint8 image
+  EXPECT_EQ(SlabPool::RoundUp(150528, &size_class), 163840);
+  EXPECT_EQ(SlabPool::RoundUp(SlabPool::kMaxBlockSize, &size_class), SlabPool::kMaxBlockSize);
+  EXPECT_GT(size_class, 0);
+  EXPECT_EQ(SlabPool::RoundUp(SlabPool::kMaxBlockSize + 1, &size_class), SlabPool::kMaxBlockSize + 1);
+  EXPECT_EQ(size_class, -1);
+}
+
+/// Feature: SlabPool
+/// Description: Test freed blocks are recycled by the following requests of the same size class
+/// Expectation: The same block is returned and the counters are updated
+TEST_F(MindDataTestSlabPool, TestRecycle) {
+  auto pool = std::make_shared<SlabPool>(std::make_shared<SystemPool>(), 1048576);
+  void *p = nullptr;
+  ASSERT_OK(pool->Allocate(150000, &p));
+  memset(p, 0, 150000);
+  pool->Deallocate(p);
+  SlabPoolStats stats = pool->GetStats();
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_cached, 163840);
+
+  void *q = nullptr;
+  ASSERT_OK(pool->Allocate(150528, &q));
+  stats = pool->GetStats();
+  EXPECT_EQ(stats.num_allocations, 2);
+  // recycling only happens on the node the block was allocated from
+  if (stats.num_reused == 1) {
+    EXPECT_EQ(p, q);
+    EXPECT_EQ(stats.bytes_cached, 0);
+  }
+  pool->Deallocate(q);
+
+  // small requests are not cached
+  uint64_t cached = pool->GetStats().bytes_cached;
+  ASSERT_OK(pool->Allocate(64, &p));
+  pool->Deallocate(p);
+  EXPECT_EQ(pool->GetStats().bytes_cached, cached);
+
+  pool->Trim();
+  EXPECT_EQ(pool->GetStats().bytes_cached, 0);
+  MS_LOG(DEBUG) << *pool << std::endl;
+}
+
+/// Feature: SlabPool
+/// Description: Test the cached bytes are bounded by the capacity
+/// Expectation: Blocks beyond the capacity are released and shrinking the capacity releases cached blocks
+TEST_F(MindDataTestSlabPool, TestCapacity) {
+  const size_t block_size = 65536;
+  auto pool = std::make_shared<SlabPool>(std::make_shared<SystemPool>(), 4 * block_size);
+  std::vector<void *> blocks(8, nullptr);
+  for (auto &p : blocks) {
+    ASSERT_OK(pool->Allocate(block_size, &p));
+  }
+  EXPECT_EQ(pool->GetStats().bytes_in_use, 8 * block_size);
+  EXPECT_EQ(pool->GetStats().peak_bytes_in_use, 8 * block_size);
+  for (auto p : blocks) {
+    pool->Deallocate(p);
+  }
+  EXPECT_EQ(pool->GetStats().bytes_cached, 4 * block_size);
+  pool->SetCapacity(block_size);
+  EXPECT_EQ(pool->GetStats().bytes_cached, block_size);
+  pool->SetCapacity(0);
+  EXPECT_EQ(pool->GetStats().bytes_cached, 0);
+}
+
+/// Feature: SlabPool
+/// Description: Test Reallocate keeps the content of the block
+/// Expectation: The content is preserved when the block grows
+TEST_F(MindDataTestSlabPool, TestReallocate) {
+  auto pool = std::make_shared<SlabPool>(std::make_shared<SystemPool>(), 1048576);
+  void *p = nullptr;
+  ASSERT_OK(pool->Allocate(5000, &p));
+  auto *data = reinterpret_cast<int32_t *>(p);
+  for (int i = 0; i < 1000; ++i) {
+    data[i] = i;
+  }
+  // still fits in the 5120 bytes size class
+  ASSERT_OK(pool->Reallocate(&p, 5000, 5100));
+  EXPECT_EQ(p, data);
+  ASSERT_OK(pool->Reallocate(&p, 5000, 100000));
+  data = reinterpret_cast<int32_t *>(p);
+  for (int i = 0; i < 1000; ++i) {
+    ASSERT_EQ(data[i], i);
+  }
+  pool->Deallocate(p);
+}
+
+/// Feature: SlabPool
+/// Description: Test concurrent allocation and deallocation from several threads
+/// Expectation: All blocks are accounted for at the end
+TEST_F(MindDataTestSlabPool, TestMultiThread) {
+  auto pool = std::make_shared<SlabPool>(std::make_shared<SystemPool>(), 16 * 1048576);
+  const int num_threads = 4;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < num_threads; ++t) {
+    threads.emplace_back([pool, t]() {
+      for (int i = 0; i < 1000; ++i) {
+        void *p = nullptr;
+        size_t n = 4096 + (i % 7) * 10000 + t;
+        if (pool->Allocate(n, &p).IsOk()) {
+          memset(p, t, n);
+          pool->Deallocate(p);
+        }
+      }
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  SlabPoolStats stats = pool->GetStats();
+  EXPECT_EQ(stats.num_allocations, num_threads * 1000);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_GT(stats.num_reused, 0);
+}
+
+/// Feature: Tensor
+/// Description: Test tensors allocate from the tensor pool once it is enabled in the config
+/// Expectation: Freed tensor buffers are cached and the capacity follows the config
+TEST_F(MindDataTestSlabPool, TestTensorPool) {
+  auto config = GlobalContext::config_manager();
+  int32_t saved_size = config->tensor_pool_size();
+  config->set_tensor_pool_size(16);
+  auto pool = GlobalContext::Instance()->tensor_pool();
+  uint64_t allocations = pool->GetStats().num_allocations;
+  {
+    std::shared_ptr<Tensor> t;
+    ASSERT_OK(Tensor::CreateEmpty(TensorShape({224, 224, 3}), DataType(DataType::DE_UINT8), &t));
+    EXPECT_EQ(pool->GetStats().num_allocations, allocations + 1);
+  }
+  EXPECT_GT(pool->GetStats().bytes_cached, 0);
+  config->set_tensor_pool_size(0);
+  EXPECT_EQ(GlobalContext::Instance()->tensor_data_pool(), GlobalContext::Instance()->mem_pool());
+  EXPECT_EQ(pool->GetStats().bytes_cached, 0);
+  config->set_tensor_pool_size(saved_size);
+}
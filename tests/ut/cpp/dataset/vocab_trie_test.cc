@@ -0,0 +1,181 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <chrono>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/common.h"
+#include "gtest/gtest.h"
+#include "minddata/dataset/include/dataset/text.h"
+#include "minddata/dataset/text/kernels/wordpiece_tokenizer_op.h"
+#include "minddata/dataset/text/vocab_trie.h"
+#include "utils/log_adapter.h"
+
+using namespace mindspore::dataset;
+
+class MindDataTestVocabTrie : public UT::Common {
+ public:
+  // random lower case words, a third of them carry the WordPiece suffix indicator
+  static std::unordered_map<std::string, int32_t> RandomWords(int32_t num_words, uint32_t seed) {
+    std::mt19937 gen(seed);
+    std::uniform_int_distribution<int32_t> len_dist(1, 8);
+    std::uniform_int_distribution<int32_t> char_dist('a', 'z');
+    std::unordered_map<std::string, int32_t> words;
+    while (static_cast<int32_t>(words.size()) < num_words) {
+      std::string word = (gen() % 3 == 0) ? "##" : "";
+      int32_t len = len_dist(gen);
+      for (int32_t i = 0; i < len; ++i) {
+        word += static_cast<char>(char_dist(gen));
+      }
+      (void)words.emplace(word, static_cast<int32_t>(words.size()));
+    }
+    return words;
+  }
+};
+
+/// Feature: VocabTrie
+/// Description: Test exact lookup against the words used to build the trie
+/// Expectation: Every word maps to its id and unknown words map to kNoTokenExists
+TEST_F(MindDataTestVocabTrie, TestFind) {
+  MS_LOG(INFO) << "Doing MindDataTestVocabTrie-TestFind.";
+  auto words = RandomWords(5000, 1);
+  words["中国"] = static_cast<int32_t>(words.size());
+  VocabTrie trie(words);
+  for (const auto &[word, id] : words) {
+    EXPECT_EQ(trie.Find(word), id);
+  }
+  EXPECT_EQ(trie.Find("中"), Vocab::kNoTokenExists);
+  EXPECT_EQ(trie.Find("abcdefghijk"), Vocab::kNoTokenExists);
+  EXPECT_EQ(trie.Find(""), Vocab::kNoTokenExists);
+}
+
+/// Feature: VocabTrie
+/// Description: Test longest prefix matching from the root and from the suffix indicator state
+/// Expectation: The longest word ending on a character boundary is matched
+TEST_F(MindDataTestVocabTrie, TestLongestPrefix) {
+  MS_LOG(INFO) << "Doing MindDataTestVocabTrie-TestLongestPrefix.";
+  std::unordered_map<std::string, int32_t> words = {{"un", 0},  {"unaff", 1}, {"##able", 2},
+                                                    {"##a", 3}, {"中", 4},    {"##国人", 5}};
+  VocabTrie trie(words);
+  size_t match_len = 0;
+  EXPECT_EQ(trie.LongestPrefix(VocabTrie::kRootState, "unaffable", &match_len), 1);
+  EXPECT_EQ(match_len, 5);
+  EXPECT_EQ(trie.LongestPrefix(VocabTrie::kRootState, "unaf", &match_len), 0);
+  EXPECT_EQ(match_len, 2);
+  EXPECT_EQ(trie.LongestPrefix(VocabTrie::kRootState, "able", &match_len), Vocab::kNoTokenExists);
+  EXPECT_EQ(match_len, 0);
+
+  int32_t suffix_state = VocabTrie::kRootState;
+  ASSERT_TRUE(trie.Traverse("##", &suffix_state));
+  EXPECT_EQ(trie.LongestPrefix(suffix_state, "able", &match_len), 2);
+  EXPECT_EQ(match_len, 4);
+  EXPECT_EQ(trie.LongestPrefix(suffix_state, "国人们", &match_len), 5);
+  EXPECT_EQ(match_len, 6);
+  EXPECT_EQ(trie.LongestPrefix(VocabTrie::kRootState, "中国", &match_len), 4);
+  EXPECT_EQ(match_len, 3);
+}
+
+/// Feature: WordpieceTokenizer op
+/// Description: Test WordpieceTokenizerOp backed by the vocab trie
+/// Expectation: Output tokens and offsets are equal to the expected output
+TEST_F(MindDataTestVocabTrie, TestWordpieceTokenizer) {
+  MS_LOG(INFO) << "Doing MindDataTestVocabTrie-TestWordpieceTokenizer.";
+  std::shared_ptr<Vocab> vocab;
+  ASSERT_OK(Vocab::BuildFromVector({"my", "favor", "##ite", "book", "is", "lov", "##ing", "during"}, {"[UNK]"},
+                                   true, &vocab));
+  auto op = std::make_unique<WordpieceTokenizerOp>(vocab, "##", 100, "[UNK]", true);
+  std::shared_ptr<Tensor> input;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<std::string>{"my", "favorite", "book", "loving", "xyz"}, &input));
+  TensorRow output;
+  ASSERT_OK(op->Compute(TensorRow(0, {input}), &output));
+  std::shared_ptr<Tensor> expected;
+  ASSERT_OK(Tensor::CreateFromVector(
+    std::vector<std::string>{"my", "favor", "##ite", "book", "lov", "##ing", "[UNK]"}, &expected));
+  EXPECT_EQ(*output[0], *expected);
+  std::shared_ptr<Tensor> expected_start;
+  ASSERT_OK(Tensor::CreateFromVector(std::vector<uint32_t>{0, 0, 5, 0, 0, 3, 0}, &expected_start));
+  EXPECT_EQ(*output[1], *expected_start);
+}
+
+/// Feature: WordpieceTokenizer op
+/// Description: Measure tokenization throughput of the trie lookup against the per-prefix hash lookup
+/// Expectation: Both lookups agree on every token
+TEST_F(MindDataTestVocabTrie, TestWordpieceThroughput) {
+  MS_LOG(INFO) << "Doing MindDataTestVocabTrie-TestWordpieceThroughput.";
+  const int32_t num_words = 30000;
+  const int32_t num_tokens = 200000;
+  auto words = RandomWords(num_words, 2);
+  VocabTrie trie(words);
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int32_t> len_dist(4, 16);
+  std::uniform_int_distribution<int32_t> char_dist('a', 'z');
+  std::vector<std::string> tokens;
+  for (int32_t i = 0; i < num_tokens; ++i) {
+    std::string token;
+    int32_t len = len_dist(gen);
+    for (int32_t j = 0; j < len; ++j) {
+      token += static_cast<char>(char_dist(gen));
+    }
+    tokens.push_back(token);
+  }
+
+  // the substring + hash lookup used by WordpieceTokenizerOp before the trie
+  auto hash_lookup = [&words](const std::string &token, size_t start) {
+    for (size_t end = token.size(); end > start; --end) {
+      std::string word = token.substr(start, end - start);
+      if (start > 0) {
+        word = "##" + word;
+      }
+      if (words.find(word) != words.end()) {
+        return end;
+      }
+    }
+    return start;
+  };
+  int32_t suffix_state = VocabTrie::kRootState;
+  ASSERT_TRUE(trie.Traverse("##", &suffix_state));
+  auto trie_lookup = [&trie, suffix_state](const std::string &token, size_t start) {
+    size_t match_len = 0;
+    std::string_view remain(token.data() + start, token.size() - start);
+    (void)trie.LongestPrefix(start > 0 ? suffix_state : VocabTrie::kRootState, remain, &match_len);
+    return start + match_len;
+  };
+  auto run = [&tokens](const auto &lookup, std::vector<size_t> *ends) {
+    auto begin = std::chrono::steady_clock::now();
+    for (const auto &token : tokens) {
+      size_t start = 0;
+      size_t end = 0;
+      while (start < token.size() && (end = lookup(token, start)) > start) {
+        start = end;
+      }
+      ends->push_back(start);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+  };
+
+  std::vector<size_t> hash_ends;
+  std::vector<size_t> trie_ends;
+  double hash_time = run(hash_lookup, &hash_ends);
+  double trie_time = run(trie_lookup, &trie_ends);
+  EXPECT_EQ(hash_ends, trie_ends);
+  MS_LOG(INFO) << "Vocab of " << num_words << " words, trie states: " << trie.NumStates();
+  MS_LOG(INFO) << "Hash lookup: " << num_tokens / hash_time << " tokens/s, trie lookup: " << num_tokens / trie_time
+               << " tokens/s.";
+}
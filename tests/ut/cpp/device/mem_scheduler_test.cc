@@ -14,6 +14,9 @@
  * limitations under the License.
  */
 
+#include <chrono>
+#include <filesystem>
+#include <thread>
 #include <vector>
 #include <map>
 #include "common/common_test.h"
@@ -21,6 +24,7 @@
 namespace mindspore::device {
 constexpr size_t kDeviceMemSize = 5;
 constexpr size_t kMaxVirtualCount = 1024;
+constexpr char kFileOffloadDir[] = "./mem_offload_test";
 class MemoryManagerStub : public MemoryManager {
  public:
   MemoryManagerStub() {
@@ -81,6 +85,8 @@ class TestMemScheduler : public UT::Common {
  public:
   TestMemScheduler() {}
 
+  void TearDown() override { (void)std::filesystem::remove_all(kFileOffloadDir); }
+
  protected:
   size_t used_tensor_num_{1};
   size_t total_step_{1};
@@ -88,6 +94,8 @@ class TestMemScheduler : public UT::Common {
   std::vector<uint8_t> tensor_datas_;
   std::vector<size_t> init_tensors_;
   std::vector<std::vector<size_t>> step_used_tensors_;
+  // the compute time of each step in Run, which gives the async file io the time to finish
+  std::chrono::milliseconds step_time_{0};
 
   void Record(const std::shared_ptr<MemScheduler> &scheduler) {
     void *stream = nullptr;
@@ -118,6 +126,7 @@ class TestMemScheduler : public UT::Common {
         auto addr = scheduler->GetOrMalloc(tensor_keys_.data() + j, 1);
         ASSERT_NE(addr, nullptr);
       }
+      std::this_thread::sleep_for(step_time_);
       scheduler->PostCompute(stream);
     }
   }
@@ -235,6 +244,64 @@ TEST_F(TestMemScheduler, test_manual_mem_scheduler) {
   Run(scheduler);
 }
 
+/// Feature: FileMemoryOffload
+/// Description: Test FileMemoryOffload write and read interface
+/// Expectation: The data read from the file is the same as the data written
+TEST_F(TestMemScheduler, test_file_memory_offload) {
+  FileMemoryOffload file_offload(kFileOffloadDir);
+  const size_t mem_size = 16;
+  std::vector<uint8_t> data(mem_size, 0);
+  for (size_t i = 0; i < mem_size; ++i) {
+    data[i] = static_cast<uint8_t>(i);
+  }
+  std::vector<uint8_t> read_data(mem_size, 0);
+  const void *key = data.data();
+  file_offload.AsyncWrite(key, data.data(), mem_size);
+  file_offload.AsyncRead(key, read_data.data(), mem_size);
+  (void)file_offload.Wait(key);
+  ASSERT_TRUE(file_offload.IsFinished(key));
+  ASSERT_EQ(data, read_data);
+}
+
+/// Feature: MemScheduler
+/// Description: Test MemScheduler interface with the file tier and a host mem size less than the swapped out memory
+/// Expectation: MemScheduler GetOrMalloc return valid ptr
+TEST_F(TestMemScheduler, test_mem_scheduler_with_file_offload) {
+  MemSchedulerManager mem_scheduler_manager;
+  auto scheduler = mem_scheduler_manager.GetOrCreateMemScheduler(0);
+  ASSERT_NE(scheduler, nullptr);
+  std::shared_ptr<MemHandler> mem_handler = std::make_shared<MemHandler>(std::make_shared<MemoryManagerStub>());
+  scheduler->SetMemHandler(mem_handler);
+  scheduler->SetFileOffload(kFileOffloadDir, 1);
+
+  // input data
+  used_tensor_num_ = 8;
+  total_step_ = 10;
+  std::vector<uint8_t> tensor_keys(used_tensor_num_, 0);
+  std::vector<uint8_t> tensor_datas(used_tensor_num_, 0);
+  std::vector<size_t> init_tensors = {7};
+  std::vector<std::vector<size_t>> step_used_tensors = {{0, 1, 7}, {2, 3}, {4}, {5}, {6},
+                                                        {5, 6},    {0},    {1}, {2}, {3, 4, 7}};
+  tensor_keys_.swap(tensor_keys);
+  tensor_datas_.swap(tensor_datas);
+  init_tensors_.swap(init_tensors);
+  step_used_tensors_.swap(step_used_tensors);
+  scheduler->SetTotalStep(total_step_);
+
+  // record
+  Record(scheduler);
+  // optimize
+  ASSERT_TRUE(scheduler->Optimize());
+  // run twice, the second run uses the measured compute time
+  step_time_ = std::chrono::milliseconds(10);
+  Run(scheduler);
+  Run(scheduler);
+  // the memory beyond the host mem size goes through the files
+  ASSERT_GT(scheduler->statistics().file_write_size, 0);
+  ASSERT_GT(scheduler->statistics().file_read_size, 0);
+  scheduler->Clear();
+}
+
 /// Feature: MemScheduler
 /// Description: Test MemScheduler interface
 /// Expectation: MemScheduler GetOrMalloc return valid ptr
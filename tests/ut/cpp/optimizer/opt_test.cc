@@ -183,6 +183,59 @@ TEST_F(TestOptOpt, ConstantVariable) {
   ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({Qct_to_P})));
 }
 
+/// Feature: Primitive dispatch of the substitutions.
+/// Description: Apply a list of substitutions for other primitives, a substitution for any node and the substitutions
+/// for the primitives in the graphs.
+/// Expectation: The substitutions for the primitives are recorded and the graphs are transformed the same as before.
+TEST_F(TestOptOpt, PrimitiveDispatch) {
+  ASSERT_EQ(idempotent_P->prim_names_, std::vector<std::string>({"P"}));
+  auto any_node = MakeSubstitution(
+    std::make_shared<IdempotentEliminater>(), "any_node", [](const AnfNodePtr &) -> bool { return false; });
+  ASSERT_TRUE(any_node->prim_names_.empty());
+
+  FuncGraphPtr before = getPyFun.CallAndParseRet("test_idempotent", "before_2");
+  FuncGraphPtr after = getPyFun.CallAndParseRet("test_idempotent", "after");
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({elim_R, any_node, Qct_to_P, idempotent_P})));
+
+  before = getPyFun.CallAndParseRet("test_elim_r", "before_1");
+  after = getPyFun.CallAndParseRet("test_elim_r", "after");
+  ASSERT_TRUE(nullptr != before);
+  ASSERT_TRUE(nullptr != after);
+  ASSERT_TRUE(CheckOpt(before, after, std::vector<SubstitutionPtr>({idempotent_P, any_node, elim_R})));
+}
+
+/// Feature: Revisiting the nodes changed by the substitutions.
+/// Description: Apply idempotent_P and Qct_to_P to P(Q(1)) once in both traverse modes, where rewriting Q(1) to P(1)
+/// makes its user P(P(1)) a new match of idempotent_P, which was tried on it before.
+/// Expectation: The new match is transformed in the same run, giving P(1), and the recorded statistics count one hit
+/// of each substitution.
+TEST_F(TestOptOpt, NewMatchAtUserNode) {
+  for (bool global_sensitive : {false, true}) {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto q_node = func_graph->NewCNode({NewValueNode(Q), NewValueNode(static_cast<int64_t>(1))});
+    func_graph->set_output(func_graph->NewCNode({NewValueNode(P), q_node}));
+    // global_sensitive makes the list traverse from the substitutions to the IR.
+    SubstitutionList transform(std::vector<SubstitutionPtr>({idempotent_P, Qct_to_P}), false, global_sensitive);
+    OptimizerPtr optimizer = std::make_shared<Optimizer>("ut_test", std::make_shared<pipeline::Resource>());
+    ASSERT_TRUE(transform(func_graph, optimizer));
+
+    auto output = func_graph->output();
+    ASSERT_TRUE(IsPrimitiveCNode(output, P));
+    ASSERT_TRUE(output->cast<CNodePtr>()->input(1)->isa<ValueNode>());
+    const auto &stats = transform.last_stats();
+    ASSERT_EQ(stats.size(), 2);
+    ASSERT_EQ(stats[0].hits, 1);
+    ASSERT_GE(stats[0].attempts, 2);
+    ASSERT_EQ(stats[1].hits, 1);
+    ASSERT_EQ(stats[1].attempts, 1);
+    ASSERT_GE(stats[0].cost, 0);
+    ASSERT_GE(stats[1].cost, 0);
+    ASSERT_GE(transform.last_cost(), stats[0].cost + stats[1].cost);
+  }
+}
+
 TEST_F(TestOptOpt, CSE) {
   // test a simple cse testcase test_f1
   FuncGraphPtr test_graph1 = getPyFun.CallAndParseRet("test_cse", "test_f1");
@@ -0,0 +1,96 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <string>
+#include <vector>
+#include "common/common_test.h"
+#include "ir/graph_utils.h"
+#define private public
+#include "frontend/parallel/graph_util/graph_splitter.h"
+#undef private
+
+namespace mindspore {
+namespace parallel {
+namespace {
+constexpr size_t kNodeNum = 512;
+constexpr size_t kNodeNumPerLabel = 7;
+}  // namespace
+
+class TestGraphSplitter : public UT::Common {
+ public:
+  TestGraphSplitter() {}
+  void SetUp() {}
+  void TearDown() {}
+
+  // A chain of Add nodes, with the labels of a worker and two servers changing every few nodes.
+  FuncGraphPtr MakeLabeledGraph() const {
+    auto func_graph = std::make_shared<FuncGraph>();
+    auto x = func_graph->add_parameter();
+    auto y = func_graph->add_parameter();
+    AnfNodePtr last = x;
+    for (size_t i = 0; i < kNodeNum; ++i) {
+      auto prim = std::make_shared<Primitive>("Add");
+      const size_t label_index = (i / kNodeNumPerLabel) % 3;
+      if (label_index != 0) {
+        prim->set_attr(distributed::kOpLabelRankId, MakeValue(static_cast<int64_t>(label_index - 1)));
+        prim->set_attr(distributed::kOpLabelRole, MakeValue(std::string(distributed::kEnvRoleOfPServer)));
+      }
+      last = func_graph->NewCNode({NewValueNode(prim), last, (i % 2 == 0) ? y : x});
+    }
+    func_graph->set_output(last);
+    return func_graph;
+  }
+};
+
+/// Feature: the graph splitter which dyes the graph and finds the inputs to split concurrently.
+/// Description: dye a graph of 512 labeled nodes and find the inputs to split of all the nodes.
+/// Expectation: the labels and the inputs to split are exactly the same as the ones found node by node serially.
+TEST_F(TestGraphSplitter, TestConcurrentDyeGraph) {
+  auto func_graph = MakeLabeledGraph();
+  GraphSplitter splitter(func_graph, 0, distributed::kEnvRoleOfPServer);
+  splitter.DyeGraph();
+
+  std::vector<AnfNodePtr> all_nodes = DeepScopedGraphSearch(func_graph->get_return());
+  ASSERT_EQ(splitter.node_labels_.size(), all_nodes.size());
+  size_t split_label_num = 0;
+  for (const auto &node : all_nodes) {
+    OperatorLabel expected = splitter.default_label_;
+    if (node->isa<CNode>()) {
+      expected = splitter.GetSplitLabel(node);
+    }
+    if (splitter.this_process_label_.LooseEqual(expected)) {
+      expected = splitter.this_process_label_;
+    }
+    ASSERT_EQ(splitter.node_labels_.count(node), 1);
+    ASSERT_TRUE(splitter.node_labels_[node] == expected);
+    split_label_num += (expected != splitter.default_label_) ? 1 : 0;
+  }
+  ASSERT_GT(split_label_num, 0);
+
+  const auto &split_inputs = splitter.FindAllInputsToSplit(all_nodes);
+  ASSERT_EQ(split_inputs.size(), all_nodes.size());
+  size_t split_input_num = 0;
+  for (size_t i = 0; i < all_nodes.size(); ++i) {
+    std::vector<size_t> expected;
+    if (all_nodes[i]->isa<CNode>()) {
+      expected = splitter.FindInputsToSplit(all_nodes[i]->cast<CNodePtr>());
+    }
+    ASSERT_EQ(split_inputs[i], expected);
+    split_input_num += expected.size();
+  }
+  ASSERT_GT(split_input_num, 0);
+}
+}  // namespace parallel
+}  // namespace mindspore
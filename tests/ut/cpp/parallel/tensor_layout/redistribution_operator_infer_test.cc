@@ -18,6 +18,7 @@
 #include "common/py_func_graph_fetcher.h"
 #include "frontend/parallel/tensor_layout/redistribution_operator_infer.h"
 #include "frontend/parallel/device_manager.h"
+#include "include/common/utils/parallel_context.h"
 #include "util_layout_gen_test.h"
 
 namespace mindspore {
@@ -107,5 +108,33 @@ TEST_F(TestRedistributionOperatorInfer, TestInferOperatorAll) {
   ASSERT_EQ(status, Status::SUCCESS);
 }
 
+/// Feature: AllToAll in the tensor redistribution.
+/// Description: move the split of a tensor from the first axis to the second one on 2, 4 and 8 devices with
+///              AllToAll enabled.
+/// Expectation: the redistribution is a single PermuteByAxis whatever the number of devices.
+TEST_F(TestRedistributionOperatorInfer, TestInferPermuteByAxisWithAllToAll) {
+  auto parallel_context = ParallelContext::GetInstance();
+  bool enable_all2all = parallel_context->enable_all2all();
+  parallel_context->set_enable_all2all(true);
+  for (int64_t dev_num : {2, 4, 8}) {
+    RankList dev_list;
+    for (int64_t i = 0; i < dev_num; i++) {
+      dev_list.push_back(i);
+    }
+    TensorLayout layout;
+    ASSERT_EQ(layout.InitFromVector({dev_num}, {0, -1}, {64, 64}), Status::SUCCESS);
+    Map out_tensor_map;
+    ASSERT_EQ(out_tensor_map.Init({-1, 0}), Status::SUCCESS);
+    RedistributionOperatorInfer operator_infer;
+    ASSERT_EQ(operator_infer.Init(layout, out_tensor_map, dev_list), Status::SUCCESS);
+    ASSERT_EQ(operator_infer.InferRedistributionOperator(), Status::SUCCESS);
+    OperatorList operator_list = operator_infer.operator_list();
+    ASSERT_EQ(operator_list.size(), 1);
+    ASSERT_EQ(operator_list[0].first.first, PERMUTE_BY_AXIS);
+    InferOperatorCheck({0, -1}, {-1, 0}, operator_list);
+  }
+  parallel_context->set_enable_all2all(enable_all2all);
+}
+
 }  // namespace parallel
 }  // namespace mindspore
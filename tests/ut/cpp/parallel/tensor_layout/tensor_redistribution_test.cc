@@ -206,5 +206,31 @@ TEST_F(TestTensorRedistribution, TestInferRedistribution3) {
   ASSERT_EQ(op_names, expected_op_names);
 }
 
+/// Feature: Memoized cost of the tensor redistribution.
+/// Description: Compute the cost of the same redistribution twice, the second one is got from the cost cache.
+/// Expectation: The costs and the operators are the same as the ones computed without the cache.
+TEST_F(TestTensorRedistribution, TestComputeCostCache) {
+  TensorLayout from_layout;
+  ASSERT_EQ(Status::SUCCESS, from_layout.InitFromVector({2, 4, 2}, {2, 0}, {512, 1024}));
+  TensorLayout to_layout;
+  ASSERT_EQ(Status::SUCCESS, to_layout.InitFromVector({4, 2, 2}, {2, 1}, {512, 1024}));
+  RankList dev_list = g_device_manager->GetDeviceListByStageId(0);
+
+  TensorRedistribution::ClearCostCache();
+  TensorRedistribution computed(false, false);
+  ASSERT_EQ(Status::SUCCESS, computed.Init(from_layout, to_layout, dev_list));
+  ASSERT_EQ(Status::SUCCESS, computed.ComputeCost());
+  TensorRedistribution cached(false, false);
+  ASSERT_EQ(Status::SUCCESS, cached.Init(from_layout, to_layout, dev_list));
+  ASSERT_EQ(Status::SUCCESS, cached.ComputeCost());
+  ASSERT_EQ(computed.operator_list().size(), cached.operator_list().size());
+  ASSERT_EQ(computed.reshape_flag(), cached.reshape_flag());
+  ASSERT_DOUBLE_EQ(computed.comm_cost(), cached.comm_cost());
+  ASSERT_DOUBLE_EQ(computed.forward_comm_cost(), cached.forward_comm_cost());
+  ASSERT_DOUBLE_EQ(computed.backward_comm_cost(), cached.backward_comm_cost());
+  ASSERT_DOUBLE_EQ(computed.computation_cost(), cached.computation_cost());
+  ASSERT_DOUBLE_EQ(computed.memory_cost(), cached.memory_cost());
+  TensorRedistribution::ClearCostCache();
+}
 }  // namespace parallel
 }  // namespace mindspore
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <cstdio>
+#include <memory>
+#include <string>
+
+#include "common/common_test.h"
+#include "pipeline/jit/static_analysis/persistent_eval_cache.h"
+#include "ir/tensor.h"
+
+namespace mindspore {
+namespace abstract {
+class TestPersistentEvalCache : public UT::Common {
+ public:
+  void SetUp() override { (void)std::remove(kCacheFile); }
+  void TearDown() override { (void)std::remove(kCacheFile); }
+
+  static constexpr char kCacheFile[] = "./persistent_eval_cache_test.bin";
+};
+
+/// Feature: Persistent primitive eval cache.
+/// Description: Put the infer result of a primitive, flush it and get it by another cache of the same file.
+/// Expectation: The result is the same as the one put, and the args with values of tensors can not be persisted.
+TEST_F(TestPersistentEvalCache, test_flush_and_get) {
+  mindspore::HashMap<std::string, ValuePtr> attrs{{"axis", MakeValue<int64_t>(1)}, {"keep_dims", MakeValue(false)}};
+  AbstractBasePtrList args{std::make_shared<AbstractTensor>(kFloat32, ShapeVector{2, 3}),
+                           std::make_shared<AbstractScalar>(static_cast<int64_t>(1))};
+  auto key = PersistentPrimEvalCache::BuildKey("ReduceSum", attrs, args);
+  ASSERT_FALSE(key.empty());
+  AbstractBasePtrList elements{std::make_shared<AbstractTensor>(kFloat32, ShapeVector{2}),
+                               std::make_shared<AbstractScalar>(1.5f), std::make_shared<AbstractNone>()};
+  auto result = std::make_shared<AbstractTuple>(elements);
+  {
+    PersistentPrimEvalCache cache(kCacheFile);
+    ASSERT_EQ(cache.Get(key), nullptr);
+    cache.Put(key, result);
+    cache.Flush();
+  }
+  PersistentPrimEvalCache cache(kCacheFile);
+  auto cached = cache.Get(key);
+  ASSERT_NE(cached, nullptr);
+  ASSERT_TRUE(*cached == *result);
+  ASSERT_EQ(cache.Get(PersistentPrimEvalCache::BuildKey("ReduceMean", attrs, args)), nullptr);
+
+  auto tensor = std::make_shared<tensor::Tensor>(kNumberTypeFloat32, ShapeVector{2, 3});
+  AbstractBasePtrList const_args{tensor->ToAbstract(), args[1]};
+  ASSERT_TRUE(PersistentPrimEvalCache::BuildKey("ReduceSum", attrs, const_args).empty());
+}
+}  // namespace abstract
+}  // namespace mindspore
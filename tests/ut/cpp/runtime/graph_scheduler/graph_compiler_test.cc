@@ -114,6 +114,23 @@ public:
 class GraphCompilerTest : public UT::Common {
 public:
  GraphCompilerTest() {}
+
+ // The segment of sub(add(x, y), x), or of mul(add(x, y), x) if 'mul' is true.
+ GraphSegmentPtr MakeSegment(bool mul, AnfNodePtrList *outputs) {
+   std::vector<int64_t> shp{2, 2};
+   auto func_graph = std::make_shared<FuncGraph>();
+   auto parameter_x = func_graph->add_parameter();
+   parameter_x->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+   auto parameter_y = func_graph->add_parameter();
+   parameter_y->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+   auto add_node = func_graph->NewCNode({NewValueNode(prim::kPrimAdd), parameter_x, parameter_y});
+   add_node->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+   auto out_node = func_graph->NewCNode({NewValueNode(mul ? prim::kPrimMul : prim::kPrimSub), add_node, parameter_x});
+   out_node->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, shp));
+   func_graph->set_return(func_graph->NewCNode({NewValueNode(prim::kPrimReturn), out_node}));
+   *outputs = {out_node};
+   return std::make_shared<GraphSegment>(std::vector<AnfNodePtr>{add_node, out_node}, false);
+ }
 };
 
 /// Feature: control flow support dynamic shape.
@@ -170,5 +187,48 @@ TEST_F(GraphCompilerTest, CompileGraph) {
  const auto &kernel_graph = compiler->Fetch(graph_id);
  ASSERT_EQ(2, kernel_graph->execution_order().size());
 }
+
+/// Feature: compile the kernel graphs of the segments concurrently.
+/// Description: Compile three identical segments and a different one concurrently with the kernels shared, then
+/// compile another identical segment.
+/// Expectation: The kernels of the first identical graph are created and shared by the other identical graphs, also by
+/// the one compiled later, while the different graph has its own kernels. All the graphs finish compiling.
+TEST_F(GraphCompilerTest, CompileSameGraphsConcurrently) {
+ auto compiler = std::make_shared<GraphCompiler>();
+ DeviceContextKey device_context_key{"CPU", 0};
+ auto device_context = std::make_shared<TestADeviceContext>(device_context_key);
+ std::vector<std::pair<KernelGraphPtr, const DeviceContext *>> graphs;
+ std::vector<AnfNodePtrList> outputs(5);
+ for (size_t i = 0; i < outputs.size(); ++i) {
+   auto segment = MakeSegment(i == 1, &outputs[i]);
+   auto graph = compiler->ConstructKernelGraph(segment, outputs[i], device_context.get(), device::RunMode::kKernelMode);
+   ASSERT_NE(graph, nullptr);
+   graphs.emplace_back(graph, device_context.get());
+ }
+ auto later_graph = graphs.back();
+ graphs.pop_back();
+ ASSERT_EQ(compiler->OptimizeGraphsAndCreateKernels(graphs, true), 2);
+ ASSERT_EQ(compiler->OptimizeGraphsAndCreateKernels({later_graph}, true), 1);
+ graphs.push_back(later_graph);
+
+ const auto &first_nodes = graphs[0].first->execution_order();
+ ASSERT_EQ(first_nodes.size(), 2);
+ for (size_t i = 1; i < graphs.size(); ++i) {
+   const auto &nodes = graphs[i].first->execution_order();
+   ASSERT_EQ(nodes.size(), first_nodes.size());
+   for (size_t j = 0; j < nodes.size(); ++j) {
+     ASSERT_NE(AnfAlgo::GetKernelMod(nodes[j]), nullptr);
+     if (i == 1) {
+       ASSERT_NE(AnfAlgo::GetKernelMod(nodes[j]), AnfAlgo::GetKernelMod(first_nodes[j]));
+     } else {
+       ASSERT_EQ(AnfAlgo::GetKernelMod(nodes[j]), AnfAlgo::GetKernelMod(first_nodes[j]));
+     }
+   }
+ }
+ for (size_t i = 0; i < graphs.size(); ++i) {
+   auto graph_id = compiler->FinishCompileGraph(graphs[i].first, outputs[i], device_context.get());
+   ASSERT_EQ(compiler->Fetch(graph_id), graphs[i].first);
+ }
+}
 }  // namespace runtime
 }  // namespace mindspore
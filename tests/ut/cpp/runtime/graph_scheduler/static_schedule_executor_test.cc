@@ -0,0 +1,256 @@
+/**
+ * Copyright 2022 Huawei Technologies Co., Ltd
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include "common/common_test.h"
+#include "backend/common/session/kernel_graph.h"
+#include "backend/common/session/anf_runtime_algorithm.h"
+#include "include/common/utils/anfalgo.h"
+#include "runtime/device/kernel_info.h"
+#include "runtime/graph_scheduler/static_schedule_executor.h"
+
+namespace mindspore {
+namespace runtime {
+using DeviceAddress = device::DeviceAddress;
+using DeviceAddressPtr = device::DeviceAddressPtr;
+using DeviceContextKey = device::DeviceContextKey;
+using DeviceType = device::DeviceType;
+using KernelBuildInfoBuilder = kernel::KernelBuildInfo::KernelBuildInfoBuilder;
+
+class StaticScheduleDeviceAddress : public DeviceAddress {
+ public:
+  StaticScheduleDeviceAddress(void *ptr, size_t size) : DeviceAddress(ptr, size) {}
+  ~StaticScheduleDeviceAddress() override = default;
+  bool SyncDeviceToHost(const ShapeVector &shape, size_t size, TypeId type, void *host_ptr) const override {
+    return true;
+  }
+  bool SyncHostToDevice(const ShapeVector &shape, size_t size, TypeId type, const void *host_ptr,
+                        const std::string &format) const override {
+    return true;
+  }
+  void ClearDeviceMemory() override {}
+};
+
+// Write the sum of the float inputs to the output.
+class StaticScheduleAddKernelMod : public kernel::KernelMod {
+ public:
+  StaticScheduleAddKernelMod() = default;
+  ~StaticScheduleAddKernelMod() override = default;
+  bool Launch(const std::vector<AddressPtr> &inputs, const std::vector<AddressPtr> &workspace,
+              const std::vector<AddressPtr> &outputs, void *stream_ptr) override {
+    auto output = static_cast<float *>(outputs[0]->addr);
+    for (size_t i = 0; i < outputs[0]->size / sizeof(float); ++i) {
+      output[i] = 0;
+      for (const auto &input : inputs) {
+        output[i] += static_cast<float *>(input->addr)[i];
+      }
+    }
+    return true;
+  }
+};
+
+class StaticScheduleDeviceResManager : public device::DeviceResManager {
+ public:
+  StaticScheduleDeviceResManager() = default;
+  ~StaticScheduleDeviceResManager() override = default;
+  void *AllocateMemory(size_t size) const override { return malloc(size); }
+  void FreeMemory(void *ptr) const override { free(ptr); }
+};
+
+class StaticScheduleKernelExecutor : public device::KernelExecutor {
+ public:
+  StaticScheduleKernelExecutor() = default;
+  ~StaticScheduleKernelExecutor() override = default;
+  bool LaunchKernel(const CNodePtr &kernel, const std::vector<AddressPtr> &inputs,
+                    const std::vector<AddressPtr> &workspace, const std::vector<AddressPtr> &outputs) const override {
+    auto kernel_mod = AnfAlgo::GetKernelMod(kernel);
+    MS_EXCEPTION_IF_NULL(kernel_mod);
+    return kernel_mod->Launch(inputs, workspace, outputs, nullptr);
+  }
+};
+
+class StaticScheduleDeviceContext
+    : public device::DeviceInterface<StaticScheduleKernelExecutor, StaticScheduleDeviceResManager> {
+ public:
+  explicit StaticScheduleDeviceContext(const DeviceContextKey &device_context_key)
+      : DeviceInterface(device_context_key) {}
+  ~StaticScheduleDeviceContext() override = default;
+  void Initialize() override {}
+  DeviceType GetDeviceType() const override { return DeviceType::kCPU; }
+  device::RunMode GetRunMode(const FuncGraphPtr &func_graph) const override { return device::RunMode::kKernelMode; }
+};
+
+class StaticScheduleExecutorTest : public UT::Common {
+ public:
+  StaticScheduleExecutorTest() {}
+
+ protected:
+  static constexpr size_t kElementNum = 4;
+  static constexpr size_t kTensorSize = kElementNum * sizeof(float);
+
+  ParameterPtr NewInput(const KernelGraphPtr &graph, std::vector<float> *data) {
+    auto parameter = graph->add_parameter();
+    parameter->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{kElementNum}));
+    parameter->set_kernel_info(std::make_shared<device::KernelInfo>());
+    AnfAlgo::SetOutputAddr(std::make_shared<StaticScheduleDeviceAddress>(data->data(), kTensorSize), 0,
+                           parameter.get());
+    graph->MutableInputs()->push_back(parameter);
+    return parameter;
+  }
+
+  CNodePtr NewKernel(const KernelGraphPtr &graph, const PrimitivePtr &prim, const std::vector<AnfNodePtr> &inputs) {
+    std::vector<AnfNodePtr> node_inputs{NewValueNode(prim)};
+    (void)node_inputs.insert(node_inputs.end(), inputs.begin(), inputs.end());
+    auto kernel = graph->NewCNode(node_inputs);
+    kernel->set_abstract(std::make_shared<abstract::AbstractTensor>(kFloat32, ShapeVector{kElementNum}));
+    auto kernel_info = std::make_shared<device::KernelInfo>();
+    KernelBuildInfoBuilder builder;
+    builder.SetOutputsFormat({kOpFormat_DEFAULT});
+    builder.SetOutputsDeviceType({kNumberTypeFloat32});
+    kernel_info->set_select_kernel_build_info(builder.Build());
+    kernel_info->set_kernel_mod(std::make_shared<StaticScheduleAddKernelMod>());
+    kernel->set_kernel_info(kernel_info);
+    AnfAlgo::SetOutputAddr(std::make_shared<StaticScheduleDeviceAddress>(nullptr, kTensorSize), 0, kernel.get());
+    return kernel;
+  }
+};
+
+/// Feature: static schedule of CPU kernel graphs.
+/// Description: Plan a diamond of kernels.
+/// Expectation: The two branches are in the same wavefront, between the producer and the consumer.
+TEST_F(StaticScheduleExecutorTest, TestDiamondWavefronts) {
+  StaticSchedulePlanner planner;
+  auto input = planner.AddBuffer(16, true);
+  auto a = planner.AddBuffer(16, false);
+  auto b = planner.AddBuffer(16, false);
+  auto c = planner.AddBuffer(16, false);
+  auto output = planner.AddBuffer(16, true);
+  planner.AddKernel({input}, {a}, {});
+  planner.AddKernel({a}, {b}, {});
+  planner.AddKernel({a}, {c}, {});
+  planner.AddKernel({b, c}, {output}, {});
+  planner.Plan();
+
+  std::vector<std::vector<size_t>> expect{{0}, {1, 2}, {3}};
+  ASSERT_EQ(planner.wavefronts(), expect);
+  // b and c are alive together and a is read while they are written.
+  ASSERT_NE(planner.offset(a), planner.offset(b));
+  ASSERT_NE(planner.offset(a), planner.offset(c));
+  ASSERT_NE(planner.offset(b), planner.offset(c));
+}
+
+/// Feature: static schedule of CPU kernel graphs.
+/// Description: Plan a chain of kernels.
+/// Expectation: The buffers whose wavefronts don't overlap share the same memory.
+TEST_F(StaticScheduleExecutorTest, TestChainMemoryReuse) {
+  StaticSchedulePlanner planner;
+  auto input = planner.AddBuffer(100, true);
+  auto a = planner.AddBuffer(100, false);
+  auto b = planner.AddBuffer(100, false);
+  auto c = planner.AddBuffer(100, false);
+  auto output = planner.AddBuffer(100, true);
+  planner.AddKernel({input}, {a}, {});
+  planner.AddKernel({a}, {b}, {});
+  planner.AddKernel({b}, {c}, {});
+  planner.AddKernel({c}, {output}, {});
+  planner.Plan();
+
+  ASSERT_EQ(planner.wavefronts().size(), 4);
+  ASSERT_EQ(planner.offset(a), planner.offset(c));
+  ASSERT_NE(planner.offset(a), planner.offset(b));
+  // Two buffers of 100 bytes, each aligned to 128 bytes.
+  ASSERT_EQ(planner.arena_size(), 256);
+}
+
+/// Feature: static schedule of CPU kernel graphs.
+/// Description: Plan a kernel updating a parameter read by a previous kernel, and an independent kernel.
+/// Expectation: The update is after the read, the independent kernel is in the first wavefront.
+TEST_F(StaticScheduleExecutorTest, TestWriteAfterRead) {
+  StaticSchedulePlanner planner;
+  auto parameter = planner.AddBuffer(16, true);
+  auto other = planner.AddBuffer(16, true);
+  auto a = planner.AddBuffer(16, false);
+  auto b = planner.AddBuffer(16, false);
+  planner.AddKernel({parameter}, {a}, {});
+  planner.AddKernel({parameter, a}, {parameter}, {});
+  planner.AddKernel({other}, {b}, {});
+  planner.Plan();
+
+  std::vector<std::vector<size_t>> expect{{0, 2}, {1}};
+  ASSERT_EQ(planner.wavefronts(), expect);
+  ASSERT_TRUE(planner.is_persistent(parameter));
+  ASSERT_FALSE(planner.is_persistent(a));
+}
+
+/// Feature: static schedule of CPU kernel graphs.
+/// Description: Plan two independent kernels with workspaces.
+/// Expectation: The workspaces of the kernels of a wavefront don't overlap, and are reused by the next wavefront.
+TEST_F(StaticScheduleExecutorTest, TestWorkspaces) {
+  StaticSchedulePlanner planner;
+  auto input = planner.AddBuffer(64, true);
+  auto a = planner.AddBuffer(64, false);
+  auto b = planner.AddBuffer(64, false);
+  auto output = planner.AddBuffer(64, true);
+  auto workspace_a = planner.AddBuffer(1024, false);
+  auto workspace_b = planner.AddBuffer(1024, false);
+  auto workspace_c = planner.AddBuffer(1024, false);
+  planner.AddKernel({input}, {a}, {workspace_a});
+  planner.AddKernel({input}, {b}, {workspace_b});
+  planner.AddKernel({a, b}, {output}, {workspace_c});
+  planner.Plan();
+
+  ASSERT_EQ(planner.wavefronts().size(), 2);
+  ASSERT_NE(planner.offset(workspace_a), planner.offset(workspace_b));
+  // a, b and the two workspaces of the first wavefront, the last workspace reuses one of the first ones.
+  ASSERT_EQ(planner.arena_size(), 2 * 1024 + 2 * 64);
+}
+
+/// Feature: static schedule of CPU kernel graphs.
+/// Description: Run a graph whose kernel reads the output of a skipped inplace kernel.
+/// Expectation: Like the kernel actors, the kernel reads the output of the real kernel before the skipped one.
+TEST_F(StaticScheduleExecutorTest, TestSkippedKernelInput) {
+  auto graph = std::make_shared<session::KernelGraph>();
+  std::vector<float> x_data{1, 2, 3, 4};
+  std::vector<float> y_data{10, 20, 30, 40};
+  auto x = NewInput(graph, &x_data);
+  auto y = NewInput(graph, &y_data);
+  auto add = std::make_shared<Primitive>("Add");
+  auto skip = std::make_shared<Primitive>("Add");
+  skip->AddAttr("skip", MakeValue(true));
+  // a = x + y, the skipped kernel s shares the memory of a, b = s + x.
+  auto a = NewKernel(graph, add, {x, y});
+  auto s = NewKernel(graph, skip, {a, y});
+  auto b = NewKernel(graph, add, {s, x});
+  graph->set_output(b);
+  graph->set_execution_order({a, s, b});
+
+  DeviceContextKey device_context_key{"CPU", 0};
+  auto device_context = std::make_shared<StaticScheduleDeviceContext>(device_context_key);
+  auto executor = std::make_unique<StaticScheduleExecutor>(graph, device_context.get());
+  executor->Compile();
+  // a and b, the skipped kernel is not launched.
+  ASSERT_EQ(executor->planner().wavefronts().size(), 2);
+  ASSERT_TRUE(executor->Run());
+
+  auto output_address = AnfAlgo::GetMutableOutputAddr(b, 0, false);
+  ASSERT_NE(output_address->GetPtr(), nullptr);
+  auto output = static_cast<float *>(output_address->GetMutablePtr());
+  std::vector<float> expect{12, 24, 36, 48};
+  ASSERT_EQ(std::vector<float>(output, output + kElementNum), expect);
+  device_context->device_res_manager_->FreeMemory(output_address.get());
+}
+}  // namespace runtime
+}  // namespace mindspore
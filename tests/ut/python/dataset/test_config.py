@@ -459,6 +459,30 @@ def test_multiprocessing_timeout_interval():
     assert saved_config == ds.config.get_multiprocessing_timeout_interval()
 
 
+def test_tensor_pool_size():
+    """
+    Feature: Test the function of get_tensor_pool_size and set_tensor_pool_size.
+    Description: Enable the tensor pool and run a pipeline with it, then disable it again.
+    Expectation: The default size is 0, the pipeline output is not affected by the pool.
+    """
+    saved_config = ds.config.get_tensor_pool_size()
+    assert saved_config == 0
+    ds.config.set_tensor_pool_size(64)
+    assert ds.config.get_tensor_pool_size() == 64
+
+    data = ds.NumpySlicesDataset(np.arange(4 * 2048, dtype=np.int32).reshape((4, 2048)), column_names=["col"],
+                                 shuffle=False)
+    data = data.map(operations=[lambda x: x + 1], input_columns=["col"])
+    for _ in range(2):
+        for i, item in enumerate(data.create_dict_iterator(num_epochs=1, output_numpy=True)):
+            np.testing.assert_array_equal(item["col"], np.arange(i * 2048, (i + 1) * 2048, dtype=np.int32) + 1)
+
+    config_error_func(ds.config.set_tensor_pool_size, -1, ValueError, "Size given is not within the required range")
+    config_error_func(ds.config.set_tensor_pool_size, True, TypeError, "size isn't of type int")
+    ds.config.set_tensor_pool_size(saved_config)
+    assert saved_config == ds.config.get_tensor_pool_size()
+
+
 def test_config_bool_type_error():
     """
     Feature: Now many interfaces of config support bool input even its valid input is int.
@@ -504,4 +528,5 @@ if __name__ == '__main__':
     test_auto_num_workers()
     test_enable_watchdog()
     test_multiprocessing_timeout_interval()
+    test_tensor_pool_size()
     test_config_bool_type_error()
@@ -25,6 +25,7 @@ from mindspore.ops import composite as C
 from mindspore.ops import operations as P
 from mindspore.parallel import _cost_model_context as cost_model_context
 from mindspore.parallel._cost_model_context import _set_algo_single_loop, _get_algo_single_loop
+from mindspore.parallel._cost_model_context import _set_algo_parallel_search, _get_algo_parallel_search
 from mindspore.parallel import set_algo_parameters, get_algo_parameters, reset_algo_parameters
 from mindspore.parallel._utils import _reset_op_id as reset_op_id
 from tests.ut.python.ops.test_math_ops import VirtualLoss
@@ -160,3 +161,96 @@ def test_two_matmul():
     for (k, v) in strategies.items():
         if re.search('MatMul-op', k) is not None:
             assert v == [[16, 1], [1, 1]]
+
+
+def test_two_matmul_time_budget():
+    """
+    Feature: The time budget of the dynamic programming strategy searching.
+    Description: Set a time budget which is always exceeded and compile a net of two matmuls.
+    Expectation: The searching returns the cheapest strategies found so far instead of failing.
+    """
+    class Net(nn.Cell):
+        def __init__(self):
+            super().__init__()
+            self.matmul1 = P.MatMul()
+            self.matmul2 = P.MatMul()
+
+        def construct(self, x, y, b):
+            out = self.matmul1(x, y)
+            out = self.matmul2(out, b)
+            return out
+
+    set_algo_parameters(algo_time_budget=1e-9)
+    time_budget = get_algo_parameters("algo_time_budget")
+    assert math.isclose(time_budget, 1e-9, rel_tol=1e-6)
+
+    x = Tensor(np.ones([128, 32]), dtype=ms.float32)
+    y = Tensor(np.ones([32, 64]), dtype=ms.float32)
+    b = Tensor(np.ones([64, 64]), dtype=ms.float32)
+
+    context.set_auto_parallel_context(device_num=16, global_rank=0, parallel_mode="auto_parallel")
+    net = NetWithLoss(Net())
+    net.set_auto_parallel()
+    reset_op_id()
+
+    net.set_train()
+    _cell_graph_executor.compile(net, x, y, b, phase='train')
+    strategies = _cell_graph_executor._get_shard_strategy(net)
+    assert any(re.search('MatMul-op', k) is not None for k in strategies)
+
+    reset_algo_parameters()
+    time_budget = get_algo_parameters("algo_time_budget")
+    assert math.isclose(time_budget, 0.0, abs_tol=1e-9)
+
+
+def test_repeated_matmul_parallel_search():
+    """
+    Feature: The parallel and cached dynamic programming strategy searching.
+    Description: Compile a net of repeated identical layers with the parallel search enabled and disabled.
+    Expectation: The strategies of all the operators are exactly the same as the ones searched serially.
+    """
+    class Layer(nn.Cell):
+        def __init__(self):
+            super().__init__()
+            self.matmul1 = P.MatMul()
+            self.relu = P.ReLU()
+            self.matmul2 = P.MatMul()
+            self.add = P.Add()
+
+        def construct(self, x, y, b):
+            out = self.relu(self.matmul1(x, y))
+            out = self.matmul2(out, b)
+            return self.add(out, x)
+
+    class Net(nn.Cell):
+        def __init__(self, layer_num):
+            super().__init__()
+            self.layers = nn.CellList([Layer() for _ in range(layer_num)])
+
+        def construct(self, x, y, b):
+            out = x
+            for layer in self.layers:
+                out = layer(out, y, b)
+            return out
+
+    def compile_strategies(parallel_search):
+        _set_algo_parallel_search(parallel_search)
+        assert _get_algo_parallel_search() == parallel_search
+        context.set_auto_parallel_context(device_num=16, global_rank=0, parallel_mode="auto_parallel")
+        net = NetWithLoss(Net(4))
+        net.set_auto_parallel()
+        reset_op_id()
+        net.set_train()
+        _cell_graph_executor.compile(net, x, y, b, phase='train')
+        return _cell_graph_executor._get_shard_strategy(net)
+
+    x = Tensor(np.ones([128, 64]), dtype=ms.float32)
+    y = Tensor(np.ones([64, 256]), dtype=ms.float32)
+    b = Tensor(np.ones([256, 64]), dtype=ms.float32)
+
+    serial_strategies = compile_strategies(False)
+    parallel_strategies = compile_strategies(True)
+    assert len([k for k in serial_strategies if re.search('MatMul-op', k) is not None]) == 8
+    assert parallel_strategies == serial_strategies
+    cost_model_context.reset_cost_model_context()
+    assert _get_algo_parallel_search()